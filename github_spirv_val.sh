@@ -0,0 +1,70 @@
+#!/usr/bin/env bash
+
+# Validates the SPIR-V emitted directly (without glslang) for the tests that use -emit-spirv-directly or
+# -validate-spirv-directly, with spirv-val from SPIRV-Tools.
+#
+# CONFIGURATION=release or debug
+
+PLATFORM=$(uname -s | tr '[:upper:]' '[:lower:]')
+ARCHITECTURE=$(uname -p)
+
+if [ "${ARCHITECTURE}" == "x86_64" ]; then
+    ARCHITECTURE="x64"
+fi
+
+TARGET=${PLATFORM}-${ARCHITECTURE}
+
+OUTPUTDIR=bin/${TARGET}/${CONFIGURATION}/
+
+SLANGC=${SLANGC:-${OUTPUTDIR}slangc}
+SPIRV_VAL=${SPIRV_VAL:-spirv-val}
+
+OUTPUT_SPIRV=$(mktemp)
+trap 'rm -f ${OUTPUT_SPIRV}' EXIT
+
+FAILURE_COUNT=0
+VALIDATED_COUNT=0
+
+for FILE in $(grep -rlE -- "^//TEST.*-(emit|validate)-spirv-directly" tests | sort); do
+    while read -r LINE; do
+        # The options for slang are either given directly (SIMPLE) or with -xslang (COMPARE_COMPUTE)
+        read -ra ARGS <<< "${LINE#*:*:}"
+
+        ENTRY=computeMain
+        STAGE=compute
+        SLANG_ARGS=()
+        for ((i = 0; i < ${#ARGS[@]}; i++)); do
+            case "${ARGS[$i]}" in
+                -entry) ENTRY=${ARGS[$((i + 1))]}; i=$((i + 1)) ;;
+                -stage) STAGE=${ARGS[$((i + 1))]}; i=$((i + 1)) ;;
+                -target) i=$((i + 1)) ;;
+                -xslang)
+                    # Validation against glslang's output isn't needed, spirv-val checks the module
+                    if [ "${ARGS[$((i + 1))]}" != "-validate-spirv-directly" ]; then
+                        SLANG_ARGS+=("${ARGS[$((i + 1))]}")
+                    fi
+                    i=$((i + 1)) ;;
+                -matrix-layout-row-major|-matrix-layout-column-major|-O0|-O1|-O2|-O3) SLANG_ARGS+=("${ARGS[$i]}") ;;
+            esac
+        done
+
+        # Only the SPIR-V emitted directly is of interest, so a compile that falls back to glslang (52006) fails
+        DIAGNOSTICS=$(${SLANGC} "${FILE}" -target spirv -entry "${ENTRY}" -stage "${STAGE}" "${SLANG_ARGS[@]}" -emit-spirv-directly -o "${OUTPUT_SPIRV}" 2>&1)
+        if [ $? -ne 0 ] || echo "${DIAGNOSTICS}" | grep -q "52006"; then
+            echo "failed to emit SPIR-V directly: ${FILE} ${SLANG_ARGS[*]}"
+            echo "${DIAGNOSTICS}"
+            FAILURE_COUNT=$((FAILURE_COUNT + 1))
+            continue
+        fi
+
+        if ! ${SPIRV_VAL} --target-env vulkan1.2 "${OUTPUT_SPIRV}"; then
+            echo "spirv-val failed: ${FILE} ${SLANG_ARGS[*]}"
+            FAILURE_COUNT=$((FAILURE_COUNT + 1))
+            continue
+        fi
+        VALIDATED_COUNT=$((VALIDATED_COUNT + 1))
+    done < <(grep -E -- "^//TEST.*-(emit|validate)-spirv-directly" "${FILE}")
+done
+
+echo "validated ${VALIDATED_COUNT}, failed ${FAILURE_COUNT}"
+[ ${FAILURE_COUNT} -eq 0 ]
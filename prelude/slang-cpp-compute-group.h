@@ -0,0 +1,369 @@
+#ifndef SLANG_PRELUDE_CPP_COMPUTE_GROUP_H
+#define SLANG_PRELUDE_CPP_COMPUTE_GROUP_H
+
+// Support for group barriers in compute kernels compiled for the CPU.
+//
+// Included by slang-cpp-prelude.h when SLANG_PRELUDE_ENABLE_COMPUTE_GROUP is defined, which
+// generated code does if it uses barriers.
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <atomic>
+#include <vector>
+
+#include "slang-cpp-types.h"
+
+// How the invocations of a group switch between each other. Can be chosen by defining one of these to 1.
+// The assembly switch is only implemented for x86-64 ELF targets, other platforms use ucontext.
+#if !defined(SLANG_PRELUDE_FIBER_WIN32) && !defined(SLANG_PRELUDE_FIBER_ASM) && !defined(SLANG_PRELUDE_FIBER_UCONTEXT)
+#   if defined(_WIN32)
+#       define SLANG_PRELUDE_FIBER_WIN32 1
+#   elif defined(__ELF__) && defined(__x86_64__)
+#       define SLANG_PRELUDE_FIBER_ASM 1
+#   else
+#       define SLANG_PRELUDE_FIBER_UCONTEXT 1
+#   endif
+#endif
+
+#if SLANG_PRELUDE_FIBER_WIN32
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   include <windows.h>
+#else
+#   if SLANG_PRELUDE_FIBER_ASM && !(defined(__ELF__) && defined(__x86_64__))
+#       error "SLANG_PRELUDE_FIBER_ASM is only supported on x86-64 ELF targets"
+#   endif
+#   if SLANG_PRELUDE_FIBER_UCONTEXT
+#       if defined(__APPLE__) && !defined(_XOPEN_SOURCE)
+            // The deprecated (but still functional) ucontext functions are only declared with _XOPEN_SOURCE
+#           define _XOPEN_SOURCE 600
+#       endif
+#       include <ucontext.h>
+#   endif
+#   include <sys/mman.h>
+#   include <unistd.h>
+#endif
+
+// The stack size of each invocation of a group that uses barriers. Stacks are allocated
+// the first time a thread runs a group of a size, and reused for later groups. Outside of
+// Windows the size is rounded up to whole pages, and the page below each stack is a guard
+// page, so overflowing a stack faults instead of corrupting memory. Win32 fibers get the
+// guard page of a thread stack.
+#ifndef SLANG_PRELUDE_FIBER_STACK_SIZE
+#   define SLANG_PRELUDE_FIBER_STACK_SIZE (64 * 1024)
+#endif
+
+static_assert(SLANG_PRELUDE_FIBER_STACK_SIZE >= 16 * 1024, "SLANG_PRELUDE_FIBER_STACK_SIZE must be at least 16KB");
+
+#if SLANG_PRELUDE_FIBER_ASM
+
+// Switching saves the callee saved registers on the stack being left, stores its stack pointer to
+// *outFromSp and continues on toSp. A new fiber starts in slang_fiberStart, which calls the function
+// in r13 with r12 as the parameter.
+//
+// The symbols are local to the object file, so each library the prelude is compiled into has its own.
+extern "C" void slang_fiberSwitch(void** outFromSp, void* toSp) __attribute__((visibility("hidden")));
+extern "C" void slang_fiberStart() __attribute__((visibility("hidden")));
+
+__asm__(
+    ".pushsection .text\n"
+    ".p2align 4\n"
+    ".type slang_fiberSwitch, @function\n"
+    "slang_fiberSwitch:\n"
+    "    pushq %rbp\n"
+    "    pushq %rbx\n"
+    "    pushq %r12\n"
+    "    pushq %r13\n"
+    "    pushq %r14\n"
+    "    pushq %r15\n"
+    "    movq %rsp, (%rdi)\n"
+    "    movq %rsi, %rsp\n"
+    "    popq %r15\n"
+    "    popq %r14\n"
+    "    popq %r13\n"
+    "    popq %r12\n"
+    "    popq %rbx\n"
+    "    popq %rbp\n"
+    "    ret\n"
+    ".size slang_fiberSwitch, .-slang_fiberSwitch\n"
+    ".p2align 4\n"
+    ".type slang_fiberStart, @function\n"
+    "slang_fiberStart:\n"
+    "    movq %r12, %rdi\n"
+    "    callq *%r13\n"
+    "    ud2\n"
+    ".size slang_fiberStart, .-slang_fiberStart\n"
+    ".popsection\n");
+
+#endif // SLANG_PRELUDE_FIBER_ASM
+
+#ifdef SLANG_PRELUDE_NAMESPACE
+namespace SLANG_PRELUDE_NAMESPACE {
+#endif
+
+/* Runs the invocations of a compute group on the calling thread, each as a fiber (with its own stack),
+such that an invocation can wait at a barrier for the other invocations of the group.
+
+The fibers are run in turn. Each runs until it reaches a barrier or completes, and then the next fiber is
+run. So each turn around all of the fibers takes the group from one barrier to the next.
+
+The fibers (and their stacks) are per thread and are reused for each group the thread runs. */
+class ComputeGroupFibers
+{
+public:
+        /// Run every invocation of a group of groupSize. The invocations have the groupID of groupInput.
+    static void run(ComputeThreadFunc func, const ComputeThreadVaryingInput* groupInput, const uint32_t groupSize[3], void* uniformEntryPointParams, void* uniformState)
+    {
+        _getForThread()._run(func, groupInput, groupSize, uniformEntryPointParams, uniformState);
+    }
+
+        /// Wait until all invocations of the current group have reached the barrier. If not inside
+        /// of a group being run (for example an invocation run directly with a _Thread function) does nothing.
+    static void barrier()
+    {
+        if (ComputeGroupFibers* fibers = _getCurrent())
+        {
+            fibers->_yield();
+        }
+    }
+
+    ~ComputeGroupFibers()
+    {
+        for (Fiber* fiber : m_fibers)
+        {
+#if SLANG_PRELUDE_FIBER_WIN32
+            DeleteFiber(fiber->handle);
+#else
+            _freeStack(fiber->stack);
+#endif
+            delete fiber;
+        }
+#if SLANG_PRELUDE_FIBER_WIN32
+        if (m_isThreadConverted)
+        {
+            ConvertFiberToThread();
+        }
+#endif
+    }
+
+private:
+    struct Fiber
+    {
+        ComputeThreadVaryingInput varyingInput;
+        bool isDone;
+#if SLANG_PRELUDE_FIBER_WIN32
+        LPVOID handle;
+#elif SLANG_PRELUDE_FIBER_ASM
+        void* sp;
+        void* stack;
+#else
+        ucontext_t context;
+        void* stack;
+#endif
+    };
+
+    void _run(ComputeThreadFunc func, const ComputeThreadVaryingInput* groupInput, const uint32_t groupSize[3], void* uniformEntryPointParams, void* uniformState)
+    {
+        // A kernel can't run a group from inside of a group
+        SLANG_PRELUDE_ASSERT(_getCurrent() == nullptr);
+
+        const uint32_t count = groupSize[0] * groupSize[1] * groupSize[2];
+        _addFibers(count);
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            Fiber* fiber = m_fibers[i];
+            fiber->varyingInput = *groupInput;
+            fiber->varyingInput.groupThreadID.x = i % groupSize[0];
+            fiber->varyingInput.groupThreadID.y = (i / groupSize[0]) % groupSize[1];
+            fiber->varyingInput.groupThreadID.z = i / (groupSize[0] * groupSize[1]);
+            fiber->isDone = false;
+        }
+
+#if SLANG_PRELUDE_FIBER_WIN32
+        // Switching requires the thread running the group to be a fiber too
+        if (!IsThreadAFiber())
+        {
+            ConvertThreadToFiber(nullptr);
+            m_isThreadConverted = true;
+        }
+        m_schedulerHandle = GetCurrentFiber();
+#endif
+
+        m_func = func;
+        m_uniformEntryPointParams = uniformEntryPointParams;
+        m_uniformState = uniformState;
+        _getCurrent() = this;
+
+        // Invocations are expected to all reach the same barriers, but if they don't turns are taken
+        // until all are done.
+        uint32_t remainingCount = count;
+        while (remainingCount)
+        {
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                Fiber* fiber = m_fibers[i];
+                if (!fiber->isDone)
+                {
+                    m_currentIndex = i;
+                    _switchTo(fiber);
+                    remainingCount -= fiber->isDone ? 1 : 0;
+                }
+            }
+        }
+
+        _getCurrent() = nullptr;
+    }
+
+        /// Runs invocations on a fiber. Each time an invocation completes, waits until run for another one.
+    static void _fiberMain(ComputeGroupFibers* fibers)
+    {
+        for (;;)
+        {
+            Fiber* fiber = fibers->m_fibers[fibers->m_currentIndex];
+            fibers->m_func(&fiber->varyingInput, fibers->m_uniformEntryPointParams, fibers->m_uniformState);
+            fiber->isDone = true;
+            fibers->_yield();
+        }
+    }
+
+        /// Make sure there are at least count fibers
+    void _addFibers(uint32_t count)
+    {
+        while (m_fibers.size() < count)
+        {
+            Fiber* fiber = new Fiber();
+#if SLANG_PRELUDE_FIBER_WIN32
+            fiber->handle = CreateFiber(SLANG_PRELUDE_FIBER_STACK_SIZE, &_win32FiberMain, this);
+#elif SLANG_PRELUDE_FIBER_ASM
+            size_t stackSize;
+            fiber->stack = _allocateStack(stackSize);
+            // The initial stack is what slang_fiberSwitch pops when first switched to
+            void** top = (void**)(((size_t)fiber->stack + stackSize) & ~size_t(15));
+            void** sp = top - 9;
+            sp[0] = nullptr;                                // r15
+            sp[1] = nullptr;                                // r14
+            sp[2] = (void*)&_fiberMain;                     // r13
+            sp[3] = this;                                   // r12
+            sp[4] = nullptr;                                // rbx
+            sp[5] = nullptr;                                // rbp
+            sp[6] = (void*)&slang_fiberStart;               // return address
+            fiber->sp = sp;
+#else
+            size_t stackSize;
+            fiber->stack = _allocateStack(stackSize);
+            getcontext(&fiber->context);
+            fiber->context.uc_stack.ss_sp = fiber->stack;
+            fiber->context.uc_stack.ss_size = stackSize;
+            fiber->context.uc_link = nullptr;
+            makecontext(&fiber->context, &_ucontextFiberMain, 0);
+#endif
+            m_fibers.push_back(fiber);
+        }
+    }
+
+    void _switchTo(Fiber* fiber)
+    {
+#if SLANG_PRELUDE_FIBER_WIN32
+        SwitchToFiber(fiber->handle);
+#elif SLANG_PRELUDE_FIBER_ASM
+        slang_fiberSwitch(&m_schedulerSp, fiber->sp);
+#else
+        swapcontext(&m_schedulerContext, &fiber->context);
+#endif
+    }
+
+        /// Switch from the current fiber back to the loop in _run
+    void _yield()
+    {
+#if SLANG_PRELUDE_FIBER_WIN32
+        SwitchToFiber(m_schedulerHandle);
+#elif SLANG_PRELUDE_FIBER_ASM
+        slang_fiberSwitch(&m_fibers[m_currentIndex]->sp, m_schedulerSp);
+#else
+        swapcontext(&m_fibers[m_currentIndex]->context, &m_schedulerContext);
+#endif
+    }
+
+#if !SLANG_PRELUDE_FIBER_WIN32
+    static size_t _getPageSize() { return size_t(sysconf(_SC_PAGESIZE)); }
+        /// The usable size of a stack, rounded up to whole pages
+    static size_t _getStackSize(size_t pageSize) { return (size_t(SLANG_PRELUDE_FIBER_STACK_SIZE) + pageSize - 1) & ~(pageSize - 1); }
+
+        /// Maps a stack of at least SLANG_PRELUDE_FIBER_STACK_SIZE bytes with a guard page below it.
+        /// Returns the lowest usable address, and the usable size in outSize.
+    static void* _allocateStack(size_t& outSize)
+    {
+        const size_t pageSize = _getPageSize();
+        outSize = _getStackSize(pageSize);
+
+        void* base = mmap(nullptr, outSize + pageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        // A kernel has no way to report failure, and can't run without its stacks
+        if (base == MAP_FAILED || mprotect(base, pageSize, PROT_NONE) != 0)
+        {
+            ::abort();
+        }
+        return (char*)base + pageSize;
+    }
+    static void _freeStack(void* stack)
+    {
+        const size_t pageSize = _getPageSize();
+        munmap((char*)stack - pageSize, _getStackSize(pageSize) + pageSize);
+    }
+#endif
+
+#if SLANG_PRELUDE_FIBER_WIN32
+    static VOID CALLBACK _win32FiberMain(LPVOID param) { _fiberMain((ComputeGroupFibers*)param); }
+#elif SLANG_PRELUDE_FIBER_UCONTEXT
+    static void _ucontextFiberMain() { _fiberMain(_getCurrent()); }
+#endif
+
+    static ComputeGroupFibers*& _getCurrent()
+    {
+        static thread_local ComputeGroupFibers* current = nullptr;
+        return current;
+    }
+    static ComputeGroupFibers& _getForThread()
+    {
+        static thread_local ComputeGroupFibers fibers;
+        return fibers;
+    }
+
+    std::vector<Fiber*> m_fibers;
+    uint32_t m_currentIndex = 0;
+
+    ComputeThreadFunc m_func = nullptr;
+    void* m_uniformEntryPointParams = nullptr;
+    void* m_uniformState = nullptr;
+
+#if SLANG_PRELUDE_FIBER_WIN32
+    LPVOID m_schedulerHandle = nullptr;
+    bool m_isThreadConverted = false;
+#elif SLANG_PRELUDE_FIBER_ASM
+    void* m_schedulerSp = nullptr;
+#else
+    ucontext_t m_schedulerContext;
+#endif
+};
+
+// The invocations of a group run on a single thread, so within a group memory barriers only need to
+// stop the compiler from moving memory accesses across them. Device memory can be accessed by groups
+// run on other threads.
+
+SLANG_FORCE_INLINE void GroupMemoryBarrier() { std::atomic_signal_fence(std::memory_order_seq_cst); }
+SLANG_FORCE_INLINE void DeviceMemoryBarrier() { std::atomic_thread_fence(std::memory_order_seq_cst); }
+SLANG_FORCE_INLINE void AllMemoryBarrier() { std::atomic_thread_fence(std::memory_order_seq_cst); }
+
+SLANG_FORCE_INLINE void GroupMemoryBarrierWithGroupSync() { ComputeGroupFibers::barrier(); }
+SLANG_FORCE_INLINE void DeviceMemoryBarrierWithGroupSync() { std::atomic_thread_fence(std::memory_order_seq_cst); ComputeGroupFibers::barrier(); }
+SLANG_FORCE_INLINE void AllMemoryBarrierWithGroupSync() { std::atomic_thread_fence(std::memory_order_seq_cst); ComputeGroupFibers::barrier(); }
+
+#ifdef SLANG_PRELUDE_NAMESPACE
+}
+#endif
+
+#endif
@@ -0,0 +1,293 @@
+#ifndef SLANG_PRELUDE_CPP_DISPATCH_H
+#define SLANG_PRELUDE_CPP_DISPATCH_H
+
+// A runtime for running compute kernels compiled for the CPU (for example with the host-callable or
+// shared library targets) across all cores.
+//
+// It is only needed by the code that invokes kernels, not by the kernels themselves, and so isn't
+// included by slang-cpp-prelude.h.
+
+#include <stddef.h>
+
+#include "slang-cpp-types.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef SLANG_PRELUDE_NAMESPACE
+namespace SLANG_PRELUDE_NAMESPACE {
+#endif
+
+/* Dispatches the groups of a compute grid across a pool of threads.
+
+The groups of the grid are split into chunks. Each thread starts with an equal share of the chunks.
+When a thread runs out it takes half of the remaining chunks of another thread ('work stealing'), such
+that all threads stay busy even when groups take different amounts of time to run.
+
+The function dispatched is the 'default' (group range) export of an entry point, for example `computeMain`
+(and not `computeMain_Group` or `computeMain_Thread`). It will be called concurrently for different
+ranges of groups, where each range is within a single row of the grid.
+
+The thread calling dispatch also runs groups. Only one dispatch runs at a time, and a dispatch must not
+be started from inside of a kernel being run by the same dispatcher. */
+class ComputeDispatcher
+{
+public:
+        /// Run func over a grid of dispatchSize groups, returning when all groups have been run.
+        /// chunkGroupCount is the amount of groups a thread takes at a time. Larger chunks have less
+        /// overhead, smaller ones balance better. If 0 an amount is picked based on the grid size and thread count.
+    void dispatch(ComputeFunc func, const uint32_t dispatchSize[3], void* uniformEntryPointParams, void* uniformState, uint32_t chunkGroupCount = 0)
+    {
+        Job job;
+        job.func = func;
+        job.uniformEntryPointParams = uniformEntryPointParams;
+        job.uniformState = uniformState;
+        for (int i = 0; i < 3; ++i)
+        {
+            job.dispatchSize[i] = dispatchSize[i];
+        }
+        job.groupCount = uint64_t(dispatchSize[0]) * dispatchSize[1] * dispatchSize[2];
+        if (job.groupCount == 0)
+        {
+            return;
+        }
+
+        const uint32_t threadCount = getThreadCount();
+        job.chunkGroupCount = chunkGroupCount ? chunkGroupCount : calcChunkGroupCount(job.groupCount, threadCount);
+
+        const uint64_t chunkCount = (job.groupCount + job.chunkGroupCount - 1) / job.chunkGroupCount;
+        if (threadCount <= 1 || chunkCount <= 1)
+        {
+            // Not worth waking up other threads
+            _runGroups(job, 0, job.groupCount);
+            return;
+        }
+
+        std::lock_guard<std::mutex> dispatchLock(m_dispatchMutex);
+
+        // Share out the chunks
+        for (uint32_t i = 0; i < threadCount; ++i)
+        {
+            Worker& worker = m_workers[i];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            worker.chunkBegin = (chunkCount * i) / threadCount;
+            worker.chunkEnd = (chunkCount * (i + 1)) / threadCount;
+        }
+
+        // Wake the pool
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_job = &job;
+            m_activeThreadCount = threadCount - 1;
+            m_generation++;
+        }
+        m_startCondition.notify_all();
+
+        _work(0);
+
+        // Wait for the other threads to complete their chunks
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_doneCondition.wait(lock, [this]() { return m_activeThreadCount == 0; });
+            m_job = nullptr;
+        }
+    }
+
+        /// The amount of threads groups are run on, including the thread calling dispatch
+    uint32_t getThreadCount() const { return uint32_t(m_workers.size()); }
+
+        /// The chunk size used if none is specified. Aims for several chunks per thread,
+        /// so there is work left to steal if threads are unbalanced.
+    static uint32_t calcChunkGroupCount(uint64_t groupCount, uint32_t threadCount)
+    {
+        const uint64_t chunkGroupCount = groupCount / (uint64_t(threadCount) * kChunksPerThread);
+        return chunkGroupCount < 1 ? 1 : (chunkGroupCount > 0xffffffff ? 0xffffffff : uint32_t(chunkGroupCount));
+    }
+
+        /// threadCount is the amount of threads to run on (including the thread calling dispatch).
+        /// If 0 uses as many as there are hardware threads.
+    explicit ComputeDispatcher(uint32_t threadCount = 0)
+    {
+        if (threadCount == 0)
+        {
+            threadCount = std::thread::hardware_concurrency();
+        }
+        threadCount = threadCount ? threadCount : 1;
+
+        m_workers = std::vector<Worker>(threadCount);
+        for (uint32_t i = 1; i < threadCount; ++i)
+        {
+            m_threads.push_back(std::thread(&ComputeDispatcher::_threadMain, this, i));
+        }
+    }
+
+    ~ComputeDispatcher()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_isQuitting = true;
+        }
+        m_startCondition.notify_all();
+        for (auto& thread : m_threads)
+        {
+            thread.join();
+        }
+    }
+
+private:
+    ComputeDispatcher(const ComputeDispatcher&) = delete;
+    void operator=(const ComputeDispatcher&) = delete;
+
+    enum { kChunksPerThread = 8 };
+
+    struct Job
+    {
+        ComputeFunc func;
+        void* uniformEntryPointParams;
+        void* uniformState;
+        uint32_t dispatchSize[3];
+        uint64_t groupCount;
+        uint32_t chunkGroupCount;
+    };
+
+        /// The chunks a thread has left to run. The owner takes from the front, others steal from the back.
+    struct Worker
+    {
+        std::mutex mutex;
+        uint64_t chunkBegin = 0;
+        uint64_t chunkEnd = 0;
+    };
+
+    void _threadMain(uint32_t workerIndex)
+    {
+        uint64_t generation = 0;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_startCondition.wait(lock, [&]() { return m_isQuitting || m_generation != generation; });
+                if (m_isQuitting)
+                {
+                    return;
+                }
+                generation = m_generation;
+            }
+
+            _work(workerIndex);
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (--m_activeThreadCount == 0)
+                {
+                    m_doneCondition.notify_one();
+                }
+            }
+        }
+    }
+
+    void _work(uint32_t workerIndex)
+    {
+        const Job& job = *m_job;
+        uint64_t chunkIndex;
+        while (_takeChunk(workerIndex, chunkIndex) || _stealChunks(workerIndex, chunkIndex))
+        {
+            const uint64_t groupBegin = chunkIndex * job.chunkGroupCount;
+            const uint64_t groupEnd = groupBegin + job.chunkGroupCount;
+            _runGroups(job, groupBegin, groupEnd < job.groupCount ? groupEnd : job.groupCount);
+        }
+    }
+
+    bool _takeChunk(uint32_t workerIndex, uint64_t& outChunkIndex)
+    {
+        Worker& worker = m_workers[workerIndex];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (worker.chunkBegin >= worker.chunkEnd)
+        {
+            return false;
+        }
+        outChunkIndex = worker.chunkBegin++;
+        return true;
+    }
+
+        /// Take half of the chunks of the first other worker that has any left. The first
+        /// stolen chunk is output, the rest become this worker's.
+    bool _stealChunks(uint32_t workerIndex, uint64_t& outChunkIndex)
+    {
+        const uint32_t threadCount = getThreadCount();
+        for (uint32_t i = 1; i < threadCount; ++i)
+        {
+            Worker& victim = m_workers[(workerIndex + i) % threadCount];
+
+            uint64_t stolenBegin, stolenEnd;
+            {
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (victim.chunkBegin >= victim.chunkEnd)
+                {
+                    continue;
+                }
+                const uint64_t remainingCount = victim.chunkEnd - victim.chunkBegin;
+                stolenEnd = victim.chunkEnd;
+                stolenBegin = stolenEnd - (remainingCount + 1) / 2;
+                victim.chunkEnd = stolenBegin;
+            }
+
+            Worker& worker = m_workers[workerIndex];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            worker.chunkBegin = stolenBegin + 1;
+            worker.chunkEnd = stolenEnd;
+
+            outChunkIndex = stolenBegin;
+            return true;
+        }
+        return false;
+    }
+
+        /// Run the groups with linear indices [groupBegin, groupEnd), one row segment at a time
+    static void _runGroups(const Job& job, uint64_t groupBegin, uint64_t groupEnd)
+    {
+        const uint64_t rowGroupCount = job.dispatchSize[0];
+        while (groupBegin < groupEnd)
+        {
+            const uint64_t rowIndex = groupBegin / rowGroupCount;
+            const uint32_t x = uint32_t(groupBegin % rowGroupCount);
+            const uint32_t y = uint32_t(rowIndex % job.dispatchSize[1]);
+            const uint32_t z = uint32_t(rowIndex / job.dispatchSize[1]);
+
+            const uint64_t rowEnd = (rowIndex + 1) * rowGroupCount;
+            const uint64_t segmentEnd = groupEnd < rowEnd ? groupEnd : rowEnd;
+
+            ComputeVaryingInput varyingInput;
+            varyingInput.startGroupID.x = x;
+            varyingInput.startGroupID.y = y;
+            varyingInput.startGroupID.z = z;
+            varyingInput.endGroupID.x = x + uint32_t(segmentEnd - groupBegin);
+            varyingInput.endGroupID.y = y + 1;
+            varyingInput.endGroupID.z = z + 1;
+
+            job.func(&varyingInput, job.uniformEntryPointParams, job.uniformState);
+
+            groupBegin = segmentEnd;
+        }
+    }
+
+    std::vector<Worker> m_workers;                  ///< One per thread, the calling thread is index 0
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_dispatchMutex;                     ///< Held for the duration of a dispatch
+
+    std::mutex m_mutex;                             ///< Guards the members below
+    std::condition_variable m_startCondition;
+    std::condition_variable m_doneCondition;
+    const Job* m_job = nullptr;
+    uint64_t m_generation = 0;                      ///< Incremented for each dispatch that uses the pool
+    uint32_t m_activeThreadCount = 0;               ///< Pool threads still working on the current dispatch
+    bool m_isQuitting = false;
+};
+
+#ifdef SLANG_PRELUDE_NAMESPACE
+}
+#endif
+
+#endif
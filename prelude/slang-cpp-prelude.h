@@ -39,6 +39,11 @@
 #include "slang-cpp-types.h"
 #include "slang-cpp-scalar-intrinsics.h"
 
+// Defined by generated code that uses barriers
+#if SLANG_PRELUDE_ENABLE_COMPUTE_GROUP
+#   include "slang-cpp-compute-group.h"
+#endif
+
 // TODO(JS): Hack! Output C++ code from slang can copy uninitialized variables. 
 #if defined(_MSC_VER)
 #   pragma warning(disable : 4700)
@@ -48,6 +53,20 @@
 #   define SLANG_UNROLL
 #endif
 
+// Marks a loop whose iterations are independent, such that the compiler can run them in SIMD lanes.
+// Output for CPU compute kernels uses it on the loop over the invocations of a group when a CPU SIMD mode is enabled.
+#ifndef SLANG_SIMD_LOOP
+#   if defined(__clang__)
+#       define SLANG_SIMD_LOOP _Pragma("clang loop vectorize(assume_safety)")
+#   elif defined(__GNUC__)
+#       define SLANG_SIMD_LOOP _Pragma("GCC ivdep")
+#   elif defined(_MSC_VER)
+#       define SLANG_SIMD_LOOP __pragma(loop(ivdep))
+#   else
+#       define SLANG_SIMD_LOOP
+#   endif
+#endif
+
 struct gfx_Renderer_0;
 struct gfx_BufferResource_0;
 struct gfx_ShaderProgram_0;
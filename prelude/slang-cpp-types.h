@@ -1036,6 +1036,17 @@ struct ComputeVaryingInput
 typedef void(*ComputeThreadFunc)(ComputeThreadVaryingInput* varyingInput, void* uniformEntryPointParams, void* uniformState);
 typedef void(*ComputeFunc)(ComputeVaryingInput* varyingInput, void* uniformEntryPointParams, void* uniformState);
 
+/* Used when the invocations of a group are run in SIMD lanes. A lane mask holds 1 for a lane whose invocation is active, 0 otherwise */
+SLANG_FORCE_INLINE bool isAnyLaneActive(const int32_t* laneMask, int laneCount)
+{
+    int32_t active = 0;
+    for (int i = 0; i < laneCount; ++i)
+    {
+        active |= laneMask[i];
+    }
+    return active != 0;
+}
+
 template<typename TResult, typename TInput>
 TResult slang_bit_cast(TInput val)
 {
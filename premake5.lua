@@ -119,9 +119,17 @@ newoption {
    value       = "path"
 }
 
+newoption {
+   trigger     = "embed-stdlib",
+   description = "(Optional) If true the serialized stdlib will be embedded in the slang library, and loaded instead of being compiled from source",
+   value       = "bool",
+   default     = "false",
+   allowed     = { { "true", "True"}, { "false", "False" } }
+}
+
 newoption {
    trigger     = "enable-profile",
-   description = "(Optional) If true will enable slang-profile tool - suitable for gprof usage on linux",
+   description = "(Optional) If true will build slang-profile with -pg on linux - suitable for gprof usage",
    value       = "bool",
    default     = "false",
    allowed     = { { "true", "True"}, { "false", "False" } }
@@ -133,6 +141,7 @@ targetDetail = _OPTIONS["target-detail"]
 buildGlslang = (_OPTIONS["build-glslang"] == "true")
 enableCuda = not not (_OPTIONS["enable-cuda"] == "true" or _OPTIONS["cuda-sdk-path"])
 enableProfile = (_OPTIONS["enable-profile"] == "true")
+embedStdLib = (_OPTIONS["embed-stdlib"] == "true")
 optixPath = _OPTIONS["optix-sdk-path"]
 enableOptix = not not (_OPTIONS["enable-optix"] == "true" or optixPath)
 enableProfile = (_OPTIONS["enable-profile"] == "true")
@@ -635,6 +644,10 @@ tool "slang-test"
     includedirs { "." }
     links { "core", "slang" }
 
+    -- Some unit tests compile on multiple threads
+    filter { "system:linux" }
+        links { "pthread" }
+
 --
 -- The reflection test harness `slang-reflection-test` is pretty
 -- simple, in that it only needs to link against the slang library
@@ -786,6 +799,14 @@ standardProject "slangc"
     kind "ConsoleApp"
     links { "core", "slang" }
     
+    -- Save the serialized stdlib next to the slang library. Creating a global session
+    -- loads it rather than compiling the stdlib from source, as long as it was saved 
+    -- after the library was last built.
+    if executeBinary and not embedStdLib then
+        postbuildmessage "Saving serialized stdlib"
+        postbuildcommands { '"%{cfg.targetdir}/slangc" -save-stdlib "%{cfg.targetdir}/slang-stdlib.bin"' }
+    end
+    
 generatorProject("run-generators", "source/slang/")
     
     -- We make 'source/slang' the location of the source, to make paths to source
@@ -926,6 +947,52 @@ generatorProject("run-generators", "source/slang/")
     end
     
     
+--
+-- If the stdlib is embedded, we need to produce the serialized stdlib before
+-- `slang` can be built. We do that with `slang-bootstrap`, which is `slangc` 
+-- statically linked with a build of the compiler that compiles the stdlib from 
+-- source. The stdlib it saves is then turned into source with `slang-embed`.
+--
+
+if embedStdLib and executeBinary then
+    tool "slang-bootstrap"
+        uuid "B2D63B45-92B0-40F7-B242-CCA4DFD64341"
+        
+        dependson { "run-generators" }
+        
+        includedirs { ".", "external/spirv-headers/include" }
+        
+        defines { "SLANG_STATIC" }
+        
+        files { "source/slangc/main.cpp", "slang.h" }
+        
+        files {
+            "prelude/slang-cuda-prelude.h.cpp",
+            "prelude/slang-hlsl-prelude.h.cpp",
+            "prelude/slang-cpp-prelude.h.cpp"
+        }
+        
+        addSourceDir "source/slang"
+        
+        links { "core" }
+        
+    generatorProject("embed-stdlib-generator", "source/slang/")
+    
+        -- As with `run-generators` we need some source to build.
+        files { "source/core/slang-string.cpp" }
+        
+        dependson { "slang-bootstrap", "slang-embed" }
+        
+        -- The paths are made absolute as the project location varies by target 
+        local stdLibPath = path.getabsolute("source/slang/slang-stdlib.bin")
+        
+        prebuildmessage "Generating embedded stdlib"
+        prebuildcommands {
+            '"%{cfg.targetdir}/slang-bootstrap" -save-stdlib "' .. stdLibPath .. '"',
+            '"%{cfg.targetdir}/slang-embed" -binary "' .. stdLibPath .. '"'
+        }
+end
+
 --
 -- TODO: Slang's current `Makefile` build does some careful incantations
 -- to make sure that the binaries it generates use a "relative `RPATH`"
@@ -985,6 +1052,14 @@ standardProject "slang"
     
     dependson { "run-generators" }
     
+    -- The serialized stdlib is embedded (as `slang-stdlib.bin.cpp`), and will be 
+    -- loaded by default when a global session is created.
+    if embedStdLib and executeBinary then
+        defines { "SLANG_EMBED_STDLIB" }
+        files { "source/slang/slang-stdlib.bin.cpp" }
+        dependson { "embed-stdlib-generator" }
+    end
+    
     -- If we are not building glslang from source, then be
     -- sure to copy a binary copy over to the output directory
     if not buildGlslang then
@@ -1002,49 +1077,59 @@ standardProject "slang"
     filter { "system:linux" }
         -- might be able to do pic(true)
         buildoptions{"-fPIC"}
+        -- Code generation can be run on a pool of threads
+        links { "pthread" }
        
     
-if enableProfile then
-    tool "slang-profile"
-        uuid "375CC87D-F34A-4DF1-9607-C5C990FD6227"
-        
-        -- gprof needs symbols
-        symbols "On"
-        
-        dependson { "slang" }
+tool "slang-profile"
+    uuid "375CC87D-F34A-4DF1-9607-C5C990FD6227"
+    
+    -- Profilers need symbols
+    symbols "On"
+    
+    dependson { "slang" }
 
-        includedirs { "external/spirv-headers/include" }
+    includedirs { "external/spirv-headers/include" }
 
-        defines { "SLANG_STATIC" }
+    defines { "SLANG_STATIC" }
 
-        -- The `standardProject` operation already added all the code in
-        -- `source/slang/*`, but we also want to incldue the umbrella
-        -- `slang.h` header in this prject, so we do that manually here.
-        files { "slang.h" }
+    -- The `standardProject` operation already added all the code in
+    -- `source/slang/*`, but we also want to incldue the umbrella
+    -- `slang.h` header in this prject, so we do that manually here.
+    files { "slang.h" }
 
-        files { "source/core/core.natvis" }
+    files { "source/core/core.natvis" }
 
-        -- We explicitly name the prelude file(s) that we need to
-        -- compile for their embedded code, since they will not
-        -- exist at the time projects/makefiles are generated,
-        -- and thus a glob would not match anything.
-        files {
-            "prelude/slang-cuda-prelude.h.cpp",
-            "prelude/slang-hlsl-prelude.h.cpp",
-            "prelude/slang-cpp-prelude.h.cpp"
-        }
-        
-        -- Add the slang source
-        addSourceDir "source/slang"
+    -- We explicitly name the prelude file(s) that we need to
+    -- compile for their embedded code, since they will not
+    -- exist at the time projects/makefiles are generated,
+    -- and thus a glob would not match anything.
+    files {
+        "prelude/slang-cuda-prelude.h.cpp",
+        "prelude/slang-hlsl-prelude.h.cpp",
+        "prelude/slang-cpp-prelude.h.cpp"
+    }
+    
+    -- Add the slang source
+    addSourceDir "source/slang"
 
-        includedirs { "." }
-        links { "core"}
-        
+    includedirs { "." }
+    links { "core"}
+    
+    filter { "system:windows" }
+        -- Peak memory use is queried with GetProcessMemoryInfo
+        links { "psapi" }
+
+    filter { "system:linux" }
+        -- The compiler (built into the tool) uses threads, and loads shared libraries
+        links { "pthread", "dl" }
+
+    -- Instrumenting for gprof changes the timings, so is only done when asked for
+    if enableProfile then
         filter { "system:linux" }
             linkoptions{  "-pg" }
             buildoptions{ "-pg" }
-
-end
+    end
 
 if buildGlslang then
 
@@ -1168,6 +1168,45 @@ extern "C"
         SlangPassThrough    passThrough
     );
 
+    /*!
+    @brief Statistics about the session's cache of downstream compiler results.
+    */
+    struct SlangDownstreamCompileResultCacheStats
+    {
+        uint64_t hitCount;              ///< Downstream compiles whose result was found in the cache
+        uint64_t missCount;             ///< Downstream compiles whose result wasn't found in the cache
+        uint64_t evictedCount;          ///< Results evicted to keep the cache within its maximum size
+        uint64_t entryCount;            ///< The amount of results in the cache
+        uint64_t totalSizeInBytes;      ///< The estimated total size of the results in the cache
+    };
+
+    /*!
+    @brief Set the maximum size of the session's in memory cache of downstream compiler results.
+
+    When the cache is enabled, the result of a downstream compile (by fxc, dxc, glslang, or a C++ or CUDA compiler) is
+    held, keyed by the compiler's identity and version, the source passed to it and its options. A later compile by any
+    request on the session that passes identical source and options to the same compiler uses the held result, rather
+    than invoking the compiler again. The cache is disabled by default.
+
+    Host callable targets are never cached, as each request needs its own loaded library. Pass-through compiles by fxc,
+    dxc and glslang aren't cached, as their source can include files whose contents aren't part of the key.
+
+    @param session Session
+    @param maxSizeInBytes The maximum estimated size of the held results, beyond which the least recently used are evicted.
+    0 disables the cache and releases everything it holds.
+    */
+    SLANG_API void spSessionSetDownstreamCompileResultCacheSize(
+        SlangSession*   session,
+        uint64_t        maxSizeInBytes);
+
+    /*!
+    @brief Get statistics about the session's cache of downstream compiler results.
+    @return SLANG_E_NOT_AVAILABLE if the cache is not enabled.
+    */
+    SLANG_API SlangResult spSessionGetDownstreamCompileResultCacheStats(
+        SlangSession*                           session,
+        SlangDownstreamCompileResultCacheStats* outStats);
+
     /*!
     @brief Add new builtin declarations to be used in subsequent compiles.
     */
@@ -1292,6 +1331,122 @@ extern "C"
         SlangCompileRequest*    request,
         SlangOptimizationLevel  level);
 
+    /*!
+    @brief Set the maximum number of threads used to generate code for the entry points and targets of the request.
+    @param request The compilation context.
+    @param jobCount The maximum number of threads. 1 (the default) generates all code on the calling thread,
+    0 uses a thread per hardware thread. The output and diagnostics do not depend on the count.
+    */
+    SLANG_API void spSetParallelJobCount(
+        SlangCompileRequest*    request,
+        int                     jobCount);
+
+    /*!
+    @brief Statistics about a compile cache.
+    */
+    struct SlangCompileCacheStats
+    {
+        uint64_t hitCount;              ///< Compiles (by this process) whose results were found in the cache
+        uint64_t missCount;             ///< Compiles (by this process) whose results had to be produced
+        uint64_t evictedCount;          ///< Entries evicted (by this process) to keep the cache within its maximum size
+        uint64_t entryCount;            ///< The amount of entries in the cache
+        uint64_t totalSizeInBytes;      ///< The total size of the entries in the cache
+    };
+
+    /*!
+    @brief Use a persistent compile cache held in a directory.
+
+    The results of compiling are stored in the cache, keyed by a digest of the options, the contents of
+    the source files, the compiler version, and the downstream compilers (such as dxc or gcc) the targets use.
+    A later compile of the same inputs returns the stored results (code and diagnostics) without parsing or
+    generating code. For such a compile, the source is parsed and checked when reflection (or the program)
+    is first asked for.
+
+    Requests that can't be cached (for example ones that dump intermediates, or target host callables) are compiled
+    as normal.
+
+    @param request The compilation context.
+    @param directory The directory holding the cache. Created if it doesn't exist. Passing nullptr stops the request using a cache.
+    @param maxSizeInBytes The maximum total size of the cache entries, beyond which the least recently used are evicted. 0 uses the default (256MB).
+    */
+    SLANG_API SlangResult spSetCompileCache(
+        SlangCompileRequest*    request,
+        char const*             directory,
+        uint64_t                maxSizeInBytes);
+
+    /*!
+    @brief Get statistics about the compile cache the request uses.
+    @return SLANG_E_NOT_AVAILABLE if the request doesn't use a compile cache.
+    */
+    SLANG_API SlangResult spGetCompileCacheStats(
+        SlangCompileRequest*    request,
+        SlangCompileCacheStats* outStats);
+
+    /*!
+    @brief Statistics about the type layouts computed for a target.
+
+    The layout of a type is computed once per target, and reused when the type is laid out again (for example by
+    another parameter, entry point or reflection query). The layouts held are released when types they could refer to
+    may have been released, such as when the modules of a compile request made on a session are released.
+    */
+    struct SlangTypeLayoutCacheStats
+    {
+        uint64_t hitCount;              ///< Type layouts that had already been computed
+        uint64_t missCount;             ///< Type layouts that were computed, and held for reuse
+        uint64_t uncachedCount;         ///< Type layouts that were computed, but can't be reused as they depend on the program or specialization arguments
+        uint64_t releaseCount;          ///< Times the held type layouts were released, because types they could refer to may have been released
+        uint64_t entryCount;            ///< The amount of type layouts held
+    };
+
+    /*!
+    @brief Get statistics about the type layouts computed for a target of the request.
+    */
+    SLANG_API SlangResult spGetTypeLayoutCacheStats(
+        SlangCompileRequest*        request,
+        int                         targetIndex,
+        SlangTypeLayoutCacheStats*  outStats);
+
+    /*!
+    @brief A phase of the front end, or an IR pass run when generating code, recorded by a compile.
+    */
+    struct SlangPerfReportEntry
+    {
+        const char* scope;              ///< "frontEnd", or the target and entry points code was generated for (for example "hlsl:computeMain")
+        const char* name;               ///< The name of the phase or pass
+        double timeInSeconds;
+        int64_t instCountBefore;        ///< Instructions in the IR module before the pass, or -1 if not known
+        int64_t instCountAfter;         ///< Instructions in the IR module after the pass, or -1 if not known
+        uint64_t arenaBytesAllocated;   ///< Bytes allocated from the IR module's memory arena during the pass
+        uint64_t liveInstBytes;         ///< Bytes of the instructions in the IR module after the pass (0 if there is no module)
+        uint64_t peakLiveInstBytes;     ///< The most bytes the instructions in the IR module have taken up to the end of the pass
+    };
+
+    /*!
+    @brief Enable or disable recording the time taken by each phase of the front end, and each IR pass run when
+    generating code. Recording adds some overhead (instructions are counted after each pass), and requests that
+    record are never satisfied from a compile cache.
+
+    Equivalent to the `-report-perf` option, which also outputs the report with the diagnostics.
+    */
+    SLANG_API void spSetReportPerf(
+        SlangCompileRequest*    request,
+        int                     enable);
+
+    /*!
+    @brief Get the amount of entries recorded by the last compile of a request with perf reporting enabled.
+    */
+    SLANG_API SlangInt spGetPerfReportEntryCount(
+        SlangCompileRequest*    request);
+
+    /*!
+    @brief Get an entry recorded by the last compile. The strings remain valid until the request is compiled
+    again or destroyed.
+    */
+    SLANG_API SlangResult spGetPerfReportEntry(
+        SlangCompileRequest*    request,
+        SlangInt                index,
+        SlangPerfReportEntry*   outEntry);
+
 
     /*!
     @brief Get the build version 'tag' string. The string is the same as produced via `git describe --tags`
@@ -2884,9 +3039,14 @@ namespace slang
         multiple sessions, in order to amortize startups costs (in current
         Slang this is mostly the cost of loading the Slang standard library).
 
-        The global session is currently *not* thread-safe and objects created from
-        a single global session should only be used from a single thread at
-        a time.
+        Once the standard library has been set up (on creation, or through `compileStdLib`/`loadStdLib`),
+        `createSession` may be called from multiple threads, and each resulting session (along with the
+        objects and compile requests created from it) may be used on its own thread concurrently with
+        the others. The standard library is shared between them, and not copied.
+
+        Other methods that modify the global session (such as setting downstream compiler paths or
+        preludes) are *not* thread-safe, and should be called before sessions are used concurrently.
+        An individual session should only be used from a single thread at a time.
         */
     struct IGlobalSession : public ISlangUnknown
     {
@@ -2988,6 +3148,33 @@ namespace slang
         virtual SLANG_NO_THROW void SLANG_MCALL getLanguagePrelude(
             SlangSourceLanguage sourceLanguage,
             ISlangBlob** outPrelude) = 0;
+
+            /** Compile the standard library from its embedded source.
+
+            Only needs to be called on a global session created with `slang_createGlobalSessionWithoutStdLib`.
+            @return SLANG_OK if the stdlib was compiled. Fails if a stdlib has already been set up on this session.
+            */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL compileStdLib() = 0;
+
+            /** Load the standard library from a blob previously produced by `saveStdLib`.
+
+            The blob records the version of Slang and a hash of the stdlib source it was produced from.
+            If either does not match this build of Slang, loading fails with SLANG_E_NOT_AVAILABLE
+            and the session is left without a stdlib, such that `compileStdLib` can be used as a fallback.
+
+            Only needs to be called on a global session created with `slang_createGlobalSessionWithoutStdLib`.
+            @param stdLib The serialized stdlib
+            @param stdLibSizeInBytes The size of the serialized stdlib in bytes
+            */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL loadStdLib(
+            const void* stdLib,
+            size_t stdLibSizeInBytes) = 0;
+
+            /** Save the standard library held by this session in a serialized form suitable for `loadStdLib`.
+            @param outBlob On success holds the serialized stdlib.
+            */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL saveStdLib(
+            ISlangBlob** outBlob) = 0;
     };
 
     #define SLANG_UUID_IGlobalSession { 0xc140b5fd, 0xc78, 0x452e, { 0xba, 0x7c, 0x1a, 0x1e, 0x70, 0xc7, 0xf7, 0x1c } };
@@ -3380,10 +3567,25 @@ namespace slang
 
 #define SLANG_API_VERSION 0
 
+/** Create a global session.
+
+If this build of Slang has an embedded stdlib (see the `embed-stdlib` premake option), the stdlib
+is loaded from it. If there is no embedded stdlib, or it is not compatible with this build, the
+stdlib is compiled from source. 
+*/
 SLANG_API SlangResult slang_createGlobalSession(
     SlangInt                apiVersion,
     slang::IGlobalSession** outGlobalSession);
 
+/** Create a global session without a standard library.
+
+The stdlib must be set up with either `IGlobalSession::compileStdLib` or `IGlobalSession::loadStdLib`
+before the session can be used for compilation. 
+*/
+SLANG_API SlangResult slang_createGlobalSessionWithoutStdLib(
+    SlangInt                apiVersion,
+    slang::IGlobalSession** outGlobalSession);
+
 namespace slang
 {
     inline SlangResult createGlobalSession(
@@ -3443,6 +3645,17 @@ SLANG_API SlangResult spCompileRequest_getModule(
 SLANG_API SlangResult spCompileRequest_getSession(
     SlangCompileRequest* request,
     slang::ISession** outSession);
+
+/** Set the maximum number of specialized component types held by the session.
+
+Specializing a component type with the same arguments as before returns the component type made
+before (along with its layouts and compiled code). The session holds the specializations it has made
+for this, up to the maximum given, beyond which the least recently used are released. The default
+is 1024. 0 releases all of them, and disables reuse of specializations.
+*/
+SLANG_API void spSession_setSpecializationCacheSize(
+    slang::ISession*    session,
+    SlangInt            maxEntryCount);
 #endif
 
 /* DEPRECATED DEFINITIONS
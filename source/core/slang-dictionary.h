@@ -9,6 +9,19 @@
 #include "slang-math.h"
 #include "slang-hash.h"
 
+#include <string.h>
+
+#if SLANG_PROCESSOR_X86_64 || (SLANG_PROCESSOR_X86 && (defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)))
+#	define SLANG_DICTIONARY_USE_SSE2 1
+#	include <emmintrin.h>
+#else
+#	define SLANG_DICTIONARY_USE_SSE2 0
+#endif
+
+#if SLANG_VC
+#	include <intrin.h>
+#endif
+
 namespace Slang
 {
 	template<typename TKey, typename TValue>
@@ -75,131 +88,251 @@ namespace Slang
 
 	const float MaxLoadFactor = 0.7f;
 
+	/* The control bytes of a Dictionary hold the state of each slot - empty, deleted, or full. A full slot holds 7 bits
+	of the hash of its key, so most slots whose key doesn't match can be skipped without comparing keys.
+
+	Slots are probed in groups of kWidth, testing all of the control bytes of a group at once (with SSE2 where available). */
+	struct DictionaryCtrlGroup
+	{
+		enum : int8_t
+		{
+			kEmpty = -128,
+			kDeleted = -2,
+		};
+		static const int kWidth = 16;
+
+			/// Bit mask of the slots in the group whose control byte is the hash bits h2
+		uint32_t match(int8_t h2) const
+		{
+#if SLANG_DICTIONARY_USE_SSE2
+			return uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)));
+#else
+			uint32_t mask = 0;
+			for (int i = 0; i < kWidth; ++i)
+				mask |= uint32_t(ctrl[i] == h2) << i;
+			return mask;
+#endif
+		}
+			/// Bit mask of the empty slots in the group
+		uint32_t matchEmpty() const { return match(kEmpty); }
+			/// Bit mask of the empty or deleted slots in the group
+		uint32_t matchEmptyOrDeleted() const
+		{
+#if SLANG_DICTIONARY_USE_SSE2
+			return uint32_t(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl)));
+#else
+			uint32_t mask = 0;
+			for (int i = 0; i < kWidth; ++i)
+				mask |= uint32_t(ctrl[i] < -1) << i;
+			return mask;
+#endif
+		}
+
+			/// The index of the lowest set bit. mask must not be 0.
+		static int lowestBitIndex(uint32_t mask)
+		{
+			SLANG_ASSERT(mask);
+#if SLANG_VC
+			unsigned long index;
+			_BitScanForward(&index, mask);
+			return int(index);
+#else
+			return __builtin_ctz(mask);
+#endif
+		}
+
+		explicit DictionaryCtrlGroup(const int8_t* groupCtrl)
+		{
+#if SLANG_DICTIONARY_USE_SSE2
+			ctrl = _mm_loadu_si128((const __m128i*)groupCtrl);
+#else
+			ctrl = groupCtrl;
+#endif
+		}
+
+#if SLANG_DICTIONARY_USE_SSE2
+		__m128i ctrl;
+#else
+		const int8_t* ctrl;
+#endif
+	};
+
+	/* An unordered map from keys to values.
+
+	Open addressing, with the control bytes for the slots held separately from the key-value pairs (see
+	DictionaryCtrlGroup). The amount of slots is a power of 2, so the first group probed is found by masking the hash,
+	and groups are then probed in triangular order, which visits every group. */
 	template<typename TKey, typename TValue>
 	class Dictionary
 	{
 		friend class Iterator;
 		friend class ItemProxy;
 	private:
-		inline int GetProbeOffset(int /*probeId*/) const
-		{
-			// linear probing
-			return 1;
-		}
-	private:
-		int bucketSizeMinusOne;
+		typedef DictionaryCtrlGroup Group;
+
+		int capacity;						///< The amount of slots. 0, or a power of 2 that is at least Group::kWidth
 		int _count;
-		UIntSet marks;
+		int growthLeft;						///< The amount of empty slots that can be filled before growing
+		int8_t* ctrl;						///< A control byte for each slot
 		KeyValuePair<TKey, TValue>* hashMap;
+
 		void Free()
 		{
 			if (hashMap)
 				delete[] hashMap;
-			hashMap = 0;
+			if (ctrl)
+				delete[] ctrl;
+			hashMap = nullptr;
+			ctrl = nullptr;
 		}
-		inline bool IsDeleted(int pos) const
+		inline bool IsFull(int pos) const
 		{
-			return marks.contains((pos << 1) + 1);
+			return ctrl[pos] >= 0;
 		}
-		inline bool IsEmpty(int pos) const
+			/// The amount of slots that can be used (full or deleted) before the load is too high
+		static int CalcMaxGrowth(int capacity)
 		{
-			return !marks.contains((pos << 1));
+			return capacity - capacity / 8;
 		}
-		inline void SetDeleted(int pos, bool val)
+			/// Mixes the bits of the hash code. The high 32 bits choose the first group probed, the top 7 bits are the
+			/// bits held in the control byte.
+		static uint64_t MixHash(HashCode hash)
 		{
-			if (val)
-				marks.add((pos << 1) + 1);
-			else
-				marks.remove((pos << 1) + 1);
+			return uint64_t(hash) * 0x9e3779b97f4a7c15ull;
 		}
-		inline void SetEmpty(int pos, bool val)
+		static int8_t GetH2(uint64_t hash)
 		{
-			if (val)
-				marks.remove((pos << 1));
-			else
-				marks.add((pos << 1));
+			return int8_t(hash >> 57);
 		}
+		inline int GetGroupMask() const
+		{
+			return (capacity / Group::kWidth) - 1;
+		}
+		inline int GetFirstGroup(uint64_t hash) const
+		{
+			return int(uint32_t(hash >> 32)) & GetGroupMask();
+		}
+
 		struct FindPositionResult
 		{
 			int ObjectPosition;
 			int InsertionPosition;
+			int8_t H2;						///< The control byte for the key
 			FindPositionResult()
 			{
 				ObjectPosition = -1;
 				InsertionPosition = -1;
+				H2 = 0;
 			}
-			FindPositionResult(int objPos, int insertPos)
+			FindPositionResult(int objPos, int insertPos, int8_t h2)
 			{
 				ObjectPosition = objPos;
 				InsertionPosition = insertPos;
+				H2 = h2;
 			}
 
 		};
-		inline int GetHashPos(TKey& key) const
-        {
-            SLANG_ASSERT(bucketSizeMinusOne > 0);
-            const unsigned int hash = (unsigned int)getHashCode(key);
-            return (hash * 2654435761u) % (unsigned int)(bucketSizeMinusOne);
-		}
 		FindPositionResult FindPosition(const TKey& key) const
 		{
-			int hashPos = GetHashPos(const_cast<TKey&>(key));
+			if (capacity == 0)
+				return FindPositionResult();
+
+			const uint64_t hash = MixHash(getHashCode(const_cast<TKey&>(key)));
+			const int8_t h2 = GetH2(hash);
+			const int groupMask = GetGroupMask();
+
+			int group = GetFirstGroup(hash);
 			int insertPos = -1;
-			int numProbes = 0;
-			while (numProbes <= bucketSizeMinusOne)
+			for (int numProbes = 0; numProbes <= groupMask; )
 			{
-				if (IsEmpty(hashPos))
+				const int groupStart = group * Group::kWidth;
+				const Group ctrlGroup(ctrl + groupStart);
+				for (uint32_t mask = ctrlGroup.match(h2); mask; mask &= mask - 1)
 				{
-					if (insertPos == -1)
-						return FindPositionResult(-1, hashPos);
-					else
-						return FindPositionResult(-1, insertPos);
+					const int pos = groupStart + Group::lowestBitIndex(mask);
+					if (hashMap[pos].Key == key)
+						return FindPositionResult(pos, -1, h2);
 				}
-				else if (IsDeleted(hashPos))
+				if (insertPos == -1)
 				{
-					if (insertPos == -1)
-						insertPos = hashPos;
-				}
-				else if (hashMap[hashPos].Key == key)
-				{
-					return FindPositionResult(hashPos, -1);
+					const uint32_t mask = ctrlGroup.matchEmptyOrDeleted();
+					if (mask)
+						insertPos = groupStart + Group::lowestBitIndex(mask);
 				}
+				// A key is never placed beyond a group with an empty slot
+				if (ctrlGroup.matchEmpty())
+					break;
 				numProbes++;
-				hashPos = (hashPos + GetProbeOffset(numProbes)) & bucketSizeMinusOne;
+				group = (group + numProbes) & groupMask;
 			}
-			if (insertPos != -1)
-				return FindPositionResult(-1, insertPos);
-			throw InvalidOperationException("Hash map is full. This indicates an error in Key::Equal or Key::getHashCode.");
+			return FindPositionResult(-1, insertPos, h2);
 		}
-		TValue & _Insert(KeyValuePair<TKey, TValue>&& kvPair, int pos)
+			/// Find an empty slot for a key known not to be in the dictionary, where there are no deleted slots
+		int FindEmptyPosition(uint64_t hash) const
+		{
+			const int groupMask = GetGroupMask();
+			int group = GetFirstGroup(hash);
+			for (int numProbes = 0; numProbes <= groupMask; )
+			{
+				const uint32_t mask = Group(ctrl + group * Group::kWidth).matchEmpty();
+				if (mask)
+					return group * Group::kWidth + Group::lowestBitIndex(mask);
+				numProbes++;
+				group = (group + numProbes) & groupMask;
+			}
+			throw InvalidOperationException("Hash map is full. This is a bug in Dictionary implementation.");
+		}
+		TValue & _Insert(KeyValuePair<TKey, TValue>&& kvPair, int pos, int8_t h2)
 		{
 			hashMap[pos] = _Move(kvPair);
-			SetEmpty(pos, false);
-			SetDeleted(pos, false);
+			if (!IsFull(pos))
+			{
+				if (ctrl[pos] == Group::kEmpty)
+					growthLeft--;
+				ctrl[pos] = h2;
+				_count++;
+			}
 			return hashMap[pos].Value;
 		}
-		void Rehash()
+			/// Rebuild the slots with newCapacity, moving the pairs directly to their new slots
+		void Resize(int newCapacity)
 		{
-			if (bucketSizeMinusOne == -1 || _count >= int(MaxLoadFactor * bucketSizeMinusOne))
+			KeyValuePair<TKey, TValue>* oldHashMap = hashMap;
+			int8_t* oldCtrl = ctrl;
+			const int oldCapacity = capacity;
+
+			capacity = newCapacity;
+			hashMap = new KeyValuePair<TKey, TValue>[newCapacity];
+			ctrl = new int8_t[newCapacity];
+			memset(ctrl, Group::kEmpty, newCapacity);
+			growthLeft = CalcMaxGrowth(newCapacity) - _count;
+
+			for (int i = 0; i < oldCapacity; i++)
 			{
-				int newSize = (bucketSizeMinusOne + 1) * 2;
-				if (newSize == 0)
-				{
-					newSize = 16;
-				}
-				Dictionary<TKey, TValue> newDict;
-				newDict.bucketSizeMinusOne = newSize - 1;
-				newDict.hashMap = new KeyValuePair<TKey, TValue>[newSize];
-				newDict.marks.resizeAndClear(newSize * 2);
-				if (hashMap)
+				if (oldCtrl[i] >= 0)
 				{
-					for (auto & kvPair : *this)
-					{
-						newDict.Add(_Move(kvPair));
-					}
+					const uint64_t hash = MixHash(getHashCode(oldHashMap[i].Key));
+					const int pos = FindEmptyPosition(hash);
+					hashMap[pos] = _Move(oldHashMap[i]);
+					ctrl[pos] = GetH2(hash);
 				}
-				*this = _Move(newDict);
 			}
+
+			if (oldHashMap)
+				delete[] oldHashMap;
+			if (oldCtrl)
+				delete[] oldCtrl;
+		}
+			/// Make sure there is room to insert a pair
+		void Rehash()
+		{
+			if (growthLeft > 0)
+				return;
+			// If the slots are mostly taken by deleted entries, rebuilding at the same size is enough
+			if (capacity > 0 && _count <= CalcMaxGrowth(capacity) / 2)
+				Resize(capacity);
+			else
+				Resize(capacity ? capacity * 2 : Group::kWidth);
 		}
 
 		bool AddIfNotExists(KeyValuePair<TKey, TValue>&& kvPair)
@@ -210,8 +343,7 @@ namespace Slang
 				return false;
 			else if (pos.InsertionPosition != -1)
 			{
-				_count++;
-				_Insert(_Move(kvPair), pos.InsertionPosition);
+				_Insert(_Move(kvPair), pos.InsertionPosition, pos.H2);
 				return true;
 			}
 			else
@@ -227,12 +359,9 @@ namespace Slang
 			Rehash();
 			auto pos = FindPosition(kvPair.Key);
 			if (pos.ObjectPosition != -1)
-				return _Insert(_Move(kvPair), pos.ObjectPosition);
+				return _Insert(_Move(kvPair), pos.ObjectPosition, pos.H2);
 			else if (pos.InsertionPosition != -1)
-			{
-				_count++;
-				return _Insert(_Move(kvPair), pos.InsertionPosition);
-			}
+				return _Insert(_Move(kvPair), pos.InsertionPosition, pos.H2);
 			else
 				throw InvalidOperationException("Inconsistent find result returned. This is a bug in Dictionary implementation.");
 		}
@@ -253,10 +382,10 @@ namespace Slang
 			}
 			Iterator & operator ++()
 			{
-				if (pos > dict->bucketSizeMinusOne)
+				if (pos >= dict->capacity)
 					return *this;
 				pos++;
-				while (pos <= dict->bucketSizeMinusOne && (dict->IsDeleted(pos) || dict->IsEmpty(pos)))
+				while (pos < dict->capacity && !dict->IsFull(pos))
 				{
 					pos++;
 				}
@@ -291,18 +420,15 @@ namespace Slang
 		Iterator begin() const
 		{
 			int pos = 0;
-			while (pos < bucketSizeMinusOne + 1)
+			while (pos < capacity && !IsFull(pos))
 			{
-				if (IsEmpty(pos) || IsDeleted(pos))
-					pos++;
-				else
-					break;
+				pos++;
 			}
 			return Iterator(this, pos);
 		}
 		Iterator end() const
 		{
-			return Iterator(this, bucketSizeMinusOne + 1);
+			return Iterator(this, capacity);
 		}
 	public:
 		void Add(const TKey & key, const TValue & value)
@@ -328,15 +454,36 @@ namespace Slang
 			auto pos = FindPosition(key);
 			if (pos.ObjectPosition != -1)
 			{
-				SetDeleted(pos.ObjectPosition, true);
+				const int objPos = pos.ObjectPosition;
+				// Release what the pair holds
+				hashMap[objPos] = KeyValuePair<TKey, TValue>();
+
+				// If the group has an empty slot no probe continues past it, so the slot can be made empty again.
+				// Otherwise a probe may need to continue past this slot, so it is marked as deleted.
+				const int groupStart = objPos & ~(Group::kWidth - 1);
+				if (Group(ctrl + groupStart).matchEmpty())
+				{
+					ctrl[objPos] = Group::kEmpty;
+					growthLeft++;
+				}
+				else
+				{
+					ctrl[objPos] = Group::kDeleted;
+				}
 				_count--;
 			}
 		}
 		void Clear()
 		{
+			for (int i = 0; i < capacity; i++)
+			{
+				if (IsFull(i))
+					hashMap[i] = KeyValuePair<TKey, TValue>();
+			}
+			if (ctrl)
+				memset(ctrl, Group::kEmpty, capacity);
 			_count = 0;
-
-			marks.clear();
+			growthLeft = CalcMaxGrowth(capacity);
 		}
 
         TValue* TryGetValueOrAdd(const TKey& key, const TValue& value)
@@ -350,9 +497,8 @@ namespace Slang
             else if (pos.InsertionPosition != -1)
             {
                 // Make pair
-                KeyValuePair<TKey, TValue> kvPair(_Move(key), _Move(value));
-                _count++;
-                _Insert(_Move(kvPair), pos.InsertionPosition);
+                KeyValuePair<TKey, TValue> kvPair(key, value);
+                _Insert(_Move(kvPair), pos.InsertionPosition, pos.H2);
                 return nullptr;
             }
             else
@@ -372,9 +518,8 @@ namespace Slang
             else if (pos.InsertionPosition != -1)
             {
                 // Make pair
-                KeyValuePair<TKey, TValue> kvPair(_Move(key), _Move(defaultValue));
-                _count++;
-                return _Insert(_Move(kvPair), pos.InsertionPosition);
+                KeyValuePair<TKey, TValue> kvPair(key, defaultValue);
+                return _Insert(_Move(kvPair), pos.InsertionPosition, pos.H2);
             }
             else
                 throw InvalidOperationException("Inconsistent find result returned. This is a bug in Dictionary implementation.");
@@ -382,14 +527,14 @@ namespace Slang
 
 		bool ContainsKey(const TKey& key) const
 		{
-			if (bucketSizeMinusOne == -1)
+			if (_count == 0)
 				return false;
 			auto pos = FindPosition(key);
 			return pos.ObjectPosition != -1;
 		}
 		bool TryGetValue(const TKey& key, TValue& value) const
 		{
-			if (bucketSizeMinusOne == -1)
+			if (_count == 0)
 				return false;
 			auto pos = FindPosition(key);
 			if (pos.ObjectPosition != -1)
@@ -401,7 +546,7 @@ namespace Slang
 		}
 		TValue* TryGetValue(const TKey& key) const
 		{
-			if (bucketSizeMinusOne == -1)
+			if (_count == 0)
 				return nullptr;
 			auto pos = FindPosition(key);
 			if (pos.ObjectPosition != -1)
@@ -475,23 +620,22 @@ namespace Slang
 		}
 	public:
 		Dictionary()
+			: capacity(0), _count(0), growthLeft(0), ctrl(nullptr), hashMap(nullptr)
 		{
-			bucketSizeMinusOne = -1;
-			_count = 0;
-			hashMap = nullptr;
 		}
 		template<typename Arg, typename... Args>
 		Dictionary(Arg arg, Args... args)
+			: capacity(0), _count(0), growthLeft(0), ctrl(nullptr), hashMap(nullptr)
 		{
 			Init(arg, args...);
 		}
 		Dictionary(const Dictionary<TKey, TValue>& other)
-			: bucketSizeMinusOne(-1), _count(0), hashMap(nullptr)
+			: capacity(0), _count(0), growthLeft(0), ctrl(nullptr), hashMap(nullptr)
 		{
 			*this = other;
 		}
 		Dictionary(Dictionary<TKey, TValue>&& other)
-			: bucketSizeMinusOne(-1), _count(0), hashMap(nullptr)
+			: capacity(0), _count(0), growthLeft(0), ctrl(nullptr), hashMap(nullptr)
 		{
 			*this = (_Move(other));
 		}
@@ -500,12 +644,20 @@ namespace Slang
 			if (this == &other)
 				return *this;
 			Free();
-			bucketSizeMinusOne = other.bucketSizeMinusOne;
+			capacity = other.capacity;
 			_count = other._count;
-			hashMap = new KeyValuePair<TKey, TValue>[other.bucketSizeMinusOne + 1];
-			marks = other.marks;
-			for (int i = 0; i <= bucketSizeMinusOne; i++)
-				hashMap[i] = other.hashMap[i];
+			growthLeft = other.growthLeft;
+			if (capacity)
+			{
+				hashMap = new KeyValuePair<TKey, TValue>[capacity];
+				ctrl = new int8_t[capacity];
+				memcpy(ctrl, other.ctrl, capacity);
+				for (int i = 0; i < capacity; i++)
+				{
+					if (IsFull(i))
+						hashMap[i] = other.hashMap[i];
+				}
+			}
 			return *this;
 		}
 		Dictionary<TKey, TValue> & operator = (Dictionary<TKey, TValue>&& other)
@@ -513,13 +665,16 @@ namespace Slang
 			if (this == &other)
 				return *this;
 			Free();
-			bucketSizeMinusOne = other.bucketSizeMinusOne;
+			capacity = other.capacity;
 			_count = other._count;
+			growthLeft = other.growthLeft;
 			hashMap = other.hashMap;
-			marks = _Move(other.marks);
-			other.hashMap = 0;
+			ctrl = other.ctrl;
+			other.hashMap = nullptr;
+			other.ctrl = nullptr;
+			other.capacity = 0;
 			other._count = 0;
-			other.bucketSizeMinusOne = -1;
+			other.growthLeft = 0;
 			return *this;
 		}
 		~Dictionary()
@@ -96,6 +96,278 @@ void DownstreamCompiler::Desc::appendAsText(StringBuilder& out) const
     }
 }
 
+SlangResult DownstreamCompiler::compileAsync(const CompileOptions& options, DownstreamCompileJobPool* pool, RefPtr<DownstreamCompileJob>& outJob)
+{
+    RefPtr<DownstreamCompileJob> job = new DownstreamCompileJob(this, options);
+    pool->addJob(job);
+    outJob = job;
+    return SLANG_OK;
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! DownstreamCompileJob !!!!!!!!!!!!!!!!!!!!!!*/
+
+void DownstreamCompileJob::_run()
+{
+    RefPtr<DownstreamCompileResult> compileResult;
+    SlangResult res;
+    try
+    {
+        res = m_compiler->compile(m_options, compileResult);
+    }
+    catch (...)
+    {
+        // Pool threads must not throw
+        res = SLANG_FAIL;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_result = res;
+        m_compileResult = compileResult;
+        m_isComplete = true;
+    }
+    m_completed.notify_all();
+}
+
+bool DownstreamCompileJob::isComplete()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_isComplete;
+}
+
+SlangResult DownstreamCompileJob::waitForResult(RefPtr<DownstreamCompileResult>& outResult)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_completed.wait(lock, [this]() { return m_isComplete; });
+
+    outResult = m_compileResult;
+    return m_result;
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! DownstreamCompileJobPool !!!!!!!!!!!!!!!!!!!!!!*/
+
+namespace { // anonymous
+
+class DownstreamCompileTask : public ThreadPool::Task
+{
+public:
+    virtual void run() SLANG_OVERRIDE { m_job->_run(); }
+
+    DownstreamCompileTask(DownstreamCompileJob* job) : m_job(job) {}
+
+protected:
+    RefPtr<DownstreamCompileJob> m_job;
+};
+
+} // anonymous
+
+DownstreamCompileJobPool::DownstreamCompileJobPool(Index maxConcurrentCount)
+{
+    m_threadPool = new ThreadPool(maxConcurrentCount);
+}
+
+void DownstreamCompileJobPool::addJob(DownstreamCompileJob* job)
+{
+    m_threadPool->addTask(new DownstreamCompileTask(job));
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! DownstreamCompileResultCache !!!!!!!!!!!!!!!!!!!!!!*/
+
+static void _appendSizedList(SHA1& sha1, const List<String>& list)
+{
+    sha1.appendValue(uint64_t(list.getCount()));
+    for (const auto& item : list)
+    {
+        sha1.appendSized(item.getUnownedSlice());
+    }
+}
+
+/* static */void DownstreamCompileResultCache::appendCompilerToKey(DownstreamCompiler* compiler, SHA1& sha1)
+{
+    const auto& desc = compiler->getDesc();
+    sha1.appendValue(int32_t(desc.type));
+    sha1.appendValue(int64_t(desc.majorVersion));
+    sha1.appendValue(int64_t(desc.minorVersion));
+
+    // The size and modified time tell apart a compiler that was replaced in place. An executable found
+    // through the search path only has a filename, so only its version identifies it.
+    String path;
+    uint64_t size = 0;
+    uint64_t modifiedTime = 0;
+    if (SLANG_SUCCEEDED(compiler->getPath(path)))
+    {
+        File::getSizeAndModifiedTime(path, size, modifiedTime);
+    }
+    sha1.appendSized(path.getUnownedSlice());
+    sha1.appendValue(size);
+    sha1.appendValue(modifiedTime);
+}
+
+/* static */SlangResult DownstreamCompileResultCache::calcKey(DownstreamCompiler* compiler, const DownstreamCompiler::CompileOptions& options, Key& outKey)
+{
+    // The contents of source files could change without the options changing
+    if (options.sourceFiles.getCount())
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    SHA1 sha1;
+    appendCompilerToKey(compiler, sha1);
+
+    sha1.appendValue(int32_t(options.optimizationLevel));
+    sha1.appendValue(int32_t(options.debugInfoType));
+    sha1.appendValue(int32_t(options.targetType));
+    sha1.appendValue(int32_t(options.sourceLanguage));
+    sha1.appendValue(int32_t(options.floatingPointMode));
+    sha1.appendValue(int32_t(options.pipelineType));
+    sha1.appendValue(uint32_t(options.flags));
+    sha1.appendValue(int32_t(options.platform));
+
+    // The module path is only where the output is written (and is typically generated),
+    // the binary read back doesn't depend on it.
+
+    sha1.appendValue(uint64_t(options.defines.getCount()));
+    for (const auto& define : options.defines)
+    {
+        sha1.appendSized(define.nameWithSig.getUnownedSlice());
+        sha1.appendSized(define.value.getUnownedSlice());
+    }
+
+    sha1.appendSized(options.sourceContents.getUnownedSlice());
+    // The path can appear in diagnostics and debug info
+    sha1.appendSized(options.sourceContentsPath.getUnownedSlice());
+
+    _appendSizedList(sha1, options.includePaths);
+    _appendSizedList(sha1, options.libraryPaths);
+
+    sha1.appendValue(uint64_t(options.requiredCapabilityVersions.getCount()));
+    for (const auto& capabilityVersion : options.requiredCapabilityVersions)
+    {
+        sha1.appendValue(int32_t(capabilityVersion.kind));
+        sha1.appendValue(uint64_t(capabilityVersion.version.toInteger()));
+    }
+
+    outKey = sha1.finalize();
+    return SLANG_OK;
+}
+
+/* static */uint64_t DownstreamCompileResultCache::_calcSizeInBytes(const DownstreamDiagnostics& diagnostics, ISlangBlob* blob)
+{
+    uint64_t size = sizeof(Entry) + blob->getBufferSize() + diagnostics.rawDiagnostics.getLength();
+    for (const auto& diagnostic : diagnostics.diagnostics)
+    {
+        size += sizeof(diagnostic) + diagnostic.text.getLength() + diagnostic.code.getLength() + diagnostic.filePath.getLength();
+    }
+    return size;
+}
+
+RefPtr<DownstreamCompileResult> DownstreamCompileResultCache::find(const Key& key)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Entry* entry = m_entries.TryGetValue(key);
+    if (!entry)
+    {
+        m_missCount++;
+        return nullptr;
+    }
+
+    m_hitCount++;
+    entry->lastUsed = ++m_useCount;
+    return entry->result;
+}
+
+RefPtr<DownstreamCompileResult> DownstreamCompileResultCache::add(const Key& key, DownstreamCompileResult* result)
+{
+    const DownstreamDiagnostics& diagnostics = result->getDiagnostics();
+    if (SLANG_FAILED(diagnostics.result) || diagnostics.has(DownstreamDiagnostic::Type::Error))
+    {
+        return result;
+    }
+
+    ComPtr<ISlangBlob> binary;
+    if (SLANG_FAILED(result->getBinary(binary)) || !binary)
+    {
+        return result;
+    }
+
+    // Copy the binary, as the blob may be backed by temporary files that should be removed when the result is released
+    ComPtr<ISlangBlob> blob(new RawBlob(binary->getBufferPointer(), binary->getBufferSize()));
+
+    Entry entry;
+    entry.result = new BlobDownstreamCompileResult(diagnostics, blob);
+    entry.sizeInBytes = _calcSizeInBytes(diagnostics, blob);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // A result that can never fit isn't held
+    if (entry.sizeInBytes > m_maxSizeInBytes)
+    {
+        return result;
+    }
+
+    // Another thread could have compiled the same thing. Use the result that's already held.
+    if (Entry* existingEntry = m_entries.TryGetValue(key))
+    {
+        existingEntry->lastUsed = ++m_useCount;
+        return existingEntry->result;
+    }
+
+    entry.lastUsed = ++m_useCount;
+    m_totalSizeInBytes += entry.sizeInBytes;
+    m_entries.Add(key, entry);
+
+    _evictIfNeeded();
+    return entry.result;
+}
+
+void DownstreamCompileResultCache::_evictIfNeeded()
+{
+    while (m_totalSizeInBytes > m_maxSizeInBytes && m_entries.Count() > 0)
+    {
+        // Results are relatively large and few, so a linear search for the least recently used is fine
+        const Key* lruKey = nullptr;
+        const Entry* lruEntry = nullptr;
+        for (const auto& pair : m_entries)
+        {
+            if (lruEntry == nullptr || pair.Value.lastUsed < lruEntry->lastUsed)
+            {
+                lruKey = &pair.Key;
+                lruEntry = &pair.Value;
+            }
+        }
+
+        const Key key = *lruKey;
+        m_totalSizeInBytes -= lruEntry->sizeInBytes;
+        m_entries.Remove(key);
+        m_evictedCount++;
+    }
+}
+
+void DownstreamCompileResultCache::getStats(SlangDownstreamCompileResultCacheStats& outStats)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    outStats.hitCount = m_hitCount;
+    outStats.missCount = m_missCount;
+    outStats.evictedCount = m_evictedCount;
+    outStats.entryCount = uint64_t(m_entries.Count());
+    outStats.totalSizeInBytes = m_totalSizeInBytes;
+}
+
+void DownstreamCompileResultCache::setMaxSizeInBytes(uint64_t size)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxSizeInBytes = size;
+    _evictIfNeeded();
+}
+
+uint64_t DownstreamCompileResultCache::getMaxSizeInBytes()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_maxSizeInBytes;
+}
+
 /* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! DownstreamDiagnostics !!!!!!!!!!!!!!!!!!!!!!*/
 
 Index DownstreamDiagnostics::getCountByType(Diagnostic::Type type) const
@@ -577,6 +849,14 @@ const DownstreamCompiler::Desc& DownstreamCompilerUtil::getCompiledWithDesc()
     }
 }
 
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! SharedLibraryDownstreamCompiler !!!!!!!!!!!!!!!!!!!!!!*/
+
+SlangResult SharedLibraryDownstreamCompiler::getPath(String& outPath)
+{
+    SlangFuncPtr func = m_library->findFuncByName(m_funcName);
+    return func ? SharedLibrary::getPathFromSymbolAddress((const void*)func, outPath) : SLANG_E_NOT_AVAILABLE;
+}
+
 static SlangResult _locateDXCCompilers(const String& path, ISlangSharedLibraryLoader* loader, DownstreamCompilerSet* set)
 {
     // First try dxil, so it's loaded from the same path if it's there
@@ -588,7 +868,7 @@ static SlangResult _locateDXCCompilers(const String& path, ISlangSharedLibraryLo
     {
         // Can we determine the version?
         DownstreamCompiler::Desc desc(SLANG_PASS_THROUGH_DXC);
-        RefPtr<DownstreamCompiler> compiler(new SharedLibraryDownstreamCompiler(desc, sharedLibrary));
+        RefPtr<DownstreamCompiler> compiler(new SharedLibraryDownstreamCompiler(desc, sharedLibrary, "DxcCreateInstance"));
 
         set->addCompiler(compiler);
     }
@@ -602,7 +882,7 @@ static SlangResult _locateFXCCompilers(const String& path, ISlangSharedLibraryLo
     {
         // Can we determine the version?
         DownstreamCompiler::Desc desc(SLANG_PASS_THROUGH_FXC);
-        RefPtr<DownstreamCompiler> compiler(new SharedLibraryDownstreamCompiler(desc, sharedLibrary));
+        RefPtr<DownstreamCompiler> compiler(new SharedLibraryDownstreamCompiler(desc, sharedLibrary, "D3DCompile"));
         set->addCompiler(compiler);
     }
     return SLANG_OK;
@@ -615,7 +895,7 @@ static SlangResult _locateGlslangCompilers(const String& path, ISlangSharedLibra
     {
         // Can we determine the version?
         DownstreamCompiler::Desc desc(SLANG_PASS_THROUGH_GLSLANG);
-        RefPtr<DownstreamCompiler> compiler(new SharedLibraryDownstreamCompiler(desc, sharedLibrary));
+        RefPtr<DownstreamCompiler> compiler(new SharedLibraryDownstreamCompiler(desc, sharedLibrary, "glslang_compile"));
         set->addCompiler(compiler);
     }
     return SLANG_OK;
@@ -10,6 +10,9 @@
 #include "slang-semantic-version.h"
 
 #include "slang-io.h"
+#include "slang-thread-pool.h"
+#include "slang-sha1.h"
+#include "slang-dictionary.h"
 
 #include "../../slang-com-ptr.h"
 
@@ -114,6 +117,9 @@ protected:
     ComPtr<ISlangBlob> m_blob;
 };
 
+class DownstreamCompileJob;
+class DownstreamCompileJobPool;
+
 class DownstreamCompiler: public RefObject
 {
 public:
@@ -195,6 +201,15 @@ public:
         Precise,
     };
 
+        /// SIMD instructions the output can use (on processors that have them).
+    enum class SIMDMode
+    {
+        Default,    ///< Whatever the compiler targets by default
+        SSE,        ///< SSE up to 4.2
+        AVX2,       ///< AVX2 with FMA
+        AVX512,     ///< AVX-512 foundation
+    };
+
     enum TargetType
     {
         Executable,         ///< Produce an executable
@@ -244,6 +259,7 @@ public:
         TargetType targetType = TargetType::Executable;
         SlangSourceLanguage sourceLanguage = SLANG_SOURCE_LANGUAGE_CPP;
         FloatingPointMode floatingPointMode = FloatingPointMode::Default;
+        SIMDMode simdMode = SIMDMode::Default;
         PipelineType pipelineType = PipelineType::Unknown;
 
         Flags flags = Flag::EnableExceptionHandling;
@@ -299,8 +315,15 @@ public:
     const Desc& getDesc() const { return m_desc;  }
         /// Compile using the specified options. The result is in resOut
     virtual SlangResult compile(const CompileOptions& options, RefPtr<DownstreamCompileResult>& outResult) = 0;
+        /// Start compiling using the specified options on the pool, without waiting for the compile to complete.
+        /// The options are copied, so don't need to stay in scope. The result is obtained via outJob.
+        /// The default implementation runs `compile` on one of the pool's threads.
+    virtual SlangResult compileAsync(const CompileOptions& options, DownstreamCompileJobPool* pool, RefPtr<DownstreamCompileJob>& outJob);
         /// Some downstream compilers are backed by a shared library. This allows access to the shared library to access internal functions. 
     virtual ISlangSharedLibrary* getSharedLibrary() { return nullptr; }
+        /// Get the path of the executable or shared library that implements the compiler, if it can be determined.
+        /// For an executable that is found through the search path, this is just its filename.
+    virtual SlangResult getPath(String& outPath) { SLANG_UNUSED(outPath); return SLANG_E_NOT_AVAILABLE; }
 
         /// Get info for a compiler type
     static const Info& getInfo(SlangPassThrough compiler) { return s_infos.infos[int(compiler)]; }
@@ -321,6 +344,124 @@ protected:
     Desc m_desc;
 };
 
+/* A compile that has been started with DownstreamCompiler::compileAsync, and may not have completed yet. */
+class DownstreamCompileJob : public RefObject
+{
+public:
+    typedef RefObject Super;
+
+        /// True if the compile has completed, such that `waitForResult` will not block
+    bool isComplete();
+        /// Blocks until the compile has completed. Returns the result of the compile, with the compile result in outResult
+    SlangResult waitForResult(RefPtr<DownstreamCompileResult>& outResult);
+
+        /// Performs the compile, and signals completion. Called on one of the pool's threads.
+    void _run();
+
+    DownstreamCompileJob(DownstreamCompiler* compiler, const DownstreamCompiler::CompileOptions& options):
+        m_compiler(compiler),
+        m_options(options)
+    {
+    }
+
+protected:
+    RefPtr<DownstreamCompiler> m_compiler;
+    DownstreamCompiler::CompileOptions m_options;
+
+    std::mutex m_mutex;
+    std::condition_variable m_completed;
+    bool m_isComplete = false;
+    SlangResult m_result = SLANG_OK;
+    RefPtr<DownstreamCompileResult> m_compileResult;
+};
+
+/* Runs downstream compiles asynchronously. The amount of compiles that run at the same time is bounded by the
+amount of threads in the pool, other compiles wait until a thread becomes free. */
+class DownstreamCompileJobPool : public RefObject
+{
+public:
+    typedef RefObject Super;
+
+        /// Add a job to be run when a thread becomes available
+    void addJob(DownstreamCompileJob* job);
+
+        /// Get the maximum amount of compiles that can run at the same time
+    Index getMaxConcurrentCount() const { return m_threadPool->getThreadCount(); }
+
+        /// Ctor. If maxConcurrentCount is 0, the amount of hardware threads is used.
+    DownstreamCompileJobPool(Index maxConcurrentCount);
+
+protected:
+    RefPtr<ThreadPool> m_threadPool;
+};
+
+/* An in memory cache of the results of downstream compiles. The key is a digest of the compiler and all of the
+compile options, including the source contents - so compiling source identical to an earlier compile (as is common when
+the same code is generated for different requests) can return the earlier result without invoking the compiler.
+
+Only successful compiles are held. The result held is immutable - its binary is copied when added, so it doesn't
+depend on any temporary files, and can be used from multiple threads. As a consequence a result from the cache can't
+provide a host callable shared library (each use needs its own loaded library, with its own global state), so compiles
+whose result is used that way shouldn't use the cache. Compiles of source files can't be keyed by their options alone,
+so aren't cached.
+
+When the estimated total size of the results exceeds the maximum, the least recently used are evicted. */
+class DownstreamCompileResultCache : public RefObject
+{
+public:
+    typedef RefObject Super;
+    typedef SHA1::Digest Key;
+
+        /// Calculate the key for compiling with options on compiler.
+        /// Returns SLANG_E_NOT_AVAILABLE if the result of the compile can't be cached.
+    static SlangResult calcKey(DownstreamCompiler* compiler, const DownstreamCompiler::CompileOptions& options, Key& outKey);
+        /// Append what identifies compiler to sha1 - its type, version, and its file (path, size and modified time) as not
+        /// all compilers report a version. Compiles that invoke a compiler's library directly (as for fxc, dxc and glslang)
+        /// key on this, followed by their arguments and source.
+    static void appendCompilerToKey(DownstreamCompiler* compiler, SHA1& sha1);
+
+        /// Find the result for the key. Returns nullptr (and counts a miss) if there isn't one.
+    RefPtr<DownstreamCompileResult> find(const Key& key);
+        /// Add the result of compiling, and return the result to use in its place (which is what is held in the cache).
+        /// If the result can't be held (for example because the compile failed), result is returned.
+    RefPtr<DownstreamCompileResult> add(const Key& key, DownstreamCompileResult* result);
+
+        /// Get stats about the use of the cache, and what it holds
+    void getStats(SlangDownstreamCompileResultCacheStats& outStats);
+
+        /// Set the maximum estimated total size of the results held. Evicts results if needed.
+    void setMaxSizeInBytes(uint64_t size);
+    uint64_t getMaxSizeInBytes();
+
+        /// Ctor
+    DownstreamCompileResultCache(uint64_t maxSizeInBytes):
+        m_maxSizeInBytes(maxSizeInBytes)
+    {
+    }
+
+protected:
+    struct Entry
+    {
+        RefPtr<DownstreamCompileResult> result;
+        uint64_t sizeInBytes;
+        uint64_t lastUsed;                  ///< Value of m_useCount when the entry was last used
+    };
+
+    static uint64_t _calcSizeInBytes(const DownstreamDiagnostics& diagnostics, ISlangBlob* blob);
+    void _evictIfNeeded();
+
+    std::mutex m_mutex;                     ///< Guards all of the state below, as compiles can be on multiple threads
+
+    Dictionary<Key, Entry> m_entries;
+    uint64_t m_maxSizeInBytes;
+    uint64_t m_totalSizeInBytes = 0;
+    uint64_t m_useCount = 0;
+
+    uint64_t m_hitCount = 0;
+    uint64_t m_missCount = 0;
+    uint64_t m_evictedCount = 0;
+};
+
 class CommandLineDownstreamCompileResult : public DownstreamCompileResult
 {
 public:
@@ -367,6 +508,8 @@ public:
     virtual SlangResult calcArgs(const CompileOptions& options, CommandLine& cmdLine) = 0;
     virtual SlangResult parseOutput(const ExecuteResult& exeResult, DownstreamDiagnostics& output) = 0;
 
+    virtual SlangResult getPath(String& outPath) SLANG_OVERRIDE { outPath = m_cmdLine.m_executable; return outPath.getLength() ? SLANG_OK : SLANG_E_NOT_AVAILABLE; }
+
     CommandLineDownstreamCompiler(const Desc& desc, const String& exeName) :
         Super(desc)
     {
@@ -391,14 +534,18 @@ public:
     // DownstreamCompiler
     virtual SlangResult compile(const CompileOptions& options, RefPtr<DownstreamCompileResult>& outResult) SLANG_OVERRIDE { SLANG_UNUSED(options); SLANG_UNUSED(outResult); return SLANG_E_NOT_IMPLEMENTED; }
     virtual ISlangSharedLibrary* getSharedLibrary() SLANG_OVERRIDE { return m_library; }
+    virtual SlangResult getPath(String& outPath) SLANG_OVERRIDE;
 
-    SharedLibraryDownstreamCompiler(const Desc& desc, ISlangSharedLibrary* library):
+        /// funcName is the name of a function the library exports, that is used to find the path of the library
+    SharedLibraryDownstreamCompiler(const Desc& desc, ISlangSharedLibrary* library, const char* funcName):
         Super(desc),
-        m_library(library)
+        m_library(library),
+        m_funcName(funcName)
     {
     }
 protected:
     ComPtr<ISlangSharedLibrary> m_library;
+    const char* m_funcName;
 };
 
 class DownstreamCompilerSet : public RefObject
@@ -452,6 +599,7 @@ struct DownstreamCompilerBaseUtil
     typedef DownstreamDiagnostics::Diagnostic Diagnostic;
 
     typedef DownstreamCompiler::FloatingPointMode FloatingPointMode;
+    typedef DownstreamCompiler::SIMDMode SIMDMode;
     typedef DownstreamCompiler::ProductFlag ProductFlag;
     typedef DownstreamCompiler::ProductFlags ProductFlags;
 };
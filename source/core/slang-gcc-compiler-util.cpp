@@ -501,6 +501,29 @@ static SlangResult _parseGCCFamilyLine(const UnownedStringSlice& line, LineParse
         }
     }
 
+    if (options.simdMode != SIMDMode::Default)
+    {
+        // Loops marked with SLANG_SIMD_LOOP are vectorized, even at -O2 for older gcc versions
+        cmdLine.addArg("-ftree-vectorize");
+
+        // The instruction set flags only make sense on x86/x64. On other processors the compiler's
+        // default (say NEON on arm64) is used.
+#if SLANG_PROCESSOR_FAMILY_X86
+        switch (options.simdMode)
+        {
+            case SIMDMode::SSE:     cmdLine.addArg("-msse4.2"); break;
+            case SIMDMode::AVX2:
+            {
+                cmdLine.addArg("-mavx2");
+                cmdLine.addArg("-mfma");
+                break;
+            }
+            case SIMDMode::AVX512:  cmdLine.addArg("-mavx512f"); break;
+            default: break;
+        }
+#endif
+    }
+
     StringBuilder moduleFilePath;
     calcModuleFilePath(options, moduleFilePath);
 
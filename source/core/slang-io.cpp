@@ -11,6 +11,7 @@
 
 #ifdef _WIN32
 #   include <direct.h>
+#   include <sys/utime.h>
 
 #   define WIN32_LEAN_AND_MEAN
 #   define VC_EXTRALEAN
@@ -24,6 +25,10 @@
 
 #   include <dirent.h>
 #   include <sys/stat.h>
+#   include <utime.h>
+// For MappedFileBlob
+#   include <fcntl.h>
+#   include <sys/mman.h>
 #endif
 
 #if SLANG_APPLE_FAMILY
@@ -31,6 +36,7 @@
 #endif
 
 #include <limits.h> /* PATH_MAX */
+#include <stdint.h> /* SIZE_MAX */
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -56,6 +62,25 @@ namespace Slang
 #endif
     }
 
+    /* static */SlangResult File::rename(const String& fromFileName, const String& toFileName)
+    {
+#ifdef _WIN32
+        // https://docs.microsoft.com/en-us/windows/win32/api/winbase/nf-winbase-movefileexa
+        if (MoveFileExA(fromFileName.getBuffer(), toFileName.getBuffer(), MOVEFILE_REPLACE_EXISTING))
+        {
+            return SLANG_OK;
+        }
+        return SLANG_FAIL;
+#else
+        // https://linux.die.net/man/2/rename
+        if (::rename(fromFileName.getBuffer(), toFileName.getBuffer()) == 0)
+        {
+            return SLANG_OK;
+        }
+        return SLANG_FAIL;
+#endif
+    }
+
 
 #ifdef _WIN32
     /* static */SlangResult File::generateTemporary(const UnownedStringSlice& inPrefix, Slang::String& outFileName)
@@ -160,6 +185,35 @@ namespace Slang
 #endif
     }
 
+    /* static */SlangResult File::getSizeAndModifiedTime(const String& fileName, uint64_t& outSize, uint64_t& outModifiedTime)
+    {
+#ifdef _WIN32
+        struct _stat64 statVar;
+        if (::_wstat64(((String)fileName).toWString(), &statVar) != 0)
+        {
+            return SLANG_E_NOT_FOUND;
+        }
+#else
+        struct stat statVar;
+        if (::stat(fileName.getBuffer(), &statVar) != 0)
+        {
+            return SLANG_E_NOT_FOUND;
+        }
+#endif
+        outSize = uint64_t(statVar.st_size);
+        outModifiedTime = uint64_t(statVar.st_mtime);
+        return SLANG_OK;
+    }
+
+    /* static */SlangResult File::updateModifiedTime(const String& fileName)
+    {
+#ifdef _WIN32
+        return ::_wutime(((String)fileName).toWString(), nullptr) == 0 ? SLANG_OK : SLANG_FAIL;
+#else
+        return ::utime(fileName.getBuffer(), nullptr) == 0 ? SLANG_OK : SLANG_FAIL;
+#endif
+    }
+
     String Path::replaceExt(const String& path, const char* newExt)
     {
         StringBuilder sb(path.getLength() + 10);
@@ -795,6 +849,92 @@ namespace Slang
         writer.Write(text);
     }
 
+    /* static */SlangResult MappedFileBlob::create(const String& path, RefPtr<MappedFileBlob>& outBlob)
+    {
+#ifdef _WIN32
+        // Sharing allows the file to be written or deleted by others while mapped, as with FileShare::ReadWrite
+        HANDLE fileHandle = ::CreateFileW(path.toWString(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE)
+        {
+            return SLANG_E_CANNOT_OPEN;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!::GetFileSizeEx(fileHandle, &fileSize) || uint64_t(fileSize.QuadPart) > uint64_t(SIZE_MAX))
+        {
+            ::CloseHandle(fileHandle);
+            return SLANG_FAIL;
+        }
+        if (fileSize.QuadPart == 0)
+        {
+            ::CloseHandle(fileHandle);
+            return SLANG_E_NOT_AVAILABLE;
+        }
+
+        HANDLE mappingHandle = ::CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        ::CloseHandle(fileHandle);
+        if (!mappingHandle)
+        {
+            return SLANG_FAIL;
+        }
+
+        // The view keeps the mapping alive, so the handle isn't needed after this
+        const void* data = ::MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+        ::CloseHandle(mappingHandle);
+        if (!data)
+        {
+            return SLANG_FAIL;
+        }
+
+        outBlob = new MappedFileBlob(data, size_t(fileSize.QuadPart));
+        return SLANG_OK;
+#elif defined(__linux__) || defined(__CYGWIN__) || SLANG_APPLE_FAMILY
+        const int fd = ::open(path.getBuffer(), O_RDONLY);
+        if (fd < 0)
+        {
+            return SLANG_E_CANNOT_OPEN;
+        }
+
+        struct stat statVar;
+        if (::fstat(fd, &statVar) != 0 || statVar.st_size < 0 || uint64_t(statVar.st_size) > uint64_t(SIZE_MAX))
+        {
+            ::close(fd);
+            return SLANG_FAIL;
+        }
+        if (statVar.st_size == 0)
+        {
+            ::close(fd);
+            return SLANG_E_NOT_AVAILABLE;
+        }
+
+        const size_t size = size_t(statVar.st_size);
+        // The mapping stays valid after the file is closed
+        void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED)
+        {
+            return SLANG_FAIL;
+        }
+
+        outBlob = new MappedFileBlob(data, size);
+        return SLANG_OK;
+#else
+        SLANG_UNUSED(path);
+        SLANG_UNUSED(outBlob);
+        return SLANG_E_NOT_IMPLEMENTED;
+#endif
+    }
+
+    MappedFileBlob::~MappedFileBlob()
+    {
+#ifdef _WIN32
+        ::UnmapViewOfFile(m_data);
+#elif defined(__linux__) || defined(__CYGWIN__) || SLANG_APPLE_FAMILY
+        ::munmap(const_cast<void*>(m_data), m_size);
+#endif
+    }
+
 
 }
 
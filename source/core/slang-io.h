@@ -5,6 +5,7 @@
 #include "slang-stream.h"
 #include "slang-text-io.h"
 #include "slang-secure-crt.h"
+#include "slang-blob.h"
 
 namespace Slang
 {
@@ -16,12 +17,45 @@ namespace Slang
 		static List<unsigned char> readAllBytes(const String& fileName);
 		static void writeAllText(const String& fileName, const String& text);
         static SlangResult remove(const String& fileName);
+            /// Rename the file, replacing any file at toFileName. Within a directory the replacement is atomic,
+            /// so something opening toFileName sees either the old file or the new one, never a partial file.
+        static SlangResult rename(const String& fromFileName, const String& toFileName);
 
         static SlangResult makeExecutable(const String& fileName);
 
         static SlangResult generateTemporary(const UnownedStringSlice& prefix, String& outFileName);
+
+            /// Get the size of the file in bytes, and the time it was last modified (in seconds since the epoch)
+        static SlangResult getSizeAndModifiedTime(const String& fileName, uint64_t& outSize, uint64_t& outModifiedTime);
+            /// Set the time the file was last modified to now
+        static SlangResult updateModifiedTime(const String& fileName);
 	};
 
+        /// A blob holding a read only memory mapping of the whole of a file. The contents are shared
+        /// with the OS page cache, so are not copied, and pages are only read when first accessed.
+        ///
+        /// The mapping lasts as long as the blob, so it should only be used where the file is known not to
+        /// change in that time. On most platforms truncating the file makes accessing pages past the new end
+        /// a fault, and on Windows the file can't be modified at all while it is mapped.
+    class MappedFileBlob : public BlobBase
+    {
+    public:
+        // ISlangBlob
+        SLANG_NO_THROW void const* SLANG_MCALL getBufferPointer() SLANG_OVERRIDE { return m_data; }
+        SLANG_NO_THROW size_t SLANG_MCALL getBufferSize() SLANG_OVERRIDE { return m_size; }
+
+            /// Map the file at path. Empty files can't be mapped, and return SLANG_E_NOT_AVAILABLE.
+        static SlangResult create(const String& path, RefPtr<MappedFileBlob>& outBlob);
+
+        ~MappedFileBlob();
+
+    protected:
+        MappedFileBlob(const void* data, size_t size) : m_data(data), m_size(size) {}
+
+        const void* m_data;
+        size_t m_size;
+    };
+
 	class Path
 	{
 	public:
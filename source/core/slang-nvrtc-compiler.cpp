@@ -97,6 +97,7 @@ public:
     // DownstreamCompiler
     virtual SlangResult compile(const CompileOptions& options, RefPtr<DownstreamCompileResult>& outResult) SLANG_OVERRIDE;
     virtual ISlangSharedLibrary* getSharedLibrary() SLANG_OVERRIDE { return m_sharedLibrary; }
+    virtual SlangResult getPath(String& outPath) SLANG_OVERRIDE { return SharedLibrary::getPathFromSymbolAddress((const void*)m_nvrtcVersion, outPath); }
 
         /// Must be called before use
     SlangResult init(ISlangSharedLibrary* library);
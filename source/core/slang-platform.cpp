@@ -134,6 +134,24 @@ SLANG_COMPILE_TIME_ASSERT(E_OUTOFMEMORY == SLANG_E_OUT_OF_MEMORY);
     return GetProcAddress((HMODULE)handle, name);
 }
 
+/* static */SlangResult SharedLibrary::getPathFromSymbolAddress(const void* address, String& outPath)
+{
+    HMODULE module = nullptr;
+    if (!::GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT, (LPCSTR)address, &module))
+    {
+        return SLANG_FAIL;
+    }
+
+    char path[MAX_PATH];
+    const DWORD length = ::GetModuleFileNameA(module, path, DWORD(SLANG_COUNT_OF(path)));
+    if (length == 0 || length >= DWORD(SLANG_COUNT_OF(path)))
+    {
+        return SLANG_FAIL;
+    }
+    outPath = String(path, path + length);
+    return SLANG_OK;
+}
+
 /* static */void SharedLibrary::appendPlatformFileName(const UnownedStringSlice& name, StringBuilder& dst)
 {
     dst.Append(name);
@@ -179,6 +197,17 @@ SLANG_COMPILE_TIME_ASSERT(E_OUTOFMEMORY == SLANG_E_OUT_OF_MEMORY);
 	return dlsym((void*)handle, name);
 }
 
+/* static */SlangResult SharedLibrary::getPathFromSymbolAddress(const void* address, String& outPath)
+{
+    Dl_info info;
+    if (!dladdr(address, &info) || !info.dli_fname)
+    {
+        return SLANG_FAIL;
+    }
+    outPath = info.dli_fname;
+    return SLANG_OK;
+}
+
 /* static */void SharedLibrary::appendPlatformFileName(const UnownedStringSlice& name, StringBuilder& dst)
 {
 #if __CYGWIN__
@@ -98,6 +98,10 @@ namespace Slang
             /// @param The shared library handle as returned by loadPlatformLibrary
         static void* findSymbolAddressByName(Handle handle, char const* name);
 
+            /// Get the path of the shared library (or executable) that holds the symbol at address
+            /// @param address The address of a symbol, such as returned by findSymbolAddressByName
+        static SlangResult getPathFromSymbolAddress(const void* address, String& outPath);
+
             /// Append to the end of dst, the name, with any platform specific additions
             /// The input name should be unadorned with any 'lib' prefix or extension
         static void appendPlatformFileName(const UnownedStringSlice& name, StringBuilder& dst);
@@ -0,0 +1,176 @@
+#include "slang-sha1.h"
+
+namespace Slang {
+
+static SLANG_FORCE_INLINE uint32_t _rotateLeft(uint32_t value, int shift)
+{
+    return (value << shift) | (value >> (32 - shift));
+}
+
+String SHA1::Digest::toString() const
+{
+    static const char kHexChars[] = "0123456789abcdef";
+
+    StringBuilder builder;
+    for (Index i = 0; i < kSize; ++i)
+    {
+        builder.appendChar(kHexChars[data[i] >> 4]);
+        builder.appendChar(kHexChars[data[i] & 0xf]);
+    }
+    return builder.ProduceString();
+}
+
+void SHA1::reset()
+{
+    m_state[0] = 0x67452301;
+    m_state[1] = 0xefcdab89;
+    m_state[2] = 0x98badcfe;
+    m_state[3] = 0x10325476;
+    m_state[4] = 0xc3d2e1f0;
+
+    m_totalSize = 0;
+    m_blockSize = 0;
+}
+
+void SHA1::_processBlock(const uint8_t* block)
+{
+    uint32_t w[80];
+    for (int i = 0; i < 16; ++i)
+    {
+        w[i] = (uint32_t(block[i * 4 + 0]) << 24) |
+            (uint32_t(block[i * 4 + 1]) << 16) |
+            (uint32_t(block[i * 4 + 2]) << 8) |
+            uint32_t(block[i * 4 + 3]);
+    }
+    for (int i = 16; i < 80; ++i)
+    {
+        w[i] = _rotateLeft(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+    }
+
+    uint32_t a = m_state[0];
+    uint32_t b = m_state[1];
+    uint32_t c = m_state[2];
+    uint32_t d = m_state[3];
+    uint32_t e = m_state[4];
+
+    for (int i = 0; i < 80; ++i)
+    {
+        uint32_t f, k;
+        if (i < 20)
+        {
+            f = (b & c) | (~b & d);
+            k = 0x5a827999;
+        }
+        else if (i < 40)
+        {
+            f = b ^ c ^ d;
+            k = 0x6ed9eba1;
+        }
+        else if (i < 60)
+        {
+            f = (b & c) | (b & d) | (c & d);
+            k = 0x8f1bbcdc;
+        }
+        else
+        {
+            f = b ^ c ^ d;
+            k = 0xca62c1d6;
+        }
+
+        const uint32_t temp = _rotateLeft(a, 5) + f + e + k + w[i];
+        e = d;
+        d = c;
+        c = _rotateLeft(b, 30);
+        b = a;
+        a = temp;
+    }
+
+    m_state[0] += a;
+    m_state[1] += b;
+    m_state[2] += c;
+    m_state[3] += d;
+    m_state[4] += e;
+}
+
+void SHA1::append(const void* inData, size_t size)
+{
+    const uint8_t* data = (const uint8_t*)inData;
+    m_totalSize += size;
+
+    // Complete a partially filled block
+    if (m_blockSize > 0)
+    {
+        const size_t copySize = (size < sizeof(m_block) - m_blockSize) ? size : (sizeof(m_block) - m_blockSize);
+        ::memcpy(m_block + m_blockSize, data, copySize);
+        m_blockSize += copySize;
+        data += copySize;
+        size -= copySize;
+
+        if (m_blockSize < sizeof(m_block))
+        {
+            return;
+        }
+        _processBlock(m_block);
+        m_blockSize = 0;
+    }
+
+    // Process whole blocks directly from the data
+    while (size >= sizeof(m_block))
+    {
+        _processBlock(data);
+        data += sizeof(m_block);
+        size -= sizeof(m_block);
+    }
+
+    ::memcpy(m_block, data, size);
+    m_blockSize = size;
+}
+
+void SHA1::appendSized(const UnownedStringSlice& slice)
+{
+    appendValue(uint64_t(slice.getLength()));
+    append(slice);
+}
+
+SHA1::Digest SHA1::finalize()
+{
+    const uint64_t totalBits = m_totalSize * 8;
+
+    // Pad with a single 1 bit, then zeros until there are 8 bytes left in the block for the length
+    const uint8_t padStart = 0x80;
+    append(&padStart, 1);
+    const uint8_t zero = 0;
+    while (m_blockSize != sizeof(m_block) - 8)
+    {
+        append(&zero, 1);
+    }
+
+    uint8_t sizeBytes[8];
+    for (int i = 0; i < 8; ++i)
+    {
+        sizeBytes[i] = uint8_t(totalBits >> (56 - i * 8));
+    }
+    append(sizeBytes, 8);
+    SLANG_ASSERT(m_blockSize == 0);
+
+    Digest digest;
+    for (int i = 0; i < 5; ++i)
+    {
+        digest.data[i * 4 + 0] = uint8_t(m_state[i] >> 24);
+        digest.data[i * 4 + 1] = uint8_t(m_state[i] >> 16);
+        digest.data[i * 4 + 2] = uint8_t(m_state[i] >> 8);
+        digest.data[i * 4 + 3] = uint8_t(m_state[i]);
+    }
+
+    reset();
+    return digest;
+}
+
+/* static */SHA1::Digest SHA1::compute(const void* data, size_t size)
+{
+    SHA1 sha1;
+    sha1.append(data, size);
+    return sha1.finalize();
+}
+
+} // namespace Slang
@@ -0,0 +1,64 @@
+#ifndef SLANG_CORE_SHA1_H
+#define SLANG_CORE_SHA1_H
+
+#include "slang-string.h"
+
+namespace Slang {
+
+/* Calculates the SHA-1 digest of a sequence of bytes.
+
+Unlike the hashes in slang-hash.h, the digest is long enough that it can be used to identify content
+(for example as the key of an on-disk cache) - collisions don't happen in practice. */
+class SHA1
+{
+public:
+    struct Digest
+    {
+        enum { kSize = 20 };
+
+            /// Get as lower case hex text (40 characters)
+        String toString() const;
+
+        bool operator==(const Digest& rhs) const { return ::memcmp(data, rhs.data, kSize) == 0; }
+        bool operator!=(const Digest& rhs) const { return !(*this == rhs); }
+
+            /// The digest is already well distributed, so the leading bytes are used as the hash
+        HashCode getHashCode() const { HashCode hash; ::memcpy(&hash, data, sizeof(hash)); return hash; }
+
+        uint8_t data[kSize];
+    };
+
+        /// Add data to be hashed
+    void append(const void* data, size_t size);
+        /// Add the chars of the slice to be hashed
+    void append(const UnownedStringSlice& slice) { append(slice.begin(), slice.getLength()); }
+        /// Add the size of the slice, followed by its chars. Makes the boundary between slices part of the digest,
+        /// such that ("ab", "c") has a different digest to ("a", "bc").
+    void appendSized(const UnownedStringSlice& slice);
+        /// Add a value to be hashed. Should only be used for types without padding.
+    template <typename T>
+    void appendValue(const T& value) { append(&value, sizeof(T)); }
+
+        /// Get the digest of all of the data appended. Resets, such that another digest can be calculated.
+    Digest finalize();
+
+        /// Reset to the initial state, as if nothing was appended
+    void reset();
+
+        /// Calculate the digest of data
+    static Digest compute(const void* data, size_t size);
+
+    SHA1() { reset(); }
+
+protected:
+    void _processBlock(const uint8_t* block);
+
+    uint32_t m_state[5];
+    uint64_t m_totalSize;               ///< The total amount of bytes appended
+    uint8_t m_block[64];                ///< Data appended, that is not yet a complete block
+    size_t m_blockSize;                 ///< The amount of bytes held in m_block
+};
+
+} // namespace Slang
+
+#endif
@@ -7,13 +7,18 @@
 
 #include "../../slang.h"
 
+#include <atomic>
+
 namespace Slang
 {
     // Base class for all reference-counted objects
+    //
+    // The reference count is atomic, so references to an object can be taken and released
+    // from multiple threads (for example a Session and its stdlib shared between compiles).
     class RefObject
     {
     private:
-        UInt referenceCount;
+        std::atomic<UInt> referenceCount;
 
     public:
         RefObject()
@@ -24,41 +29,44 @@ namespace Slang
             : referenceCount(0)
         {}
 
-        RefObject& operator=(const RefObject& rhs) = default;
+            /// The reference count belongs to the object, and so is not assigned
+        RefObject& operator=(const RefObject&) { return *this; }
 
         virtual ~RefObject()
         {}
 
         UInt addReference()
         {
-            return ++referenceCount;
+            return referenceCount.fetch_add(1, std::memory_order_relaxed) + 1;
         }
 
         UInt decreaseReference()
         {
-            return --referenceCount;
+            return referenceCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
         }
 
         UInt releaseReference()
         {
-            SLANG_ASSERT(referenceCount != 0);
-            if(--referenceCount == 0)
+            SLANG_ASSERT(referenceCount.load(std::memory_order_relaxed) != 0);
+            const UInt count = referenceCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
+            if(count == 0)
             {
                 delete this;
                 return 0;
             }
-            return referenceCount;
+            return count;
         }
 
         bool isUniquelyReferenced()
         {
-            SLANG_ASSERT(referenceCount != 0);
-            return referenceCount == 1;
+            const UInt count = referenceCount.load(std::memory_order_acquire);
+            SLANG_ASSERT(count != 0);
+            return count == 1;
         }
 
         UInt debugGetReferenceCount()
         {
-            return referenceCount;
+            return referenceCount.load(std::memory_order_relaxed);
         }
     };
 
@@ -2,6 +2,17 @@
 
 #include "slang-blob.h"
 
+#if SLANG_PROCESSOR_X86_64 || (SLANG_PROCESSOR_X86 && (defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)))
+#   define SLANG_STRING_UTIL_USE_SSE2 1
+#   include <emmintrin.h>
+#else
+#   define SLANG_STRING_UTIL_USE_SSE2 0
+#endif
+
+#if SLANG_VC
+#   include <intrin.h>
+#endif
+
 namespace Slang {
 
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! StringUtil !!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -360,6 +371,86 @@ ComPtr<ISlangBlob> StringUtil::createStringBlob(const String& string)
     }
 }
 
+// Records the start of the line following the line break character at cursor. Returns where to continue scanning from.
+SLANG_FORCE_INLINE static const char* _addLineStart(const char* begin, const char* cursor, const char* end, List<uint32_t>& outOffsets)
+{
+    const char c = *cursor++;
+    // A \r\n or \n\r pair is a single line break
+    if (cursor < end && (c ^ *cursor) == ('\r' ^ '\n'))
+    {
+        cursor++;
+    }
+    outOffsets.add(uint32_t(cursor - begin));
+    return cursor;
+}
+
+/* static */void StringUtil::calcLineStartOffsets(const UnownedStringSlice& text, List<uint32_t>& outOffsets)
+{
+    outOffsets.clear();
+
+    const char* const begin = text.begin();
+    const char* const end = text.end();
+    // Matches extractLine, which produces no lines for the 'null' slice
+    if (begin == nullptr)
+    {
+        return;
+    }
+
+    outOffsets.add(0);
+
+    const char* cursor = begin;
+#if SLANG_STRING_UTIL_USE_SSE2
+    const __m128i newLines = _mm_set1_epi8('\n');
+    const __m128i returns = _mm_set1_epi8('\r');
+    while (end - cursor >= 16)
+    {
+        const __m128i chars = _mm_loadu_si128((const __m128i*)cursor);
+        uint32_t mask = uint32_t(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chars, newLines), _mm_cmpeq_epi8(chars, returns))));
+        if (mask == 0)
+        {
+            cursor += 16;
+            continue;
+        }
+
+        const char* const blockBegin = cursor;
+        const char* next = blockBegin;
+        do
+        {
+#if SLANG_VC
+            unsigned long index;
+            _BitScanForward(&index, mask);
+#else
+            const int index = __builtin_ctz(mask);
+#endif
+            mask &= mask - 1;
+
+            const char* lineBreak = blockBegin + index;
+            // Skip the second character of a pair
+            if (lineBreak >= next)
+            {
+                next = _addLineStart(begin, lineBreak, end, outOffsets);
+            }
+        }
+        while (mask);
+
+        // Continue at the end of the block, unless the last line break was a pair that crossed into the next block
+        cursor = (next > blockBegin + 16) ? next : blockBegin + 16;
+    }
+#endif
+
+    while (cursor < end)
+    {
+        if (*cursor == '\n' || *cursor == '\r')
+        {
+            cursor = _addLineStart(begin, cursor, end, outOffsets);
+        }
+        else
+        {
+            cursor++;
+        }
+    }
+}
+
 /* static */bool StringUtil::areLinesEqual(const UnownedStringSlice& inA, const UnownedStringSlice& inB)
 {
     UnownedStringSlice a(inA), b(inB), lineA, lineB;
@@ -88,6 +88,11 @@ struct StringUtil
         /// Given text, splits into lines stored in outLines. NOTE! That lines is only valid as long as textIn remains valid
     static void calcLines(const UnownedStringSlice& textIn, List<UnownedStringSlice>& lines);
 
+        /// Calculates the offset of the start of each line in text, with lines as found by extractLine. That is \n, \r, \r\n and \n\r
+        /// are each a single line break, and there is a line start after a line break at the end of the text.
+        /// Scans 16 bytes at a time where SSE2 is available.
+    static void calcLineStartOffsets(const UnownedStringSlice& text, List<uint32_t>& outOffsets);
+
         /// Equal if the lines are equal (in effect a way to ignore differences in line breaks)
     static bool areLinesEqual(const UnownedStringSlice& a, const UnownedStringSlice& b);
 
@@ -0,0 +1,186 @@
+#include "slang-thread-pool.h"
+
+#include "slang-math.h"
+
+namespace Slang {
+
+namespace { // anonymous
+
+// Shared between parallelFor and the tasks it adds to the pool. Each thread taking part claims indices until
+// there are none left, so it doesn't matter how many of the tasks actually get to run before all the work is done.
+class ParallelForTask : public ThreadPool::Task
+{
+public:
+    virtual void run() SLANG_OVERRIDE
+    {
+        for (;;)
+        {
+            const Index index = m_nextIndex.fetch_add(1);
+            if (index >= m_count)
+            {
+                // The callback and user data can be out of scope at this point, so must not be touched
+                return;
+            }
+
+            m_callback(index, m_userData);
+
+            if (m_completedCount.fetch_add(1) + 1 == m_count)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_allCompleted.notify_all();
+            }
+        }
+    }
+
+    void waitForAll()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_allCompleted.wait(lock, [this]() { return m_completedCount.load() == m_count; });
+    }
+
+    ParallelForTask(Index count, ThreadPool::ParallelForCallback callback, void* userData):
+        m_count(count),
+        m_callback(callback),
+        m_userData(userData)
+    {
+    }
+
+protected:
+    Index m_count;
+    ThreadPool::ParallelForCallback m_callback;
+    void* m_userData;
+
+    std::atomic<Index> m_nextIndex { 0 };
+    std::atomic<Index> m_completedCount { 0 };
+
+    std::mutex m_mutex;
+    std::condition_variable m_allCompleted;
+};
+
+} // anonymous
+
+/* static */Index ThreadPool::getHardwareThreadCount()
+{
+    const Index count = Index(std::thread::hardware_concurrency());
+    // hardware_concurrency can return 0 if it's not able to determine the count
+    return count > 0 ? count : 1;
+}
+
+ThreadPool::ThreadPool(Index threadCount)
+{
+    if (threadCount <= 0)
+    {
+        threadCount = getHardwareThreadCount();
+    }
+
+    for (Index i = 0; i < threadCount; ++i)
+    {
+        m_threads.add(std::thread(&ThreadPool::_runWorker, this));
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isShuttingDown = true;
+    }
+    m_taskAdded.notify_all();
+
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+void ThreadPool::addTask(Task* task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.add(task);
+    }
+    m_taskAdded.notify_one();
+}
+
+void ThreadPool::_runWorker()
+{
+    for (;;)
+    {
+        RefPtr<Task> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            // When shutting down, tasks that have been added still get to run
+            m_taskAdded.wait(lock, [this]() { return m_isShuttingDown || m_taskStartIndex < m_tasks.getCount(); });
+
+            if (m_taskStartIndex >= m_tasks.getCount())
+            {
+                return;
+            }
+
+            task = m_tasks[m_taskStartIndex];
+            m_tasks[m_taskStartIndex].setNull();
+            m_taskStartIndex++;
+
+            // If all the tasks have been started, the list can be reused
+            if (m_taskStartIndex == m_tasks.getCount())
+            {
+                m_tasks.clear();
+                m_taskStartIndex = 0;
+            }
+        }
+
+        task->run();
+    }
+}
+
+void ThreadPool::parallelFor(Index count, ParallelForCallback callback, void* userData)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    RefPtr<ParallelForTask> task = new ParallelForTask(count, callback, userData);
+
+    // The calling thread does some of the work, so there is no need to have more helpers than that
+    const Index helperCount = Math::Min(getThreadCount(), count - 1);
+    for (Index i = 0; i < helperCount; ++i)
+    {
+        addTask(task);
+    }
+
+    task->run();
+    task->waitForAll();
+}
+
+ParallelForTurns::ParallelForTurns(Index count)
+{
+    m_isTurnEnded.setCount(count);
+    for (auto& isTurnEnded : m_isTurnEnded)
+    {
+        isTurnEnded = false;
+    }
+}
+
+void ParallelForTurns::waitForTurn(Index index)
+{
+    SLANG_ASSERT(index >= 0 && index < m_isTurnEnded.getCount());
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_turnEnded.wait(lock, [&]() { return m_endedCount >= index; });
+}
+
+void ParallelForTurns::endTurn(Index index)
+{
+    SLANG_ASSERT(index >= 0 && index < m_isTurnEnded.getCount());
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isTurnEnded[index] = true;
+        while (m_endedCount < m_isTurnEnded.getCount() && m_isTurnEnded[m_endedCount])
+        {
+            m_endedCount++;
+        }
+    }
+    m_turnEnded.notify_all();
+}
+
+} // namespace Slang
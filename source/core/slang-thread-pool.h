@@ -0,0 +1,105 @@
+#ifndef SLANG_CORE_THREAD_POOL_H
+#define SLANG_CORE_THREAD_POOL_H
+
+#include "slang-smart-pointer.h"
+#include "slang-list.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Slang {
+
+/* A fixed set of worker threads that run tasks.
+
+Tasks are started in the order they are added, but can complete in any order. A task is kept alive by the pool
+until it has run. Tasks must not throw - any exception has to be caught and recorded within the task itself.
+
+Work made up of many independent items can be distributed over the pool with `parallelFor`. */
+class ThreadPool : public RefObject
+{
+public:
+    class Task : public RefObject
+    {
+    public:
+            /// Called on one of the pool's threads
+        virtual void run() = 0;
+    };
+
+        /// Callback for use with `parallelFor`
+    typedef void (*ParallelForCallback)(Index index, void* userData);
+
+        /// Add a task to be run on one of the pool's threads
+    void addTask(Task* task);
+
+        /// Invoke `callback` for each index in [0, count), distributing the calls over the pool's threads.
+        /// The calling thread takes part in the work, so this can be used from within a task without deadlocking.
+        /// Returns once all of the calls have completed.
+    void parallelFor(Index count, ParallelForCallback callback, void* userData);
+
+        /// Invoke `func(index)` for each index in [0, count), distributing the calls over the pool's threads.
+    template <typename F>
+    void parallelFor(Index count, F const& func)
+    {
+        struct Helper
+        {
+            static void helper(Index index, void* userData)
+            {
+                (*(F*)userData)(index);
+            }
+        };
+        parallelFor(count, &Helper::helper, (void*)&func);
+    }
+
+        /// Get the amount of worker threads
+    Index getThreadCount() const { return m_threads.getCount(); }
+
+        /// Get the amount of threads the hardware can run concurrently. Always at least 1.
+    static Index getHardwareThreadCount();
+
+        /// Ctor. If threadCount is 0, a thread is created for each hardware thread.
+    ThreadPool(Index threadCount);
+        /// Dtor. Waits for all added tasks to complete.
+    ~ThreadPool();
+
+protected:
+    void _runWorker();
+
+    std::mutex m_mutex;
+    std::condition_variable m_taskAdded;
+    List<RefPtr<Task>> m_tasks;                 ///< Tasks waiting to run. Tasks before m_taskStartIndex have been started.
+    Index m_taskStartIndex = 0;
+    bool m_isShuttingDown = false;
+
+    List<std::thread> m_threads;
+};
+
+/* Makes a step of the work items of a `parallelFor` happen one item at a time, in the order of the items' indices.
+Used where the step changes state shared between the items, so that it changes the same way as when the items
+run serially.
+
+An item waits for its turn with `waitForTurn`, and must end it with `endTurn`, including when it does not take the
+step at all (which doesn't need to wait). `parallelFor` starts the items in index order, and each item keeps running
+on the thread that started it, so an item waiting for its turn only waits on items that are already running. */
+class ParallelForTurns : public RefObject
+{
+public:
+        /// Wait until every item before index has ended its turn
+    void waitForTurn(Index index);
+        /// The item at index has taken the step, or won't take it. Can be called more than once.
+    void endTurn(Index index);
+
+        /// Ctor. count is the number of items.
+    ParallelForTurns(Index count);
+
+protected:
+    std::mutex m_mutex;
+    std::condition_variable m_turnEnded;
+    List<bool> m_isTurnEnded;
+    Index m_endedCount = 0;                     ///< The items before this index have all ended their turn
+};
+
+} // namespace Slang
+
+#endif
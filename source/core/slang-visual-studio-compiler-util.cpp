@@ -188,6 +188,14 @@ namespace Slang
         }
     }
 
+    switch (options.simdMode)
+    {
+        // SSE2 is the baseline for x64, and the auto vectorizer is always on when optimizing
+        case SIMDMode::AVX2:    cmdLine.addArg("/arch:AVX2"); break;
+        case SIMDMode::AVX512:  cmdLine.addArg("/arch:AVX512"); break;
+        default: break;
+    }
+
     switch (options.targetType)
     {
         case TargetType::SharedLibrary:
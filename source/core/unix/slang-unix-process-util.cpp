@@ -9,6 +9,7 @@
 
 //#include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <poll.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -84,6 +85,23 @@ namespace Slang {
     return cmd.ToString();
 }
 
+// Creates a pipe whose file descriptors are closed on exec. Without this, a process launched on another thread
+// at the same time would inherit the write ends, and reading the output wouldn't complete until it exits.
+static int _createPipe(int fds[2])
+{
+#if SLANG_LINUX_FAMILY
+    return pipe2(fds, O_CLOEXEC);
+#else
+    if (pipe(fds) == -1)
+    {
+        return -1;
+    }
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+    return 0;
+#endif
+}
+
 /* static */SlangResult ProcessUtil::execute(const CommandLine& commandLine, ExecuteResult& outExecuteResult)
 {
     outExecuteResult.init();
@@ -105,14 +123,16 @@ namespace Slang {
     int stdoutPipe[2];
     int stderrPipe[2];
 
-    if (pipe(stdoutPipe) == -1)
+    if (_createPipe(stdoutPipe) == -1)
     {
         fprintf(stderr, "error: `pipe` failed\n");
         return SLANG_FAIL;
     }
 
-    if (pipe(stderrPipe) == -1)
+    if (_createPipe(stderrPipe) == -1)
     {
+        close(stdoutPipe[0]);
+        close(stdoutPipe[1]);
         fprintf(stderr, "error: `pipe` failed\n");
         return SLANG_FAIL;
     }
@@ -139,9 +159,13 @@ namespace Slang {
 
         execvp(argPtrs[0], (char* const*)&argPtrs[0]);
 
-        // If we get here, then `exec` failed
-        fprintf(stderr, "error: `exec` failed\n");
-        return SLANG_FAIL;
+        // If we get here, then `exec` failed. The child must not return into the parent's code, or touch
+        // its state (such as stdio, whose locks may be held by threads of the parent that don't exist
+        // in the child), so the message is written directly to the file descriptor.
+        static const char message[] = "error: `exec` failed\n";
+        const ssize_t writtenCount = write(STDERR_FILENO, message, sizeof(message) - 1);
+        SLANG_UNUSED(writtenCount);
+        _exit(127);
     }
     else
     {
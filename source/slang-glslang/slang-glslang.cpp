@@ -18,6 +18,7 @@
 
 #include "spirv-tools/optimizer.hpp"
 #include "spirv-tools/libspirv.h"
+#include "spirv-tools/libspirv.hpp"
 
 #if 0
 #include <cstring>
@@ -474,6 +475,51 @@ static int glslang_dissassembleSPIRV(const glslang_CompileRequest_1_1& request)
     return 0;
 }
 
+static int glslang_validateSPIRV(const glslang_CompileRequest_1_1& request)
+{
+    typedef unsigned int SPIRVWord;
+
+    SPIRVWord const* spirvBegin = (SPIRVWord const*)request.inputBegin;
+    SPIRVWord const* spirvEnd   = (SPIRVWord const*)request.inputEnd;
+
+    // The header is 5 words, the second being the version, which is encoded
+    // the same way as a glslang target language version.
+    if (spirvEnd - spirvBegin < 5)
+    {
+        dumpDiagnostics(request, "error: SPIR-V module is too small to be valid\n");
+        return 1;
+    }
+    const spv_target_env targetEnv = _getUniversalTargetEnv(glslang::EShTargetLanguageVersion(spirvBegin[1]));
+
+    std::string log;
+    spvtools::SpirvTools tools(targetEnv);
+    tools.SetMessageConsumer(
+        [&log](spv_message_level_t level, const char* source, const spv_position_t& position, const char* message) {
+        (void)source;
+        switch (level)
+        {
+        case SPV_MSG_FATAL:
+        case SPV_MSG_INTERNAL_ERROR:
+        case SPV_MSG_ERROR:
+            log += "error: ";
+            break;
+        case SPV_MSG_WARNING:
+            log += "warning: ";
+            break;
+        default:
+            break;
+        }
+        log += "word " + std::to_string(position.index) + ": " + message + "\n";
+    });
+
+    const bool isValid = tools.Validate(spirvBegin, size_t(spirvEnd - spirvBegin));
+    if (log.length())
+    {
+        dumpDiagnostics(request, log);
+    }
+    return isValid ? 0 : 1;
+}
+
 // We need a per process initialization
 class ProcessInitializer
 {
@@ -526,6 +572,10 @@ static int _compile(const glslang_CompileRequest_1_1& request)
         case GLSLANG_ACTION_DISSASSEMBLE_SPIRV:
             result = glslang_dissassembleSPIRV(request);
             break;
+
+        case GLSLANG_ACTION_VALIDATE_SPIRV:
+            result = glslang_validateSPIRV(request);
+            break;
     }
 
     return result;
@@ -10,6 +10,7 @@ enum
 {
     GLSLANG_ACTION_COMPILE_GLSL_TO_SPIRV,
     GLSLANG_ACTION_DISSASSEMBLE_SPIRV,
+    GLSLANG_ACTION_VALIDATE_SPIRV,              ///< Validate the SPIR-V in the input, outputting any errors as diagnostics
 };
 
 struct glsl_SPIRVVersion
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "slang-ast-support-types.h"
 
 #include "slang-generated-ast.h"
@@ -161,9 +163,11 @@ protected:
     bool equalsImpl(Type* type);
     Type* createCanonicalType();
 
-    Type* canonicalType = nullptr;
-
     SLANG_UNREFLECTED
+        /// Set on first use of getCanonicalType. Atomic because types held in a shared (stdlib)
+        /// ASTBuilder can have their canonical type requested from multiple threads.
+    std::atomic<Type*> m_canonicalType { nullptr };
+
     ASTBuilder* m_astBuilder = nullptr;
 };
 
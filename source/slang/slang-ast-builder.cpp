@@ -23,6 +23,8 @@ void SharedASTBuilder::init(Session* session)
     {
         RefPtr<ASTBuilder> astBuilder(new ASTBuilder);
         astBuilder->m_sharedASTBuilder = this;
+        // Types from here are used by all sessions
+        astBuilder->m_isShared = true;
         m_astBuilder = astBuilder.detach();
     }
 
@@ -145,7 +147,92 @@ void SharedASTBuilder::registerMagicDecl(Decl* decl, MagicTypeModifier* modifier
 
 Decl* SharedASTBuilder::findMagicDecl(const String& name)
 {
-    return m_magicDecls[name].GetValue();
+    // Lookup must not modify m_magicDecls, as it can be used from multiple threads
+    Decl* decl = nullptr;
+    m_magicDecls.TryGetValue(name, decl);
+    return decl;
+}
+
+void SharedASTBuilder::finalizeStdLib()
+{
+    // Create the lazily constructed types now, so that they are never created on demand
+    // while the builder is being used by multiple Linkages.
+    if (findMagicDecl("StringType"))
+    {
+        getStringType();
+    }
+    if (findMagicDecl("EnumTypeType"))
+    {
+        getEnumTypeType();
+    }
+    if (findMagicDecl("DynamicType"))
+    {
+        getDynamicType();
+    }
+}
+
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! ValKey !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+void ValKey::addDeclRef(const DeclRefBase& declRef)
+{
+    add(declRef.decl);
+
+    for (auto subst = declRef.substitutions.substitutions; subst; subst = subst->outer)
+    {
+        // The kind of substitution is needed, as the operands alone could be ambiguous
+        add(uint64_t(subst->astNodeType));
+
+        if (auto genericSubst = as<GenericSubstitution>(subst))
+        {
+            add(genericSubst->genericDecl);
+            for (auto arg : genericSubst->args)
+            {
+                add(arg);
+            }
+        }
+        else if (auto thisTypeSubst = as<ThisTypeSubstitution>(subst))
+        {
+            add(thisTypeSubst->interfaceDecl);
+            add(thisTypeSubst->witness);
+        }
+        else if (auto globalGenericSubst = as<GlobalGenericParamSubstitution>(subst))
+        {
+            add(globalGenericSubst->paramDecl);
+            add(globalGenericSubst->actualType);
+            for (const auto& constraintArg : globalGenericSubst->constraintArgs)
+            {
+                add(constraintArg.decl);
+                add(constraintArg.val);
+            }
+        }
+        else
+        {
+            // Not a substitution we know how to identify, so make the key unusable
+            m_operandCount = kMaxOperandCount + 1;
+        }
+    }
+}
+
+HashCode ValKey::getHashCode() const
+{
+    SLANG_ASSERT(isValid());
+    return combineHash(HashCode(m_nodeType), Slang::getHashCode((const char*)m_operands, size_t(m_operandCount) * sizeof(m_operands[0])));
+}
+
+bool ValKey::operator==(const ValKey& rhs) const
+{
+    if (m_nodeType != rhs.m_nodeType || m_operandCount != rhs.m_operandCount)
+    {
+        return false;
+    }
+    for (Index i = 0; i < m_operandCount; ++i)
+    {
+        if (m_operands[i] != rhs.m_operands[i])
+        {
+            return false;
+        }
+    }
+    return true;
 }
 
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! ASTBuilder !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -153,7 +240,7 @@ Decl* SharedASTBuilder::findMagicDecl(const String& name)
 ASTBuilder::ASTBuilder(SharedASTBuilder* sharedASTBuilder, const String& name):
     m_sharedASTBuilder(sharedASTBuilder),
     m_name(name),
-    m_id(sharedASTBuilder->m_id++),
+    m_id(sharedASTBuilder->m_id.fetch_add(1, std::memory_order_relaxed)),
     m_arena(2048)
 {
     SLANG_ASSERT(sharedASTBuilder);
@@ -233,9 +320,20 @@ PtrTypeBase* ASTBuilder::getPtrType(Type* valueType, GenericDecl* genericDecl)
 
 ArrayExpressionType* ASTBuilder::getArrayType(Type* elementType, IntVal* elementCount)
 {
+    ValKey key(ASTNodeType::ArrayExpressionType);
+    key.add(elementType);
+    key.add(elementCount);
+
+    SharedLock lock(this);
+    if (auto arrayType = findInterned<ArrayExpressionType>(key))
+    {
+        return arrayType;
+    }
+
     ArrayExpressionType* arrayType = create<ArrayExpressionType>();
     arrayType->baseType = elementType;
     arrayType->arrayLength = elementCount;
+    addInterned(key, arrayType);
     return arrayType;
 }
 
@@ -259,7 +357,54 @@ VectorExpressionType* ASTBuilder::getVectorType(
 
 TypeType* ASTBuilder::getTypeType(Type* type)
 {
-    return create<TypeType>(type);
+    ValKey key(ASTNodeType::TypeType);
+    key.add(type);
+
+    SharedLock lock(this);
+    if (auto typeType = findInterned<TypeType>(key))
+    {
+        return typeType;
+    }
+
+    auto typeType = create<TypeType>(type);
+    addInterned(key, typeType);
+    return typeType;
+}
+
+ConstantIntVal* ASTBuilder::getIntVal(IntegerLiteralValue value)
+{
+    ValKey key(ASTNodeType::ConstantIntVal);
+    key.add(uint64_t(value));
+
+    SharedLock lock(this);
+    if (auto intVal = findInterned<ConstantIntVal>(key))
+    {
+        return intVal;
+    }
+
+    auto intVal = create<ConstantIntVal>(value);
+    addInterned(key, intVal);
+    return intVal;
+}
+
+Val* ASTBuilder::_findInterned(const ValKey& key)
+{
+    if (!key.isValid())
+    {
+        return nullptr;
+    }
+    Val** valPtr = m_internedVals.TryGetValue(key);
+    return valPtr ? *valPtr : nullptr;
+}
+
+void ASTBuilder::addInterned(const ValKey& key, Val* val)
+{
+    // Only Vals owned by this builder can be interned, so that they are not used after they are freed
+    SLANG_ASSERT(val->getASTBuilder() == this);
+    if (key.isValid())
+    {
+        m_internedVals.Add(key, val);
+    }
 }
 
 
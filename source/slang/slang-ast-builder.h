@@ -3,6 +3,8 @@
 #define SLANG_AST_BUILDER_H
 
 #include <type_traits>
+#include <atomic>
+#include <mutex>
 
 #include "slang-ast-support-types.h"
 #include "slang-ast-all.h"
@@ -43,6 +45,10 @@ public:
         /// Must be called before used
     void init(Session* session);
 
+        /// Called once the stdlib is available. After this the shared state is not modified,
+        /// so it can be used from multiple threads.
+    void finalizeStdLib();
+
     SharedASTBuilder();
 
     ~SharedASTBuilder();
@@ -79,7 +85,48 @@ protected:
     ASTBuilder* m_astBuilder = nullptr;
     Session* m_session = nullptr;
 
-    Index m_id = 1;
+    // ASTBuilders can be created for different Linkages on different threads
+    std::atomic<Index> m_id { 1 };
+
+    // Held when nodes are lazily created in a shared ASTBuilder
+    std::recursive_mutex m_sharedMutex;
+};
+
+    /// Identifies a Val by its node type and operands, such that an ASTBuilder can hand back an
+    /// existing Val rather than create an equivalent one.
+    ///
+    /// Operands are compared by identity. Two Vals only share a key if they were built from the
+    /// same operand nodes, so sugar (such as the typedef a type was named by) is never merged away.
+struct ValKey
+{
+    enum { kMaxOperandCount = 8 };
+
+    void add(const void* ptr) { add(uint64_t(uintptr_t(ptr))); }
+    void add(uint64_t value)
+    {
+        if (m_operandCount < kMaxOperandCount)
+        {
+            m_operands[m_operandCount] = value;
+        }
+        // Once full the key is invalid, and will stay so
+        m_operandCount = (m_operandCount < kMaxOperandCount) ? (m_operandCount + 1) : (kMaxOperandCount + 1);
+    }
+        /// Add the decl and substitutions of declRef. 
+    void addDeclRef(const DeclRefBase& declRef);
+
+        /// A key that has too many operands can't be used
+    bool isValid() const { return m_operandCount <= kMaxOperandCount; }
+
+    HashCode getHashCode() const;
+    bool operator==(const ValKey& rhs) const;
+
+    ValKey() {}
+    explicit ValKey(ASTNodeType nodeType) : m_nodeType(nodeType) {}
+
+protected:
+    ASTNodeType m_nodeType = ASTNodeType::CountOf;
+    Index m_operandCount = 0;
+    uint64_t m_operands[kMaxOperandCount];
 };
 
 class ASTBuilder : public RefObject
@@ -87,6 +134,29 @@ class ASTBuilder : public RefObject
     friend class SharedASTBuilder;
 public:
 
+        /// Locks the builder for the scope, if it is shared between threads
+    class SharedLock
+    {
+    public:
+        SharedLock(ASTBuilder* astBuilder):
+            m_mutex((astBuilder && astBuilder->m_isShared) ? &astBuilder->m_sharedASTBuilder->m_sharedMutex : nullptr)
+        {
+            if (m_mutex)
+            {
+                m_mutex->lock();
+            }
+        }
+        ~SharedLock()
+        {
+            if (m_mutex)
+            {
+                m_mutex->unlock();
+            }
+        }
+    private:
+        std::recursive_mutex* m_mutex;
+    };
+
     // For compile time check to see if thing being constructed is an AST type
     template <typename T>
     struct IsValidType
@@ -155,6 +225,19 @@ public:
 
     TypeType* getTypeType(Type* type);
 
+        /// Get the `ConstantIntVal` for value
+    ConstantIntVal* getIntVal(IntegerLiteralValue value);
+
+        /// Find a Val previously interned with key, or nullptr if there isn't one.
+        /// If the builder is shared, the caller must hold a SharedLock across the find and any add.
+    template <typename T>
+    T* findInterned(const ValKey& key) { return as<T>(_findInterned(key)); }
+        /// Intern val, such that it is found from key. Vals that are interned must not be modified afterwards.
+    void addInterned(const ValKey& key, Val* val);
+
+        /// The amount of Vals that have been interned
+    Index getInternedCount() const { return m_internedVals.Count(); }
+
         /// Helpers to get type info from the SharedASTBuilder
     const ReflectClassInfo* findClassInfo(const UnownedStringSlice& slice) { return m_sharedASTBuilder->findClassInfo(slice); }
     SyntaxClass<NodeBase> findSyntaxClass(const UnownedStringSlice& slice) { return m_sharedASTBuilder->findSyntaxClass(slice); }
@@ -167,6 +250,12 @@ public:
         /// Get the shared AST builder
     SharedASTBuilder* getSharedASTBuilder() { return m_sharedASTBuilder; }
 
+        /// Mark the builder as shared between threads (as the stdlib builders are). After this the
+        /// builder is only added to lazily (for example canonical types), under a lock.
+    void setShared() { m_isShared = true; }
+        /// True if the builder is shared between threads
+    bool isShared() const { return m_isShared; }
+
         /// Get the global session
     Session* getGlobalSession() { return m_sharedASTBuilder->m_session; }
 
@@ -180,6 +269,8 @@ protected:
     // Special default Ctor that can only be used by SharedASTBuilder
     ASTBuilder();
 
+    Val* _findInterned(const ValKey& key);
+
     template <typename T>
     SLANG_FORCE_INLINE T* _initAndAdd(T* node)
     {
@@ -198,11 +289,16 @@ protected:
     String m_name;
     Index m_id;
 
+    bool m_isShared = false;
+
         /// List of all nodes that require being dtored when ASTBuilder is dtored
     List<NodeBase*> m_dtorNodes;
 
     SharedASTBuilder* m_sharedASTBuilder;
 
+        /// Vals (types in particular) that have been created, such that they can be reused
+    Dictionary<ValKey, Val*> m_internedVals;
+
     MemoryArena m_arena;
 };
 
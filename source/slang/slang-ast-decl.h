@@ -24,10 +24,20 @@ class ContainerDecl: public Decl
 
     List<Decl*> members;
 
+        /// Get the members. If they are created on demand, all of them are created first.
+    const List<Decl*>& getMembers()
+    {
+        if (ASTDeclLoader* loader = memberLoader.load())
+        {
+            loader->loadAllMembers(this);
+        }
+        return members;
+    }
+
     template<typename T>
     FilteredMemberList<T> getMembersOfType()
     {
-        return FilteredMemberList<T>(members);
+        return FilteredMemberList<T>(getMembers());
     }
 
     bool isMemberDictionaryValid() const { return dictionaryLastCount == members.getCount(); }
@@ -49,6 +59,11 @@ class ContainerDecl: public Decl
     // A list of transparent members, to be used in lookup
     // Note: this is only valid if `memberDictionaryIsValid` is true
     List<TransparentMemberInfo> transparentMembers;
+
+    // Set if the members are created on demand, and not all of them have been yet.
+    // When set, transparentMembers is complete, but members and memberDictionary may not be.
+    // Atomic because decls of a shared module (the stdlib) can have their members created from multiple threads.
+    std::atomic<ASTDeclLoader*> memberLoader { nullptr };
 };
 
 // Base class for all variable declarations
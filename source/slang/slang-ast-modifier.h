@@ -561,7 +561,12 @@ class UnrollAttribute : public Attribute
 {
     SLANG_AST_CLASS(UnrollAttribute)
  
-    IntegerLiteralValue getCount();
+    // The maximum number of iterations to unroll, or 0
+    // if the loop should be unrolled whatever its count.
+    //
+    // TODO: This should be an accessor that uses the
+    // ordinary `args` list, rather than side data.
+    int32_t count = 0;
 };
 
 class LoopAttribute : public Attribute 
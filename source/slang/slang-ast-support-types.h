@@ -858,6 +858,29 @@ namespace Slang
         Decl*	decl = nullptr;
     };
 
+        /// Produces the declarations of an AST module that were not created when the module was loaded.
+        ///
+        /// A module read from a serialized form (such as the stdlib) can defer creating the members of
+        /// its container decls until they are first needed. A container decl with members yet to be
+        /// created has its `memberLoader` set, and its members must then be accessed through
+        /// `ContainerDecl::getMembers` or lookup.
+    class ASTDeclLoader : public RefObject
+    {
+    public:
+            /// Create all of the members of decl (if they haven't been already), and build its member dictionary
+        virtual void loadAllMembers(ContainerDecl* decl) = 0;
+            /// Create the members of decl called name, and return the first of them (the rest are
+            /// linked through `Decl::nextInContainerWithSameName`). Returns nullptr if there are none.
+        virtual Decl* loadMembersWithName(ContainerDecl* decl, Name* name) = 0;
+            /// Create the decls that have a modifier of the type modifierClass (or a type derived from it)
+        virtual void loadDeclsWithModifier(const ReflectClassInfo& modifierClass, List<Decl*>& outDecls) = 0;
+            /// Find the node exported with the mangled name. Returns false if the loader can't look up exports, in
+            /// which case they have to be found by traversing the module.
+        virtual bool findExportFromMangledName(const UnownedStringSlice& mangledName, NodeBase*& outNode) = 0;
+            /// Create everything in the module
+        virtual void loadAll() = 0;
+    };
+
     template<typename T>
     struct FilteredMemberRefList
     {
@@ -18,7 +18,12 @@ Type* Type::createCanonicalType()
 
 bool Type::equals(Type* type)
 {
-    return getCanonicalType()->equalsImpl(type->getCanonicalType());
+    if (this == type)
+        return true;
+    Type* canType = getCanonicalType();
+    Type* otherCanType = type->getCanonicalType();
+    // Canonical types are typically interned, so are often the same node
+    return canType == otherCanType || canType->equalsImpl(otherCanType);
 }
 
 bool Type::equalsImpl(Type* type)
@@ -63,16 +68,21 @@ Val* Type::_substituteImplOverride(ASTBuilder* astBuilder, SubstitutionSet subst
 
 Type* Type::getCanonicalType()
 {
-    Type* et = const_cast<Type*>(this);
-    if (!et->canonicalType)
+    Type* canType = m_canonicalType.load(std::memory_order_acquire);
+    if (!canType)
     {
-        // TODO(tfoley): worry about thread safety here?
-        auto canType = et->createCanonicalType();
-        et->canonicalType = canType;
-
-        SLANG_ASSERT(et->canonicalType);
+        // Creating the canonical type can add nodes to this type's builder. If the builder is
+        // shared between threads (as the stdlib's is) this has to be done under its lock.
+        ASTBuilder::SharedLock lock(m_astBuilder);
+        canType = m_canonicalType.load(std::memory_order_relaxed);
+        if (!canType)
+        {
+            canType = createCanonicalType();
+            SLANG_ASSERT(canType);
+            m_canonicalType.store(canType, std::memory_order_release);
+        }
     }
-    return et->canonicalType;
+    return canType;
 }
 
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! OverloadGroupType !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -365,9 +375,17 @@ IntVal* MatrixExpressionType::getColumnCount()
 
 Type* MatrixExpressionType::getRowType()
 {
+    Type* rowType = m_rowType.load(std::memory_order_acquire);
     if (!rowType)
     {
-        rowType = m_astBuilder->getVectorType(getElementType(), getColumnCount());
+        // Creating the row type adds nodes to this type's builder, which may be shared between threads
+        ASTBuilder::SharedLock lock(m_astBuilder);
+        rowType = m_rowType.load(std::memory_order_relaxed);
+        if (!rowType)
+        {
+            rowType = m_astBuilder->getVectorType(getElementType(), getColumnCount());
+            m_rowType.store(rowType, std::memory_order_release);
+        }
     }
     return rowType;
 }
@@ -949,7 +967,7 @@ Val* ThisType::_substituteImplOverride(ASTBuilder* astBuilder, SubstitutionSet s
 
     (*ioDiff)++;
 
-    ThisType* substType = m_astBuilder->create<ThisType>();
+    ThisType* substType = astBuilder->create<ThisType>();
     substType->interfaceDeclRef = substInterfaceDeclRef;
     return substType;
 }
@@ -457,7 +457,8 @@ class MatrixExpressionType : public ArithmeticExpressionType
     BasicExpressionType* _getScalarTypeOverride();
 
 private:
-    Type* rowType = nullptr;
+    SLANG_UNREFLECTED
+    std::atomic<Type*> m_rowType { nullptr };
 };
 
 // The built-in `String` type
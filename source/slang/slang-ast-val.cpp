@@ -23,6 +23,9 @@ Val* Val::substituteImpl(ASTBuilder* astBuilder, SubstitutionSet subst, int* ioD
 
 bool Val::equalsVal(Val* val)
 {
+    // Vals are interned by their ASTBuilder, so the same node is a common case
+    if (this == val)
+        return true;
     SLANG_AST_NODE_VIRTUAL_CALL(Val, equalsVal, (val))
 }
 
@@ -311,7 +311,7 @@ namespace Slang
                 // We have a new type for the conversion, based on what
                 // we learned.
                 toType = m_astBuilder->getArrayType(toElementType,
-                    m_astBuilder->create<ConstantIntVal>(elementCount));
+                    m_astBuilder->getIntVal(elementCount));
             }
         }
         else if(auto toMatrixType = as<MatrixExpressionType>(toType))
@@ -783,7 +783,7 @@ namespace Slang
             // and likely a crash.
             // 
             // Accessing the members via index side steps the issue.
-            const auto& members = containerDecl->members;
+            const auto& members = containerDecl->getMembers();
             for(Index i = 0; i < members.getCount(); ++i)
             {
                 Decl* childDecl = members[i];
@@ -1198,11 +1198,7 @@ namespace Slang
         }
     };
 
-        /// Recursively register any builtin declarations that need to be attached to the `session`.
-        ///
-        /// This function should only be needed for declarations in the standard library.
-        ///
-    static void _registerBuiltinDeclsRec(Session* session, Decl* decl)
+    void registerBuiltinDecl(Session* session, Decl* decl)
     {
         SharedASTBuilder* sharedASTBuilder = session->m_sharedASTBuilder;
 
@@ -1214,10 +1210,19 @@ namespace Slang
         {
             sharedASTBuilder->registerMagicDecl(decl, magicMod);
         }
+    }
+
+        /// Recursively register any builtin declarations that need to be attached to the `session`.
+        ///
+        /// This function should only be needed for declarations in the standard library.
+        ///
+    static void _registerBuiltinDeclsRec(Session* session, Decl* decl)
+    {
+        registerBuiltinDecl(session, decl);
 
         if(auto containerDecl = as<ContainerDecl>(decl))
         {
-            for(auto childDecl : containerDecl->members)
+            for(auto childDecl : containerDecl->getMembers())
             {
                 if(as<ScopeDecl>(childDecl))
                     continue;
@@ -3135,7 +3140,7 @@ namespace Slang
             {
                 if(auto enumTypeTypeInterfaceDecl = as<InterfaceDecl>(enumTypeTypeDeclRefType->declRef.getDecl()))
                 {
-                    for(auto memberDecl : enumTypeTypeInterfaceDecl->members)
+                    for(auto memberDecl : enumTypeTypeInterfaceDecl->getMembers())
                     {
                         if(memberDecl->getName() == tagAssociatedTypeName)
                         {
@@ -687,8 +687,7 @@ namespace Slang
 
     IntVal* SemanticsVisitor::getIntVal(IntegerLiteralExpr* expr)
     {
-        // TODO(tfoley): don't keep allocating here!
-        return m_astBuilder->create<ConstantIntVal>(expr->value);
+        return m_astBuilder->getIntVal(expr->value);
     }
 
     IntVal* SemanticsVisitor::tryConstantFoldExpr(
@@ -814,7 +813,7 @@ namespace Slang
             return nullptr;
         }
 
-        IntVal* result = m_astBuilder->create<ConstantIntVal>(resultValue);
+        IntVal* result = m_astBuilder->getIntVal(resultValue);
         return result;
     }
 
@@ -1566,7 +1565,7 @@ namespace Slang
             // here if the input type had a sugared name...
             swizExpr->type = QualType(createVectorType(
                 baseElementType,
-                m_astBuilder->create<ConstantIntVal>(elementCount)));
+                m_astBuilder->getIntVal(elementCount)));
         }
 
         // A swizzle can be used as an l-value as long as there
@@ -1678,7 +1677,7 @@ namespace Slang
             // here if the input type had a sugared name...
             swizExpr->type = QualType(createVectorType(
                 baseElementType,
-                m_astBuilder->create<ConstantIntVal>(elementCount)));
+                m_astBuilder->getIntVal(elementCount)));
         }
 
         // A swizzle can be used as an l-value as long as there
@@ -161,7 +161,7 @@ namespace Slang
         //
         // TODO: This step should skip `static` fields.
         //
-        for(auto member : structDecl->members)
+        for(auto member : structDecl->getMembers())
         {
             if(auto varMember = as<VarDecl>(member))
             {
@@ -449,6 +449,11 @@ namespace Slang
             // if an attribute has arguments, but not handled explicitly (and the default param will come through
             // as 1 arg if nothing is specified)
             SLANG_ASSERT(attr->args.getCount() == 1);
+            auto val = checkConstantIntVal(attr->args[0]);
+
+            if(!val) return false;
+
+            unrollAttr->count = (int32_t)val->value;
         }
         else if (auto userDefAttr = as<UserDefinedAttribute>(attr))
         {
@@ -608,7 +608,7 @@ namespace Slang
         //
         HashSet<Module*> requiredModuleSet;
 
-        for( auto globalDecl : moduleDecl->members )
+        for( auto globalDecl : moduleDecl->getMembers() )
         {
             if(auto globalVar = as<VarDecl>(globalDecl))
             {
@@ -872,7 +872,7 @@ namespace Slang
             for(Index tt = 0; tt < translationUnitCount; ++tt)
             {
                 auto translationUnit = compileRequest->translationUnits[tt];
-                for( auto globalDecl : translationUnit->getModuleDecl()->members )
+                for( auto globalDecl : translationUnit->getModuleDecl()->getMembers() )
                 {
                     auto maybeFuncDecl = globalDecl;
                     if( auto genericDecl = as<GenericDecl>(maybeFuncDecl) )
@@ -1107,7 +1107,7 @@ namespace Slang
                     if(!intVal)
                     {
                         sink->diagnose(param.loc, Diagnostics::expectedValueOfTypeForSpecializationArg, paramDecl->getType(), paramDecl);
-                        intVal = getLinkage()->getASTBuilder()->create<ConstantIntVal>(0);
+                        intVal = getLinkage()->getASTBuilder()->getIntVal(0);
                     }
 
                     ModuleSpecializationInfo::GenericArgInfo expandedArg;
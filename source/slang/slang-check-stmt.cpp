@@ -166,9 +166,7 @@ namespace Slang
         }
         else
         {
-            ConstantIntVal* rangeBeginConst = m_astBuilder->create<ConstantIntVal>();
-            rangeBeginConst->value = 0;
-            rangeBeginVal = rangeBeginConst;
+            rangeBeginVal = m_astBuilder->getIntVal(0);
         }
 
         stmt->rangeEndExpr = checkExpressionAndExpectIntegerConstant(stmt->rangeEndExpr, &rangeEndVal);
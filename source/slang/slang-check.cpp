@@ -82,6 +82,8 @@ namespace Slang
 
     void Session::setSharedLibraryLoader(ISlangSharedLibraryLoader* loader)
     {
+        std::lock_guard<std::recursive_mutex> lock(m_downstreamCompilerMutex);
+
         if (m_sharedLibraryLoader != loader)
         {
             // Need to clear all of the libraries
@@ -103,13 +105,55 @@ namespace Slang
 
     void Session::resetDownstreamCompiler(PassThroughMode type)
     {
+        std::lock_guard<std::recursive_mutex> lock(m_downstreamCompilerMutex);
+
         // Mark as initialized
         m_downstreamCompilerInitialized &= ~(1 << int(type));
         m_downstreamCompilers[int(type)].setNull();
     }
 
+    DownstreamCompileJobPool* Session::getDownstreamCompileJobPool()
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_downstreamCompilerMutex);
+
+        if (!m_downstreamCompileJobPool)
+        {
+            // Downstream compiles are mostly separate processes, so run as many as the hardware can
+            m_downstreamCompileJobPool = new DownstreamCompileJobPool(0);
+        }
+        return m_downstreamCompileJobPool;
+    }
+
+    RefPtr<DownstreamCompileResultCache> Session::getDownstreamCompileResultCache()
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_downstreamCompilerMutex);
+        return m_downstreamCompileResultCache;
+    }
+
+    void Session::setDownstreamCompileResultCacheSize(uint64_t maxSizeInBytes)
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_downstreamCompilerMutex);
+
+        if (maxSizeInBytes == 0)
+        {
+            // Compiles in progress can keep using the cache they found, it's just no longer held by the session
+            m_downstreamCompileResultCache.setNull();
+        }
+        else if (m_downstreamCompileResultCache)
+        {
+            m_downstreamCompileResultCache->setMaxSizeInBytes(maxSizeInBytes);
+        }
+        else
+        {
+            m_downstreamCompileResultCache = new DownstreamCompileResultCache(maxSizeInBytes);
+        }
+    }
+
     DownstreamCompiler* Session::getOrLoadDownstreamCompiler(PassThroughMode type, DiagnosticSink* sink)
     {
+        // Compiles on different Linkages may be trying to load at the same time
+        std::lock_guard<std::recursive_mutex> lock(m_downstreamCompilerMutex);
+
         if (m_downstreamCompilerInitialized & (1 << int(type)))
         {
             return m_downstreamCompilers[int(type)];
@@ -186,6 +230,8 @@ namespace Slang
 
     SlangFuncPtr Session::getSharedLibraryFunc(SharedLibraryFuncType type, DiagnosticSink* sink)
     {
+        std::lock_guard<std::recursive_mutex> lock(m_downstreamCompilerMutex);
+
         if (m_sharedLibraryFunctions[int(type)])
         {
             return m_sharedLibraryFunctions[int(type)];
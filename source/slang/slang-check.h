@@ -38,4 +38,6 @@ namespace Slang
     bool isFromStdLib(Decl* decl);
 
     void registerBuiltinDecls(Session* session, Decl* decl);
+        /// Register decl with the session if it is a builtin or magic type decl (but not any decls it contains)
+    void registerBuiltinDecl(Session* session, Decl* decl);
 }
@@ -0,0 +1,667 @@
+// slang-compile-cache.cpp
+#include "slang-compile-cache.h"
+
+#include "../core/slang-io.h"
+#include "../core/slang-blob.h"
+#include "../core/slang-process-util.h"
+
+#include <time.h>
+
+#include "slang-compiler.h"
+
+namespace Slang {
+
+static const char kEntryFileExtension[] = ".slang-cache";
+static const char kTemporaryFileExtension[] = ".slang-cache-tmp";
+
+// A temporary file older than this (in seconds) was left by a write that didn't complete
+static const uint64_t kStaleTemporaryFileAge = 60 * 60;
+
+CompileCache::CompileCache(const String& directory):
+    m_directory(directory)
+{
+}
+
+void CompileCache::setMaxSizeInBytes(uint64_t size)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxSizeInBytes = size ? size : kDefaultMaxSizeInBytes;
+}
+
+uint64_t CompileCache::getMaxSizeInBytes()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_maxSizeInBytes;
+}
+
+String CompileCache::_getEntryPath(const Key& key) const
+{
+    return Path::combine(m_directory, key.toString() + kEntryFileExtension);
+}
+
+/* static */SlangResult CompileCache::calcFileDigest(ISlangFileSystemExt* fileSystem, const String& path, SHA1::Digest& outDigest)
+{
+    ComPtr<ISlangBlob> blob;
+    SLANG_RETURN_ON_FAIL(fileSystem->loadFile(path.getBuffer(), blob.writeRef()));
+    outDigest = SHA1::compute(blob->getBufferPointer(), blob->getBufferSize());
+    return SLANG_OK;
+}
+
+/* static */SlangResult CompileCache::_writeEntry(const Key& key, const Entry& entry, Stream* stream)
+{
+    RiffContainer container;
+    {
+        RiffContainer::ScopeChunk entryScope(&container, RiffContainer::Chunk::Kind::List, kEntryFourCc);
+
+        {
+            Header header;
+            header.semanticVersion = Header::getCurrentVersion().m_raw;
+            ::memcpy(header.key, key.data, sizeof(header.key));
+
+            RiffContainer::ScopeChunk scope(&container, RiffContainer::Chunk::Kind::Data, kHeaderFourCc);
+            container.write(&header, sizeof(header));
+        }
+
+        for (const auto& dependency : entry.dependencies)
+        {
+            RiffContainer::ScopeChunk scope(&container, RiffContainer::Chunk::Kind::Data, kDependencyFourCc);
+            container.write(dependency.digest.data, sizeof(dependency.digest.data));
+            container.write(dependency.path.getBuffer(), dependency.path.getLength());
+        }
+
+        for (const auto& entryPoint : entry.entryPoints)
+        {
+            RiffContainer::ScopeChunk scope(&container, RiffContainer::Chunk::Kind::Data, kEntryPointFourCc);
+            container.write(&entryPoint.profile, sizeof(entryPoint.profile));
+            container.write(entryPoint.name.getBuffer(), entryPoint.name.getLength());
+        }
+
+        for (const auto& output : entry.outputs)
+        {
+            RiffContainer::ScopeChunk scope(&container, RiffContainer::Chunk::Kind::Data, kOutputFourCc);
+
+            const int32_t indices[2] = { int32_t(output.targetIndex), int32_t(output.entryPointIndex) };
+            const uint32_t isText = output.isText ? 1 : 0;
+
+            container.write(indices, sizeof(indices));
+            container.write(&isText, sizeof(isText));
+            container.write(output.blob->getBufferPointer(), output.blob->getBufferSize());
+        }
+
+        {
+            RiffContainer::ScopeChunk scope(&container, RiffContainer::Chunk::Kind::Data, kDiagnosticsFourCc);
+            container.write(entry.diagnostics.getBuffer(), entry.diagnostics.getLength());
+        }
+    }
+
+    return RiffUtil::write(&container, stream);
+}
+
+/* static */SlangResult CompileCache::_readEntry(RiffContainer::ListChunk* entryChunk, const Key& key, Entry& outEntry)
+{
+    if (!entryChunk || entryChunk->getSubType() != kEntryFourCc)
+    {
+        return SLANG_FAIL;
+    }
+
+    auto header = entryChunk->findContainedData<Header>(kHeaderFourCc);
+    if (!header ||
+        !RiffSemanticVersion::areCompatible(Header::getCurrentVersion(), RiffSemanticVersion::makeFromRaw(header->semanticVersion)) ||
+        ::memcmp(header->key, key.data, sizeof(header->key)) != 0)
+    {
+        return SLANG_FAIL;
+    }
+
+    for (RiffContainer::Chunk* chunk = entryChunk->getFirstContainedChunk(); chunk; chunk = chunk->m_next)
+    {
+        auto dataChunk = as<RiffContainer::DataChunk>(chunk);
+        if (!dataChunk)
+        {
+            continue;
+        }
+
+        RiffReadHelper reader = dataChunk->asReadHelper();
+        auto readRemainingAsString = [&]() { return String((const char*)reader.getData(), (const char*)reader.getData() + reader.getRemainingSize()); };
+
+        switch (dataChunk->m_fourCC)
+        {
+            case kDependencyFourCc:
+            {
+                Dependency dependency;
+                SLANG_RETURN_ON_FAIL(reader.read(dependency.digest.data));
+                dependency.path = readRemainingAsString();
+                outEntry.dependencies.add(dependency);
+                break;
+            }
+            case kEntryPointFourCc:
+            {
+                EntryPoint entryPoint;
+                SLANG_RETURN_ON_FAIL(reader.read(entryPoint.profile));
+                entryPoint.name = readRemainingAsString();
+                outEntry.entryPoints.add(entryPoint);
+                break;
+            }
+            case kOutputFourCc:
+            {
+                int32_t indices[2];
+                uint32_t isText;
+                SLANG_RETURN_ON_FAIL(reader.read(indices));
+                SLANG_RETURN_ON_FAIL(reader.read(isText));
+
+                Output output;
+                output.targetIndex = Index(indices[0]);
+                output.entryPointIndex = Index(indices[1]);
+                output.isText = (isText != 0);
+
+                List<uint8_t> data;
+                data.addRange(reader.getData(), Index(reader.getRemainingSize()));
+                output.blob = ListBlob::moveCreate(data);
+
+                outEntry.outputs.add(output);
+                break;
+            }
+            case kDiagnosticsFourCc:
+            {
+                outEntry.diagnostics = readRemainingAsString();
+                break;
+            }
+            default: break;
+        }
+    }
+
+    return SLANG_OK;
+}
+
+SlangResult CompileCache::findEntry(const Key& key, ISlangFileSystemExt* fileSystem, Entry& outEntry)
+{
+    const String path = _getEntryPath(key);
+
+    SlangResult res = SLANG_E_NOT_FOUND;
+    if (File::exists(path))
+    {
+        RiffContainer container;
+        try
+        {
+            FileStream stream(path, FileMode::Open, FileAccess::Read, FileShare::ReadWrite);
+            res = RiffUtil::read(&stream, container);
+        }
+        catch (const IOException&)
+        {
+            res = SLANG_FAIL;
+        }
+
+        if (SLANG_SUCCEEDED(res))
+        {
+            res = _readEntry(container.getRoot(), key, outEntry);
+        }
+
+        // Only usable if everything the compilation read is unchanged
+        for (Index i = 0; SLANG_SUCCEEDED(res) && i < outEntry.dependencies.getCount(); ++i)
+        {
+            const auto& dependency = outEntry.dependencies[i];
+            SHA1::Digest digest;
+            if (SLANG_FAILED(calcFileDigest(fileSystem, dependency.path, digest)) || digest != dependency.digest)
+            {
+                res = SLANG_FAIL;
+            }
+        }
+
+        if (SLANG_SUCCEEDED(res))
+        {
+            // Mark as recently used. If this fails it just means the entry might be evicted sooner.
+            File::updateModifiedTime(path);
+        }
+        else
+        {
+            outEntry = Entry();
+            res = SLANG_E_NOT_FOUND;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (SLANG_SUCCEEDED(res))
+    {
+        m_hitCount++;
+    }
+    else
+    {
+        m_missCount++;
+    }
+    return res;
+}
+
+String CompileCache::_getTemporaryEntryPath(const Key& key)
+{
+    // Unique to this write, so writes of the same entry (from this or other processes) don't collide
+    StringBuilder builder;
+    builder << key.toString() << "-";
+    builder.append(uint64_t(ProcessUtil::getClockTick()), 16);
+    builder << "-";
+    builder.append(uint64_t(++m_temporaryCount), 16);
+    builder << "-";
+    builder.append(uint64_t(size_t(this)), 16);
+    builder << kTemporaryFileExtension;
+    return Path::combine(m_directory, builder);
+}
+
+SlangResult CompileCache::addEntry(const Key& key, const Entry& entry)
+{
+    const String path = _getEntryPath(key);
+
+    // The entry is written to a temporary file which is then renamed, so a reader never sees a partial entry
+    const String temporaryPath = _getTemporaryEntryPath(key);
+
+    SlangResult res = SLANG_OK;
+    try
+    {
+        FileStream stream(temporaryPath, FileMode::Create, FileAccess::Write, FileShare::ReadWrite);
+        res = _writeEntry(key, entry, &stream);
+    }
+    catch (const IOException&)
+    {
+        res = SLANG_FAIL;
+    }
+
+    if (SLANG_SUCCEEDED(res))
+    {
+        res = File::rename(temporaryPath, path);
+    }
+
+    if (SLANG_FAILED(res))
+    {
+        // Don't leave a partially written entry around
+        File::remove(temporaryPath);
+        return res;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    _evictIfNeeded();
+    return SLANG_OK;
+}
+
+void CompileCache::_findFiles(const char* extension, List<FileInfo>& outFiles)
+{
+    struct Visitor : public Path::Visitor
+    {
+        virtual void accept(Path::Type type, const UnownedStringSlice& filename) SLANG_OVERRIDE
+        {
+            if (type != Path::Type::File)
+            {
+                return;
+            }
+
+            FileInfo info;
+            info.path = Path::combine(m_directory, filename);
+            if (SLANG_SUCCEEDED(File::getSizeAndModifiedTime(info.path, info.size, info.modifiedTime)))
+            {
+                m_files.add(info);
+            }
+        }
+
+        Visitor(const String& directory, List<FileInfo>& files):
+            m_directory(directory),
+            m_files(files)
+        {
+        }
+
+        const String& m_directory;
+        List<FileInfo>& m_files;
+    };
+
+    String pattern = String("*") + extension;
+    Visitor visitor(m_directory, outFiles);
+    Path::find(m_directory, pattern.getBuffer(), &visitor);
+}
+
+void CompileCache::_findEntryFiles(List<FileInfo>& outFiles)
+{
+    _findFiles(kEntryFileExtension, outFiles);
+}
+
+void CompileCache::_removeStaleTemporaryFiles()
+{
+    List<FileInfo> files;
+    _findFiles(kTemporaryFileExtension, files);
+    if (files.getCount() == 0)
+    {
+        return;
+    }
+
+    const uint64_t now = uint64_t(::time(nullptr));
+    for (const auto& file : files)
+    {
+        if (file.modifiedTime + kStaleTemporaryFileAge < now)
+        {
+            File::remove(file.path);
+        }
+    }
+}
+
+void CompileCache::_evictIfNeeded()
+{
+    _removeStaleTemporaryFiles();
+
+    List<FileInfo> files;
+    _findEntryFiles(files);
+
+    uint64_t totalSize = 0;
+    for (const auto& file : files)
+    {
+        totalSize += file.size;
+    }
+    if (totalSize <= m_maxSizeInBytes)
+    {
+        return;
+    }
+
+    // Evict the least recently used first
+    files.sort([](const FileInfo& a, const FileInfo& b) { return a.modifiedTime < b.modifiedTime; });
+
+    for (Index i = 0; i < files.getCount() && totalSize > m_maxSizeInBytes; ++i)
+    {
+        const auto& file = files[i];
+        if (SLANG_SUCCEEDED(File::remove(file.path)))
+        {
+            totalSize -= file.size;
+            m_evictedCount++;
+        }
+    }
+}
+
+SlangResult CompileCache::getStats(SlangCompileCacheStats& outStats)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    List<FileInfo> files;
+    _findEntryFiles(files);
+
+    outStats.hitCount = m_hitCount;
+    outStats.missCount = m_missCount;
+    outStats.evictedCount = m_evictedCount;
+    outStats.entryCount = uint64_t(files.getCount());
+    outStats.totalSizeInBytes = 0;
+    for (const auto& file : files)
+    {
+        outStats.totalSizeInBytes += file.size;
+    }
+    return SLANG_OK;
+}
+
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+bool canUseCompileCache(EndToEndCompileRequest* request)
+{
+    auto linkage = request->getLinkage();
+    auto frontEndReq = request->getFrontEndReq();
+    auto backEndReq = request->getBackEndReq();
+
+    if (request->passThrough != PassThroughMode::None ||
+        request->m_containerFormat != ContainerFormat::None ||
+        request->shouldSkipCodegen ||
+        (frontEndReq->compileFlags & SLANG_COMPILE_FLAG_NO_CODEGEN) ||
+        request->dumpRepro.getLength() ||
+        request->dumpReproOnError)
+    {
+        return false;
+    }
+
+    // Dumping is a side effect of compilation, that wouldn't happen on a hit
+    if (frontEndReq->shouldDumpIR || frontEndReq->shouldDumpAST || frontEndReq->outputIncludes ||
+        backEndReq->shouldDumpIR || backEndReq->shouldDumpIntermediates)
+    {
+        return false;
+    }
+
+    // A hit would have nothing to report
+    if (request->getPerfReport())
+    {
+        return false;
+    }
+
+    // Libraries and entry points added directly as IR, are not described by anything that is part of the key
+    if (linkage->m_libModules.getCount() || frontEndReq->m_extraEntryPoints.getCount())
+    {
+        return false;
+    }
+
+    for (auto targetReq : linkage->targets)
+    {
+        // A host callable is loaded into the process so can't be stored
+        if (targetReq->getTarget() == CodeGenTarget::HostCallable)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void _appendString(SHA1& sha1, const String& string)
+{
+    sha1.appendSized(string.getUnownedSlice());
+}
+
+static void _appendDefines(SHA1& sha1, const Dictionary<String, String>& defines)
+{
+    // The order of a dictionary is not defined, so sort
+    List<KeyValuePair<String, String>> pairs;
+    for (const auto& pair : defines)
+    {
+        pairs.add(pair);
+    }
+    pairs.sort([](const KeyValuePair<String, String>& a, const KeyValuePair<String, String>& b) { return a.Key < b.Key; });
+
+    sha1.appendValue(uint64_t(pairs.getCount()));
+    for (const auto& pair : pairs)
+    {
+        _appendString(sha1, pair.Key);
+        _appendString(sha1, pair.Value);
+    }
+}
+
+static void _appendSearchDirectories(SHA1& sha1, const SearchDirectoryList& searchDirectories)
+{
+    sha1.appendValue(uint64_t(searchDirectories.searchDirectories.getCount()));
+    for (const auto& searchDirectory : searchDirectories.searchDirectories)
+    {
+        _appendString(sha1, searchDirectory.path);
+    }
+}
+
+static void _appendDownstreamCompiler(SHA1& sha1, Session* session, CodeGenTarget target)
+{
+    // The compiler that is used is found in the same way as when compiling
+    const PassThroughMode passThrough = getDownstreamCompilerRequiredForTarget(target);
+
+    DownstreamCompiler* compiler = nullptr;
+    switch (passThrough)
+    {
+        case PassThroughMode::None:                 break;
+        case PassThroughMode::GenericCCpp:          compiler = session->getDefaultDownstreamCompiler(SourceLanguage::CPP); break;
+        case PassThroughMode::NVRTC:                compiler = session->getDefaultDownstreamCompiler(SourceLanguage::CUDA); break;
+        default:                                    compiler = session->getOrLoadDownstreamCompiler(passThrough, nullptr); break;
+    }
+
+    // If there is no compiler the compilation will fail, and so won't be stored
+    if (!compiler)
+    {
+        sha1.appendValue(int32_t(SLANG_PASS_THROUGH_NONE));
+        return;
+    }
+
+    DownstreamCompileResultCache::appendCompilerToKey(compiler, sha1);
+}
+
+SlangResult calcCompileCacheKey(EndToEndCompileRequest* request, CompileCache::Key& outKey)
+{
+    auto session = request->getSession();
+    auto linkage = request->getLinkage();
+    auto frontEndReq = request->getFrontEndReq();
+    auto backEndReq = request->getBackEndReq();
+
+    SHA1 sha1;
+
+    // The compiler and format the entry is for
+    sha1.appendValue(CompileCache::Header::getCurrentVersion().m_raw);
+    _appendString(sha1, session->getBuildTagString());
+
+    for (Index i = 0; i < Index(SourceLanguage::CountOf); ++i)
+    {
+        _appendString(sha1, session->getPreludeForLanguage(SourceLanguage(i)));
+    }
+
+    // The options as specified on the command line (if there was one)
+    sha1.appendValue(uint64_t(request->m_commandLineArgs.getCount()));
+    for (const auto& arg : request->m_commandLineArgs)
+    {
+        _appendString(sha1, arg);
+    }
+
+    // The options as they were set on the request, which is all there is if the request was set up through the API
+    sha1.appendValue(uint64_t(linkage->targets.getCount()));
+    for (auto targetReq : linkage->targets)
+    {
+        sha1.appendValue(int32_t(targetReq->getTarget()));
+        sha1.appendValue(uint32_t(targetReq->targetFlags));
+        sha1.appendValue(uint32_t(targetReq->getTargetProfile().raw));
+        sha1.appendValue(int32_t(targetReq->getFloatingPointMode()));
+
+        _appendDownstreamCompiler(sha1, session, targetReq->getTarget());
+    }
+
+    sha1.appendValue(int32_t(linkage->optimizationLevel));
+    sha1.appendValue(int32_t(linkage->debugInfoLevel));
+    sha1.appendValue(int32_t(linkage->defaultMatrixLayoutMode));
+    sha1.appendValue(uint8_t(linkage->m_obfuscateCode));
+    _appendDefines(sha1, linkage->preprocessorDefinitions);
+    _appendSearchDirectories(sha1, linkage->searchDirectories);
+
+    sha1.appendValue(uint32_t(frontEndReq->compileFlags));
+    _appendDefines(sha1, frontEndReq->preprocessorDefinitions);
+    _appendSearchDirectories(sha1, frontEndReq->searchDirectories);
+
+    sha1.appendValue(int32_t(backEndReq->lineDirectiveMode));
+    sha1.appendValue(uint8_t(backEndReq->useUnknownImageFormatAsDefault));
+    sha1.appendValue(uint8_t(backEndReq->shouldEmitSPIRVDirectly));
+    sha1.appendValue(uint8_t(backEndReq->shouldValidateSPIRVEmittedDirectly));
+    sha1.appendValue(uint8_t(backEndReq->cpuSIMDMode));
+    sha1.appendValue(uint8_t(backEndReq->disableSpecialization));
+    sha1.appendValue(uint8_t(backEndReq->disableDynamicDispatch));
+
+    // The source, with the contents of the files as they were loaded
+    sha1.appendValue(uint64_t(frontEndReq->translationUnits.getCount()));
+    for (auto translationUnit : frontEndReq->translationUnits)
+    {
+        sha1.appendValue(int32_t(translationUnit->sourceLanguage));
+        _appendString(sha1, translationUnit->moduleName ? translationUnit->moduleName->text : String());
+        _appendDefines(sha1, translationUnit->preprocessorDefinitions);
+
+        const auto& sourceFiles = translationUnit->getSourceFiles();
+        sha1.appendValue(uint64_t(sourceFiles.getCount()));
+        for (auto sourceFile : sourceFiles)
+        {
+            _appendString(sha1, sourceFile->getPathInfo().foundPath);
+
+            const UnownedStringSlice content = sourceFile->getContent();
+            const SHA1::Digest contentDigest = SHA1::compute(content.begin(), content.getLength());
+            sha1.appendValue(contentDigest.data);
+        }
+    }
+
+    // The entry points, and how they (and the program) are specialized
+    const auto& entryPointReqs = frontEndReq->getEntryPointReqs();
+    sha1.appendValue(uint64_t(entryPointReqs.getCount()));
+    for (auto entryPointReq : entryPointReqs)
+    {
+        _appendString(sha1, entryPointReq->getName()->text);
+        sha1.appendValue(uint32_t(entryPointReq->getProfile().raw));
+        sha1.appendValue(int32_t(entryPointReq->getTranslationUnitIndex()));
+    }
+
+    sha1.appendValue(uint64_t(request->globalSpecializationArgStrings.getCount()));
+    for (const auto& argString : request->globalSpecializationArgStrings)
+    {
+        _appendString(sha1, argString);
+    }
+
+    sha1.appendValue(uint64_t(request->entryPoints.getCount()));
+    for (const auto& entryPointInfo : request->entryPoints)
+    {
+        sha1.appendValue(uint64_t(entryPointInfo.specializationArgStrings.getCount()));
+        for (const auto& argString : entryPointInfo.specializationArgStrings)
+        {
+            _appendString(sha1, argString);
+        }
+    }
+
+    outKey = sha1.finalize();
+    return SLANG_OK;
+}
+
+SlangResult createCompileCacheEntry(EndToEndCompileRequest* request, const String& diagnostics, CompileCache::Entry& outEntry)
+{
+    auto linkage = request->getLinkage();
+    auto fileSystem = linkage->getFileSystemExt();
+
+    // Everything that was read in producing the program
+    for (const auto& path : request->getFrontEndReq()->getGlobalAndEntryPointsComponentType()->getFilePathDependencies())
+    {
+        CompileCache::Dependency dependency;
+        dependency.path = path;
+        SLANG_RETURN_ON_FAIL(CompileCache::calcFileDigest(fileSystem, path, dependency.digest));
+        outEntry.dependencies.add(dependency);
+    }
+
+    auto program = request->getSpecializedGlobalAndEntryPointsComponentType();
+    const Index entryPointCount = program->getEntryPointCount();
+
+    for (Index i = 0; i < entryPointCount; ++i)
+    {
+        auto entryPoint = program->getEntryPoint(i);
+
+        CompileCache::EntryPoint cacheEntryPoint;
+        cacheEntryPoint.name = entryPoint->getName()->text;
+        cacheEntryPoint.profile = uint32_t(entryPoint->getProfile().raw);
+        outEntry.entryPoints.add(cacheEntryPoint);
+    }
+
+    auto addOutput = [&](Index targetIndex, Index entryPointIndex, const CompileResult& result) -> SlangResult
+    {
+        if (result.format == ResultFormat::None)
+        {
+            return SLANG_OK;
+        }
+
+        CompileCache::Output output;
+        output.targetIndex = targetIndex;
+        output.entryPointIndex = entryPointIndex;
+        output.isText = (result.format == ResultFormat::Text);
+        SLANG_RETURN_ON_FAIL(result.getBlob(output.blob));
+
+        outEntry.outputs.add(output);
+        return SLANG_OK;
+    };
+
+    for (Index targetIndex = 0; targetIndex < linkage->targets.getCount(); ++targetIndex)
+    {
+        auto targetReq = linkage->targets[targetIndex];
+        auto targetProgram = program->getTargetProgram(targetReq);
+
+        if (targetReq->isWholeProgramRequest())
+        {
+            SLANG_RETURN_ON_FAIL(addOutput(targetIndex, -1, targetProgram->getExistingWholeProgramResult()));
+        }
+        else
+        {
+            for (Index entryPointIndex = 0; entryPointIndex < entryPointCount; ++entryPointIndex)
+            {
+                SLANG_RETURN_ON_FAIL(addOutput(targetIndex, entryPointIndex, targetProgram->getExistingEntryPointResult(entryPointIndex)));
+            }
+        }
+    }
+
+    outEntry.diagnostics = diagnostics;
+    return SLANG_OK;
+}
+
+} // namespace Slang
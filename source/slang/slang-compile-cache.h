@@ -0,0 +1,148 @@
+// slang-compile-cache.h
+#ifndef SLANG_COMPILE_CACHE_H_INCLUDED
+#define SLANG_COMPILE_CACHE_H_INCLUDED
+
+#include "../core/slang-basic.h"
+#include "../core/slang-sha1.h"
+#include "../core/slang-riff.h"
+
+#include "../../slang-com-ptr.h"
+#include "../../slang.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace Slang {
+
+class EndToEndCompileRequest;
+
+/* A persistent cache of the results of compilations, held as files in a directory.
+
+An entry is identified by a key, which is a digest of everything that was specified for a compilation -
+the options, the contents of the source files, the preludes, and the version of the compiler. The contents of
+the files that are only found during compilation (via #include or import) can't be part of the key, so the entry
+records their paths and digests, and an entry is only returned if they are all unchanged.
+
+Least recently used entries are evicted when the total size of the entries exceeds the maximum size. The modified
+time of an entry's file is used to track when it was last used, so the order survives between processes.
+An entry is written to a temporary file in the directory, which is then renamed, so other processes never see a
+partial entry. An entry file that can't be read is treated as a miss, and will be replaced. */
+class CompileCache : public RefObject
+{
+public:
+    typedef SHA1::Digest Key;
+
+        /// A file that was read during the compilation
+    struct Dependency
+    {
+        String path;
+        SHA1::Digest digest;
+    };
+
+    struct EntryPoint
+    {
+        String name;
+        uint32_t profile;                   ///< Raw profile
+    };
+
+    struct Output
+    {
+        Index targetIndex;
+        Index entryPointIndex;              ///< The entry point index, or -1 if the output is for the whole program
+        bool isText;
+        ComPtr<ISlangBlob> blob;
+    };
+
+    struct Entry
+    {
+        List<Dependency> dependencies;
+        List<EntryPoint> entryPoints;
+        List<Output> outputs;
+        String diagnostics;                 ///< Diagnostics (without errors) produced by the compilation
+    };
+
+    static const FourCC kEntryFourCc = SLANG_FOUR_CC('S', 'L', 'c', 'e');
+    static const FourCC kHeaderFourCc = SLANG_FOUR_CC('S', 'L', 'c', 'h');
+    static const FourCC kDependencyFourCc = SLANG_FOUR_CC('S', 'L', 'c', 'd');
+    static const FourCC kEntryPointFourCc = SLANG_FOUR_CC('S', 'L', 'c', 'p');
+    static const FourCC kOutputFourCc = SLANG_FOUR_CC('S', 'L', 'c', 'o');
+    static const FourCC kDiagnosticsFourCc = SLANG_FOUR_CC('S', 'L', 'c', 'g');
+
+    struct Header
+    {
+            /// The version of the entry format. Should be changed whenever the format, or what is stored changes.
+        static RiffSemanticVersion getCurrentVersion() { return RiffSemanticVersion::make(1, 0, 0); }
+
+        uint32_t semanticVersion;           ///< The RiffSemanticVersion raw value
+        uint8_t key[SHA1::Digest::kSize];   ///< The key of the entry
+    };
+
+        /// Find the entry for the key. Only succeeds if all of the entries dependencies are unchanged, as seen through fileSystem.
+        /// Returns SLANG_E_NOT_FOUND if there isn't a usable entry.
+    SlangResult findEntry(const Key& key, ISlangFileSystemExt* fileSystem, Entry& outEntry);
+        /// Add (or replace) the entry for the key. May evict other entries.
+    SlangResult addEntry(const Key& key, const Entry& entry);
+
+        /// Get stats about the use of the cache (by this process), and what it holds
+    SlangResult getStats(SlangCompileCacheStats& outStats);
+
+        /// Set the maximum total size of the entries. If 0, the default size is used.
+    void setMaxSizeInBytes(uint64_t size);
+    uint64_t getMaxSizeInBytes();
+
+        /// Get the directory the entries are stored in
+    const String& getDirectory() const { return m_directory; }
+
+        /// Calculate the digest of the contents of the file at path
+    static SlangResult calcFileDigest(ISlangFileSystemExt* fileSystem, const String& path, SHA1::Digest& outDigest);
+
+        /// Ctor. The directory must exist.
+    CompileCache(const String& directory);
+
+    static const uint64_t kDefaultMaxSizeInBytes = uint64_t(256) * 1024 * 1024;
+
+protected:
+    struct FileInfo
+    {
+        String path;
+        uint64_t size;
+        uint64_t modifiedTime;
+    };
+
+    String _getEntryPath(const Key& key) const;
+        /// Get a path, unique to this call, that an entry can be written to before it's renamed to the entry path
+    String _getTemporaryEntryPath(const Key& key);
+    void _findFiles(const char* extension, List<FileInfo>& outFiles);
+    void _findEntryFiles(List<FileInfo>& outFiles);
+        /// Remove temporary files left by writes that didn't complete (say because the process was killed)
+    void _removeStaleTemporaryFiles();
+    void _evictIfNeeded();
+
+    static SlangResult _writeEntry(const Key& key, const Entry& entry, Stream* stream);
+    static SlangResult _readEntry(RiffContainer::ListChunk* entryChunk, const Key& key, Entry& outEntry);
+
+    std::mutex m_mutex;                     ///< Guards all of the state below, as compiles using the cache can be on multiple threads
+
+    String m_directory;
+    uint64_t m_maxSizeInBytes = kDefaultMaxSizeInBytes;
+
+    uint64_t m_hitCount = 0;
+    uint64_t m_missCount = 0;
+    uint64_t m_evictedCount = 0;
+
+    std::atomic<uint64_t> m_temporaryCount { 0 };
+};
+
+    /// True if the results of the request can be stored in, and retrieved from a compile cache.
+    /// Things that have side effects (like dumping), or produce results that can't be stored (like host callables) can't.
+bool canUseCompileCache(EndToEndCompileRequest* request);
+
+    /// Calculate the key that identifies the result of compiling the request
+SlangResult calcCompileCacheKey(EndToEndCompileRequest* request, CompileCache::Key& outKey);
+
+    /// Create an entry holding the results of the request, which must have compiled successfully
+SlangResult createCompileCacheEntry(EndToEndCompileRequest* request, const String& diagnostics, CompileCache::Entry& outEntry);
+
+} // namespace Slang
+
+#endif
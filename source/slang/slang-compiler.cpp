@@ -7,6 +7,7 @@
 #include "../core/slang-hex-dump-util.h"
 #include "../core/slang-riff.h"
 #include "../core/slang-type-text-util.h"
+#include "../core/slang-thread-pool.h"
 
 #include "slang-check.h"
 #include "slang-compiler.h"
@@ -782,6 +783,62 @@ namespace Slang
         reportExternalCompileError(compilerName, SLANG_FAILED(res) ? Severity::Error : Severity::Warning, res, diagnostic, sink);
     }
 
+    bool DownstreamLibraryCompileCache::init(Session* session, PassThroughMode passThrough, EndToEndCompileRequest* endToEndReq)
+    {
+        cache.setNull();
+        if (endToEndReq && endToEndReq->passThrough != PassThroughMode::None)
+        {
+            return false;
+        }
+
+        RefPtr<DownstreamCompileResultCache> sessionCache = session->getDownstreamCompileResultCache();
+        DownstreamCompiler* compiler = sessionCache ? session->getOrLoadDownstreamCompiler(passThrough, nullptr) : nullptr;
+        if (!compiler)
+        {
+            return false;
+        }
+
+        sha1 = SHA1();
+        DownstreamCompileResultCache::appendCompilerToKey(compiler, sha1);
+        cache = sessionCache;
+        return true;
+    }
+
+    bool DownstreamLibraryCompileCache::find(List<uint8_t>& outCode)
+    {
+        if (!cache)
+        {
+            return false;
+        }
+        key = sha1.finalize();
+
+        RefPtr<DownstreamCompileResult> result = cache->find(key);
+        ComPtr<ISlangBlob> blob;
+        if (!result || SLANG_FAILED(result->getBinary(blob)))
+        {
+            return false;
+        }
+
+        outCode.clear();
+        outCode.addRange((const uint8_t*)blob->getBufferPointer(), Index(blob->getBufferSize()));
+        return true;
+    }
+
+    void DownstreamLibraryCompileCache::add(const void* code, size_t size)
+    {
+        if (!cache)
+        {
+            return;
+        }
+
+        DownstreamDiagnostics diagnostics;
+        diagnostics.result = SLANG_OK;
+
+        ComPtr<ISlangBlob> blob(new RawBlob(code, size));
+        RefPtr<DownstreamCompileResult> result(new BlobDownstreamCompileResult(diagnostics, blob));
+        cache->add(key, result);
+    }
+
     static String _getDisplayPath(DiagnosticSink* sink, SourceFile* sourceFile)
     {
         if (sink->isFlagSet(DiagnosticSink::Flag::VerbosePath))
@@ -1023,6 +1080,20 @@ namespace Slang
 
         const String sourcePath = calcSourcePathForEntryPoint(endToEndReq, entryPointIndex);
 
+        DownstreamLibraryCompileCache cache;
+        if (cache.init(session, PassThroughMode::Fxc, endToEndReq))
+        {
+            cache.sha1.appendSized(hlslCode.getUnownedSlice());
+            cache.sha1.appendSized(sourcePath.getUnownedSlice());
+            cache.sha1.appendSized(getText(entryPoint->getName()).getUnownedSlice());
+            cache.sha1.appendSized(GetHLSLProfileName(profile).getUnownedSlice());
+            cache.sha1.appendValue(uint32_t(flags));
+            if (cache.find(byteCodeOut))
+            {
+                return SLANG_OK;
+            }
+        }
+
         ComPtr<ID3DBlob> codeBlob;
         ComPtr<ID3DBlob> diagnosticsBlob;
         HRESULT hr = compileFunc(
@@ -1041,6 +1112,7 @@ namespace Slang
         if (codeBlob && SLANG_SUCCEEDED(hr))
         {
             byteCodeOut.addRange((uint8_t const*)codeBlob->GetBufferPointer(), (int)codeBlob->GetBufferSize());
+            cache.add(codeBlob->GetBufferPointer(), codeBlob->GetBufferSize());
         }
 
         if (FAILED(hr))
@@ -1135,9 +1207,13 @@ SlangResult dissassembleDXILUsingDXC(
 #endif
 
 #if SLANG_ENABLE_GLSLANG_SUPPORT
-    SlangResult invokeGLSLCompiler(
+        /// Invoke glslang with `request`, appending any diagnostics it outputs to `outDiagnostics`.
+        ///
+        /// Returns SLANG_E_NOT_AVAILABLE if glslang can't be loaded (which is reported to the sink), and SLANG_FAIL if the request fails.
+    static SlangResult _invokeGLSLCompiler(
         BackEndCompileRequest*      slangCompileRequest,
-        glslang_CompileRequest_1_1&     request)
+        glslang_CompileRequest_1_1&     request,
+        StringBuilder&              outDiagnostics)
     {
         Session* session = slangCompileRequest->getSession();
         auto sink = slangCompileRequest->getSink();
@@ -1151,18 +1227,16 @@ SlangResult dissassembleDXILUsingDXC(
             // Try again and put diagnostic to the sink
             session->getSharedLibraryFunc(Session::SharedLibraryFuncType::Glslang_Compile_1_0, sink);
             session->getSharedLibraryFunc(Session::SharedLibraryFuncType::Glslang_Compile_1_1, sink);
-            return SLANG_FAIL;
+            return SLANG_E_NOT_AVAILABLE;
         }
 
-        StringBuilder diagnosticOutput;
-        
         auto diagnosticOutputFunc = [](void const* data, size_t size, void* userData)
         {
             (*(StringBuilder*)userData).append((char const*)data, (char const*)data + size);
         };
 
         request.diagnosticFunc = diagnosticOutputFunc;
-        request.diagnosticUserData = &diagnosticOutput;
+        request.diagnosticUserData = &outDiagnostics;
 
         request.optimizationLevel = (unsigned)linkage->optimizationLevel;
         request.debugInfoType = (unsigned)linkage->debugInfoLevel;
@@ -1179,13 +1253,20 @@ SlangResult dissassembleDXILUsingDXC(
             err = glslang_compile_1_0(&request_1_0);   
         }
 
-        if (err)
+        return err ? SLANG_FAIL : SLANG_OK;
+    }
+
+    SlangResult invokeGLSLCompiler(
+        BackEndCompileRequest*      slangCompileRequest,
+        glslang_CompileRequest_1_1&     request)
+    {
+        StringBuilder diagnosticOutput;
+        const SlangResult res = _invokeGLSLCompiler(slangCompileRequest, request, diagnosticOutput);
+        if (res == SLANG_FAIL)
         {
-            reportExternalCompileError("glslang", SLANG_FAIL, diagnosticOutput.getUnownedSlice(), sink);
-            return SLANG_FAIL;
+            reportExternalCompileError("glslang", SLANG_FAIL, diagnosticOutput.getUnownedSlice(), slangCompileRequest->getSink());
         }
-
-        return SLANG_OK;
+        return res;
     }
 
     SlangResult dissassembleSPIRV(
@@ -1223,15 +1304,39 @@ SlangResult dissassembleDXILUsingDXC(
         return SLANG_OK;
     }
 
-    SlangResult emitWithDownstreamForEntryPoints(
+        /// Validate the SPIR-V module in `data` with SPIRV-Tools (as used by glslang).
+        ///
+        /// Returns SLANG_FAIL if the module is invalid, with the validation errors in `outDiagnostics`.
+    static SlangResult _validateSPIRV(
+        BackEndCompileRequest*  slangRequest,
+        void const*             data,
+        size_t                  size,
+        String&                 outDiagnostics)
+    {
+        glslang_CompileRequest_1_1 request;
+        memset(&request, 0, sizeof(request));
+        request.sizeInBytes = sizeof(request);
+
+        request.action = GLSLANG_ACTION_VALIDATE_SPIRV;
+
+        request.inputBegin = data;
+        request.inputEnd = (char*)data + size;
+
+        StringBuilder diagnostics;
+        const SlangResult res = _invokeGLSLCompiler(slangRequest, request, diagnostics);
+        outDiagnostics = diagnostics.ProduceString();
+        return res;
+    }
+
+        /// Determines the downstream compiler, and the options (including the source) to compile the entry points with it
+    static SlangResult _prepareDownstreamCompile(
         BackEndCompileRequest*  slangRequest,
         const List<Int>&        entryPointIndices,
         TargetRequest*          targetReq,
         EndToEndCompileRequest* endToEndReq,
-        RefPtr<DownstreamCompileResult>& outResult)
+        RefPtr<DownstreamCompiler>& outCompiler,
+        DownstreamCompiler::CompileOptions& outOptions)
     {
-        outResult.setNull();
-
         auto sink = slangRequest->getSink();
 
         auto session = slangRequest->getSession();
@@ -1451,6 +1556,15 @@ SlangResult dissassembleDXILUsingDXC(
                 default: SLANG_ASSERT(!"Unhandled floating point mode");
             }
 
+            switch (slangRequest->cpuSIMDMode)
+            {
+                case CPUSIMDMode::None:             options.simdMode = DownstreamCompiler::SIMDMode::Default; break;
+                case CPUSIMDMode::SSE:              options.simdMode = DownstreamCompiler::SIMDMode::SSE; break;
+                case CPUSIMDMode::AVX2:             options.simdMode = DownstreamCompiler::SIMDMode::AVX2; break;
+                case CPUSIMDMode::AVX512:           options.simdMode = DownstreamCompiler::SIMDMode::AVX512; break;
+                default: SLANG_ASSERT(!"Unhandled CPU SIMD mode");
+            }
+
             {
                 // We need to look at the stage of the entry point(s) we are
                 // being asked to compile, since this will determine the
@@ -1517,10 +1631,24 @@ SlangResult dissassembleDXILUsingDXC(
             }
         }
 
-        // Compile
-        RefPtr<DownstreamCompileResult> downstreamCompileResult;
-        SLANG_RETURN_ON_FAIL(compiler->compile(options, downstreamCompileResult));
-        
+        outCompiler = compiler;
+        outOptions = options;
+        return SLANG_OK;
+    }
+
+        /// Reports the diagnostics of a completed downstream compile to the sink.
+        /// compileRes is the result of invoking the compiler.
+    static SlangResult _reportDownstreamCompileResult(
+        DiagnosticSink*                 sink,
+        DownstreamCompiler*             compiler,
+        SlangResult                     compileRes,
+        DownstreamCompileResult*        downstreamCompileResult,
+        RefPtr<DownstreamCompileResult>& outResult)
+    {
+        outResult.setNull();
+
+        SLANG_RETURN_ON_FAIL(compileRes);
+
         const auto& diagnostics = downstreamCompileResult->getDiagnostics();
 
         {
@@ -1585,12 +1713,70 @@ SlangResult dissassembleDXILUsingDXC(
         return SLANG_OK;
     }
 
+        /// Get the session's cache of downstream compile results, if it's enabled and the result of compiling options for the target
+        /// can be held in it. If a cache is returned, outKey holds the key for the compile.
+    static RefPtr<DownstreamCompileResultCache> _getDownstreamCompileResultCache(
+        Session*                                    session,
+        TargetRequest*                              targetReq,
+        DownstreamCompiler*                         compiler,
+        const DownstreamCompiler::CompileOptions&   options,
+        DownstreamCompileResultCache::Key&          outKey)
+    {
+        // Each host callable result is a loaded library with its own global state, so can't be shared
+        if (targetReq->getTarget() == CodeGenTarget::HostCallable)
+        {
+            return nullptr;
+        }
+
+        RefPtr<DownstreamCompileResultCache> cache = session->getDownstreamCompileResultCache();
+        if (cache && SLANG_SUCCEEDED(DownstreamCompileResultCache::calcKey(compiler, options, outKey)))
+        {
+            return cache;
+        }
+        return nullptr;
+    }
+
+    SlangResult emitWithDownstreamForEntryPoints(
+        BackEndCompileRequest*  slangRequest,
+        const List<Int>&        entryPointIndices,
+        TargetRequest*          targetReq,
+        EndToEndCompileRequest* endToEndReq,
+        RefPtr<DownstreamCompileResult>& outResult)
+    {
+        outResult.setNull();
+
+        RefPtr<DownstreamCompiler> compiler;
+        DownstreamCompiler::CompileOptions options;
+        SLANG_RETURN_ON_FAIL(_prepareDownstreamCompile(slangRequest, entryPointIndices, targetReq, endToEndReq, compiler, options));
+
+        DownstreamCompileResultCache::Key cacheKey;
+        RefPtr<DownstreamCompileResultCache> cache = _getDownstreamCompileResultCache(slangRequest->getSession(), targetReq, compiler, options, cacheKey);
+
+        RefPtr<DownstreamCompileResult> downstreamCompileResult = cache ? cache->find(cacheKey) : nullptr;
+        SlangResult compileRes = SLANG_OK;
+        if (!downstreamCompileResult)
+        {
+            // Compile
+            compileRes = compiler->compile(options, downstreamCompileResult);
+            if (cache && SLANG_SUCCEEDED(compileRes))
+            {
+                downstreamCompileResult = cache->add(cacheKey, downstreamCompileResult);
+            }
+        }
+
+        return _reportDownstreamCompileResult(slangRequest->getSink(), compiler, compileRes, downstreamCompileResult, outResult);
+    }
+
     SlangResult emitSPIRVForEntryPointsDirectly(
         BackEndCompileRequest*  compileRequest,
         const List<Int>&        entryPointIndices,
         TargetRequest*          targetReq,
         List<uint8_t>&          spirvOut);
 
+    void getSPIRVInterfaceParts(
+        const List<uint8_t>&    spirv,
+        List<String>&           outParts);
+
     SlangResult emitSPIRVForEntryPointsViaGLSL(
         ComponentType*                  program,
         BackEndCompileRequest*          slangRequest,
@@ -1641,7 +1827,103 @@ SlangResult dissassembleDXILUsingDXC(
         request.outputFunc = outputFunc;
         request.outputUserData = &spirvOut;
 
+        auto linkage = slangRequest->getLinkage();
+
+        DownstreamLibraryCompileCache cache;
+        if (cache.init(slangRequest->getSession(), PassThroughMode::Glslang, endToEndReq))
+        {
+            cache.sha1.appendSized(rawGLSL.getUnownedSlice());
+            cache.sha1.appendSized(sourcePath.getUnownedSlice());
+            cache.sha1.appendValue(int32_t(request.slangStage));
+            cache.sha1.appendValue(int32_t(request.spirvVersion.major));
+            cache.sha1.appendValue(int32_t(request.spirvVersion.minor));
+            cache.sha1.appendValue(int32_t(request.spirvVersion.patch));
+            cache.sha1.appendValue(int32_t(linkage->optimizationLevel));
+            cache.sha1.appendValue(int32_t(linkage->debugInfoLevel));
+            if (cache.find(spirvOut))
+            {
+                return SLANG_OK;
+            }
+        }
+
         SLANG_RETURN_ON_FAIL(invokeGLSLCompiler(slangRequest, request));
+        cache.add(spirvOut.getBuffer(), size_t(spirvOut.getCount()));
+        return SLANG_OK;
+    }
+
+        /// Describe the parts of `parts` that aren't in `otherParts` (both sorted) to `out`
+    static void _appendMissingParts(const List<String>& parts, const List<String>& otherParts, const char* prefix, StringBuilder& out)
+    {
+        Index otherIndex = 0;
+        for (const auto& part : parts)
+        {
+            while (otherIndex < otherParts.getCount() && otherParts[otherIndex] < part)
+            {
+                otherIndex++;
+            }
+            if (otherIndex < otherParts.getCount() && otherParts[otherIndex] == part)
+            {
+                otherIndex++;
+                continue;
+            }
+            if (out.getLength())
+            {
+                out << ", ";
+            }
+            out << prefix << " '" << part << "'";
+        }
+    }
+
+        /// Check `ioSpirv` (emitted directly) against the SPIR-V generated via GLSL by glslang.
+        ///
+        /// If the directly emitted SPIR-V fails validation it is replaced by the SPIR-V generated via GLSL.
+        /// Differences in the interfaces of the modules (such as bindings and locations) are reported as warnings.
+    static SlangResult _validateSPIRVEmittedDirectly(
+        ComponentType*                  program,
+        BackEndCompileRequest*          slangRequest,
+        const List<Int>&                entryPointIndices,
+        TargetRequest*                  targetReq,
+        EndToEndCompileRequest*         endToEndReq,
+        List<uint8_t>&                  ioSpirv)
+    {
+        auto sink = slangRequest->getSink();
+        auto entryPoint = program->getEntryPoint(assertSingleEntryPoint(entryPointIndices));
+        const String entryPointName = getText(entryPoint->getName());
+
+        List<uint8_t> spirvViaGLSL;
+        SLANG_RETURN_ON_FAIL(emitSPIRVForEntryPointsViaGLSL(
+            program,
+            slangRequest,
+            entryPointIndices,
+            targetReq,
+            endToEndReq,
+            spirvViaGLSL));
+
+        String validationDiagnostics;
+        const SlangResult validateRes = _validateSPIRV(slangRequest, ioSpirv.getBuffer(), size_t(ioSpirv.getCount()), validationDiagnostics);
+        if (validateRes == SLANG_E_NOT_AVAILABLE)
+        {
+            return validateRes;
+        }
+        if (SLANG_FAILED(validateRes))
+        {
+            sink->diagnose(SourceLoc(), Diagnostics::spirvDirectEmitInvalid, entryPointName, validationDiagnostics);
+            ioSpirv.swapWith(spirvViaGLSL);
+            return SLANG_OK;
+        }
+
+        List<String> directParts;
+        List<String> viaGLSLParts;
+        getSPIRVInterfaceParts(ioSpirv, directParts);
+        getSPIRVInterfaceParts(spirvViaGLSL, viaGLSLParts);
+
+        StringBuilder differences;
+        _appendMissingParts(directParts, viaGLSLParts, "direct only", differences);
+        _appendMissingParts(viaGLSLParts, directParts, "via GLSL only", differences);
+        if (differences.getLength())
+        {
+            sink->diagnose(SourceLoc(), Diagnostics::spirvDirectEmitInterfaceMismatch, entryPointName, differences);
+        }
         return SLANG_OK;
     }
 
@@ -1655,22 +1937,39 @@ SlangResult dissassembleDXILUsingDXC(
     {
         if( slangRequest->shouldEmitSPIRVDirectly )
         {
-            return emitSPIRVForEntryPointsDirectly(
-                slangRequest,
-                entryPointIndices,
-                targetReq,
-                spirvOut);
-        }
-        else
-        {
-            return emitSPIRVForEntryPointsViaGLSL(
-                program,
+            const SlangResult res = emitSPIRVForEntryPointsDirectly(
                 slangRequest,
                 entryPointIndices,
                 targetReq,
-                endToEndReq,
                 spirvOut);
+
+            // If something couldn't be emitted directly (which has been diagnosed)
+            // we fall back to generating SPIR-V via GLSL.
+            //
+            if (res != SLANG_E_NOT_IMPLEMENTED)
+            {
+                SLANG_RETURN_ON_FAIL(res);
+                if (slangRequest->shouldValidateSPIRVEmittedDirectly)
+                {
+                    return _validateSPIRVEmittedDirectly(
+                        program,
+                        slangRequest,
+                        entryPointIndices,
+                        targetReq,
+                        endToEndReq,
+                        spirvOut);
+                }
+                return SLANG_OK;
+            }
         }
+
+        return emitSPIRVForEntryPointsViaGLSL(
+            program,
+            slangRequest,
+            entryPointIndices,
+            targetReq,
+            endToEndReq,
+            spirvOut);
     }
 
     SlangResult emitSPIRVAssemblyForEntryPoints(
@@ -2249,6 +2548,145 @@ SlangResult dissassembleDXILUsingDXC(
 
     }
 
+    void TargetProgram::_prepareForParallelCodeGen(DiagnosticSink* sink)
+    {
+        getOrCreateLayout(sink);
+
+        const Index entryPointCount = m_program->getEntryPointCount();
+        if (entryPointCount > m_entryPointResults.getCount())
+        {
+            m_entryPointResults.setCount(entryPointCount);
+        }
+    }
+
+        /// The downstream compile of a single entry point, which may still be running.
+        ///
+        /// Has its own sink, so the diagnostics can be output in entry point order
+        /// once the compile has completed.
+    class AsyncDownstreamCompile : public RefObject
+    {
+    public:
+            /// Generates the source for the entry point, and starts compiling it on the pool
+        SlangResult start(
+            Int                         entryPointIndex,
+            TargetRequest*              targetReq,
+            EndToEndCompileRequest*     endToEndReq,
+            DownstreamCompileJobPool*   pool)
+        {
+            List<Int> entryPointIndices;
+            entryPointIndices.add(entryPointIndex);
+
+            DownstreamCompiler::CompileOptions options;
+            SLANG_RETURN_ON_FAIL(_prepareDownstreamCompile(m_backEndReq, entryPointIndices, targetReq, endToEndReq, m_compiler, options));
+
+            // If the result is already known there is nothing to run
+            m_cache = _getDownstreamCompileResultCache(m_backEndReq->getSession(), targetReq, m_compiler, options, m_cacheKey);
+            m_cachedResult = m_cache ? m_cache->find(m_cacheKey) : nullptr;
+            if (m_cachedResult)
+            {
+                return SLANG_OK;
+            }
+
+            return m_compiler->compileAsync(options, pool, m_job);
+        }
+
+            /// Waits for the compile to complete (if it was started), and reports its diagnostics
+        SlangResult complete(RefPtr<DownstreamCompileResult>& outResult)
+        {
+            if (m_cachedResult)
+            {
+                return _reportDownstreamCompileResult(&m_sink, m_compiler, SLANG_OK, m_cachedResult, outResult);
+            }
+            if (!m_job)
+            {
+                return SLANG_FAIL;
+            }
+
+            RefPtr<DownstreamCompileResult> downstreamCompileResult;
+            const SlangResult compileRes = m_job->waitForResult(downstreamCompileResult);
+            if (m_cache && SLANG_SUCCEEDED(compileRes))
+            {
+                downstreamCompileResult = m_cache->add(m_cacheKey, downstreamCompileResult);
+            }
+            return _reportDownstreamCompileResult(&m_sink, m_compiler, compileRes, downstreamCompileResult, outResult);
+        }
+
+        AsyncDownstreamCompile(BackEndCompileRequest* compileReq)
+            : m_sink(compileReq->getSink()->getSourceManager())
+        {
+            if (compileReq->getSink()->isFlagSet(DiagnosticSink::Flag::VerbosePath))
+            {
+                m_sink.setFlag(DiagnosticSink::Flag::VerbosePath);
+            }
+
+            // The options are the same as the original request, only the sink differs
+            m_backEndReq = new BackEndCompileRequest(*compileReq);
+            m_backEndReq->setSink(&m_sink);
+        }
+
+        DiagnosticSink m_sink;
+        RefPtr<BackEndCompileRequest> m_backEndReq;
+        RefPtr<DownstreamCompiler> m_compiler;
+        RefPtr<DownstreamCompileJob> m_job;
+
+        RefPtr<DownstreamCompileResultCache> m_cache;               ///< Set if the result can be held in the session's cache
+        DownstreamCompileResultCache::Key m_cacheKey;
+        RefPtr<DownstreamCompileResult> m_cachedResult;             ///< Set if the result was found in the cache, so there is no job
+    };
+
+    void TargetProgram::_createEntryPointResultsWithAsyncDownstream(
+        BackEndCompileRequest*  backEndRequest,
+        EndToEndCompileRequest* endToEndRequest)
+    {
+        const Index entryPointCount = m_program->getEntryPointCount();
+        if (entryPointCount > m_entryPointResults.getCount())
+        {
+            m_entryPointResults.setCount(entryPointCount);
+        }
+
+        auto pool = backEndRequest->getSession()->getDownstreamCompileJobPool();
+
+        // Start all of the compiles. The source for an entry point is generated while the
+        // compiles of the entry points before it are running.
+        List<RefPtr<AsyncDownstreamCompile>> compiles;
+        std::exception_ptr exception;
+        try
+        {
+            for (Index ii = 0; ii < entryPointCount; ++ii)
+            {
+                RefPtr<AsyncDownstreamCompile> compile = new AsyncDownstreamCompile(backEndRequest);
+                compiles.add(compile);
+                compile->start(ii, m_targetReq, endToEndRequest, pool);
+            }
+        }
+        catch (...)
+        {
+            // Rethrown once the entry points before have been completed, as would happen serially
+            exception = std::current_exception();
+        }
+
+        // Complete in entry point order, so the results and diagnostics are the same as when compiling serially
+        auto sink = backEndRequest->getSink();
+        for (Index ii = 0; ii < compiles.getCount(); ++ii)
+        {
+            auto compile = compiles[ii];
+
+            RefPtr<DownstreamCompileResult> downstreamResult;
+            if (SLANG_SUCCEEDED(compile->complete(downstreamResult)))
+            {
+                maybeDumpIntermediate(compile->m_backEndReq, downstreamResult, m_targetReq->target);
+                m_entryPointResults[ii] = CompileResult(downstreamResult);
+            }
+
+            sink->appendDiagnostics(&compile->m_sink);
+        }
+
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+
     CompileResult& TargetProgram::getOrCreateWholeProgramResult(
         DiagnosticSink* sink)
     {
@@ -2306,6 +2744,39 @@ SlangResult dissassembleDXILUsingDXC(
             nullptr);
     }
 
+        /// True if the target's code is produced by a downstream compiler, and the compiles of the
+        /// entry points can be run asynchronously without changing the output.
+    static bool _canCompileDownstreamAsync(
+        BackEndCompileRequest*  compileReq,
+        TargetRequest*          targetReq,
+        EndToEndCompileRequest* endToEndReq)
+    {
+        switch (targetReq->target)
+        {
+            case CodeGenTarget::PTX:
+            case CodeGenTarget::HostCallable:
+            case CodeGenTarget::SharedLibrary:
+            case CodeGenTarget::Executable:
+                break;
+            default:
+                return false;
+        }
+
+        // Pass-through compiles diagnose directly to the end-to-end request's sink
+        if (isPassThroughEnabled(endToEndReq))
+        {
+            return false;
+        }
+
+        // The intermediates would be numbered in a different order
+        if (compileReq->shouldDumpIntermediates)
+        {
+            return false;
+        }
+
+        return true;
+    }
+
     void generateOutputForTarget(
         BackEndCompileRequest*  compileReq,
         TargetRequest*          targetReq,
@@ -2323,6 +2794,12 @@ SlangResult dissassembleDXILUsingDXC(
                 compileReq,
                 endToEndReq);
         }
+        else if (entryPointCount > 1 && _canCompileDownstreamAsync(compileReq, targetReq, endToEndReq))
+        {
+            targetProgram->_createEntryPointResultsWithAsyncDownstream(
+                compileReq,
+                endToEndReq);
+        }
         else
         {
             for (Index ii = 0; ii < entryPointCount; ++ii)
@@ -2335,6 +2812,169 @@ SlangResult dissassembleDXILUsingDXC(
         }
     }
 
+
+        /// Generates the code for a single entry point (or the whole program) for a target,
+        /// such that multiple can be generated at the same time on different threads.
+        ///
+        /// Each job has its own sink, so the diagnostics can be output in the same order
+        /// as when generated serially.
+    class ParallelCodeGenJob : public RefObject
+    {
+    public:
+        void run()
+        {
+            try
+            {
+                auto targetProgram = m_backEndReq->getProgram()->getTargetProgram(m_targetReq);
+                if (m_entryPointIndex < 0)
+                {
+                    targetProgram->_createWholeProgramResult(m_backEndReq, m_endToEndReq);
+                }
+                else
+                {
+                    targetProgram->_createEntryPointResult(m_entryPointIndex, m_backEndReq, m_endToEndReq);
+                }
+            }
+            catch (...)
+            {
+                // Rethrown on the calling thread, once the diagnostics up to this point have been output
+                m_exception = std::current_exception();
+            }
+        }
+
+        ParallelCodeGenJob(
+            BackEndCompileRequest*  compileReq,
+            TargetRequest*          targetReq,
+            Index                   entryPointIndex,
+            EndToEndCompileRequest* endToEndReq)
+            : m_sink(compileReq->getSink()->getSourceManager())
+            , m_targetReq(targetReq)
+            , m_entryPointIndex(entryPointIndex)
+            , m_endToEndReq(endToEndReq)
+        {
+            if (compileReq->getSink()->isFlagSet(DiagnosticSink::Flag::VerbosePath))
+            {
+                m_sink.setFlag(DiagnosticSink::Flag::VerbosePath);
+            }
+
+            // The options are the same as the original request, only the sink differs
+            m_backEndReq = new BackEndCompileRequest(*compileReq);
+            m_backEndReq->setSink(&m_sink);
+        }
+
+        DiagnosticSink m_sink;
+        RefPtr<BackEndCompileRequest> m_backEndReq;
+        TargetRequest* m_targetReq;
+        Index m_entryPointIndex;                    ///< The entry point index, or -1 for the whole program
+        EndToEndCompileRequest* m_endToEndReq;
+        std::exception_ptr m_exception;
+    };
+
+        /// True if the request asks for code generation on multiple threads, and nothing
+        /// requested depends on code being generated serially.
+    static bool _isParallelCodeGenEnabled(
+        BackEndCompileRequest*  compileReq,
+        EndToEndCompileRequest* endToEndReq)
+    {
+        if (compileReq->parallelJobCount == 1)
+        {
+            return false;
+        }
+
+        // Dumping writes output (and files with a global counter) as code is generated,
+        // which would not be deterministic
+        if (compileReq->shouldDumpIR || compileReq->shouldDumpIntermediates)
+        {
+            return false;
+        }
+
+        // Pass-through compiles diagnose directly to the end-to-end request's sink
+        if (isPassThroughEnabled(endToEndReq))
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+        /// Generate the code for all the targets, for the entry points (or the whole program) on a pool of threads.
+        /// Returns false if there is not enough work to be worth doing in parallel, and nothing was generated.
+    static bool _generateOutputInParallel(
+        BackEndCompileRequest*  compileReq,
+        EndToEndCompileRequest* endToEndReq)
+    {
+        auto program = compileReq->getProgram();
+        auto linkage = compileReq->getLinkage();
+        auto sink = compileReq->getSink();
+
+        List<RefPtr<ParallelCodeGenJob>> jobs;
+        for (auto targetReq : linkage->targets)
+        {
+            if (targetReq->isWholeProgramRequest())
+            {
+                jobs.add(new ParallelCodeGenJob(compileReq, targetReq, -1, endToEndReq));
+            }
+            else
+            {
+                const Index entryPointCount = program->getEntryPointCount();
+                for (Index ii = 0; ii < entryPointCount; ++ii)
+                {
+                    jobs.add(new ParallelCodeGenJob(compileReq, targetReq, ii, endToEndReq));
+                }
+            }
+        }
+
+        Index threadCount = compileReq->parallelJobCount;
+        if (threadCount <= 0)
+        {
+            threadCount = ThreadPool::getHardwareThreadCount();
+        }
+        threadCount = Math::Min(threadCount, jobs.getCount());
+        if (threadCount <= 1)
+        {
+            return false;
+        }
+
+        // Everything that would be created on demand during code generation has to exist
+        // before the jobs run, as it is shared between them
+        for (auto targetReq : linkage->targets)
+        {
+            program->getTargetProgram(targetReq)->_prepareForParallelCodeGen(sink);
+        }
+
+        // Witness tables are given sequential IDs (shared across all entry points) on the linkage as
+        // they are encountered during code generation. The jobs take turns to allocate them, so the
+        // IDs are the same as when the jobs run serially.
+        RefPtr<ParallelForTurns> witnessTableIDTurns = new ParallelForTurns(jobs.getCount());
+        for (Index i = 0; i < jobs.getCount(); ++i)
+        {
+            jobs[i]->m_backEndReq->witnessTableIDTurns = witnessTableIDTurns;
+            jobs[i]->m_backEndReq->parallelCodeGenJobIndex = i;
+        }
+
+        // The calling thread also runs jobs, so the pool needs one less thread
+        {
+            RefPtr<ThreadPool> threadPool = new ThreadPool(threadCount - 1);
+            threadPool->parallelFor(jobs.getCount(), [&](Index index)
+            {
+                jobs[index]->run();
+                // If the job failed before getting to its turn, later jobs mustn't wait for it
+                witnessTableIDTurns->endTurn(index);
+            });
+        }
+
+        // Output the diagnostics in the same order they would be if the jobs had run serially.
+        // If a job failed with an exception, later jobs would not have run.
+        for (auto& job : jobs)
+        {
+            sink->appendDiagnostics(&job->m_sink);
+            if (job->m_exception)
+            {
+                std::rethrow_exception(job->m_exception);
+            }
+        }
+        return true;
+    }
     
     SlangResult EndToEndCompileRequest::writeContainerToStream(Stream* stream)
     {
@@ -2344,6 +2984,7 @@ SlangResult dissassembleDXILUsingDXC(
         SerialContainerUtil::WriteOptions options;
 
         options.compressionType = linkage->serialCompressionType;
+        options.sourceManager = linkage->getSourceManager();
         if (linkage->debugInfoLevel != DebugInfoLevel::None)
         {
             options.optionFlags |= SerialOptionFlag::SourceLocation;
@@ -2457,6 +3098,15 @@ SlangResult dissassembleDXILUsingDXC(
         }
 
 
+        // If requested, the entry points (across all targets) can
+        // be generated on multiple threads.
+        //
+        if (_isParallelCodeGenEnabled(compileRequest, endToEndReq) &&
+            _generateOutputInParallel(compileRequest, endToEndReq))
+        {
+            return;
+        }
+
         // Go through the code-generation targets that the user
         // has specified, and generate code for each of them.
         //
@@ -2483,32 +3133,38 @@ SlangResult dissassembleDXILUsingDXC(
 
         if (compileRequest->isCommandLineCompile)
         {
-            auto linkage = compileRequest->getLinkage();
-            auto program = compileRequest->getSpecializedGlobalAndEntryPointsComponentType();
-            for (auto targetReq : linkage->targets)
+            writeCommandLineOutput(compileRequest);
+        }
+    }
+
+    void writeCommandLineOutput(
+        EndToEndCompileRequest* compileRequest)
+    {
+        auto linkage = compileRequest->getLinkage();
+        auto program = compileRequest->getSpecializedGlobalAndEntryPointsComponentType();
+        for (auto targetReq : linkage->targets)
+        {
+            Index entryPointCount = program->getEntryPointCount();
+            if (targetReq->isWholeProgramRequest()) {
+                writeWholeProgramResult(
+                    compileRequest,
+                    targetReq);
+            }
+            else
             {
-                Index entryPointCount = program->getEntryPointCount();
-                if (targetReq->isWholeProgramRequest()) {
-                    writeWholeProgramResult(
+                for (Index ee = 0; ee < entryPointCount; ++ee)
+                {
+                    writeEntryPointResult(
+                        program,
                         compileRequest,
+                        ee,
                         targetReq);
                 }
-                else
-                {
-                    for (Index ee = 0; ee < entryPointCount; ++ee)
-                    {
-                        writeEntryPointResult(
-                            program,
-                            compileRequest,
-                            ee,
-                            targetReq);
-                    }
-                }
             }
-
-            compileRequest->maybeCreateContainer();
-            compileRequest->maybeWriteContainer(compileRequest->m_containerOutputPath);
         }
+
+        compileRequest->maybeCreateContainer();
+        compileRequest->maybeWriteContainer(compileRequest->m_containerOutputPath);
     }
 
     // Debug logic for dumping intermediate outputs
@@ -18,6 +18,9 @@
 
 #include "slang-include-system.h"
 
+#include "slang-compile-cache.h"
+#include "slang-perf-report.h"
+
 #include "slang-serialize-ir-types.h"
 
 #include "../../slang.h"
@@ -26,11 +29,13 @@ namespace Slang
 {
     struct PathInfo;
     struct IncludeHandler;
+    class ParallelForTurns;
     class ProgramLayout;
     class PtrType;
     class TargetProgram;
     class TargetRequest;
     class TypeLayout;
+    class TypeLayoutCache;
 
     enum class CompilerMode
     {
@@ -849,6 +854,23 @@ namespace Slang
 
     class SourceFile;
 
+        /// Counts the modules of a linkage that have been released. Anything holding on to types of a
+        /// linkage (such as a TypeLayoutCache) can use it to tell when those types may have been released.
+        ///
+        /// Held by the linkage and its modules, so a module can record its release even if it outlives
+        /// the linkage.
+    class ReleasedModuleCounter : public RefObject
+    {
+    public:
+            /// Record a module being released. Can be called from any thread.
+        void add() { m_count.fetch_add(1, std::memory_order_relaxed); }
+            /// The number of modules released
+        Index getCount() const { return m_count.load(std::memory_order_relaxed); }
+
+    protected:
+        std::atomic<Index> m_count { 0 };
+    };
+
         /// A module of code that has been compiled through the front-end
         ///
         /// A module comprises all the code from one translation unit (which
@@ -927,6 +949,9 @@ namespace Slang
             /// Create a module (initially empty).
         Module(Linkage* linkage, ASTBuilder* astBuilder = nullptr);
 
+            /// Dtor
+        ~Module();
+
             /// Get the AST for the module (if it has been parsed)
         ModuleDecl* getModuleDecl() { return m_moduleDecl; }
 
@@ -977,6 +1002,15 @@ namespace Slang
             /// If not found returns nullptr.
         NodeBase* findExportFromMangledName(const UnownedStringSlice& slice);
 
+            /// Get the mangled names of all of the symbols exported by this module, and the nodes they refer to.
+            /// Creates all of the decls of the module if they are created on demand.
+        void getExportSymbols(List<UnownedStringSlice>& outMangledNames, List<NodeBase*>& outNodes);
+
+            /// Set the loader used to create the decls of the module on demand (if it was read from a serialized form)
+        void setASTDeclLoader(ASTDeclLoader* loader) { m_astDeclLoader = loader; }
+            /// Get the loader that creates decls of the module on demand. Returns nullptr if all the decls exist.
+        ASTDeclLoader* getASTDeclLoader() const { return m_astDeclLoader; }
+
             /// Get the ASTBuilder
         ASTBuilder* getASTBuilder() { return m_astBuilder; }
 
@@ -1009,6 +1043,7 @@ namespace Slang
         List<RefPtr<EntryPoint>> const& getEntryPoints() { return m_entryPoints; }
         void _addEntryPoint(EntryPoint* entryPoint);
         void _processFindDeclsExportSymbolsRec(Decl* decl);
+        void _ensureExportSymbols();
 
     protected:
         void acceptVisitor(ComponentTypeVisitor* visitor, SpecializationInfo* specializationInfo) SLANG_OVERRIDE;
@@ -1060,10 +1095,16 @@ namespace Slang
         // this module. 
         RefPtr<ASTBuilder> m_astBuilder;
 
+        // Records the release of this module with the linkage (as its types may be released with it)
+        RefPtr<ReleasedModuleCounter> m_releasedModuleCounter;
+
         // Holds map of exported mangled names to symbols. m_mangledExportPool maps names to indices,
         // and m_mangledExportSymbols holds the NodeBase* values for each index. 
         StringSlicePool m_mangledExportPool;
         List<NodeBase*> m_mangledExportSymbols;
+
+        // Set if the module's decls are created on demand
+        RefPtr<ASTDeclLoader> m_astDeclLoader;
     };
     typedef Module LoadedModule;
 
@@ -1119,6 +1160,16 @@ namespace Slang
         Precise = SLANG_FLOATING_POINT_MODE_PRECISE,
     };
 
+        /// The SIMD instructions C++ generated for CPU compute kernels is written for, such that
+        /// the invocations of a thread group are run in SIMD lanes.
+    enum class CPUSIMDMode
+    {
+        None,           ///< Invocations are run one at a time
+        SSE,            ///< 4 x 32 bit lanes
+        AVX2,           ///< 8 x 32 bit lanes
+        AVX512,         ///< 16 x 32 bit lanes
+    };
+
     enum class WriterChannel : SlangWriterChannel
     {
         Diagnostic = SLANG_WRITER_CHANNEL_DIAGNOSTIC,
@@ -1150,6 +1201,7 @@ namespace Slang
         Linkage* getLinkage() { return linkage; }
         CodeGenTarget getTarget() { return target; }
         Profile getTargetProfile() { return targetProfile; }
+        SlangTargetFlags getTargetFlags() { return targetFlags; }
         FloatingPointMode getFloatingPointMode() { return floatingPointMode; }
 
         Session* getSession();
@@ -1161,6 +1213,12 @@ namespace Slang
         Dictionary<Type*, RefPtr<TypeLayout>>& getTypeLayouts() { return typeLayouts; }
 
         TypeLayout* getTypeLayout(Type* type);
+
+            /// Get the cache of the layouts of types computed for this target
+        TypeLayoutCache* getTypeLayoutCache();
+
+    protected:
+        RefPtr<TypeLayoutCache> m_typeLayoutCache;
     };
 
         /// Are we generating code for a D3D API?
@@ -1287,6 +1345,11 @@ namespace Slang
        
         RefPtr<ASTBuilder> m_astBuilder;
 
+            /// Get the count of the modules of this linkage that have been released
+        ReleasedModuleCounter* getReleasedModuleCounter() { return m_releasedModuleCounter; }
+
+        RefPtr<ReleasedModuleCounter> m_releasedModuleCounter = new ReleasedModuleCounter;
+
             // cache used by type checking, implemented in check.cpp
         TypeCheckingCache* getTypeCheckingCache();
         void destroyTypeCheckingCache();
@@ -1311,6 +1374,16 @@ namespace Slang
         // Counters for allocating sequential IDs to witness tables conforming to each interface type.
         Dictionary<String, uint32_t> mapInterfaceMangledNameToSequentialIDCounters;
 
+            /// Get the sequential ID of a witness table, allocating the next ID for the interface
+            /// it conforms to if it doesn't have one yet. Can be called from multiple threads
+            /// (as happens when generating code in parallel).
+        uint32_t getOrAllocateWitnessTableSequentialID(
+            const UnownedStringSlice& witnessTableMangledName,
+            const UnownedStringSlice& interfaceMangledName);
+
+        // Guards the sequential ID maps
+        std::mutex m_sequentialIDMutex;
+
         // The resulting specialized IR module for each entry point request
         List<RefPtr<IRModule>> compiledModules;
 
@@ -1365,6 +1438,20 @@ namespace Slang
             Name*                           name,
             PathInfo const&                 pathInfo);
 
+            /// Load a module from a serialized module container (such as a `.slang-module` file).
+            ///
+            /// If the source of the module was found, `sourceBlob` holds its contents, and the container
+            /// is only used if the module was produced from that source. If the container can't be used,
+            /// returns a failure with the reason in `outProblem`.
+        SlangResult loadSerializedModule(
+            Name*               name,
+            const PathInfo&     filePathInfo,
+            ISlangBlob*         fileContentsBlob,
+            ISlangBlob*         sourceBlob,
+            DiagnosticSink*     sink,
+            String&             outProblem,
+            RefPtr<Module>&     outModule);
+
             /// Load a module of the given name.
         Module* loadModule(String const& name);
 
@@ -1461,6 +1548,54 @@ namespace Slang
 
         List<Type*> m_specializedTypes;
 
+    public:
+            /// Identifies a specialization of a component type.
+            ///
+            /// Specialization arguments that are types are held in canonical form, so that
+            /// different ways of naming the same type give the same key.
+        struct SpecializationKey
+        {
+            SpecializationKey() {}
+            SpecializationKey(ComponentType* base, SpecializationArg const* args, Index argCount);
+
+            HashCode getHashCode() const;
+            bool operator==(const SpecializationKey& rhs) const;
+
+            ComponentType* base = nullptr;
+            List<SpecializationArg> args;
+        };
+
+            /// The default maximum number of specializations held by m_specializationCache
+        static const Index kDefaultSpecializationCacheSize = 1024;
+
+            /// Find a specialization made before via this linkage. Returns nullptr if there isn't one.
+        ComponentType* findSpecialization(const SpecializationKey& key);
+            /// Hold the specialization so that it's found for the same key. Evicts the least recently used
+            /// specializations if more than the maximum are held.
+        void addSpecialization(const SpecializationKey& key, ComponentType* specialized);
+
+            /// Set the maximum number of specializations held. 0 releases all of them, and disables the cache.
+        void setSpecializationCacheSize(Index maxEntryCount);
+        Index getSpecializationCacheSize() const { return m_maxSpecializationCacheEntryCount; }
+
+    protected:
+        struct SpecializationEntry
+        {
+            RefPtr<ComponentType> componentType;
+            uint64_t lastUsed = 0;              ///< Value of m_specializationUseCount when the entry was last used
+        };
+
+        void _evictSpecializationsIfNeeded();
+
+            /// Specializations of component types made via this linkage, so that specializing the
+            /// same component type with the same arguments returns the same specialized component
+            /// type (along with its layouts and compiled code).
+            ///
+            /// Holds references to the specialized component types (and so their bases) until they
+            /// are evicted, at most m_maxSpecializationCacheEntryCount of them.
+        Dictionary<SpecializationKey, SpecializationEntry> m_specializationCache;
+        Index m_maxSpecializationCacheEntryCount = kDefaultSpecializationCacheSize;
+        uint64_t m_specializationUseCount = 0;
     };
 
         /// Shared functionality between front- and back-end compile requests.
@@ -1485,6 +1620,7 @@ namespace Slang
         Session* getSession();
         Linkage* getLinkage() { return m_linkage; }
         DiagnosticSink* getSink() { return m_sink; }
+        void setSink(DiagnosticSink* sink) { m_sink = sink; }
         SourceManager* getSourceManager() { return getLinkage()->getSourceManager(); }
         NamePool* getNamePool() { return getLinkage()->getNamePool(); }
         ISlangFileSystemExt* getFileSystemExt() { return getLinkage()->getFileSystemExt(); }
@@ -1498,6 +1634,9 @@ namespace Slang
             /// If true will after lexical analysis output the hierarchy of includes to stdout
         bool outputIncludes = false;
 
+            /// If set, the time taken by each phase and IR pass is recorded in the report
+        RefPtr<PerfReport> perfReport;
+
     protected:
         CompileRequestBase(
             Linkage*        linkage,
@@ -1736,6 +1875,25 @@ namespace Slang
             BackEndCompileRequest*  backEndRequest,
             EndToEndCompileRequest* endToEndRequest);
 
+            /// Internal helper for generating code on multiple threads.
+            ///
+            /// Creates the state that is otherwise created on demand by
+            /// `_createEntryPointResult` and `_createWholeProgramResult`, such
+            /// that they can then be called concurrently (for different entry points).
+            ///
+        void _prepareForParallelCodeGen(DiagnosticSink* sink);
+
+            /// Internal helper for `generateOutputForTarget`.
+            ///
+            /// Creates the results for all entry points of a target that is
+            /// compiled by a downstream compiler. The downstream compiles run
+            /// asynchronously, overlapping with each other and with generating
+            /// the source for the entry points that follow.
+            ///
+        void _createEntryPointResultsWithAsyncDownstream(
+            BackEndCompileRequest*  backEndRequest,
+            EndToEndCompileRequest* endToEndRequest);
+
         RefPtr<IRModule> getOrCreateIRModuleForLayout(DiagnosticSink* sink);
 
         RefPtr<IRModule> getExistingIRModuleForLayout()
@@ -1793,6 +1951,12 @@ namespace Slang
             /// Should SPIR-V be generated directly from Slang IR rather than via translation to GLSL?
         bool shouldEmitSPIRVDirectly = false;
 
+            /// When SPIR-V is generated directly, should it be validated, and compared with the SPIR-V generated via GLSL?
+        bool shouldValidateSPIRVEmittedDirectly = false;
+
+            /// The SIMD instructions compute kernels compiled for the CPU are vectorized for
+        CPUSIMDMode cpuSIMDMode = CPUSIMDMode::None;
+
 
         // If true will disable generics/existential value specialization pass.
         bool disableSpecialization = false;
@@ -1800,6 +1964,16 @@ namespace Slang
         // If true will disable generating dynamic dispatch code.
         bool disableDynamicDispatch = false;
 
+            /// The maximum number of threads used to generate code for entry points and targets.
+            /// 1 (the default) generates everything on the calling thread, 0 uses a thread per hardware thread.
+            /// The results (and diagnostics) are the same as when generated on a single thread.
+        Index parallelJobCount = 1;
+
+            /// Set when the request is for one of the jobs generating code in parallel. Witness table
+            /// sequential IDs are allocated by the jobs in turn, in the order of the jobs.
+        ParallelForTurns* witnessTableIDTurns = nullptr;
+        Index parallelCodeGenJobIndex = -1;
+
         String m_dumpIntermediatePrefix;
 
     private:
@@ -1878,6 +2052,13 @@ namespace Slang
         };
         Dictionary<TargetRequest*, RefPtr<TargetInfo>> targetInfos;
 
+            /// If set, results are looked up in (and added to) the cache
+        RefPtr<CompileCache> m_compileCache;
+
+            /// The command-line arguments the request was set up with (excluding the compile cache options).
+            /// Part of the compile cache key.
+        List<String> m_commandLineArgs;
+
             /// Writes the modules in a container to the stream
         SlangResult writeContainerToStream(Stream* stream);
         
@@ -1902,6 +2083,22 @@ namespace Slang
         SlangResult executeActionsInner();
         SlangResult executeActions();
 
+            /// True if the results were retrieved from the compile cache, in which case there is no AST or layout
+            /// until ensureProgramForCompileCacheHit is called
+        bool isCompileCacheHit() const { return m_isCompileCacheHit; }
+            /// If the results were retrieved from the compile cache, the program is made of stand ins.
+            /// Runs the front end (parsing, checking, specialization and layout) so the program is complete,
+            /// keeping the results from the cache. Does nothing if the results weren't from the cache.
+        SlangResult ensureProgramForCompileCacheHit();
+
+            /// Enable or disable recording the time taken by each phase and IR pass of the compilation
+        void setReportPerf(bool enable);
+            /// Get the report of the time taken by each phase and pass, or nullptr if not enabled
+        PerfReport* getPerfReport() { return getFrontEndReq()->perfReport; }
+
+            /// Get the paths of all of the files that were read in compiling
+        List<String> const& getFilePathDependencies();
+
         Session* getSession() { return m_session; }
         DiagnosticSink* getSink() { return &m_sink; }
         NamePool* getNamePool() { return getLinkage()->getNamePool(); }
@@ -1926,6 +2123,20 @@ namespace Slang
     private:
         void init();
 
+            /// If no target is specified, infers one from the source language
+        void _addDefaultTargetIfNeeded();
+
+            /// Specialize the program the front end produced, and lay it out for each target
+        SlangResult _specializeProgram();
+
+        SlangResult _executeActionsWithCompileCache();
+            /// Set up the request as if it had been compiled, with the results held in entry
+        SlangResult _applyCompileCacheEntry(const CompileCache::Entry& entry);
+
+        bool                            m_isCompileCacheHit = false;
+        bool                            m_hasProgramForCompileCacheHit = false;     ///< Set once ensureProgramForCompileCacheHit has run
+        List<String>                    m_compileCacheDependencyPaths;
+
         Session*                        m_session = nullptr;
         RefPtr<Linkage>                 m_linkage;
         DiagnosticSink                  m_sink;
@@ -1945,6 +2156,10 @@ namespace Slang
     void generateOutput(
         EndToEndCompileRequest* compileRequest);
 
+        /// Write the results of a command-line compile to the output files (or standard output) it specifies
+    void writeCommandLineOutput(
+        EndToEndCompileRequest* compileRequest);
+
     // Helper to dump intermediate output when debugging
     void maybeDumpIntermediate(
         BackEndCompileRequest* compileRequest,
@@ -1973,6 +2188,24 @@ namespace Slang
     @param sink The diagnostic sink to report to */
     void reportExternalCompileError(const char* compilerName, SlangResult res, const UnownedStringSlice& diagnostic, DiagnosticSink* sink);
 
+    /* Finds and adds the result of a compile that invokes a downstream compiler's library directly (as for fxc, dxc
+    and glslang) in the session's DownstreamCompileResultCache. The key is the identity of the compiler, followed by the
+    arguments and source of the compile, which the caller appends to `sha1` after `init` and before `find`. */
+    struct DownstreamLibraryCompileCache
+    {
+            /// Returns true if the result of the compile can be held in the cache. A pass-through compile isn't held,
+            /// as its source can #include files whose contents aren't in the key.
+        bool init(Session* session, PassThroughMode passThrough, EndToEndCompileRequest* endToEndReq);
+            /// Returns true if code compiled for the key is held, setting outCode to it
+        bool find(List<uint8_t>& outCode);
+            /// Hold the code from a successful compile for the key
+        void add(const void* code, size_t size);
+
+        SHA1 sha1;
+        RefPtr<DownstreamCompileResultCache> cache;
+        DownstreamCompileResultCache::Key key;
+    };
+
     /* Determines a suitable filename to identify the input for a given entry point being compiled.
     If the end-to-end compile is a pass-through case, will attempt to find the (unique) source file
     pathname for the translation unit containing the entry point at `entryPointIndex.
@@ -2081,6 +2314,10 @@ namespace Slang
         SLANG_NO_THROW void SLANG_MCALL setLanguagePrelude(SlangSourceLanguage inSourceLanguage, char const* prelude) override;
         SLANG_NO_THROW void SLANG_MCALL getLanguagePrelude(SlangSourceLanguage inSourceLanguage, ISlangBlob** outPrelude) override;
 
+        SLANG_NO_THROW SlangResult SLANG_MCALL compileStdLib() override;
+        SLANG_NO_THROW SlangResult SLANG_MCALL loadStdLib(const void* stdLib, size_t stdLibSizeInBytes) override;
+        SLANG_NO_THROW SlangResult SLANG_MCALL saveStdLib(ISlangBlob** outBlob) override;
+
             /// Get the default compiler for a language
         DownstreamCompiler* getDefaultDownstreamCompiler(SourceLanguage sourceLanguage);
 
@@ -2148,6 +2385,16 @@ namespace Slang
         DownstreamCompiler* getOrLoadDownstreamCompiler(PassThroughMode type, DiagnosticSink* sink);
             /// Will unload the specified shared library if it's currently loaded 
         void resetDownstreamCompiler(PassThroughMode type);
+            /// Get the pool that downstream compiles are run on asynchronously. Created on first use.
+        DownstreamCompileJobPool* getDownstreamCompileJobPool();
+            /// Get the cache of downstream compile results, or nullptr if it isn't enabled
+        RefPtr<DownstreamCompileResultCache> getDownstreamCompileResultCache();
+            /// Set the maximum size of the cache of downstream compile results. 0 disables the cache.
+        void setDownstreamCompileResultCacheSize(uint64_t maxSizeInBytes);
+
+            /// Get the compile cache that uses the directory, creating the directory if needed. Requests that
+            /// use the same directory share a cache, such that its stats cover all of them.
+        SlangResult getOrCreateCompileCache(const String& directory, RefPtr<CompileCache>& outCache);
 
         SlangFuncPtr getSharedLibraryFunc(SharedLibraryFuncType type, DiagnosticSink* sink);
 
@@ -2171,13 +2418,29 @@ namespace Slang
 
         int m_downstreamCompilerInitialized = 0;                                        
 
+        std::recursive_mutex m_downstreamCompilerMutex;                                         ///< Guards loading of downstream compilers and shared library functions, which can happen from any Linkage
         RefPtr<DownstreamCompilerSet> m_downstreamCompilerSet;                                  ///< Information about all available downstream compilers.
         RefPtr<DownstreamCompiler> m_downstreamCompilers[int(PassThroughMode::CountOf)];        ///< A downstream compiler for a pass through
         DownstreamCompilerLocatorFunc m_downstreamCompilerLocators[int(PassThroughMode::CountOf)];
+        RefPtr<DownstreamCompileJobPool> m_downstreamCompileJobPool;                            ///< Bounds the amount of downstream compiles running at the same time. Guarded by m_downstreamCompilerMutex.
+        RefPtr<DownstreamCompileResultCache> m_downstreamCompileResultCache;                    ///< Results of downstream compiles, if enabled. Guarded by m_downstreamCompilerMutex.
+
+            /// Get a hash that identifies the stdlib source for this build. Used to validate a serialized stdlib or module.
+        HashCode64 getStdLibSourceHash();
+
+        std::mutex m_compileCacheMutex;                                                         ///< Guards m_compileCaches
+        Dictionary<String, RefPtr<CompileCache>> m_compileCaches;                               ///< Compile caches keyed by canonical directory path
 
     private:
 
-        SlangResult _readBuiltinModule(Scope* scope, String moduleName);
+            /// Read a serialized stdlib module from the container, and add it to the builtin linkage
+        SlangResult _readBuiltinModule(RiffContainer::ListChunk* containerChunk);
+            /// Add a stdlib module to the builtin linkage, making its contents available in scope 
+        void _addBuiltinModule(Scope* scope, Name* moduleName, Module* module);
+            /// Get the scope a builtin module with the given name should be added to
+        Scope* _getBuiltinModuleScope(Name* moduleName);
+            /// Build the member dictionary of containerDecl and all containers it holds
+        static void _buildMemberDictionaries(ContainerDecl* containerDecl);
 
         SlangResult _loadRequest(EndToEndCompileRequest* request, const void* data, size_t size);
 
@@ -2214,6 +2477,11 @@ SLANG_FORCE_INLINE slang::ISession* asExternal(Linkage* linkage)
     return static_cast<slang::ISession*>(linkage);
 }
 
+SLANG_FORCE_INLINE Linkage* asInternal(slang::ISession* session)
+{
+    return static_cast<Linkage*>(session);
+}
+
 SLANG_FORCE_INLINE Module* asInternal(slang::IModule* module)
 {
     return static_cast<Module*>(module);
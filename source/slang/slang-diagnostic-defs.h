@@ -76,6 +76,9 @@ DIAGNOSTIC(    19, Error, unknownSourceLanguage, "unknown source language '$0'")
 
 DIAGNOSTIC(    20, Error, entryPointsNeedToBeAssociatedWithTranslationUnits, "when using multiple source files, entry points must be specified after their corresponding source file(s)")
 DIAGNOSTIC(    21, Error, expectedArgumentForOption, "expected an argument for command-line option '$0'")
+DIAGNOSTIC(    22, Error, invalidParallelJobCount, "invalid parallel job count '$0', expected a non-negative integer")
+DIAGNOSTIC(    23, Error, invalidCompileCacheMaxSize, "invalid compile cache maximum size '$0', expected a non-negative integer number of megabytes")
+DIAGNOSTIC(    24, Error, cannotUseCompileCacheDirectory, "cannot use '$0' as a compile cache directory")
 
 DIAGNOSTIC(    24, Error, unknownLineDirectiveMode, "unknown '#line' directive mode '$0'")
 DIAGNOSTIC(    25, Error, unknownFloatingPointMode, "unknown floating-point mode '$0'")
@@ -83,6 +86,7 @@ DIAGNOSTIC(    26, Error, unknownOptimiziationLevel, "unknown optimization level
 DIAGNOSTIC(    27, Error, unknownDebugInfoLevel, "unknown debug info level '$0'")
 
 DIAGNOSTIC(    28, Error, unableToGenerateCodeForTarget, "unable to generate code for target '$0'")
+DIAGNOSTIC(    29, Error, unknownCPUSIMDMode, "unknown CPU SIMD mode '$0', expected 'none', 'sse', 'avx2' or 'avx512'")
 
 DIAGNOSTIC(    30, Warning, sameStageSpecifiedMoreThanOnce, "the stage '$0' was specified more than once for entry point '$1'")
 DIAGNOSTIC(    31, Error, conflictingStagesForEntryPoint, "conflicting stages have been specified for entry point '$0'")
@@ -442,6 +446,8 @@ DIAGNOSTIC(38027, Error, mismatchExistentialSlotArgCount, "expected $0 existenti
 DIAGNOSTIC(38029, Error,typeArgumentDoesNotConformToInterface, "type argument '$0' does not conform to the required interface '$1'")
 
 DIAGNOSTIC(38200, Error, recursiveModuleImport, "module `$0` recursively imports itself")
+DIAGNOSTIC(38201, Error, unableToImportSerializedModule, "unable to import serialized module '$0': $1")
+DIAGNOSTIC(38202, Warning, serializedModuleIgnored, "serialized module '$0' is not used, because $1; '$2' is compiled instead")
 DIAGNOSTIC(39999, Fatal, errorInImportedModule, "error in imported module, compilation ceased.")
 
 // 39xxx - Type layout and parameter binding.
@@ -559,6 +565,10 @@ DIAGNOSTIC(52003, Error, cppCompilerNotFound, "Could not find a suitable C/C++ c
 DIAGNOSTIC(52004, Error, unableToWriteFile, "Unable to write file '$0'")
 DIAGNOSTIC(52005, Error, unableToReadFile, "Unable to read file '$0'")
 
+DIAGNOSTIC(52006, Warning, spirvDirectEmitUnsupported, "direct SPIR-V emit doesn't support $0, so SPIR-V will be generated via GLSL")
+DIAGNOSTIC(52007, Warning, spirvDirectEmitInvalid, "SPIR-V emitted directly for entry point '$0' is invalid, so SPIR-V generated via GLSL is used: $1")
+DIAGNOSTIC(52008, Warning, spirvDirectEmitInterfaceMismatch, "interface of SPIR-V emitted directly for entry point '$0' differs from SPIR-V generated via GLSL: $1")
+
 //
 // 8xxxx - Issues specific to a particular library/technology/platform/etc.
 //
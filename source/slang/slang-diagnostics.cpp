@@ -307,6 +307,28 @@ void DiagnosticSink::diagnoseRaw(
     }
 }
 
+void DiagnosticSink::appendDiagnostics(DiagnosticSink* other)
+{
+    SLANG_ASSERT(other && other != this && other->writer == nullptr);
+
+    m_errorCount += other->m_errorCount;
+
+    const UnownedStringSlice text = other->outputBuffer.getUnownedSlice();
+    if (text.getLength() == 0)
+    {
+        return;
+    }
+
+    if (writer)
+    {
+        writer->write(text.begin(), text.getLength());
+    }
+    else
+    {
+        outputBuffer.append(text);
+    }
+}
+
 namespace Diagnostics
 {
 #define DIAGNOSTIC(id, severity, name, messageFormat) const DiagnosticInfo name = { id, Severity::severity, #name, messageFormat };
@@ -195,6 +195,11 @@ namespace Slang
             /// *note* only works if writer is not set, the blob is created from outputBuffer
         SlangResult getBlobIfNeeded(ISlangBlob** outBlob);
 
+            /// Output the diagnostics collected in the outputBuffer of `other` as if they were diagnosed on
+            /// this sink, and add its error count. Allows diagnostics that were collected separately
+            /// (for example on different threads) to be output in a fixed order.
+        void appendDiagnostics(DiagnosticSink* other);
+
             /// Get the source manager used 
         SourceManager* getSourceManager() const { return m_sourceManager; }
             /// Set the source manager used for lookup of source locs
@@ -271,6 +271,25 @@ namespace Slang
 
         DxcIncludeHandler includeHandler(&linkage->searchDirectories, linkage->getFileSystemExt(), compileRequest->getSourceManager());
 
+        DownstreamLibraryCompileCache cache;
+        if (cache.init(session, PassThroughMode::Dxc, endToEndReq))
+        {
+            cache.sha1.appendSized(hlslCode.getUnownedSlice());
+            cache.sha1.appendSized(sourcePath.getUnownedSlice());
+            cache.sha1.appendSized(entryPointName.getUnownedSlice());
+            cache.sha1.appendSized(profileName.getUnownedSlice());
+            cache.sha1.appendValue(uint32_t(profile.getStage() == Stage::Unknown));
+            cache.sha1.appendValue(uint32_t(argCount));
+            for (UINT32 i = 0; i < argCount; ++i)
+            {
+                cache.sha1.appendSized(String::fromWString(args[i]).getUnownedSlice());
+            }
+            if (cache.find(outCode))
+            {
+                return SLANG_OK;
+            }
+        }
+
         ComPtr<IDxcOperationResult> dxcResult;
         SLANG_RETURN_ON_FAIL(dxcCompiler->Compile(dxcSourceBlob,
             sourcePath.toWString().begin(),
@@ -317,6 +336,7 @@ namespace Slang
         outCode.addRange(
             (uint8_t const*)dxcResultBlob->GetBufferPointer(),
             (int)           dxcResultBlob->GetBufferSize());
+        cache.add(dxcResultBlob->GetBufferPointer(), dxcResultBlob->GetBufferSize());
 
         return SLANG_OK;
     }
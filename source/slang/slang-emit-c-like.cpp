@@ -1096,6 +1096,10 @@ bool CLikeSourceEmitter::shouldFoldInstIntoUseSites(IRInst* inst)
     if(inst->mightHaveSideEffects())
         return false;
 
+    // Let the target keep anything else it needs as a temporary
+    if(!canFoldInstIntoUseSitesImpl(inst))
+        return false;
+
     // Don't fold instructions that are marked `[precise]`.
     // This could in principle be extended to any other
     // decorations that affect the semantics of an instruction
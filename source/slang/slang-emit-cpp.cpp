@@ -27,10 +27,10 @@ Broadly we could categorize these as..
 4) Thread shared (such as group shared) or ('thread shared')
 5) Thread local ('static')
 
-If we can invoke a bunch of threads as a single invocation we could effectively have the ThreadShared not part of the ABI, but something
-that is say allocated on the stack before the threads are kicked off. If we kick of threads individually then we would need to pass this
-in as part of ABI. NOTE that it isn't right in so far as memory barriers etc couldn't work, as each thread would run to completion, but
-we aren't going to worry about barriers for now. 
+Thread shared variables are not part of the ABI. All the threads of a group are run on the same OS thread, so they are output as
+thread_local globals. If a group sync barrier is reachable from the entry point, the group runs each of its threads as a fiber
+(see ComputeGroupFibers in slang-cpp-compute-group.h) and a barrier switches to the next thread of the group. Otherwise each thread runs
+to completion one after another.
 
 On 1 - there could be potentially input and outputs (perhaps in out?). On CPU I guess that's fine. 
 
@@ -1867,6 +1867,13 @@ void CPPSourceEmitter::emitSimpleFuncImpl(IRFunc* func)
         // Because the workhorse function doesn't have the right signature to service
         // general-purpose calls, it is being emitted with a `_` prefix.
         //
+        // When the invocations of a group are run in SIMD lanes, the workhorse has to be inlined
+        // into the group loop for the loop to be vectorized.
+        if (_isSIMDGroupEnabled() && entryPointDecor->getProfile().getStage() == Stage::Compute)
+        {
+            m_writer->emit("SLANG_FORCE_INLINE ");
+        }
+
         StringBuilder prefixName;
         prefixName << "_" << name;
         emitType(resultType, prefixName);
@@ -2119,6 +2126,116 @@ void CPPSourceEmitter::emitLoopControlDecorationImpl(IRLoopControlDecoration* de
     }
 }
 
+bool CPPSourceEmitter::canFoldInstIntoUseSitesImpl(IRInst* inst)
+{
+    // In the lane wide function anything that must only be evaluated for active lanes (such as a load)
+    // gets its own statement, so it doesn't stop the expressions it's used in running for all lanes.
+    return !m_isEmittingLaneFunc || _isLaneSafeExpr(inst);
+}
+
+void CPPSourceEmitter::emitRateQualifiersImpl(IRRate* rate)
+{
+    // All of the invocations of a group run on the same thread (see ComputeGroupFibers), and
+    // different threads run different groups, so each thread has its own group shared memory.
+    if (as<IRGroupSharedRate>(rate))
+    {
+        m_writer->emit("thread_local ");
+    }
+}
+
+void CPPSourceEmitter::emitPreludeDirectivesImpl()
+{
+    if (m_requiresComputeGroup)
+    {
+        // Barriers are defined by the compute group runtime in the prelude
+        m_writer->emit("#define SLANG_PRELUDE_ENABLE_COMPUTE_GROUP 1\n");
+    }
+}
+
+CPPSourceEmitter::BarrierKind CPPSourceEmitter::_getBarrierKind(IRInst* callee)
+{
+    auto targetIntrinsic = findTargetIntrinsicDecoration(callee);
+    if (!targetIntrinsic)
+    {
+        return BarrierKind::None;
+    }
+
+    const UnownedStringSlice name = targetIntrinsic->getDefinition();
+    if (name == "GroupMemoryBarrierWithGroupSync" ||
+        name == "AllMemoryBarrierWithGroupSync" ||
+        name == "DeviceMemoryBarrierWithGroupSync")
+    {
+        return BarrierKind::GroupSync;
+    }
+    if (name == "GroupMemoryBarrier" ||
+        name == "AllMemoryBarrier" ||
+        name == "DeviceMemoryBarrier")
+    {
+        return BarrierKind::Memory;
+    }
+    return BarrierKind::None;
+}
+
+bool CPPSourceEmitter::_isGroupSyncReachable(IRFunc* func, HashSet<IRFunc*>& ioVisited)
+{
+    if (!ioVisited.Add(func))
+    {
+        return false;
+    }
+
+    for (auto block : func->getBlocks())
+    {
+        for (auto inst : block->getChildren())
+        {
+            if (inst->op == kIROp_GroupMemoryBarrierWithGroupSync)
+            {
+                return true;
+            }
+            if (auto call = as<IRCall>(inst))
+            {
+                IRInst* callee = call->getCallee();
+                if (_getBarrierKind(callee) == BarrierKind::GroupSync)
+                {
+                    return true;
+                }
+                auto calleeFunc = as<IRFunc>(callee);
+                if (calleeFunc && _isGroupSyncReachable(calleeFunc, ioVisited))
+                {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+bool CPPSourceEmitter::_isBarrierUsed(IRModule* module)
+{
+    for (auto inst : module->getGlobalInsts())
+    {
+        auto func = as<IRFunc>(inst);
+        if (!func)
+        {
+            continue;
+        }
+        if (func->hasUses() && _getBarrierKind(func) != BarrierKind::None)
+        {
+            return true;
+        }
+        for (auto block : func->getBlocks())
+        {
+            for (auto child : block->getChildren())
+            {
+                if (child->op == kIROp_GroupMemoryBarrierWithGroupSync)
+                {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
 bool CPPSourceEmitter::_tryEmitInstExprAsIntrinsic(IRInst* inst, const EmitOpInfo& inOuterPrec)
 {
     HLSLIntrinsic* specOp = m_intrinsicSet.add(inst);
@@ -2433,31 +2550,61 @@ static void _calcAxisOrder(const Int sizeAlongAxis[CLikeSourceEmitter::kThreadGr
     // axes.sort();
 }
 
+bool CPPSourceEmitter::_isSIMDGroupEnabled()
+{
+    return m_target == CodeGenTarget::CPPSource && m_compileRequest->cpuSIMDMode != CPUSIMDMode::None;
+}
+
 void CPPSourceEmitter::_emitEntryPointGroup(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName)
 {
     List<AxisWithSize> axes;
     _calcAxisOrder(sizeAlongAxis, false, axes);
 
+    // With SIMD enabled, but a kernel that can't be emitted lane wide (see _emitLaneFunc), the inner
+    // most loop is marked such that the C++ compiler can run its iterations (the invocations along
+    // that axis) in SIMD lanes if it is able to vectorize the kernel itself.
+    //
+    // Each iteration works on its own copy of the thread input, so there is no dependency
+    // between iterations that could stop vectorization.
+    const bool isSIMD = _isSIMDGroupEnabled();
+    const char* threadInputName = isSIMD ? "laneInput" : "threadInput";
+
     // Open all the loops
     StringBuilder builder;
     for (Index i = 0; i < axes.getCount(); ++i)
     {
         const auto& axis = axes[i];
+        const bool isInnerMost = (i == axes.getCount() - 1);
+
         builder.Clear();
         const char elem[2] = { s_elemNames[axis.axis], 0 };
+        if (isSIMD && isInnerMost)
+        {
+            builder << "SLANG_SIMD_LOOP\n";
+        }
         builder << "for (uint32_t " << elem << " = 0; " << elem << " < " << axis.size << "; ++" << elem << ")\n{\n";
         m_writer->emit(builder);
         m_writer->indent();
 
         builder.Clear();
-        builder << "threadInput.groupThreadID." << elem << " = " << elem << ";\n";
+        if (isSIMD && isInnerMost)
+        {
+            builder << "ComputeThreadVaryingInput laneInput = threadInput;\n";
+            builder << "laneInput.groupThreadID." << elem << " = " << elem << ";\n";
+        }
+        else
+        {
+            builder << "threadInput.groupThreadID." << elem << " = " << elem << ";\n";
+        }
         m_writer->emit(builder);
     }
 
     // just call at inner loop point
     m_writer->emit("_");
     m_writer->emit(funcName);
-    m_writer->emit("(&threadInput, entryPointParams, globalParams);\n");
+    m_writer->emit("(&");
+    m_writer->emit(threadInputName);
+    m_writer->emit(", entryPointParams, globalParams);\n");
 
     // Close all the loops
     for (Index i = Index(axes.getCount() - 1); i >= 0; --i)
@@ -2467,6 +2614,498 @@ void CPPSourceEmitter::_emitEntryPointGroup(const Int sizeAlongAxis[kThreadGroup
     }
 }
 
+void CPPSourceEmitter::_emitEntryPointGroupFibers(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName)
+{
+    // Each invocation runs on its own fiber, with a barrier switching to the next invocation
+    // of the group. The invocations are run through the _Thread export, as it has the
+    // ComputeThreadFunc signature.
+    StringBuilder builder;
+    builder << "const uint32_t groupSize[3] = { " << sizeAlongAxis[0] << ", " << sizeAlongAxis[1] << ", " << sizeAlongAxis[2] << " };\n";
+    builder << "ComputeGroupFibers::run(&" << funcName << "_Thread, &threadInput, groupSize, entryPointParams, globalParams);\n";
+    m_writer->emit(builder);
+}
+
+Index CPPSourceEmitter::_getSIMDLaneCount()
+{
+    switch (m_compileRequest->cpuSIMDMode)
+    {
+        case CPUSIMDMode::SSE:      return 4;
+        case CPUSIMDMode::AVX2:     return 8;
+        case CPUSIMDMode::AVX512:   return 16;
+        default:                    return 1;
+    }
+}
+
+static bool _calcBlockPostOrder(IRBlock* block, HashSet<IRBlock*>& ioVisited, HashSet<IRBlock*>& ioOnPath, List<IRBlock*>& outBlocks)
+{
+    ioVisited.Add(block);
+    ioOnPath.Add(block);
+    for (auto succ : block->getSuccessors())
+    {
+        // A successor on the current path is a back edge, so the control flow has a loop
+        if (ioOnPath.Contains(succ))
+        {
+            return false;
+        }
+        if (!ioVisited.Contains(succ) && !_calcBlockPostOrder(succ, ioVisited, ioOnPath, outBlocks))
+        {
+            return false;
+        }
+    }
+    ioOnPath.Remove(block);
+    outBlocks.add(block);
+    return true;
+}
+
+bool CPPSourceEmitter::_calcLaneFuncBlocks(IRFunc* func, List<IRBlock*>& outBlocks)
+{
+    // The lanes are fed what the _Thread function passes: the varying input, the entry point params and the global params
+    Index paramCount = 0;
+    for (auto param = func->getFirstParam(); param; param = param->getNextParam())
+    {
+        if (!as<IRRawPointerType>(param->getDataType()))
+        {
+            return false;
+        }
+        paramCount++;
+    }
+    if (paramCount != 3)
+    {
+        return false;
+    }
+
+    // All lanes step through every block, with a mask of the lanes active in the block. That requires
+    // the blocks can be ordered such that a block comes after all of its predecessors - ie there are no loops.
+    HashSet<IRBlock*> visited;
+    HashSet<IRBlock*> onPath;
+    outBlocks.clear();
+    if (!_calcBlockPostOrder(func->getFirstBlock(), visited, onPath, outBlocks))
+    {
+        return false;
+    }
+    outBlocks.reverse();
+
+    for (auto block : outBlocks)
+    {
+        for (auto inst : block->getOrdinaryInsts())
+        {
+            switch (inst->op)
+            {
+                case kIROp_ReturnVoid:
+                case kIROp_unconditionalBranch:
+                case kIROp_loop:
+                case kIROp_conditionalBranch:
+                case kIROp_ifElse:
+                {
+                    break;
+                }
+                case kIROp_swizzleSet:
+                {
+                    // Emitted as a declaration followed by an assignment, so can't be emitted per lane
+                    return false;
+                }
+                default:
+                {
+                    // Other terminators (such as switch) aren't handled
+                    if (as<IRTerminatorInst>(inst))
+                    {
+                        return false;
+                    }
+                    break;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+static bool _isFloatingPointType(IRType* type)
+{
+    if (auto vectorType = as<IRVectorType>(type))
+    {
+        type = vectorType->getElementType();
+    }
+    else if (auto matrixType = as<IRMatrixType>(type))
+    {
+        type = matrixType->getElementType();
+    }
+
+    if (auto basicType = as<IRBasicType>(type))
+    {
+        switch (basicType->getBaseType())
+        {
+            case BaseType::Half:
+            case BaseType::Float:
+            case BaseType::Double:
+            {
+                return true;
+            }
+            default: break;
+        }
+    }
+    return false;
+}
+
+bool CPPSourceEmitter::_isLaneSafeExpr(IRInst* inst)
+{
+    switch (inst->op)
+    {
+        case kIROp_IntLit:
+        case kIROp_FloatLit:
+        case kIROp_BoolLit:
+        {
+            return true;
+        }
+        case kIROp_Add:
+        case kIROp_Sub:
+        case kIROp_Mul:
+        case kIROp_Neg:
+        case kIROp_Lsh:
+        case kIROp_Rsh:
+        case kIROp_Eql:
+        case kIROp_Neq:
+        case kIROp_Greater:
+        case kIROp_Less:
+        case kIROp_Geq:
+        case kIROp_Leq:
+        case kIROp_BitAnd:
+        case kIROp_BitXor:
+        case kIROp_BitOr:
+        case kIROp_BitNot:
+        case kIROp_And:
+        case kIROp_Or:
+        case kIROp_Not:
+        case kIROp_Select:
+        case kIROp_Construct:
+        case kIROp_makeVector:
+        case kIROp_makeStruct:
+        case kIROp_swizzle:
+        case kIROp_FieldExtract:
+        case kIROp_BitCast:
+        {
+            break;
+        }
+        case kIROp_Div:
+        {
+            // Integer division traps on a zero divisor, which an inactive lane can hold
+            if (!_isFloatingPointType(inst->getDataType()))
+            {
+                return false;
+            }
+            break;
+        }
+        default:
+        {
+            // Loads, stores, calls, indexing and so on can access memory an inactive lane must not touch
+            return false;
+        }
+    }
+
+    // Operands folded into the expression are evaluated along with it
+    for (UInt i = 0; i < inst->getOperandCount(); ++i)
+    {
+        IRInst* operand = inst->getOperand(i);
+        if (shouldFoldInstIntoUseSites(operand) && !_isLaneSafeExpr(operand))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void _emitLaneLoopStart(SourceWriter* writer, Index laneCount, const String& activeMaskName)
+{
+    StringBuilder builder;
+    builder << "for (int _l = 0; _l < " << laneCount << "; ++_l)\n{\n";
+    writer->emit(builder);
+    writer->indent();
+    if (activeMaskName.getLength())
+    {
+        builder.Clear();
+        builder << "if (" << activeMaskName << "[_l])\n{\n";
+        writer->emit(builder);
+        writer->indent();
+    }
+}
+
+static void _emitLaneLoopEnd(SourceWriter* writer, const String& activeMaskName)
+{
+    if (activeMaskName.getLength())
+    {
+        writer->dedent();
+        writer->emit("}\n");
+    }
+    writer->dedent();
+    writer->emit("}\n");
+}
+
+void CPPSourceEmitter::_emitLaneFunc(IRFunc* func, const List<IRBlock*>& blocks, const String& funcName)
+{
+    const Index laneCount = _getSIMDLaneCount();
+
+    StringBuilder builder;
+    builder << "static void _" << funcName << "_Lanes(const int32_t* laneMask, ComputeThreadVaryingInput* laneInputs, void* entryPointParams, void* globalParams)\n{\n";
+    m_writer->emit(builder);
+    m_writer->indent();
+
+    m_isEmittingLaneFunc = true;
+
+    // Every value is held in an array with an element per lane. Inside of a loop over the lanes a value is
+    // named by its element, such that the instructions can be emitted as usual.
+    List<IRInst*> laneValues;
+    List<String> laneValueNames;
+    for (auto block : blocks)
+    {
+        for (auto inst : block->getChildren())
+        {
+            if (as<IRTerminatorInst>(inst) || shouldFoldInstIntoUseSites(inst))
+            {
+                continue;
+            }
+
+            IRType* type = inst->getDataType();
+            if (inst->op == kIROp_Var)
+            {
+                type = cast<IRPtrType>(type)->getValueType();
+            }
+            if (!type || as<IRVoidType>(type))
+            {
+                continue;
+            }
+
+            const String name = getName(inst);
+            builder.Clear();
+            builder << name << "[" << laneCount << "]";
+            emitType(type, builder);
+            m_writer->emit(" = {};\n");
+
+            laneValues.add(inst);
+            laneValueNames.add(name);
+        }
+    }
+
+    // Each block has a mask of the lanes that reach it. All lanes given by laneMask enter the first block.
+    Dictionary<IRBlock*, String> maskNames;
+    for (auto block : blocks)
+    {
+        builder.Clear();
+        if (block == blocks[0])
+        {
+            builder << "laneMask";
+        }
+        else
+        {
+            builder << "laneMask" << getName(block);
+            m_writer->emit("int32_t ");
+            m_writer->emit(builder);
+            m_writer->emit("[");
+            m_writer->emit(laneCount);
+            m_writer->emit("] = {};\n");
+        }
+        maskNames.Add(block, builder);
+    }
+
+    for (Index i = 0; i < laneValues.getCount(); ++i)
+    {
+        m_mapInstToName[laneValues[i]] = laneValueNames[i] + "[_l]";
+    }
+
+    {
+        const char* const paramValues[] = { "&laneInputs[_l]", "entryPointParams", "globalParams" };
+        _emitLaneLoopStart(m_writer, laneCount, String());
+        Index paramIndex = 0;
+        for (auto param = func->getFirstParam(); param; param = param->getNextParam())
+        {
+            m_writer->emit(getName(param));
+            m_writer->emit(" = ");
+            m_writer->emit(paramValues[paramIndex++]);
+            m_writer->emit(";\n");
+        }
+        _emitLaneLoopEnd(m_writer, String());
+    }
+
+    for (auto block : blocks)
+    {
+        const String mask = maskNames[block];
+
+        // The values of a block are only used by the blocks it dominates, and no lane reaches
+        // those if none reaches the block, so the block can be skipped.
+        if (block != blocks[0])
+        {
+            builder.Clear();
+            builder << "if (isAnyLaneActive(" << mask << ", " << laneCount << "))\n{\n";
+            m_writer->emit(builder);
+            m_writer->indent();
+        }
+
+        // Consecutive statements share a loop over the lanes. Statements that are safe to evaluate for
+        // inactive lanes run for all lanes (so the C++ compiler can use SIMD instructions), others only
+        // for the active lanes.
+        String openLoopMask;
+        bool isLoopOpen = false;
+
+        auto terminator = block->getTerminator();
+        for (auto inst = block->getFirstOrdinaryInst(); inst != terminator; inst = inst->getNextInst())
+        {
+            if (shouldFoldInstIntoUseSites(inst))
+            {
+                continue;
+            }
+            switch (inst->op)
+            {
+                case kIROp_Var:
+                case kIROp_undefined:
+                case kIROp_DefaultConstruct:
+                {
+                    // Fully handled by the declaration
+                    continue;
+                }
+                default: break;
+            }
+
+            const String loopMask = _isLaneSafeExpr(inst) ? String() : mask;
+            if (!isLoopOpen || loopMask != openLoopMask)
+            {
+                if (isLoopOpen)
+                {
+                    _emitLaneLoopEnd(m_writer, openLoopMask);
+                }
+                _emitLaneLoopStart(m_writer, laneCount, loopMask);
+                openLoopMask = loopMask;
+                isLoopOpen = true;
+            }
+
+            IRType* type = inst->getDataType();
+            if (type && !as<IRVoidType>(type))
+            {
+                m_writer->advanceToSourceLocation(inst->sourceLoc);
+                m_writer->emit(getName(inst));
+                m_writer->emit(" = ");
+                emitInstExpr(inst, getInfo(EmitOp::General));
+                m_writer->emit(";\n");
+            }
+            else
+            {
+                emitInst(inst);
+            }
+        }
+        if (isLoopOpen)
+        {
+            _emitLaneLoopEnd(m_writer, openLoopMask);
+        }
+
+        // The terminator passes the lanes on to the successors
+        m_writer->advanceToSourceLocation(terminator->sourceLoc);
+        switch (terminator->op)
+        {
+            case kIROp_unconditionalBranch:
+            case kIROp_loop:
+            {
+                auto branch = cast<IRUnconditionalBranch>(terminator);
+                IRBlock* target = branch->getTargetBlock();
+
+                _emitLaneLoopStart(m_writer, laneCount, String());
+
+                // The active lanes pass their arguments to the parameters of the target
+                UInt argIndex = 0;
+                for (auto param : target->getParams())
+                {
+                    const String paramName = getName(param);
+                    m_writer->emit(paramName);
+                    m_writer->emit(" = ");
+                    m_writer->emit(mask);
+                    m_writer->emit("[_l] ? ");
+                    emitOperand(branch->getArg(argIndex++), getInfo(EmitOp::General));
+                    m_writer->emit(" : ");
+                    m_writer->emit(paramName);
+                    m_writer->emit(";\n");
+                }
+
+                builder.Clear();
+                builder << maskNames[target].GetValue() << "[_l] |= " << mask << "[_l];\n";
+                m_writer->emit(builder);
+
+                _emitLaneLoopEnd(m_writer, String());
+                break;
+            }
+            case kIROp_conditionalBranch:
+            case kIROp_ifElse:
+            {
+                auto branch = cast<IRConditionalBranch>(terminator);
+
+                _emitLaneLoopStart(m_writer, laneCount, String());
+
+                m_writer->emit("const int32_t laneCond = ");
+                m_writer->emit(mask);
+                m_writer->emit("[_l] ? int32_t(");
+                emitOperand(branch->getCondition(), getInfo(EmitOp::General));
+                m_writer->emit(") : 0;\n");
+
+                builder.Clear();
+                builder << maskNames[branch->getTrueBlock()].GetValue() << "[_l] |= laneCond;\n";
+                builder << maskNames[branch->getFalseBlock()].GetValue() << "[_l] |= " << mask << "[_l] & (laneCond ^ 1);\n";
+                m_writer->emit(builder);
+
+                _emitLaneLoopEnd(m_writer, String());
+                break;
+            }
+            default:
+            {
+                // Returning lanes reach no other block
+                break;
+            }
+        }
+
+        if (block != blocks[0])
+        {
+            m_writer->dedent();
+            m_writer->emit("}\n");
+        }
+    }
+
+    for (Index i = 0; i < laneValues.getCount(); ++i)
+    {
+        m_mapInstToName[laneValues[i]] = laneValueNames[i];
+    }
+    m_isEmittingLaneFunc = false;
+
+    m_writer->dedent();
+    m_writer->emit("}\n\n");
+}
+
+void CPPSourceEmitter::_emitEntryPointGroupLanes(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName)
+{
+    const Index laneCount = _getSIMDLaneCount();
+    const Int groupSize = sizeAlongAxis[0] * sizeAlongAxis[1] * sizeAlongAxis[2];
+
+    // The invocations of the group are run laneCount at a time, in x, y, z order. Lanes past the end of
+    // the group are inactive.
+    StringBuilder builder;
+    builder << "ComputeThreadVaryingInput laneInputs[" << laneCount << "];\n";
+    builder << "int32_t laneMask[" << laneCount << "];\n";
+    builder << "for (uint32_t i = 0; i < " << groupSize << "; i += " << laneCount << ")\n{\n";
+    m_writer->emit(builder);
+    m_writer->indent();
+
+    _emitLaneLoopStart(m_writer, laneCount, String());
+    builder.Clear();
+    builder << "const uint32_t index = i + uint32_t(_l);\n";
+    builder << "laneInputs[_l] = threadInput;\n";
+    builder << "laneInputs[_l].groupThreadID.x = index % " << sizeAlongAxis[0] << ";\n";
+    builder << "laneInputs[_l].groupThreadID.y = (index / " << sizeAlongAxis[0] << ") % " << sizeAlongAxis[1] << ";\n";
+    builder << "laneInputs[_l].groupThreadID.z = index / " << sizeAlongAxis[0] * sizeAlongAxis[1] << ";\n";
+    builder << "laneMask[_l] = int32_t(index < " << groupSize << ");\n";
+    m_writer->emit(builder);
+    _emitLaneLoopEnd(m_writer, String());
+
+    builder.Clear();
+    builder << "_" << funcName << "_Lanes(laneMask, laneInputs, entryPointParams, globalParams);\n";
+    m_writer->emit(builder);
+
+    m_writer->dedent();
+    m_writer->emit("}\n");
+}
+
 void CPPSourceEmitter::_emitEntryPointGroupRange(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName)
 {
     List<AxisWithSize> axes;
@@ -2652,6 +3291,9 @@ void CPPSourceEmitter::emitModuleImpl(IRModule* module)
 
     List<EmitAction> actions;
     computeEmitActions(module, actions);
+
+    // The barrier functions are only defined in the prelude if they are needed
+    m_requiresComputeGroup = (m_target == CodeGenTarget::CPPSource) && _isBarrierUsed(module);
     
     _emitForwardDeclarations(actions);
 
@@ -2720,6 +3362,17 @@ void CPPSourceEmitter::emitModuleImpl(IRModule* module)
 
                 // Emit the group version which runs for all elements in *single* thread group
                 {
+                    HashSet<IRFunc*> visited;
+                    const bool useFibers = m_target == CodeGenTarget::CPPSource && _isGroupSyncReachable(func, visited);
+
+                    // With SIMD enabled, a kernel without loops is run through a lane wide version of it
+                    List<IRBlock*> laneBlocks;
+                    const bool useLanes = !useFibers && _isSIMDGroupEnabled() && _calcLaneFuncBlocks(func, laneBlocks);
+                    if (useLanes)
+                    {
+                        _emitLaneFunc(func, laneBlocks, funcName);
+                    }
+
                     StringBuilder builder;
                     builder << getName(func);
                     builder << "_Group";
@@ -2731,7 +3384,18 @@ void CPPSourceEmitter::emitModuleImpl(IRModule* module)
                     m_writer->emit("ComputeThreadVaryingInput threadInput = {};\n");
                     m_writer->emit("threadInput.groupID = varyingInput->startGroupID;\n");
 
-                    _emitEntryPointGroup(groupThreadSize, funcName);
+                    if (useFibers)
+                    {
+                        _emitEntryPointGroupFibers(groupThreadSize, funcName);
+                    }
+                    else if (useLanes)
+                    {
+                        _emitEntryPointGroupLanes(groupThreadSize, funcName);
+                    }
+                    else
+                    {
+                        _emitEntryPointGroup(groupThreadSize, funcName);
+                    }
                     _emitEntryPointDefinitionEnd(func);
                 }
 
@@ -73,6 +73,9 @@ protected:
     virtual void emitIntrinsicCallExprImpl(IRCall* inst, IRTargetIntrinsicDecoration* targetIntrinsic, EmitOpInfo const& inOuterPrec) SLANG_OVERRIDE;
 
     virtual void emitLoopControlDecorationImpl(IRLoopControlDecoration* decl) SLANG_OVERRIDE;
+    virtual bool canFoldInstIntoUseSitesImpl(IRInst* inst) SLANG_OVERRIDE;
+    virtual void emitRateQualifiersImpl(IRRate* rate) SLANG_OVERRIDE;
+    virtual void emitPreludeDirectivesImpl() SLANG_OVERRIDE;
 
     // Replaceable for classes derived from CPPSourceEmitter
     virtual SlangResult calcTypeName(IRType* type, CodeGenTarget target, StringBuilder& out);
@@ -112,7 +115,34 @@ protected:
     void _emitEntryPointDefinitionStart(IRFunc* func, const String& funcName, const UnownedStringSlice& varyingTypeName);
     void _emitEntryPointDefinitionEnd(IRFunc* func);
     void _emitEntryPointGroup(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName);
+        /// True if the invocations of a compute group should be emitted such that they can be run in SIMD lanes
+    bool _isSIMDGroupEnabled();
+        /// The amount of invocations run at a time in SIMD lanes
+    Index _getSIMDLaneCount();
+        /// True if func can be emitted lane wide. If so outBlocks holds its blocks in reverse post order.
+    bool _calcLaneFuncBlocks(IRFunc* func, List<IRBlock*>& outBlocks);
+        /// True if the expression emitted for inst (including folded operands) can be evaluated for inactive lanes
+    bool _isLaneSafeExpr(IRInst* inst);
+        /// Emit the lane wide version of func, where each value is an array holding a value per lane
+    void _emitLaneFunc(IRFunc* func, const List<IRBlock*>& blocks, const String& funcName);
+        /// Emit a group that runs the invocations in SIMD lanes through the lane wide function
+    void _emitEntryPointGroupLanes(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName);
     void _emitEntryPointGroupRange(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName);
+        /// Emit a group that runs the invocations as fibers, such that they can wait on group sync barriers
+    void _emitEntryPointGroupFibers(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName);
+
+    enum class BarrierKind
+    {
+        None,           ///< Not a barrier
+        Memory,         ///< Orders memory accesses only
+        GroupSync,      ///< Waits for all invocations in the group
+    };
+        /// Get the kind of barrier calling callee is
+    BarrierKind _getBarrierKind(IRInst* callee);
+        /// True if an instruction in func, or in a function it calls, is a group sync barrier
+    bool _isGroupSyncReachable(IRFunc* func, HashSet<IRFunc*>& ioVisited);
+        /// True if the module calls a barrier of any kind
+    bool _isBarrierUsed(IRModule* module);
 
     void _emitInitAxisValues(const Int sizeAlongAxis[kThreadGroupAxisCount], const UnownedStringSlice& mulName, const UnownedStringSlice& addName);
 
@@ -142,6 +172,9 @@ protected:
 
     SemanticUsedFlags m_semanticUsedFlags;
 
+    bool m_requiresComputeGroup = false;        ///< If set the prelude must define the compute group runtime (for barriers)
+    bool m_isEmittingLaneFunc = false;          ///< Set while emitting the lane wide version of an entry point
+
     // Witness tables pending for emitting their definitions.
     // They must be emitted last, after the entire `Context` class so those member functions defined
     // in `Context` may be referenced.
@@ -16,7 +16,8 @@
 
 namespace Slang {
 
-SourceWriter::SourceWriter(SourceManager* sourceManager, LineDirectiveMode lineDirectiveMode)
+SourceWriter::SourceWriter(SourceManager* sourceManager, LineDirectiveMode lineDirectiveMode) :
+    m_sourceLocResolver(sourceManager)
 {
     m_lineDirectiveMode = lineDirectiveMode;
     this->m_sourceManager = sourceManager;
@@ -253,7 +254,12 @@ void SourceWriter::emit(double value)
 
 void SourceWriter::advanceToSourceLocation(const SourceLoc& sourceLocation)
 {
-    advanceToSourceLocation(getSourceManager()->getHumaneLoc(sourceLocation));
+    // The location is only used for line directives
+    if (getLineDirectiveMode() == LineDirectiveMode::None)
+        return;
+
+    // Code is mostly emitted in source order, so the lookup is typically a short step from the previous one
+    advanceToSourceLocation(m_sourceLocResolver.getHumaneLoc(sourceLocation));
 }
 
 void SourceWriter::advanceToSourceLocation(const HumaneSourceLoc& sourceLocation)
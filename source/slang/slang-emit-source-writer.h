@@ -107,6 +107,7 @@ protected:
     Int m_indentLevel = 0;
 
     SourceManager* m_sourceManager = nullptr;
+    SourceLocResolver m_sourceLocResolver;      ///< Resolves the locations of emitted code on m_sourceManager
 
     // For GLSL output, we can't emit traditional `#line` directives
     // with a file path in them, so we maintain a map that associates
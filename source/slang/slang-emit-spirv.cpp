@@ -2,10 +2,12 @@
 #include "slang-emit.h"
 
 #include "slang-compiler.h"
+#include "slang-emit-c-like.h"
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
 
 #include "spirv/unified1/spirv.h"
+#include "spirv/unified1/GLSL.std.450.h"
 
 #include "../core/slang-memory-arena.h"
 
@@ -85,7 +87,6 @@ enum class SpvLogicalSectionID
     DebugNames,
     Annotations,
     Types,
-    Constants,
     GlobalVariables,
     FunctionDeclarations,
     FunctionDefinitions,
@@ -133,6 +134,9 @@ public:
         /// Add an instruction to the end of the list of children
     void addInst(SpvInst* inst);
 
+        /// Move all the children of `other` to the start of the list of children, leaving `other` empty
+    void prependChildrenOf(SpvInstParent* other);
+
         /// Dump all children, recursively, to a flattened list of SPIR-V words
     void dumpTo(List<SpvWord>& ioWords);
 
@@ -260,6 +264,24 @@ void SpvInstParent::addInst(SpvInst* inst)
     m_link = &inst->nextSibling;
 }
 
+void SpvInstParent::prependChildrenOf(SpvInstParent* other)
+{
+    if( !other->m_firstChild )
+        return;
+
+    // The last child of `other` links to our current first child.
+    //
+    *other->m_link = m_firstChild;
+    if( !m_firstChild )
+    {
+        m_link = other->m_link;
+    }
+    m_firstChild = other->m_firstChild;
+
+    other->m_firstChild = nullptr;
+    other->m_link = &other->m_firstChild;
+}
+
 void SpvInstParent::dumpTo(List<SpvWord>& ioWords)
 {
     for( auto child = m_firstChild; child; child = child->nextSibling )
@@ -339,7 +361,9 @@ struct SPIRVEmitContext
 
         // > Version nuumber
         //
-        m_words.add(SpvVersion);
+        // This is the lowest version that supports everything that was emitted.
+        //
+        m_words.add(m_spirvVersion);
 
         // > Generator's magic number.
         // > Its value does not affect any semantics, and is allowed to be 0.
@@ -521,6 +545,16 @@ struct SPIRVEmitContext
             // the ordering of instruction words to be interleaved.
             //
             spvInst = emitGlobalInst(irInst);
+
+            // Many global instructions (e.g. types) are shared between
+            // equivalent IR instructions, and so may not have been
+            // registered as corresponding to `irInst`. The placeholder
+            // used for unsupported instructions is never registered.
+            //
+            if( spvInst && spvInst != m_placeholderInst && !m_mapIRInstToSpvInst.ContainsKey(irInst) )
+            {
+                registerInst(irInst, spvInst);
+            }
         }
         return spvInst;
     }
@@ -561,10 +595,11 @@ struct SPIRVEmitContext
         /// Emit an operand to the current instruction, which references `src` by its <id>
     void emitOperand(IRInst* src)
     {
-        // We first ensure that the `src` instruction has been emitted,
+        // We first ensure that the `src` instruction has been emitted
+        // (and loaded, if it is a variable used as a value; see `getValue`),
         // and then handle it as for any other <id> operand.
         //
-        SpvInst* spvSrc = ensureInst(src);
+        SpvInst* spvSrc = getValue(src);
         emitOperand(getID(spvSrc));
     }
 
@@ -742,6 +777,79 @@ struct SPIRVEmitContext
         return spvInst;
     }
 
+    template<typename A, typename B, typename C, typename D, typename E, typename F>
+    SpvInst* emitInst(SpvInstParent* parent, IRInst* irInst, SpvOp opcode, A const& a, B const& b, C const& c, D const& d, E const& e, F const& f)
+    {
+        InstConstructScope scopeInst(this, opcode, irInst);
+        SpvInst* spvInst = scopeInst;
+        emitOperand(a);
+        emitOperand(b);
+        emitOperand(c);
+        emitOperand(d);
+        emitOperand(e);
+        emitOperand(f);
+        parent->addInst(spvInst);
+        return spvInst;
+    }
+
+    template<typename A, typename B, typename C, typename D, typename E, typename F, typename G>
+    SpvInst* emitInst(SpvInstParent* parent, IRInst* irInst, SpvOp opcode, A const& a, B const& b, C const& c, D const& d, E const& e, F const& f, G const& g)
+    {
+        InstConstructScope scopeInst(this, opcode, irInst);
+        SpvInst* spvInst = scopeInst;
+        emitOperand(a);
+        emitOperand(b);
+        emitOperand(c);
+        emitOperand(d);
+        emitOperand(e);
+        emitOperand(f);
+        emitOperand(g);
+        parent->addInst(spvInst);
+        return spvInst;
+    }
+
+    // Some instructions have a variable number of operands that
+    // we compute before emitting the instruction, and for those
+    // we allow the operands to be given as a list of words.
+
+    struct OperandWords
+    {
+        OperandWords(List<SpvWord> const& words)
+            : words(words)
+        {}
+
+        List<SpvWord> const& words;
+    };
+
+        /// Emit each word in `words` as an operand to the current instruction
+    void emitOperand(OperandWords const& other)
+    {
+        for( auto word : other.words )
+        {
+            emitOperand(word);
+        }
+    }
+
+    // A few instructions (notably `OpPhi`) can only have their operands
+    // filled in once the rest of a function has been emitted. The
+    // instruction is created (and given an <id>) up front, and then
+    // the operands are replaced later.
+
+        /// Replace the operand words of `inst` with `words`
+    void setOperands(SpvInst* inst, List<SpvWord> const& words)
+    {
+        inst->operandWords = words.getCount() ? m_memoryArena.allocateAndCopyArray(words.getBuffer(), words.getCount()) : nullptr;
+        inst->operandWordsCount = uint32_t(words.getCount());
+    }
+
+        /// Create an instruction that defines a result <id>, without adding it to a parent.
+    SpvInst* createInstWithResult(SpvOp opcode, IRInst* irInst = nullptr)
+    {
+        InstConstructScope scopeInst(this, opcode, irInst);
+        emitOperand(kResultID);
+        return scopeInst;
+    }
+
     // Now that we've gotten the core infrastructure out of the way,
     // let's start looking at emitting some instructions that make
     // up a SPIR-V module.
@@ -755,12 +863,12 @@ struct SPIRVEmitContext
         /// the SPIR-V module must include to make it usable.
     void emitFrontMatter()
     {
-        // TODO: We should ideally add SPIR-V capabilities to
-        // the module as we emit instructions that require them.
-        // For now we will always emit the `Shader` capability,
-        // since every Vulkan shader module will use it.
+        // Every Vulkan shader module will use the `Shader`
+        // capability. Any other capabilities are added on
+        // demand by `requireCapability` as we emit instructions
+        // that require them.
         //
-        emitInst(getSection(SpvLogicalSectionID::Capabilities), nullptr, SpvOpCapability, SpvCapabilityShader);
+        requireCapability(SpvCapabilityShader);
 
         // [2.4: Logical Layout of a Module]
         //
@@ -779,383 +887,5576 @@ struct SPIRVEmitContext
         emitInst(getSection(SpvLogicalSectionID::MemoryModel),  nullptr, SpvOpMemoryModel, SpvAddressingModelLogical, SpvMemoryModelGLSL450);
     }
 
-    // Next, let's look at emitting some of the instructions
-    // that can occur at global scope.
+    // The direct emitter doesn't (yet) handle every instruction that
+    // can appear in the Slang IR. Rather than fail the compile when
+    // an unhandled case is found, we record the reason and keep going,
+    // so that the caller can fall back to generating SPIR-V via GLSL.
 
-        /// Emit an instruction that is expected to appear at the global scope of the SPIR-V module.
-        ///
-        /// Returns the corresponding SPIR-V instruction.
+        /// The reason the first unsupported construct was found, or empty if none was
+    String m_unsupportedReason;
+
+        /// Returns true if something that couldn't be emitted was found
+    bool hasFailed() const { return m_unsupportedReason.getLength() != 0; }
+
+        /// Note that `irInst` uses something (described by `what`) that can't be emitted.
         ///
-    SpvInst* emitGlobalInst(IRInst* inst)
+        /// Returns a placeholder instruction so that emitting can continue.
+    SpvInst* _unsupported(IRInst* irInst, char const* what)
     {
-        switch( inst->op )
+        if( !hasFailed() )
         {
-        // [3.32.6: Type-Declaration Instructions]
-        //
+            StringBuilder builder;
+            builder << what;
+            if( irInst )
+            {
+                builder << " (" << getIROpInfo(irInst->op).name << ")";
+            }
+            m_unsupportedReason = builder.ProduceString();
+        }
+        return _getPlaceholderInst();
+    }
 
-#define CASE(IROP, SPVOP) \
-        case IROP: return emitInst(getSection(SpvLogicalSectionID::Types), inst, SPVOP, kResultID)
+        /// An instruction that is used in place of one that couldn't be emitted
+    SpvInst* m_placeholderInst = nullptr;
 
-        // > OpTypeVoid
-        CASE(kIROp_VoidType, SpvOpTypeVoid);
+    SpvInst* _getPlaceholderInst()
+    {
+        if( !m_placeholderInst )
+        {
+            m_placeholderInst = createInstWithResult(SpvOpNop);
+        }
+        return m_placeholderInst;
+    }
 
-        // > OpTypeBool
-        CASE(kIROp_BoolType, SpvOpTypeBool);
+    // [2.4: Logical Layout of a Module]
+    //
+    // > All OpCapability instructions.
+    //
+    // We add a capability the first time that something that needs it
+    // is emitted.
 
-#undef CASE
+        /// The capabilities that have been added to the module
+    HashSet<SpvWord> m_capabilities;
 
-        // > OpTypeInt
+        /// Add `capability` to the module, if it hasn't been added already
+    void requireCapability(SpvCapability capability)
+    {
+        if( m_capabilities.Add(SpvWord(capability)) )
+        {
+            emitInst(getSection(SpvLogicalSectionID::Capabilities), nullptr, SpvOpCapability, capability);
+        }
+    }
 
-#define CASE(IROP, BITS, SIGNED) \
-        case IROP: return emitInst(getSection(SpvLogicalSectionID::Types), inst, SpvOpTypeInt, kResultID, BITS, SIGNED)
+    // [2.4: Logical Layout of a Module]
+    //
+    // > All OpExtInstImport instructions.
+    //
+    // Most of the GLSL builtin functions map to instructions from the
+    // `GLSL.std.450` extended instruction set, which is imported when
+    // it is first needed.
 
-        CASE(kIROp_IntType,     32, 1);
-        CASE(kIROp_UIntType,    32, 0);
-        CASE(kIROp_Int64Type,   64, 1);
-        CASE(kIROp_UInt64Type,  64, 0);
+    SpvInst* m_glslStd450 = nullptr;
 
-#undef CASE
+    SpvInst* getGLSLStd450()
+    {
+        if( !m_glslStd450 )
+        {
+            m_glslStd450 = emitInst(getSection(SpvLogicalSectionID::ExtIntInstImports), nullptr, SpvOpExtInstImport, kResultID, UnownedStringSlice::fromLiteral("GLSL.std.450"));
+        }
+        return m_glslStd450;
+    }
 
-        // > OpTypeFloat
+    // [2.8: Types]
+    //
+    // > Two different type <id>s form, by definition, two different types.
+    // > It is invalid to declare multiple non-aggregate, non-pointer type
+    // > <id>s having the same opcode and operands.
+    //
+    // Slang IR types are also deduplicated, but several different Slang types
+    // can map to the same SPIR-V type (e.g. `vector<float,1>` and `float`),
+    // and we also create types that don't correspond to any IR instruction
+    // (pointers, wrapper types for buffers, etc). So types, and likewise
+    // constants, are deduplicated on their opcode and operand words.
+
+    struct GlobalInstKey
+    {
+        List<SpvWord> words;
 
-#define CASE(IROP, BITS) \
-        case IROP: return emitInst(getSection(SpvLogicalSectionID::Types), inst, SpvOpTypeFloat, kResultID, BITS)
+        HashCode getHashCode() const
+        {
+            return Slang::getHashCode((const char*)words.getBuffer(), size_t(words.getCount()) * sizeof(SpvWord));
+        }
+        bool operator==(const GlobalInstKey& rhs) const
+        {
+            return words.getCount() == rhs.words.getCount() &&
+                ::memcmp(words.getBuffer(), rhs.words.getBuffer(), size_t(words.getCount()) * sizeof(SpvWord)) == 0;
+        }
+    };
 
-        CASE(kIROp_HalfType,    16);
-        CASE(kIROp_FloatType,   32);
-        CASE(kIROp_DoubleType,  64);
+    Dictionary<GlobalInstKey, SpvInst*> m_globalInsts;
 
-#undef CASE
+        /// Emit a type instruction with the given `operands` (which don't include the result <id>), or return an identical one.
+    SpvInst* emitTypeInst(SpvOp opcode, List<SpvWord> const& operands)
+    {
+        GlobalInstKey key;
+        key.words.add(SpvWord(opcode));
+        key.words.addRange(operands);
 
-        // > OpTypeVector
-        // > OpTypeMatrix
-        // > OpTypeImage
-        // > OpTypeSampler
-        // > OpTypeArray
-        // > OpTypeRuntimeArray
-        // > OpTypeStruct
-        // > OpTypeOpaque
-        // > OpTypePointer
+        SpvInst* spvInst = nullptr;
+        if( m_globalInsts.TryGetValue(key, spvInst) )
+            return spvInst;
 
-        case kIROp_FuncType:
-            // > OpTypeFunction
-            //
-            // Both Slang and SPIR-V encode a function type
-            // with the result-type operand coming first,
-            // followed by operand sfor all the parameter types.
-            //
-            return emitInst(getSection(SpvLogicalSectionID::Types), inst, SpvOpTypeFunction, kResultID, OperandsOf(inst));
+        // The result <id> of a type is its first operand.
+        //
+        spvInst = emitInst(getSection(SpvLogicalSectionID::Types), nullptr, opcode, kResultID, OperandWords(operands));
+        m_globalInsts.Add(key, spvInst);
+        return spvInst;
+    }
 
-        // > OpTypeForwardPointer
+    SpvInst* emitTypeInst(SpvOp opcode)
+    {
+        List<SpvWord> operands;
+        return emitTypeInst(opcode, operands);
+    }
 
-        case kIROp_Func:
-            // [3.32.6: Function Instructions]
-            //
-            // > OpFunction
-            //
-            // Functions are complex enough that we'll handle
-            // them in a dedicated subroutine.
-            //
-            return emitFunc(as<IRFunc>(inst));
+        /// Emit a constant of type `type` with the given `operands` (which don't include the type or result <id>), or return an identical one.
+    SpvInst* emitConstantInst(SpvOp opcode, SpvInst* type, List<SpvWord> const& operands)
+    {
+        GlobalInstKey key;
+        key.words.add(SpvWord(opcode));
+        key.words.add(getID(type));
+        key.words.addRange(operands);
 
-        // ...
+        SpvInst* spvInst = nullptr;
+        if( m_globalInsts.TryGetValue(key, spvInst) )
+            return spvInst;
 
-        default:
-            SLANG_UNIMPLEMENTED_X("unhandled instruction opcode");
-            UNREACHABLE_RETURN(nullptr);
-        }
+        // Constants take the type <id> first, and then the result <id>.
+        //
+        spvInst = emitInst(getSection(SpvLogicalSectionID::Types), nullptr, opcode, type, kResultID, OperandWords(operands));
+        m_globalInsts.Add(key, spvInst);
+        return spvInst;
     }
 
-        /// Emit the given `irFunc` to SPIR-V
-    SpvInst* emitFunc(IRFunc* irFunc)
+        /// Returns true if `inst` is a constant (and so can be used as an operand to other constants)
+    static bool _isConstant(SpvInst* inst)
     {
-        // [2.4: Logical Layout of a Module]
-        //
-        // > All function declarations ("declarations" are functions
-        // > without a body; there is no forward declaration to a
-        // > function with a body).
-        // > ...
-        // > All function definitions (functions with a body).
-        //
-        // We need to treat functions differently based
-        // on whether they have a body or not, since these
-        // are encoded differently (and to different sections).
-        //
-        if( isDefinition(irFunc) )
+        switch( inst->opcode )
         {
-            return emitFuncDefinition(irFunc);
+        case SpvOpConstant:
+        case SpvOpConstantTrue:
+        case SpvOpConstantFalse:
+        case SpvOpConstantComposite:
+        case SpvOpConstantNull:
+            return true;
+        default:
+            return false;
         }
-        else
+    }
+
+    // [3.32.2. Debug Instructions]
+    //
+    // > OpName
+    //
+    // Names are purely informative, but make the output much easier to
+    // read when disassembled, so we emit them for anything that has a
+    // name hint.
+
+    void emitNameForInst(SpvInst* spvInst, IRInst* irInst)
+    {
+        if( auto nameHint = irInst->findDecoration<IRNameHintDecoration>() )
         {
-            return emitFuncDeclaration(irFunc);
+            emitInst(getSection(SpvLogicalSectionID::DebugNames), nullptr, SpvOpName, spvInst, nameHint->getName());
         }
     }
 
-        /// Emit a declaration for the given `irFunc`
-    SpvInst* emitFuncDeclaration(IRFunc* irFunc)
+    void emitDecoration(SpvInst* target, SpvDecoration decoration)
     {
-        // For now we aren't handling function declarations;
-        // we expect to deal only with fully linked modules.
-        //
-        SLANG_UNUSED(irFunc);
-        SLANG_UNEXPECTED("function declaration in SPIR-V emit");
-        UNREACHABLE_RETURN(nullptr);
+        emitInst(getSection(SpvLogicalSectionID::Annotations), nullptr, SpvOpDecorate, target, decoration);
     }
 
-        /// Emit a SPIR-V function definition for the Slang IR function `irFunc`.
-    SpvInst* emitFuncDefinition(IRFunc* irFunc)
+    void emitDecoration(SpvInst* target, SpvDecoration decoration, SpvWord value)
     {
-        // [2.4: Logical Layout of a Module]
-        //
-        // > All function definitions (functions with a body).
-        //
-        auto section = getSection(SpvLogicalSectionID::FunctionDefinitions);
-        //
-        // > A function definition is as follows.
-        // > * Function definition, using OpFunction.
-        // > * Function parameter declarations, using OpFunctionParameter.
-        // > * Block
-        // > * Block
-        // > * ...
-        // > * Function end, using OpFunctionEnd.
-        //
+        emitInst(getSection(SpvLogicalSectionID::Annotations), nullptr, SpvOpDecorate, target, decoration, value);
+    }
 
-        // [3.24. Function Control]
-        //
-        // TODO: We should eventually support emitting the "function control"
-        // mask to include inline and other hint bits based on decorations
-        // set on `irFunc`.
-        //
-        SpvFunctionControlMask spvFunctionControl = SpvFunctionControlMaskNone;
+    void emitMemberDecoration(SpvInst* target, SpvWord member, SpvDecoration decoration)
+    {
+        emitInst(getSection(SpvLogicalSectionID::Annotations), nullptr, SpvOpMemberDecorate, target, member, decoration);
+    }
 
-        // [3.32.9. Function Instructions]
-        //
-        // > OpFunction
-        //
-        // Note that the type <id> of a SPIR-V function uses the
-        // *result* type of the function, while the actual function
-        // type is given as a later operand. Slan IR instead uses
-        // the type of a function instruction store, you know, its *type*.
-        //
-        SpvInst* spvFunc = emitInst(section, irFunc, SpvOpFunction,
-            irFunc->getDataType()->getResultType(),
-            kResultID,
-            spvFunctionControl,
-            irFunc->getDataType());
+    void emitMemberDecoration(SpvInst* target, SpvWord member, SpvDecoration decoration, SpvWord value)
+    {
+        emitInst(getSection(SpvLogicalSectionID::Annotations), nullptr, SpvOpMemberDecorate, target, member, decoration, value);
+    }
 
-        // > OpFunctionParameter
-        //
-        // Unlike Slang, where parameters always belong to blocks,
-        // the parameters of a SPIR-V function must appear as direct
-        // children of the function instruction, and before any basic blocks.
-        //
-        for( auto irParam : irFunc->getParams() )
+    // Next, let's look at the types. Most IR types have a direct
+    // SPIR-V equivalent, but we need some helpers to reason about
+    // scalar and vector types when selecting opcodes.
+
+        /// The kind of a scalar type, for the purpose of choosing SPIR-V opcodes
+    enum class ScalarKind
+    {
+        None,
+        Bool,
+        SignedInt,
+        UnsignedInt,
+        Float,
+    };
+
+    static ScalarKind _getScalarKind(IRType* type)
+    {
+        if( !type )
+            return ScalarKind::None;
+        switch( type->op )
         {
-            emitInst(spvFunc, irParam, SpvOpFunctionParameter,
-                irParam->getFullType(),
-                kResultID);
+        case kIROp_BoolType:
+            return ScalarKind::Bool;
+        case kIROp_Int8Type:
+        case kIROp_Int16Type:
+        case kIROp_IntType:
+        case kIROp_Int64Type:
+            return ScalarKind::SignedInt;
+        case kIROp_UInt8Type:
+        case kIROp_UInt16Type:
+        case kIROp_UIntType:
+        case kIROp_UInt64Type:
+            return ScalarKind::UnsignedInt;
+        case kIROp_HalfType:
+        case kIROp_FloatType:
+        case kIROp_DoubleType:
+            return ScalarKind::Float;
+        default:
+            return ScalarKind::None;
         }
+    }
 
-        // [3.32.17. Control-Flow Instructions]
-        //
-        // > OpLabel
-        //
-        // A Slang `IRBlock` corresponds to a SPIR-V `OpLabel`:
-        // each represents a basic block in the control flow
-        // graph of a parent function.
-        //
-        // We will allocate SPIR-V instructions to represent
-        // all of the blocks in a function before we emit
-        // body instructions into any of them. We do this
-        // because it is possible for one block to make
-        // forward reference to another (wheras that is
-        // not possible for ordinary instructions within
-        // the blocks in the Slang IR)
-        //
-        for( auto irBlock : irFunc->getBlocks() )
+        /// Get the size in bytes of the scalar `type`, or zero if it isn't a (sized) scalar
+    static SpvWord _getScalarByteSize(IRType* type)
+    {
+        if( !type )
+            return 0;
+        switch( type->op )
         {
-            emitInst(spvFunc, irBlock, SpvOpLabel, kResultID);
+        case kIROp_Int8Type:
+        case kIROp_UInt8Type:
+            return 1;
+        case kIROp_Int16Type:
+        case kIROp_UInt16Type:
+        case kIROp_HalfType:
+            return 2;
+        case kIROp_IntType:
+        case kIROp_UIntType:
+        case kIROp_FloatType:
+            return 4;
+        case kIROp_Int64Type:
+        case kIROp_UInt64Type:
+        case kIROp_DoubleType:
+            return 8;
+        default:
+            return 0;
         }
+    }
 
-        // Once all the basic blocks have had instructions allocated
-        // for them, we go through and fill them in with their bodies.
-        //
-        for( auto irBlock : irFunc->getBlocks() )
+        /// If `type` is a scalar or vector, returns the scalar type and sets `outCount` to the amount of elements.
+        ///
+        /// A scalar has a count of 1. Returns nullptr if `type` is neither.
+    static IRType* _getScalarType(IRType* type, Index& outCount)
+    {
+        if( auto vectorType = as<IRVectorType>(type) )
         {
-            // Note: because we already created the block above,
-            // we can be sure that it will have been registred.
-            //
-            SpvInst* spvBlock = nullptr;
-            m_mapIRInstToSpvInst.TryGetValue(irBlock, spvBlock);
-            SLANG_ASSERT(spvBlock);
-
-            // [3.32.17. Control-Flow Instructions]
-            //
-            // > OpPhi
-            //
-            // TODO: We eventually need to emit `OpPhi` instructions corresponding
-            // to the parameters of any non-entry block, with operands representing
-            // the values passed along incoming edges from the predecessor blocks.
-
-            for( auto irInst : irBlock->getOrdinaryInsts() )
-            {
-                // Any instructions local to the block will be emitted as children
-                // of the block.
-                //
-                emitLocalInst(spvBlock, irInst);
-            }
+            outCount = Index(getIntVal(vectorType->getElementCount()));
+            return vectorType->getElementType();
+        }
+        if( _getScalarKind(type) != ScalarKind::None )
+        {
+            outCount = 1;
+            return type;
         }
+        outCount = 0;
+        return nullptr;
+    }
 
-        // [3.32.9. Function Instructions]
-        //
-        // > OpFunctionEnd
-        //
-        // In the SPIR-V encoding a function is logically the parent of any
-        // instructions up to a matching `OpFunctionEnd`. In our intermediate
-        // structure we will make the `OpFunctionEnd` be the last child of
-        // the `OpFunction`.
-        //
-        emitInst(spvFunc, nullptr, SpvOpFunctionEnd);
+    static IRType* _getScalarType(IRType* type)
+    {
+        Index count;
+        return _getScalarType(type, count);
+    }
 
-        // We will emit any decorations pertinent to the function to the
-        // appropriate section of the module.
-        //
-        emitDecorations(irFunc, getID(spvFunc));
+        /// Get the type pointed to by a pointer(-like) IR type.
+    static IRType* _getPointeeType(IRType* type)
+    {
+        if( auto rateType = as<IRRateQualifiedType>(type) )
+            type = rateType->getValueType();
+        if( auto ptrType = as<IRPtrTypeBase>(type) )
+            return ptrType->getValueType();
+        if( auto groupType = as<IRUniformParameterGroupType>(type) )
+            return groupType->getElementType();
+        return nullptr;
+    }
 
-        return spvFunc;
+        /// Used for creating IR types that the emitter needs (e.g. the results of GLSL builtins)
+    SharedIRBuilder m_sharedBuilder;
+    IRBuilder m_builder;
+
+    IRType* _getVectorType(IRType* elementType, Index count)
+    {
+        if( count == 1 )
+            return elementType;
+        return m_builder.getVectorType(elementType, m_builder.getIntValue(m_builder.getIntType(), count));
     }
 
-    // The instructions that appear inside the basic blocks of
-    // functions are what we will call "local" instructions.
+    IRType* _getIntVectorType(Index count) { return _getVectorType(m_builder.getIntType(), count); }
+    IRType* _getUIntVectorType(Index count) { return _getVectorType(m_builder.getUIntType(), count); }
+    IRType* _getFloatVectorType(Index count) { return _getVectorType(m_builder.getBasicType(BaseType::Float), count); }
+    IRType* _getBoolVectorType(Index count) { return _getVectorType(m_builder.getBoolType(), count); }
+
+    // [3.32.6: Type-Declaration Instructions]
+
+        /// Get the SPIR-V type for the IR `type`
+    SpvInst* getType(IRType* type)
+    {
+        if( !type )
+            return _unsupported(nullptr, "value without a type");
+
+        SpvInst* spvType = nullptr;
+        if( m_mapIRInstToSpvInst.TryGetValue(type, spvType) )
+            return spvType;
+
+        spvType = _emitType(type);
+        if( spvType != m_placeholderInst && !m_mapIRInstToSpvInst.ContainsKey(type) )
+        {
+            registerInst(type, spvType);
+        }
+        return spvType;
+    }
+
+    SpvInst* _emitScalarType(IRType* type)
+    {
+        List<SpvWord> operands;
+        switch( type->op )
+        {
+        // > OpTypeVoid
+        case kIROp_VoidType:
+            return emitTypeInst(SpvOpTypeVoid);
+
+        // > OpTypeBool
+        case kIROp_BoolType:
+            return emitTypeInst(SpvOpTypeBool);
+
+        // > OpTypeInt
+        case kIROp_Int8Type:
+        case kIROp_UInt8Type:
+            requireCapability(SpvCapabilityInt8);
+            break;
+        case kIROp_Int16Type:
+        case kIROp_UInt16Type:
+            requireCapability(SpvCapabilityInt16);
+            break;
+        case kIROp_Int64Type:
+        case kIROp_UInt64Type:
+            requireCapability(SpvCapabilityInt64);
+            break;
+
+        // > OpTypeFloat
+        case kIROp_HalfType:
+            requireCapability(SpvCapabilityFloat16);
+            break;
+        case kIROp_DoubleType:
+            requireCapability(SpvCapabilityFloat64);
+            break;
+
+        default:
+            break;
+        }
+
+        const SpvWord bits = _getScalarByteSize(type) * 8;
+        switch( _getScalarKind(type) )
+        {
+        case ScalarKind::SignedInt:
+            operands.add(bits);
+            operands.add(1);
+            return emitTypeInst(SpvOpTypeInt, operands);
+        case ScalarKind::UnsignedInt:
+            operands.add(bits);
+            operands.add(0);
+            return emitTypeInst(SpvOpTypeInt, operands);
+        case ScalarKind::Float:
+            operands.add(bits);
+            return emitTypeInst(SpvOpTypeFloat, operands);
+        default:
+            return _unsupported(type, "type");
+        }
+    }
+
+    SpvInst* _emitType(IRType* type)
+    {
+        switch( type->op )
+        {
+        case kIROp_VoidType:
+        case kIROp_BoolType:
+        case kIROp_Int8Type:
+        case kIROp_Int16Type:
+        case kIROp_IntType:
+        case kIROp_Int64Type:
+        case kIROp_UInt8Type:
+        case kIROp_UInt16Type:
+        case kIROp_UIntType:
+        case kIROp_UInt64Type:
+        case kIROp_HalfType:
+        case kIROp_FloatType:
+        case kIROp_DoubleType:
+            return _emitScalarType(type);
+
+        case kIROp_VectorType:
+            {
+                // > OpTypeVector
+                //
+                // SPIR-V doesn't have single element vectors, so they
+                // are represented as scalars.
+                //
+                auto vectorType = static_cast<IRVectorType*>(type);
+                auto count = getIntVal(vectorType->getElementCount());
+                if( count == 1 )
+                    return getType(vectorType->getElementType());
+
+                List<SpvWord> operands;
+                operands.add(getID(getType(vectorType->getElementType())));
+                operands.add(SpvWord(count));
+                return emitTypeInst(SpvOpTypeVector, operands);
+            }
+
+        case kIROp_MatrixType:
+            {
+                // > OpTypeMatrix
+                //
+                // A Slang `matrix<T,R,C>` has `R` rows that each have `C`
+                // elements. As for GLSL output we treat the rows of the Slang
+                // matrix as the columns of the SPIR-V one, so indexing a
+                // matrix gives the same vector in both, and the meaning of
+                // row and column major layout is swapped.
+                //
+                auto matrixType = static_cast<IRMatrixType*>(type);
+                auto rowCount = getIntVal(matrixType->getRowCount());
+                auto columnCount = getIntVal(matrixType->getColumnCount());
+                if( rowCount < 2 || columnCount < 2 || _getScalarKind(matrixType->getElementType()) != ScalarKind::Float )
+                    return _unsupported(type, "matrix type");
+
+                List<SpvWord> operands;
+                operands.add(getID(getType(_getVectorType(matrixType->getElementType(), Index(columnCount)))));
+                operands.add(SpvWord(rowCount));
+                return emitTypeInst(SpvOpTypeMatrix, operands);
+            }
+
+        case kIROp_ArrayType:
+            {
+                // > OpTypeArray
+                //
+                // The length of an array is given by the <id> of a constant.
+                //
+                auto arrayType = static_cast<IRArrayType*>(type);
+                List<SpvWord> operands;
+                operands.add(getID(getType(arrayType->getElementType())));
+                operands.add(getID(getUIntConstant(SpvWord(getIntVal(arrayType->getElementCount())))));
+                return emitTypeInst(SpvOpTypeArray, operands);
+            }
+
+        case kIROp_UnsizedArrayType:
+            {
+                // > OpTypeRuntimeArray
+                auto arrayType = static_cast<IRUnsizedArrayType*>(type);
+                List<SpvWord> operands;
+                operands.add(getID(getType(arrayType->getElementType())));
+                return emitTypeInst(SpvOpTypeRuntimeArray, operands);
+            }
+
+        case kIROp_StructType:
+            return _emitStructType(static_cast<IRStructType*>(type));
+
+        case kIROp_PtrType:
+        case kIROp_RefType:
+        case kIROp_OutType:
+        case kIROp_InOutType:
+            {
+                // > OpTypePointer
+                //
+                // Pointers in SPIR-V include the storage class of what they point
+                // to. The only pointers that appear in IR *types* (rather than being
+                // produced by instructions that refer to some other storage) are
+                // the parameters of functions, which are in the `Function` storage
+                // class.
+                //
+                return getPointerType(getType(static_cast<IRPtrTypeBase*>(type)->getValueType()), SpvStorageClassFunction);
+            }
+
+        case kIROp_RateQualifiedType:
+            return getType(static_cast<IRRateQualifiedType*>(type)->getValueType());
+
+        case kIROp_TextureType:
+            return getImageType(static_cast<IRTextureType*>(type), nullptr);
+
+        case kIROp_TextureSamplerType:
+            {
+                // > OpTypeSampledImage
+                auto imageType = getImageType(static_cast<IRTextureSamplerType*>(type), nullptr);
+                return getSampledImageType(imageType);
+            }
+
+        case kIROp_SamplerStateType:
+        case kIROp_SamplerComparisonStateType:
+            // > OpTypeSampler
+            return emitTypeInst(SpvOpTypeSampler);
+
+        case kIROp_FuncType:
+            {
+                // > OpTypeFunction
+                //
+                // Both Slang and SPIR-V encode a function type
+                // with the result-type operand coming first,
+                // followed by operands for all the parameter types.
+                //
+                auto funcType = static_cast<IRFuncType*>(type);
+                List<SpvWord> operands;
+                operands.add(getID(getType(funcType->getResultType())));
+                for( UInt ii = 0; ii < funcType->getParamCount(); ++ii )
+                {
+                    operands.add(getID(getType(funcType->getParamType(ii))));
+                }
+                return emitTypeInst(SpvOpTypeFunction, operands);
+            }
+
+        default:
+            return _unsupported(type, "type");
+        }
+    }
+
+        /// Get a pointer type to `valueType` in `storageClass`
+    SpvInst* getPointerType(SpvInst* valueType, SpvStorageClass storageClass)
+    {
+        List<SpvWord> operands;
+        operands.add(SpvWord(storageClass));
+        operands.add(getID(valueType));
+        return emitTypeInst(SpvOpTypePointer, operands);
+    }
+
+    SpvInst* getPointerType(IRType* valueType, SpvStorageClass storageClass)
+    {
+        return getPointerType(getType(valueType), storageClass);
+    }
+
+        /// Get the sampled image type for `imageType`
+    SpvInst* getSampledImageType(SpvInst* imageType)
+    {
+        List<SpvWord> operands;
+        operands.add(getID(imageType));
+        return emitTypeInst(SpvOpTypeSampledImage, operands);
+    }
+
+    // A struct type is an aggregate, so two struct instructions with the
+    // same operands are different types. We emit one SPIR-V struct for
+    // each IR struct. Fields of type `void` (which are left behind where
+    // resource fields were legalized out) are skipped, so the index of
+    // a field in SPIR-V doesn't always match the IR.
+
+    SpvInst* _emitStructType(IRStructType* structType)
+    {
+        List<SpvWord> operands;
+        for( auto field : structType->getFields() )
+        {
+            auto fieldType = field->getFieldType();
+            if( fieldType->op == kIROp_VoidType )
+                continue;
+            operands.add(getID(getType(fieldType)));
+        }
+
+        auto spvStruct = emitInst(getSection(SpvLogicalSectionID::Types), nullptr, SpvOpTypeStruct, kResultID, OperandWords(operands));
+        emitNameForInst(spvStruct, structType);
+
+        SpvWord memberIndex = 0;
+        for( auto field : structType->getFields() )
+        {
+            if( field->getFieldType()->op == kIROp_VoidType )
+                continue;
+            if( auto nameHint = field->getKey()->findDecoration<IRNameHintDecoration>() )
+            {
+                emitInst(getSection(SpvLogicalSectionID::DebugNames), nullptr, SpvOpMemberName, spvStruct, memberIndex, nameHint->getName());
+            }
+            memberIndex++;
+        }
+        return spvStruct;
+    }
+
+        /// Get the SPIR-V member index of the field with `key` in `structType`, or -1 if not found
+    static Index _getFieldIndex(IRStructType* structType, IRInst* key)
+    {
+        Index index = 0;
+        for( auto field : structType->getFields() )
+        {
+            if( field->getKey() == key )
+                return (field->getFieldType()->op == kIROp_VoidType) ? -1 : index;
+            if( field->getFieldType()->op != kIROp_VoidType )
+                index++;
+        }
+        return -1;
+    }
+
+    // [3.32.6: Type-Declaration Instructions]
     //
-    // When emititng blobal instructions, we usually have to
-    // pick the right logical section to emit them into, while
-    // for local instructions they will usually emit into
-    // a known parent (the basic block that contains them).
+    // > OpTypeImage
+    //
+    // Texture types map to images. The image format isn't part of the
+    // Slang type, and is either given by a `[format(...)]` attribute on
+    // the variable, or inferred from the element type in the same way as
+    // is done when generating GLSL.
+
+        /// Image types that were declared with an unknown format
+    HashSet<SpvInst*> m_imageTypesWithUnknownFormat;
+
+    static SpvImageFormat _getSpvImageFormat(ImageFormat format)
+    {
+        switch( format )
+        {
+#define CASE(SLANG, SPV) case ImageFormat::SLANG: return SpvImageFormat##SPV
+        CASE(rgba32f, Rgba32f);
+        CASE(rgba16f, Rgba16f);
+        CASE(rg32f, Rg32f);
+        CASE(rg16f, Rg16f);
+        CASE(r11f_g11f_b10f, R11fG11fB10f);
+        CASE(r32f, R32f);
+        CASE(r16f, R16f);
+        CASE(rgba16, Rgba16);
+        CASE(rgb10_a2, Rgb10A2);
+        CASE(rgba8, Rgba8);
+        CASE(rg16, Rg16);
+        CASE(rg8, Rg8);
+        CASE(r16, R16);
+        CASE(r8, R8);
+        CASE(rgba16_snorm, Rgba16Snorm);
+        CASE(rgba8_snorm, Rgba8Snorm);
+        CASE(rg16_snorm, Rg16Snorm);
+        CASE(rg8_snorm, Rg8Snorm);
+        CASE(r16_snorm, R16Snorm);
+        CASE(r8_snorm, R8Snorm);
+        CASE(rgba32i, Rgba32i);
+        CASE(rgba16i, Rgba16i);
+        CASE(rgba8i, Rgba8i);
+        CASE(rg32i, Rg32i);
+        CASE(rg16i, Rg16i);
+        CASE(rg8i, Rg8i);
+        CASE(r32i, R32i);
+        CASE(r16i, R16i);
+        CASE(r8i, R8i);
+        CASE(rgba32ui, Rgba32ui);
+        CASE(rgba16ui, Rgba16ui);
+        CASE(rgb10_a2ui, Rgb10a2ui);
+        CASE(rgba8ui, Rgba8ui);
+        CASE(rg32ui, Rg32ui);
+        CASE(rg16ui, Rg16ui);
+        CASE(rg8ui, Rg8ui);
+        CASE(r32ui, R32ui);
+        CASE(r16ui, R16ui);
+        CASE(r8ui, R8ui);
+#undef CASE
+        default:
+            return SpvImageFormatUnknown;
+        }
+    }
+
+        /// Infer a format for a storage image from its element type
+    static SpvImageFormat _inferImageFormat(IRType* elementType)
+    {
+        Index count = 0;
+        auto scalarType = _getScalarType(elementType, count);
+        if( !scalarType )
+            return SpvImageFormatUnknown;
+
+        // As for GLSL output, 3 element types use a 4 element format.
+        //
+        const Index formatCount = (count == 1) ? 1 : ((count == 2) ? 2 : 4);
+        switch( scalarType->op )
+        {
+        case kIROp_HalfType:
+            return (formatCount == 1) ? SpvImageFormatR16f : ((formatCount == 2) ? SpvImageFormatRg16f : SpvImageFormatRgba16f);
+        case kIROp_UIntType:
+            return (formatCount == 1) ? SpvImageFormatR32ui : ((formatCount == 2) ? SpvImageFormatRg32ui : SpvImageFormatRgba32ui);
+        case kIROp_IntType:
+            return (formatCount == 1) ? SpvImageFormatR32i : ((formatCount == 2) ? SpvImageFormatRg32i : SpvImageFormatRgba32i);
+        case kIROp_FloatType:
+        default:
+            return (formatCount == 1) ? SpvImageFormatR32f : ((formatCount == 2) ? SpvImageFormatRg32f : SpvImageFormatRgba32f);
+        }
+    }
+
+        /// Get the image type for `textureType`, using the format from `var` if it has one
+    SpvInst* getImageType(IRTextureTypeBase* textureType, IRInst* var)
+    {
+        // The sampled type is the scalar type of the elements. There are no
+        // half images, so (as for GLSL) they are accessed as float.
+        //
+        auto scalarType = _getScalarType(textureType->getElementType());
+        if( !scalarType )
+            return _unsupported(textureType, "texture element type");
+        if( scalarType->op == kIROp_HalfType )
+            scalarType = m_builder.getBasicType(BaseType::Float);
+        const auto scalarKind = _getScalarKind(scalarType);
+        if( scalarKind == ScalarKind::Bool || _getScalarByteSize(scalarType) != 4 )
+            return _unsupported(textureType, "texture element type");
+
+        const bool isArray = textureType->isArray();
+        const bool isMultisample = textureType->isMultisample();
+
+        SpvWord sampled = 1;
+        switch( textureType->getAccess() )
+        {
+        case SLANG_RESOURCE_ACCESS_NONE:
+        case SLANG_RESOURCE_ACCESS_READ:
+            sampled = 1;
+            break;
+        case SLANG_RESOURCE_ACCESS_READ_WRITE:
+        case SLANG_RESOURCE_ACCESS_RASTER_ORDERED:
+            sampled = 2;
+            break;
+        default:
+            return _unsupported(textureType, "texture access");
+        }
+
+        SpvDim dim = SpvDim2D;
+        switch( textureType->GetBaseShape() )
+        {
+        case TextureFlavor::Shape::Shape1D:
+            dim = SpvDim1D;
+            requireCapability(sampled == 1 ? SpvCapabilitySampled1D : SpvCapabilityImage1D);
+            break;
+        case TextureFlavor::Shape::Shape2D:
+            dim = SpvDim2D;
+            break;
+        case TextureFlavor::Shape::Shape3D:
+            dim = SpvDim3D;
+            break;
+        case TextureFlavor::Shape::ShapeCube:
+            dim = SpvDimCube;
+            if( isArray )
+                requireCapability(sampled == 1 ? SpvCapabilitySampledCubeArray : SpvCapabilityImageCubeArray);
+            break;
+        case TextureFlavor::Shape::ShapeBuffer:
+            dim = SpvDimBuffer;
+            requireCapability(sampled == 1 ? SpvCapabilitySampledBuffer : SpvCapabilityImageBuffer);
+            break;
+        default:
+            return _unsupported(textureType, "texture shape");
+        }
+        if( isMultisample && isArray && sampled == 2 )
+            requireCapability(SpvCapabilityImageMSArray);
+
+        SpvImageFormat format = SpvImageFormatUnknown;
+        if( sampled == 2 )
+        {
+            IRFormatDecoration* formatDecoration = var ? var->findDecoration<IRFormatDecoration>() : nullptr;
+            if( formatDecoration )
+            {
+                format = _getSpvImageFormat(formatDecoration->getFormat());
+            }
+            else if( !m_useUnknownImageFormatAsDefault )
+            {
+                format = _inferImageFormat(textureType->getElementType());
+            }
+
+            switch( format )
+            {
+            case SpvImageFormatUnknown:
+            case SpvImageFormatRgba32f:
+            case SpvImageFormatRgba16f:
+            case SpvImageFormatR32f:
+            case SpvImageFormatRgba8:
+            case SpvImageFormatRgba8Snorm:
+            case SpvImageFormatRgba32i:
+            case SpvImageFormatRgba16i:
+            case SpvImageFormatRgba8i:
+            case SpvImageFormatR32i:
+            case SpvImageFormatRgba32ui:
+            case SpvImageFormatRgba16ui:
+            case SpvImageFormatRgba8ui:
+            case SpvImageFormatR32ui:
+                break;
+            default:
+                requireCapability(SpvCapabilityStorageImageExtendedFormats);
+                break;
+            }
+        }
+
+        List<SpvWord> operands;
+        operands.add(getID(getType(scalarType)));
+        operands.add(SpvWord(dim));
+        operands.add(0);
+        operands.add(isArray ? 1 : 0);
+        operands.add(isMultisample ? 1 : 0);
+        operands.add(sampled);
+        operands.add(SpvWord(format));
+        auto spvType = emitTypeInst(SpvOpTypeImage, operands);
+        if( sampled == 2 && format == SpvImageFormatUnknown )
+        {
+            m_imageTypesWithUnknownFormat.Add(spvType);
+        }
+        return spvType;
+    }
+
+        /// Set if storage images without a `[format(...)]` should have an unknown format
+    bool m_useUnknownImageFormatAsDefault = false;
+
+    // [3.32.7: Constant-Creation Instructions]
+
+    SpvInst* getIntConstant(IRType* type, IRIntegerValue value)
+    {
+        auto spvType = getType(type);
+        List<SpvWord> operands;
+        const auto byteSize = _getScalarByteSize(type);
+
+        // [2.2.1: Instructions]
+        //
+        // > Literal Number: ... If it is a signed integer type and the width is
+        // > narrower than 32 bits, the value is sign extended.
+        //
+        if( byteSize < 4 && _getScalarKind(type) == ScalarKind::SignedInt )
+        {
+            value = (byteSize == 1) ? IRIntegerValue(int8_t(value)) : IRIntegerValue(int16_t(value));
+            operands.add(SpvWord(uint32_t(int32_t(value))));
+        }
+        else if( byteSize < 4 )
+        {
+            value = (byteSize == 1) ? IRIntegerValue(uint8_t(value)) : IRIntegerValue(uint16_t(value));
+            operands.add(SpvWord(value));
+        }
+        else
+        {
+            // Values wider than 32 bits take multiple words, low-order first.
+            //
+            operands.add(SpvWord(uint64_t(value) & 0xffffffff));
+            if( byteSize > 4 )
+                operands.add(SpvWord(uint64_t(value) >> 32));
+        }
+        return emitConstantInst(SpvOpConstant, spvType, operands);
+    }
+
+    SpvInst* getIntConstant(int32_t value) { return getIntConstant(m_builder.getIntType(), value); }
+    SpvInst* getUIntConstant(SpvWord value) { return getIntConstant(m_builder.getUIntType(), value); }
+
+    SpvInst* getFloatConstant(IRType* type, IRFloatingPointValue value)
+    {
+        auto spvType = getType(type);
+        List<SpvWord> operands;
+        switch( type->op )
+        {
+        case kIROp_HalfType:
+            operands.add(SpvWord(FloatToHalf(float(value))));
+            break;
+        case kIROp_FloatType:
+            {
+                float floatValue = float(value);
+                SpvWord word;
+                memcpy(&word, &floatValue, sizeof(word));
+                operands.add(word);
+            }
+            break;
+        case kIROp_DoubleType:
+            {
+                uint64_t bits;
+                memcpy(&bits, &value, sizeof(bits));
+                operands.add(SpvWord(bits & 0xffffffff));
+                operands.add(SpvWord(bits >> 32));
+            }
+            break;
+        default:
+            return _unsupported(type, "floating point constant");
+        }
+        return emitConstantInst(SpvOpConstant, spvType, operands);
+    }
+
+    SpvInst* getBoolConstant(bool value)
+    {
+        List<SpvWord> operands;
+        return emitConstantInst(value ? SpvOpConstantTrue : SpvOpConstantFalse, getType(m_builder.getBoolType()), operands);
+    }
+
+        /// Get a constant of the scalar `type` with the given value
+    SpvInst* getScalarConstant(IRType* type, IRFloatingPointValue value)
+    {
+        switch( _getScalarKind(type) )
+        {
+        case ScalarKind::Bool:
+            return getBoolConstant(value != 0);
+        case ScalarKind::SignedInt:
+        case ScalarKind::UnsignedInt:
+            return getIntConstant(type, IRIntegerValue(value));
+        case ScalarKind::Float:
+            return getFloatConstant(type, value);
+        default:
+            return _unsupported(type, "constant");
+        }
+    }
+
+        /// Get a constant with every element set to `value`, of the scalar or vector `type`
+    SpvInst* getSplatConstant(IRType* type, IRFloatingPointValue value)
+    {
+        Index count = 0;
+        auto scalarType = _getScalarType(type, count);
+        if( !scalarType )
+            return _unsupported(type, "constant");
+        auto scalar = getScalarConstant(scalarType, value);
+        if( count == 1 )
+            return scalar;
+
+        List<SpvWord> operands;
+        for( Index ii = 0; ii < count; ++ii )
+            operands.add(getID(scalar));
+        return emitConstantInst(SpvOpConstantComposite, getType(type), operands);
+    }
+
+    SpvInst* getNullConstant(IRType* type)
+    {
+        List<SpvWord> operands;
+        return emitConstantInst(SpvOpConstantNull, getType(type), operands);
+    }
+
+        /// Get the SPIR-V constant for an IR literal
+    SpvInst* _emitLiteral(IRConstant* constant)
+    {
+        auto type = constant->getDataType();
+        switch( constant->op )
+        {
+        case kIROp_IntLit:
+            if( _getScalarKind(type) == ScalarKind::Float )
+                return getFloatConstant(type, IRFloatingPointValue(constant->value.intVal));
+            return getIntConstant(type, constant->value.intVal);
+        case kIROp_FloatLit:
+            return getFloatConstant(type, constant->value.floatVal);
+        case kIROp_BoolLit:
+            return getBoolConstant(constant->value.intVal != 0);
+        default:
+            return _unsupported(constant, "constant");
+        }
+    }
+
+        /// Try to emit the global-scope instruction `irInst` as a constant.
+        ///
+        /// Returns nullptr if it can't be represented as a constant.
+    SpvInst* _tryEmitConstant(IRInst* irInst)
+    {
+        SpvInst* spvInst = nullptr;
+        if( m_mapIRInstToSpvInst.TryGetValue(irInst, spvInst) )
+            return _isConstant(spvInst) ? spvInst : nullptr;
+
+        switch( irInst->op )
+        {
+        case kIROp_IntLit:
+        case kIROp_FloatLit:
+        case kIROp_BoolLit:
+            return _emitLiteral(static_cast<IRConstant*>(irInst));
+
+        case kIROp_GlobalConstant:
+            {
+                auto value = static_cast<IRGlobalConstant*>(irInst)->getValue();
+                return value ? _tryEmitConstant(value) : nullptr;
+            }
+
+        case kIROp_Construct:
+            {
+                // A conversion of a literal can be folded
+                //
+                auto type = irInst->getDataType();
+                if( irInst->getOperandCount() == 0 )
+                    return getNullConstant(type);
+                if( irInst->getOperandCount() != 1 || !_getScalarType(type) )
+                    return nullptr;
+                auto literal = as<IRConstant>(irInst->getOperand(0));
+                if( !literal || !_getScalarType(literal->getDataType()) || as<IRVectorType>(literal->getDataType()) )
+                    return nullptr;
+                return getSplatConstant(type, _getLiteralValue(literal));
+            }
+
+        case kIROp_constructVectorFromScalar:
+            {
+                auto literal = as<IRConstant>(irInst->getOperand(0));
+                if( !literal )
+                    return nullptr;
+                return getSplatConstant(irInst->getDataType(), _getLiteralValue(literal));
+            }
+
+        case kIROp_makeVector:
+        case kIROp_MakeMatrix:
+        case kIROp_makeArray:
+        case kIROp_makeStruct:
+            {
+                auto type = irInst->getDataType();
+                List<IRType*> elementTypes;
+                if( !_getCompositeElementTypes(type, elementTypes) )
+                    return nullptr;
+
+                // The operands of a matrix or vector can either be the
+                // elements, or (for a matrix) the scalars of all the elements.
+                //
+                List<IRInst*> operands;
+                for( UInt ii = 0; ii < irInst->getOperandCount(); ++ii )
+                {
+                    auto operand = irInst->getOperand(ii);
+                    if( operand->getDataType()->op == kIROp_VoidType )
+                        continue;
+                    operands.add(operand);
+                }
+                if( operands.getCount() != elementTypes.getCount() )
+                    return nullptr;
+
+                List<SpvWord> words;
+                for( Index ii = 0; ii < operands.getCount(); ++ii )
+                {
+                    SpvInst* element = nullptr;
+                    auto literal = as<IRConstant>(operands[ii]);
+                    if( literal && _getScalarType(elementTypes[ii]) && !as<IRVectorType>(literal->getDataType()) )
+                        element = getSplatConstant(elementTypes[ii], _getLiteralValue(literal));
+                    else
+                        element = _tryEmitConstant(operands[ii]);
+                    if( !element )
+                        return nullptr;
+                    words.add(getID(element));
+                }
+                return emitConstantInst(SpvOpConstantComposite, getType(type), words);
+            }
+
+        default:
+            return nullptr;
+        }
+    }
+
+    static IRFloatingPointValue _getLiteralValue(IRConstant* literal)
+    {
+        switch( literal->op )
+        {
+        case kIROp_FloatLit:
+            return literal->value.floatVal;
+        default:
+            return IRFloatingPointValue(literal->value.intVal);
+        }
+    }
+
+        /// Get the types of the elements of the composite `type` (in SPIR-V terms).
+    bool _getCompositeElementTypes(IRType* type, List<IRType*>& outTypes)
+    {
+        if( auto vectorType = as<IRVectorType>(type) )
+        {
+            auto count = getIntVal(vectorType->getElementCount());
+            for( IRIntegerValue ii = 0; ii < count; ++ii )
+                outTypes.add(vectorType->getElementType());
+            return count > 1;
+        }
+        if( auto matrixType = as<IRMatrixType>(type) )
+        {
+            auto rowType = _getVectorType(matrixType->getElementType(), Index(getIntVal(matrixType->getColumnCount())));
+            auto count = getIntVal(matrixType->getRowCount());
+            for( IRIntegerValue ii = 0; ii < count; ++ii )
+                outTypes.add(rowType);
+            return true;
+        }
+        if( auto arrayType = as<IRArrayType>(type) )
+        {
+            auto count = getIntVal(arrayType->getElementCount());
+            for( IRIntegerValue ii = 0; ii < count; ++ii )
+                outTypes.add(arrayType->getElementType());
+            return true;
+        }
+        if( auto structType = as<IRStructType>(type) )
+        {
+            for( auto field : structType->getFields() )
+            {
+                if( field->getFieldType()->op != kIROp_VoidType )
+                    outTypes.add(field->getFieldType());
+            }
+            return true;
+        }
+        return false;
+    }
+
+    // [2.16.2: Validation Rules for Shader Capabilities]
+    //
+    // > Composite objects in the StorageBuffer, PhysicalStorageBuffer,
+    // > Uniform, and PushConstant Storage Classes must be explicitly laid out.
+    //
+    // The offsets and strides of data in buffers are given by decorations.
+    // We compute them with the same rules that are used when GLSL is
+    // compiled: `std140` for uniform (constant) buffers, and `std430`
+    // for storage (structured and byte-address) buffers.
+
+    enum class LayoutRules
+    {
+        Std140,
+        Std430,
+    };
+
+    struct LayoutInfo
+    {
+        SpvWord size = 0;
+        SpvWord alignment = 1;
+    };
+
+    static SpvWord _roundUp(SpvWord value, SpvWord alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+        /// The rules used to decorate each struct type that has been laid out
+    Dictionary<SpvInst*, LayoutRules> m_structLayoutRules;
+        /// The stride each array type has been decorated with
+    Dictionary<SpvInst*, SpvWord> m_arrayStrides;
+
+        /// The default matrix layout, from the target
+    MatrixLayoutMode m_matrixLayoutMode = kMatrixLayoutMode_RowMajor;
+
+        /// Get the layout of the vector of `count` elements of `scalarType`
+    LayoutInfo _getVectorLayout(IRType* scalarType, Index count)
+    {
+        const SpvWord scalarSize = _getScalarByteSize(scalarType);
+        LayoutInfo info;
+        info.size = scalarSize * SpvWord(count);
+        info.alignment = scalarSize * ((count == 1) ? 1 : ((count == 2) ? 2 : 4));
+        return info;
+    }
+
+        /// Get the layout of a matrix, and the stride between its SPIR-V columns (or rows, if `outIsRowMajor`)
+    LayoutInfo _getMatrixLayout(IRMatrixType* matrixType, LayoutRules rules, SpvWord& outStride, bool& outIsRowMajor)
+    {
+        // A Slang matrix has its rows as the columns of the SPIR-V matrix
+        // (see `_emitType`), so a row-major layout in Slang terms is a
+        // column-major layout in SPIR-V terms.
+        //
+        outIsRowMajor = (m_matrixLayoutMode == kMatrixLayoutMode_ColumnMajor);
+
+        const Index rowCount = Index(getIntVal(matrixType->getRowCount()));
+        const Index columnCount = Index(getIntVal(matrixType->getColumnCount()));
+
+        // The matrix is laid out as an array of the vectors that are contiguous.
+        //
+        const Index vectorCount = outIsRowMajor ? columnCount : rowCount;
+        const Index vectorSize = outIsRowMajor ? rowCount : columnCount;
+
+        LayoutInfo vectorInfo = _getVectorLayout(matrixType->getElementType(), vectorSize);
+        SpvWord alignment = vectorInfo.alignment;
+        if( rules == LayoutRules::Std140 )
+            alignment = _roundUp(alignment, 16);
+
+        outStride = alignment;
+
+        LayoutInfo info;
+        info.alignment = alignment;
+        info.size = outStride * SpvWord(vectorCount);
+        return info;
+    }
+
+        /// Compute the layout of `type` with `rules`, and decorate any aggregate types within it with their layout.
+    LayoutInfo _layoutType(IRType* type, LayoutRules rules)
+    {
+        if( auto matrixType = as<IRMatrixType>(type) )
+        {
+            SpvWord stride;
+            bool isRowMajor;
+            return _getMatrixLayout(matrixType, rules, stride, isRowMajor);
+        }
+
+        if( auto arrayType = as<IRArrayTypeBase>(type) )
+        {
+            // [Vulkan 15.6.4: Offset and Stride Assignment]
+            //
+            // > An array has a base alignment equal to the base alignment of its element type,
+            // > rounded up to a multiple of 16 (std140 only).
+            //
+            LayoutInfo elementInfo = _layoutType(arrayType->getElementType(), rules);
+            SpvWord alignment = elementInfo.alignment;
+            if( rules == LayoutRules::Std140 )
+                alignment = _roundUp(alignment, 16);
+            const SpvWord stride = _roundUp(elementInfo.size, alignment);
+
+            auto spvType = getType(type);
+            SpvWord existingStride = 0;
+            if( m_arrayStrides.TryGetValue(spvType, existingStride) )
+            {
+                if( existingStride != stride )
+                    _unsupported(type, "array type used with different layouts");
+            }
+            else
+            {
+                m_arrayStrides.Add(spvType, stride);
+                emitDecoration(spvType, SpvDecorationArrayStride, stride);
+            }
+
+            LayoutInfo info;
+            info.alignment = alignment;
+            if( auto sizedArrayType = as<IRArrayType>(type) )
+                info.size = stride * SpvWord(getIntVal(sizedArrayType->getElementCount()));
+            return info;
+        }
+
+        if( auto structType = as<IRStructType>(type) )
+        {
+            return _layoutStructType(structType, rules);
+        }
+
+        Index count = 0;
+        if( auto scalarType = _getScalarType(type, count) )
+        {
+            // Types smaller than 32 bits need extra capabilities (and extensions
+            // before SPIR-V 1.3) to be used in buffers, and `bool` can't be used
+            // in them at all.
+            //
+            if( _getScalarByteSize(scalarType) < 4 || scalarType->op == kIROp_BoolType )
+            {
+                _unsupported(type, "type in buffer");
+                return LayoutInfo();
+            }
+            return _getVectorLayout(scalarType, count);
+        }
+
+        _unsupported(type, "type in buffer");
+        return LayoutInfo();
+    }
+
+    LayoutInfo _layoutStructType(IRStructType* structType, LayoutRules rules)
+    {
+        auto spvStruct = getType(structType);
+
+        // A struct can only be decorated once, so a struct that is used in both
+        // a uniform and a storage buffer (where the layouts differ) isn't supported.
+        //
+        LayoutRules existingRules;
+        const bool isDecorated = m_structLayoutRules.TryGetValue(spvStruct, existingRules);
+        if( isDecorated && existingRules != rules )
+        {
+            _unsupported(structType, "struct type used with different layouts");
+        }
+        else if( !isDecorated )
+        {
+            m_structLayoutRules.Add(spvStruct, rules);
+        }
+
+        LayoutInfo info;
+        SpvWord memberIndex = 0;
+        for( auto field : structType->getFields() )
+        {
+            auto fieldType = field->getFieldType();
+            if( fieldType->op == kIROp_VoidType )
+                continue;
+
+            LayoutInfo fieldInfo = _layoutType(fieldType, rules);
+            const SpvWord offset = _roundUp(info.size, fieldInfo.alignment);
+
+            if( !isDecorated )
+            {
+                emitMemberDecoration(spvStruct, memberIndex, SpvDecorationOffset, offset);
+
+                // Matrices (and arrays of them) are given their layout
+                // by decorations on the member.
+                //
+                IRType* elementType = fieldType;
+                while( auto arrayType = as<IRArrayTypeBase>(elementType) )
+                    elementType = arrayType->getElementType();
+                if( auto matrixType = as<IRMatrixType>(elementType) )
+                {
+                    SpvWord stride;
+                    bool isRowMajor;
+                    _getMatrixLayout(matrixType, rules, stride, isRowMajor);
+                    emitMemberDecoration(spvStruct, memberIndex, isRowMajor ? SpvDecorationRowMajor : SpvDecorationColMajor);
+                    emitMemberDecoration(spvStruct, memberIndex, SpvDecorationMatrixStride, stride);
+                }
+            }
+
+            info.size = offset + fieldInfo.size;
+            if( fieldInfo.alignment > info.alignment )
+                info.alignment = fieldInfo.alignment;
+            memberIndex++;
+        }
+
+        if( rules == LayoutRules::Std140 )
+            info.alignment = _roundUp(info.alignment, 16);
+        info.size = _roundUp(info.size, info.alignment);
+        return info;
+    }
+
+        /// Create a struct type that wraps `memberType`, for use as the type of a buffer (a "block").
+        ///
+        /// Unlike other types, these are never shared, so that decorating them can't affect other uses
+        /// of `memberType`.
+    SpvInst* _emitBlockType(SpvInst* memberType, SpvDecoration blockDecoration, bool isReadOnly)
+    {
+        auto spvStruct = emitInst(getSection(SpvLogicalSectionID::Types), nullptr, SpvOpTypeStruct, kResultID, memberType);
+        emitDecoration(spvStruct, blockDecoration);
+        emitMemberDecoration(spvStruct, 0, SpvDecorationOffset, 0);
+        if( isReadOnly )
+            emitMemberDecoration(spvStruct, 0, SpvDecorationNonWritable);
+        emitInst(getSection(SpvLogicalSectionID::DebugNames), nullptr, SpvOpMemberName, spvStruct, SpvWord(0), UnownedStringSlice::fromLiteral("_data"));
+        return spvStruct;
+    }
+
+    // Next, let's look at emitting some of the instructions
+    // that can occur at global scope.
+
+        /// Emit an instruction that is expected to appear at the global scope of the SPIR-V module.
+        ///
+        /// Returns the corresponding SPIR-V instruction.
+        ///
+    SpvInst* emitGlobalInst(IRInst* inst)
+    {
+        if( auto type = as<IRType>(inst) )
+        {
+            return getType(type);
+        }
+
+        switch( inst->op )
+        {
+        case kIROp_IntLit:
+        case kIROp_FloatLit:
+        case kIROp_BoolLit:
+            return _emitLiteral(static_cast<IRConstant*>(inst));
+
+        case kIROp_Func:
+            // [3.32.6: Function Instructions]
+            //
+            // > OpFunction
+            //
+            // Functions are complex enough that we'll handle
+            // them in a dedicated subroutine.
+            //
+            return emitFunc(as<IRFunc>(inst));
+
+        case kIROp_GlobalParam:
+            return emitGlobalParam(static_cast<IRGlobalParam*>(inst));
+
+        case kIROp_GlobalVar:
+            return emitGlobalVar(static_cast<IRGlobalVar*>(inst));
+
+        default:
+            {
+                // Anything else at global scope that we can handle
+                // must fold to a constant.
+                //
+                if( auto spvConstant = _tryEmitConstant(inst) )
+                    return spvConstant;
+                return _unsupported(inst, "global instruction");
+            }
+        }
+    }
+
+    // [3.32.8: Memory Instructions]
+    //
+    // > OpVariable
+    //
+    // Pointers in SPIR-V are typed with the storage class that they point
+    // into, so we need to know the storage class of any pointer value.
+    // We track it for each instruction that produces a pointer.
+
+    Dictionary<SpvInst*, SpvStorageClass> m_storageClasses;
+
+        /// Get the storage class of the pointer `spvPtr`
+    SpvStorageClass _getStorageClass(SpvInst* spvPtr)
+    {
+        SpvStorageClass storageClass = SpvStorageClassFunction;
+        m_storageClasses.TryGetValue(spvPtr, storageClass);
+        return storageClass;
+    }
+
+        /// Emit a global `OpVariable` of the type pointed to by `spvValueType` in `storageClass`
+    SpvInst* _emitGlobalVariable(IRInst* irInst, SpvInst* spvValueType, SpvStorageClass storageClass)
+    {
+        auto spvPtrType = getPointerType(spvValueType, storageClass);
+        auto spvVar = emitInst(getSection(SpvLogicalSectionID::GlobalVariables), nullptr, SpvOpVariable, spvPtrType, kResultID, storageClass);
+        m_storageClasses[spvVar] = storageClass;
+        if( irInst )
+            emitNameForInst(spvVar, irInst);
+        if( storageClass == SpvStorageClassInput || storageClass == SpvStorageClassOutput )
+            m_interfaceVars.add(spvVar);
+        return spvVar;
+    }
+
+        /// The `Input` and `Output` variables, which are the interface of the entry points
+    List<SpvInst*> m_interfaceVars;
+
+    // Some global parameters are not used directly as values in
+    // SPIR-V. For example a texture is an `OpVariable` in the
+    // `UniformConstant` storage class, and each use of the texture
+    // in the IR needs to load from it. We record how such parameters
+    // need to be *materialized* at the point of each use.
+
+    enum class MaterializeKind
+    {
+            /// Load from the variable
+        Load,
+            /// Get the address of the first member of the block variable
+        BlockMember,
+    };
+
+    struct MaterializeInfo
+    {
+        MaterializeKind kind;
+        SpvInst* spvVar = nullptr;
+        SpvInst* spvResultType = nullptr;
+        SpvStorageClass storageClass = SpvStorageClassFunction;
+    };
+
+    Dictionary<IRInst*, MaterializeInfo> m_materializeInfos;
+
+        /// The block that local instructions are currently being emitted to
+    SpvInst* m_currentBlock = nullptr;
+
+        /// Get the SPIR-V value of `irInst` for use as an operand in the current block
+    SpvInst* getValue(IRInst* irInst)
+    {
+        MaterializeInfo* info = m_materializeInfos.TryGetValue(irInst);
+        if( !info )
+        {
+            // Make sure that global parameters have had a chance to set up
+            // how they are materialized.
+            //
+            if( irInst->op == kIROp_GlobalParam && !m_mapIRInstToSpvInst.ContainsKey(irInst) )
+            {
+                ensureInst(irInst);
+                info = m_materializeInfos.TryGetValue(irInst);
+            }
+        }
+        if( !info )
+        {
+            return ensureInst(irInst);
+        }
+        if( !m_currentBlock )
+        {
+            return _unsupported(irInst, "use of parameter outside of a function");
+        }
+
+        switch( info->kind )
+        {
+        case MaterializeKind::Load:
+            return emitInst(m_currentBlock, nullptr, SpvOpLoad, info->spvResultType, kResultID, info->spvVar);
+        case MaterializeKind::BlockMember:
+            {
+                auto spvPtr = emitInst(m_currentBlock, nullptr, SpvOpAccessChain, info->spvResultType, kResultID, info->spvVar, getIntConstant(0));
+                m_storageClasses[spvPtr] = info->storageClass;
+                return spvPtr;
+            }
+        default:
+            return _unsupported(irInst, "parameter");
+        }
+    }
+
+        /// Get the layout of the IR variable or parameter `irInst`, if it has one
+    static IRVarLayout* _getVarLayout(IRInst* irInst)
+    {
+        auto layoutDecoration = irInst->findDecoration<IRLayoutDecoration>();
+        return layoutDecoration ? as<IRVarLayout>(layoutDecoration->getLayout()) : nullptr;
+    }
+
+    // A chain of variable layouts, from the innermost variable to the outermost,
+    // used for computing bindings, in the same way as for GLSL output.
+
+    struct VarLayoutChain
+    {
+        IRVarLayout* varLayout;
+        VarLayoutChain* next;
+    };
+
+    static UInt _getBindingOffset(VarLayoutChain* chain, LayoutResourceKind kind)
+    {
+        UInt offset = 0;
+        for( auto cc = chain; cc; cc = cc->next )
+        {
+            if( auto resInfo = cc->varLayout->findOffsetAttr(kind) )
+                offset += resInfo->getOffset();
+        }
+        return offset;
+    }
+
+    static UInt _getBindingSpace(VarLayoutChain* chain, LayoutResourceKind kind)
+    {
+        UInt space = 0;
+        for( auto cc = chain; cc; cc = cc->next )
+        {
+            if( auto resInfo = cc->varLayout->findOffsetAttr(kind) )
+                space += resInfo->getSpace();
+            if( auto resInfo = cc->varLayout->findOffsetAttr(LayoutResourceKind::RegisterSpace) )
+                space += resInfo->getOffset();
+        }
+        return space;
+    }
+
+        /// Decorate `spvVar` with the descriptor set and binding from `chain`
+    void _emitBindingDecorations(SpvInst* spvVar, VarLayoutChain* chain)
+    {
+        if( !chain || !chain->varLayout->findOffsetAttr(LayoutResourceKind::DescriptorTableSlot) )
+            return;
+        emitDecoration(spvVar, SpvDecorationDescriptorSet, SpvWord(_getBindingSpace(chain, LayoutResourceKind::DescriptorTableSlot)));
+        emitDecoration(spvVar, SpvDecorationBinding, SpvWord(_getBindingOffset(chain, LayoutResourceKind::DescriptorTableSlot)));
+    }
+
+    // [3.21: BuiltIn]
+    //
+    // The system-value semantics of entry point parameters are turned into
+    // GLSL builtin variables (e.g. `gl_GlobalInvocationID`) by an earlier
+    // pass, and are marked by an `[import(...)]` of their GLSL name.
+
+    struct BuiltinInfo
+    {
+        char const* name;
+        SpvBuiltIn builtin;
+        SpvCapability capability;
+    };
+
+    static BuiltinInfo const* _findBuiltin(UnownedStringSlice const& name)
+    {
+        // `SpvCapabilityShader` is used to mark builtins that don't need an extra capability.
+        static const BuiltinInfo kBuiltins[] =
+        {
+            { "gl_GlobalInvocationID",  SpvBuiltInGlobalInvocationId,   SpvCapabilityShader },
+            { "gl_LocalInvocationID",   SpvBuiltInLocalInvocationId,    SpvCapabilityShader },
+            { "gl_LocalInvocationIndex",SpvBuiltInLocalInvocationIndex, SpvCapabilityShader },
+            { "gl_WorkGroupID",         SpvBuiltInWorkgroupId,          SpvCapabilityShader },
+            { "gl_NumWorkGroups",       SpvBuiltInNumWorkgroups,        SpvCapabilityShader },
+            { "gl_VertexIndex",         SpvBuiltInVertexIndex,          SpvCapabilityShader },
+            { "gl_InstanceIndex",       SpvBuiltInInstanceIndex,        SpvCapabilityShader },
+            { "gl_Position",            SpvBuiltInPosition,             SpvCapabilityShader },
+            { "gl_PointSize",           SpvBuiltInPointSize,            SpvCapabilityShader },
+            { "gl_FragCoord",           SpvBuiltInFragCoord,            SpvCapabilityShader },
+            { "gl_FrontFacing",         SpvBuiltInFrontFacing,          SpvCapabilityShader },
+            { "gl_FragDepth",           SpvBuiltInFragDepth,            SpvCapabilityShader },
+            { "gl_PrimitiveID",         SpvBuiltInPrimitiveId,          SpvCapabilityGeometry },
+            { "gl_SampleID",            SpvBuiltInSampleId,             SpvCapabilitySampleRateShading },
+            { "gl_SamplePosition",      SpvBuiltInSamplePosition,       SpvCapabilitySampleRateShading },
+            { "gl_Layer",               SpvBuiltInLayer,                SpvCapabilityGeometry },
+            { "gl_ViewportIndex",       SpvBuiltInViewportIndex,        SpvCapabilityMultiViewport },
+        };
+        for( auto const& info : kBuiltins )
+        {
+            if( name == UnownedStringSlice(info.name) )
+                return &info;
+        }
+        return nullptr;
+    }
+
+        /// Set if `gl_FragDepth` is written, which requires the `DepthReplacing` execution mode
+    bool m_writesFragDepth = false;
+
+        /// Emit a global shader parameter (a resource, buffer or varying)
+    SpvInst* emitGlobalParam(IRGlobalParam* param)
+    {
+        auto type = param->getFullType();
+        auto varLayout = _getVarLayout(param);
+
+        VarLayoutChain varChain = { varLayout, nullptr };
+        VarLayoutChain* chain = varLayout ? &varChain : nullptr;
+
+        if( as<IRArrayTypeBase>(type) )
+        {
+            // Arrays of resources need the descriptor indexing rules (and
+            // non-uniform qualifiers) to be handled.
+            //
+            return _unsupported(param, "array of parameters");
+        }
+
+        if( auto groupType = as<IRUniformParameterGroupType>(type) )
+        {
+            // A constant buffer (or parameter block) is a `Block` variable in
+            // the `Uniform` storage class, wrapping the element type. The
+            // parameter is used in the IR as the address of the element.
+            //
+            // As for GLSL output, the binding comes from the layout of the
+            // container (the buffer itself), combined with the variable.
+            //
+            VarLayoutChain containerChain = varChain;
+            if( varLayout )
+            {
+                if( auto groupTypeLayout = as<IRParameterGroupTypeLayout>(varLayout->getTypeLayout()) )
+                {
+                    containerChain.varLayout = groupTypeLayout->getContainerVarLayout();
+                    containerChain.next = &varChain;
+                }
+            }
+
+            auto elementType = groupType->getElementType();
+            SpvStorageClass storageClass = SpvStorageClassUniform;
+            SpvDecoration blockDecoration = SpvDecorationBlock;
+            LayoutRules rules = LayoutRules::Std140;
+            if( varLayout && containerChain.varLayout->findOffsetAttr(LayoutResourceKind::PushConstantBuffer) )
+            {
+                storageClass = SpvStorageClassPushConstant;
+            }
+            else if( varLayout && containerChain.varLayout->findOffsetAttr(LayoutResourceKind::ShaderRecord) )
+            {
+                return _unsupported(param, "shader record");
+            }
+            else if( as<IRGLSLShaderStorageBufferType>(groupType) )
+            {
+                storageClass = _getStorageBufferStorageClass(blockDecoration);
+                rules = LayoutRules::Std430;
+            }
+            else if( !as<IRConstantBufferType>(groupType) && !as<IRParameterBlockType>(groupType) )
+            {
+                return _unsupported(param, "parameter group type");
+            }
+
+            auto spvElementType = getType(elementType);
+            _layoutType(elementType, rules);
+            auto spvBlockType = _emitBlockType(spvElementType, blockDecoration, false);
+            auto spvVar = _emitGlobalVariable(param, spvBlockType, storageClass);
+            if( storageClass != SpvStorageClassPushConstant )
+                _emitBindingDecorations(spvVar, &containerChain);
+
+            MaterializeInfo info;
+            info.kind = MaterializeKind::BlockMember;
+            info.spvVar = spvVar;
+            info.spvResultType = getPointerType(spvElementType, storageClass);
+            info.storageClass = storageClass;
+            m_materializeInfos.Add(param, info);
+            return spvVar;
+        }
+
+        if( auto structuredBufferType = as<IRHLSLStructuredBufferTypeBase>(type) )
+        {
+            // A structured buffer is a storage buffer that wraps a runtime
+            // array of its elements. Uses of the buffer in the IR access the
+            // array as `_data` (just like the generated GLSL), so the parameter
+            // is the variable itself.
+            //
+            switch( type->op )
+            {
+            case kIROp_HLSLStructuredBufferType:
+            case kIROp_HLSLRWStructuredBufferType:
+            case kIROp_HLSLRasterizerOrderedStructuredBufferType:
+                break;
+            default:
+                return _unsupported(param, "structured buffer type");
+            }
+
+            auto elementType = structuredBufferType->getElementType();
+            IRType* arrayType = m_builder.getUnsizedArrayType(elementType);
+            return _emitStorageBuffer(param, arrayType, as<IRHLSLStructuredBufferType>(type) != nullptr, chain);
+        }
+
+        if( as<IRByteAddressBufferTypeBase>(type) )
+        {
+            // A byte-address buffer is handled like a structured buffer of `uint`.
+            //
+            IRType* arrayType = m_builder.getUnsizedArrayType(m_builder.getUIntType());
+            return _emitStorageBuffer(param, arrayType, as<IRHLSLByteAddressBufferType>(type) != nullptr, chain);
+        }
+
+        if( as<IRTextureTypeBase>(type) || as<IRSamplerStateTypeBase>(type) )
+        {
+            // Textures and samplers are opaque values in the `UniformConstant`
+            // storage class, and are loaded where they are used.
+            //
+            if( type->op == kIROp_SamplerComparisonStateType )
+                return _unsupported(param, "comparison sampler");
+
+            SpvInst* spvType = nullptr;
+            if( auto textureType = as<IRTextureType>(type) )
+            {
+                spvType = getImageType(textureType, param);
+            }
+            else
+            {
+                spvType = getType(type);
+            }
+
+            auto spvVar = _emitGlobalVariable(param, spvType, SpvStorageClassUniformConstant);
+            _emitBindingDecorations(spvVar, chain);
+
+            MaterializeInfo info;
+            info.kind = MaterializeKind::Load;
+            info.spvVar = spvVar;
+            info.spvResultType = spvType;
+            info.storageClass = SpvStorageClassUniformConstant;
+            m_materializeInfos.Add(param, info);
+            return spvVar;
+        }
+
+        // What remains are varying inputs and outputs (including builtins).
+        // Outputs have an `Out<T>` type, and are used as pointers, while
+        // inputs are values.
+        //
+        const bool isOutput = as<IROutTypeBase>(type) != nullptr;
+        auto valueType = isOutput ? static_cast<IROutTypeBase*>(type)->getValueType() : type;
+        const SpvStorageClass storageClass = isOutput ? SpvStorageClassOutput : SpvStorageClassInput;
+
+        const LayoutResourceKind varyingKind = isOutput ? LayoutResourceKind::VaryingOutput : LayoutResourceKind::VaryingInput;
+        auto importDecoration = param->findDecoration<IRImportDecoration>();
+        BuiltinInfo const* builtin = nullptr;
+        if( importDecoration )
+        {
+            builtin = _findBuiltin(importDecoration->getMangledName());
+            if( !builtin )
+                return _unsupported(param, "builtin variable");
+        }
+        else if( !varLayout || !varLayout->findOffsetAttr(varyingKind) )
+        {
+            return _unsupported(param, "parameter");
+        }
+
+        if( as<IRStructType>(valueType) || as<IRArrayTypeBase>(valueType) || as<IRMatrixType>(valueType) )
+        {
+            // Aggregate varyings take up multiple locations.
+            //
+            return _unsupported(param, "aggregate varying");
+        }
+        if( _getScalarKind(_getScalarType(valueType)) == ScalarKind::Bool && !builtin )
+        {
+            return _unsupported(param, "bool varying");
+        }
+
+        auto spvValueType = getType(valueType);
+        auto spvVar = _emitGlobalVariable(param, spvValueType, storageClass);
+
+        if( builtin )
+        {
+            requireCapability(builtin->capability);
+            emitDecoration(spvVar, SpvDecorationBuiltIn, SpvWord(builtin->builtin));
+            if( builtin->builtin == SpvBuiltInFragDepth )
+                m_writesFragDepth = true;
+        }
+        else
+        {
+            // [3.20: Decoration]
+            //
+            // > Location: Apply to a variable or a structure-type member to establish
+            // > locations used in user-defined varying variables.
+            //
+            // As for GLSL output, the "space" of a fragment output is its index
+            // (for dual-source blending).
+            //
+            auto offsetAttr = varLayout->findOffsetAttr(varyingKind);
+            emitDecoration(spvVar, SpvDecorationLocation, SpvWord(offsetAttr->getOffset()));
+            if( offsetAttr->getSpace() )
+                emitDecoration(spvVar, SpvDecorationIndex, SpvWord(offsetAttr->getSpace()));
+
+            _emitInterpolationDecorations(param, spvVar, valueType, isOutput);
+        }
+
+        if( isOutput )
+        {
+            m_storageClasses[spvVar] = storageClass;
+        }
+        else
+        {
+            MaterializeInfo info;
+            info.kind = MaterializeKind::Load;
+            info.spvVar = spvVar;
+            info.spvResultType = spvValueType;
+            info.storageClass = storageClass;
+            m_materializeInfos.Add(param, info);
+        }
+        return spvVar;
+    }
+
+        /// The entry point stage being emitted, used to decide on interpolation decorations
+    Stage m_stage = Stage::Unknown;
+
+    void _emitInterpolationDecorations(IRInst* param, SpvInst* spvVar, IRType* valueType, bool isOutput)
+    {
+        // [Vulkan 15.1.4: Interpolation Decorations]
+        //
+        // Integer inputs to a fragment shader must be `Flat`.
+        //
+        const bool isFragmentInput = (m_stage == Stage::Fragment && !isOutput);
+        bool isFlat = false;
+        if( isFragmentInput )
+        {
+            const auto kind = _getScalarKind(_getScalarType(valueType));
+            isFlat = (kind == ScalarKind::SignedInt || kind == ScalarKind::UnsignedInt || _getScalarType(valueType)->op == kIROp_DoubleType);
+        }
+
+        // Interpolation modes only apply to the inputs of fragment shaders
+        // and the outputs of the previous stage.
+        //
+        if( isFragmentInput || (isOutput && m_stage != Stage::Fragment) )
+        {
+            for( auto decoration : param->getDecorations() )
+            {
+                auto modeDecoration = as<IRInterpolationModeDecoration>(decoration);
+                if( !modeDecoration )
+                    continue;
+                switch( modeDecoration->getMode() )
+                {
+                case IRInterpolationMode::NoInterpolation:
+                    isFlat = true;
+                    break;
+                case IRInterpolationMode::NoPerspective:
+                    emitDecoration(spvVar, SpvDecorationNoPerspective);
+                    break;
+                case IRInterpolationMode::Centroid:
+                    emitDecoration(spvVar, SpvDecorationCentroid);
+                    break;
+                case IRInterpolationMode::Sample:
+                    requireCapability(SpvCapabilitySampleRateShading);
+                    emitDecoration(spvVar, SpvDecorationSample);
+                    break;
+                default:
+                    break;
+                }
+            }
+        }
+
+        if( isFlat )
+        {
+            emitDecoration(spvVar, SpvDecorationFlat);
+        }
+    }
+
+        /// The SPIR-V version being targeted, as `0x00MMmm00`
+    SpvWord m_spirvVersion = 0x00010000;
+
+        /// Get the storage class (and block decoration) for storage buffers
+    SpvStorageClass _getStorageBufferStorageClass(SpvDecoration& outBlockDecoration)
+    {
+        // [3.7: Storage Class]
+        //
+        // > StorageBuffer: Shared externally, readable and writable, visible across
+        // > all functions in all invocations in a workgroup. Graphics storage buffers
+        // > (buffer blocks). Missing before version 1.3.
+        //
+        // Before SPIR-V 1.3, storage buffers are `BufferBlock`s in the `Uniform`
+        // storage class (as produced by glslang).
+        //
+        if( m_spirvVersion >= 0x00010300 )
+        {
+            outBlockDecoration = SpvDecorationBlock;
+            return SpvStorageClassStorageBuffer;
+        }
+        outBlockDecoration = SpvDecorationBufferBlock;
+        return SpvStorageClassUniform;
+    }
+
+    SpvInst* _emitStorageBuffer(IRGlobalParam* param, IRType* arrayType, bool isReadOnly, VarLayoutChain* chain)
+    {
+        SpvDecoration blockDecoration;
+        const SpvStorageClass storageClass = _getStorageBufferStorageClass(blockDecoration);
+
+        auto spvArrayType = getType(arrayType);
+        _layoutType(arrayType, LayoutRules::Std430);
+        auto spvBlockType = _emitBlockType(spvArrayType, blockDecoration, isReadOnly);
+        auto spvVar = _emitGlobalVariable(param, spvBlockType, storageClass);
+        _emitBindingDecorations(spvVar, chain);
+
+        // The IR uses the buffer's `_data` member, which (for a variable
+        // of the block type) is a pointer to the runtime array.
+        //
+        m_storageBufferArrayTypes[spvVar] = arrayType;
+        return spvVar;
+    }
+
+        /// For each storage buffer variable, the IR type of the array it holds
+    Dictionary<SpvInst*, IRType*> m_storageBufferArrayTypes;
+
+        /// Emit a global variable (in the `Private` or `Workgroup` storage class)
+    SpvInst* emitGlobalVar(IRGlobalVar* globalVar)
+    {
+        auto type = globalVar->getFullType();
+        SpvStorageClass storageClass = SpvStorageClassPrivate;
+        if( auto rateType = as<IRRateQualifiedType>(type) )
+        {
+            if( rateType->getRate()->op != kIROp_GroupSharedRate )
+                return _unsupported(globalVar, "rate of global variable");
+            storageClass = SpvStorageClassWorkgroup;
+            type = rateType->getValueType();
+        }
+        auto ptrType = as<IRPtrTypeBase>(type);
+        if( !ptrType )
+            return _unsupported(globalVar, "global variable type");
+
+        // An initializer is code that computes the initial value. We only
+        // handle initializers that fold to a constant, which can be given
+        // directly as an operand to `OpVariable`.
+        //
+        SpvInst* spvInitializer = nullptr;
+        if( auto firstBlock = globalVar->getFirstBlock() )
+        {
+            auto returnInst = as<IRReturnVal>(firstBlock->getTerminator());
+            if( firstBlock->getNextBlock() || !returnInst || firstBlock->getFirstOrdinaryInst() != returnInst )
+                return _unsupported(globalVar, "global variable initializer");
+            spvInitializer = _tryEmitConstant(returnInst->getVal());
+            if( !spvInitializer )
+                return _unsupported(globalVar, "global variable initializer");
+        }
+
+        auto spvPtrType = getPointerType(ptrType->getValueType(), storageClass);
+        SpvInst* spvVar = nullptr;
+        if( spvInitializer )
+            spvVar = emitInst(getSection(SpvLogicalSectionID::GlobalVariables), nullptr, SpvOpVariable, spvPtrType, kResultID, storageClass, spvInitializer);
+        else
+            spvVar = emitInst(getSection(SpvLogicalSectionID::GlobalVariables), nullptr, SpvOpVariable, spvPtrType, kResultID, storageClass);
+        m_storageClasses[spvVar] = storageClass;
+        emitNameForInst(spvVar, globalVar);
+        return spvVar;
+    }
+
+        /// Emit the given `irFunc` to SPIR-V
+    SpvInst* emitFunc(IRFunc* irFunc)
+    {
+        // [2.4: Logical Layout of a Module]
+        //
+        // > All function declarations ("declarations" are functions
+        // > without a body; there is no forward declaration to a
+        // > function with a body).
+        // > ...
+        // > All function definitions (functions with a body).
+        //
+        // We expect to deal only with fully linked modules, where
+        // any function without a body is a target intrinsic that
+        // is expanded at its call sites (see `emitCall`), so only
+        // definitions are emitted.
+        //
+        if( !isDefinition(irFunc) )
+        {
+            return _unsupported(irFunc, "function without a definition");
+        }
+        return emitFuncDefinition(irFunc);
+    }
+
+        /// Functions whose body has yet to be emitted
+    List<IRFunc*> m_funcsToEmit;
+
+        /// Emit a SPIR-V function definition for the Slang IR function `irFunc`.
+        ///
+        /// The body of the function is emitted later, by `emitPendingFuncBodies`.
+    SpvInst* emitFuncDefinition(IRFunc* irFunc)
+    {
+        // [2.4: Logical Layout of a Module]
+        //
+        // > All function definitions (functions with a body).
+        //
+        auto section = getSection(SpvLogicalSectionID::FunctionDefinitions);
+        //
+        // > A function definition is as follows.
+        // > * Function definition, using OpFunction.
+        // > * Function parameter declarations, using OpFunctionParameter.
+        // > * Block
+        // > * Block
+        // > * ...
+        // > * Function end, using OpFunctionEnd.
+        //
+
+        // [3.24. Function Control]
+        //
+        // TODO: We should eventually support emitting the "function control"
+        // mask to include inline and other hint bits based on decorations
+        // set on `irFunc`.
+        //
+        SpvFunctionControlMask spvFunctionControl = SpvFunctionControlMaskNone;
+
+        // [3.32.9. Function Instructions]
+        //
+        // > OpFunction
+        //
+        // Note that the type <id> of a SPIR-V function uses the
+        // *result* type of the function, while the actual function
+        // type is given as a later operand. Slang IR instead uses
+        // the type of a function instruction store, you know, its *type*.
+        //
+        // The function is registered before any of its operands are
+        // emitted, so that recursive references will find it.
+        //
+        auto spvResultType = getType(irFunc->getDataType()->getResultType());
+        auto spvFuncType = getType(irFunc->getDataType());
+        SpvInst* spvFunc = emitInst(section, irFunc, SpvOpFunction,
+            spvResultType,
+            kResultID,
+            spvFunctionControl,
+            spvFuncType);
+        emitNameForInst(spvFunc, irFunc);
+
+        // > OpFunctionParameter
+        //
+        // Unlike Slang, where parameters always belong to blocks,
+        // the parameters of a SPIR-V function must appear as direct
+        // children of the function instruction, and before any basic blocks.
+        //
+        for( auto irParam : irFunc->getParams() )
+        {
+            auto paramType = irParam->getFullType();
+            if( as<IRUniformParameterGroupType>(paramType) || as<IRResourceTypeBase>(paramType) ||
+                as<IRHLSLStructuredBufferTypeBase>(paramType) || as<IRByteAddressBufferTypeBase>(paramType) )
+            {
+                // Buffers and resources are used through their variables,
+                // and can't be passed as parameters.
+                //
+                _unsupported(irParam, "resource parameter");
+            }
+            auto spvParam = emitInst(spvFunc, irParam, SpvOpFunctionParameter,
+                getType(paramType),
+                kResultID);
+            emitNameForInst(spvParam, irParam);
+        }
+
+        m_funcsToEmit.add(irFunc);
+        return spvFunc;
+    }
+
+        /// Emit the bodies of all functions that have been referenced, including any that they reference
+    void emitPendingFuncBodies()
+    {
+        for( Index ii = 0; ii < m_funcsToEmit.getCount(); ++ii )
+        {
+            emitFuncBody(m_funcsToEmit[ii]);
+        }
+        m_funcsToEmit.clear();
+    }
+
+    // [2.11: Structured Control Flow]
+    //
+    // SPIR-V for shaders must use structured control flow, where each
+    // loop and selection is headed by a block that names its merge
+    // block (and, for a loop, its continue target). The Slang IR
+    // preserves that structure in its `loop`, `ifElse` and `switch`
+    // instructions, but some adjustments are needed:
+    //
+    // * The header of a loop must contain an `OpLoopMerge` just before its
+    //   terminator, and the IR loop's target block may also be the header of
+    //   a selection. Each loop target block is split in two: a header with
+    //   only the `OpPhi`s, `OpLoopMerge` and a branch, followed by the body.
+    //
+    // * The IR often uses the loop target block as the continue block. In
+    //   SPIR-V the back edge must come from a block that post-dominates the
+    //   continue target, which doesn't hold for a loop with a `break`, so in
+    //   that case we add a continue block that branches back to the header,
+    //   and make `continue`s go to it.
+
+    struct LoopInfo
+    {
+            /// The label of the loop header (the first half of the IR target block)
+        SpvInst* spvHeader = nullptr;
+            /// The label for the rest of the target block
+        SpvInst* spvBody = nullptr;
+            /// The added continue block, if the IR loop continues at its target
+        SpvInst* spvContinue = nullptr;
+            /// The IR loop instruction
+        IRLoop* irLoop = nullptr;
+    };
+
+        /// Information about loops, keyed by their target block
+    Dictionary<IRBlock*, LoopInfo> m_loops;
+
+        /// The labels of blocks that are the merge or continue target of a loop
+    HashSet<SpvInst*> m_loopExitLabels;
+
+        /// The `OpPhi` instructions of each block
+    Dictionary<SpvInst*, List<SpvInst*>> m_phis;
+
+    struct PhiEdge
+    {
+        SpvInst* spvPhi;
+        SpvWord valueID;
+        SpvWord fromLabelID;
+    };
+
+        /// The incoming values of `OpPhi`s, added as branches are emitted
+    List<PhiEdge> m_phiEdges;
+
+        /// The `OpVariable`s of the current function, which are placed at the start of the first block
+    SpvInstParent m_functionVars;
+
+        /// Get the label of `irBlock`
+    SpvInst* _getLabel(IRBlock* irBlock)
+    {
+        SpvInst* spvLabel = nullptr;
+        m_mapIRInstToSpvInst.TryGetValue(irBlock, spvLabel);
+        SLANG_ASSERT(spvLabel);
+        return spvLabel;
+    }
+
+        /// Get the label that a branch to `irBlock` should target.
+    SpvInst* _getBranchTarget(IRBlock* irBlock)
+    {
+        if( auto loopInfo = m_loops.TryGetValue(irBlock) )
+        {
+            if( loopInfo->spvContinue )
+                return loopInfo->spvContinue;
+        }
+        return _getLabel(irBlock);
+    }
+
+        /// Compute the order to emit the blocks of `irFunc` in.
+        ///
+        /// [2.16.1: Universal Validation Rules]
+        ///
+        /// > The order of blocks in a function must satisfy the rule that blocks
+        /// > appear before all blocks they dominate.
+        ///
+        /// A reverse post-order of the control flow graph satisfies this. The
+        /// merge and continue blocks of structured control flow are included
+        /// (as if they were successors of their header), since they must exist
+        /// even if they can't be reached.
+    static void _getBlockOrder(IRFunc* irFunc, List<IRBlock*>& outBlocks)
+    {
+        HashSet<IRBlock*> visited;
+        List<IRBlock*> postOrder;
+
+        struct Entry
+        {
+            IRBlock* block;
+            List<IRBlock*> successors;
+            Index next;
+        };
+        List<Entry> stack;
+
+        auto pushBlock = [&](IRBlock* block)
+        {
+            visited.Add(block);
+            Entry entry;
+            entry.block = block;
+            entry.next = 0;
+            _getStructuredSuccessors(block, entry.successors);
+            stack.add(entry);
+        };
+
+        pushBlock(irFunc->getFirstBlock());
+        while( stack.getCount() )
+        {
+            auto& entry = stack.getLast();
+            if( entry.next < entry.successors.getCount() )
+            {
+                // Successors are visited in reverse, so that the reverse post-order
+                // has them in their original order where possible.
+                //
+                auto successor = entry.successors[entry.successors.getCount() - 1 - entry.next];
+                entry.next++;
+                if( !visited.Contains(successor) )
+                    pushBlock(successor);
+            }
+            else
+            {
+                postOrder.add(entry.block);
+                stack.removeLast();
+            }
+        }
+
+        for( Index ii = postOrder.getCount() - 1; ii >= 0; --ii )
+            outBlocks.add(postOrder[ii]);
+    }
+
+    static void _getStructuredSuccessors(IRBlock* block, List<IRBlock*>& outSuccessors)
+    {
+        auto terminator = block->getTerminator();
+        switch( terminator->op )
+        {
+        case kIROp_unconditionalBranch:
+            outSuccessors.add(static_cast<IRUnconditionalBranch*>(terminator)->getTargetBlock());
+            break;
+        case kIROp_loop:
+            {
+                // The body must be visited first, so that the branch from
+                // the continue block back to the header is seen as a back
+                // edge, and the continue block is ordered after the body.
+                //
+                auto loop = static_cast<IRLoop*>(terminator);
+                outSuccessors.add(loop->getBreakBlock());
+                outSuccessors.add(loop->getContinueBlock());
+                outSuccessors.add(loop->getTargetBlock());
+            }
+            break;
+        case kIROp_conditionalBranch:
+            {
+                auto branch = static_cast<IRConditionalBranch*>(terminator);
+                outSuccessors.add(branch->getTrueBlock());
+                outSuccessors.add(branch->getFalseBlock());
+            }
+            break;
+        case kIROp_ifElse:
+            {
+                auto ifElse = static_cast<IRIfElse*>(terminator);
+                outSuccessors.add(ifElse->getTrueBlock());
+                outSuccessors.add(ifElse->getFalseBlock());
+                outSuccessors.add(ifElse->getAfterBlock());
+            }
+            break;
+        case kIROp_Switch:
+            {
+                auto switchInst = static_cast<IRSwitch*>(terminator);
+                for( UInt ii = 0; ii < switchInst->getCaseCount(); ++ii )
+                    outSuccessors.add(switchInst->getCaseLabel(ii));
+                if( auto defaultLabel = switchInst->getDefaultLabel() )
+                    outSuccessors.add(defaultLabel);
+                outSuccessors.add(switchInst->getBreakLabel());
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+        /// Emit the body of the function `irFunc`
+    void emitFuncBody(IRFunc* irFunc)
+    {
+        SpvInst* spvFunc = _getLabelOrFunc(irFunc);
+
+        List<IRBlock*> blocks;
+        _getBlockOrder(irFunc, blocks);
+
+        // [3.32.17. Control-Flow Instructions]
+        //
+        // > OpLabel
+        //
+        // A Slang `IRBlock` corresponds to a SPIR-V `OpLabel`:
+        // each represents a basic block in the control flow
+        // graph of a parent function.
+        //
+        // We will allocate SPIR-V instructions to represent
+        // all of the blocks in a function before we emit
+        // body instructions into any of them. We do this
+        // because it is possible for one block to make
+        // forward reference to another (wheras that is
+        // not possible for ordinary instructions within
+        // the blocks in the Slang IR)
+        //
+        m_loops.Clear();
+        m_loopExitLabels.Clear();
+        m_phis.Clear();
+        m_phiEdges.clear();
+        for( auto irBlock : blocks )
+        {
+            registerInst(irBlock, createInstWithResult(SpvOpLabel));
+        }
+        List<SpvInst*> continueLabels;
+        for( auto irBlock : blocks )
+        {
+            auto terminator = irBlock->getTerminator();
+            if( terminator->op != kIROp_loop )
+                continue;
+
+            auto irLoop = static_cast<IRLoop*>(terminator);
+            auto target = irLoop->getTargetBlock();
+            if( m_loops.ContainsKey(target) )
+            {
+                _unsupported(irLoop, "block that is the target of multiple loops");
+                continue;
+            }
+
+            LoopInfo info;
+            info.irLoop = irLoop;
+            info.spvHeader = _getLabel(target);
+            info.spvBody = createInstWithResult(SpvOpLabel);
+            if( irLoop->getContinueBlock() == target )
+            {
+                info.spvContinue = createInstWithResult(SpvOpLabel);
+                continueLabels.add(info.spvContinue);
+                m_loopExitLabels.Add(info.spvContinue);
+            }
+            else
+            {
+                m_loopExitLabels.Add(_getLabel(irLoop->getContinueBlock()));
+            }
+            m_loopExitLabels.Add(_getLabel(irLoop->getBreakBlock()));
+            m_loops.Add(target, info);
+        }
+
+        // The `OpPhi`s of each block correspond to the block's parameters.
+        // The parameters of the first block are those of the function,
+        // which were emitted with the function.
+        //
+        for( Index ii = 1; ii < blocks.getCount(); ++ii )
+        {
+            auto irBlock = blocks[ii];
+            auto spvLabel = _getLabel(irBlock);
+            List<SpvInst*> phis;
+            for( auto irParam : irBlock->getParams() )
+            {
+                auto spvPhi = emitInst(spvLabel, irParam, SpvOpPhi, getType(irParam->getFullType()), kResultID);
+                emitNameForInst(spvPhi, irParam);
+                phis.add(spvPhi);
+            }
+            m_phis.Add(spvLabel, phis);
+        }
+
+        // An added continue block takes the values passed to the loop target by
+        // `continue`s as its own `OpPhi`s, and passes them on to the header.
+        //
+        for( auto& pair : m_loops )
+        {
+            auto& info = pair.Value;
+            if( !info.spvContinue )
+                continue;
+            List<SpvInst*> phis;
+            List<SpvWord> args;
+            for( auto irParam : pair.Key->getParams() )
+            {
+                auto spvPhi = emitInst(info.spvContinue, nullptr, SpvOpPhi, getType(irParam->getFullType()), kResultID);
+                phis.add(spvPhi);
+                args.add(getID(spvPhi));
+            }
+            m_phis.Add(info.spvContinue, phis);
+            emitInst(info.spvContinue, nullptr, SpvOpBranch, info.spvHeader);
+            _addPhiEdges(info.spvHeader, info.spvContinue, args);
+        }
+
+        for( auto irBlock : blocks )
+        {
+            auto spvLabel = _getLabel(irBlock);
+            spvFunc->addInst(spvLabel);
+            m_currentBlock = spvLabel;
+
+            if( auto loopInfo = m_loops.TryGetValue(irBlock) )
+            {
+                // [3.32.17. Control-Flow Instructions]
+                //
+                // > OpLoopMerge
+                // > This instruction must immediately precede either an OpBranch or
+                // > OpBranchConditional instruction.
+                //
+                SpvInst* spvContinue = loopInfo->spvContinue ? loopInfo->spvContinue : _getLabel(loopInfo->irLoop->getContinueBlock());
+                emitInst(spvLabel, nullptr, SpvOpLoopMerge, _getLabel(loopInfo->irLoop->getBreakBlock()), spvContinue, SpvLoopControlMaskNone);
+                emitInst(spvLabel, nullptr, SpvOpBranch, loopInfo->spvBody);
+
+                spvFunc->addInst(loopInfo->spvBody);
+                m_currentBlock = loopInfo->spvBody;
+            }
+
+            for( auto irInst : irBlock->getOrdinaryInsts() )
+            {
+                // Any instructions local to the block will be emitted as children
+                // of the block.
+                //
+                emitLocalInst(irInst);
+            }
+        }
+        for( auto spvContinue : continueLabels )
+        {
+            spvFunc->addInst(spvContinue);
+        }
+        m_currentBlock = nullptr;
+
+        // [2.4: Logical Layout of a Module]
+        //
+        // > All OpVariable instructions in a function must be the first instructions in the first block.
+        //
+        if( blocks.getCount() )
+        {
+            _getLabel(blocks[0])->prependChildrenOf(&m_functionVars);
+        }
+
+        // Now that all the branches have been emitted, we know the incoming
+        // values of all the `OpPhi`s.
+        //
+        {
+            Dictionary<SpvInst*, List<SpvWord>> phiOperands;
+            for( auto& edge : m_phiEdges )
+            {
+                List<SpvWord>* operands = phiOperands.TryGetValue(edge.spvPhi);
+                if( !operands )
+                {
+                    List<SpvWord> initial;
+                    initial.add(edge.spvPhi->operandWords[0]);
+                    initial.add(getID(edge.spvPhi));
+                    phiOperands.Add(edge.spvPhi, initial);
+                    operands = phiOperands.TryGetValue(edge.spvPhi);
+                }
+                operands->add(edge.valueID);
+                operands->add(edge.fromLabelID);
+            }
+            for( auto& pair : phiOperands )
+            {
+                setOperands(pair.Key, pair.Value);
+            }
+        }
+
+        // [3.32.9. Function Instructions]
+        //
+        // > OpFunctionEnd
+        //
+        // In the SPIR-V encoding a function is logically the parent of any
+        // instructions up to a matching `OpFunctionEnd`. In our intermediate
+        // structure we will make the `OpFunctionEnd` be the last child of
+        // the `OpFunction`.
+        //
+        emitInst(spvFunc, nullptr, SpvOpFunctionEnd);
+    }
+
+    SpvInst* _getLabelOrFunc(IRInst* irInst)
+    {
+        SpvInst* spvInst = nullptr;
+        m_mapIRInstToSpvInst.TryGetValue(irInst, spvInst);
+        SLANG_ASSERT(spvInst);
+        return spvInst;
+    }
+
+        /// Record that the branch from `spvFrom` to `spvTarget` passes the values `args` to the target's `OpPhi`s
+    void _addPhiEdges(SpvInst* spvTarget, SpvInst* spvFrom, List<SpvWord> const& args)
+    {
+        List<SpvInst*>* phis = m_phis.TryGetValue(spvTarget);
+        const Index phiCount = phis ? phis->getCount() : 0;
+        if( phiCount != args.getCount() )
+        {
+            _unsupported(nullptr, "branch with mismatched arguments");
+            return;
+        }
+        for( Index ii = 0; ii < phiCount; ++ii )
+        {
+            PhiEdge edge;
+            edge.spvPhi = (*phis)[ii];
+            edge.valueID = args[ii];
+            edge.fromLabelID = getID(spvFrom);
+            m_phiEdges.add(edge);
+        }
+    }
+
+        /// Emit a branch (with arguments) to `irTarget`, as the terminator of the current block.
+    void _emitBranch(IRUnconditionalBranch* branch, SpvInst* spvTarget)
+    {
+        List<SpvWord> args;
+        for( UInt ii = 0; ii < branch->getArgCount(); ++ii )
+        {
+            args.add(getID(getValue(branch->getArg(ii))));
+        }
+        _addPhiEdges(spvTarget, m_currentBlock, args);
+        emitInst(m_currentBlock, branch, SpvOpBranch, spvTarget);
+    }
+
+        /// Emit the terminator instruction `terminator` of the current block
+    void emitTerminator(IRInst* terminator)
+    {
+        switch( terminator->op )
+        {
+        // [3.32.17. Control-Flow Instructions]
+        //
+        // > OpReturn
+        case kIROp_ReturnVoid:
+            emitInst(m_currentBlock, terminator, SpvOpReturn);
+            break;
+
+        // > OpReturnValue
+        case kIROp_ReturnVal:
+            {
+                auto returnVal = static_cast<IRReturnVal*>(terminator);
+                auto value = emitValueOfType(returnVal->getVal(), _getCurrentFuncResultType(terminator));
+                emitInst(m_currentBlock, terminator, SpvOpReturnValue, value);
+            }
+            break;
+
+        // > OpKill
+        case kIROp_discard:
+            emitInst(m_currentBlock, terminator, SpvOpKill);
+            break;
+
+        // > OpUnreachable
+        case kIROp_Unreachable:
+        case kIROp_MissingReturn:
+            emitInst(m_currentBlock, terminator, SpvOpUnreachable);
+            break;
+
+        // > OpBranch
+        case kIROp_unconditionalBranch:
+            {
+                auto branch = static_cast<IRUnconditionalBranch*>(terminator);
+                _emitBranch(branch, _getBranchTarget(branch->getTargetBlock()));
+            }
+            break;
+
+        case kIROp_loop:
+            {
+                // Entering a loop goes to the header, and not to any added
+                // continue block.
+                //
+                auto loop = static_cast<IRLoop*>(terminator);
+                _emitBranch(loop, _getLabel(loop->getTargetBlock()));
+            }
+            break;
+
+        // > OpBranchConditional
+        case kIROp_conditionalBranch:
+        case kIROp_ifElse:
+            {
+                auto branch = static_cast<IRConditionalBranch*>(terminator);
+                auto spvTrue = _getBranchTarget(branch->getTrueBlock());
+                auto spvFalse = _getBranchTarget(branch->getFalseBlock());
+                if( branch->getTrueBlock()->getFirstParam() || branch->getFalseBlock()->getFirstParam() )
+                {
+                    _unsupported(terminator, "conditional branch with arguments");
+                    break;
+                }
+
+                // [2.11: Structured Control Flow]
+                //
+                // A conditional branch needs a selection header, unless it breaks
+                // out of (or continues) a loop. When the block after an `if` is the
+                // merge or continue block of a loop, the `if` can only be represented
+                // if one of its branches goes straight there.
+                //
+                SpvInst* spvAfter = nullptr;
+                if( terminator->op == kIROp_ifElse )
+                    spvAfter = _getBranchTarget(static_cast<IRIfElse*>(terminator)->getAfterBlock());
+                if( !spvAfter || m_loopExitLabels.Contains(spvAfter) )
+                {
+                    if( !m_loopExitLabels.Contains(spvTrue) && !m_loopExitLabels.Contains(spvFalse) )
+                    {
+                        _unsupported(terminator, "unstructured conditional branch");
+                        break;
+                    }
+                }
+                else
+                {
+                    emitInst(m_currentBlock, nullptr, SpvOpSelectionMerge, spvAfter, SpvSelectionControlMaskNone);
+                }
+
+                auto condition = emitValueOfType(branch->getCondition(), m_builder.getBoolType());
+                emitInst(m_currentBlock, terminator, SpvOpBranchConditional, condition, spvTrue, spvFalse);
+            }
+            break;
+
+        // > OpSwitch
+        case kIROp_Switch:
+            {
+                auto switchInst = static_cast<IRSwitch*>(terminator);
+                auto selector = getValue(switchInst->getCondition());
+                auto selectorType = switchInst->getCondition()->getDataType();
+                if( _getScalarByteSize(selectorType) != 4 || _getScalarKind(selectorType) == ScalarKind::Float )
+                {
+                    _unsupported(terminator, "switch selector type");
+                    break;
+                }
+
+                emitInst(m_currentBlock, nullptr, SpvOpSelectionMerge, _getBranchTarget(switchInst->getBreakLabel()), SpvSelectionControlMaskNone);
+
+                // A `switch` without a `default` (e.g. for dynamic dispatch)
+                // goes to the merge block for any other value.
+                //
+                auto defaultLabel = switchInst->getDefaultLabel();
+                if( !defaultLabel )
+                    defaultLabel = switchInst->getBreakLabel();
+
+                List<SpvWord> operands;
+                operands.add(getID(selector));
+                operands.add(getID(_getBranchTarget(defaultLabel)));
+                for( UInt ii = 0; ii < switchInst->getCaseCount(); ++ii )
+                {
+                    auto caseValue = as<IRIntLit>(switchInst->getCaseValue(ii));
+                    if( !caseValue )
+                    {
+                        _unsupported(terminator, "switch case value");
+                        break;
+                    }
+                    operands.add(SpvWord(caseValue->getValue()));
+                    operands.add(getID(_getBranchTarget(switchInst->getCaseLabel(ii))));
+                }
+                emitInst(m_currentBlock, terminator, SpvOpSwitch, OperandWords(operands));
+            }
+            break;
+
+        default:
+            _unsupported(terminator, "terminator");
+            break;
+        }
+    }
+
+        /// Get the result type of the function that contains `inst`
+    static IRType* _getCurrentFuncResultType(IRInst* inst)
+    {
+        auto func = as<IRFunc>(inst->getParent()->getParent());
+        SLANG_ASSERT(func);
+        return func->getDataType()->getResultType();
+    }
+
+    // The instructions that appear inside the basic blocks of
+    // functions are what we will call "local" instructions.
+    //
+    // When emitting global instructions, we usually have to
+    // pick the right logical section to emit them into, while
+    // local instructions are emitted into the current block
+    // (`m_currentBlock`).
+    //
+    // Many Slang IR operations are more permissive about the types
+    // of their operands than SPIR-V is (e.g. mixing scalars and vectors,
+    // or using an `int` literal where a `float` is needed), so operands
+    // are converted to the type that the SPIR-V instruction requires.
+
+        /// Emit an instruction that converts `value` from `fromType` to `toType`
+    SpvInst* emitConversion(SpvInst* value, IRType* fromType, IRType* toType)
+    {
+        auto spvToType = getType(toType);
+        if( getType(fromType) == spvToType )
+            return value;
+
+        Index fromCount = 0;
+        Index toCount = 0;
+        auto fromScalarType = _getScalarType(fromType, fromCount);
+        auto toScalarType = _getScalarType(toType, toCount);
+        if( !fromScalarType || !toScalarType )
+        {
+            return _unsupported(nullptr, "conversion between types");
+        }
+
+        if( fromCount > toCount )
+        {
+            // Truncating a vector keeps its leading elements.
+            //
+            auto truncatedType = _getVectorType(fromScalarType, toCount);
+            if( toCount == 1 )
+            {
+                value = emitInst(m_currentBlock, nullptr, SpvOpCompositeExtract, getType(truncatedType), kResultID, value, SpvWord(0));
+            }
+            else
+            {
+                List<SpvWord> components;
+                for( Index ii = 0; ii < toCount; ++ii )
+                    components.add(SpvWord(ii));
+                value = emitInst(m_currentBlock, nullptr, SpvOpVectorShuffle, getType(truncatedType), kResultID, value, value, OperandWords(components));
+            }
+            return emitConversion(value, truncatedType, toType);
+        }
+        if( fromCount < toCount )
+        {
+            // A scalar can be converted to a vector by replicating it.
+            //
+            if( fromCount != 1 )
+                return _unsupported(nullptr, "conversion between vector sizes");
+            value = emitConversion(value, fromScalarType, toScalarType);
+            return emitSplat(value, toType, toCount);
+        }
+
+        // Now only the element type differs.
+        //
+        const auto fromKind = _getScalarKind(fromScalarType);
+        const auto toKind = _getScalarKind(toScalarType);
+        const auto fromSize = _getScalarByteSize(fromScalarType);
+        const auto toSize = _getScalarByteSize(toScalarType);
+
+        if( fromKind == ScalarKind::Bool )
+        {
+            // [3.32.13: Arithmetic Instructions] doesn't include a conversion
+            // from `bool`, so we select between one and zero.
+            //
+            return emitInst(m_currentBlock, nullptr, SpvOpSelect, spvToType, kResultID, value, getSplatConstant(toType, 1), getSplatConstant(toType, 0));
+        }
+        if( toKind == ScalarKind::Bool )
+        {
+            if( fromKind == ScalarKind::Float )
+                return emitInst(m_currentBlock, nullptr, SpvOpFUnordNotEqual, spvToType, kResultID, value, getSplatConstant(fromType, 0));
+            return emitInst(m_currentBlock, nullptr, SpvOpINotEqual, spvToType, kResultID, value, getSplatConstant(fromType, 0));
+        }
+
+        // [3.32.11: Conversion Instructions]
+        //
+        if( fromKind == ScalarKind::Float && toKind == ScalarKind::Float )
+            return emitInst(m_currentBlock, nullptr, SpvOpFConvert, spvToType, kResultID, value);
+        if( fromKind == ScalarKind::Float )
+            return emitInst(m_currentBlock, nullptr, (toKind == ScalarKind::SignedInt) ? SpvOpConvertFToS : SpvOpConvertFToU, spvToType, kResultID, value);
+        if( toKind == ScalarKind::Float )
+            return emitInst(m_currentBlock, nullptr, (fromKind == ScalarKind::SignedInt) ? SpvOpConvertSToF : SpvOpConvertUToF, spvToType, kResultID, value);
+
+        // Between integer types, a change of width extends based on the
+        // signedness of the source, and a change of signedness is a bitcast.
+        //
+        if( fromSize == toSize )
+            return emitInst(m_currentBlock, nullptr, SpvOpBitcast, spvToType, kResultID, value);
+        if( fromKind == ScalarKind::SignedInt )
+            return emitInst(m_currentBlock, nullptr, SpvOpSConvert, spvToType, kResultID, value);
+
+        // > OpUConvert: Result Type must be a scalar or vector of integer type,
+        // > whose Signedness operand is 0.
+        //
+        IRType* unsignedType = nullptr;
+        switch( toSize )
+        {
+        case 1: unsignedType = m_builder.getBasicType(BaseType::UInt8); break;
+        case 2: unsignedType = m_builder.getBasicType(BaseType::UInt16); break;
+        case 4: unsignedType = m_builder.getUIntType(); break;
+        default: unsignedType = m_builder.getUInt64Type(); break;
+        }
+        unsignedType = _getVectorType(unsignedType, toCount);
+        value = emitInst(m_currentBlock, nullptr, SpvOpUConvert, getType(unsignedType), kResultID, value);
+        return emitConversion(value, unsignedType, toType);
+    }
+
+        /// Emit a vector of type `vectorType` with all `count` elements set to the scalar `value`
+    SpvInst* emitSplat(SpvInst* value, IRType* vectorType, Index count)
+    {
+        if( count == 1 )
+            return value;
+        List<SpvWord> constituents;
+        for( Index ii = 0; ii < count; ++ii )
+            constituents.add(getID(value));
+        if( _isConstant(value) )
+            return emitConstantInst(SpvOpConstantComposite, getType(vectorType), constituents);
+        return emitInst(m_currentBlock, nullptr, SpvOpCompositeConstruct, getType(vectorType), kResultID, OperandWords(constituents));
+    }
+
+        /// Get the value of `irInst`, converted to `type`
+    SpvInst* emitValueOfType(IRInst* irInst, IRType* type)
+    {
+        // Literals are converted when they are emitted, rather than
+        // emitting a conversion instruction.
+        //
+        if( auto literal = as<IRConstant>(irInst) )
+        {
+            if( _getScalarType(type) && literal->op != kIROp_StringLit )
+                return getSplatConstant(type, _getLiteralValue(literal));
+        }
+        return emitConversion(getValue(irInst), irInst->getDataType(), type);
+    }
+
+        /// Get the type that the operation with `operands` should be performed on.
+        ///
+        /// This is the widest of the (scalar or vector) operand types, preferring
+        /// a type that doesn't come from a literal.
+    static IRType* _getOperationType(IRInst* const* operands, Index operandCount)
+    {
+        IRType* bestType = nullptr;
+        Index bestCount = 0;
+        bool bestIsLiteral = true;
+        for( Index ii = 0; ii < operandCount; ++ii )
+        {
+            auto type = operands[ii]->getDataType();
+            Index count = 0;
+            if( !_getScalarType(type, count) )
+                return type;
+            const bool isLiteral = as<IRConstant>(operands[ii]) != nullptr;
+            if( !bestType || count > bestCount || (count == bestCount && bestIsLiteral && !isLiteral) )
+            {
+                bestType = type;
+                bestCount = count;
+                bestIsLiteral = isLiteral;
+            }
+        }
+        return bestType;
+    }
+
+    // [3.32.13: Arithmetic Instructions]
+    // [3.32.14: Bit Instructions]
+    // [3.32.15: Relational and Logical Instructions]
+    //
+    // The SPIR-V opcodes for arithmetic depend on the kind of the
+    // operands (floating point, signed or unsigned), so each IR
+    // operation maps to a set of opcodes.
+
+    struct OpcodeSet
+    {
+        SpvOp floatOp;
+        SpvOp signedOp;
+        SpvOp unsignedOp;
+        SpvOp boolOp;
+    };
+
+    static bool _getOpcodeSet(IROp op, OpcodeSet& outSet, bool& outIsComparison)
+    {
+        outIsComparison = false;
+        switch( op )
+        {
+#define CASE(IROP, F, S, U, B) case kIROp_##IROP: outSet = OpcodeSet{ SpvOp##F, SpvOp##S, SpvOp##U, SpvOp##B }; return true
+        CASE(Add,       FAdd,   IAdd,   IAdd,   Nop);
+        CASE(Sub,       FSub,   ISub,   ISub,   Nop);
+        CASE(Mul,       FMul,   IMul,   IMul,   Nop);
+        CASE(Div,       FDiv,   SDiv,   UDiv,   Nop);
+        CASE(IRem,      FRem,   SRem,   UMod,   Nop);
+        CASE(FRem,      FRem,   SRem,   UMod,   Nop);
+        CASE(Lsh,       Nop,    ShiftLeftLogical,       ShiftLeftLogical,   Nop);
+        CASE(Rsh,       Nop,    ShiftRightArithmetic,   ShiftRightLogical,  Nop);
+        CASE(BitAnd,    Nop,    BitwiseAnd, BitwiseAnd, LogicalAnd);
+        CASE(BitOr,     Nop,    BitwiseOr,  BitwiseOr,  LogicalOr);
+        CASE(BitXor,    Nop,    BitwiseXor, BitwiseXor, LogicalNotEqual);
+#undef CASE
+
+#define CASE(IROP, F, S, U, B) case kIROp_##IROP: outSet = OpcodeSet{ SpvOp##F, SpvOp##S, SpvOp##U, SpvOp##B }; outIsComparison = true; return true
+        CASE(Eql,       FOrdEqual,              IEqual,                 IEqual,                 LogicalEqual);
+        CASE(Neq,       FUnordNotEqual,         INotEqual,              INotEqual,              LogicalNotEqual);
+        CASE(Less,      FOrdLessThan,           SLessThan,              ULessThan,              Nop);
+        CASE(Leq,       FOrdLessThanEqual,      SLessThanEqual,         ULessThanEqual,         Nop);
+        CASE(Greater,   FOrdGreaterThan,        SGreaterThan,           UGreaterThan,           Nop);
+        CASE(Geq,       FOrdGreaterThanEqual,   SGreaterThanEqual,      UGreaterThanEqual,      Nop);
+#undef CASE
+        default:
+            return false;
+        }
+    }
+
+    static SpvOp _selectOpcode(OpcodeSet const& set, IRType* type)
+    {
+        switch( _getScalarKind(_getScalarType(type)) )
+        {
+        case ScalarKind::Float:         return set.floatOp;
+        case ScalarKind::SignedInt:     return set.signedOp;
+        case ScalarKind::UnsignedInt:   return set.unsignedOp;
+        case ScalarKind::Bool:          return set.boolOp;
+        default:                        return SpvOpNop;
+        }
+    }
+
+        /// Emit the binary operation `opcodes` on `left` and `right`, which have already been converted to `type`.
+        ///
+        /// Operations on matrices are performed on each row.
+    SpvInst* emitBinaryOp(IRInst* irInst, OpcodeSet const& opcodes, IRType* resultType, IRType* type, SpvInst* left, SpvInst* right)
+    {
+        if( auto matrixType = as<IRMatrixType>(type) )
+        {
+            auto resultMatrixType = as<IRMatrixType>(resultType);
+            if( !resultMatrixType )
+                return _unsupported(irInst, "matrix operation");
+
+            auto rowType = _getVectorType(matrixType->getElementType(), Index(getIntVal(matrixType->getColumnCount())));
+            auto resultRowType = _getVectorType(resultMatrixType->getElementType(), Index(getIntVal(resultMatrixType->getColumnCount())));
+            auto rowCount = getIntVal(matrixType->getRowCount());
+
+            List<SpvWord> rows;
+            for( IRIntegerValue ii = 0; ii < rowCount; ++ii )
+            {
+                auto leftRow = emitInst(m_currentBlock, nullptr, SpvOpCompositeExtract, getType(rowType), kResultID, left, SpvWord(ii));
+                auto rightRow = emitInst(m_currentBlock, nullptr, SpvOpCompositeExtract, getType(rowType), kResultID, right, SpvWord(ii));
+                rows.add(getID(emitBinaryOp(irInst, opcodes, resultRowType, rowType, leftRow, rightRow)));
+            }
+            return emitInst(m_currentBlock, nullptr, SpvOpCompositeConstruct, getType(resultType), kResultID, OperandWords(rows));
+        }
+
+        const SpvOp opcode = _selectOpcode(opcodes, type);
+        if( opcode == SpvOpNop )
+            return _unsupported(irInst, "operand type");
+        return emitInst(m_currentBlock, nullptr, opcode, getType(resultType), kResultID, left, right);
+    }
+
+        /// Convert `irInst` (a scalar, vector or matrix) to `type`, replicating a scalar for a matrix.
+    SpvInst* _emitOperandOfType(IRInst* irInst, IRType* type)
+    {
+        if( auto matrixType = as<IRMatrixType>(type) )
+        {
+            if( as<IRMatrixType>(irInst->getDataType()) )
+            {
+                if( getType(irInst->getDataType()) != getType(type) )
+                    return _unsupported(irInst, "matrix conversion");
+                return getValue(irInst);
+            }
+            auto rowType = _getVectorType(matrixType->getElementType(), Index(getIntVal(matrixType->getColumnCount())));
+            auto row = emitValueOfType(irInst, rowType);
+            List<SpvWord> rows;
+            for( IRIntegerValue ii = 0; ii < getIntVal(matrixType->getRowCount()); ++ii )
+                rows.add(getID(row));
+            return emitInst(m_currentBlock, nullptr, SpvOpCompositeConstruct, getType(type), kResultID, OperandWords(rows));
+        }
+        return emitValueOfType(irInst, type);
+    }
+
+    SpvInst* emitArithmetic(IRInst* irInst, OpcodeSet const& opcodes, bool isComparison)
+    {
+        auto resultType = irInst->getDataType();
+        auto leftInst = irInst->getOperand(0);
+        auto rightInst = irInst->getOperand(1);
+
+        IRType* type = resultType;
+        if( isComparison )
+        {
+            // The operands are compared as their (common) type, and the
+            // result has the same amount of elements.
+            //
+            IRInst* operands[] = { leftInst, rightInst };
+            type = _getOperationType(operands, 2);
+            Index resultCount = 0;
+            Index count = 0;
+            auto scalarType = _getScalarType(type, count);
+            if( !scalarType || !_getScalarType(resultType, resultCount) )
+                return _unsupported(irInst, "comparison type");
+            type = _getVectorType(scalarType, resultCount);
+        }
+        else if( irInst->op == kIROp_BitAnd || irInst->op == kIROp_BitOr || irInst->op == kIROp_BitXor )
+        {
+            // Bitwise operations on `bool` are logical operations.
+            //
+            if( _getScalarKind(_getScalarType(resultType)) == ScalarKind::Bool )
+                type = resultType;
+        }
+
+        auto left = _emitOperandOfType(leftInst, type);
+        auto right = _emitOperandOfType(rightInst, type);
+        return emitBinaryOp(irInst, opcodes, resultType, type, left, right);
+    }
+
+        /// Emit the result of the unary operation `irInst`
+    SpvInst* emitUnaryOp(IRInst* irInst)
+    {
+        auto type = irInst->getDataType();
+        auto operand = _emitOperandOfType(irInst->getOperand(0), type);
+
+        if( auto matrixType = as<IRMatrixType>(type) )
+        {
+            // Negating a matrix negates each row.
+            //
+            if( irInst->op != kIROp_Neg || _getScalarKind(matrixType->getElementType()) != ScalarKind::Float )
+                return _unsupported(irInst, "matrix operation");
+            auto rowType = _getVectorType(matrixType->getElementType(), Index(getIntVal(matrixType->getColumnCount())));
+            List<SpvWord> rows;
+            for( IRIntegerValue ii = 0; ii < getIntVal(matrixType->getRowCount()); ++ii )
+            {
+                auto row = emitInst(m_currentBlock, nullptr, SpvOpCompositeExtract, getType(rowType), kResultID, operand, SpvWord(ii));
+                rows.add(getID(emitInst(m_currentBlock, nullptr, SpvOpFNegate, getType(rowType), kResultID, row)));
+            }
+            return emitInst(m_currentBlock, irInst, SpvOpCompositeConstruct, getType(type), kResultID, OperandWords(rows));
+        }
+
+        SpvOp opcode = SpvOpNop;
+        const auto kind = _getScalarKind(_getScalarType(type));
+        switch( irInst->op )
+        {
+        case kIROp_Neg:
+            opcode = (kind == ScalarKind::Float) ? SpvOpFNegate : ((kind == ScalarKind::Bool) ? SpvOpNop : SpvOpSNegate);
+            break;
+        case kIROp_Not:
+            opcode = (kind == ScalarKind::Bool) ? SpvOpLogicalNot : SpvOpNop;
+            break;
+        case kIROp_BitNot:
+            opcode = (kind == ScalarKind::Bool) ? SpvOpLogicalNot : ((kind == ScalarKind::Float) ? SpvOpNop : SpvOpNot);
+            break;
+        default:
+            break;
+        }
+        if( opcode == SpvOpNop )
+            return _unsupported(irInst, "operand type");
+        return emitInst(m_currentBlock, irInst, opcode, getType(type), kResultID, operand);
+    }
+
+        /// Emit a composite of `type` from the IR values `operands`.
+        ///
+        /// The operands can be the elements of the composite, or (for vectors and matrices)
+        /// vectors or scalars that together have the right amount of elements.
+    SpvInst* emitComposite(IRInst* irInst, IRType* type, List<IRInst*> const& operands)
+    {
+        auto spvType = getType(type);
+        List<SpvWord> constituents;
+
+        if( as<IRVectorType>(type) || as<IRMatrixType>(type) )
+        {
+            // For a matrix, the constituents are the rows; for a vector, the
+            // scalars (or vectors) that make it up.
+            //
+            IRType* elementType = nullptr;
+            Index rowCount = 1;
+            Index rowSize = 0;
+            if( auto matrixType = as<IRMatrixType>(type) )
+            {
+                elementType = matrixType->getElementType();
+                rowCount = Index(getIntVal(matrixType->getRowCount()));
+                rowSize = Index(getIntVal(matrixType->getColumnCount()));
+            }
+            else
+            {
+                _getScalarType(type, rowSize);
+                elementType = _getScalarType(type);
+            }
+            auto rowType = _getVectorType(elementType, rowSize);
+
+            // Gather the operands for each row.
+            //
+            Index operandIndex = 0;
+            for( Index row = 0; row < rowCount; ++row )
+            {
+                List<SpvWord> rowConstituents;
+                Index rowElementCount = 0;
+                while( rowElementCount < rowSize )
+                {
+                    if( operandIndex >= operands.getCount() )
+                        return _unsupported(irInst, "composite with too few elements");
+                    auto operand = operands[operandIndex++];
+                    Index operandCount = 0;
+                    if( as<IRMatrixType>(operand->getDataType()) || !_getScalarType(operand->getDataType(), operandCount) )
+                        return _unsupported(irInst, "composite operand");
+                    if( rowElementCount + operandCount > rowSize )
+                        return _unsupported(irInst, "composite operand");
+                    rowConstituents.add(getID(emitValueOfType(operand, _getVectorType(elementType, operandCount))));
+                    rowElementCount += operandCount;
+                }
+
+                if( rowCount == 1 )
+                {
+                    constituents = rowConstituents;
+                }
+                else if( rowConstituents.getCount() == 1 )
+                {
+                    constituents.add(rowConstituents[0]);
+                }
+                else
+                {
+                    auto spvRow = emitInst(m_currentBlock, nullptr, SpvOpCompositeConstruct, getType(rowType), kResultID, OperandWords(rowConstituents));
+                    constituents.add(getID(spvRow));
+                }
+            }
+            if( operandIndex != operands.getCount() )
+                return _unsupported(irInst, "composite with too many elements");
+        }
+        else
+        {
+            List<IRType*> elementTypes;
+            if( !_getCompositeElementTypes(type, elementTypes) )
+                return _unsupported(irInst, "composite type");
+
+            // The operands for `void` fields of a struct are skipped.
+            //
+            List<IRInst*> elements;
+            for( auto operand : operands )
+            {
+                if( operand->getDataType()->op != kIROp_VoidType )
+                    elements.add(operand);
+            }
+            if( elements.getCount() != elementTypes.getCount() )
+                return _unsupported(irInst, "composite with wrong amount of elements");
+
+            for( Index ii = 0; ii < elements.getCount(); ++ii )
+            {
+                if( _getScalarType(elementTypes[ii]) )
+                    constituents.add(getID(emitValueOfType(elements[ii], elementTypes[ii])));
+                else
+                    constituents.add(getID(getValue(elements[ii])));
+            }
+        }
+
+        return emitInst(m_currentBlock, irInst, SpvOpCompositeConstruct, spvType, kResultID, OperandWords(constituents));
+    }
+
+        /// Emit the `construct` instruction `irInst`, which is either a conversion or makes a composite
+    SpvInst* emitConstruct(IRInst* irInst)
+    {
+        auto type = irInst->getDataType();
+        const UInt operandCount = irInst->getOperandCount();
+        if( operandCount == 0 )
+        {
+            return getNullConstant(type);
+        }
+        if( operandCount == 1 )
+        {
+            auto operand = irInst->getOperand(0);
+            auto operandType = operand->getDataType();
+            if( getType(operandType) == getType(type) )
+                return getValue(operand);
+            if( _getScalarType(type) && _getScalarType(operandType) )
+                return emitValueOfType(operand, type);
+            if( auto matrixType = as<IRMatrixType>(type) )
+            {
+                if( auto operandMatrixType = as<IRMatrixType>(operandType) )
+                    return emitMatrixConversion(irInst, getValue(operand), operandMatrixType, matrixType);
+            }
+        }
+        List<IRInst*> operands;
+        for( UInt ii = 0; ii < operandCount; ++ii )
+            operands.add(irInst->getOperand(ii));
+        return emitComposite(irInst, type, operands);
+    }
+
+        /// Convert a matrix to one with a different element type, or fewer rows or columns
+    SpvInst* emitMatrixConversion(IRInst* irInst, SpvInst* value, IRMatrixType* fromType, IRMatrixType* toType)
+    {
+        const auto fromRowCount = getIntVal(fromType->getRowCount());
+        const auto toRowCount = getIntVal(toType->getRowCount());
+        if( toRowCount > fromRowCount || getIntVal(toType->getColumnCount()) > getIntVal(fromType->getColumnCount()) )
+            return _unsupported(irInst, "matrix conversion");
+
+        auto fromRowType = _getVectorType(fromType->getElementType(), Index(getIntVal(fromType->getColumnCount())));
+        auto toRowType = _getVectorType(toType->getElementType(), Index(getIntVal(toType->getColumnCount())));
+        List<SpvWord> rows;
+        for( IRIntegerValue ii = 0; ii < toRowCount; ++ii )
+        {
+            auto row = emitInst(m_currentBlock, nullptr, SpvOpCompositeExtract, getType(fromRowType), kResultID, value, SpvWord(ii));
+            rows.add(getID(emitConversion(row, fromRowType, toRowType)));
+        }
+        return emitInst(m_currentBlock, irInst, SpvOpCompositeConstruct, getType(toType), kResultID, OperandWords(rows));
+    }
+
+        /// Emit an `OpAccessChain` from `spvBase` to a value of `pointeeType`, following `indices`
+    SpvInst* emitAccessChain(IRInst* irInst, SpvInst* spvBase, IRType* pointeeType, List<SpvWord> const& indices)
+    {
+        const auto storageClass = _getStorageClass(spvBase);
+        auto spvPtr = emitInst(m_currentBlock, irInst, SpvOpAccessChain, getPointerType(pointeeType, storageClass), kResultID, spvBase, OperandWords(indices));
+        m_storageClasses[spvPtr] = storageClass;
+        return spvPtr;
+    }
+
+        /// Get the index of the field `key` in the struct `type`, as used for access chains
+    Index _getFieldIndexOrFail(IRInst* irInst, IRType* type, IRInst* key)
+    {
+        auto structType = as<IRStructType>(type);
+        const Index index = structType ? _getFieldIndex(structType, key) : -1;
+        if( index < 0 )
+            _unsupported(irInst, "field access");
+        return index;
+    }
+
+        /// Emit an `OpVariable` in the current function, of `type`
+    SpvInst* emitFunctionVariable(IRInst* irInst, IRType* type)
+    {
+        auto spvVar = emitInst(&m_functionVars, irInst, SpvOpVariable, getPointerType(type, SpvStorageClassFunction), kResultID, SpvStorageClassFunction);
+        m_storageClasses[spvVar] = SpvStorageClassFunction;
+        return spvVar;
+    }
+
+        /// Returns true if `spvPtr` can be passed as a pointer argument to a function
+    bool _isMemoryObjectDeclaration(SpvInst* spvPtr)
+    {
+        // [2.16.1: Universal Validation Rules]
+        //
+        // > Any pointer operand to an OpFunctionCall must be a memory object
+        // > declaration, or a pointer to an element in an array that is a
+        // > memory object declaration (where the element type is OpTypeSampler
+        // > or OpTypeImage).
+        //
+        // A memory object declaration is an `OpVariable` or `OpFunctionParameter`.
+        // Function arguments also need to be in the `Function` storage class,
+        // since that is the storage class of the parameter's type.
+        //
+        return (spvPtr->opcode == SpvOpVariable || spvPtr->opcode == SpvOpFunctionParameter) &&
+            _getStorageClass(spvPtr) == SpvStorageClassFunction;
+    }
+
+        /// Emit a call to the IR function `irFunc`, which has a definition
+    SpvInst* emitFunctionCall(IRCall* call, IRFunc* irFunc)
+    {
+        auto funcType = irFunc->getDataType();
+        if( funcType->getParamCount() != call->getArgCount() )
+            return _unsupported(call, "call with wrong amount of arguments");
+
+        struct CopyBack
+        {
+            SpvInst* spvTemp;
+            SpvInst* spvPtr;
+            IRType* valueType;
+        };
+        List<CopyBack> copyBacks;
+
+        List<SpvWord> args;
+        for( UInt ii = 0; ii < call->getArgCount(); ++ii )
+        {
+            auto paramType = funcType->getParamType(ii);
+            auto arg = call->getArg(ii);
+            if( auto ptrType = as<IRPtrTypeBase>(paramType) )
+            {
+                // Pointers that aren't variables in the `Function` storage class
+                // (e.g. the address of a field, or of buffer memory) are passed by
+                // copying to a temporary, and back again after the call.
+                //
+                auto spvArg = getValue(arg);
+                if( _isMemoryObjectDeclaration(spvArg) )
+                {
+                    args.add(getID(spvArg));
+                    continue;
+                }
+
+                auto valueType = ptrType->getValueType();
+                auto spvTemp = emitFunctionVariable(nullptr, valueType);
+                if( paramType->op != kIROp_OutType )
+                {
+                    auto spvValue = emitInst(m_currentBlock, nullptr, SpvOpLoad, getType(valueType), kResultID, spvArg);
+                    emitInst(m_currentBlock, nullptr, SpvOpStore, spvTemp, spvValue);
+                }
+                CopyBack copyBack = { spvTemp, spvArg, valueType };
+                copyBacks.add(copyBack);
+                args.add(getID(spvTemp));
+                continue;
+            }
+
+            if( _getScalarType(paramType) )
+                args.add(getID(emitValueOfType(arg, paramType)));
+            else if( getType(arg->getDataType()) == getType(paramType) )
+                args.add(getID(getValue(arg)));
+            else
+                return _unsupported(call, "argument type");
+        }
+
+        // [3.32.9. Function Instructions]
+        //
+        // > OpFunctionCall
+        //
+        auto spvCall = emitInst(m_currentBlock, call, SpvOpFunctionCall, getType(call->getDataType()), kResultID, ensureInst(irFunc), OperandWords(args));
+
+        for( auto& copyBack : copyBacks )
+        {
+            auto spvValue = emitInst(m_currentBlock, nullptr, SpvOpLoad, getType(copyBack.valueType), kResultID, copyBack.spvTemp);
+            emitInst(m_currentBlock, nullptr, SpvOpStore, copyBack.spvPtr, spvValue);
+        }
+        return spvCall;
+    }
+
+        /// Find the value that a (possibly nested) `specialize` results in
+    static IRInst* _getSpecializedValue(IRInst* inst)
+    {
+        while( auto specialize = as<IRSpecialize>(inst) )
+        {
+            auto base = _getSpecializedValue(specialize->getBase());
+            auto generic = as<IRGeneric>(base);
+            auto value = generic ? findGenericReturnVal(generic) : nullptr;
+            if( !value )
+                return inst;
+            inst = value;
+        }
+        return inst;
+    }
+
+        /// Find the target intrinsic definition that applies to GLSL (and so SPIR-V) for `irFunc`
+    static IRTargetIntrinsicDecoration* _findTargetIntrinsicDecoration(IRInst* irFunc)
+    {
+        // As for GLSL output, a definition for `glsl` is better than
+        // a catch-all definition (without a target).
+        //
+        IRTargetIntrinsicDecoration* best = nullptr;
+        for( auto decoration : irFunc->getDecorations() )
+        {
+            auto targetIntrinsic = as<IRTargetIntrinsicDecoration>(decoration);
+            if( !targetIntrinsic )
+                continue;
+            auto targetName = targetIntrinsic->getTargetName();
+            if( targetName == "glsl" )
+                return targetIntrinsic;
+            if( targetName.getLength() == 0 )
+                best = targetIntrinsic;
+        }
+        return best;
+    }
+
+    SpvInst* emitCall(IRCall* call)
+    {
+        auto callee = _getSpecializedValue(call->getCallee());
+        requireSPIRVVersionOf(callee);
+        if( auto targetIntrinsic = _findTargetIntrinsicDecoration(callee) )
+        {
+            return emitIntrinsicCall(call, targetIntrinsic->getDefinition());
+        }
+        if( auto irFunc = as<IRFunc>(callee) )
+        {
+            if( isDefinition(irFunc) )
+                return emitFunctionCall(call, irFunc);
+        }
+        return _unsupported(call, "call to function without a definition");
+    }
+
+        /// Emit a read from the image at `coords` (the `ImageSubscript` of a texture)
+    SpvInst* emitImageRead(IRInst* irInst, IRInst* subscript, IRType* resultType)
+    {
+        auto spvImage = getValue(subscript->getOperand(0));
+        auto coords = _emitImageCoords(subscript->getOperand(1));
+        return _emitImageRead(irInst, spvImage, coords, resultType);
+    }
+
+        /// Get the integer coordinates for an image access from `irCoords`
+    SpvInst* _emitImageCoords(IRInst* irCoords)
+    {
+        Index count = 0;
+        _getScalarType(irCoords->getDataType(), count);
+        return emitValueOfType(irCoords, _getIntVectorType(count));
+    }
+
+        /// Emit `OpImageRead` from `spvImage`, giving a result of `resultType`
+    SpvInst* _emitImageRead(IRInst* irInst, SpvInst* spvImage, SpvInst* coords, IRType* resultType)
+    {
+        // [3.32.10: Image Instructions]
+        //
+        // > OpImageRead: Result Type must be a scalar or vector of floating-point type or integer type.
+        //
+        // Images always hold 4 elements, and the result is converted to
+        // the type required.
+        //
+        if( m_imageTypesWithUnknownFormat.Contains(_getImageTypeOf(spvImage)) )
+            requireCapability(SpvCapabilityStorageImageReadWithoutFormat);
+
+        auto texelType = _getTexelType(resultType);
+        if( !texelType )
+            return _unsupported(irInst, "image element type");
+        auto texel = emitInst(m_currentBlock, nullptr, SpvOpImageRead, getType(texelType), kResultID, spvImage, coords);
+        return emitConversion(texel, texelType, resultType);
+    }
+
+        /// Get the 4 element vector type used for texels of an image with elements of `type`
+    IRType* _getTexelType(IRType* type)
+    {
+        auto scalarType = _getScalarType(type);
+        if( !scalarType )
+            return nullptr;
+        if( scalarType->op == kIROp_HalfType )
+            scalarType = m_builder.getBasicType(BaseType::Float);
+        return _getVectorType(scalarType, 4);
+    }
+
+        /// Get the type of the image `spvImage` (which is loaded from a variable)
+    SpvInst* _getImageTypeOf(SpvInst* spvImage)
+    {
+        // The result type of an `OpLoad` is its first operand.
+        //
+        if( spvImage->operandWordsCount == 0 )
+            return nullptr;
+        const SpvWord typeID = spvImage->operandWords[0];
+        for( auto spvType : m_imageTypesWithUnknownFormat )
+        {
+            if( spvType->id == typeID )
+                return spvType;
+        }
+        return nullptr;
+    }
+
+        /// Emit `OpImageWrite` of `value` (of `valueType`) to `spvImage`
+    void _emitImageWrite(IRInst* irInst, SpvInst* spvImage, SpvInst* coords, SpvInst* value, IRType* valueType)
+    {
+        if( m_imageTypesWithUnknownFormat.Contains(_getImageTypeOf(spvImage)) )
+            requireCapability(SpvCapabilityStorageImageWriteWithoutFormat);
+
+        // > OpImageWrite: Texel is the data to write. It must be a scalar or vector with component type the
+        // > same as Sampled Type of the OpTypeImage (unless that Sampled Type is OpTypeVoid).
+        //
+        // The elements are converted (e.g. from `half`), and padded out to 4.
+        //
+        Index count = 0;
+        _getScalarType(valueType, count);
+        auto texelType = _getTexelType(valueType);
+        if( !texelType )
+        {
+            _unsupported(irInst, "image element type");
+            return;
+        }
+        auto elementsType = _getVectorType(_getScalarType(texelType), count);
+        auto texel = _emitPadded(irInst, emitConversion(value, valueType, elementsType), elementsType, 4);
+        emitInst(m_currentBlock, irInst, SpvOpImageWrite, spvImage, coords, texel);
+    }
+
+        /// Emit an instruction that is local to the body of a function
+    SpvInst* emitLocalInst(IRInst* inst)
+    {
+        if( as<IRTerminatorInst>(inst) )
+        {
+            emitTerminator(inst);
+            return nullptr;
+        }
+
+        OpcodeSet opcodes;
+        bool isComparison = false;
+        if( _getOpcodeSet(inst->op, opcodes, isComparison) )
+        {
+            auto spvInst = emitArithmetic(inst, opcodes, isComparison);
+            _registerLocal(inst, spvInst);
+            return spvInst;
+        }
+
+        SpvInst* spvInst = _emitLocalInst(inst);
+        _registerLocal(inst, spvInst);
+        return spvInst;
+    }
+
+        /// Register that `irInst` has the value `spvInst`, if it wasn't already registered when created
+    void _registerLocal(IRInst* irInst, SpvInst* spvInst)
+    {
+        if( spvInst && !m_mapIRInstToSpvInst.ContainsKey(irInst) )
+            registerInst(irInst, spvInst);
+    }
+
+    SpvInst* _emitLocalInst(IRInst* inst)
+    {
+        auto type = inst->getDataType();
+        switch( inst->op )
+        {
+        default:
+            // Types can be local to a function (e.g. after specialization),
+            // but are emitted with the other types.
+            //
+            if( auto irType = as<IRType>(inst) )
+                return getType(irType);
+            return _unsupported(inst, "instruction");
+
+        case kIROp_Specialize:
+            // The callee of a call is looked through to the function
+            // being specialized (see `emitCall`), so there is nothing to emit.
+            //
+            return nullptr;
+
+        case kIROp_Neg:
+        case kIROp_Not:
+        case kIROp_BitNot:
+            return emitUnaryOp(inst);
+
+        case kIROp_And:
+        case kIROp_Or:
+            {
+                // [3.32.15: Relational and Logical Instructions]
+                //
+                // > OpLogicalAnd, OpLogicalOr
+                //
+                auto left = emitValueOfType(inst->getOperand(0), type);
+                auto right = emitValueOfType(inst->getOperand(1), type);
+                return emitInst(m_currentBlock, inst, (inst->op == kIROp_And) ? SpvOpLogicalAnd : SpvOpLogicalOr, getType(type), kResultID, left, right);
+            }
+
+        case kIROp_Select:
+            {
+                // > OpSelect
+                //
+                // Before SPIR-V 1.4 the condition must be a vector with the same
+                // amount of elements as the result, and the result can't be a composite.
+                //
+                Index count = 0;
+                if( !_getScalarType(type, count) )
+                    return _unsupported(inst, "select of a composite");
+                auto condition = emitValueOfType(inst->getOperand(0), _getBoolVectorType(count));
+                auto trueValue = emitValueOfType(inst->getOperand(1), type);
+                auto falseValue = emitValueOfType(inst->getOperand(2), type);
+                return emitInst(m_currentBlock, inst, SpvOpSelect, getType(type), kResultID, condition, trueValue, falseValue);
+            }
+
+        case kIROp_Dot:
+            {
+                // > OpDot: Result Type must be a floating point scalar.
+                //
+                if( _getScalarKind(type) != ScalarKind::Float )
+                    return _unsupported(inst, "dot product of integers");
+                IRInst* operands[] = { inst->getOperand(0), inst->getOperand(1) };
+                auto operandType = _getOperationType(operands, 2);
+                auto left = emitValueOfType(operands[0], operandType);
+                auto right = emitValueOfType(operands[1], operandType);
+                if( !as<IRVectorType>(operandType) || getType(operandType) == getType(type) )
+                    return emitInst(m_currentBlock, inst, SpvOpFMul, getType(type), kResultID, left, right);
+                return emitInst(m_currentBlock, inst, SpvOpDot, getType(type), kResultID, left, right);
+            }
+
+        case kIROp_Construct:
+            return emitConstruct(inst);
+
+        case kIROp_makeVector:
+        case kIROp_MakeMatrix:
+        case kIROp_makeArray:
+        case kIROp_makeStruct:
+            {
+                List<IRInst*> operands;
+                for( UInt ii = 0; ii < inst->getOperandCount(); ++ii )
+                    operands.add(inst->getOperand(ii));
+                return emitComposite(inst, type, operands);
+            }
+
+        case kIROp_constructVectorFromScalar:
+            {
+                Index count = 0;
+                auto scalarType = _getScalarType(type, count);
+                if( !scalarType )
+                    return _unsupported(inst, "vector type");
+                auto scalar = emitValueOfType(inst->getOperand(0), scalarType);
+                return emitSplat(scalar, type, count);
+            }
+
+        case kIROp_swizzle:
+            {
+                // [3.32.12: Composite Instructions]
+                //
+                // > OpVectorShuffle
+                //
+                auto swizzle = static_cast<IRSwizzle*>(inst);
+                auto base = getValue(swizzle->getBase());
+                Index baseCount = 0;
+                if( !_getScalarType(swizzle->getBase()->getDataType(), baseCount) )
+                    return _unsupported(inst, "swizzle of a non-vector");
+
+                const Index count = Index(swizzle->getElementCount());
+                if( baseCount == 1 )
+                    return emitSplat(base, type, count);
+
+                List<SpvWord> components;
+                for( Index ii = 0; ii < count; ++ii )
+                    components.add(SpvWord(getIntVal(swizzle->getElementIndex(ii))));
+                if( count == 1 )
+                    return emitInst(m_currentBlock, inst, SpvOpCompositeExtract, getType(type), kResultID, base, OperandWords(components));
+                return emitInst(m_currentBlock, inst, SpvOpVectorShuffle, getType(type), kResultID, base, base, OperandWords(components));
+            }
+
+        case kIROp_swizzleSet:
+            {
+                // The result takes each element from the source if it is
+                // written by the swizzle, and otherwise from the base.
+                //
+                auto swizzleSet = static_cast<IRSwizzleSet*>(inst);
+                Index baseCount = 0;
+                auto scalarType = _getScalarType(type, baseCount);
+                if( !scalarType )
+                    return _unsupported(inst, "swizzle of a non-vector");
+                auto base = emitValueOfType(swizzleSet->getBase(), type);
+                const Index count = Index(swizzleSet->getElementCount());
+                auto source = emitValueOfType(swizzleSet->getSource(), _getVectorType(scalarType, count));
+
+                if( count == 1 )
+                {
+                    if( baseCount == 1 )
+                        return source;
+                    return emitInst(m_currentBlock, inst, SpvOpCompositeInsert, getType(type), kResultID, source, base, SpvWord(getIntVal(swizzleSet->getElementIndex(0))));
+                }
+
+                List<SpvWord> components;
+                for( Index ii = 0; ii < baseCount; ++ii )
+                    components.add(SpvWord(ii));
+                for( Index ii = 0; ii < count; ++ii )
+                    components[Index(getIntVal(swizzleSet->getElementIndex(ii)))] = SpvWord(baseCount + ii);
+                return emitInst(m_currentBlock, inst, SpvOpVectorShuffle, getType(type), kResultID, base, source, OperandWords(components));
+            }
+
+        case kIROp_SwizzledStore:
+            {
+                // Each element is stored through a pointer to it.
+                //
+                auto swizzledStore = static_cast<IRSwizzledStore*>(inst);
+                auto dest = getValue(swizzledStore->getDest());
+                auto vectorType = _getPointeeType(swizzledStore->getDest()->getDataType());
+                Index vectorCount = 0;
+                auto scalarType = vectorType ? _getScalarType(vectorType, vectorCount) : nullptr;
+                if( !scalarType || vectorCount == 1 )
+                    return _unsupported(inst, "swizzled store to a non-vector");
+                const Index count = Index(swizzledStore->getElementCount());
+                auto sourceType = _getVectorType(scalarType, count);
+                auto source = emitValueOfType(swizzledStore->getSource(), sourceType);
+                for( Index ii = 0; ii < count; ++ii )
+                {
+                    List<SpvWord> indices;
+                    indices.add(getID(getIntConstant(int32_t(getIntVal(swizzledStore->getElementIndex(ii))))));
+                    auto elementPtr = emitAccessChain(nullptr, dest, scalarType, indices);
+                    auto element = (count == 1) ? source : emitInst(m_currentBlock, nullptr, SpvOpCompositeExtract, getType(scalarType), kResultID, source, SpvWord(ii));
+                    emitInst(m_currentBlock, nullptr, SpvOpStore, elementPtr, element);
+                }
+                return nullptr;
+            }
+
+        case kIROp_FieldExtract:
+            {
+                auto fieldExtract = static_cast<IRFieldExtract*>(inst);
+                const Index index = _getFieldIndexOrFail(inst, fieldExtract->getBase()->getDataType(), fieldExtract->getField());
+                if( index < 0 )
+                    return _getPlaceholderInst();
+                return emitInst(m_currentBlock, inst, SpvOpCompositeExtract, getType(type), kResultID, getValue(fieldExtract->getBase()), SpvWord(index));
+            }
+
+        case kIROp_FieldAddress:
+            {
+                auto fieldAddress = static_cast<IRFieldAddress*>(inst);
+                auto base = getValue(fieldAddress->getBase());
+                const Index index = _getFieldIndexOrFail(inst, _getPointeeType(fieldAddress->getBase()->getDataType()), fieldAddress->getField());
+                if( index < 0 )
+                    return _getPlaceholderInst();
+                List<SpvWord> indices;
+                indices.add(getID(getIntConstant(int32_t(index))));
+                return emitAccessChain(inst, base, _getPointeeType(type), indices);
+            }
+
+        case kIROp_getElement:
+            {
+                auto getElement = static_cast<IRGetElement*>(inst);
+                auto baseInst = getElement->getBase();
+                auto indexInst = getElement->getIndex();
+                auto base = getValue(baseInst);
+                auto baseType = baseInst->getDataType();
+
+                Index baseCount = 0;
+                if( _getScalarType(baseType, baseCount) && baseCount == 1 )
+                    return base;
+
+                if( auto literal = as<IRIntLit>(indexInst) )
+                    return emitInst(m_currentBlock, inst, SpvOpCompositeExtract, getType(type), kResultID, base, SpvWord(literal->getValue()));
+
+                auto index = getValue(indexInst);
+                if( as<IRVectorType>(baseType) )
+                    return emitInst(m_currentBlock, inst, SpvOpVectorExtractDynamic, getType(type), kResultID, base, index);
+
+                // Dynamically indexing an array or matrix value in SPIR-V needs
+                // a pointer to it, so the value is copied into a variable.
+                //
+                auto spvTemp = emitFunctionVariable(nullptr, baseType);
+                emitInst(m_currentBlock, nullptr, SpvOpStore, spvTemp, base);
+                List<SpvWord> indices;
+                indices.add(getID(index));
+                auto elementPtr = emitAccessChain(nullptr, spvTemp, type, indices);
+                return emitInst(m_currentBlock, inst, SpvOpLoad, getType(type), kResultID, elementPtr);
+            }
+
+        case kIROp_getElementPtr:
+            {
+                auto getElementPtr = static_cast<IRGetElementPtr*>(inst);
+                auto base = getValue(getElementPtr->getBase());
+                List<SpvWord> indices;
+                indices.add(getID(getValue(getElementPtr->getIndex())));
+                return emitAccessChain(inst, base, _getPointeeType(type), indices);
+            }
+
+        case kIROp_Var:
+            {
+                // [3.32.8: Memory Instructions]
+                //
+                // > OpVariable
+                //
+                auto spvVar = emitFunctionVariable(inst, _getPointeeType(inst->getFullType()));
+                emitNameForInst(spvVar, inst);
+                return spvVar;
+            }
+
+        case kIROp_Load:
+            {
+                // > OpLoad
+                //
+                auto ptr = static_cast<IRLoad*>(inst)->ptr.get();
+                if( ptr->op == kIROp_ImageSubscript )
+                    return emitImageRead(inst, ptr, type);
+                return emitInst(m_currentBlock, inst, SpvOpLoad, getType(type), kResultID, getValue(ptr));
+            }
+
+        case kIROp_Store:
+            {
+                // > OpStore
+                //
+                auto store = static_cast<IRStore*>(inst);
+                auto ptr = store->ptr.get();
+                if( ptr->op == kIROp_ImageSubscript )
+                {
+                    auto spvImage = getValue(ptr->getOperand(0));
+                    auto coords = _emitImageCoords(ptr->getOperand(1));
+                    _emitImageWrite(inst, spvImage, coords, getValue(store->val.get()), store->val.get()->getDataType());
+                    return nullptr;
+                }
+                auto spvPtr = getValue(ptr);
+                auto valueType = _getPointeeType(ptr->getDataType());
+                SpvInst* value = nullptr;
+                if( valueType && _getScalarType(valueType) )
+                    value = emitValueOfType(store->val.get(), valueType);
+                else
+                    value = getValue(store->val.get());
+                emitInst(m_currentBlock, inst, SpvOpStore, spvPtr, value);
+                return nullptr;
+            }
+
+        case kIROp_ImageSubscript:
+            // An image subscript is only used as the address in a load or
+            // store, which handle it directly.
+            //
+            return nullptr;
+
+        case kIROp_Call:
+            return emitCall(static_cast<IRCall*>(inst));
+
+        case kIROp_BitCast:
+            {
+                // > OpBitcast
+                //
+                auto operand = inst->getOperand(0);
+                if( getType(operand->getDataType()) == getType(type) )
+                    return getValue(operand);
+                return emitInst(m_currentBlock, inst, SpvOpBitcast, getType(type), kResultID, getValue(operand));
+            }
+
+        case kIROp_makeUInt64:
+            {
+                // The low and high halves are widened and combined.
+                //
+                auto uint64Type = m_builder.getUInt64Type();
+                auto low = emitValueOfType(inst->getOperand(0), m_builder.getUIntType());
+                auto high = emitValueOfType(inst->getOperand(1), m_builder.getUIntType());
+                auto wideLow = emitInst(m_currentBlock, nullptr, SpvOpUConvert, getType(uint64Type), kResultID, low);
+                auto wideHigh = emitInst(m_currentBlock, nullptr, SpvOpUConvert, getType(uint64Type), kResultID, high);
+                auto shiftedHigh = emitInst(m_currentBlock, nullptr, SpvOpShiftLeftLogical, getType(uint64Type), kResultID, wideHigh, getUIntConstant(32));
+                return emitInst(m_currentBlock, inst, SpvOpBitwiseOr, getType(uint64Type), kResultID, wideLow, shiftedHigh);
+            }
+
+        case kIROp_undefined:
+            {
+                // [3.32.1: Miscellaneous Instructions]
+                //
+                // > OpUndef
+                //
+                List<SpvWord> operands;
+                return emitConstantInst(SpvOpUndef, getType(type), operands);
+            }
+
+        case kIROp_DefaultConstruct:
+            return getNullConstant(type);
+
+        case kIROp_GroupMemoryBarrierWithGroupSync:
+            return _emitControlBarrier(inst);
+        }
+    }
+
+    // [3.25: Memory Semantics <id>] and [3.27: Scope <id>]
+    //
+    // Barriers take their scope and memory semantics as <id>s of constants.
+
+    enum : SpvWord
+    {
+        kScopeDevice = SpvScopeDevice,
+        kScopeWorkgroup = SpvScopeWorkgroup,
+
+        kSemanticsAcquireRelease = SpvMemorySemanticsAcquireReleaseMask,
+        kSemanticsWorkgroupMemory = SpvMemorySemanticsWorkgroupMemoryMask,
+        kSemanticsUniformMemory = SpvMemorySemanticsUniformMemoryMask,
+        kSemanticsImageMemory = SpvMemorySemanticsImageMemoryMask,
+    };
+
+        /// Emit an `OpControlBarrier` that synchronizes the workgroup and its shared memory (as GLSL `barrier()` does)
+    SpvInst* _emitControlBarrier(IRInst* irInst)
+    {
+        return emitInst(m_currentBlock, irInst, SpvOpControlBarrier,
+            getUIntConstant(kScopeWorkgroup),
+            getUIntConstant(kScopeWorkgroup),
+            getUIntConstant(kSemanticsAcquireRelease | kSemanticsWorkgroupMemory));
+    }
+
+    // Calls to functions in the standard library are (mostly) to functions
+    // without a body, that have a `[__target_intrinsic(glsl, ...)]` giving
+    // the GLSL code to generate. The definitions range from a single function
+    // name (e.g. `sin`) to small expressions with escapes for the arguments
+    // (e.g. `$ctextureLod($p, $2, $3)$z`).
+    //
+    // Rather than adding a separate definition of every intrinsic for SPIR-V,
+    // we evaluate the GLSL definitions directly: the definition text is parsed
+    // as a (small subset of) GLSL expressions, and the GLSL builtin functions it
+    // calls are mapped to SPIR-V instructions. Anything that is outside of the
+    // subset is reported as unsupported.
+
+        /// A value computed while evaluating an intrinsic definition
+    struct IntrinsicValue
+    {
+            /// The SPIR-V value (or pointer), if not a literal
+        SpvInst* spv = nullptr;
+            /// The type of the value, or of what is pointed to for a pointer
+        IRType* type = nullptr;
+            /// Set if `spv` is a pointer (which can be assigned to)
+        bool isPointer = false;
+            /// Set if the value is a numeric literal in the definition
+        bool isLiteral = false;
+        IRFloatingPointValue literalValue = 0;
+            /// The IR argument to the call this value came from, if any
+        IRInst* irArg = nullptr;
+    };
+
+    enum class IntrinsicTokenType
+    {
+        End,
+        Identifier,
+        IntLiteral,
+        FloatLiteral,
+        Arg,            ///< `$0` to `$9`
+        ArgPadded,      ///< `$V0` to `$V9`
+        SampledImage,   ///< `$p`
+        AtomicDest,     ///< `$A`
+        Punctuation,
+        Invalid,
+    };
+
+    struct IntrinsicToken
+    {
+        IntrinsicTokenType type = IntrinsicTokenType::End;
+        UnownedStringSlice text;
+        Index argIndex = 0;
+    };
+
+        /// State for evaluating one intrinsic definition
+    struct IntrinsicEvalState
+    {
+        IRCall* call = nullptr;
+        String text;
+        char const* cursor = nullptr;
+        char const* end = nullptr;
+        IntrinsicToken token;
+    };
+
+    IntrinsicEvalState* m_intrinsic = nullptr;
+
+        /// Get the GLSL name of the scalar or vector `type`, as used by `$T` and `$S` escapes
+    static bool _appendGLSLTypeName(IRType* type, StringBuilder& builder)
+    {
+        Index count = 0;
+        auto scalarType = _getScalarType(type, count);
+        if( !scalarType )
+            return false;
+        char const* scalarName = nullptr;
+        char const* vectorPrefix = nullptr;
+        switch( scalarType->op )
+        {
+        case kIROp_BoolType:    scalarName = "bool";    vectorPrefix = "bvec"; break;
+        case kIROp_IntType:     scalarName = "int";     vectorPrefix = "ivec"; break;
+        case kIROp_UIntType:    scalarName = "uint";    vectorPrefix = "uvec"; break;
+        case kIROp_FloatType:   scalarName = "float";   vectorPrefix = "vec"; break;
+        case kIROp_DoubleType:  scalarName = "double";  vectorPrefix = "dvec"; break;
+        default:
+            return false;
+        }
+        if( count == 1 )
+            builder << scalarName;
+        else
+            builder << vectorPrefix << count;
+        return true;
+    }
+
+        /// Expand the escapes in `definition` that only depend on the types of the arguments of `call`.
+        ///
+        /// `$c` and `$z` (which convert the result of texture operations) are removed, as the
+        /// result of a call is always converted to the type of the call.
+    bool _preExpandIntrinsic(IRCall* call, UnownedStringSlice definition, StringBuilder& outText)
+    {
+        char const* cursor = definition.begin();
+        char const* end = definition.end();
+        while( cursor != end )
+        {
+            char c = *cursor++;
+            if( c != '$' || cursor == end )
+            {
+                outText.appendChar(c);
+                continue;
+            }
+            char d = *cursor;
+            switch( d )
+            {
+            case 'c':
+            case 'z':
+                cursor++;
+                break;
+            case 'a':
+                // `$atomicAdd` becomes `imageAtomicAdd` for an image in GLSL, but
+                // the same builtin handles both here.
+                cursor++;
+                outText.appendChar('a');
+                break;
+            case 'N':
+            case 'T':
+            case 'S':
+                {
+                    cursor++;
+                    if( cursor == end || *cursor < '0' || *cursor > '9' )
+                        return false;
+                    UInt argIndex = UInt(*cursor++ - '0');
+                    if( argIndex >= call->getArgCount() )
+                        return false;
+                    IRType* type = call->getArg(argIndex)->getDataType();
+                    if( auto textureType = as<IRTextureTypeBase>(type) )
+                        type = textureType->getElementType();
+                    if( d == 'N' )
+                    {
+                        auto vectorType = as<IRVectorType>(type);
+                        if( !vectorType )
+                            return false;
+                        outText << getIntVal(vectorType->getElementCount());
+                    }
+                    else
+                    {
+                        if( d == 'S' )
+                            type = _getScalarType(type);
+                        if( !type || !_appendGLSLTypeName(type, outText) )
+                            return false;
+                    }
+                }
+                break;
+            default:
+                // Other escapes are handled when tokenizing.
+                outText.appendChar(c);
+                break;
+            }
+        }
+        return true;
+    }
+
+    void _advanceIntrinsicToken()
+    {
+        auto& state = *m_intrinsic;
+        auto& cursor = state.cursor;
+        auto end = state.end;
+        while( cursor != end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\n' || *cursor == '\r') )
+            cursor++;
+
+        IntrinsicToken token;
+        if( cursor == end )
+        {
+            state.token = token;
+            return;
+        }
+
+        char const* start = cursor;
+        char c = *cursor++;
+        if( c == '$' )
+        {
+            token.type = IntrinsicTokenType::Invalid;
+            if( cursor != end )
+            {
+                char d = *cursor++;
+                if( d >= '0' && d <= '9' )
+                {
+                    token.type = IntrinsicTokenType::Arg;
+                    token.argIndex = d - '0';
+                }
+                else if( d == 'V' && cursor != end && *cursor >= '0' && *cursor <= '9' )
+                {
+                    token.type = IntrinsicTokenType::ArgPadded;
+                    token.argIndex = *cursor++ - '0';
+                }
+                else if( d == 'p' )
+                {
+                    token.type = IntrinsicTokenType::SampledImage;
+                }
+                else if( d == 'A' )
+                {
+                    token.type = IntrinsicTokenType::AtomicDest;
+                }
+            }
+        }
+        else if( (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' )
+        {
+            while( cursor != end && ((*cursor >= 'a' && *cursor <= 'z') || (*cursor >= 'A' && *cursor <= 'Z') || (*cursor >= '0' && *cursor <= '9') || *cursor == '_') )
+                cursor++;
+            token.type = IntrinsicTokenType::Identifier;
+        }
+        else if( c >= '0' && c <= '9' )
+        {
+            token.type = IntrinsicTokenType::IntLiteral;
+            while( cursor != end && ((*cursor >= '0' && *cursor <= '9') || *cursor == '.') )
+            {
+                if( *cursor == '.' )
+                    token.type = IntrinsicTokenType::FloatLiteral;
+                cursor++;
+            }
+            // Suffixes don't change how the literal is used, since
+            // literals are converted to the type they are used as.
+            //
+            while( cursor != end && (*cursor == 'u' || *cursor == 'U' || *cursor == 'f' || *cursor == 'F') )
+                cursor++;
+        }
+        else
+        {
+            token.type = IntrinsicTokenType::Punctuation;
+        }
+        token.text = UnownedStringSlice(start, cursor);
+        state.token = token;
+    }
+
+    bool _isIntrinsicPunctuation(char c)
+    {
+        auto& token = m_intrinsic->token;
+        return token.type == IntrinsicTokenType::Punctuation && token.text.getLength() == 1 && token.text[0] == c;
+    }
+
+    bool _expectIntrinsicPunctuation(char c)
+    {
+        if( !_isIntrinsicPunctuation(c) )
+        {
+            _unsupported(m_intrinsic->call, "target intrinsic syntax");
+            return false;
+        }
+        _advanceIntrinsicToken();
+        return true;
+    }
+
+        /// Emit a call to a function with a `[__target_intrinsic]` definition `definition`
+    SpvInst* emitIntrinsicCall(IRCall* call, UnownedStringSlice definition)
+    {
+        IntrinsicEvalState state;
+        state.call = call;
+        IntrinsicEvalState* outerState = m_intrinsic;
+        m_intrinsic = &state;
+
+        IntrinsicValue result;
+        if( definition.getLength() && definition[0] == '.' )
+        {
+            // A member function call (which the GLSL doesn't have any equivalent for).
+            //
+            _unsupported(call, "member function target intrinsic");
+        }
+        else if( CLikeSourceEmitter::isOrdinaryName(definition) )
+        {
+            // Just a function name, so call it with all the arguments.
+            //
+            List<IntrinsicValue> args;
+            for( UInt ii = 0; ii < call->getArgCount(); ++ii )
+                args.add(_getIntrinsicArg(Index(ii)));
+            result = _emitBuiltinCall(definition, args);
+        }
+        else
+        {
+            StringBuilder builder;
+            if( !_preExpandIntrinsic(call, definition, builder) )
+            {
+                _unsupported(call, "target intrinsic escape");
+            }
+            else
+            {
+                state.text = builder.ProduceString();
+                state.cursor = state.text.begin();
+                state.end = state.text.end();
+                _advanceIntrinsicToken();
+                result = _parseIntrinsicSequence();
+                if( state.token.type != IntrinsicTokenType::End )
+                    _unsupported(call, "target intrinsic syntax");
+            }
+        }
+        m_intrinsic = outerState;
+
+        auto callType = call->getDataType();
+        if( hasFailed() )
+            return _getPlaceholderInst();
+        if( callType->op == kIROp_VoidType )
+            return nullptr;
+
+        if( as<IRPtrTypeBase>(callType) )
+        {
+            // The call gives the address of something (e.g. an element of a buffer).
+            //
+            if( !result.isPointer || !result.type )
+                return _unsupported(call, "target intrinsic that doesn't give an address");
+            return result.spv;
+        }
+        return _coerceIntrinsicValue(result, callType);
+    }
+
+        /// Get the argument `index` of the call being evaluated
+    IntrinsicValue _getIntrinsicArg(Index index)
+    {
+        auto call = m_intrinsic->call;
+        IntrinsicValue value;
+        if( index >= Index(call->getArgCount()) )
+        {
+            _unsupported(call, "target intrinsic argument");
+            return value;
+        }
+
+        auto arg = call->getArg(UInt(index));
+        value.irArg = arg;
+        if( arg->op == kIROp_ImageSubscript )
+        {
+            // The subscript of an image can only be used by `$A` (or through
+            // a load or store, which are handled elsewhere).
+            //
+            value.type = arg->getDataType();
+            return value;
+        }
+        value.spv = getValue(arg);
+
+        auto type = arg->getDataType();
+        if( auto ptrType = as<IRPtrTypeBase>(type) )
+        {
+            value.isPointer = true;
+            value.type = ptrType->getValueType();
+        }
+        else if( m_storageBufferArrayTypes.ContainsKey(value.spv) )
+        {
+            // A structured or byte-address buffer, which is used through its `_data`.
+            //
+            value.isPointer = true;
+            value.type = nullptr;
+        }
+        else
+        {
+            value.type = type;
+        }
+        return value;
+    }
+
+        /// Get the SPIR-V value of `value`, loading it if it is a pointer
+    SpvInst* _getIntrinsicRValue(IntrinsicValue const& value)
+    {
+        if( value.isLiteral )
+            return getScalarConstant(value.type, value.literalValue);
+        if( !value.spv || !value.type )
+            return _unsupported(m_intrinsic ? m_intrinsic->call : nullptr, "target intrinsic value");
+        if( value.isPointer )
+            return emitInst(m_currentBlock, nullptr, SpvOpLoad, getType(value.type), kResultID, value.spv);
+        return value.spv;
+    }
+
+        /// Convert `value` to `type`
+    SpvInst* _coerceIntrinsicValue(IntrinsicValue const& value, IRType* type)
+    {
+        if( value.isLiteral && _getScalarType(type) )
+            return getSplatConstant(type, value.literalValue);
+        auto spvValue = _getIntrinsicRValue(value);
+        if( hasFailed() )
+            return spvValue;
+        if( as<IRMatrixType>(type) || !_getScalarType(type) )
+        {
+            if( getType(type) != getType(value.type) )
+                return _unsupported(m_intrinsic ? m_intrinsic->call : nullptr, "target intrinsic value type");
+            return spvValue;
+        }
+        return emitConversion(spvValue, value.type, type);
+    }
+
+    IntrinsicValue _makeIntrinsicValue(SpvInst* spv, IRType* type)
+    {
+        IntrinsicValue value;
+        value.spv = spv;
+        value.type = type;
+        return value;
+    }
+
+        /// sequence := assign ((',' | ';') assign)*
+    IntrinsicValue _parseIntrinsicSequence()
+    {
+        IntrinsicValue value = _parseIntrinsicAssign();
+        while( !hasFailed() && (_isIntrinsicPunctuation(',') || _isIntrinsicPunctuation(';')) )
+        {
+            _advanceIntrinsicToken();
+            if( m_intrinsic->token.type == IntrinsicTokenType::End )
+                break;
+            value = _parseIntrinsicAssign();
+        }
+        return value;
+    }
+
+        /// assign := additive ('=' assign)?
+    IntrinsicValue _parseIntrinsicAssign()
+    {
+        IntrinsicValue left = _parseIntrinsicAdditive();
+        if( hasFailed() || !_isIntrinsicPunctuation('=') )
+            return left;
+        _advanceIntrinsicToken();
+        IntrinsicValue right = _parseIntrinsicAssign();
+        if( hasFailed() )
+            return right;
+        if( !left.isPointer || !left.type )
+        {
+            _unsupported(m_intrinsic->call, "target intrinsic assignment");
+            return right;
+        }
+        auto spvValue = _coerceIntrinsicValue(right, left.type);
+        emitInst(m_currentBlock, nullptr, SpvOpStore, left.spv, spvValue);
+        return _makeIntrinsicValue(spvValue, left.type);
+    }
+
+        /// additive := multiplicative (('+' | '-') multiplicative)*
+    IntrinsicValue _parseIntrinsicAdditive()
+    {
+        IntrinsicValue left = _parseIntrinsicMultiplicative();
+        while( !hasFailed() && (_isIntrinsicPunctuation('+') || _isIntrinsicPunctuation('-')) )
+        {
+            const char op = m_intrinsic->token.text[0];
+            _advanceIntrinsicToken();
+            IntrinsicValue right = _parseIntrinsicMultiplicative();
+            left = _emitIntrinsicArithmetic(op, left, right);
+        }
+        return left;
+    }
+
+        /// multiplicative := unary (('*' | '/') unary)*
+    IntrinsicValue _parseIntrinsicMultiplicative()
+    {
+        IntrinsicValue left = _parseIntrinsicUnary();
+        while( !hasFailed() && (_isIntrinsicPunctuation('*') || _isIntrinsicPunctuation('/')) )
+        {
+            const char op = m_intrinsic->token.text[0];
+            _advanceIntrinsicToken();
+            IntrinsicValue right = _parseIntrinsicUnary();
+            left = _emitIntrinsicArithmetic(op, left, right);
+        }
+        return left;
+    }
+
+        /// unary := '-' unary | postfix
+    IntrinsicValue _parseIntrinsicUnary()
+    {
+        if( _isIntrinsicPunctuation('-') )
+        {
+            _advanceIntrinsicToken();
+            IntrinsicValue operand = _parseIntrinsicUnary();
+            if( operand.isLiteral )
+            {
+                operand.literalValue = -operand.literalValue;
+                return operand;
+            }
+            IntrinsicValue zero;
+            zero.isLiteral = true;
+            zero.type = m_builder.getIntType();
+            return _emitIntrinsicArithmetic('-', zero, operand);
+        }
+        return _parseIntrinsicPostfix();
+    }
+
+        /// Get the rank of a scalar kind for the implicit conversions of GLSL (higher ranks are converted to)
+    static int _getConversionRank(IRType* type)
+    {
+        switch( _getScalarKind(_getScalarType(type)) )
+        {
+        case ScalarKind::Float:         return 3;
+        case ScalarKind::UnsignedInt:   return 2;
+        case ScalarKind::SignedInt:     return 1;
+        default:                        return 0;
+        }
+    }
+
+        /// Get the type an operation on `values` should be done in, following GLSL implicit conversions
+    IRType* _getIntrinsicOperationType(IntrinsicValue const* values, Index count)
+    {
+        IRType* bestType = nullptr;
+        Index bestCount = 0;
+        bool bestIsLiteral = true;
+        for( Index ii = 0; ii < count; ++ii )
+        {
+            auto type = values[ii].type;
+            Index elementCount = 0;
+            if( !type || !_getScalarType(type, elementCount) )
+                return type;
+            const bool isLiteral = values[ii].isLiteral;
+            bool isBetter = !bestType;
+            if( !isBetter && bestIsLiteral != isLiteral )
+                isBetter = bestIsLiteral;
+            else if( !isBetter && elementCount != bestCount )
+                isBetter = elementCount > bestCount;
+            else if( !isBetter )
+                isBetter = _getConversionRank(type) > _getConversionRank(bestType);
+
+            if( isBetter )
+            {
+                bestType = type;
+                bestCount = elementCount;
+                bestIsLiteral = isLiteral;
+            }
+        }
+        if( !bestType )
+            return nullptr;
+
+        // The result has the most elements of any operand (a scalar being replicated).
+        //
+        Index maxCount = 0;
+        for( Index ii = 0; ii < count; ++ii )
+        {
+            Index elementCount = 0;
+            _getScalarType(values[ii].type, elementCount);
+            if( elementCount > maxCount )
+                maxCount = elementCount;
+        }
+        return _getVectorType(_getScalarType(bestType), maxCount);
+    }
+
+    IntrinsicValue _emitIntrinsicArithmetic(char op, IntrinsicValue const& left, IntrinsicValue const& right)
+    {
+        if( hasFailed() )
+            return left;
+
+        if( left.isLiteral && right.isLiteral )
+        {
+            IntrinsicValue result = left;
+            switch( op )
+            {
+            case '+': result.literalValue = left.literalValue + right.literalValue; break;
+            case '-': result.literalValue = left.literalValue - right.literalValue; break;
+            case '*': result.literalValue = left.literalValue * right.literalValue; break;
+            default:
+                _unsupported(m_intrinsic->call, "target intrinsic syntax");
+                break;
+            }
+            return result;
+        }
+
+        auto leftType = left.type;
+        auto rightType = right.type;
+        if( op == '*' && (as<IRMatrixType>(leftType) || as<IRMatrixType>(rightType)) )
+            return _emitIntrinsicMatrixProduct(left, right);
+
+        IntrinsicValue operands[] = { left, right };
+        auto type = _getIntrinsicOperationType(operands, 2);
+        if( !type || !_getScalarType(type) )
+        {
+            _unsupported(m_intrinsic->call, "target intrinsic operand type");
+            return left;
+        }
+
+        OpcodeSet opcodes;
+        bool isComparison = false;
+        IROp irOp = kIROp_Add;
+        switch( op )
+        {
+        case '+': irOp = kIROp_Add; break;
+        case '-': irOp = kIROp_Sub; break;
+        case '*': irOp = kIROp_Mul; break;
+        case '/': irOp = kIROp_Div; break;
+        }
+        _getOpcodeSet(irOp, opcodes, isComparison);
+
+        auto spvLeft = _coerceIntrinsicValue(left, type);
+        auto spvRight = _coerceIntrinsicValue(right, type);
+        return _makeIntrinsicValue(emitBinaryOp(m_intrinsic->call, opcodes, type, type, spvLeft, spvRight), type);
+    }
+
+        /// Emit the GLSL `*` of values where at least one is a matrix, which is a linear algebraic product.
+    IntrinsicValue _emitIntrinsicMatrixProduct(IntrinsicValue const& left, IntrinsicValue const& right)
+    {
+        // [3.32.13: Arithmetic Instructions]
+        //
+        // A Slang `matrix<T,R,C>` is a SPIR-V matrix with `R` columns of `C`
+        // elements (see `_emitType`), so in the terms of SPIR-V it has `C` rows.
+        //
+        auto leftMatrix = as<IRMatrixType>(left.type);
+        auto rightMatrix = as<IRMatrixType>(right.type);
+        auto spvLeft = _getIntrinsicRValue(left);
+        auto spvRight = _getIntrinsicRValue(right);
+        if( hasFailed() )
+            return left;
+
+        if( leftMatrix && rightMatrix )
+        {
+            // > OpMatrixTimesMatrix
+            //
+            auto resultType = m_builder.getMatrixType(leftMatrix->getElementType(), rightMatrix->getRowCount(), leftMatrix->getColumnCount());
+            return _makeIntrinsicValue(emitInst(m_currentBlock, nullptr, SpvOpMatrixTimesMatrix, getType(resultType), kResultID, spvLeft, spvRight), resultType);
+        }
+
+        auto matrixType = leftMatrix ? leftMatrix : rightMatrix;
+        auto otherType = leftMatrix ? right.type : left.type;
+        Index otherCount = 0;
+        if( !_getScalarType(otherType, otherCount) )
+        {
+            _unsupported(m_intrinsic->call, "matrix product operand");
+            return left;
+        }
+
+        if( otherCount == 1 )
+        {
+            // > OpMatrixTimesScalar
+            //
+            auto scalar = leftMatrix ? _coerceIntrinsicValue(right, matrixType->getElementType()) : _coerceIntrinsicValue(left, matrixType->getElementType());
+            auto matrix = leftMatrix ? spvLeft : spvRight;
+            return _makeIntrinsicValue(emitInst(m_currentBlock, nullptr, SpvOpMatrixTimesScalar, getType(matrixType), kResultID, matrix, scalar), matrixType);
+        }
+
+        const Index rowCount = Index(getIntVal(matrixType->getRowCount()));
+        const Index columnCount = Index(getIntVal(matrixType->getColumnCount()));
+        if( leftMatrix )
+        {
+            // > OpMatrixTimesVector: the vector has one element per SPIR-V column.
+            //
+            auto vectorType = _getVectorType(matrixType->getElementType(), rowCount);
+            auto resultType = _getVectorType(matrixType->getElementType(), columnCount);
+            auto vector = _coerceIntrinsicValue(right, vectorType);
+            return _makeIntrinsicValue(emitInst(m_currentBlock, nullptr, SpvOpMatrixTimesVector, getType(resultType), kResultID, spvLeft, vector), resultType);
+        }
+
+        // > OpVectorTimesMatrix: the vector has one element per SPIR-V row.
+        //
+        auto vectorType = _getVectorType(matrixType->getElementType(), columnCount);
+        auto resultType = _getVectorType(matrixType->getElementType(), rowCount);
+        auto vector = _coerceIntrinsicValue(left, vectorType);
+        return _makeIntrinsicValue(emitInst(m_currentBlock, nullptr, SpvOpVectorTimesMatrix, getType(resultType), kResultID, vector, spvRight), resultType);
+    }
+
+        /// postfix := primary ('.' identifier ('(' ')')? | '[' sequence ']')*
+    IntrinsicValue _parseIntrinsicPostfix()
+    {
+        IntrinsicValue value = _parseIntrinsicPrimary();
+        for( ;; )
+        {
+            if( hasFailed() )
+                return value;
+
+            if( _isIntrinsicPunctuation('.') )
+            {
+                _advanceIntrinsicToken();
+                auto& token = m_intrinsic->token;
+                if( token.type != IntrinsicTokenType::Identifier )
+                {
+                    _unsupported(m_intrinsic->call, "target intrinsic syntax");
+                    return value;
+                }
+                auto name = token.text;
+                _advanceIntrinsicToken();
+
+                if( _isIntrinsicPunctuation('(') )
+                {
+                    _advanceIntrinsicToken();
+                    if( !_expectIntrinsicPunctuation(')') )
+                        return value;
+                    value = _emitIntrinsicMethodCall(value, name);
+                }
+                else
+                {
+                    value = _emitIntrinsicMember(value, name);
+                }
+                continue;
+            }
+
+            if( _isIntrinsicPunctuation('[') )
+            {
+                _advanceIntrinsicToken();
+                IntrinsicValue index = _parseIntrinsicSequence();
+                if( !_expectIntrinsicPunctuation(']') )
+                    return value;
+                value = _emitIntrinsicIndex(value, index);
+                continue;
+            }
+
+            return value;
+        }
+    }
+
+        /// Emit `value.name`, which is either the `_data` of a buffer or a swizzle
+    IntrinsicValue _emitIntrinsicMember(IntrinsicValue const& value, UnownedStringSlice const& name)
+    {
+        if( value.isPointer && !value.type )
+        {
+            // The `_data` of a structured or byte-address buffer is the
+            // runtime array that is the only member of its block.
+            //
+            IRType* arrayType = nullptr;
+            if( name != "_data" || !m_storageBufferArrayTypes.TryGetValue(value.spv, arrayType) )
+            {
+                _unsupported(m_intrinsic->call, "buffer member");
+                return value;
+            }
+            List<SpvWord> indices;
+            indices.add(getID(getIntConstant(0)));
+            IntrinsicValue result;
+            result.spv = emitAccessChain(nullptr, value.spv, arrayType, indices);
+            result.type = arrayType;
+            result.isPointer = true;
+            result.irArg = value.irArg;
+            return result;
+        }
+
+        // Anything else is a swizzle.
+        //
+        Index count = 0;
+        auto scalarType = value.type ? _getScalarType(value.type, count) : nullptr;
+        if( !scalarType || name.getLength() > 4 )
+        {
+            _unsupported(m_intrinsic->call, "target intrinsic member");
+            return value;
+        }
+
+        List<SpvWord> components;
+        for( auto c : name )
+        {
+            Index index = -1;
+            switch( c )
+            {
+            case 'x': case 'r': case 's': index = 0; break;
+            case 'y': case 'g': case 't': index = 1; break;
+            case 'z': case 'b': case 'p': index = 2; break;
+            case 'w': case 'a': case 'q': index = 3; break;
+            }
+            if( index < 0 || index >= count )
+            {
+                _unsupported(m_intrinsic->call, "target intrinsic swizzle");
+                return value;
+            }
+            components.add(SpvWord(index));
+        }
+
+        auto spvValue = _getIntrinsicRValue(value);
+        auto resultType = _getVectorType(scalarType, components.getCount());
+        if( count == 1 )
+            return _makeIntrinsicValue(emitSplat(spvValue, resultType, components.getCount()), resultType);
+        if( components.getCount() == 1 )
+            return _makeIntrinsicValue(emitInst(m_currentBlock, nullptr, SpvOpCompositeExtract, getType(resultType), kResultID, spvValue, components[0]), resultType);
+        return _makeIntrinsicValue(emitInst(m_currentBlock, nullptr, SpvOpVectorShuffle, getType(resultType), kResultID, spvValue, spvValue, OperandWords(components)), resultType);
+    }
+
+        /// Emit `value.name()`
+    IntrinsicValue _emitIntrinsicMethodCall(IntrinsicValue const& value, UnownedStringSlice const& name)
+    {
+        // [3.32.8: Memory Instructions]
+        //
+        // > OpArrayLength: Length of a run-time array.
+        //
+        // The only method used is `length()` of the runtime array of a buffer,
+        // which needs the block variable, and the index of the array in it.
+        //
+        if( name == "length" && value.isPointer && as<IRUnsizedArrayType>(value.type) && value.spv->opcode == SpvOpAccessChain && value.spv->operandWordsCount >= 3 )
+        {
+            const SpvWord blockID = value.spv->operandWords[2];
+            auto uintType = m_builder.getUIntType();
+            auto spvLength = emitInst(m_currentBlock, nullptr, SpvOpArrayLength, getType(uintType), kResultID, blockID, SpvWord(0));
+            return _makeIntrinsicValue(spvLength, uintType);
+        }
+        _unsupported(m_intrinsic->call, "target intrinsic method");
+        return value;
+    }
+
+        /// Emit `value[index]`
+    IntrinsicValue _emitIntrinsicIndex(IntrinsicValue const& value, IntrinsicValue const& index)
+    {
+        IRType* elementType = nullptr;
+        if( auto arrayType = as<IRArrayTypeBase>(value.type) )
+            elementType = arrayType->getElementType();
+        else if( auto vectorType = as<IRVectorType>(value.type) )
+            elementType = vectorType->getElementType();
+        else if( auto matrixType = as<IRMatrixType>(value.type) )
+            elementType = _getVectorType(matrixType->getElementType(), Index(getIntVal(matrixType->getColumnCount())));
+        if( !elementType )
+        {
+            _unsupported(m_intrinsic->call, "target intrinsic index");
+            return value;
+        }
+
+        Index indexCount = 0;
+        auto indexScalarType = index.type ? _getScalarType(index.type, indexCount) : nullptr;
+        if( !indexScalarType || indexCount != 1 || _getScalarKind(indexScalarType) == ScalarKind::Float || _getScalarKind(indexScalarType) == ScalarKind::Bool )
+        {
+            _unsupported(m_intrinsic->call, "target intrinsic index type");
+            return value;
+        }
+        auto spvIndex = index.isLiteral ? getIntConstant(int32_t(index.literalValue)) : _getIntrinsicRValue(index);
+
+        if( value.isPointer )
+        {
+            List<SpvWord> indices;
+            indices.add(getID(spvIndex));
+            IntrinsicValue result;
+            result.spv = emitAccessChain(nullptr, value.spv, elementType, indices);
+            result.type = elementType;
+            result.isPointer = true;
+            return result;
+        }
+
+        auto spvValue = _getIntrinsicRValue(value);
+        if( index.isLiteral )
+            return _makeIntrinsicValue(emitInst(m_currentBlock, nullptr, SpvOpCompositeExtract, getType(elementType), kResultID, spvValue, SpvWord(index.literalValue)), elementType);
+        if( as<IRVectorType>(value.type) )
+            return _makeIntrinsicValue(emitInst(m_currentBlock, nullptr, SpvOpVectorExtractDynamic, getType(elementType), kResultID, spvValue, spvIndex), elementType);
+        _unsupported(m_intrinsic->call, "dynamic index of a value");
+        return value;
+    }
+
+        /// primary := '$n' | '$Vn' | '$p' | '$A' | number | identifier ('(' arguments ')')? | '(' sequence ')'
+    IntrinsicValue _parseIntrinsicPrimary()
+    {
+        auto token = m_intrinsic->token;
+        auto call = m_intrinsic->call;
+        switch( token.type )
+        {
+        case IntrinsicTokenType::Arg:
+            _advanceIntrinsicToken();
+            return _getIntrinsicArg(token.argIndex);
+
+        case IntrinsicTokenType::ArgPadded:
+            {
+                // `$Vn` pads the argument out to a 4 element vector.
+                //
+                _advanceIntrinsicToken();
+                IntrinsicValue arg = _getIntrinsicArg(token.argIndex);
+                auto scalarType = arg.type ? _getScalarType(arg.type) : nullptr;
+                if( !scalarType )
+                {
+                    _unsupported(call, "target intrinsic argument type");
+                    return arg;
+                }
+                auto texelType = _getVectorType(scalarType, 4);
+                return _makeIntrinsicValue(_emitPadded(call, _getIntrinsicRValue(arg), arg.type, 4), texelType);
+            }
+
+        case IntrinsicTokenType::SampledImage:
+            {
+                // [3.32.10: Image Instructions]
+                //
+                // > OpSampledImage: Create a sampled image, containing both a sampler and an image.
+                //
+                _advanceIntrinsicToken();
+                IntrinsicValue texture = _getIntrinsicArg(0);
+                IntrinsicValue sampler = _getIntrinsicArg(1);
+                auto textureType = as<IRTextureType>(texture.type);
+                if( !textureType || !as<IRSamplerStateTypeBase>(sampler.type) || !texture.spv || !sampler.spv )
+                {
+                    _unsupported(call, "sampled image");
+                    return texture;
+                }
+                auto spvImageType = getImageType(textureType, texture.irArg);
+                auto spvSampledImage = emitInst(m_currentBlock, nullptr, SpvOpSampledImage, getSampledImageType(spvImageType), kResultID, texture.spv, sampler.spv);
+                IntrinsicValue result = _makeIntrinsicValue(spvSampledImage, textureType);
+                result.irArg = texture.irArg;
+                return result;
+            }
+
+        case IntrinsicTokenType::AtomicDest:
+            {
+                _advanceIntrinsicToken();
+                return _getAtomicDest(_getIntrinsicArg(0));
+            }
+
+        case IntrinsicTokenType::IntLiteral:
+        case IntrinsicTokenType::FloatLiteral:
+            {
+                _advanceIntrinsicToken();
+                IntrinsicValue value;
+                value.isLiteral = true;
+                value.type = (token.type == IntrinsicTokenType::IntLiteral) ? m_builder.getIntType() : m_builder.getBasicType(BaseType::Float);
+                value.literalValue = StringToDouble(String(token.text));
+                return value;
+            }
+
+        case IntrinsicTokenType::Identifier:
+            {
+                _advanceIntrinsicToken();
+                if( token.text == "true" || token.text == "false" )
+                {
+                    IntrinsicValue value;
+                    value.isLiteral = true;
+                    value.type = m_builder.getBoolType();
+                    value.literalValue = (token.text == "true") ? 1 : 0;
+                    return value;
+                }
+
+                List<IntrinsicValue> args;
+                if( !_expectIntrinsicPunctuation('(') )
+                    return IntrinsicValue();
+                if( !_isIntrinsicPunctuation(')') )
+                {
+                    for( ;; )
+                    {
+                        args.add(_parseIntrinsicAssign());
+                        if( hasFailed() )
+                            return IntrinsicValue();
+                        if( !_isIntrinsicPunctuation(',') )
+                            break;
+                        _advanceIntrinsicToken();
+                    }
+                }
+                if( !_expectIntrinsicPunctuation(')') )
+                    return IntrinsicValue();
+                return _emitBuiltinCall(token.text, args);
+            }
+
+        case IntrinsicTokenType::Punctuation:
+            if( _isIntrinsicPunctuation('(') )
+            {
+                _advanceIntrinsicToken();
+                IntrinsicValue value = _parseIntrinsicSequence();
+                _expectIntrinsicPunctuation(')');
+                return value;
+            }
+            break;
+
+        default:
+            break;
+        }
+        _unsupported(call, "target intrinsic syntax");
+        return IntrinsicValue();
+    }
+
+        /// Pad the scalar or vector `value` of `type` to `count` elements with zeros
+    SpvInst* _emitPadded(IRInst* irInst, SpvInst* value, IRType* type, Index count)
+    {
+        Index valueCount = 0;
+        auto scalarType = _getScalarType(type, valueCount);
+        if( !scalarType || valueCount > count )
+            return _unsupported(irInst, "padded value type");
+        if( valueCount == count )
+            return value;
+        List<SpvWord> constituents;
+        constituents.add(getID(value));
+        auto zero = getScalarConstant(scalarType, 0);
+        for( Index ii = valueCount; ii < count; ++ii )
+            constituents.add(getID(zero));
+        return emitInst(m_currentBlock, nullptr, SpvOpCompositeConstruct, getType(_getVectorType(scalarType, count)), kResultID, OperandWords(constituents));
+    }
+
+        /// Get the pointer that an atomic operation on `dest` applies to
+    IntrinsicValue _getAtomicDest(IntrinsicValue const& dest)
+    {
+        auto irArg = dest.irArg;
+        if( irArg && irArg->op == kIROp_ImageSubscript )
+        {
+            // [3.32.10: Image Instructions]
+            //
+            // > OpImageTexelPointer: Form a pointer to a texel of an image. Use of such
+            // > a pointer is limited to atomic operations.
+            //
+            // This needs the variable for the image, rather than its value.
+            //
+            auto irImage = irArg->getOperand(0);
+            MaterializeInfo* info = nullptr;
+            if( irImage->op == kIROp_GlobalParam )
+            {
+                ensureInst(irImage);
+                info = m_materializeInfos.TryGetValue(irImage);
+            }
+            auto textureType = as<IRTextureType>(irImage->getDataType());
+            if( !info || !textureType )
+            {
+                _unsupported(m_intrinsic->call, "atomic on image");
+                return dest;
+            }
+            auto scalarType = _getScalarType(textureType->getElementType());
+            auto coords = _emitImageCoords(irArg->getOperand(1));
+            IntrinsicValue result;
+            result.spv = emitInst(m_currentBlock, nullptr, SpvOpImageTexelPointer, getPointerType(scalarType, SpvStorageClassImage), kResultID, info->spvVar, coords, getUIntConstant(0));
+            m_storageClasses[result.spv] = SpvStorageClassImage;
+            result.type = scalarType;
+            result.isPointer = true;
+            return result;
+        }
+        if( !dest.isPointer )
+            _unsupported(m_intrinsic->call, "atomic on a value");
+        return dest;
+    }
+
+    // The GLSL builtin functions used by intrinsic definitions. Most of the
+    // math functions are instructions in the `GLSL.std.450` extended
+    // instruction set, which depend on the kind of their operands.
+
+    struct GLSLStd450Info
+    {
+        char const* name;
+        int floatOp;
+        int signedOp;
+        int unsignedOp;
+        int argCount;
+    };
+
+    static GLSLStd450Info const* _findGLSLStd450(UnownedStringSlice const& name, Index argCount)
+    {
+        static const GLSLStd450Info kInfos[] =
+        {
+            { "round",          GLSLstd450Round,        -1, -1, 1 },
+            { "roundEven",      GLSLstd450RoundEven,    -1, -1, 1 },
+            { "trunc",          GLSLstd450Trunc,        -1, -1, 1 },
+            { "abs",            GLSLstd450FAbs,         GLSLstd450SAbs, -1, 1 },
+            { "sign",           GLSLstd450FSign,        GLSLstd450SSign, -1, 1 },
+            { "floor",          GLSLstd450Floor,        -1, -1, 1 },
+            { "ceil",           GLSLstd450Ceil,         -1, -1, 1 },
+            { "fract",          GLSLstd450Fract,        -1, -1, 1 },
+            { "radians",        GLSLstd450Radians,      -1, -1, 1 },
+            { "degrees",        GLSLstd450Degrees,      -1, -1, 1 },
+            { "sin",            GLSLstd450Sin,          -1, -1, 1 },
+            { "cos",            GLSLstd450Cos,          -1, -1, 1 },
+            { "tan",            GLSLstd450Tan,          -1, -1, 1 },
+            { "asin",           GLSLstd450Asin,         -1, -1, 1 },
+            { "acos",           GLSLstd450Acos,         -1, -1, 1 },
+            { "atan",           GLSLstd450Atan,         -1, -1, 1 },
+            { "atan",           GLSLstd450Atan2,        -1, -1, 2 },
+            { "sinh",           GLSLstd450Sinh,         -1, -1, 1 },
+            { "cosh",           GLSLstd450Cosh,         -1, -1, 1 },
+            { "tanh",           GLSLstd450Tanh,         -1, -1, 1 },
+            { "asinh",          GLSLstd450Asinh,        -1, -1, 1 },
+            { "acosh",          GLSLstd450Acosh,        -1, -1, 1 },
+            { "atanh",          GLSLstd450Atanh,        -1, -1, 1 },
+            { "pow",            GLSLstd450Pow,          -1, -1, 2 },
+            { "exp",            GLSLstd450Exp,          -1, -1, 1 },
+            { "log",            GLSLstd450Log,          -1, -1, 1 },
+            { "exp2",           GLSLstd450Exp2,         -1, -1, 1 },
+            { "log2",           GLSLstd450Log2,         -1, -1, 1 },
+            { "sqrt",           GLSLstd450Sqrt,         -1, -1, 1 },
+            { "inversesqrt",    GLSLstd450InverseSqrt,  -1, -1, 1 },
+            { "min",            GLSLstd450FMin,         GLSLstd450SMin, GLSLstd450UMin, 2 },
+            { "max",            GLSLstd450FMax,         GLSLstd450SMax, GLSLstd450UMax, 2 },
+            { "clamp",          GLSLstd450FClamp,       GLSLstd450SClamp, GLSLstd450UClamp, 3 },
+            { "mix",            GLSLstd450FMix,         -1, -1, 3 },
+            { "step",           GLSLstd450Step,         -1, -1, 2 },
+            { "smoothstep",     GLSLstd450SmoothStep,   -1, -1, 3 },
+            { "fma",            GLSLstd450Fma,          -1, -1, 3 },
+            { "cross",          GLSLstd450Cross,        -1, -1, 2 },
+            { "normalize",      GLSLstd450Normalize,    -1, -1, 1 },
+            { "faceforward",    GLSLstd450FaceForward,  -1, -1, 3 },
+            { "reflect",        GLSLstd450Reflect,      -1, -1, 2 },
+            { "findLSB",        -1,                     GLSLstd450FindILsb, GLSLstd450FindILsb, 1 },
+            { "findMSB",        -1,                     GLSLstd450FindSMsb, GLSLstd450FindUMsb, 1 },
+        };
+        for( auto const& info : kInfos )
+        {
+            if( info.argCount == argCount && name == UnownedStringSlice(info.name) )
+                return &info;
+        }
+        return nullptr;
+    }
+
+        /// Emit an `OpExtInst` from `GLSL.std.450`, with operands converted to `operandType`
+    IntrinsicValue _emitGLSLStd450(int instruction, IRType* resultType, IRType* operandType, List<IntrinsicValue> const& args)
+    {
+        List<SpvWord> operands;
+        operands.add(getID(getGLSLStd450()));
+        operands.add(SpvWord(instruction));
+        for( auto const& arg : args )
+            operands.add(getID(_coerceIntrinsicValue(arg, operandType)));
+        return _makeIntrinsicValue(emitInst(m_currentBlock, nullptr, SpvOpExtInst, getType(resultType), kResultID, OperandWords(operands)), resultType);
+    }
+
+        /// Get the type of a constructor named `name` (e.g. `vec3`), or nullptr if it isn't one
+    IRType* _getConstructorType(UnownedStringSlice const& name)
+    {
+        struct Entry { char const* prefix; BaseType baseType; };
+        static const Entry kEntries[] =
+        {
+            { "bvec", BaseType::Bool },
+            { "ivec", BaseType::Int },
+            { "uvec", BaseType::UInt },
+            { "dvec", BaseType::Double },
+            { "vec", BaseType::Float },
+        };
+        if( name == "float" ) return m_builder.getBasicType(BaseType::Float);
+        if( name == "int" ) return m_builder.getIntType();
+        if( name == "uint" ) return m_builder.getUIntType();
+        if( name == "bool" ) return m_builder.getBoolType();
+        if( name == "double" ) return m_builder.getBasicType(BaseType::Double);
+        for( auto const& entry : kEntries )
+        {
+            const Index prefixLength = Index(::strlen(entry.prefix));
+            if( name.getLength() != prefixLength + 1 || !name.startsWith(UnownedStringSlice(entry.prefix)) )
+                continue;
+            const char c = name[prefixLength];
+            if( c < '2' || c > '4' )
+                return nullptr;
+            return _getVectorType(m_builder.getBasicType(entry.baseType), c - '0');
+        }
+        return nullptr;
+    }
 
-        /// Emit an instruction that is local to the body of the given `parent`.
-    SpvInst* emitLocalInst(SpvInstParent* parent, IRInst* inst)
+        /// Emit the GLSL builtin function `name` applied to `args`
+    IntrinsicValue _emitBuiltinCall(UnownedStringSlice const& name, List<IntrinsicValue>& args)
     {
-        switch( inst->op )
+        auto call = m_intrinsic->call;
+        if( hasFailed() )
+            return IntrinsicValue();
+        const Index argCount = args.getCount();
+
+        // Constructors
+        //
+        if( auto constructorType = _getConstructorType(name) )
         {
-        default:
-            SLANG_UNIMPLEMENTED_X("unhandled instruction opcode");
-            break;
+            if( argCount == 1 )
+                return _makeIntrinsicValue(_coerceIntrinsicValue(args[0], constructorType), constructorType);
 
-        // [3.32.17. Control-Flow Instructions]
+            auto scalarType = _getScalarType(constructorType);
+            List<SpvWord> constituents;
+            Index total = 0;
+            for( auto const& arg : args )
+            {
+                Index count = 0;
+                if( !arg.type || !_getScalarType(arg.type, count) )
+                {
+                    _unsupported(call, "constructor argument");
+                    return IntrinsicValue();
+                }
+                constituents.add(getID(_coerceIntrinsicValue(arg, _getVectorType(scalarType, count))));
+                total += count;
+            }
+            Index constructorCount = 0;
+            _getScalarType(constructorType, constructorCount);
+            if( total != constructorCount )
+            {
+                _unsupported(call, "constructor arguments");
+                return IntrinsicValue();
+            }
+            return _makeIntrinsicValue(emitInst(m_currentBlock, nullptr, SpvOpCompositeConstruct, getType(constructorType), kResultID, OperandWords(constituents)), constructorType);
+        }
+
+        // [GLSL.std.450]
         //
-        // > OpReturn
-        case kIROp_ReturnVoid: return emitInst(parent, inst, SpvOpReturn);
+        if( auto info = _findGLSLStd450(name, argCount) )
+        {
+            // `mix` with a `bool` selector picks one of the values.
+            //
+            if( name == "mix" && _getScalarKind(_getScalarType(args[2].type)) == ScalarKind::Bool )
+            {
+                IntrinsicValue values[] = { args[0], args[1] };
+                auto type = _getIntrinsicOperationType(values, 2);
+                Index count = 0;
+                _getScalarType(type, count);
+                auto selector = _coerceIntrinsicValue(args[2], _getBoolVectorType(count));
+                auto spvFalse = _coerceIntrinsicValue(args[0], type);
+                auto spvTrue = _coerceIntrinsicValue(args[1], type);
+                return _makeIntrinsicValue(emitInst(m_currentBlock, nullptr, SpvOpSelect, getType(type), kResultID, selector, spvTrue, spvFalse), type);
+            }
+
+            auto type = _getIntrinsicOperationType(args.getBuffer(), argCount);
+            if( !type || !_getScalarType(type) )
+            {
+                _unsupported(call, "builtin function argument type");
+                return IntrinsicValue();
+            }
+            int instruction = -1;
+            switch( _getScalarKind(_getScalarType(type)) )
+            {
+            case ScalarKind::Float:         instruction = info->floatOp; break;
+            case ScalarKind::SignedInt:     instruction = info->signedOp; break;
+            case ScalarKind::UnsignedInt:   instruction = (info->unsignedOp >= 0 || info->signedOp < 0) ? info->unsignedOp : -2; break;
+            default:                        break;
+            }
+            if( instruction == -2 )
+            {
+                // `abs` and `sign` of unsigned values (only `abs` is meaningful)
+                //
+                if( name == "abs" )
+                    return _makeIntrinsicValue(_coerceIntrinsicValue(args[0], type), type);
+                instruction = -1;
+            }
+            if( instruction < 0 )
+            {
+                _unsupported(call, "builtin function argument type");
+                return IntrinsicValue();
+            }
+            return _emitGLSLStd450(instruction, type, type, args);
+        }
+
+        if( name == "length" || name == "distance" )
+        {
+            auto type = _getIntrinsicOperationType(args.getBuffer(), argCount);
+            if( !type || _getScalarKind(_getScalarType(type)) != ScalarKind::Float || argCount != (name == "length" ? 1 : 2) )
+            {
+                _unsupported(call, "builtin function argument type");
+                return IntrinsicValue();
+            }
+            return _emitGLSLStd450(name == "length" ? GLSLstd450Length : GLSLstd450Distance, _getScalarType(type), type, args);
+        }
+
+        if( name == "refract" && argCount == 3 )
+        {
+            IntrinsicValue vectors[] = { args[0], args[1] };
+            auto type = _getIntrinsicOperationType(vectors, 2);
+            List<SpvWord> operands;
+            operands.add(getID(getGLSLStd450()));
+            operands.add(SpvWord(GLSLstd450Refract));
+            operands.add(getID(_coerceIntrinsicValue(args[0], type)));
+            operands.add(getID(_coerceIntrinsicValue(args[1], type)));
+            operands.add(getID(_coerceIntrinsicValue(args[2], _getScalarType(type))));
+            return _makeIntrinsicValue(emitInst(m_currentBlock, nullptr, SpvOpExtInst, getType(type), kResultID, OperandWords(operands)), type);
+        }
+
+        if( name == "determinant" || name == "inverse" )
+        {
+            auto matrixType = argCount == 1 ? as<IRMatrixType>(args[0].type) : nullptr;
+            if( !matrixType || getIntVal(matrixType->getRowCount()) != getIntVal(matrixType->getColumnCount()) )
+            {
+                _unsupported(call, "builtin function argument type");
+                return IntrinsicValue();
+            }
+            if( name == "determinant" )
+                return _emitGLSLStd450(GLSLstd450Determinant, matrixType->getElementType(), matrixType, args);
+            return _emitGLSLStd450(GLSLstd450MatrixInverse, matrixType, matrixType, args);
+        }
+
+        // Core instructions
+        //
+        if( name == "dot" && argCount == 2 )
+        {
+            auto type = _getIntrinsicOperationType(args.getBuffer(), argCount);
+            auto scalarType = type ? _getScalarType(type) : nullptr;
+            if( !scalarType || _getScalarKind(scalarType) != ScalarKind::Float )
+            {
+                _unsupported(call, "dot product of integers");
+                return IntrinsicValue();
+            }
+            auto left = _coerceIntrinsicValue(args[0], type);
+            auto right = _coerceIntrinsicValue(args[1], type);
+            if( scalarType == type )
+                return _makeIntrinsicValue(emitInst(m_currentBlock, nullptr, SpvOpFMul, getType(type), kResultID, left, right), type);
+            return _makeIntrinsicValue(emitInst(m_currentBlock, nullptr, SpvOpDot, getType(scalarType), kResultID, left, right), scalarType);
+        }
+
+        if( name == "transpose" && argCount == 1 )
+        {
+            auto matrixType = as<IRMatrixType>(args[0].type);
+            if( !matrixType )
+            {
+                _unsupported(call, "builtin function argument type");
+                return IntrinsicValue();
+            }
+            auto resultType = m_builder.getMatrixType(matrixType->getElementType(), matrixType->getColumnCount(), matrixType->getRowCount());
+            return _makeIntrinsicValue(emitInst(m_currentBlock, nullptr, SpvOpTranspose, getType(resultType), kResultID, _getIntrinsicRValue(args[0])), resultType);
+        }
+
+        if( name == "mod" && argCount == 2 )
+        {
+            // GLSL `mod` is `x - y * floor(x/y)`, which is `OpFMod`.
+            //
+            auto type = _getIntrinsicOperationType(args.getBuffer(), argCount);
+            if( !type || _getScalarKind(_getScalarType(type)) != ScalarKind::Float )
+            {
+                _unsupported(call, "builtin function argument type");
+                return IntrinsicValue();
+            }
+            return _makeIntrinsicValue(emitInst(m_currentBlock, nullptr, SpvOpFMod, getType(type), kResultID, _coerceIntrinsicValue(args[0], type), _coerceIntrinsicValue(args[1], type)), type);
+        }
+
+        {
+            // Functions of one operand that map to an instruction with the same type of result,
+            // or a `bool` result.
+            //
+            struct UnaryInfo { char const* name; SpvOp opcode; bool isBoolResult; bool isFloatOnly; SpvCapability capability; };
+            static const UnaryInfo kUnaryInfos[] =
+            {
+                { "dFdx",           SpvOpDPdx,          false, true, SpvCapabilityShader },
+                { "dFdy",           SpvOpDPdy,          false, true, SpvCapabilityShader },
+                { "fwidth",         SpvOpFwidth,        false, true, SpvCapabilityShader },
+                { "dFdxFine",       SpvOpDPdxFine,      false, true, SpvCapabilityDerivativeControl },
+                { "dFdyFine",       SpvOpDPdyFine,      false, true, SpvCapabilityDerivativeControl },
+                { "fwidthFine",     SpvOpFwidthFine,    false, true, SpvCapabilityDerivativeControl },
+                { "dFdxCoarse",     SpvOpDPdxCoarse,    false, true, SpvCapabilityDerivativeControl },
+                { "dFdyCoarse",     SpvOpDPdyCoarse,    false, true, SpvCapabilityDerivativeControl },
+                { "fwidthCoarse",   SpvOpFwidthCoarse,  false, true, SpvCapabilityDerivativeControl },
+                { "isnan",          SpvOpIsNan,         true,  true, SpvCapabilityShader },
+                { "isinf",          SpvOpIsInf,         true,  true, SpvCapabilityShader },
+                { "bitfieldReverse",SpvOpBitReverse,    false, false, SpvCapabilityShader },
+                { "bitCount",       SpvOpBitCount,      false, false, SpvCapabilityShader },
+            };
+            for( auto const& info : kUnaryInfos )
+            {
+                if( argCount != 1 || name != UnownedStringSlice(info.name) )
+                    continue;
+                Index count = 0;
+                auto scalarType = args[0].type ? _getScalarType(args[0].type, count) : nullptr;
+                const auto kind = _getScalarKind(scalarType);
+                const bool isValid = info.isFloatOnly ? (kind == ScalarKind::Float) : (kind == ScalarKind::SignedInt || kind == ScalarKind::UnsignedInt);
+                if( !isValid )
+                {
+                    _unsupported(call, "builtin function argument type");
+                    return IntrinsicValue();
+                }
+                requireCapability(info.capability);
+                auto resultType = info.isBoolResult ? _getBoolVectorType(count) : args[0].type;
+                return _makeIntrinsicValue(emitInst(m_currentBlock, nullptr, info.opcode, getType(resultType), kResultID, _getIntrinsicRValue(args[0])), resultType);
+            }
+        }
+
+        {
+            // Reinterpreting the bits of values.
+            //
+            struct BitcastInfo { char const* name; BaseType toType; };
+            static const BitcastInfo kBitcastInfos[] =
+            {
+                { "floatBitsToInt",     BaseType::Int },
+                { "floatBitsToUint",    BaseType::UInt },
+                { "intBitsToFloat",     BaseType::Float },
+                { "uintBitsToFloat",    BaseType::Float },
+            };
+            for( auto const& info : kBitcastInfos )
+            {
+                if( argCount != 1 || name != UnownedStringSlice(info.name) )
+                    continue;
+                Index count = 0;
+                if( !args[0].type || !_getScalarType(args[0].type, count) )
+                {
+                    _unsupported(call, "builtin function argument type");
+                    return IntrinsicValue();
+                }
+                auto resultType = _getVectorType(m_builder.getBasicType(info.toType), count);
+                auto value = _getIntrinsicRValue(args[0]);
+                if( getType(args[0].type) == getType(resultType) )
+                    return _makeIntrinsicValue(value, resultType);
+                return _makeIntrinsicValue(emitInst(m_currentBlock, nullptr, SpvOpBitcast, getType(resultType), kResultID, value), resultType);
+            }
+        }
+
+        if( (name == "all" || name == "any" || name == "not") && argCount == 1 )
+        {
+            Index count = 0;
+            if( !args[0].type || !_getScalarType(args[0].type, count) )
+            {
+                _unsupported(call, "builtin function argument type");
+                return IntrinsicValue();
+            }
+            auto boolType = _getBoolVectorType(count);
+            auto value = _coerceIntrinsicValue(args[0], boolType);
+            if( name == "not" )
+                return _makeIntrinsicValue(emitInst(m_currentBlock, nullptr, SpvOpLogicalNot, getType(boolType), kResultID, value), boolType);
+            if( count == 1 )
+                return _makeIntrinsicValue(value, boolType);
+            auto resultType = m_builder.getBoolType();
+            return _makeIntrinsicValue(emitInst(m_currentBlock, nullptr, (name == "all") ? SpvOpAll : SpvOpAny, getType(resultType), kResultID, value), resultType);
+        }
+
+        {
+            // Component-wise comparisons of vectors.
+            //
+            struct CompareInfo { char const* name; IROp op; };
+            static const CompareInfo kCompareInfos[] =
+            {
+                { "equal",              kIROp_Eql },
+                { "notEqual",           kIROp_Neq },
+                { "lessThan",           kIROp_Less },
+                { "lessThanEqual",      kIROp_Leq },
+                { "greaterThan",        kIROp_Greater },
+                { "greaterThanEqual",   kIROp_Geq },
+            };
+            for( auto const& info : kCompareInfos )
+            {
+                if( argCount != 2 || name != UnownedStringSlice(info.name) )
+                    continue;
+                auto type = _getIntrinsicOperationType(args.getBuffer(), argCount);
+                Index count = 0;
+                if( !type || !_getScalarType(type, count) )
+                {
+                    _unsupported(call, "builtin function argument type");
+                    return IntrinsicValue();
+                }
+                OpcodeSet opcodes;
+                bool isComparison = false;
+                _getOpcodeSet(info.op, opcodes, isComparison);
+                auto resultType = _getBoolVectorType(count);
+                auto spvInst = emitBinaryOp(call, opcodes, resultType, type, _coerceIntrinsicValue(args[0], type), _coerceIntrinsicValue(args[1], type));
+                return _makeIntrinsicValue(spvInst, resultType);
+            }
         }
+
+        if( auto result = _emitTextureBuiltin(name, args) )
+            return *result;
+        if( auto result = _emitAtomicBuiltin(name, args) )
+            return *result;
+        if( auto result = _emitBarrierBuiltin(name, args) )
+            return *result;
+
+        _unsupported(call, "builtin function");
+        return IntrinsicValue();
     }
 
-    // Both "local" and "global" instructions can have decorations.
-    // When we decide to emit an instruction, we typically also want
-    // to emit any decoratons that were attached to it that have
-    // a SPIR-V equivalent.
+        /// Holds the result of a builtin, for builtins that might not apply
+    struct OptionalIntrinsicValue
+    {
+        bool hasValue = false;
+        IntrinsicValue value;
 
-        /// Emit appropriate SPIR-V decorations for the given IR `irInst`.
-        ///
-        /// The given `dstID` should be the `<id>` of the SPIR-V instruction being decorated,
-        /// and should correspond to `irInst`.
-        ///
-    void emitDecorations(IRInst* irInst, SpvWord dstID)
+        OptionalIntrinsicValue() {}
+        OptionalIntrinsicValue(IntrinsicValue const& value) : hasValue(true), value(value) {}
+
+        explicit operator bool() const { return hasValue; }
+        IntrinsicValue const& operator*() const { return value; }
+    };
+
+        /// Get the amount of coordinates needed to address `textureType` (excluding any array index)
+    static Index _getTextureDimensionCount(IRTextureTypeBase* textureType)
     {
-        for( auto decoration : irInst->getDecorations() )
+        switch( textureType->GetBaseShape() )
         {
-            emitDecoration(dstID, decoration);
+        case TextureFlavor::Shape::Shape1D:     return 1;
+        case TextureFlavor::Shape::Shape2D:     return 2;
+        case TextureFlavor::Shape::Shape3D:     return 3;
+        case TextureFlavor::Shape::ShapeCube:   return 2;
+        case TextureFlavor::Shape::ShapeBuffer: return 1;
+        default:                                return 0;
         }
     }
 
-        /// Emit an appropriate SPIR-V decoration for the given IR `decoration`, if necessary and possible.
-        ///
-        /// The given `dstID` should be the `<id>` of the SPIR-V instruction being decorated,
-        /// and should correspond to the parent of `decoration` in the Slang IR.
-        ///
-    void emitDecoration(SpvWord dstID, IRDecoration* decoration)
+        /// Get the image operands for an offset (which is `ConstOffset` if it is constant)
+    void _addOffsetOperand(IntrinsicValue const& offset, Index coordCount, SpvWord& ioMask, List<SpvWord>& ioOperands)
+    {
+        auto spvOffset = _coerceIntrinsicValue(offset, _getIntVectorType(coordCount));
+        if( _isConstant(spvOffset) )
+        {
+            ioMask |= SpvImageOperandsConstOffsetMask;
+        }
+        else
+        {
+            requireCapability(SpvCapabilityImageGatherExtended);
+            ioMask |= SpvImageOperandsOffsetMask;
+        }
+        ioOperands.add(getID(spvOffset));
+    }
+
+    OptionalIntrinsicValue _emitTextureBuiltin(UnownedStringSlice const& name, List<IntrinsicValue>& args)
     {
-        // Unlike in the Slang IR, decorations in SPIR-V are not children
-        // of the instruction they decorate, and instead are free-standing
-        // instructions at global scope, which reference their target
-        // instruction by its `<id>`.
+        auto call = m_intrinsic->call;
+        const Index argCount = args.getCount();
+        if( argCount == 0 )
+            return OptionalIntrinsicValue();
+
+        auto textureType = as<IRTextureTypeBase>(args[0].type);
+        if( !textureType )
+            return OptionalIntrinsicValue();
+
+        auto spvImage = _getIntrinsicRValue(args[0]);
+        auto elementType = textureType->getElementType();
+        auto texelType = _getTexelType(elementType);
+        const Index dimensionCount = _getTextureDimensionCount(textureType);
+        const Index coordCount = dimensionCount + (textureType->isArray() ? 1 : 0);
+        if( !texelType || !dimensionCount || hasFailed() )
+        {
+            _unsupported(call, "texture type");
+            return IntrinsicValue();
+        }
+
+        // [3.32.10: Image Instructions]
         //
-        // The `IRDecoration` hierarchy in Slang also maps to several
-        // different categories of instruction in SPIR-V, only a subset
-        // of which are officialy called "decorations."
+        // > OpImageSampleImplicitLod, OpImageSampleExplicitLod
         //
-        // We will continue to use the Slang terminology here, since
-        // this code path is a catch-all for stuff that only needs to
-        // be emitted if the owning instruction gets emitted.
+        const bool isSample = name == "texture" || name == "textureOffset" || name == "textureLod" || name == "textureLodOffset" || name == "textureGrad" || name == "textureGradOffset";
+        if( isSample )
+        {
+            // The sampled image was created by `$p`.
+            //
+            if( spvImage->opcode != SpvOpSampledImage || argCount < 2 )
+            {
+                _unsupported(call, "texture sampling");
+                return IntrinsicValue();
+            }
+            const bool hasOffset = name.endsWith(UnownedStringSlice::fromLiteral("Offset"));
+            const bool isLod = name.startsWith(UnownedStringSlice::fromLiteral("textureLod"));
+            const bool isGrad = name.startsWith(UnownedStringSlice::fromLiteral("textureGrad"));
+
+            Index samplerCoordCount = coordCount + ((textureType->GetBaseShape() == TextureFlavor::Shape::ShapeCube) ? 1 : 0);
+            auto floatType = m_builder.getBasicType(BaseType::Float);
+            auto coords = _coerceIntrinsicValue(args[1], _getVectorType(floatType, samplerCoordCount));
+
+            SpvWord mask = 0;
+            List<SpvWord> operands;
+            Index nextArg = 2;
+            if( isLod )
+            {
+                if( nextArg >= argCount )
+                {
+                    _unsupported(call, "texture sampling");
+                    return IntrinsicValue();
+                }
+                mask |= SpvImageOperandsLodMask;
+                operands.add(getID(_coerceIntrinsicValue(args[nextArg++], floatType)));
+            }
+            else if( isGrad )
+            {
+                if( nextArg + 1 >= argCount )
+                {
+                    _unsupported(call, "texture sampling");
+                    return IntrinsicValue();
+                }
+                mask |= SpvImageOperandsGradMask;
+                auto gradType = _getVectorType(floatType, dimensionCount + ((textureType->GetBaseShape() == TextureFlavor::Shape::ShapeCube) ? 1 : 0));
+                operands.add(getID(_coerceIntrinsicValue(args[nextArg++], gradType)));
+                operands.add(getID(_coerceIntrinsicValue(args[nextArg++], gradType)));
+            }
+            if( hasOffset )
+            {
+                if( nextArg >= argCount )
+                {
+                    _unsupported(call, "texture sampling");
+                    return IntrinsicValue();
+                }
+                _addOffsetOperand(args[nextArg++], dimensionCount, mask, operands);
+            }
+            if( !isLod && !isGrad && nextArg < argCount )
+            {
+                // An optional bias comes last for `texture` and `textureOffset`,
+                // but its operand is first.
+                //
+                List<SpvWord> biasOperands;
+                biasOperands.add(getID(_coerceIntrinsicValue(args[nextArg++], floatType)));
+                biasOperands.addRange(operands);
+                operands = biasOperands;
+                mask |= SpvImageOperandsBiasMask;
+            }
+            if( nextArg != argCount )
+            {
+                _unsupported(call, "texture sampling");
+                return IntrinsicValue();
+            }
 
-        switch( decoration->op )
+            const SpvOp opcode = (isLod || isGrad) ? SpvOpImageSampleExplicitLod : SpvOpImageSampleImplicitLod;
+            SpvInst* spvResult = nullptr;
+            if( mask )
+                spvResult = emitInst(m_currentBlock, nullptr, opcode, getType(texelType), kResultID, spvImage, coords, mask, OperandWords(operands));
+            else
+                spvResult = emitInst(m_currentBlock, nullptr, opcode, getType(texelType), kResultID, spvImage, coords);
+            return _makeIntrinsicValue(spvResult, texelType);
+        }
+
+        // > OpImageGather
+        //
+        if( (name == "textureGather" || name == "textureGatherOffset") && argCount >= 2 )
         {
-        default:
-            break;
+            if( spvImage->opcode != SpvOpSampledImage )
+            {
+                _unsupported(call, "texture gather");
+                return IntrinsicValue();
+            }
+            auto floatType = m_builder.getBasicType(BaseType::Float);
+            Index samplerCoordCount = coordCount + ((textureType->GetBaseShape() == TextureFlavor::Shape::ShapeCube) ? 1 : 0);
+            auto coords = _coerceIntrinsicValue(args[1], _getVectorType(floatType, samplerCoordCount));
+
+            SpvWord mask = 0;
+            List<SpvWord> operands;
+            Index nextArg = 2;
+            if( name == "textureGatherOffset" )
+            {
+                if( nextArg >= argCount )
+                {
+                    _unsupported(call, "texture gather");
+                    return IntrinsicValue();
+                }
+                _addOffsetOperand(args[nextArg++], dimensionCount, mask, operands);
+            }
+            SpvInst* component = getIntConstant(0);
+            if( nextArg < argCount )
+                component = _coerceIntrinsicValue(args[nextArg++], m_builder.getIntType());
+            if( nextArg != argCount )
+            {
+                _unsupported(call, "texture gather");
+                return IntrinsicValue();
+            }
+            SpvInst* spvResult = nullptr;
+            if( mask )
+                spvResult = emitInst(m_currentBlock, nullptr, SpvOpImageGather, getType(texelType), kResultID, spvImage, coords, component, mask, OperandWords(operands));
+            else
+                spvResult = emitInst(m_currentBlock, nullptr, SpvOpImageGather, getType(texelType), kResultID, spvImage, coords, component);
+            return _makeIntrinsicValue(spvResult, texelType);
+        }
 
-        // [3.32.2. Debug Instructions]
+        // > OpImageFetch
         //
-        // > OpName
+        if( name == "texelFetch" && argCount >= 2 )
+        {
+            if( spvImage->opcode == SpvOpSampledImage )
+            {
+                _unsupported(call, "fetch from sampled image");
+                return IntrinsicValue();
+            }
+            auto coords = _coerceIntrinsicValue(args[1], _getIntVectorType(coordCount));
+            SpvWord mask = 0;
+            List<SpvWord> operands;
+            if( argCount > 2 )
+            {
+                // The last operand is the level of detail, or the sample for
+                // a multisample texture. Buffers have neither.
+                //
+                if( textureType->GetBaseShape() != TextureFlavor::Shape::ShapeBuffer )
+                {
+                    mask |= textureType->isMultisample() ? SpvImageOperandsSampleMask : SpvImageOperandsLodMask;
+                    operands.add(getID(_coerceIntrinsicValue(args[2], m_builder.getIntType())));
+                }
+            }
+            SpvInst* spvResult = nullptr;
+            if( mask )
+                spvResult = emitInst(m_currentBlock, nullptr, SpvOpImageFetch, getType(texelType), kResultID, spvImage, coords, mask, OperandWords(operands));
+            else
+                spvResult = emitInst(m_currentBlock, nullptr, SpvOpImageFetch, getType(texelType), kResultID, spvImage, coords);
+            return _makeIntrinsicValue(spvResult, texelType);
+        }
+
+        // > OpImageRead, OpImageWrite
         //
-        case kIROp_NameHintDecoration:
+        if( name == "imageLoad" && argCount == 2 )
+        {
+            auto coords = _coerceIntrinsicValue(args[1], _getIntVectorType(coordCount));
+            return _makeIntrinsicValue(_emitImageRead(call, spvImage, coords, texelType), texelType);
+        }
+        if( name == "imageStore" && argCount == 3 )
+        {
+            auto coords = _coerceIntrinsicValue(args[1], _getIntVectorType(coordCount));
+            Index valueCount = 0;
+            if( !args[2].type || !_getScalarType(args[2].type, valueCount) )
             {
-                auto section = getSection(SpvLogicalSectionID::DebugNames);
-                auto nameHint = cast<IRNameHintDecoration>(decoration);
-                emitInst(section, decoration, SpvOpName, dstID, nameHint->getName());
+                _unsupported(call, "image store value");
+                return IntrinsicValue();
             }
-            break;
+            auto value = _coerceIntrinsicValue(args[2], _getVectorType(_getScalarType(texelType), valueCount));
+            _emitImageWrite(call, spvImage, coords, value, _getVectorType(_getScalarType(texelType), valueCount));
+            return IntrinsicValue();
+        }
 
-        // [3.32.5. Mode-Setting Instructions]
+        // > OpImageQuerySizeLod, OpImageQuerySize, OpImageQueryLevels, OpImageQuerySamples
         //
-        // > OpEntryPoint
-        // > Declare an entry point, its execution model, and its interface.
+        // These need the image, rather than a sampled image.
         //
-        case kIROp_EntryPointDecoration:
+        const bool isQuery = name == "textureSize" || name == "imageSize" || name == "textureQueryLevels" || name == "textureSamples" || name == "imageSamples";
+        if( isQuery )
+        {
+            if( spvImage->opcode == SpvOpSampledImage )
+            {
+                _unsupported(call, "query of sampled image");
+                return IntrinsicValue();
+            }
+            requireCapability(SpvCapabilityImageQuery);
+            auto intType = m_builder.getIntType();
+            if( name == "textureQueryLevels" || name == "textureSamples" || name == "imageSamples" )
             {
-                auto section = getSection(SpvLogicalSectionID::EntryPoints);
+                const SpvOp opcode = (name == "textureQueryLevels") ? SpvOpImageQueryLevels : SpvOpImageQuerySamples;
+                return _makeIntrinsicValue(emitInst(m_currentBlock, nullptr, opcode, getType(intType), kResultID, spvImage), intType);
+            }
 
-                // TODO: The `OpEntryPoint` is required to list an varying
-                // input or output parameters (by `<id>`) used by the entry point,
-                // although these are encoded as global variables in the IR.
-                //
-                // Currently we have a pass that moves entry-point varying
-                // parameters to global scope for the benefit of GLSL output,
-                // but we do not maintain a connection between those parameters
-                // and the original entry point. That pass should be updated
-                // to attach a decoration linking the original entry point
-                // to the new globals, which would be used in the SPIR-V emit case.
-
-                auto entryPointDecor = cast<IREntryPointDecoration>(decoration);
-                auto spvStage = mapStageToExecutionModel(entryPointDecor->getProfile().getStage());
-                auto name = entryPointDecor->getName()->getStringSlice();
-                emitInst(section, decoration, SpvOpEntryPoint, spvStage, dstID, name);
+            auto sizeType = _getIntVectorType(coordCount);
+            const bool hasLod = name == "textureSize" && !textureType->isMultisample() && textureType->GetBaseShape() != TextureFlavor::Shape::ShapeBuffer;
+            if( hasLod )
+            {
+                auto lod = argCount > 1 ? _coerceIntrinsicValue(args[1], intType) : getIntConstant(0);
+                return _makeIntrinsicValue(emitInst(m_currentBlock, nullptr, SpvOpImageQuerySizeLod, getType(sizeType), kResultID, spvImage, lod), sizeType);
             }
-            break;
+            return _makeIntrinsicValue(emitInst(m_currentBlock, nullptr, SpvOpImageQuerySize, getType(sizeType), kResultID, spvImage), sizeType);
+        }
 
-        // > OpExecutionMode
+        return OptionalIntrinsicValue();
+    }
 
-        // [3.6. Execution Mode]: LocalSize
-        case kIROp_NumThreadsDecoration:
+    OptionalIntrinsicValue _emitAtomicBuiltin(UnownedStringSlice const& name, List<IntrinsicValue>& args)
+    {
+        // [3.32.18: Atomic Instructions]
+        //
+        // The GLSL atomic functions (and `imageAtomic*`, which are handled the
+        // same way as `$A` gives a texel pointer) use device scope, and relaxed
+        // memory semantics.
+        //
+        struct AtomicInfo { char const* name; SpvOp signedOp; SpvOp unsignedOp; Index argCount; };
+        static const AtomicInfo kAtomicInfos[] =
+        {
+            { "atomicAdd",      SpvOpAtomicIAdd,    SpvOpAtomicIAdd,    2 },
+            { "atomicMin",      SpvOpAtomicSMin,    SpvOpAtomicUMin,    2 },
+            { "atomicMax",      SpvOpAtomicSMax,    SpvOpAtomicUMax,    2 },
+            { "atomicAnd",      SpvOpAtomicAnd,     SpvOpAtomicAnd,     2 },
+            { "atomicOr",       SpvOpAtomicOr,      SpvOpAtomicOr,      2 },
+            { "atomicXor",      SpvOpAtomicXor,     SpvOpAtomicXor,     2 },
+            { "atomicExchange", SpvOpAtomicExchange,SpvOpAtomicExchange,2 },
+            { "atomicCompSwap", SpvOpAtomicCompareExchange, SpvOpAtomicCompareExchange, 3 },
+        };
+        UnownedStringSlice baseName = name;
+        if( baseName.startsWith(UnownedStringSlice::fromLiteral("imageA")) )
+        {
+            // `imageAtomicAdd` is `atomicAdd` on a texel pointer.
+            //
+            baseName = UnownedStringSlice(name.begin() + 5, name.end());
+        }
+        for( auto const& info : kAtomicInfos )
+        {
+            if( baseName != UnownedStringSlice(info.name) )
+                continue;
+            auto call = m_intrinsic->call;
+            if( args.getCount() != info.argCount || !args[0].isPointer || !args[0].type )
             {
-                auto section = getSection(SpvLogicalSectionID::ExecutionModes);
-
-                // TODO: The `LocalSize` execution mode option requires
-                // literal values for the X,Y,Z thread-group sizes.
-                // There is a `LocalSizeId` variant that takes `<id>`s
-                // for those sizes, and we should consider using that
-                // and requiring the appropriate capabilities
-                // if any of the operands to the decoration are not
-                // literals (in a future where we support non-literals
-                // in those positions in the Slang IR).
+                _unsupported(call, "atomic operation");
+                return IntrinsicValue();
+            }
+            auto type = args[0].type;
+            const auto kind = _getScalarKind(type);
+            if( (kind != ScalarKind::SignedInt && kind != ScalarKind::UnsignedInt) || _getScalarByteSize(type) != 4 )
+            {
+                _unsupported(call, "atomic operation type");
+                return IntrinsicValue();
+            }
+            const SpvOp opcode = (kind == ScalarKind::SignedInt) ? info.signedOp : info.unsignedOp;
+            auto scope = getUIntConstant(kScopeDevice);
+            auto semantics = getUIntConstant(0);
+            SpvInst* spvResult = nullptr;
+            if( opcode == SpvOpAtomicCompareExchange )
+            {
+                // > OpAtomicCompareExchange ... Value, Comparator
                 //
-                auto numThreads = cast<IRNumThreadsDecoration>(decoration);
-                emitInst(section, decoration, SpvOpExecutionMode, dstID, SpvExecutionModeLocalSize,
-                    SpvWord(numThreads->getX()->getValue()),
-                    SpvWord(numThreads->getY()->getValue()),
-                    SpvWord(numThreads->getZ()->getValue()));
+                auto comparator = _coerceIntrinsicValue(args[1], type);
+                auto value = _coerceIntrinsicValue(args[2], type);
+                List<SpvWord> operands;
+                operands.add(getID(semantics));
+                operands.add(getID(value));
+                operands.add(getID(comparator));
+                spvResult = emitInst(m_currentBlock, nullptr, opcode, getType(type), kResultID, args[0].spv, scope, semantics, OperandWords(operands));
+            }
+            else
+            {
+                auto value = _coerceIntrinsicValue(args[1], type);
+                spvResult = emitInst(m_currentBlock, nullptr, opcode, getType(type), kResultID, args[0].spv, scope, semantics, value);
             }
+            return _makeIntrinsicValue(spvResult, type);
+        }
+        return OptionalIntrinsicValue();
+    }
+
+    OptionalIntrinsicValue _emitBarrierBuiltin(UnownedStringSlice const& name, List<IntrinsicValue>& args)
+    {
+        // [3.32.20: Barrier Instructions]
+        //
+        // The scope and semantics match the code glslang generates for each function.
+        //
+        struct BarrierInfo { char const* name; SpvWord scope; SpvWord semantics; };
+        static const SpvWord kAllMemory = kSemanticsAcquireRelease | kSemanticsUniformMemory | kSemanticsWorkgroupMemory | kSemanticsImageMemory;
+        static const BarrierInfo kBarrierInfos[] =
+        {
+            { "groupMemoryBarrier",     kScopeWorkgroup,    kAllMemory },
+            { "memoryBarrier",          kScopeDevice,       kAllMemory },
+            { "memoryBarrierShared",    kScopeDevice,       kSemanticsAcquireRelease | kSemanticsWorkgroupMemory },
+            { "memoryBarrierBuffer",    kScopeDevice,       kSemanticsAcquireRelease | kSemanticsUniformMemory },
+            { "memoryBarrierImage",     kScopeDevice,       kSemanticsAcquireRelease | kSemanticsImageMemory },
+        };
+        if( args.getCount() != 0 )
+            return OptionalIntrinsicValue();
+        if( name == "barrier" )
+        {
+            _emitControlBarrier(nullptr);
+            return IntrinsicValue();
+        }
+        for( auto const& info : kBarrierInfos )
+        {
+            if( name != UnownedStringSlice(info.name) )
+                continue;
+            emitInst(m_currentBlock, nullptr, SpvOpMemoryBarrier, getUIntConstant(info.scope), getUIntConstant(info.semantics));
+            return IntrinsicValue();
+        }
+        return OptionalIntrinsicValue();
+    }
+
+    // [3.32.5: Mode-Setting Instructions]
+    //
+    // Entry points are emitted after the bodies of all functions, since
+    // `OpEntryPoint` lists the input and output variables of its interface,
+    // which are only known once everything that uses them has been emitted.
+
+    struct EntryPointInfo
+    {
+        IRFunc* irFunc = nullptr;
+        IREntryPointDecoration* decoration = nullptr;
+        SpvInst* spvFunc = nullptr;
+    };
+    List<EntryPointInfo> m_entryPoints;
+
+        /// Emit the function for the entry point `irFunc` (and everything it uses)
+    void emitEntryPointFunc(IRFunc* irFunc)
+    {
+        auto decoration = irFunc->findDecoration<IREntryPointDecoration>();
+        if( !decoration )
+        {
+            _unsupported(irFunc, "entry point without a decoration");
+            return;
+        }
+
+        // The stage changes how varying parameters are decorated, so all
+        // of the entry points must be for the same stage.
+        //
+        const Stage stage = decoration->getProfile().getStage();
+        switch( stage )
+        {
+        case Stage::Vertex:
+        case Stage::Fragment:
+        case Stage::Compute:
             break;
+        default:
+            _unsupported(irFunc, "entry point stage");
+            return;
+        }
+        if( m_stage != Stage::Unknown && m_stage != stage )
+        {
+            _unsupported(irFunc, "entry points for different stages");
+            return;
+        }
+        m_stage = stage;
+
+        EntryPointInfo info;
+        info.irFunc = irFunc;
+        info.decoration = decoration;
+        info.spvFunc = ensureInst(irFunc);
+        m_entryPoints.add(info);
+    }
 
-        // ...
+        /// Emit the `OpEntryPoint` and `OpExecutionMode`s for all of the entry points
+    void emitEntryPoints()
+    {
+        for( auto const& info : m_entryPoints )
+        {
+            auto irFunc = info.irFunc;
+            auto spvFunc = info.spvFunc;
+            const Stage stage = info.decoration->getProfile().getStage();
+
+            // > OpEntryPoint
+            // > Declare an entry point, its execution model, and its interface.
+            //
+            // Before SPIR-V 1.4 the interface is only the `Input` and `Output` variables.
+            //
+            List<SpvWord> interfaceIDs;
+            for( auto spvVar : m_interfaceVars )
+                interfaceIDs.add(getID(spvVar));
+            emitInst(getSection(SpvLogicalSectionID::EntryPoints), nullptr, SpvOpEntryPoint,
+                mapStageToExecutionModel(stage),
+                spvFunc,
+                info.decoration->getName()->getStringSlice(),
+                OperandWords(interfaceIDs));
+
+            // > OpExecutionMode
+            //
+            auto section = getSection(SpvLogicalSectionID::ExecutionModes);
+            switch( stage )
+            {
+            case Stage::Compute:
+                {
+                    // [3.6. Execution Mode]: LocalSize
+                    //
+                    SpvWord sizes[3] = { 1, 1, 1 };
+                    if( auto numThreads = irFunc->findDecoration<IRNumThreadsDecoration>() )
+                    {
+                        sizes[0] = SpvWord(numThreads->getX()->getValue());
+                        sizes[1] = SpvWord(numThreads->getY()->getValue());
+                        sizes[2] = SpvWord(numThreads->getZ()->getValue());
+                    }
+                    emitInst(section, nullptr, SpvOpExecutionMode, spvFunc, SpvExecutionModeLocalSize, sizes[0], sizes[1], sizes[2]);
+                }
+                break;
+
+            case Stage::Fragment:
+                {
+                    // Vulkan requires `OriginUpperLeft` for fragment shaders.
+                    //
+                    emitInst(section, nullptr, SpvOpExecutionMode, spvFunc, SpvExecutionModeOriginUpperLeft);
+                    if( m_writesFragDepth )
+                        emitInst(section, nullptr, SpvOpExecutionMode, spvFunc, SpvExecutionModeDepthReplacing);
+                    if( irFunc->findDecoration<IREarlyDepthStencilDecoration>() )
+                        emitInst(section, nullptr, SpvOpExecutionMode, spvFunc, SpvExecutionModeEarlyFragmentTests);
+                }
+                break;
+
+            default:
+                break;
+            }
         }
     }
 
@@ -1184,30 +6485,65 @@ struct SPIRVEmitContext
         }
     }
 
-    SPIRVEmitContext(IRModule* module) :
+        /// Note that `irFunc` (which is called) needs at least the SPIR-V version it is decorated with
+    void requireSPIRVVersionOf(IRInst* irFunc)
+    {
+        if( !irFunc )
+            return;
+        if( auto decoration = irFunc->findDecoration<IRRequireSPIRVVersionDecoration>() )
+        {
+            SemanticVersion version;
+            version.setFromInteger(SemanticVersion::IntegerType(decoration->getSPIRVVersion()));
+            const SpvWord spirvVersion = (SpvWord(version.m_major) << 16) | (SpvWord(version.m_minor) << 8);
+            if( spirvVersion > m_spirvVersion )
+                m_spirvVersion = spirvVersion;
+        }
+    }
+
+    SPIRVEmitContext(IRModule* module, BackEndCompileRequest* compileRequest, TargetRequest* targetRequest, SpvWord spirvVersion) :
         m_irModule(module),
         m_memoryArena(2048)
     {
+        m_sharedBuilder.module = module;
+        m_sharedBuilder.session = module->getSession();
+        m_builder.sharedBuilder = &m_sharedBuilder;
+
+        if( spirvVersion > m_spirvVersion )
+            m_spirvVersion = spirvVersion;
+        m_matrixLayoutMode = targetRequest->getDefaultMatrixLayoutMode();
+        m_useUnknownImageFormatAsDefault = compileRequest->useUnknownImageFormatAsDefault;
     }
 };
 
 SlangResult emitSPIRVFromIR(
     BackEndCompileRequest*  compileRequest,
+    TargetRequest*          targetRequest,
     IRModule*               irModule,
     const List<IRFunc*>&    irEntryPoints,
+    uint32_t                spirvVersion,
     List<uint8_t>&          spirvOut)
 {
-    SLANG_UNUSED(compileRequest);
-    
     spirvOut.clear();
 
-    SPIRVEmitContext context(irModule);
+    SPIRVEmitContext context(irModule, compileRequest, targetRequest, spirvVersion);
 
     context.emitFrontMatter();
     for (auto irEntryPoint : irEntryPoints)
     {
-        context.ensureInst(irEntryPoint);
+        context.emitEntryPointFunc(irEntryPoint);
+    }
+    context.emitPendingFuncBodies();
+    context.emitEntryPoints();
+
+    // If anything couldn't be emitted, the caller can generate the SPIR-V
+    // via GLSL instead.
+    //
+    if (context.hasFailed())
+    {
+        compileRequest->getSink()->diagnose(SourceLoc(), Diagnostics::spirvDirectEmitUnsupported, context.m_unsupportedReason);
+        return SLANG_E_NOT_IMPLEMENTED;
     }
+
     context.emitPhysicalLayout();
 
     spirvOut.addRange(
@@ -1217,5 +6553,128 @@ SlangResult emitSPIRVFromIR(
     return SLANG_OK;
 }
 
+    /// Get the name of a storage class that can be part of the interface of a module
+static char const* _getInterfaceStorageClassName(SpvWord storageClass)
+{
+    switch( storageClass )
+    {
+    case SpvStorageClassUniformConstant:    return "UniformConstant";
+    case SpvStorageClassInput:              return "Input";
+    case SpvStorageClassUniform:            return "Uniform";
+    case SpvStorageClassOutput:             return "Output";
+    case SpvStorageClassPushConstant:       return "PushConstant";
+    case SpvStorageClassStorageBuffer:      return "StorageBuffer";
+    default:                                return nullptr;
+    }
+}
+
+void getSPIRVInterfaceParts(
+    const List<uint8_t>&    spirv,
+    List<String>&           outParts)
+{
+    // The parts of the interface of a module that are expected to be the same
+    // whatever generated it are the execution modes of its entry points, and
+    // how its variables are bound (by descriptor set, binding, location and builtin).
+    //
+    // Ids differ between modules, so the variables are described by their
+    // decorations.
+    //
+    outParts.clear();
+
+    SpvWord const* words = (SpvWord const*)spirv.getBuffer();
+    const Index wordCount = spirv.getCount() / Index(sizeof(SpvWord));
+
+    // [2.3: Physical Layout of a SPIR-V Module and Instruction]
+    //
+    // The header is 5 words.
+    //
+    if( wordCount < 5 || words[0] != SpvMagicNumber )
+        return;
+
+    Dictionary<SpvWord, SpvWord> storageClasses;
+    Dictionary<SpvWord, List<String>> decorations;
+
+    for( Index ii = 5; ii < wordCount; )
+    {
+        const SpvWord opcode = words[ii] & 0xffff;
+        const Index instWordCount = Index(words[ii] >> 16);
+        if( instWordCount == 0 || ii + instWordCount > wordCount )
+            break;
+        SpvWord const* operands = words + ii + 1;
+        const Index operandCount = instWordCount - 1;
+
+        switch( opcode )
+        {
+        case SpvOpExecutionMode:
+            if( operandCount >= 2 )
+            {
+                StringBuilder builder;
+                builder << "ExecutionMode " << operands[1];
+                for( Index jj = 2; jj < operandCount; ++jj )
+                    builder << " " << operands[jj];
+                outParts.add(builder.ProduceString());
+            }
+            break;
+
+        case SpvOpVariable:
+            if( operandCount >= 3 )
+                storageClasses[operands[1]] = operands[2];
+            break;
+
+        case SpvOpDecorate:
+            if( operandCount >= 2 )
+            {
+                char const* name = nullptr;
+                switch( operands[1] )
+                {
+                case SpvDecorationBuiltIn:          name = "BuiltIn"; break;
+                case SpvDecorationLocation:         name = "Location"; break;
+                case SpvDecorationIndex:            name = "Index"; break;
+                case SpvDecorationBinding:          name = "Binding"; break;
+                case SpvDecorationDescriptorSet:    name = "DescriptorSet"; break;
+                default:                            break;
+                }
+                if( name && operandCount >= 3 )
+                {
+                    StringBuilder builder;
+                    builder << name << " " << operands[2];
+                    List<String>* varDecorations = decorations.TryGetValue(operands[0]);
+                    if( !varDecorations )
+                    {
+                        decorations.Add(operands[0], List<String>());
+                        varDecorations = decorations.TryGetValue(operands[0]);
+                    }
+                    varDecorations->add(builder.ProduceString());
+                }
+            }
+            break;
+
+        default:
+            break;
+        }
+        ii += instWordCount;
+    }
+
+    for( auto& pair : decorations )
+    {
+        SpvWord storageClass = 0;
+        if( !storageClasses.TryGetValue(pair.Key, storageClass) )
+            continue;
+        auto storageClassName = _getInterfaceStorageClassName(storageClass);
+        if( !storageClassName )
+            continue;
+
+        auto& varDecorations = pair.Value;
+        varDecorations.sort();
+
+        StringBuilder builder;
+        builder << storageClassName;
+        for( auto const& decoration : varDecorations )
+            builder << " " << decoration;
+        outParts.add(builder.ProduceString());
+    }
+
+    outParts.sort();
+}
 
 } // namespace Slang
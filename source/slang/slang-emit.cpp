@@ -13,13 +13,18 @@
 #include "slang-ir-explicit-global-context.h"
 #include "slang-ir-explicit-global-init.h"
 #include "slang-ir-glsl-legalize.h"
+#include "slang-ir-gvn.h"
 #include "slang-ir-insts.h"
 #include "slang-ir-legalize-varying-params.h"
+#include "slang-ir-licm.h"
+#include "slang-ir-loop-unroll.h"
 #include "slang-ir-link.h"
 #include "slang-ir-lower-generics.h"
 #include "slang-ir-lower-tuple-types.h"
+#include "slang-ir-peephole.h"
 #include "slang-ir-restructure.h"
 #include "slang-ir-restructure-scoping.h"
+#include "slang-ir-sccp.h"
 #include "slang-ir-specialize.h"
 #include "slang-ir-specialize-arrays.h"
 #include "slang-ir-specialize-resources.h"
@@ -139,10 +144,27 @@ static void dumpIRIfEnabled(
     }
 }
 
+    /// Get the scope used in a perf report for generating code for the entry points for the target
+static String _getPerfReportScope(BackEndCompileRequest* compileRequest, const List<Int>& entryPointIndices, CodeGenTarget target)
+{
+    StringBuilder builder;
+    builder << TypeTextUtil::getCompileTargetName(SlangCompileTarget(target));
+
+    auto program = compileRequest->getProgram();
+    for (Index i = 0; i < entryPointIndices.getCount(); ++i)
+    {
+        builder << ((i == 0) ? ":" : ",") << getText(program->getEntryPoint(entryPointIndices[i])->getName());
+    }
+    return builder.ProduceString();
+}
+
 struct LinkingAndOptimizationOptions
 {
     bool shouldLegalizeExistentialAndResourceTypes = true;
     CLikeSourceEmitter* sourceEmitter = nullptr;
+
+        /// Tracks GLSL extensions needed by legalization for the GLSL target. If not set the source emitter's tracker is used.
+    GLSLExtensionTracker* glslExtensionTracker = nullptr;
 };
 
 Result linkAndOptimizeIR(
@@ -159,6 +181,9 @@ Result linkAndOptimizeIR(
 
     auto session = targetRequest->getSession();
 
+    PerfReport* perfReport = compileRequest->perfReport;
+    PerfPhaseRecorder perfRecorder(perfReport, perfReport ? _getPerfReportScope(compileRequest, entryPointIndices, target) : String());
+
     // We start out by performing "linking" at the level of the IR.
     // This step will create a fresh IR module to be used for
     // code generation, and will copy in any IR definitions that
@@ -175,6 +200,18 @@ Result linkAndOptimizeIR(
     auto irModule = outLinkedIR.module;
     auto irEntryPoints = outLinkedIR.entryPoints;
 
+    perfRecorder.setModule(irModule);
+
+    // Each pass ends here. A pass can hold on to instructions it has removed until it completes,
+    // so the memory of the instructions deallocated in a pass is only reused after it.
+    auto endPass = [&](const char* name)
+    {
+        irModule->reclaimDeallocatedInstMemory();
+        perfRecorder.endPhase(name);
+    };
+
+    endPass("linkIR");
+
 #if 0
     dumpIRIfEnabled(compileRequest, irModule, "LINKED");
 #endif
@@ -189,6 +226,7 @@ Result linkAndOptimizeIR(
     // Replace any global constants with their values.
     //
     replaceGlobalConstants(irModule);
+    endPass("replaceGlobalConstants");
 #if 0
     dumpIRIfEnabled(compileRequest, irModule, "GLOBAL CONSTANTS REPLACED");
 #endif
@@ -203,6 +241,7 @@ Result linkAndOptimizeIR(
     // use sites.
     //
     bindExistentialSlots(irModule, sink);
+    endPass("bindExistentialSlots");
 #if 1
     dumpIRIfEnabled(compileRequest, irModule, "EXISTENTIALS BOUND");
 #endif
@@ -227,6 +266,7 @@ Result linkAndOptimizeIR(
     // passed using constant buffers.
     //
     collectGlobalUniformParameters(irModule, outLinkedIR.globalScopeVarLayout);
+    endPass("collectGlobalUniformParameters");
 #if 1
     dumpIRIfEnabled(compileRequest, irModule, "GLOBAL UNIFORMS COLLECTED");
 #endif
@@ -250,6 +290,7 @@ Result linkAndOptimizeIR(
             passOptions.alwaysCreateCollectedParam = true;
         default:
             collectEntryPointUniformParams(irModule, passOptions);
+            endPass("collectEntryPointUniformParams");
         #if 0
             dumpIRIfEnabled(compileRequest, irModule, "ENTRY POINT UNIFORMS COLLECTED");
         #endif
@@ -262,6 +303,7 @@ Result linkAndOptimizeIR(
     {
     default:
         moveEntryPointUniformParamsToGlobalScope(irModule);
+        endPass("moveEntryPointUniformParamsToGlobalScope");
     #if 0
         dumpIRIfEnabled(compileRequest, irModule, "ENTRY POINT UNIFORMS MOVED");
     #endif
@@ -278,6 +320,7 @@ Result linkAndOptimizeIR(
     // various targets.
     //
     desugarUnionTypes(irModule);
+    endPass("desugarUnionTypes");
 #if 0
     dumpIRIfEnabled(compileRequest, irModule, "UNIONS DESUGARED");
 #endif
@@ -303,9 +346,13 @@ Result linkAndOptimizeIR(
     // values that need to be compile-time constants.
     //
     if (!compileRequest->disableSpecialization)
+    {
         specializeModule(irModule);
+        endPass("specializeModule");
+    }
 
     eliminateDeadCode(irModule);
+    endPass("eliminateDeadCode");
 
     LowerGenericsOptions lowerGenericsOptions = kLowerGeneicsOptions_None;
     switch (target)
@@ -332,13 +379,20 @@ Result linkAndOptimizeIR(
     // generics / interface types to ordinary functions and types using
     // function pointers.
     dumpIRIfEnabled(compileRequest, irModule, "BEFORE-LOWER-GENERICS");
-    lowerGenerics(targetRequest, irModule, sink, lowerGenericsOptions);
+    WitnessTableIDTurn witnessTableIDTurn;
+    witnessTableIDTurn.turns = compileRequest->witnessTableIDTurns;
+    witnessTableIDTurn.jobIndex = compileRequest->parallelCodeGenJobIndex;
+    lowerGenerics(targetRequest, irModule, sink, lowerGenericsOptions, witnessTableIDTurn);
+    // Any IDs the code needs have been allocated, so later jobs can allocate theirs
+    witnessTableIDTurn.end();
+    endPass("lowerGenerics");
     dumpIRIfEnabled(compileRequest, irModule, "LOWER-GENERICS");
 
     if (sink->getErrorCount() != 0)
         return SLANG_FAIL;
 
     lowerTuples(irModule, sink);
+    endPass("lowerTuples");
     if (sink->getErrorCount() != 0)
         return SLANG_FAIL;
 
@@ -359,6 +413,7 @@ Result linkAndOptimizeIR(
     // apply at this point?
     //
     eliminateDeadCode(irModule);
+    endPass("eliminateDeadCode");
 #if 0
     dumpIRIfEnabled(compileRequest, irModule, "AFTER DCE");
 #endif
@@ -397,6 +452,7 @@ Result linkAndOptimizeIR(
             irModule,
             sink);
         eliminateDeadCode(irModule);
+        endPass("legalizeExistentialTypeLayout");
 
 #if 0
         dumpIRIfEnabled(compileRequest, irModule, "EXISTENTIALS LEGALIZED");
@@ -418,6 +474,7 @@ Result linkAndOptimizeIR(
             irModule,
             sink);
         eliminateDeadCode(irModule);
+        endPass("legalizeResourceTypes");
 
         //  Debugging output of legalization
     #if 0
@@ -432,12 +489,68 @@ Result linkAndOptimizeIR(
     // (e.g., things that used to be aggregated might now be split up,
     // so that we can work with the individual fields).
     constructSSA(irModule);
+    endPass("constructSSA");
 
 #if 0
     dumpIRIfEnabled(compileRequest, irModule, "AFTER SSA");
 #endif
     validateIRModuleIfEnabled(compileRequest, irModule);
 
+    const OptimizationLevel optimizationLevel = compileRequest->getLinkage()->optimizationLevel;
+
+    // Loops marked `[unroll]` with a trip count we can work out are unrolled here,
+    // as not every target has a downstream compiler that would unroll them. Constant
+    // propagation then turns the loop variables into constants in each copy of the
+    // body, so that array indices in the loop are constants for specialization below.
+    if (optimizationLevel != OptimizationLevel::None)
+    {
+        LoopUnrollOptions unrollOptions;
+        const bool hasUnrolled = unrollLoops(irModule, unrollOptions);
+        endPass("unrollLoops");
+        if (hasUnrolled)
+        {
+            applySparseConditionalConstantPropagation(irModule);
+            endPass("applySparseConditionalConstantPropagation");
+            eliminateDeadCode(irModule);
+            endPass("eliminateDeadCode");
+        }
+        validateIRModuleIfEnabled(compileRequest, irModule);
+    }
+
+    // At higher optimization levels we clean up the redundant computations that
+    // specialization, legalization and SSA construction leave behind, rather than
+    // relying on the downstream compiler to do so. The effect of each pass on the
+    // number of instructions is recorded in the perf report (-report-perf).
+    if (optimizationLevel >= OptimizationLevel::High)
+    {
+        // Simplifications expose redundant values and vice versa, so at the maximal
+        // level repeat (a bounded number of times) while something changes.
+        const Index maxRounds = (optimizationLevel >= OptimizationLevel::Maximal) ? 4 : 1;
+        for (Index round = 0; round < maxRounds; ++round)
+        {
+            bool changed = applyPeepholeOptimizations(irModule);
+            endPass("applyPeepholeOptimizations");
+            changed = applyGlobalValueNumbering(irModule) || changed;
+            endPass("applyGlobalValueNumbering");
+            if (!changed)
+            {
+                break;
+            }
+        }
+        validateIRModuleIfEnabled(compileRequest, irModule);
+
+        hoistLoopInvariantInsts(irModule);
+        endPass("hoistLoopInvariantInsts");
+
+        eliminateDeadCode(irModule);
+        endPass("eliminateDeadCode");
+
+#if 0
+        dumpIRIfEnabled(compileRequest, irModule, "AFTER IR OPTIMIZATION");
+#endif
+        validateIRModuleIfEnabled(compileRequest, irModule);
+    }
+
     // After type legalization and subsequent SSA cleanup we expect
     // that any resource types passed to functions are exposed
     // as their own top-level parameters (which might have
@@ -460,7 +573,9 @@ Result linkAndOptimizeIR(
     // pass down the target request along with the IR.
     //
     specializeResourceOutputs(compileRequest, targetRequest, irModule);
+    endPass("specializeResourceOutputs");
     specializeResourceParameters(compileRequest, targetRequest, irModule);
+    endPass("specializeResourceParameters");
 
     // For GLSL targets, we also want to specialize calls to functions that
     // takes array parameters if possible, to avoid performance issues on
@@ -468,6 +583,7 @@ Result linkAndOptimizeIR(
     if (isKhronosTarget(targetRequest))
     {
         specializeArrayParameters(compileRequest, targetRequest, irModule);
+        endPass("specializeArrayParameters");
     }
 
 #if 0
@@ -488,6 +604,7 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::HLSL:
         {
             wrapStructuredBuffersOfMatrices(irModule);
+            endPass("wrapStructuredBuffersOfMatrices");
 #if 0
                 dumpIRIfEnabled(compileRequest, irModule, "STRUCTURED BUFFERS WRAPPED");
 #endif
@@ -585,6 +702,7 @@ Result linkAndOptimizeIR(
         }
 
         legalizeByteAddressBufferOps(session, targetRequest, irModule, byteAddressBufferOptions);
+        endPass("legalizeByteAddressBufferOps");
     }
 
     // For CUDA targets only, we will need to turn operations
@@ -599,6 +717,7 @@ Result linkAndOptimizeIR(
             synthesizeActiveMask(
                 irModule,
                 compileRequest->getSink());
+            endPass("synthesizeActiveMask");
 
 #if 0
             dumpIRIfEnabled(compileRequest, irModule, "AFTER synthesizeActiveMask");
@@ -623,7 +742,11 @@ Result linkAndOptimizeIR(
     {
     case CodeGenTarget::GLSL:
     {
-        auto glslExtensionTracker = as<GLSLExtensionTracker>(options.sourceEmitter->getExtensionTracker());
+        auto glslExtensionTracker = options.glslExtensionTracker;
+        if (!glslExtensionTracker)
+        {
+            glslExtensionTracker = as<GLSLExtensionTracker>(options.sourceEmitter->getExtensionTracker());
+        }
 
         legalizeEntryPointsForGLSL(
             session,
@@ -631,6 +754,7 @@ Result linkAndOptimizeIR(
             irEntryPoints,
             compileRequest->getSink(),
             glslExtensionTracker);
+        endPass("legalizeEntryPointsForGLSL");
 
 #if 0
             dumpIRIfEnabled(compileRequest, irModule, "GLSL LEGALIZED");
@@ -643,12 +767,14 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::CPPSource:
         {
             legalizeEntryPointVaryingParamsForCPU(irModule, compileRequest->getSink());
+            endPass("legalizeEntryPointVaryingParamsForCPU");
         }
         break;
 
     case CodeGenTarget::CUDASource:
         {
             legalizeEntryPointVaryingParamsForCUDA(irModule, compileRequest->getSink());
+            endPass("legalizeEntryPointVaryingParamsForCUDA");
         }
         break;
 
@@ -665,10 +791,13 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::CPPSource:
     case CodeGenTarget::CUDASource:
         moveGlobalVarInitializationToEntryPoints(irModule);
+        endPass("moveGlobalVarInitializationToEntryPoints");
         introduceExplicitGlobalContext(irModule, target);
+        endPass("introduceExplicitGlobalContext");
         if(target == CodeGenTarget::CPPSource)
         {
             convertEntryPointPtrParamsToRawPtrs(irModule);
+            endPass("convertEntryPointPtrParamsToRawPtrs");
         }
     #if 0
         dumpIRIfEnabled(compileRequest, irModule, "EXPLICIT GLOBAL CONTEXT INTRODUCED");
@@ -681,6 +810,7 @@ Result linkAndOptimizeIR(
     // If we are going to support function-pointer based, "real" modular dynamic dispatch,
     // we will need to disable this pass.
     stripWitnessTables(irModule);
+    endPass("stripWitnessTables");
 
 #if 0
     dumpIRIfEnabled(compileRequest, irModule, "AFTER STRIP WITNESS TABLES");
@@ -698,6 +828,7 @@ Result linkAndOptimizeIR(
     // whatever code is "live."
     //
     eliminateDeadCode(irModule);
+    endPass("eliminateDeadCode");
 #if 0
     dumpIRIfEnabled(compileRequest, irModule, "AFTER DCE");
 #endif
@@ -821,7 +952,11 @@ SlangResult emitEntryPointsSourceFromIR(
 #if 0
         dumpIR(compileRequest, irModule, "PRE-EMIT");
 #endif
+        PerfReport* perfReport = compileRequest->perfReport;
+        PerfPhaseRecorder perfRecorder(perfReport, perfReport ? _getPerfReportScope(compileRequest, entryPointIndices, target) : String());
+
         sourceEmitter->emitModule(irModule);
+        perfRecorder.endPhase("emitSource");
     }
 
     String code = sourceWriter.getContent();
@@ -871,8 +1006,10 @@ SlangResult emitEntryPointsSourceFromIR(
 
 SlangResult emitSPIRVFromIR(
     BackEndCompileRequest*  compileRequest,
+    TargetRequest*          targetRequest,
     IRModule*               irModule,
     const List<IRFunc*>&    irEntryPoints,
+    uint32_t                spirvVersion,
     List<uint8_t>&          spirvOut);
 
 SlangResult emitSPIRVForEntryPointsDirectly(
@@ -881,20 +1018,25 @@ SlangResult emitSPIRVForEntryPointsDirectly(
     TargetRequest*          targetRequest,
     List<uint8_t>&          spirvOut)
 {
-    auto sink = compileRequest->getSink();
-    auto program = compileRequest->getProgram();
-    auto targetProgram = program->getTargetProgram(targetRequest);
-    auto programLayout = targetProgram->getOrCreateLayout(sink);
-
-    RefPtr<EntryPointLayout> entryPointLayout = programLayout->entryPoints[entryPointIndices[0]];
+    spirvOut.clear();
 
     // Outside because we want to keep IR in scope whilst we are processing emits
     LinkedIR linkedIR;
+
+    // The IR is linked and legalized as it would be for GLSL output, so that
+    // the definitions of intrinsics for GLSL are selected, and varying entry
+    // point parameters are moved to (builtin or user defined) global inputs
+    // and outputs, which is how SPIR-V represents them.
+    //
+    RefPtr<GLSLExtensionTracker> glslExtensionTracker = new GLSLExtensionTracker;
+
     LinkingAndOptimizationOptions linkingAndOptimizationOptions;
+    linkingAndOptimizationOptions.glslExtensionTracker = glslExtensionTracker;
+
     SLANG_RETURN_ON_FAIL(linkAndOptimizeIR(
         compileRequest,
         entryPointIndices,
-        targetRequest->getTarget(),
+        CodeGenTarget::GLSL,
         targetRequest,
         linkingAndOptimizationOptions,
         linkedIR));
@@ -902,12 +1044,21 @@ SlangResult emitSPIRVForEntryPointsDirectly(
     auto irModule = linkedIR.module;
     auto irEntryPoints = linkedIR.entryPoints;
 
-    emitSPIRVFromIR(
+    PerfReport* perfReport = compileRequest->perfReport;
+    PerfPhaseRecorder perfRecorder(perfReport, perfReport ? _getPerfReportScope(compileRequest, entryPointIndices, CodeGenTarget::SPIRV) : String());
+
+    // Legalization may require a minimum SPIR-V version (as it would for glslang).
+    const SemanticVersion& spirvVersion = glslExtensionTracker->getSPIRVVersion();
+
+    SLANG_RETURN_ON_FAIL(emitSPIRVFromIR(
         compileRequest,
+        targetRequest,
         irModule,
         irEntryPoints,
-        spirvOut);
+        (uint32_t(spirvVersion.m_major) << 16) | (uint32_t(spirvVersion.m_minor) << 8),
+        spirvOut));
 
+    perfRecorder.endPhase("emitSPIRV");
     return SLANG_OK;
 }
 
@@ -2,6 +2,9 @@
 
 #include "../../slang-com-ptr.h"
 #include "../core/slang-io.h"
+#include "../core/slang-blob.h"
+#include "../core/slang-riff.h"
+#include "../core/slang-text-io.h"
 #include "../core/slang-string-util.h"
 
 namespace Slang
@@ -46,7 +49,8 @@ ISlangUnknown* OSFileSystem::getInterface(const Guid& guid)
 
 /* !!!!!!!!!!!!!!!!!!!!!!!!!! OSFileSystemExt !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!*/
 
-/* static */OSFileSystemExt OSFileSystemExt::s_singleton; 
+/* static */OSFileSystemExt OSFileSystemExt::s_singleton(false);
+/* static */OSFileSystemExt OSFileSystemExt::s_mappedSingleton(true);
 
 template <typename T>
 static ISlangFileSystemExt* _getInterface(T* ptr, const Guid& guid)
@@ -102,6 +106,36 @@ SlangResult SLANG_MCALL OSFileSystemExt::getPathType(const char* pathIn, SlangPa
     return Path::getPathType(_fixPathDelimiters(pathIn), pathTypeOut);
 }
 
+// Files at least this size are memory mapped by OSFileSystemExt::loadFile. For smaller files the cost
+// of setting up (and tearing down) the mapping is more than the cost of copying the contents.
+static const uint64_t kMinMappedFileSize = 16 * 1024;
+
+// True if the contents of a file can be used as is. That is the case for a RIFF container (which is binary),
+// or text that reading through StreamReader wouldn't change - UTF-8 without a byte order mark, no
+// characters that could indicate UTF-16 and no carriage returns (which are converted to \n).
+static bool _canUseFileContentsAsIs(const void* data, size_t size)
+{
+    const uint8_t* bytes = (const uint8_t*)data;
+    if (size >= sizeof(FourCC))
+    {
+        FourCC fourCC;
+        ::memcpy(&fourCC, bytes, sizeof(fourCC));
+        if (fourCC == RiffFourCC::kRiff)
+        {
+            return true;
+        }
+    }
+
+    // Byte order marks
+    if ((size >= 3 && bytes[0] == 0xef && bytes[1] == 0xbb && bytes[2] == 0xbf) ||
+        (size >= 2 && ((bytes[0] == 0xff && bytes[1] == 0xfe) || (bytes[0] == 0xfe && bytes[1] == 0xff))))
+    {
+        return false;
+    }
+
+    return ::memchr(bytes, 0, size) == nullptr && ::memchr(bytes, '\r', size) == nullptr;
+}
+
 SlangResult OSFileSystemExt::loadFile(char const* pathIn, ISlangBlob** outBlob)
 {
     // Default implementation that uses the `core` libraries facilities for talking to the OS filesystem.
@@ -116,9 +150,51 @@ SlangResult OSFileSystemExt::loadFile(char const* pathIn, ISlangBlob** outBlob)
         return SLANG_E_NOT_FOUND;
     }
 
+    // If enabled, large files whose contents don't need converting are mapped, so their contents are shared
+    // with the OS page cache (and from the blob with SourceFile and the lexer) without any copies.
+    // If the file changed while it was being mapped the contents may not be consistent, so it's read instead.
+    uint64_t fileSize, modifiedTime;
+    if (m_mapFiles &&
+        SLANG_SUCCEEDED(File::getSizeAndModifiedTime(path, fileSize, modifiedTime)) && fileSize >= kMinMappedFileSize)
+    {
+        RefPtr<MappedFileBlob> mappedBlob;
+        uint64_t mappedFileSize, mappedModifiedTime;
+        if (SLANG_SUCCEEDED(MappedFileBlob::create(path, mappedBlob)) &&
+            SLANG_SUCCEEDED(File::getSizeAndModifiedTime(path, mappedFileSize, mappedModifiedTime)) &&
+            mappedFileSize == fileSize && mappedModifiedTime == modifiedTime &&
+            mappedBlob->getBufferSize() == fileSize &&
+            _canUseFileContentsAsIs(mappedBlob->getBufferPointer(), mappedBlob->getBufferSize()))
+        {
+            *outBlob = mappedBlob.detach();
+            return SLANG_OK;
+        }
+    }
+
     try
     {
-        String sourceString = File::readAllText(path);
+        RefPtr<Stream> stream = new FileStream(path, FileMode::Open, FileAccess::Read, FileShare::ReadWrite);
+
+        // A RIFF container (such as a serialized module) is binary, so is loaded as is. Anything else is
+        // text, which is converted to UTF-8.
+        FourCC fourCC = 0;
+        if (stream->read(&fourCC, sizeof(fourCC)) == sizeof(fourCC) && fourCC == RiffFourCC::kRiff)
+        {
+            List<uint8_t> data;
+            data.addRange((const uint8_t*)&fourCC, sizeof(fourCC));
+
+            uint8_t buffer[4096];
+            size_t readSize;
+            while ((readSize = stream->read(buffer, sizeof(buffer))) > 0)
+            {
+                data.addRange(buffer, Index(readSize));
+            }
+            *outBlob = ListBlob::moveCreate(data).detach();
+            return SLANG_OK;
+        }
+        stream->seek(SeekOrigin::Start, 0);
+
+        StreamReader reader(stream);
+        String sourceString = reader.ReadToEnd();
         *outBlob = StringUtil::createStringBlob(sourceString).detach();
         return SLANG_OK;
     }
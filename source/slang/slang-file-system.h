@@ -59,17 +59,25 @@ public:
         size_t size) SLANG_OVERRIDE ;
 
 
-        /// Get a default instance
+        /// Get a default instance. Files are always read into memory, so the file system can change freely
+        /// while the contents are in use.
     static ISlangFileSystemExt* getSingleton() { return &s_singleton; }
+        /// Get an instance that memory maps large files rather than reading them (see MappedFileBlob).
+        /// Blobs it returns keep the file mapped, so the files must not be modified while they are in use -
+        /// typically for the lifetime of the session that loaded them.
+    static ISlangFileSystemExt* getMappedSingleton() { return &s_mappedSingleton; }
 
 private:
         /// Make so not constructible
-    OSFileSystemExt() {}
+    OSFileSystemExt(bool mapFiles) : m_mapFiles(mapFiles) {}
     virtual ~OSFileSystemExt() {}
 
     ISlangUnknown* getInterface(const Guid& guid);
 
+    bool m_mapFiles;                        ///< If set large files are mapped rather than read
+
     static OSFileSystemExt s_singleton;
+    static OSFileSystemExt s_mappedSingleton;
 };
 
 // Implementation of ISlangFileSystem for the OS (ie only has simplified interface of just loadFile)
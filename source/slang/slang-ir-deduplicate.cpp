@@ -21,6 +21,7 @@ namespace Slang
             if (auto newValue = builder->constantMap.TryGetValue(key))
                 return *newValue;
             builder->constantMap[key] = value;
+            value->isDeduplicated = 1;
             return value;
         }
         IRInst* addTypeValue(IRInst* value)
@@ -44,6 +45,7 @@ namespace Slang
             if (auto newValue = builder->globalValueNumberingMap.TryGetValue(key))
                 return *newValue;
             builder->globalValueNumberingMap[key] = value;
+            value->isDeduplicated = 1;
             return value;
         }
     };
@@ -257,7 +257,10 @@ struct DepthFirstSearchContext
         preVisit(block);
         for(auto succ : block->getSuccessors())
         {
-            if(!visited.Contains(succ))
+            // A `switch` need not have a `default` label (e.g. a dynamic
+            // dispatch `switch` for an interface with no conforming types),
+            // in which case that successor is null.
+            if(succ && !visited.Contains(succ))
             {
                 walk(succ);
             }
@@ -59,7 +59,12 @@ struct IntroduceExplicitGlobalContextPass
                     // this is represented as a variable with the `@GroupShared`
                     // rate on its type.
                     //
-                    if( m_target == CodeGenTarget::CUDASource )
+                    // On CPU all the invocations of a thread group are run
+                    // on the same thread, and so a `groupshared` variable
+                    // can be a `thread_local` global, which is shared
+                    // between them and not with groups run on other threads.
+                    //
+                    if( m_target == CodeGenTarget::CUDASource || m_target == CodeGenTarget::CPPSource )
                     {
                         if( as<IRGroupSharedRate>(globalVar->getRate()) )
                             continue;
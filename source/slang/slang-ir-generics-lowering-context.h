@@ -25,6 +25,8 @@ namespace Slang
 
         LowerGenericsOptions options = kLowerGeneicsOptions_None;
 
+        WitnessTableIDTurn witnessTableIDTurn;
+
         // RTTI objects for each type used to call a generic function.
         OrderedDictionary<IRInst*, IRInst*> mapTypeToRTTIObject;
 
@@ -0,0 +1,238 @@
+// slang-ir-gvn.cpp
+#include "slang-ir-gvn.h"
+
+#include "slang-ir.h"
+#include "slang-ir-insts.h"
+#include "slang-ir-dominators.h"
+
+namespace Slang
+{
+
+static bool _isCommutative(IROp op)
+{
+    switch (op)
+    {
+        case kIROp_Add:
+        case kIROp_Mul:
+        case kIROp_Eql:
+        case kIROp_Neq:
+        case kIROp_BitAnd:
+        case kIROp_BitXor:
+        case kIROp_BitOr:
+        case kIROp_And:
+        case kIROp_Or:
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+namespace { // anonymous
+
+// Identifies the value computed by a pure instruction, by its op, type and operands.
+// The operands of a commutative operation match in either order.
+struct ValueKey
+{
+    HashCode getHashCode() const
+    {
+        HashCode code = combineHash(Slang::getHashCode(inst->op), Slang::getHashCode(inst->getFullType()));
+
+        const UInt operandCount = inst->getOperandCount();
+        code = combineHash(code, Slang::getHashCode(operandCount));
+
+        if (operandCount == 2 && _isCommutative(inst->op))
+        {
+            // Combine such that the order of the operands doesn't matter
+            return combineHash(code, Slang::getHashCode(inst->getOperand(0)) ^ Slang::getHashCode(inst->getOperand(1)));
+        }
+
+        for (UInt i = 0; i < operandCount; ++i)
+        {
+            code = combineHash(code, Slang::getHashCode(inst->getOperand(i)));
+        }
+        return code;
+    }
+
+    bool operator==(const ValueKey& rhs) const
+    {
+        IRInst* a = inst;
+        IRInst* b = rhs.inst;
+
+        const UInt operandCount = a->getOperandCount();
+        if (a->op != b->op ||
+            a->getFullType() != b->getFullType() ||
+            operandCount != b->getOperandCount())
+        {
+            return false;
+        }
+
+        if (operandCount == 2 && _isCommutative(a->op) &&
+            a->getOperand(0) == b->getOperand(1) &&
+            a->getOperand(1) == b->getOperand(0))
+        {
+            return true;
+        }
+
+        for (UInt i = 0; i < operandCount; ++i)
+        {
+            if (a->getOperand(i) != b->getOperand(i))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    IRInst* inst;
+};
+
+struct GlobalValueNumberingContext
+{
+    void processFunc(IRFunc* func)
+    {
+        auto firstBlock = func->getFirstBlock();
+        if (!firstBlock)
+        {
+            return;
+        }
+
+        m_dominatorTree = computeDominatorTree(func);
+        _processBlock(firstBlock);
+
+        m_dominatorTree.setNull();
+        SLANG_ASSERT(m_undoStack.getCount() == 0);
+    }
+
+    bool m_changed = false;
+
+protected:
+    // An entry in the value map, as it was before it was set while processing a block.
+    // `previousInst` is nullptr if there was no entry.
+    struct UndoEntry
+    {
+        ValueKey key;
+        IRInst* previousInst;
+    };
+
+    void _replace(IRInst* inst, IRInst* existing)
+    {
+        inst->replaceUsesWith(existing);
+        inst->removeAndDeallocate();
+        m_changed = true;
+    }
+
+    void _setValue(IRInst* inst)
+    {
+        ValueKey key;
+        key.inst = inst;
+
+        UndoEntry undoEntry;
+        undoEntry.key = key;
+        undoEntry.previousInst = nullptr;
+        m_valueMap.TryGetValue(key, undoEntry.previousInst);
+
+        m_undoStack.add(undoEntry);
+        m_valueMap[key] = inst;
+    }
+
+    // Processes the block, and then the blocks it dominates. The values available in a block are
+    // those computed in the blocks that dominate it.
+    void _processBlock(IRBlock* block)
+    {
+        const Index undoStart = m_undoStack.getCount();
+
+        // Loads can only be replaced by loads in the same block, and only until something that might
+        // write memory is seen. Maps an address to the value loaded from it.
+        Dictionary<IRInst*, IRInst*> loads;
+
+        IRInst* nextInst = nullptr;
+        for (IRInst* inst = block->getFirstChild(); inst; inst = nextInst)
+        {
+            nextInst = inst->getNextInst();
+
+            if (auto load = as<IRLoad>(inst))
+            {
+                IRInst* existing = nullptr;
+                if (loads.TryGetValue(load->ptr.get(), existing))
+                {
+                    _replace(inst, existing);
+                }
+                else
+                {
+                    loads.Add(load->ptr.get(), inst);
+                }
+                continue;
+            }
+
+            if (inst->mightHaveSideEffects())
+            {
+                loads.Clear();
+                continue;
+            }
+
+            if (!isPureValueInst(inst) || inst->findDecoration<IRPreciseDecoration>())
+            {
+                continue;
+            }
+
+            ValueKey key;
+            key.inst = inst;
+
+            IRInst* existing = nullptr;
+            if (m_valueMap.TryGetValue(key, existing))
+            {
+                // A value that can't be held in a temporary is folded into its uses when emitted, which
+                // only works in the block it is defined in.
+                if (existing->getParent() == block || canHoldInTemporary(inst->getDataType()))
+                {
+                    _replace(inst, existing);
+                    continue;
+                }
+            }
+
+            _setValue(inst);
+        }
+
+        for (auto dominatedBlock : m_dominatorTree->getImmediatelyDominatedBlocks(block))
+        {
+            _processBlock(dominatedBlock);
+        }
+
+        // Restore the values to how they were before the block
+        for (Index i = m_undoStack.getCount() - 1; i >= undoStart; --i)
+        {
+            const auto& undoEntry = m_undoStack[i];
+            if (undoEntry.previousInst)
+            {
+                m_valueMap[undoEntry.key] = undoEntry.previousInst;
+            }
+            else
+            {
+                m_valueMap.Remove(undoEntry.key);
+            }
+        }
+        m_undoStack.setCount(undoStart);
+    }
+
+    RefPtr<IRDominatorTree> m_dominatorTree;
+    Dictionary<ValueKey, IRInst*> m_valueMap;
+    List<UndoEntry> m_undoStack;
+};
+
+} // anonymous
+
+bool applyGlobalValueNumbering(IRModule* module)
+{
+    GlobalValueNumberingContext context;
+    for (auto inst : module->getGlobalInsts())
+    {
+        if (auto func = as<IRFunc>(inst))
+        {
+            context.processFunc(func);
+        }
+    }
+    return context.m_changed;
+}
+
+}
@@ -0,0 +1,17 @@
+// slang-ir-gvn.h
+#pragma once
+
+namespace Slang
+{
+    struct IRModule;
+
+        /// Apply dominator-based global value numbering (GVN) to the functions of a module.
+        ///
+        /// An instruction that computes the same value as an instruction that dominates it
+        /// (the same pure operation on the same operands) is replaced by the dominating instruction.
+        /// A load from the same address as an earlier load in the same block, with nothing that
+        /// might write memory in between, is also replaced by the earlier load.
+        ///
+        /// Returns true if the module was changed.
+    bool applyGlobalValueNumbering(IRModule* module);
+}
@@ -56,6 +56,12 @@ struct IRLoopControlDecoration : IRDecoration
     {
         return IRLoopControl(getModeOperand()->value.intVal);
     }
+
+        /// Get the maximum number of iterations to unroll, or 0 if there is no limit
+    IRIntegerValue getMaxUnrollCount()
+    {
+        return getOperandCount() > 1 ? cast<IRIntLit>(getOperand(1))->getValue() : 0;
+    }
 };
 
 
@@ -2472,9 +2478,17 @@ struct IRBuilder
         addDecoration(value, kIROp_InterpolationModeDecoration, getIntValue(getIntType(), IRIntegerValue(mode)));
     }
 
-    void addLoopControlDecoration(IRInst* value, IRLoopControl mode)
+    void addLoopControlDecoration(IRInst* value, IRLoopControl mode, IRIntegerValue maxUnrollCount = 0)
     {
-        addDecoration(value, kIROp_LoopControlDecoration, getIntValue(getIntType(), IRIntegerValue(mode)));
+        auto modeOperand = getIntValue(getIntType(), IRIntegerValue(mode));
+        if (maxUnrollCount > 0)
+        {
+            addDecoration(value, kIROp_LoopControlDecoration, modeOperand, getIntValue(getIntType(), maxUnrollCount));
+        }
+        else
+        {
+            addDecoration(value, kIROp_LoopControlDecoration, modeOperand);
+        }
     }
 
     void addSemanticDecoration(IRInst* value, UnownedStringSlice const& text, int index = 0)
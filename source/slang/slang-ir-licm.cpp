@@ -0,0 +1,205 @@
+// slang-ir-licm.cpp
+#include "slang-ir-licm.h"
+
+#include "slang-ir.h"
+#include "slang-ir-insts.h"
+#include "slang-ir-dominators.h"
+
+namespace Slang
+{
+
+namespace { // anonymous
+
+struct LoopInvariantCodeMotionContext
+{
+    void processFunc(IRFunc* func)
+    {
+        List<IRLoop*> loops;
+        for (auto block : func->getBlocks())
+        {
+            if (auto loop = as<IRLoop>(block->getTerminator()))
+            {
+                loops.add(loop);
+            }
+        }
+        if (loops.getCount() == 0)
+        {
+            return;
+        }
+
+        // Moving instructions between blocks doesn't change the control flow graph
+        m_dominatorTree = computeDominatorTree(func);
+
+        // Instructions hoisted out of a loop that is nested in another loop may then be hoisted
+        // out of that loop too, so repeat until nothing moves. Loops usually follow the loops they
+        // are nested in, so going backwards usually moves everything in one pass.
+        for (Index pass = 0; pass <= loops.getCount(); ++pass)
+        {
+            bool hasHoisted = false;
+            for (Index i = loops.getCount() - 1; i >= 0; --i)
+            {
+                hasHoisted = _processLoop(loops[i]) || hasHoisted;
+            }
+            if (!hasHoisted)
+            {
+                break;
+            }
+            m_changed = true;
+        }
+
+        m_dominatorTree.setNull();
+    }
+
+    bool m_changed = false;
+
+protected:
+        /// True if `value` is defined in one of the blocks of the loop
+    bool _isDefinedInLoop(IRInst* value)
+    {
+        auto block = as<IRBlock>(value->getParent());
+        return block && m_loopBlocks.Contains(block);
+    }
+
+        /// True if `inst` can be moved out of the loop
+    bool _canHoist(IRInst* inst)
+    {
+        if (!isPureValueInst(inst) || inst->findDecoration<IRPreciseDecoration>())
+        {
+            return false;
+        }
+
+        // The instruction will be executed even if the part of the loop it was in isn't, so
+        // it must not be able to trap, and shouldn't be able to take any significant time.
+        switch (inst->op)
+        {
+            case kIROp_Call:
+            case kIROp_Div:
+            case kIROp_IRem:
+            case kIROp_FRem:
+            {
+                return false;
+            }
+            case kIROp_getElement:
+            {
+                if (!as<IRIntLit>(inst->getOperand(1)))
+                {
+                    return false;
+                }
+                break;
+            }
+            default: break;
+        }
+
+        auto type = inst->getDataType();
+        if (!type || !canHoldInTemporary(type) || _isDefinedInLoop(type))
+        {
+            return false;
+        }
+
+        const UInt operandCount = inst->getOperandCount();
+        for (UInt i = 0; i < operandCount; ++i)
+        {
+            if (_isDefinedInLoop(inst->getOperand(i)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+        /// Hoist the invariant instructions in `block`, followed by the loop blocks it dominates, to the end of `preheader`.
+        /// As a block is processed before the blocks it dominates, the operands of an instruction are processed before it.
+    bool _hoistFromBlock(IRBlock* block, IRBlock* preheader)
+    {
+        bool hasHoisted = false;
+
+        IRInst* nextInst = nullptr;
+        for (IRInst* inst = block->getFirstOrdinaryInst(); inst; inst = nextInst)
+        {
+            nextInst = inst->getNextInst();
+            if (_canHoist(inst))
+            {
+                inst->insertBefore(preheader->getTerminator());
+                hasHoisted = true;
+            }
+        }
+
+        for (auto dominatedBlock : m_dominatorTree->getImmediatelyDominatedBlocks(block))
+        {
+            if (m_loopBlocks.Contains(dominatedBlock))
+            {
+                hasHoisted = _hoistFromBlock(dominatedBlock, preheader) || hasHoisted;
+            }
+        }
+        return hasHoisted;
+    }
+
+    bool _processLoop(IRLoop* loop)
+    {
+        auto preheader = as<IRBlock>(loop->getParent());
+        auto header = loop->getTargetBlock();
+        if (!preheader || m_dominatorTree->isUnreachable(preheader))
+        {
+            return false;
+        }
+
+        // The blocks of the loop are the header, and the blocks that can reach a back edge
+        // (a branch to the header from a block it dominates) without going through the header.
+        m_loopBlocks.Clear();
+        m_loopBlocks.Add(header);
+
+        List<IRBlock*> workList;
+        for (auto predecessor : header->getPredecessors())
+        {
+            if (predecessor != preheader &&
+                m_dominatorTree->dominates(header, predecessor) &&
+                m_loopBlocks.Add(predecessor))
+            {
+                workList.add(predecessor);
+            }
+        }
+
+        // If nothing branches back to the header, the body is executed at most once
+        if (workList.getCount() == 0)
+        {
+            return false;
+        }
+
+        while (workList.getCount())
+        {
+            IRBlock* block = workList.getLast();
+            workList.removeLast();
+
+            for (auto predecessor : block->getPredecessors())
+            {
+                if (m_dominatorTree->dominates(header, predecessor) &&
+                    m_loopBlocks.Add(predecessor))
+                {
+                    workList.add(predecessor);
+                }
+            }
+        }
+
+        return _hoistFromBlock(header, preheader);
+    }
+
+    RefPtr<IRDominatorTree> m_dominatorTree;
+    HashSet<IRBlock*> m_loopBlocks;                 ///< The blocks of the loop being processed
+};
+
+} // anonymous
+
+bool hoistLoopInvariantInsts(IRModule* module)
+{
+    LoopInvariantCodeMotionContext context;
+    for (auto inst : module->getGlobalInsts())
+    {
+        if (auto func = as<IRFunc>(inst))
+        {
+            context.processFunc(func);
+        }
+    }
+    return context.m_changed;
+}
+
+}
@@ -0,0 +1,17 @@
+// slang-ir-licm.h
+#pragma once
+
+namespace Slang
+{
+    struct IRModule;
+
+        /// Apply loop-invariant code motion (LICM) to the functions of a module.
+        ///
+        /// Pure instructions in a loop whose operands are all defined outside of the loop
+        /// compute the same value on every iteration, so are moved to the block that enters
+        /// the loop. Only instructions that are safe to execute when the loop body isn't
+        /// (that can't trap), and whose values can be held in temporaries, are moved.
+        ///
+        /// Returns true if the module was changed.
+    bool hoistLoopInvariantInsts(IRModule* module);
+}
@@ -40,12 +40,22 @@ struct IRSharedSpecContext
     // The specialized module we are building
     RefPtr<IRModule>   module;
 
+    // The symbol indices of the *original* modules
+    // being linked, in the order their global values
+    // are considered.
+    List<const IRModuleSymbolIndex*> symbolIndices;
+
     // A map from mangled symbol names to zero or
     // more global IR values that have that name,
-    // in the *original* module.
+    // in the *original* modules. Only holds the
+    // names that have been looked up (a name with no
+    // values maps to nullptr).
     typedef Dictionary<String, RefPtr<IRSpecSymbol>> SymbolDictionary;
     SymbolDictionary symbols;
 
+        /// Find the global values with the mangled name in the original modules, or nullptr if there are none
+    IRSpecSymbol* findSymbols(const String& mangledName);
+
     SharedIRBuilder sharedBuilderStorage;
     IRBuilder builderStorage;
 
@@ -61,7 +71,7 @@ struct IRSpecContextBase
 
     IRModule* getModule() { return getShared()->module; }
 
-    IRSharedSpecContext::SymbolDictionary& getSymbols() { return getShared()->symbols; }
+    IRSpecSymbol* findSymbols(const String& mangledName) { return getShared()->findSymbols(mangledName); }
 
     // The current specialization environment to use.
     IRSpecEnv* env = nullptr;
@@ -814,12 +824,13 @@ IRFunc* specializeIRForEntryPoint(
     // so that the mangled name of the decl-ref is
     // not the same as the mangled name of the decl.
     //
-    RefPtr<IRSpecSymbol> sym;
-    if (!context->getSymbols().TryGetValue(mangledName, sym))
+    IRSpecSymbol* sym = context->findSymbols(mangledName);
+    if (!sym)
     {
         String hashedName = getHashedName(mangledName.getUnownedSlice());
 
-        if (!context->getSymbols().TryGetValue(hashedName, sym))
+        sym = context->findSymbols(hashedName);
+        if (!sym)
         {
             SLANG_UNEXPECTED("no matching IR symbol");
             return nullptr;
@@ -1144,11 +1155,22 @@ IRInst* cloneInst(
     return clonedInst;
 }
 
+    /// Make sure the body of a global value from a lazily loaded module (such as a serialized stdlib) is present
+static void _ensureBodyLoaded(IRInst* originalInst)
+{
+    if (IRModule* module = originalInst->getModule())
+    {
+        module->ensureBodyLoaded(originalInst);
+    }
+}
+
 IRInst* cloneGlobalValueImpl(
     IRSpecContext*                  context,
     IRInst*                         originalInst,
     IROriginalValuesForClone const& originalValues)
 {
+    _ensureBodyLoaded(originalInst);
+
     auto clonedValue = cloneInst(context, &context->shared->builderStorage, originalInst, originalValues);
     clonedValue->moveToEnd();
     return clonedValue;
@@ -1196,8 +1218,8 @@ IRInst* cloneGlobalValueWithLinkage(
     // to pick the "best" one for our target.
 
     auto mangledName = String(originalLinkage->getMangledName());
-    RefPtr<IRSpecSymbol> sym;
-    if( !context->getSymbols().TryGetValue(mangledName, sym) )
+    IRSpecSymbol* sym = context->findSymbols(mangledName);
+    if( !sym )
     {
         if(!originalVal)
             return nullptr;
@@ -1217,6 +1239,13 @@ IRInst* cloneGlobalValueWithLinkage(
     for(IRSpecSymbol* ss = sym; ss; ss = ss->nextWithSameName )
     {
         IRInst* newVal = ss->irGlobalValue;
+
+        // Choosing between candidates may require looking inside of them
+        if (sym->nextWithSameName)
+        {
+            _ensureBodyLoaded(newVal);
+        }
+
         if (isBetterForTarget(context, newVal, bestVal))
             bestVal = newVal;
     }
@@ -1254,46 +1283,55 @@ IRInst* cloneGlobalValue(IRSpecContext* context, IRInst* originalVal)
         originalVal->findDecoration<IRLinkageDecoration>());
 }
 
-void insertGlobalValueSymbol(
-    IRSharedSpecContext*    sharedContext,
-    IRInst*                 gv)
+IRSpecSymbol* IRSharedSpecContext::findSymbols(const String& mangledName)
 {
-    auto linkage = gv->findDecoration<IRLinkageDecoration>();
+    RefPtr<IRSpecSymbol>* existing = symbols.TryGetValue(mangledName);
+    if (existing)
+    {
+        return *existing;
+    }
 
-    // Don't try to register a symbol for global values
-    // that don't have linkage.
-    //
-    if (!linkage)
-        return;
+    // Gather the values with the name from each of the modules. The
+    // first value found is at the head, and the rest follow it in
+    // reverse order, which is the order candidates have always been
+    // considered in (and so how ties between them are broken).
+    RefPtr<IRSpecSymbol> head;
+    const UnownedStringSlice name = mangledName.getUnownedSlice();
+    for (auto symbolIndex : symbolIndices)
+    {
+        for (Index i = symbolIndex->findFirstEntryIndex(name); i >= 0; )
+        {
+            const auto& entry = symbolIndex->getEntry(i);
 
-    auto mangledName = String(linkage->getMangledName());
+            RefPtr<IRSpecSymbol> sym = new IRSpecSymbol();
+            sym->irGlobalValue = entry.globalValue;
 
-    RefPtr<IRSpecSymbol> sym = new IRSpecSymbol();
-    sym->irGlobalValue = gv;
+            if (head)
+            {
+                sym->nextWithSameName = head->nextWithSameName;
+                head->nextWithSameName = sym;
+            }
+            else
+            {
+                head = sym;
+            }
 
-    RefPtr<IRSpecSymbol> prev;
-    if (sharedContext->symbols.TryGetValue(mangledName, prev))
-    {
-        sym->nextWithSameName = prev->nextWithSameName;
-        prev->nextWithSameName = sym;
-    }
-    else
-    {
-        sharedContext->symbols.Add(mangledName, sym);
+            i = entry.nextEntryIndex;
+        }
     }
+
+    symbols.Add(mangledName, head);
+    return head;
 }
 
-void insertGlobalValueSymbols(
+static void _addSymbolIndex(
     IRSharedSpecContext*    sharedContext,
     IRModule*               originalModule)
 {
     if (!originalModule)
         return;
 
-    for(auto ii : originalModule->getGlobalInsts())
-    {
-        insertGlobalValueSymbol(sharedContext, ii);
-    }
+    sharedContext->symbolIndices.add(originalModule->getSymbolIndex());
 }
 
 void initializeSharedSpecContext(
@@ -1376,12 +1414,31 @@ LinkedIR linkIR(
 
     state->irModule = sharedContext->module;
 
+    // Every link clones what it needs into its own new module, including
+    // the standard library functions the entry points use, choosing
+    // between target specific variants (`isBetterForTarget`) as it goes.
+    // That work is repeated by each link for a target, but it can't be
+    // shared through a pre-linked copy of the standard library per target:
+    //
+    // * Standard library declarations are lowered into each module that
+    //   uses them (see `isImportedDecl`), rather than linked in from IR
+    //   modules of the standard library, so there is no one copy to
+    //   resolve ahead of time.
+    //
+    // * The passes after linking change the linked module in place, and
+    //   IR values can't be shared between modules, so a shared copy would
+    //   still have to be cloned into every link.
+    //
+    // Only names with more than one value need a choice, so caching the
+    // choices alone saves little.
+
     auto linkage = compileRequest->getLinkage();
 
     // We need to be able to look up IR definitions for any symbols in
-    // modules that the program depends on (transitively). To
-    // accelerate lookup, we will create a symbol table for looking
-    // up IR definitions by their mangled name.
+    // modules that the program depends on (transitively). Each module
+    // holds an index of its IR definitions by mangled name, which is
+    // built once and shared by every link that uses the module, so
+    // we only need to gather the indices here.
     //
 
     List<IRModule*> irModules;
@@ -1395,7 +1452,7 @@ LinkedIR linkIR(
     // Add any modules that were loaded as libraries
     for (IRModule* irModule : irModules)
     {
-        insertGlobalValueSymbols(sharedContext, irModule);
+        _addSymbolIndex(sharedContext, irModule);
     }
 
     // We will also insert the IR global symbols from the IR module
@@ -1404,7 +1461,7 @@ LinkedIR linkIR(
     // global symbols via decorations.
     //
     auto irModuleForLayout = targetProgram->getExistingIRModuleForLayout();
-    insertGlobalValueSymbols(sharedContext, irModuleForLayout);
+    _addSymbolIndex(sharedContext, irModuleForLayout);
 
     auto context = state->getContext();
 
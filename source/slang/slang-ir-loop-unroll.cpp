@@ -0,0 +1,471 @@
+// slang-ir-loop-unroll.cpp
+#include "slang-ir-loop-unroll.h"
+
+#include "slang-ir.h"
+#include "slang-ir-insts.h"
+#include "slang-ir-clone.h"
+#include "slang-ir-sccp.h"
+
+namespace Slang
+{
+
+namespace { // anonymous
+
+// The loops unrolled are those lowered from `for` and `while` statements, that have the shape
+//
+//      preheader:  loop(header, breakBlock, continueBlock, initialArgs...)
+//      header:     (params...) ... ifElse(condition, bodyEntry, breakBlock, bodyEntry)
+//      ...         (the body, ending in a single branch back to the header with the next args)
+//      breakBlock: ...
+//
+// Unrolling a loop N times replaces it with N + 1 copies of the header, with a copy of the body
+// between each consecutive pair. The last copy of the header goes straight to the break block.
+
+struct LoopUnrollContext
+{
+    LoopUnrollContext(IRModule* module, LoopUnrollOptions const& options):
+        m_options(options)
+    {
+        m_sharedBuilder.module = module;
+        m_sharedBuilder.session = module->getSession();
+        m_sharedBuilder.deduplicateAndRebuildGlobalNumberingMap();
+        m_builder.sharedBuilder = &m_sharedBuilder;
+    }
+
+    void processFunc(IRFunc* func)
+    {
+        // The trip count of a nested loop may depend on the loop variables of the loops around
+        // it (as in `for (j = i; ...)`), so it is only known in the copies made by unrolling
+        // them. Each round can therefore unroll more loops, and as the copies are nested less
+        // deeply than the loops they were copied from, the rounds come to an end.
+        List<IRLoop*> loops;
+        for (;;)
+        {
+            loops.clear();
+            for (auto block : func->getBlocks())
+            {
+                if (auto loop = as<IRLoop>(block->getTerminator()))
+                {
+                    auto loopControl = loop->findDecoration<IRLoopControlDecoration>();
+                    if (loopControl && loopControl->getMode() == kIRLoopControl_Unroll)
+                    {
+                        loops.add(loop);
+                    }
+                }
+            }
+
+            // Loops nested in other loops follow them, so going backwards unrolls inner loops before
+            // the loops they are in. Unrolling a loop doesn't change the loops around it or beside it.
+            bool hasUnrolled = false;
+            for (Index i = loops.getCount() - 1; i >= 0; --i)
+            {
+                hasUnrolled = _processLoop(loops[i]) || hasUnrolled;
+            }
+            if (!hasUnrolled)
+            {
+                break;
+            }
+            m_changed = true;
+        }
+    }
+
+    bool m_changed = false;
+
+protected:
+
+        /// Find the blocks of the body of `loop`, the back edge, and the header condition.
+        /// Returns false if the loop doesn't have the shape that can be unrolled.
+    bool _analyzeLoop(IRLoop* loop)
+    {
+        m_header = loop->getTargetBlock();
+        m_breakBlock = loop->getBreakBlock();
+
+        auto loopTest = as<IRIfElse>(m_header->getTerminator());
+        if (!loopTest || loopTest->getFalseBlock() != m_breakBlock || loopTest->getTrueBlock() == m_breakBlock)
+        {
+            return false;
+        }
+        m_condition = loopTest->getCondition();
+        m_bodyEntry = loopTest->getTrueBlock();
+
+        // A `break` would be another branch to the break block
+        for (auto predecessor : m_breakBlock->getPredecessors())
+        {
+            if (predecessor != m_header)
+            {
+                return false;
+            }
+        }
+
+        // The body is the blocks reachable from its entry without going through the header or the
+        // break block (which is the only way out of the loop other than returning).
+        // They are found in reverse postorder, so blocks come after the blocks that dominate them.
+        m_bodyBlocks.clear();
+        m_loopBlocks.Clear();
+        m_loopBlocks.Add(m_header);
+        {
+            List<IRBlock*> postorder;
+            HashSet<IRBlock*> visited;
+            _addPostorder(m_bodyEntry, visited, postorder);
+            for (Index i = postorder.getCount() - 1; i >= 0; --i)
+            {
+                m_bodyBlocks.add(postorder[i]);
+                m_loopBlocks.Add(postorder[i]);
+            }
+        }
+
+        // There must be exactly one back edge, so the body has no `continue`. If the continue block
+        // isn't the header, `continue` would instead be another branch to the continue block.
+        m_backEdge = nullptr;
+        for (auto predecessor : m_header->getPredecessors())
+        {
+            if (!m_loopBlocks.Contains(predecessor))
+            {
+                continue;
+            }
+            auto branch = as<IRUnconditionalBranch>(predecessor->getTerminator());
+            if (m_backEdge || !branch || branch->op != kIROp_unconditionalBranch)
+            {
+                return false;
+            }
+            m_backEdge = branch;
+        }
+        if (!m_backEdge || m_backEdge->getArgCount() != loop->getArgCount())
+        {
+            return false;
+        }
+
+        for (auto block : m_bodyBlocks)
+        {
+            UInt predecessorCount = 0;
+            for (auto predecessor : block->getPredecessors())
+            {
+                // The loop must only be entered through the header
+                if (!m_loopBlocks.Contains(predecessor))
+                {
+                    return false;
+                }
+                predecessorCount++;
+            }
+            if (block == loop->getContinueBlock() && predecessorCount != 1)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void _addPostorder(IRBlock* block, HashSet<IRBlock*>& visited, List<IRBlock*>& outPostorder)
+    {
+        if (block == m_header || block == m_breakBlock || !visited.Add(block))
+        {
+            return;
+        }
+        for (auto successor : block->getSuccessors())
+        {
+            _addPostorder(successor, visited, outPostorder);
+        }
+        outPostorder.add(block);
+    }
+
+        /// Get the constant value of `inst` in an iteration, where ioValues holds the values of the header
+        /// params and of the instructions evaluated so far. Returns nullptr if the value isn't known.
+    IRInst* _evaluate(IRInst* inst, Dictionary<IRInst*, IRInst*>& ioValues)
+    {
+        if (as<IRIntLit>(inst) || as<IRBoolLit>(inst))
+        {
+            return inst;
+        }
+
+        IRInst* value = nullptr;
+        if (ioValues.TryGetValue(inst, value))
+        {
+            return value;
+        }
+
+        // Values from outside the loop are the same in every iteration, but aren't necessarily
+        // folded yet (such as the initial values of a loop in a copy made by unrolling another).
+        auto block = as<IRBlock>(inst->getParent());
+        if (!block)
+        {
+            return nullptr;
+        }
+
+        ioValues[inst] = nullptr;
+        if (auto param = as<IRParam>(inst))
+        {
+            // A param of a block with a single predecessor has the value passed by its branch
+            // (the params of the header are all in ioValues)
+            IRBlock* predecessor = nullptr;
+            for (auto p : block->getPredecessors())
+            {
+                if (predecessor)
+                {
+                    return nullptr;
+                }
+                predecessor = p;
+            }
+            auto branch = predecessor ? as<IRUnconditionalBranch>(predecessor->getTerminator()) : nullptr;
+            if (branch)
+            {
+                UInt paramIndex = 0;
+                for (auto p : block->getParams())
+                {
+                    if (p == param)
+                    {
+                        break;
+                    }
+                    paramIndex++;
+                }
+                if (paramIndex < branch->getArgCount())
+                {
+                    value = _evaluate(branch->getArg(paramIndex), ioValues);
+                }
+            }
+        }
+        else
+        {
+            const UInt operandCount = inst->getOperandCount();
+            IRInst* operandValues[2];
+            if (operandCount >= 1 && operandCount <= SLANG_COUNT_OF(operandValues))
+            {
+                bool isKnown = true;
+                for (UInt i = 0; i < operandCount && isKnown; ++i)
+                {
+                    operandValues[i] = _evaluate(inst->getOperand(i), ioValues);
+                    isKnown = operandValues[i] != nullptr;
+                }
+                if (isKnown)
+                {
+                    value = tryConstantFoldInst(&m_builder, inst, operandValues);
+                }
+            }
+        }
+
+        ioValues[inst] = value;
+        return value;
+    }
+
+        /// Find the number of times the body of the analyzed loop is executed, by evaluating the
+        /// condition with the values the header params have in each iteration.
+        /// Returns -1 if it isn't known, or is more than maxTripCount.
+    Index _findTripCount(IRLoop* loop, Index maxTripCount)
+    {
+        List<IRInst*> paramValues;
+        {
+            Dictionary<IRInst*, IRInst*> values;
+            for (UInt i = 0; i < loop->getArgCount(); ++i)
+            {
+                paramValues.add(_evaluate(loop->getArg(i), values));
+            }
+        }
+
+        for (Index tripCount = 0; ; ++tripCount)
+        {
+            Dictionary<IRInst*, IRInst*> values;
+            Index paramIndex = 0;
+            for (auto param : m_header->getParams())
+            {
+                values[param] = paramIndex < paramValues.getCount() ? paramValues[paramIndex] : nullptr;
+                paramIndex++;
+            }
+
+            auto condition = as<IRBoolLit>(_evaluate(m_condition, values));
+            if (!condition)
+            {
+                return -1;
+            }
+            if (!condition->getValue())
+            {
+                return tripCount;
+            }
+            if (tripCount == maxTripCount)
+            {
+                return -1;
+            }
+
+            // The values for the next iteration are those passed back to the header.
+            // Only those the condition depends on need to be known.
+            for (UInt i = 0; i < m_backEdge->getArgCount(); ++i)
+            {
+                paramValues[i] = _evaluate(m_backEdge->getArg(i), values);
+            }
+        }
+    }
+
+        /// Clone the non-terminator instructions of the header into `block`, which is where the builder is
+    void _cloneHeaderInsts(IRCloneEnv* env, IRBlock* block)
+    {
+        m_builder.setInsertInto(block);
+        for (auto inst : m_header->getOrdinaryInsts())
+        {
+            if (inst != m_header->getTerminator())
+            {
+                cloneInst(env, &m_builder, inst);
+            }
+        }
+    }
+
+    void _unroll(IRLoop* loop, Index tripCount)
+    {
+        // The values of the header params in the copy of the header being made
+        List<IRInst*> paramValues;
+        for (UInt i = 0; i < loop->getArgCount(); ++i)
+        {
+            paramValues.add(loop->getArg(i));
+        }
+
+        IRBlock* headerCopy = m_builder.createBlock();
+        headerCopy->insertBefore(m_breakBlock);
+        IRBlock* firstHeaderCopy = headerCopy;
+
+        IRCloneEnv env;
+        for (Index iteration = 0; ; ++iteration)
+        {
+            env.mapOldValToNew.Clear();
+            Index paramIndex = 0;
+            for (auto param : m_header->getParams())
+            {
+                env.mapOldValToNew.Add(param, paramValues[paramIndex++]);
+            }
+
+            _cloneHeaderInsts(&env, headerCopy);
+            if (iteration == tripCount)
+            {
+                m_builder.emitBranch(m_breakBlock);
+                break;
+            }
+
+            // Create all of the blocks first, as they can be branched to before they are filled in
+            for (auto block : m_bodyBlocks)
+            {
+                auto blockCopy = m_builder.createBlock();
+                blockCopy->insertBefore(m_breakBlock);
+                env.mapOldValToNew.Add(block, blockCopy);
+            }
+            IRBlock* nextHeaderCopy = m_builder.createBlock();
+            nextHeaderCopy->insertBefore(m_breakBlock);
+
+            m_builder.setInsertInto(headerCopy);
+            m_builder.emitBranch(as<IRBlock>(lookUp(&env, m_bodyEntry)));
+
+            for (auto block : m_bodyBlocks)
+            {
+                m_builder.setInsertInto(lookUp(&env, block));
+                for (auto inst : block->getChildren())
+                {
+                    if (inst != m_backEdge)
+                    {
+                        cloneInst(&env, &m_builder, inst);
+                        continue;
+                    }
+                    for (UInt i = 0; i < m_backEdge->getArgCount(); ++i)
+                    {
+                        paramValues[i] = findCloneForOperand(&env, m_backEdge->getArg(i));
+                    }
+                    m_builder.emitBranch(nextHeaderCopy);
+                }
+            }
+            headerCopy = nextHeaderCopy;
+        }
+
+        // The header is the only block of the loop the code after it can use the values of, and
+        // those are the values in the last copy of the header.
+        for (auto param : m_header->getParams())
+        {
+            param->replaceUsesWith(lookUp(&env, param));
+        }
+        for (auto inst : m_header->getOrdinaryInsts())
+        {
+            if (inst != m_header->getTerminator())
+            {
+                inst->replaceUsesWith(lookUp(&env, inst));
+            }
+        }
+
+        m_builder.setInsertBefore(loop);
+        m_builder.emitBranch(firstHeaderCopy);
+        loop->removeAndDeallocate();
+
+        // Remove the instructions of the old blocks first, as they reference each other
+        m_header->removeAndDeallocateAllDecorationsAndChildren();
+        for (auto block : m_bodyBlocks)
+        {
+            block->removeAndDeallocateAllDecorationsAndChildren();
+        }
+        m_header->removeAndDeallocate();
+        for (auto block : m_bodyBlocks)
+        {
+            block->removeAndDeallocate();
+        }
+    }
+
+    bool _processLoop(IRLoop* loop)
+    {
+        if (!_analyzeLoop(loop))
+        {
+            return false;
+        }
+
+        Index instCount = 0;
+        for (auto block : m_loopBlocks)
+        {
+            for (auto inst : block->getChildren())
+            {
+                SLANG_UNUSED(inst);
+                instCount++;
+            }
+        }
+
+        // The unrolled loop has a copy of the header for each iteration, plus one to exit
+        Index maxTripCount = m_options.maxUnrolledInstCount / instCount - 1;
+        auto loopControl = loop->findDecoration<IRLoopControlDecoration>();
+        if (auto maxUnrollCount = loopControl->getMaxUnrollCount())
+        {
+            maxTripCount = Math::Min(maxTripCount, Index(maxUnrollCount));
+        }
+        if (maxTripCount < 0)
+        {
+            return false;
+        }
+
+        const Index tripCount = _findTripCount(loop, maxTripCount);
+        if (tripCount < 0)
+        {
+            return false;
+        }
+
+        _unroll(loop, tripCount);
+        return true;
+    }
+
+    LoopUnrollOptions m_options;
+    SharedIRBuilder m_sharedBuilder;
+    IRBuilder m_builder;
+
+    // The loop being processed
+    IRBlock* m_header = nullptr;
+    IRBlock* m_breakBlock = nullptr;
+    IRBlock* m_bodyEntry = nullptr;
+    IRInst* m_condition = nullptr;
+    IRUnconditionalBranch* m_backEdge = nullptr;        ///< The branch from the end of the body to the header
+    List<IRBlock*> m_bodyBlocks;                        ///< The blocks of the body in reverse postorder
+    HashSet<IRBlock*> m_loopBlocks;                     ///< The header and the blocks of the body
+};
+
+} // anonymous
+
+bool unrollLoops(IRModule* module, LoopUnrollOptions const& options)
+{
+    LoopUnrollContext context(module, options);
+    for (auto inst : module->getGlobalInsts())
+    {
+        if (auto func = as<IRFunc>(inst))
+        {
+            context.processFunc(func);
+        }
+    }
+    return context.m_changed;
+}
+
+}
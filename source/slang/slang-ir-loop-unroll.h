@@ -0,0 +1,29 @@
+// slang-ir-loop-unroll.h
+#pragma once
+
+#include "../core/slang-basic.h"
+
+namespace Slang
+{
+    struct IRModule;
+
+    struct LoopUnrollOptions
+    {
+            /// The largest number of instructions an unrolled loop may take
+        Index maxUnrolledInstCount = 2048;
+    };
+
+        /// Fully unroll the loops in the functions of a module that are marked `[unroll]`.
+        ///
+        /// The trip count of a loop is found by constant folding its condition with the
+        /// values of the loop variables, starting from the values the loop is entered with.
+        /// A loop is only unrolled if the trip count can be found, is no more than the count
+        /// given with `[unroll(N)]`, and the unrolled code fits in the instruction budget.
+        /// Loops that `break` or `continue` are left alone.
+        ///
+        /// The loop variables of an unrolled loop are constants in each copy of the body,
+        /// so constant propagation should be run afterwards.
+        ///
+        /// Returns true if the module was changed.
+    bool unrollLoops(IRModule* module, LoopUnrollOptions const& options);
+}
@@ -107,16 +107,18 @@ namespace Slang
     }
 
     void lowerGenerics(
-        TargetRequest*          targetReq,
-        IRModule*               module,
-        DiagnosticSink*         sink,
-        LowerGenericsOptions    options)
+        TargetRequest*              targetReq,
+        IRModule*                   module,
+        DiagnosticSink*             sink,
+        LowerGenericsOptions        options,
+        WitnessTableIDTurn const&   witnessTableIDTurn)
     {
         SharedGenericsLoweringContext sharedContext;
         sharedContext.targetReq = targetReq;
         sharedContext.module = module;
         sharedContext.sink = sink;
         sharedContext.options = options;
+        sharedContext.witnessTableIDTurn = witnessTableIDTurn;
 
         // Replace all `makeExistential` insts with `makeExistentialWithRTTI`
         // before making any other changes. This is necessary because a parameter of
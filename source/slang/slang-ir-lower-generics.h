@@ -3,6 +3,8 @@
 
 #include "slang-ir.h"
 
+#include "../core/slang-thread-pool.h"
+
 namespace Slang
 {
     struct IRModule;
@@ -17,12 +19,25 @@ namespace Slang
         kLowerGenericsOption_SpecializeDispatchToKnownTargets   = 1 << 1,
     };
 
+        /// The turn of a code generation job at allocating witness table sequential IDs, when the jobs
+        /// run in parallel. The IDs are shared between the jobs, so have to be allocated in the same
+        /// order as when the jobs run serially.
+    struct WitnessTableIDTurn
+    {
+        void wait() const { if (turns) turns->waitForTurn(jobIndex); }
+        void end() const { if (turns) turns->endTurn(jobIndex); }
+
+        ParallelForTurns* turns = nullptr;          ///< nullptr if the jobs aren't run in parallel
+        Index jobIndex = -1;
+    };
+
     /// Lower generic and interface-based code to ordinary types and functions using
     /// dynamic dispatch mechanisms.
     void lowerGenerics(
-        TargetRequest*          targetReq,
-        IRModule*               module,
-        DiagnosticSink*         sink,
-        LowerGenericsOptions    options);
+        TargetRequest*              targetReq,
+        IRModule*                   module,
+        DiagnosticSink*             sink,
+        LowerGenericsOptions        options,
+        WitnessTableIDTurn const&   witnessTableIDTurn);
 
 }
@@ -0,0 +1,299 @@
+// slang-ir-peephole.cpp
+#include "slang-ir-peephole.h"
+
+#include "slang-ir.h"
+#include "slang-ir-insts.h"
+
+namespace Slang
+{
+
+namespace { // anonymous
+
+enum class ScalarKind
+{
+    None,
+    Bool,
+    Integer,
+    Float,
+};
+
+} // anonymous
+
+static ScalarKind _getScalarKind(IRType* type)
+{
+    switch (type->op)
+    {
+        case kIROp_BoolType:
+        {
+            return ScalarKind::Bool;
+        }
+        case kIROp_Int8Type:
+        case kIROp_Int16Type:
+        case kIROp_IntType:
+        case kIROp_Int64Type:
+        case kIROp_UInt8Type:
+        case kIROp_UInt16Type:
+        case kIROp_UIntType:
+        case kIROp_UInt64Type:
+        {
+            return ScalarKind::Integer;
+        }
+        case kIROp_HalfType:
+        case kIROp_FloatType:
+        case kIROp_DoubleType:
+        {
+            return ScalarKind::Float;
+        }
+        default: break;
+    }
+    return ScalarKind::None;
+}
+
+// True if `inst` is a constant of the kind with the value
+static bool _isConstant(IRInst* inst, ScalarKind kind, int value)
+{
+    switch (kind)
+    {
+        case ScalarKind::Bool:
+        {
+            auto lit = as<IRBoolLit>(inst);
+            return lit && lit->getValue() == (value != 0);
+        }
+        case ScalarKind::Integer:
+        {
+            auto lit = as<IRIntLit>(inst);
+            return lit && lit->getValue() == IRIntegerValue(value);
+        }
+        case ScalarKind::Float:
+        {
+            auto lit = as<IRConstant>(inst);
+            return lit && lit->op == kIROp_FloatLit && lit->value.floatVal == IRFloatingPointValue(value);
+        }
+        default: break;
+    }
+    return false;
+}
+
+// If `inst` is a binary operation with an operand that is the identity value for the operation (such as the 0 in `x + 0`),
+// returns the other operand.
+static IRInst* _getIdentityOperand(IRInst* inst, ScalarKind kind, int identityValue, bool isCommutative)
+{
+    IRInst* a = inst->getOperand(0);
+    IRInst* b = inst->getOperand(1);
+    IRType* type = inst->getDataType();
+
+    if (_isConstant(b, kind, identityValue) && a->getDataType() == type)
+    {
+        return a;
+    }
+    if (isCommutative && _isConstant(a, kind, identityValue) && b->getDataType() == type)
+    {
+        return b;
+    }
+    return nullptr;
+}
+
+// Get the value `inst` is equal to, or nullptr if there isn't a simpler one.
+static IRInst* _getSimplifiedValue(IRInst* inst)
+{
+    IRType* type = inst->getDataType();
+    if (!type || inst->findDecoration<IRPreciseDecoration>())
+    {
+        return nullptr;
+    }
+
+    switch (inst->op)
+    {
+        case kIROp_Construct:
+        {
+            // Conversion to the type the value already has
+            if (inst->getOperandCount() == 1 && inst->getOperand(0)->getDataType() == type)
+            {
+                return inst->getOperand(0);
+            }
+            break;
+        }
+        case kIROp_FieldExtract:
+        {
+            auto fieldExtract = static_cast<IRFieldExtract*>(inst);
+            auto base = fieldExtract->getBase();
+            auto structType = as<IRStructType>(base->getDataType());
+            if (base->op != kIROp_makeStruct || !structType)
+            {
+                break;
+            }
+
+            // The operands of makeStruct are the values of the fields in order
+            UInt fieldIndex = 0;
+            for (auto field : structType->getFields())
+            {
+                if (field->getKey() == fieldExtract->getField())
+                {
+                    return fieldIndex < base->getOperandCount() ? base->getOperand(fieldIndex) : nullptr;
+                }
+                fieldIndex++;
+            }
+            break;
+        }
+        case kIROp_getElement:
+        {
+            auto base = inst->getOperand(0);
+            auto index = as<IRIntLit>(inst->getOperand(1));
+            if (base->op == kIROp_makeArray && index &&
+                index->getValue() >= 0 && index->getValue() < IRIntegerValue(base->getOperandCount()))
+            {
+                return base->getOperand(UInt(index->getValue()));
+            }
+            break;
+        }
+        case kIROp_swizzle:
+        {
+            // A swizzle of all of the elements of a vector in order
+            auto swizzle = static_cast<IRSwizzle*>(inst);
+            auto base = swizzle->getBase();
+            if (base->getDataType() != type)
+            {
+                break;
+            }
+            const UInt elementCount = swizzle->getElementCount();
+            for (UInt i = 0; i < elementCount; ++i)
+            {
+                auto elementIndex = as<IRIntLit>(swizzle->getElementIndex(i));
+                if (!elementIndex || elementIndex->getValue() != IRIntegerValue(i))
+                {
+                    return nullptr;
+                }
+            }
+            return base;
+        }
+        case kIROp_Neg:
+        case kIROp_Not:
+        case kIROp_BitNot:
+        {
+            // Applying the operation twice
+            auto operand = inst->getOperand(0);
+            if (operand->op == inst->op && operand->getOperand(0)->getDataType() == type)
+            {
+                return operand->getOperand(0);
+            }
+            break;
+        }
+        case kIROp_Add:
+        case kIROp_BitOr:
+        case kIROp_BitXor:
+        {
+            if (inst->op == kIROp_BitOr && inst->getOperand(0) == inst->getOperand(1))
+            {
+                return inst->getOperand(0);
+            }
+            // Floating point x + 0 isn't x when x is -0
+            if (_getScalarKind(type) == ScalarKind::Integer)
+            {
+                return _getIdentityOperand(inst, ScalarKind::Integer, 0, true);
+            }
+            break;
+        }
+        case kIROp_Sub:
+        case kIROp_Lsh:
+        case kIROp_Rsh:
+        {
+            if (_getScalarKind(type) == ScalarKind::Integer)
+            {
+                return _getIdentityOperand(inst, ScalarKind::Integer, 0, false);
+            }
+            break;
+        }
+        case kIROp_Mul:
+        case kIROp_Div:
+        {
+            const ScalarKind kind = _getScalarKind(type);
+            if (kind == ScalarKind::Integer || kind == ScalarKind::Float)
+            {
+                return _getIdentityOperand(inst, kind, 1, inst->op == kIROp_Mul);
+            }
+            break;
+        }
+        case kIROp_BitAnd:
+        {
+            if (inst->getOperand(0) == inst->getOperand(1))
+            {
+                return inst->getOperand(0);
+            }
+            break;
+        }
+        case kIROp_And:
+        case kIROp_Or:
+        {
+            if (inst->getOperand(0) == inst->getOperand(1))
+            {
+                return inst->getOperand(0);
+            }
+            if (_getScalarKind(type) == ScalarKind::Bool)
+            {
+                return _getIdentityOperand(inst, ScalarKind::Bool, inst->op == kIROp_And ? 1 : 0, true);
+            }
+            break;
+        }
+        case kIROp_Select:
+        {
+            auto trueValue = inst->getOperand(1);
+            auto falseValue = inst->getOperand(2);
+            if (trueValue == falseValue)
+            {
+                return trueValue;
+            }
+            if (auto condition = as<IRBoolLit>(inst->getOperand(0)))
+            {
+                return condition->getValue() ? trueValue : falseValue;
+            }
+            break;
+        }
+        default: break;
+    }
+    return nullptr;
+}
+
+static bool _applyPeepholeOptimizations(IRFunc* func)
+{
+    bool changed = false;
+    for (auto block : func->getBlocks())
+    {
+        IRInst* nextInst = nullptr;
+        for (IRInst* inst = block->getFirstOrdinaryInst(); inst; inst = nextInst)
+        {
+            nextInst = inst->getNextInst();
+
+            // Replacing an operand may make another rule apply, so keep going until
+            // the instruction can't be simplified any further.
+            IRInst* value = _getSimplifiedValue(inst);
+            if (!value)
+            {
+                continue;
+            }
+            while (IRInst* simplerValue = _getSimplifiedValue(value))
+            {
+                value = simplerValue;
+            }
+
+            inst->replaceUsesWith(value);
+            inst->removeAndDeallocate();
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+bool applyPeepholeOptimizations(IRModule* module)
+{
+    bool changed = false;
+    for (auto inst : module->getGlobalInsts())
+    {
+        if (auto func = as<IRFunc>(inst))
+        {
+            changed = _applyPeepholeOptimizations(func) || changed;
+        }
+    }
+    return changed;
+}
+
+}
@@ -0,0 +1,17 @@
+// slang-ir-peephole.h
+#pragma once
+
+namespace Slang
+{
+    struct IRModule;
+
+        /// Apply peephole optimizations to the functions of a module.
+        ///
+        /// Replaces instructions whose result is simply one of their operands (or one
+        /// of the operands of an operand), such as arithmetic identities (`x + 0`, `x * 1`),
+        /// double negation, conversions to the type a value already has, identity swizzles,
+        /// and extracting a field or element from the instruction that made the aggregate.
+        ///
+        /// Returns true if the module was changed.
+    bool applyPeepholeOptimizations(IRModule* module);
+}
@@ -6,6 +6,260 @@
 
 namespace Slang {
 
+// Before getting to the SCCP algorithm itself, we define the constant folding
+// it uses: computing the result of an operation given constant operands.
+//
+// We only fold operations on integer and `Bool` scalars. Floating-point folding
+// would need to exactly match the rounding behavior of each target, so it is
+// left to downstream compilers.
+
+    /// Get the bit count and signedness of an integer `type`, returning false if it isn't an integer type
+static bool _getIntTypeInfo(IRType* type, int& outBitCount, bool& outIsSigned)
+{
+    switch (type->op)
+    {
+        case kIROp_Int8Type:    outBitCount = 8;  outIsSigned = true;  return true;
+        case kIROp_Int16Type:   outBitCount = 16; outIsSigned = true;  return true;
+        case kIROp_IntType:     outBitCount = 32; outIsSigned = true;  return true;
+        case kIROp_Int64Type:   outBitCount = 64; outIsSigned = true;  return true;
+        case kIROp_UInt8Type:   outBitCount = 8;  outIsSigned = false; return true;
+        case kIROp_UInt16Type:  outBitCount = 16; outIsSigned = false; return true;
+        case kIROp_UIntType:    outBitCount = 32; outIsSigned = false; return true;
+        case kIROp_UInt64Type:  outBitCount = 64; outIsSigned = false; return true;
+        default: return false;
+    }
+}
+
+    /// Wrap `value` to the range of the integer type. Signed values are sign extended and
+    /// unsigned values narrower than 64 bits are zero extended, which is how literals of the types are held.
+static IRIntegerValue _wrapToType(IRIntegerValue value, int bitCount, bool isSigned)
+{
+    if (bitCount >= 64)
+    {
+        return value;
+    }
+    const uint64_t mask = (uint64_t(1) << bitCount) - 1;
+    uint64_t bits = uint64_t(value) & mask;
+    if (isSigned && (bits >> (bitCount - 1)))
+    {
+        bits |= ~mask;
+    }
+    return IRIntegerValue(bits);
+}
+
+    /// The most operands of an operation that can be folded
+static const UInt kMaxFoldOperandCount = 2;
+
+static IRInst* _foldIntOperation(IRBuilder* builder, IRInst* inst, IRInst* const* operandValues)
+{
+    IRType* type = inst->getDataType();
+
+    // Comparisons produce a `Bool`, so their operation type is that of the operands
+    IRType* operandType = operandValues[0]->getDataType();
+
+    int bitCount;
+    bool isSigned;
+    if (!_getIntTypeInfo(operandType, bitCount, isSigned))
+    {
+        return nullptr;
+    }
+
+    const IRIntegerValue a = static_cast<IRIntLit*>(operandValues[0])->getValue();
+    if (inst->getOperandCount() == 1)
+    {
+        switch (inst->op)
+        {
+            case kIROp_Neg:     return builder->getIntValue(type, _wrapToType(IRIntegerValue(0 - uint64_t(a)), bitCount, isSigned));
+            case kIROp_BitNot:  return builder->getIntValue(type, _wrapToType(~a, bitCount, isSigned));
+            default:            return nullptr;
+        }
+    }
+
+    auto bLit = as<IRIntLit>(operandValues[1]);
+    if (!bLit)
+    {
+        return nullptr;
+    }
+    const IRIntegerValue b = bLit->getValue();
+
+    // The shift amount can be of a different type to the value shifted
+    if (inst->op == kIROp_Lsh || inst->op == kIROp_Rsh)
+    {
+        if (b < 0 || b >= bitCount)
+        {
+            return nullptr;
+        }
+        const IRIntegerValue value = (inst->op == kIROp_Lsh) ?
+            IRIntegerValue(uint64_t(a) << b) :
+            (isSigned ? (a >> b) : IRIntegerValue(uint64_t(a) >> b));
+        return builder->getIntValue(type, _wrapToType(value, bitCount, isSigned));
+    }
+
+    if (bLit->getDataType() != operandType)
+    {
+        return nullptr;
+    }
+
+    // Unsigned 64 bit values are held as their bit pattern, so need unsigned comparison
+    const bool isLess = isSigned ? (a < b) : (uint64_t(a) < uint64_t(b));
+
+    switch (inst->op)
+    {
+        case kIROp_Eql:     return builder->getBoolValue(a == b);
+        case kIROp_Neq:     return builder->getBoolValue(a != b);
+        case kIROp_Less:    return builder->getBoolValue(isLess);
+        case kIROp_Geq:     return builder->getBoolValue(!isLess);
+        case kIROp_Greater: return builder->getBoolValue(!isLess && a != b);
+        case kIROp_Leq:     return builder->getBoolValue(isLess || a == b);
+        default: break;
+    }
+
+    if (type != operandType)
+    {
+        return nullptr;
+    }
+
+    IRIntegerValue value;
+    switch (inst->op)
+    {
+        case kIROp_Add:     value = IRIntegerValue(uint64_t(a) + uint64_t(b)); break;
+        case kIROp_Sub:     value = IRIntegerValue(uint64_t(a) - uint64_t(b)); break;
+        case kIROp_Mul:     value = IRIntegerValue(uint64_t(a) * uint64_t(b)); break;
+        case kIROp_BitAnd:  value = a & b; break;
+        case kIROp_BitOr:   value = a | b; break;
+        case kIROp_BitXor:  value = a ^ b; break;
+        case kIROp_Div:
+        case kIROp_IRem:
+        {
+            // Division by zero, and overflow of signed division, are undefined
+            if (b == 0 || (isSigned && b == -1 && a == _wrapToType(IRIntegerValue(uint64_t(1) << (bitCount - 1)), bitCount, true)))
+            {
+                return nullptr;
+            }
+            if (isSigned)
+            {
+                value = (inst->op == kIROp_Div) ? (a / b) : (a % b);
+            }
+            else
+            {
+                value = IRIntegerValue((inst->op == kIROp_Div) ? (uint64_t(a) / uint64_t(b)) : (uint64_t(a) % uint64_t(b)));
+            }
+            break;
+        }
+        default: return nullptr;
+    }
+    return builder->getIntValue(type, _wrapToType(value, bitCount, isSigned));
+}
+
+static IRInst* _foldBoolOperation(IRBuilder* builder, IRInst* inst, IRInst* const* operandValues)
+{
+    const bool a = static_cast<IRBoolLit*>(operandValues[0])->getValue();
+    if (inst->getOperandCount() == 1)
+    {
+        return (inst->op == kIROp_Not) ? builder->getBoolValue(!a) : nullptr;
+    }
+
+    auto bLit = as<IRBoolLit>(operandValues[1]);
+    if (!bLit)
+    {
+        return nullptr;
+    }
+    const bool b = bLit->getValue();
+
+    switch (inst->op)
+    {
+        case kIROp_Eql:     return builder->getBoolValue(a == b);
+        case kIROp_Neq:
+        case kIROp_BitXor:  return builder->getBoolValue(a != b);
+        case kIROp_And:
+        case kIROp_BitAnd:  return builder->getBoolValue(a && b);
+        case kIROp_Or:
+        case kIROp_BitOr:   return builder->getBoolValue(a || b);
+        default:            return nullptr;
+    }
+}
+
+IRInst* tryConstantFoldInst(IRBuilder* builder, IRInst* inst, IRInst* const* operandValues)
+{
+    IRType* type = inst->getDataType();
+    if (!type || inst->getOperandCount() < 1 || inst->getOperandCount() > kMaxFoldOperandCount)
+    {
+        return nullptr;
+    }
+
+    switch (inst->op)
+    {
+        case kIROp_Construct:
+        {
+            // A conversion between integer and `Bool` scalar types
+            if (inst->getOperandCount() != 1)
+            {
+                return nullptr;
+            }
+
+            IRIntegerValue value;
+            if (auto intLit = as<IRIntLit>(operandValues[0]))
+            {
+                value = intLit->getValue();
+            }
+            else if (auto boolLit = as<IRBoolLit>(operandValues[0]))
+            {
+                value = boolLit->getValue() ? 1 : 0;
+            }
+            else
+            {
+                return nullptr;
+            }
+
+            int bitCount;
+            bool isSigned;
+            if (type->op == kIROp_BoolType)
+            {
+                return builder->getBoolValue(value != 0);
+            }
+            if (_getIntTypeInfo(type, bitCount, isSigned))
+            {
+                return builder->getIntValue(type, _wrapToType(value, bitCount, isSigned));
+            }
+            return nullptr;
+        }
+
+        case kIROp_Add:
+        case kIROp_Sub:
+        case kIROp_Mul:
+        case kIROp_Div:
+        case kIROp_IRem:
+        case kIROp_Lsh:
+        case kIROp_Rsh:
+        case kIROp_Eql:
+        case kIROp_Neq:
+        case kIROp_Greater:
+        case kIROp_Less:
+        case kIROp_Geq:
+        case kIROp_Leq:
+        case kIROp_BitAnd:
+        case kIROp_BitXor:
+        case kIROp_BitOr:
+        case kIROp_And:
+        case kIROp_Or:
+        case kIROp_Neg:
+        case kIROp_Not:
+        case kIROp_BitNot:
+        {
+            if (as<IRIntLit>(operandValues[0]))
+            {
+                return _foldIntOperation(builder, inst, operandValues);
+            }
+            if (as<IRBoolLit>(operandValues[0]))
+            {
+                return _foldBoolOperation(builder, inst, operandValues);
+            }
+            return nullptr;
+        }
+
+        default: return nullptr;
+    }
+}
 
 // This file implements the Spare Conditional Constant Propagation (SCCP) optimization.
 //
@@ -254,44 +508,63 @@ struct SCCPContext
             break;
         }
 
-        // TODO: We should now look up the lattice values for
-        // the operands of the instruction.
+        // A `select` with a constant condition has the value of the
+        // operand it selects, which need not be a constant we can fold,
+        // and otherwise could have the value of either operand.
         //
-        // If all of the operands have `Constant` lattice values,
-        // then we can potential execute the operation directly
-        // on those constant values, create a fresh `IRConstant`,
-        // and return a `Constant` lattice value for it. This
-        // would allow us to achieve true constant folding here.
-        //
-        // Textbook discussions of SCCP often point out that it
-        // is also possible to perform certain algebraic simplifications
-        // here, such as evaluating a multiply by a `Constant` zero
-        // to zero.
-        //
-        // As a default, if any operand has the `Any` value
-        // then the result of the operation should be treated as
-        // `Any`. There are exceptions to this, however, with the
-        // multiply-by-zero example being an important example.
-        // If we had previously decided that (Any * None) -> Any
-        // but then we refine our estimates and have (Any * Constant(0)) -> Constant(0)
-        // then we have violated the monotonicity rules for how
-        // our values move through the lattice, and we may break
-        // the convergence guarantees of the analysis.
+        if( inst->op == kIROp_Select )
+        {
+            LatticeVal condVal = getLatticeVal(inst->getOperand(0));
+            if(condVal.flavor == LatticeVal::Flavor::None)
+                return condVal;
+            if( auto boolConst = as<IRBoolLit>(condVal.value) )
+            {
+                return getLatticeVal(inst->getOperand(boolConst->getValue() ? 1 : 2));
+            }
+            return meet(getLatticeVal(inst->getOperand(1)), getLatticeVal(inst->getOperand(2)));
+        }
+
+        // Otherwise we look up the lattice values for the operands
+        // of the instruction.
+        //
+        // If any operand has the `Any` value then the result of the
+        // operation is treated as `Any`. Textbook discussions of SCCP
+        // often point out that there are exceptions to this (e.g.,
+        // a multiply by a `Constant` zero is zero), but we don't try
+        // to handle them.
         //
         // When we have a mix of `None` and `Constant` operands,
         // then the `None` values imply that our operation is using
-        // uninitialized data or the results of undefined behavior.
-        // We could try to propagate the `None` through, and allow
-        // the compiler to speculatively assume that the operation
-        // produces whatever value we find convenient. Alternatively,
-        // we can be less aggressive and treat an operation with
-        // `None` inputs as producing `Any` to make sure we don't
-        // optimize the code based on non-obvious assumptions.
+        // values we haven't seen produced yet, so the result is also `None`.
+        // Treating it as `Any` instead would break the convergence
+        // guarantees of the analysis, because we would move from `Any`
+        // to `Constant` once the operand is seen.
         //
-        // For now we aren't implementing *any* folding logic here,
-        // for simplicity. This is the right place to add folding
-        // optimizations if/when we need them.
+        // If all of the operands have `Constant` lattice values,
+        // then we can potentially execute the operation directly
+        // on those constant values, giving a constant for the result.
         //
+        const UInt operandCount = inst->getOperandCount();
+        if(operandCount == 0 || operandCount > kMaxFoldOperandCount)
+            return LatticeVal::getAny();
+
+        IRInst* operandValues[kMaxFoldOperandCount];
+        bool hasNoneOperand = false;
+        for( UInt ii = 0; ii < operandCount; ++ii )
+        {
+            LatticeVal operandVal = getLatticeVal(inst->getOperand(ii));
+            if(operandVal.flavor == LatticeVal::Flavor::Any)
+                return LatticeVal::getAny();
+            hasNoneOperand = hasNoneOperand || (operandVal.flavor == LatticeVal::Flavor::None);
+            operandValues[ii] = operandVal.value;
+        }
+        if(hasNoneOperand)
+            return LatticeVal::getNone();
+
+        if( auto foldedValue = tryConstantFoldInst(getBuilder(), inst, operandValues) )
+        {
+            return LatticeVal::getConstant(foldedValue);
+        }
 
         // A safe default is to assume that every instruction not
         // handled by one of the cases above could produce *any*
@@ -725,8 +998,11 @@ struct SCCPContext
                 // instructions to be removed *iff* the instruction
                 // is known to have no obersvable side effects.
                 //
+                // A division is treated as having side effects because it
+                // might trap, but one that was folded to a constant can't.
+                //
                 inst->replaceUsesWith(constantVal);
-                if( !inst->mightHaveSideEffects() )
+                if( !inst->mightHaveSideEffects() || inst->op == kIROp_Div || inst->op == kIROp_IRem )
                 {
                     instsToRemove.add(inst);
                 }
@@ -943,6 +1219,10 @@ void applySparseConditionalConstantPropagation(
     shared.sharedBuilder.module = module;
     shared.sharedBuilder.session = module->getSession();
 
+    // Folded constants should be the existing instructions for the values (if any),
+    // so that they are recognized as the same constant.
+    shared.sharedBuilder.deduplicateAndRebuildGlobalNumberingMap();
+
     applySparseConditionalConstantPropagationRec(&shared, module->getModuleInst());
 }
 
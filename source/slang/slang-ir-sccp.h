@@ -3,6 +3,8 @@
 
 namespace Slang
 {
+    struct IRBuilder;
+    struct IRInst;
     struct IRModule;
 
         /// Apply Sparse Conditional Constant Propagation (SCCP) to a module.
@@ -14,5 +16,16 @@ namespace Slang
         /// becoming dead code)
     void applySparseConditionalConstantPropagation(
         IRModule*       module);
+
+        /// Try to compute the constant result of `inst` if its operands had the constant `operandValues`.
+        ///
+        /// Operations on integer and `Bool` scalars (arithmetic, comparisons, logical and bitwise
+        /// operations, and conversions) can be folded. The result is created with `builder`.
+        ///
+        /// Returns nullptr if the operation can't be folded (for example division by zero).
+    IRInst* tryConstantFoldInst(
+        IRBuilder*              builder,
+        IRInst*                 inst,
+        IRInst* const*          operandValues);
 }
 
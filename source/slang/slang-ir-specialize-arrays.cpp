@@ -39,6 +39,10 @@ struct ArrayParameterSpecializationCondition : FunctionCallSpecializeCondition
     {
         return isStructTypeWithArray(param->getDataType());
     }
+
+    // Indices that are constant (for example, after a loop has been
+    // unrolled) can then be folded in the specialized function.
+    bool shouldSpecializeConstantIndices() SLANG_OVERRIDE { return true; }
 };
 
 void specializeArrayParameters(
@@ -142,6 +142,10 @@ IRFunc* specializeDispatchFunction(SharedGenericsLoweringContext* sharedContext,
 // can be looked up by the user via future Slang API calls.
 void ensureWitnessTableSequentialIDs(SharedGenericsLoweringContext* sharedContext)
 {
+    // When code for entry points is generated in parallel, new IDs have to be allocated in
+    // the same order as if the entry points were generated one after another.
+    sharedContext->witnessTableIDTurn.wait();
+
     auto linkage = sharedContext->targetReq->getLinkage();
     for (auto inst : sharedContext->module->getGlobalInsts())
     {
@@ -164,31 +168,15 @@ void ensureWitnessTableSequentialIDs(SharedGenericsLoweringContext* sharedContex
                 continue;
 
             // Get a sequential ID for the witness table using the map from the Linkage.
-            uint32_t seqID = 0;
-            if (!linkage->mapMangledNameToRTTIObjectIndex.TryGetValue(
-                witnessTableMangledName, seqID))
-            {
-                auto interfaceType =
-                    cast<IRWitnessTableType>(inst->getDataType())->getConformanceType();
-                auto interfaceLinkage = interfaceType->findDecoration<IRLinkageDecoration>();
-                SLANG_ASSERT(
-                    interfaceLinkage && "An interface type does not have a linkage,"
-                                        "but a witness table associated with it has one.");
-                auto interfaceName = interfaceLinkage->getMangledName();
-                auto idAllocator =
-                    linkage->mapInterfaceMangledNameToSequentialIDCounters.TryGetValue(
-                        interfaceName);
-                if (!idAllocator)
-                {
-                    linkage->mapInterfaceMangledNameToSequentialIDCounters[interfaceName] = 0;
-                    idAllocator =
-                        linkage->mapInterfaceMangledNameToSequentialIDCounters.TryGetValue(
-                            interfaceName);
-                }
-                seqID = *idAllocator;
-                ++(*idAllocator);
-                linkage->mapMangledNameToRTTIObjectIndex[witnessTableMangledName] = seqID;
-            }
+            auto interfaceType =
+                cast<IRWitnessTableType>(inst->getDataType())->getConformanceType();
+            auto interfaceLinkage = interfaceType->findDecoration<IRLinkageDecoration>();
+            SLANG_ASSERT(
+                interfaceLinkage && "An interface type does not have a linkage,"
+                                    "but a witness table associated with it has one.");
+            uint32_t seqID = linkage->getOrAllocateWitnessTableSequentialID(
+                witnessTableMangledName,
+                interfaceLinkage->getMangledName());
 
             // Add a decoration to the inst.
             IRBuilder builder;
@@ -197,6 +185,8 @@ void ensureWitnessTableSequentialIDs(SharedGenericsLoweringContext* sharedContex
             builder.addSequentialIDDecoration(inst, seqID);
         }
     }
+
+    sharedContext->witnessTableIDTurn.end();
 }
 
 // Fixes up call sites of a dispatch function, so that the witness table argument is replaced with
@@ -474,6 +474,14 @@ struct FunctionParameterSpecializationContext
         }
     }
 
+    // An index that is a constant is made part of the
+    // specialization key if the condition asks for it.
+    //
+    bool isSpecializedConstantIndex(IRInst* index)
+    {
+        return as<IRIntLit>(index) && condition->shouldSpecializeConstantIndices();
+    }
+
     void getCallInfoForArg(
         CallSpecializationInfo& ioInfo,
         IRInst*                 oldArg)
@@ -511,7 +519,17 @@ struct FunctionParameterSpecializationContext
             //
             getCallInfoForArg(ioInfo, oldBase);
 
-            // Then we process `oldIndex` just like we
+            // If the index is a constant the condition wants
+            // to specialize on, it is part of the key instead,
+            // and the callee uses the constant directly.
+            //
+            if( isSpecializedConstantIndex(oldIndex) )
+            {
+                ioInfo.key.vals.add(oldIndex);
+                return;
+            }
+
+            // Otherwise we process `oldIndex` just like we
             // would have an ordinary argument that doesn't
             // involve specialization: add its value to
             // the arguments at the new call site, and
@@ -638,11 +656,17 @@ struct FunctionParameterSpecializationContext
             // was an ordinary argument (not a specialized one),
             // which means creating a parameter to receive its value,
             // which will also stand in for `oldIndex` in
-            // the body of the specialized callee.
+            // the body of the specialized callee. A constant
+            // index that is part of the key stands in for itself.
             //
             auto builder = getBuilder();
-            auto newIndex = builder->createParam(oldIndex->getFullType());
-            ioInfo.newParams.add(newIndex);
+            IRInst* newIndex = oldIndex;
+            if( !isSpecializedConstantIndex(oldIndex) )
+            {
+                auto newIndexParam = builder->createParam(oldIndex->getFullType());
+                ioInfo.newParams.add(newIndexParam);
+                newIndex = newIndexParam;
+            }
 
             // Finally, we need to compute a value that
             // can stand in for `oldArg` (which was
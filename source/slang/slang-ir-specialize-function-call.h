@@ -12,6 +12,10 @@ namespace Slang
     {
     public:
         virtual bool doesParamNeedSpecialization(IRParam* param) = 0;
+
+            /// Should an argument indexed with a constant (such as `a[3]`) be specialized to
+            /// the element, so the callee can use the constant, rather than passing the index?
+        virtual bool shouldSpecializeConstantIndices() { return false; }
     };
 
 
@@ -1304,10 +1304,11 @@ namespace Slang
         size_t size = sizeof(IRInst) + (totalArgCount) * sizeof(IRUse);
 
         SLANG_ASSERT(module);
-        IRInst* inst = (IRInst*)module->memoryArena.allocateAndZero(size);
+        IRInst* inst = (IRInst*)module->allocateInstMemory(size);
 
         inst->operandCount = uint32_t(totalArgCount);
         inst->op = op;
+        inst->allocatedSize = uint32_t(size);
 
         return inst;
     }
@@ -1320,10 +1321,11 @@ namespace Slang
         SLANG_ASSERT(totalSizeInBytes >= sizeof(IRInst));
 
         SLANG_ASSERT(module);
-        IRInst* inst = (IRInst*)module->memoryArena.allocateAndZero(totalSizeInBytes);
+        IRInst* inst = (IRInst*)module->allocateInstMemory(totalSizeInBytes);
 
         inst->operandCount = 0;
         inst->op = op;
+        inst->allocatedSize = uint32_t(totalSizeInBytes);
 
         return inst;
     }
@@ -1600,11 +1602,12 @@ namespace Slang
         }
 
         SLANG_ASSERT(module);
-        T* inst = (T*)module->memoryArena.allocateAndZero(size);
+        T* inst = (T*)module->allocateInstMemory(size);
 
         // TODO: Do we need to run ctor after zeroing?
         new(inst)T();
 
+        inst->allocatedSize = uint32_t(size);
         inst->operandCount = (uint32_t)(fixedArgCount + varArgCount);
 
         inst->op = op;
@@ -1654,13 +1657,12 @@ namespace Slang
         size_t          sizeInBytes)
     {
         auto module = builder->getModule();
-        IRInst* inst = (IRInst*)module->memoryArena.allocate(sizeInBytes);
-        // Zero only the 'type'
-        memset(inst, 0, sizeof(IRInst));
+        IRInst* inst = (IRInst*)module->allocateInstMemory(sizeInBytes);
         // TODO: Do we need to run ctor after zeroing?
         new (inst) IRInst;
 
         inst->op = op;
+        inst->allocatedSize = uint32_t(sizeInBytes);
         if (type)
         {
             inst->typeUse.init(inst, type);
@@ -2067,6 +2069,7 @@ namespace Slang
 
         key.inst = irValue;
         builder->sharedBuilder->constantMap.Add(key, irValue);
+        irValue->isDeduplicated = 1;
 
         addHoistableInst(builder, irValue);
 
@@ -2151,21 +2154,17 @@ namespace Slang
             operandCount += listOperandCounts[ii];
         }
 
-        auto& memoryArena = getModule()->memoryArena;
-        void* cursor = memoryArena.getCursor();
+        auto module = getModule();
 
-        // We are going to create a 'dummy' instruction on the memoryArena
+        // We are going to create a 'dummy' instruction in the module
         // which can be used as a key for lookup, so see if we
         // already have an equivalent instruction available to use.
         size_t keySize = sizeof(IRInst) + operandCount * sizeof(IRUse);
-        IRInst* inst = (IRInst*) memoryArena.allocateAndZero(keySize);
-        
-        void* endCursor = memoryArena.getCursor();
-        // Mark as 'unused' cos it is unused on release builds. 
-        SLANG_UNUSED(endCursor);
+        IRInst* inst = (IRInst*)module->allocateInstMemory(keySize);
 
         new(inst) IRInst();
         inst->op = op;
+        inst->allocatedSize = uint32_t(keySize);
         inst->typeUse.usedValue = type;
         inst->operandCount = (uint32_t) operandCount;
 
@@ -2189,13 +2188,14 @@ namespace Slang
 
             // Ideally we would add if not found, else return if was found instead of testing & then adding.
             IRInst** found = sharedBuilder->globalValueNumberingMap.TryGetValueOrAdd(key, inst);
-            SLANG_ASSERT(endCursor == memoryArena.getCursor());
             // If it's found, just return, and throw away the instruction
+            // (it isn't linked to anything, so its memory can be reused straight away)
             if (found)
             {
-                memoryArena.rewindToCursor(cursor);
+                module->freeInstMemory(inst);
                 return *found;
             }
+            inst->isDeduplicated = 1;
         }
 
         // Make the lookup 'inst' instruction into 'proper' instruction. Equivalent to
@@ -2238,21 +2238,17 @@ namespace Slang
             operandCount += listOperandCounts[ii];
         }
 
-        auto& memoryArena = getModule()->memoryArena;
-        void* cursor = memoryArena.getCursor();
+        auto module = getModule();
 
-        // We are going to create a 'dummy' instruction on the memoryArena
+        // We are going to create a 'dummy' instruction in the module
         // which can be used as a key for lookup, so see if we
         // already have an equivalent instruction available to use.
         size_t keySize = sizeof(IRInst) + operandCount * sizeof(IRUse);
-        IRInst* inst = (IRInst*)memoryArena.allocateAndZero(keySize);
-
-        void* endCursor = memoryArena.getCursor();
-        // Mark as 'unused' cos it is unused on release builds. 
-        SLANG_UNUSED(endCursor);
+        IRInst* inst = (IRInst*)module->allocateInstMemory(keySize);
 
         new(inst) IRInst();
         inst->op = op;
+        inst->allocatedSize = uint32_t(keySize);
         inst->typeUse.usedValue = type;
         inst->operandCount = (uint32_t)operandCount;
 
@@ -2276,13 +2272,14 @@ namespace Slang
 
             // Ideally we would add if not found, else return if was found instead of testing & then adding.
             IRInst** found = sharedBuilder->globalValueNumberingMap.TryGetValueOrAdd(key, inst);
-            SLANG_ASSERT(endCursor == memoryArena.getCursor());
             // If it's found, just return, and throw away the instruction
+            // (it isn't linked to anything, so its memory can be reused straight away)
             if (found)
             {
-                memoryArena.rewindToCursor(cursor);
+                module->freeInstMemory(inst);
                 return *found;
             }
+            inst->isDeduplicated = 1;
         }
 
         // Make the lookup 'inst' instruction into 'proper' instruction. Equivalent to
@@ -3094,6 +3091,130 @@ namespace Slang
         return inst;
     }
 
+    void IRModuleSymbolIndex::addGlobalValues(IRModule* module)
+    {
+        for (auto globalValue : module->getGlobalInsts())
+        {
+            auto linkage = globalValue->findDecoration<IRLinkageDecoration>();
+            if (!linkage)
+                continue;
+
+            const Index entryIndex = m_entries.getCount();
+            m_entries.add(Entry{ globalValue, -1 });
+
+            Index* firstEntryIndex = m_firstEntryIndexMap.TryGetValueOrAdd(linkage->getMangledName(), entryIndex);
+            if (firstEntryIndex)
+            {
+                // Values with the same name in a module are rare (target specific declarations), so just
+                // follow the chain to append in module order
+                Index lastEntryIndex = *firstEntryIndex;
+                while (m_entries[lastEntryIndex].nextEntryIndex >= 0)
+                {
+                    lastEntryIndex = m_entries[lastEntryIndex].nextEntryIndex;
+                }
+                m_entries[lastEntryIndex].nextEntryIndex = entryIndex;
+            }
+        }
+    }
+
+    const IRModuleSymbolIndex* IRModule::getSymbolIndex()
+    {
+        std::lock_guard<std::mutex> lock(m_symbolIndexMutex);
+        if (!m_symbolIndex)
+        {
+            RefPtr<IRModuleSymbolIndex> symbolIndex = new IRModuleSymbolIndex;
+            symbolIndex->addGlobalValues(this);
+            m_symbolIndex = symbolIndex;
+        }
+        return m_symbolIndex;
+    }
+
+    static size_t _roundUpInstSize(size_t size)
+    {
+        return (size + IRModule::kInstSizeGranularity - 1) & ~size_t(IRModule::kInstSizeGranularity - 1);
+    }
+
+    void* IRModule::allocateInstMemory(size_t size)
+    {
+        const size_t roundedSize = _roundUpInstSize(size);
+        const size_t sizeClass = roundedSize / kInstSizeGranularity;
+
+        void* memory;
+        if (sizeClass < kInstSizeClassCount && m_freeInsts[sizeClass])
+        {
+            IRInst* freeInst = m_freeInsts[sizeClass];
+            m_freeInsts[sizeClass] = freeInst->next;
+
+            memory = freeInst;
+            ::memset(memory, 0, roundedSize);
+        }
+        else
+        {
+            memory = memoryArena.allocateAndZero(roundedSize);
+        }
+
+        m_liveInstBytes += roundedSize;
+        m_peakLiveInstBytes = Math::Max(m_peakLiveInstBytes, m_liveInstBytes);
+        return memory;
+    }
+
+    void IRModule::freeInstMemory(IRInst* inst)
+    {
+        // Instructions not allocated with allocateInstMemory have no size, as do ones already freed
+        const size_t size = inst->allocatedSize;
+        if (size == 0)
+        {
+            return;
+        }
+        SLANG_ASSERT(memoryArena.isValid(inst, size) && !inst->firstUse);
+        inst->allocatedSize = 0;
+
+        const size_t roundedSize = _roundUpInstSize(size);
+        SLANG_ASSERT(m_liveInstBytes >= roundedSize);
+        m_liveInstBytes -= roundedSize;
+
+        const size_t sizeClass = roundedSize / kInstSizeGranularity;
+        if (sizeClass < kInstSizeClassCount)
+        {
+            inst->next = m_freeInsts[sizeClass];
+            m_freeInsts[sizeClass] = inst;
+        }
+    }
+
+    void IRModule::deallocateInstMemory(IRInst* inst, size_t allocatedSize, bool reusable)
+    {
+        // Instructions not allocated with allocateInstMemory have no size
+        if (allocatedSize == 0)
+        {
+            return;
+        }
+        SLANG_ASSERT(memoryArena.isValid(inst, allocatedSize));
+
+        const size_t roundedSize = _roundUpInstSize(allocatedSize);
+        SLANG_ASSERT(m_liveInstBytes >= roundedSize);
+        m_liveInstBytes -= roundedSize;
+
+        const size_t sizeClass = roundedSize / kInstSizeGranularity;
+        if (reusable && sizeClass < kInstSizeClassCount)
+        {
+            DeallocatedInst deallocatedInst;
+            deallocatedInst.inst = inst;
+            deallocatedInst.sizeClass = sizeClass;
+            m_deallocatedInsts.add(deallocatedInst);
+        }
+    }
+
+    void IRModule::reclaimDeallocatedInstMemory()
+    {
+        for (const auto& deallocatedInst : m_deallocatedInsts)
+        {
+            IRInst* inst = deallocatedInst.inst;
+            inst->next = m_freeInsts[deallocatedInst.sizeClass];
+            m_freeInsts[deallocatedInst.sizeClass] = inst;
+        }
+        m_deallocatedInsts.clear();
+    }
+
     IRModule* IRBuilder::createModule()
     {
         auto module = new IRModule();
@@ -5433,22 +5554,44 @@ namespace Slang
     // Remove this instruction from its parent block,
     // and then destroy it (it had better have no uses!)
     void IRInst::removeAndDeallocate()
+    {
+        // The module has to be found before the instruction is removed from it
+        _removeAndDeallocate(getModule());
+    }
+
+    void IRInst::_removeAndDeallocate(IRModule* module)
     {
         removeFromParent();
         removeArguments();
-        removeAndDeallocateAllDecorationsAndChildren();
+        _removeAndDeallocateAllDecorationsAndChildren(module);
+
+        // What is needed to deallocate the memory has to be read before the instruction is destructed.
+        // If the instruction is still used, the use will be removed from it later, which would
+        // overwrite whatever the memory had been reused for.
+        const size_t size = allocatedSize;
+        const bool reusable = !firstUse && !isDeduplicated;
 
         // Run destructor to be sure...
         this->~IRInst();
+
+        if (module)
+        {
+            module->deallocateInstMemory(this, size, reusable);
+        }
     }
 
     void IRInst::removeAndDeallocateAllDecorationsAndChildren()
+    {
+        _removeAndDeallocateAllDecorationsAndChildren(getModule());
+    }
+
+    void IRInst::_removeAndDeallocateAllDecorationsAndChildren(IRModule* module)
     {
         IRInst* nextChild = nullptr;
         for( IRInst* child = getFirstDecorationOrChild(); child; child = nextChild )
         {
             nextChild = child->getNextInst();
-            child->removeAndDeallocate();
+            child->_removeAndDeallocate(module);
         }
     }
 
@@ -5787,5 +5930,72 @@ namespace Slang
         }
         return nullptr;
     }
+
+    bool isPureValueInst(IRInst* inst)
+    {
+        switch (inst->op)
+        {
+            case kIROp_Construct:
+            case kIROp_makeUInt64:
+            case kIROp_makeVector:
+            case kIROp_MakeMatrix:
+            case kIROp_makeArray:
+            case kIROp_makeStruct:
+            case kIROp_FieldExtract:
+            case kIROp_FieldAddress:
+            case kIROp_getElement:
+            case kIROp_getElementPtr:
+            case kIROp_constructVectorFromScalar:
+            case kIROp_swizzle:
+            case kIROp_swizzleSet:
+            case kIROp_Add:
+            case kIROp_Sub:
+            case kIROp_Mul:
+            case kIROp_Div:
+            case kIROp_IRem:
+            case kIROp_FRem:
+            case kIROp_Lsh:
+            case kIROp_Rsh:
+            case kIROp_Eql:
+            case kIROp_Neq:
+            case kIROp_Greater:
+            case kIROp_Less:
+            case kIROp_Geq:
+            case kIROp_Leq:
+            case kIROp_BitAnd:
+            case kIROp_BitXor:
+            case kIROp_BitOr:
+            case kIROp_And:
+            case kIROp_Or:
+            case kIROp_Neg:
+            case kIROp_Not:
+            case kIROp_BitNot:
+            case kIROp_Select:
+            case kIROp_Dot:
+            case kIROp_BitCast:
+            {
+                return true;
+            }
+            case kIROp_Call:
+            {
+                // Only calls to functions marked as [__readNone]
+                return !inst->mightHaveSideEffects();
+            }
+        }
+        return false;
+    }
+
+    bool canHoldInTemporary(IRType* type)
+    {
+        switch (type->op)
+        {
+            case kIROp_VectorType:
+            case kIROp_MatrixType:
+            {
+                return true;
+            }
+        }
+        return as<IRBasicType>(type) && type->op != kIROp_VoidType;
+    }
 } // namespace Slang
 
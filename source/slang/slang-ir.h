@@ -15,6 +15,8 @@
 
 #include "slang-type-system-shared.h"
 
+#include <mutex>
+
 namespace Slang {
 
 class   Decl;
@@ -331,6 +333,17 @@ struct IRInst
     // Source location information for this value, if any
     SourceLoc sourceLoc;
 
+    // The size of the memory allocated for this instruction in its module,
+    // so that the memory can be reused once the instruction is deallocated.
+    // Zero if the memory shouldn't be reused.
+    uint32_t allocatedSize : 31;
+
+    // Set once the instruction has been added to the deduplication maps of a
+    // SharedIRBuilder (`globalValueNumberingMap` or `constantMap`). The maps aren't
+    // purged when an instruction is deallocated, so the memory of such an instruction
+    // is never reused.
+    uint32_t isDeduplicated : 1;
+
     // Each instruction can have zero or more "decorations"
     // attached to it. A decoration is a specialized kind
     // of instruction that either attaches metadata to,
@@ -526,6 +539,12 @@ struct IRInst
         /// If both `inPrev` and `inNext` are null, then `inParent` must have no (raw) children.
         ///
     void _insertAt(IRInst* inPrev, IRInst* inNext, IRInst* inParent);
+
+        /// Implementation of `removeAndDeallocate`, where `module` (if not null) is given the memory of
+        /// this instruction and its children to reuse.
+    void _removeAndDeallocate(IRModule* module);
+        /// Implementation of `removeAndDeallocateAllDecorationsAndChildren`, giving the memory to `module`.
+    void _removeAndDeallocateAllDecorationsAndChildren(IRModule* module);
 };
 
 template<typename T>
@@ -1438,6 +1457,58 @@ struct IRModuleInst : IRInst
     IR_LEAF_ISA(Module)
 };
 
+    /// Produces parts of an IRModule that were not created when the module was loaded.
+    ///
+    /// A module read from a serialized form can defer creating the bodies of its global
+    /// values (functions and generics) until they are first needed. The global value
+    /// itself, along with its decorations, is always present.
+    ///
+    /// Implementations must allow loading from multiple threads, as a module may be shared between compiles.
+class IRModuleBodyLoader : public RefObject
+{
+public:
+        /// Make sure the body of the global value `inst` is present
+    virtual void loadBody(IRInst* inst) = 0;
+        /// Load every body that has not yet been loaded
+    virtual void loadAllBodies() = 0;
+};
+
+    /// An index of the global values of an IRModule that have linkage, by their mangled name.
+    ///
+    /// The linker looks up the definitions it needs in the index of each module it links against, rather than
+    /// visiting every global value of every module each time it links.
+    ///
+    /// The names are slices of the string literals in the module, so the index can only be used while the module
+    /// is alive. It holds the global values present when it was built, so is only valid as long as no global values
+    /// with linkage are added to or removed from the module.
+class IRModuleSymbolIndex : public RefObject
+{
+public:
+    struct Entry
+    {
+        IRInst* globalValue;                ///< A global value with the mangled name
+        Index nextEntryIndex;               ///< The next entry with the same mangled name (in module order), or -1 if there isn't one
+    };
+
+        /// Get the index of the first entry with the mangledName, or -1 if there isn't one
+    Index findFirstEntryIndex(const UnownedStringSlice& mangledName) const
+    {
+        const Index* entryIndex = m_firstEntryIndexMap.TryGetValue(mangledName);
+        return entryIndex ? *entryIndex : -1;
+    }
+        /// Get the entry at the index
+    const Entry& getEntry(Index index) const { return m_entries[index]; }
+        /// Get the total amount of entries
+    Index getEntryCount() const { return m_entries.getCount(); }
+
+        /// Add all the global values of the module that have linkage
+    void addGlobalValues(IRModule* module);
+
+protected:
+    Dictionary<UnownedStringSlice, Index> m_firstEntryIndexMap;     ///< Map from a mangled name to the index of the first entry with that name
+    List<Entry> m_entries;
+};
+
 struct IRModule : RefObject
 {
     enum 
@@ -1450,10 +1521,42 @@ struct IRModule : RefObject
 
     IRInstListBase getGlobalInsts() const { return getModuleInst()->getChildren(); }
 
+        /// Make sure the body of the global value `inst` held in this module is present.
+        /// Must be used before looking inside a global value of a module that may have been lazily loaded.
+    void ensureBodyLoaded(IRInst* inst) { if (bodyLoader) bodyLoader->loadBody(inst); }
+        /// Make sure all of the module is present
+    void ensureAllBodiesLoaded() { if (bodyLoader) bodyLoader->loadAllBodies(); }
+
+        /// Get the index of the global values of the module that have linkage.
+        /// The index is built on first use, and is safe to get from multiple threads.
+    const IRModuleSymbolIndex* getSymbolIndex();
+
+        /// Allocate zeroed memory for an instruction of `size` bytes. The memory of a deallocated instruction
+        /// of the same size class is reused if there is one, otherwise the memory comes from the arena.
+        /// The size must be recorded in the instruction (as `IRInst::allocatedSize`) once it is constructed.
+    void* allocateInstMemory(size_t size);
+        /// Take the memory of an instruction that was never added to the module (such as a lookup key)
+        /// for reuse straight away.
+    void freeInstMemory(IRInst* inst);
+        /// Deallocate the memory of an instruction that has been removed and destructed. `allocatedSize`
+        /// and `reusable` must be read from the instruction before it is destructed.
+        /// The memory isn't reused until `reclaimDeallocatedInstMemory` is called, as a pass may still
+        /// hold pointers to instructions it has removed (in a work list or set, say) until it completes.
+    void deallocateInstMemory(IRInst* inst, size_t allocatedSize, bool reusable);
+        /// Make the memory of the instructions deallocated since the last call available for reuse.
+        /// Must only be called when nothing refers to a deallocated instruction, such as between passes.
+    void reclaimDeallocatedInstMemory();
+
+        /// Get the bytes of the instructions allocated in the module that haven't been deallocated
+    size_t getLiveInstBytes() const { return m_liveInstBytes; }
+        /// Get the highest value getLiveInstBytes has had
+    size_t getPeakLiveInstBytes() const { return m_peakLiveInstBytes; }
+
         /// Ctor
     IRModule():
         memoryArena(kMemoryArenaBlockSize)
     {
+        ::memset(m_freeInsts, 0, sizeof(m_freeInsts));
     }
 
     MemoryArena memoryArena;
@@ -1461,6 +1564,36 @@ struct IRModule : RefObject
     // The compilation session in use.
     Session*    session;
     IRModuleInst* moduleInst;
+
+    // Set if some global value bodies are yet to be loaded
+    RefPtr<IRModuleBodyLoader> bodyLoader;
+
+    // Built on first use by getSymbolIndex
+    RefPtr<IRModuleSymbolIndex> m_symbolIndex;
+    std::mutex m_symbolIndexMutex;
+
+    enum
+    {
+        kInstSizeGranularity = MemoryArena::kMinAlignment,      ///< Instruction sizes are rounded up to a multiple of this
+        kMaxReusedInstSize = 1024,                              ///< The memory of larger instructions isn't reused
+        kInstSizeClassCount = kMaxReusedInstSize / kInstSizeGranularity + 1,
+    };
+
+    // The memory of deallocated instructions, linked through IRInst::next, for each size class
+    // (the size divided by kInstSizeGranularity)
+    IRInst* m_freeInsts[kInstSizeClassCount];
+
+    struct DeallocatedInst
+    {
+        IRInst* inst;
+        size_t sizeClass;
+    };
+    // Deallocated instructions to add to m_freeInsts on the next reclaimDeallocatedInstMemory.
+    // Kept out of the instructions' memory so it is untouched until then.
+    List<DeallocatedInst> m_deallocatedInsts;
+
+    size_t m_liveInstBytes = 0;
+    size_t m_peakLiveInstBytes = 0;
 };
 
     /// How much detail to include in dumped IR.
@@ -1520,6 +1653,14 @@ bool isBuiltin(IRInst* inst);
     // Get the enclosuing function of an instruction.
 IRFunc* getParentFunc(IRInst* inst);
 
+    /// True if `inst` computes its value only from its operands - it has no side effects and doesn't read memory.
+    /// Two such instructions with the same op, type and operands produce the same value.
+bool isPureValueInst(IRInst* inst);
+
+    /// True if a value of the type can be held in a temporary (a local variable) on every target.
+    /// Values of other types (such as pointers and resources) may have to be folded into their uses when emitted.
+bool canHoldInTemporary(IRType* type);
+
 }
 
 #endif
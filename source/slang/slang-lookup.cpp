@@ -198,15 +198,23 @@ static void _lookUpDirectAndTransparentMembers(
 {
     ContainerDecl* containerDecl = containerDeclRef.getDecl();
 
-    // Ensure that the lookup dictionary in the container is up to date
-    if (!containerDecl->isMemberDictionaryValid())
+    // Look up the declarations with the chosen name in the container.
+    Decl* firstDecl = nullptr;
+    if (ASTDeclLoader* loader = containerDecl->memberLoader.load())
     {
-        buildMemberDictionary(containerDecl);
+        // The members are created on demand, so only create the ones with the name
+        firstDecl = loader->loadMembersWithName(containerDecl, name);
     }
+    else
+    {
+        // Ensure that the lookup dictionary in the container is up to date
+        if (!containerDecl->isMemberDictionaryValid())
+        {
+            buildMemberDictionary(containerDecl);
+        }
 
-    // Look up the declarations with the chosen name in the container.
-    Decl* firstDecl = nullptr;
-    containerDecl->memberDictionary.TryGetValue(name, firstDecl);
+        containerDecl->memberDictionary.TryGetValue(name, firstDecl);
+    }
 
     // Now iterate over those declarations (if any) and see if
     // we find any that meet our filtering criteria.
@@ -13,6 +13,8 @@ LookupResult refineLookup(LookupResult const& inResult, LookupMask mask);
 
 // Ensure that the dictionary for name-based member lookup has been
 // built for the given container declaration.
+// If the members of decl are created on demand (decl->memberLoader is set),
+// the loader builds the dictionary, and this must not be used.
 void buildMemberDictionary(ContainerDecl* decl);
 
 // Look up a name in the given scope, proceeding up through
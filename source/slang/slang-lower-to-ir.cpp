@@ -3956,9 +3956,9 @@ struct StmtLoweringVisitor : StmtVisitor<StmtLoweringVisitor>
         IRInst* inst,
         Stmt*   stmt)
     {
-        if( stmt->findModifier<UnrollAttribute>() )
+        if( auto unrollAttr = stmt->findModifier<UnrollAttribute>() )
         {
-            getBuilder()->addLoopControlDecoration(inst, kIRLoopControl_Unroll);
+            getBuilder()->addLoopControlDecoration(inst, kIRLoopControl_Unroll, unrollAttr->count);
         }
         else if( stmt->findModifier<LoopAttribute>() )
         {
@@ -5069,7 +5069,7 @@ struct DeclLoweringVisitor : DeclVisitor<DeclLoweringVisitor, LoweredValInfo>
 
     LoweredValInfo visitExtensionDecl(ExtensionDecl* decl)
     {
-        for (auto & member : decl->members)
+        for (auto & member : decl->getMembers())
             ensureDecl(context, member);
         return LoweredValInfo();
     }
@@ -6016,7 +6016,7 @@ struct DeclLoweringVisitor : DeclVisitor<DeclLoweringVisitor, LoweredValInfo>
         // First, compute the number of requirement entries that will be included in this
         // interface type.
         UInt operandCount = 0;
-        for (auto requirementDecl : decl->members)
+        for (auto requirementDecl : decl->getMembers())
         {
             operandCount++;
             // As a special case, any type constraints placed
@@ -6060,7 +6060,7 @@ struct DeclLoweringVisitor : DeclVisitor<DeclLoweringVisitor, LoweredValInfo>
 
         UInt entryIndex = 0;
 
-        for (auto requirementDecl : decl->members)
+        for (auto requirementDecl : decl->getMembers())
         {
             auto entry = subBuilder->createInterfaceRequirementEntry(
                 getInterfaceRequirementKey(requirementDecl),
@@ -7626,7 +7626,7 @@ static void ensureAllDeclsRec(
     //
     if(auto containerDecl = as<AggTypeDeclBase>(decl))
     {
-        for (auto memberDecl : containerDecl->members)
+        for (auto memberDecl : containerDecl->getMembers())
         {
             ensureAllDeclsRec(context, memberDecl);
         }
@@ -7683,7 +7683,7 @@ IRModule* generateIRForTranslationUnit(
     //
     // Next, ensure that all other global declarations have
     // been emitted.
-    for (auto decl : translationUnit->getModuleDecl()->members)
+    for (auto decl : translationUnit->getModuleDecl()->getMembers())
     {
         ensureAllDeclsRec(context, decl);
     }
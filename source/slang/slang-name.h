@@ -7,6 +7,8 @@
 
 #include "../core/slang-basic.h"
 
+#include <mutex>
+
 namespace Slang {
 
 // The `Name` type is used to represent the name of a type, variable, etc.
@@ -47,10 +49,16 @@ const char* getCstr(Name* name);
 // get equivalent names for a string like `"Foo"`, then they need to use
 // the same root name pool (directly or indirectly).
 //
+// A root name pool can be shared by `NamePool`s that are used from
+// different threads, so access to `names` must hold `mutex`.
+//
 struct RootNamePool
 {
     // The mapping from text strings to the corresponding name.
     Dictionary<String, RefPtr<Name> > names;
+
+    // Guards `names`
+    std::mutex mutex;
 };
 
 // A `NamePool` is effectively a way of storing a subset of the
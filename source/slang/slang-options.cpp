@@ -434,6 +434,23 @@ struct OptionsParser
 
         bool hasLoadedRepro = false;
 
+        String compileCacheDirectory;
+        uint64_t compileCacheMaxSize = 0;
+
+        // The arguments are part of the compile cache key, apart from the ones that control the cache itself,
+        // and output paths (which only determine where the output is written, and the targets, which are
+        // part of the key anyway)
+        for (int i = 0; i < argc; ++i)
+        {
+            const UnownedStringSlice argStr(argv[i]);
+            if (argStr == "-cache-dir" || argStr == "-cache-max-size" || argStr == "-o")
+            {
+                ++i;
+                continue;
+            }
+            requestImpl->m_commandLineArgs.add(argStr);
+        }
+
         char const* const* argCursor = &argv[0];
         char const* const* argEnd = &argv[argc];
         while (argCursor != argEnd)
@@ -465,6 +482,10 @@ struct OptionsParser
                 {
                     requestImpl->getFrontEndReq()->outputIncludes = true;
                 }
+                else if (argStr == "-report-perf")
+                {
+                    requestImpl->setReportPerf(true);
+                }
                 else if(argStr == "-dump-ir" )
                 {
                     requestImpl->getFrontEndReq()->shouldDumpIR = true;
@@ -876,6 +897,46 @@ struct OptionsParser
                 {
                     spSetDebugInfoLevel(compileRequest, SLANG_DEBUG_INFO_LEVEL_MAXIMAL);
                 }
+                else if( argStr == "-j" )
+                {
+                    String countText;
+                    SLANG_RETURN_ON_FAIL(tryReadCommandLineArgument(sink, arg, &argCursor, argEnd, countText));
+
+                    bool isValidCount = countText.getLength() > 0 && countText.getLength() < 6;
+                    for (auto c : countText)
+                    {
+                        isValidCount = isValidCount && c >= '0' && c <= '9';
+                    }
+                    if (!isValidCount)
+                    {
+                        sink->diagnose(SourceLoc(), Diagnostics::invalidParallelJobCount, countText);
+                        return SLANG_FAIL;
+                    }
+
+                    spSetParallelJobCount(compileRequest, StringToInt(countText));
+                }
+                else if (argStr == "-cache-dir")
+                {
+                    SLANG_RETURN_ON_FAIL(tryReadCommandLineArgument(sink, arg, &argCursor, argEnd, compileCacheDirectory));
+                }
+                else if (argStr == "-cache-max-size")
+                {
+                    String sizeText;
+                    SLANG_RETURN_ON_FAIL(tryReadCommandLineArgument(sink, arg, &argCursor, argEnd, sizeText));
+
+                    bool isValidSize = sizeText.getLength() > 0 && sizeText.getLength() < 10;
+                    for (auto c : sizeText)
+                    {
+                        isValidSize = isValidSize && c >= '0' && c <= '9';
+                    }
+                    if (!isValidSize)
+                    {
+                        sink->diagnose(SourceLoc(), Diagnostics::invalidCompileCacheMaxSize, sizeText);
+                        return SLANG_FAIL;
+                    }
+
+                    compileCacheMaxSize = uint64_t(StringToInt(sizeText)) * 1024 * 1024;
+                }
                 else if( argStr == "-default-image-format-unknown" )
                 {
                     requestImpl->getBackEndReq()->useUnknownImageFormatAsDefault = true;
@@ -903,6 +964,11 @@ struct OptionsParser
                         // OSFileSystemExt implements the ISlangFileSystemExt interface - and will be used directly
                         spSetFileSystem(compileRequest, OSFileSystemExt::getSingleton());
                     }
+                    else if (name == "os-mapped")
+                    {
+                        // As "os", but large files are memory mapped rather than read
+                        spSetFileSystem(compileRequest, OSFileSystemExt::getMappedSingleton());
+                    }
                     else
                     {
                         sink->diagnose(SourceLoc(), Diagnostics::unknownFileSystemOption, name);
@@ -921,6 +987,25 @@ struct OptionsParser
 
                     _addLibraryReference(requestImpl, &fileStream);
                 }
+                else if (argStr == "-save-stdlib")
+                {
+                    String fileName;
+                    SLANG_RETURN_ON_FAIL(tryReadCommandLineArgument(sink, arg, &argCursor, argEnd, fileName));
+
+                    ComPtr<ISlangBlob> blob;
+                    SLANG_RETURN_ON_FAIL(session->saveStdLib(blob.writeRef()));
+
+                    try
+                    {
+                        FileStream stream(fileName, FileMode::Create, FileAccess::Write, FileShare::ReadWrite);
+                        stream.write(blob->getBufferPointer(), blob->getBufferSize());
+                    }
+                    catch (const IOException&)
+                    {
+                        sink->diagnose(SourceLoc(), Diagnostics::cannotWriteOutputFile, fileName);
+                        return SLANG_FAIL;
+                    }
+                }
                 else if (argStr == "-v")
                 {
                     sink->diagnoseRaw(Severity::Note, session->getBuildTagString());
@@ -929,6 +1014,41 @@ struct OptionsParser
                 {
                     requestImpl->getBackEndReq()->shouldEmitSPIRVDirectly = true;
                 }
+                else if( argStr == "-validate-spirv-directly" )
+                {
+                    requestImpl->getBackEndReq()->shouldEmitSPIRVDirectly = true;
+                    requestImpl->getBackEndReq()->shouldValidateSPIRVEmittedDirectly = true;
+                }
+                else if( argStr == "-cpu-simd" )
+                {
+                    String name;
+                    SLANG_RETURN_ON_FAIL(tryReadCommandLineArgument(sink, arg, &argCursor, argEnd, name));
+
+                    CPUSIMDMode mode = CPUSIMDMode::None;
+                    if (name == "none")
+                    {
+                        mode = CPUSIMDMode::None;
+                    }
+                    else if (name == "sse")
+                    {
+                        mode = CPUSIMDMode::SSE;
+                    }
+                    else if (name == "avx2")
+                    {
+                        mode = CPUSIMDMode::AVX2;
+                    }
+                    else if (name == "avx512")
+                    {
+                        mode = CPUSIMDMode::AVX512;
+                    }
+                    else
+                    {
+                        sink->diagnose(SourceLoc(), Diagnostics::unknownCPUSIMDMode, name);
+                        return SLANG_FAIL;
+                    }
+
+                    requestImpl->getBackEndReq()->cpuSIMDMode = mode;
+                }
                 else if (argStr == "-default-downstream-compiler")
                 {
                     String sourceLanguageText;
@@ -1009,6 +1129,15 @@ struct OptionsParser
 
         spSetCompileFlags(compileRequest, flags);
 
+        if (compileCacheDirectory.getLength())
+        {
+            if (SLANG_FAILED(spSetCompileCache(compileRequest, compileCacheDirectory.getBuffer(), compileCacheMaxSize)))
+            {
+                sink->diagnose(SourceLoc(), Diagnostics::cannotUseCompileCacheDirectory, compileCacheDirectory);
+                return SLANG_FAIL;
+            }
+        }
+
         // As a compatability feature, if the user didn't list any explicit entry
         // point names, *and* they are compiling a single translation unit, *and* they
         // have either specified a stage, or we can assume one from the naming
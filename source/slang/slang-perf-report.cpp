@@ -0,0 +1,176 @@
+// slang-perf-report.cpp
+#include "slang-perf-report.h"
+
+#include "../core/slang-process-util.h"
+
+#include "slang-ir.h"
+
+namespace Slang {
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! PerfReport !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+void PerfReport::addEntry(const Entry& entry)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.add(entry);
+}
+
+void PerfReport::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+}
+
+static void _appendPadded(const UnownedStringSlice& text, Index width, StringBuilder& out)
+{
+    out << text;
+    for (Index i = text.getLength(); i < width; ++i)
+    {
+        out.appendChar(' ');
+    }
+}
+
+static void _appendInstCount(Int count, StringBuilder& out)
+{
+    char buffer[32];
+    if (count < 0)
+    {
+        sprintf_s(buffer, SLANG_COUNT_OF(buffer), "%10s", "-");
+    }
+    else
+    {
+        sprintf_s(buffer, SLANG_COUNT_OF(buffer), "%10lld", (long long)count);
+    }
+    out << buffer;
+}
+
+void PerfReport::appendAsText(StringBuilder& out) const
+{
+    Index scopeWidth = Index(UnownedStringSlice::fromLiteral("scope").getLength());
+    Index nameWidth = Index(UnownedStringSlice::fromLiteral("phase").getLength());
+    for (const auto& entry : m_entries)
+    {
+        scopeWidth = (entry.scope.getLength() > scopeWidth) ? entry.scope.getLength() : scopeWidth;
+        nameWidth = (entry.name.getLength() > nameWidth) ? entry.name.getLength() : nameWidth;
+    }
+
+    _appendPadded(UnownedStringSlice::fromLiteral("scope"), scopeWidth + 2, out);
+    _appendPadded(UnownedStringSlice::fromLiteral("phase"), nameWidth + 2, out);
+    out << " time (ms) insts before insts after  arena bytes   live bytes   peak bytes\n";
+
+    // Totals for each scope, in the order the scopes were first seen
+    List<String> scopes;
+    List<double> scopeTimes;
+
+    for (const auto& entry : m_entries)
+    {
+        _appendPadded(entry.scope.getUnownedSlice(), scopeWidth + 2, out);
+        _appendPadded(entry.name.getUnownedSlice(), nameWidth + 2, out);
+
+        char buffer[64];
+        sprintf_s(buffer, SLANG_COUNT_OF(buffer), "%10.3f   ", entry.timeInSeconds * 1000.0);
+        out << buffer;
+        _appendInstCount(entry.instCountBefore, out);
+        out << " ";
+        _appendInstCount(entry.instCountAfter, out);
+        sprintf_s(buffer, SLANG_COUNT_OF(buffer), " %12llu", (unsigned long long)entry.arenaBytesAllocated);
+        out << buffer;
+        if (entry.instCountAfter < 0)
+        {
+            // No module, so no memory to report
+            sprintf_s(buffer, SLANG_COUNT_OF(buffer), " %12s %12s\n", "-", "-");
+        }
+        else
+        {
+            sprintf_s(buffer, SLANG_COUNT_OF(buffer), " %12llu %12llu\n", (unsigned long long)entry.liveInstBytes, (unsigned long long)entry.peakLiveInstBytes);
+        }
+        out << buffer;
+
+        Index scopeIndex = scopes.indexOf(entry.scope);
+        if (scopeIndex < 0)
+        {
+            scopeIndex = scopes.getCount();
+            scopes.add(entry.scope);
+            scopeTimes.add(0.0);
+        }
+        scopeTimes[scopeIndex] += entry.timeInSeconds;
+    }
+
+    for (Index i = 0; i < scopes.getCount(); ++i)
+    {
+        char buffer[64];
+        sprintf_s(buffer, SLANG_COUNT_OF(buffer), "%.3f", scopeTimes[i] * 1000.0);
+        out << "total " << scopes[i] << ": " << buffer << " ms\n";
+    }
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! PerfPhaseRecorder !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+PerfPhaseRecorder::PerfPhaseRecorder(PerfReport* report, const String& scope, IRModule* module):
+    m_report(report),
+    m_scope(scope),
+    m_module(module)
+{
+    if (m_report)
+    {
+        if (m_module)
+        {
+            m_instCount = countIRInsts(m_module);
+            m_arenaBytes = m_module->memoryArena.calcTotalMemoryUsed();
+        }
+        m_startTick = ProcessUtil::getClockTick();
+    }
+}
+
+void PerfPhaseRecorder::endPhase(const char* name)
+{
+    if (!m_report)
+    {
+        return;
+    }
+
+    const uint64_t endTick = ProcessUtil::getClockTick();
+
+    PerfReport::Entry entry;
+    entry.scope = m_scope;
+    entry.name = name;
+    entry.timeInSeconds = double(endTick - m_startTick) / double(ProcessUtil::getClockFrequency());
+    entry.instCountBefore = m_instCount;
+
+    if (m_module)
+    {
+        const uint64_t arenaBytes = m_module->memoryArena.calcTotalMemoryUsed();
+
+        entry.instCountAfter = countIRInsts(m_module);
+        entry.arenaBytesAllocated = (arenaBytes > m_arenaBytes) ? (arenaBytes - m_arenaBytes) : 0;
+        entry.liveInstBytes = m_module->getLiveInstBytes();
+        entry.peakLiveInstBytes = m_module->getPeakLiveInstBytes();
+
+        m_instCount = entry.instCountAfter;
+        m_arenaBytes = arenaBytes;
+    }
+
+    m_report->addEntry(entry);
+
+    // Don't include the time taken to count in the next phase
+    m_startTick = ProcessUtil::getClockTick();
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! countIRInsts !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+static Int _countInsts(IRInst* inst)
+{
+    Int count = 1;
+    for (auto child : inst->getDecorationsAndChildren())
+    {
+        count += _countInsts(child);
+    }
+    return count;
+}
+
+Int countIRInsts(IRModule* module)
+{
+    return module ? _countInsts(module->getModuleInst()) : 0;
+}
+
+} // namespace Slang
@@ -0,0 +1,91 @@
+// slang-perf-report.h
+#ifndef SLANG_PERF_REPORT_H_INCLUDED
+#define SLANG_PERF_REPORT_H_INCLUDED
+
+#include "../core/slang-basic.h"
+
+#include <mutex>
+
+namespace Slang {
+
+struct IRModule;
+
+/* Records where the time (and IR memory) goes in a compilation - the phases of the front end, and each of the IR
+passes run when generating code for a target.
+
+Code generation for different targets and entry points can run on multiple threads, so adding entries is thread safe.
+Entries are in the order they were added, so passes for different scopes may be interleaved. */
+class PerfReport : public RefObject
+{
+public:
+    struct Entry
+    {
+        String scope;                       ///< "frontEnd", or the target (and entry points) code was being generated for
+        String name;                        ///< The name of the phase or pass
+        double timeInSeconds = 0.0;
+        Int instCountBefore = -1;           ///< Instructions in the IR module before the pass, or -1 if not known
+        Int instCountAfter = -1;            ///< Instructions in the IR module after the pass, or -1 if not known
+        uint64_t arenaBytesAllocated = 0;   ///< Bytes allocated from the IR module's memory arena during the pass
+        uint64_t liveInstBytes = 0;         ///< Bytes of the instructions in the IR module after the pass
+        uint64_t peakLiveInstBytes = 0;     ///< The most bytes the instructions in the IR module have taken so far
+    };
+
+        /// Add an entry
+    void addEntry(const Entry& entry);
+
+        /// Get the entries. Must not be called while a compilation that adds to the report is running.
+    const List<Entry>& getEntries() const { return m_entries; }
+
+        /// Append the entries as a table, followed by the total time for each scope
+    void appendAsText(StringBuilder& out) const;
+
+        /// Remove all of the entries
+    void clear();
+
+protected:
+    std::mutex m_mutex;                     ///< Guards m_entries
+    List<Entry> m_entries;
+};
+
+/* Records a sequence of phases in a PerfReport.
+
+Each phase starts where the previous one ended (or where the recorder was constructed), so a phase is recorded by
+calling `endPhase` once its work is done. Anything else done between phases, such as IR validation and dumping, is
+attributed to the next phase.
+
+If there is an IR module the amount of instructions in it, the memory allocated from its arena, and the memory its
+instructions take, are recorded for each phase. The memory of deallocated instructions is reused before more is
+allocated from the arena. Counting instructions is not part of the time of a phase.
+
+Does nothing if there is no report, so can be used unconditionally. */
+class PerfPhaseRecorder
+{
+public:
+        /// End the current phase (recording it with the name), and start the next
+    void endPhase(const char* name);
+
+        /// Set the module the phases operate on. The next phase ending is the first to record instruction counts.
+    void setModule(IRModule* module) { m_module = module; }
+
+        /// True if phases are recorded
+    bool isEnabled() const { return m_report != nullptr; }
+
+        /// Ctor. If report is nullptr nothing is recorded.
+    PerfPhaseRecorder(PerfReport* report, const String& scope, IRModule* module = nullptr);
+
+protected:
+    PerfReport* m_report;
+    String m_scope;
+    IRModule* m_module;
+
+    Int m_instCount = -1;                   ///< Instructions in m_module at the start of the phase
+    uint64_t m_arenaBytes = 0;              ///< Memory used in m_module's arena at the start of the phase
+    uint64_t m_startTick = 0;
+};
+
+    /// Count all of the instructions (including decorations) in the module
+Int countIRInsts(IRModule* module);
+
+} // namespace Slang
+
+#endif
@@ -12,6 +12,9 @@
 
 #include "slang-serialize-factory.h"
 
+#include "slang-lookup.h"
+#include "slang-parser.h"
+
 namespace Slang {
 
 // !!!!!!!!!!!!!!!!!!!!!! Generate fields for a type !!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -48,6 +51,442 @@ struct ASTFieldAccess
     }
 };
 
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! ASTSerialNodeFixer  !!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+static List<ExtensionDecl*>& _getCandidateExtensionList(
+    AggTypeDecl* typeDecl,
+    Dictionary<AggTypeDecl*, RefPtr<CandidateExtensionList>>& mapTypeToCandidateExtensions)
+{
+    RefPtr<CandidateExtensionList> entry;
+    if (!mapTypeToCandidateExtensions.TryGetValue(typeDecl, entry))
+    {
+        entry = new CandidateExtensionList();
+        mapTypeToCandidateExtensions.Add(typeDecl, entry);
+    }
+    return entry->candidateExtensions;
+}
+
+void ASTSerialNodeFixer::fixUp(NodeBase* node)
+{
+    if (Type* type = dynamicCast<Type>(node))
+    {
+        type->_setASTBuilder(m_astBuilder);
+    }
+    else if (ExtensionDecl* extensionDecl = dynamicCast<ExtensionDecl>(node))
+    {
+        SLANG_ASSERT(m_moduleDecl);
+        if (auto targetDeclRefType = as<DeclRefType>(extensionDecl->targetType))
+        {
+            // Attach our extension to that type as a candidate...
+            if (auto aggTypeDeclRef = targetDeclRefType->declRef.as<AggTypeDecl>())
+            {
+                auto aggTypeDecl = aggTypeDeclRef.getDecl();
+
+                _getCandidateExtensionList(aggTypeDecl, m_moduleDecl->mapTypeToCandidateExtensions).add(extensionDecl);
+            }
+        }
+    }
+    else if (SyntaxDecl* syntaxDecl = dynamicCast<SyntaxDecl>(node))
+    {
+        // Get the parse infos
+        const auto syntaxParseInfos = getSyntaxParseInfos();
+        SLANG_ASSERT(syntaxParseInfos.getCount());
+
+        // Set up the dictionary lazily
+        if (m_syntaxKeywordDict.Count() == 0)
+        {
+            for (Index i = 0; i < syntaxParseInfos.getCount(); ++i)
+            {
+                const auto& entry = syntaxParseInfos[i];
+                m_syntaxKeywordDict.Add(m_namePool->getName(entry.keywordName), i);
+            }
+            // Must have something in it at this point
+            SLANG_ASSERT(m_syntaxKeywordDict.Count());
+        }
+
+        // Look up the index 
+        Index* entryIndexPtr = m_syntaxKeywordDict.TryGetValue(syntaxDecl->getName());
+        if (entryIndexPtr)
+        {
+            // Set up SyntaxDecl based on the ParseSyntaxIndo
+            auto& info = syntaxParseInfos[*entryIndexPtr];
+            syntaxDecl->parseCallback = *info.callback;
+            syntaxDecl->parseUserData = const_cast<ReflectClassInfo*>(info.classInfo);
+        }
+        else
+        {
+            // If we don't find a setup entry, we use `parseSimpleSyntax`, and set
+            // the parseUserData to the ReflectClassInfo (as parseSimpleSyntax needs this)
+            syntaxDecl->parseCallback = &parseSimpleSyntax;
+            SLANG_ASSERT(syntaxDecl->syntaxClass.classInfo);
+            syntaxDecl->parseUserData = const_cast<ReflectClassInfo*>(syntaxDecl->syntaxClass.classInfo);
+        }
+    }
+}
+
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! ASTSerialDeclLoader  !!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+ASTSerialDeclLoader::ASTSerialDeclLoader(ASTBuilder* astBuilder, NamePool* syntaxNamePool):
+    m_astBuilder(astBuilder),
+    m_objectFactory(astBuilder),
+    m_fixer(astBuilder, syntaxNamePool),
+    m_exportPool(StringSlicePool::Style::Empty)
+{
+}
+
+SlangResult ASTSerialDeclLoader::init(SerialClasses* serialClasses, const void* data, size_t dataSize, const void* exportsData, size_t exportsDataSize, NamePool* namePool, SerialSourceLocReader* sourceLocReader)
+{
+    // The entries point into the data, so we need our own copy. Using uint64_t keeps it aligned.
+    m_data.setCount(Index((dataSize + sizeof(uint64_t) - 1) / sizeof(uint64_t)));
+    ::memcpy(m_data.getBuffer(), data, dataSize);
+
+    m_membersField = serialClasses->findField(SerialTypeKind::NodeBase, SerialSubType(ASTNodeType::ContainerDecl), "members");
+    m_nextInContainerWithSameNameField = serialClasses->findField(SerialTypeKind::NodeBase, SerialSubType(ASTNodeType::Decl), "nextInContainerWithSameName");
+    m_nameAndLocField = serialClasses->findField(SerialTypeKind::NodeBase, SerialSubType(ASTNodeType::Decl), "nameAndLoc");
+    m_modifiersField = serialClasses->findField(SerialTypeKind::NodeBase, SerialSubType(ASTNodeType::ModifiableSyntaxNode), "modifiers");
+    if (!m_membersField || !m_nextInContainerWithSameNameField || !m_nameAndLocField || !m_modifiersField)
+    {
+        return SLANG_FAIL;
+    }
+
+    m_serialClasses = serialClasses;
+    m_reader = new SerialReader(serialClasses, &m_objectFactory);
+    SLANG_RETURN_ON_FAIL(m_reader->loadEntries((const uint8_t*)m_data.getBuffer(), dataSize));
+
+    m_sourceLocReader = sourceLocReader;
+    m_reader->getExtraObjects().set(sourceLocReader);
+
+    // Members of containers are created on demand.
+    // The same name links are set up when the member dictionary is built, so there is no need to follow them.
+    m_reader->addDeferredField(m_membersField);
+    m_reader->addDeferredField(m_nextInContainerWithSameNameField);
+
+    m_reader->prepareOnDemand(namePool, this);
+
+    if (exportsData)
+    {
+        m_exportsData.setCount(Index(exportsDataSize / sizeof(uint32_t)));
+        ::memcpy(m_exportsData.getBuffer(), exportsData, m_exportsData.getCount() * sizeof(uint32_t));
+
+        // Pairs of (mangled name, node)
+        const Index exportsCount = m_exportsData.getCount() / 2;
+        for (Index i = 0; i < exportsCount; ++i)
+        {
+            const UnownedStringSlice mangledName = m_reader->getStringSlice(SerialIndex(m_exportsData[i * 2]));
+            // If more than one entity has the same mangled name, use the first (as Module::findExportFromMangledName does)
+            if (Index(m_exportPool.add(mangledName)) == m_exportNodes.getCount())
+            {
+                m_exportNodes.add(SerialIndex(m_exportsData[i * 2 + 1]));
+            }
+        }
+    }
+
+    return SLANG_OK;
+}
+
+ModuleDecl* ASTSerialDeclLoader::loadModuleDecl()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // The root node is at index 1 (0 is the null value)
+    ModuleDecl* moduleDecl = as<ModuleDecl>(m_reader->getPointer(SerialIndex(1)).dynamicCast<NodeBase>());
+    if (!moduleDecl)
+    {
+        return nullptr;
+    }
+    m_fixer.setModuleDecl(moduleDecl);
+
+    // Extensions are found through the module (not lookup), so they have to be created up front
+    const auto& entries = m_reader->getEntries();
+    for (Index i = 1; i < entries.getCount(); ++i)
+    {
+        auto objectEntry = m_reader->getObjectEntry(SerialIndex(i));
+        if (objectEntry && objectEntry->typeKind == SerialTypeKind::NodeBase &&
+            ReflectClassInfo::isSubClassOf(uint32_t(objectEntry->subType), ExtensionDecl::kReflectClassInfo))
+        {
+            m_reader->getPointer(SerialIndex(i));
+        }
+    }
+
+    return moduleDecl;
+}
+
+bool ASTSerialDeclLoader::_isLazyContainer(ContainerDecl* decl)
+{
+    // Other containers (like generics and functions) are small, and their members are accessed directly in many places
+    return as<NamespaceDeclBase>(decl) || as<AggTypeDeclBase>(decl);
+}
+
+bool ASTSerialDeclLoader::_hasModifier(SerialIndex nodeIndex, const ReflectClassInfo& modifierClass)
+{
+    const SerialIndex modifiersIndex = *(const SerialIndex*)m_reader->getSerialField(nodeIndex, m_modifiersField);
+
+    Index modifiersCount;
+    auto modifierIndices = (const SerialIndex*)m_reader->getArray(modifiersIndex, modifiersCount);
+    for (Index i = 0; i < modifiersCount; ++i)
+    {
+        auto objectEntry = m_reader->getObjectEntry(modifierIndices[i]);
+        if (objectEntry && objectEntry->typeKind == SerialTypeKind::NodeBase &&
+            ReflectClassInfo::isSubClassOf(uint32_t(objectEntry->subType), modifierClass))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+Decl* ASTSerialDeclLoader::_getMember(ContainerInfo* info, Index memberIndex)
+{
+    Index membersCount;
+    auto memberIndices = (const SerialIndex*)m_reader->getArray(info->membersIndex, membersCount);
+    SLANG_ASSERT(memberIndex >= 0 && memberIndex < membersCount);
+    return m_reader->getPointer(memberIndices[memberIndex]).dynamicCast<Decl>();
+}
+
+void ASTSerialDeclLoader::_ensureNameIndex(ContainerInfo* info)
+{
+    if (info->hasNameIndex)
+    {
+        return;
+    }
+    info->hasNameIndex = true;
+
+    Index membersCount;
+    auto memberIndices = (const SerialIndex*)m_reader->getArray(info->membersIndex, membersCount);
+
+    info->prevMemberWithSameName.setCount(membersCount);
+    for (Index i = 0; i < membersCount; ++i)
+    {
+        // Get the name without creating the member
+        typedef SerialTypeInfo<NameLoc>::SerialType SerialNameLoc;
+        auto nameLoc = (const SerialNameLoc*)m_reader->getSerialField(memberIndices[i], m_nameAndLocField);
+        Name* name = m_reader->getName(nameLoc->name);
+
+        Index prevIndex = -1;
+        if (name)
+        {
+            info->lastMemberWithName.TryGetValue(name, prevIndex);
+            info->lastMemberWithName[name] = i;
+        }
+        info->prevMemberWithSameName[i] = prevIndex;
+    }
+}
+
+Decl* ASTSerialDeclLoader::_loadMembersWithName(ContainerDecl* decl, ContainerInfo* info, Name* name)
+{
+    // The memberDictionary holds the names that have been loaded
+    Decl* firstDecl = nullptr;
+    if (decl->memberDictionary.TryGetValue(name, firstDecl))
+    {
+        return firstDecl;
+    }
+
+    _ensureNameIndex(info);
+
+    Index memberIndex;
+    if (!info->lastMemberWithName.TryGetValue(name, memberIndex))
+    {
+        return nullptr;
+    }
+
+    // Link up in the same order as buildMemberDictionary - the last member is first
+    Decl* prevDecl = nullptr;
+    for (; memberIndex >= 0; memberIndex = info->prevMemberWithSameName[memberIndex])
+    {
+        Decl* memberDecl = _getMember(info, memberIndex);
+        memberDecl->nextInContainerWithSameName = nullptr;
+
+        if (prevDecl)
+        {
+            prevDecl->nextInContainerWithSameName = memberDecl;
+        }
+        else
+        {
+            firstDecl = memberDecl;
+        }
+        prevDecl = memberDecl;
+    }
+
+    decl->memberDictionary.Add(name, firstDecl);
+    return firstDecl;
+}
+
+void ASTSerialDeclLoader::_loadAllMembers(ContainerDecl* decl)
+{
+    if (!decl->memberLoader.load())
+    {
+        return;
+    }
+
+    RefPtr<ContainerInfo> info = m_containers[decl];
+
+    _ensureNameIndex(info);
+    for (const auto& pair : info->lastMemberWithName)
+    {
+        _loadMembersWithName(decl, info, pair.Key);
+    }
+
+    List<Decl*> members;
+    m_reader->getArray(info->membersIndex, members);
+    decl->members.swapWith(members);
+
+    // The dictionary (and transparent members) now cover all of the members
+    decl->dictionaryLastCount = decl->members.getCount();
+
+    m_containers.Remove(decl);
+
+    // Only clear once everything is set up, as the members are accessed directly from then on
+    decl->memberLoader.store(nullptr);
+}
+
+void ASTSerialDeclLoader::loadAllMembers(ContainerDecl* decl)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    _loadAllMembers(decl);
+}
+
+Decl* ASTSerialDeclLoader::loadMembersWithName(ContainerDecl* decl, Name* name)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    RefPtr<ContainerInfo> info;
+    if (!decl->memberLoader.load() || !m_containers.TryGetValue(decl, info))
+    {
+        // All of the members have been loaded, so the dictionary is complete
+        Decl* firstDecl = nullptr;
+        decl->memberDictionary.TryGetValue(name, firstDecl);
+        return firstDecl;
+    }
+
+    return _loadMembersWithName(decl, info, name);
+}
+
+void ASTSerialDeclLoader::loadDeclsWithModifier(const ReflectClassInfo& modifierClass, List<Decl*>& outDecls)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const auto& entries = m_reader->getEntries();
+    for (Index i = 1; i < entries.getCount(); ++i)
+    {
+        auto objectEntry = m_reader->getObjectEntry(SerialIndex(i));
+        if (objectEntry && objectEntry->typeKind == SerialTypeKind::NodeBase &&
+            ReflectClassInfo::isSubClassOf(uint32_t(objectEntry->subType), Decl::kReflectClassInfo) &&
+            _hasModifier(SerialIndex(i), modifierClass))
+        {
+            outDecls.add(m_reader->getPointer(SerialIndex(i)).dynamicCast<Decl>());
+        }
+    }
+}
+
+bool ASTSerialDeclLoader::findExportFromMangledName(const UnownedStringSlice& mangledName, NodeBase*& outNode)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_exportNodes.getCount() == 0)
+    {
+        // The module was written without exports
+        return false;
+    }
+
+    const Index index = m_exportPool.findIndex(mangledName);
+    outNode = (index >= 0) ? m_reader->getPointer(m_exportNodes[index]).dynamicCast<NodeBase>() : nullptr;
+    return true;
+}
+
+void ASTSerialDeclLoader::loadAll()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const auto& entries = m_reader->getEntries();
+    for (Index i = 1; i < entries.getCount(); ++i)
+    {
+        if (m_reader->getObjectEntry(SerialIndex(i)))
+        {
+            m_reader->getPointer(SerialIndex(i));
+        }
+    }
+
+    // All the nodes now exist, so no more containers will be added
+    List<ContainerDecl*> containerDecls;
+    for (const auto& pair : m_containers)
+    {
+        containerDecls.add(pair.Key);
+    }
+    for (auto containerDecl : containerDecls)
+    {
+        _loadAllMembers(containerDecl);
+    }
+}
+
+void ASTSerialDeclLoader::deferField(SerialReader* reader, SerialIndex objectIndex, const SerialField* field, const void* serial)
+{
+    // The same name links are set when the member dictionary is built
+    if (field != m_membersField)
+    {
+        return;
+    }
+
+    // The object has been constructed (its fields are being deserialized), so this won't construct it again
+    ContainerDecl* containerDecl = reader->getPointer(objectIndex).dynamicCast<ContainerDecl>();
+    SLANG_ASSERT(containerDecl);
+
+    const SerialIndex membersIndex = *(const SerialIndex*)serial;
+    if (_isLazyContainer(containerDecl) && membersIndex != SerialIndex(0))
+    {
+        RefPtr<ContainerInfo> info = new ContainerInfo;
+        info->membersIndex = membersIndex;
+        m_containers.Add(containerDecl, info);
+    }
+    else
+    {
+        field->type->toNativeFunc(reader, serial, (uint8_t*)containerDecl + field->nativeOffset);
+    }
+}
+
+void ASTSerialDeclLoader::objectDeserialized(SerialReader* reader, SerialIndex objectIndex, const SerialPointer& ptr)
+{
+    SLANG_UNUSED(reader);
+    SLANG_UNUSED(objectIndex);
+
+    if (ptr.m_kind != SerialTypeKind::NodeBase)
+    {
+        return;
+    }
+    NodeBase* node = (NodeBase*)ptr.m_ptr;
+
+    m_fixer.fixUp(node);
+
+    ContainerDecl* containerDecl = as<ContainerDecl>(node);
+    if (!containerDecl)
+    {
+        return;
+    }
+
+    RefPtr<ContainerInfo> info;
+    if (m_containers.TryGetValue(containerDecl, info))
+    {
+        // Lookup needs the transparent members up front, so create them now
+        Index membersCount;
+        auto memberIndices = (const SerialIndex*)m_reader->getArray(info->membersIndex, membersCount);
+        for (Index i = 0; i < membersCount; ++i)
+        {
+            if (_hasModifier(memberIndices[i], TransparentModifier::kReflectClassInfo))
+            {
+                TransparentMemberInfo transparentInfo;
+                transparentInfo.decl = m_reader->getPointer(memberIndices[i]).dynamicCast<Decl>();
+                containerDecl->transparentMembers.add(transparentInfo);
+            }
+        }
+
+        containerDecl->memberLoader.store(this);
+    }
+    else
+    {
+        // All the members are created, so the dictionary can be built (so lookup doesn't modify the decl later)
+        buildMemberDictionary(containerDecl);
+    }
+}
+
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! ASTSerialUtil  !!!!!!!!!!!!!!!!!!!!!!!!!!!!
 
 /* static */void ASTSerialUtil::addSerialClasses(SerialClasses* serialClasses)
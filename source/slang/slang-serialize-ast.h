@@ -10,6 +10,10 @@
 #include "slang-ast-builder.h"
 
 #include "slang-serialize.h"
+#include "slang-serialize-factory.h"
+#include "slang-serialize-source-loc.h"
+
+#include <mutex>
 
 namespace Slang
 {
@@ -23,6 +27,8 @@ struct ASTSerialBinary
     static const FourCC kSlangASTModuleFourCC = SLANG_FOUR_CC('S', 'A', 'm', 'l');
         /// AST module data 
     static const FourCC kSlangASTModuleDataFourCC = SLANG_FOUR_CC('S', 'A', 'm', 'd');
+        /// AST module exports. Pairs of SerialIndex (mangled name, node) for each symbol the module exports.
+    static const FourCC kSlangASTModuleExportsFourCC = SLANG_FOUR_CC('S', 'A', 'm', 'x');
 };
 
 class ModuleSerialFilter : public SerialFilter
@@ -40,6 +46,108 @@ public:
     ModuleDecl* m_moduleDecl;
 };
 
+/* Sets up AST nodes that have been deserialized, such that they can be used in the same way as nodes produced
+by parsing and checking source.
+
+1) Sets the ASTBuilder on Type nodes
+2) Adds extensions to the module mapTypeToCandidateExtensions cache
+3) Sets the callback pointers for parsing on SyntaxDecls */
+class ASTSerialNodeFixer
+{
+public:
+    void fixUp(NodeBase* node);
+
+        /// Set the module decl the nodes are in. Must be set before any ExtensionDecl is fixed up.
+    void setModuleDecl(ModuleDecl* moduleDecl) { m_moduleDecl = moduleDecl; }
+
+        /// namePool is the pool used to look up the syntax keyword names
+    ASTSerialNodeFixer(ASTBuilder* astBuilder, NamePool* namePool):
+        m_astBuilder(astBuilder),
+        m_namePool(namePool)
+    {
+    }
+
+protected:
+    ModuleDecl* m_moduleDecl = nullptr;
+    ASTBuilder* m_astBuilder;
+    NamePool* m_namePool;
+
+    // Maps from keyword name name to index in (syntaxParseInfos)
+    // Will be filled in lazily if needed (for SyntaxDecl setup)
+    Dictionary<Name*, Index> m_syntaxKeywordDict;
+};
+
+/* Reads an AST module, creating nodes only when they are needed.
+
+The module decl and extension decls are created up front. The members of modules, types and extensions are
+created when they are looked up by name, or when all of the members are accessed (see ASTDeclLoader).
+Other containers (such as generics and functions) have all their members created along with them. */
+class ASTSerialDeclLoader : public ASTDeclLoader, public SerialOnDemandHandler
+{
+public:
+    // ASTDeclLoader
+    virtual void loadAllMembers(ContainerDecl* decl) SLANG_OVERRIDE;
+    virtual Decl* loadMembersWithName(ContainerDecl* decl, Name* name) SLANG_OVERRIDE;
+    virtual void loadDeclsWithModifier(const ReflectClassInfo& modifierClass, List<Decl*>& outDecls) SLANG_OVERRIDE;
+    virtual bool findExportFromMangledName(const UnownedStringSlice& mangledName, NodeBase*& outNode) SLANG_OVERRIDE;
+    virtual void loadAll() SLANG_OVERRIDE;
+
+    // SerialOnDemandHandler
+    virtual void deferField(SerialReader* reader, SerialIndex objectIndex, const SerialField* field, const void* serial) SLANG_OVERRIDE;
+    virtual void objectDeserialized(SerialReader* reader, SerialIndex objectIndex, const SerialPointer& ptr) SLANG_OVERRIDE;
+
+        /// Set up to read the module. Takes a copy of the data (and exportsData if set), so they don't need to stay in scope.
+    SlangResult init(SerialClasses* serialClasses, const void* data, size_t dataSize, const void* exportsData, size_t exportsDataSize, NamePool* namePool, SerialSourceLocReader* sourceLocReader);
+
+        /// The reader. Imported symbols must be set on its objects before loadModuleDecl is called.
+    SerialReader* getReader() { return m_reader; }
+
+        /// Create the module decl, and the nodes that have to exist up front. Returns nullptr if the root isn't a module decl.
+    ModuleDecl* loadModuleDecl();
+
+        /// syntaxNamePool is the pool used to look up the syntax keyword names
+    ASTSerialDeclLoader(ASTBuilder* astBuilder, NamePool* syntaxNamePool);
+
+protected:
+    /* Members yet to be created of a container */
+    struct ContainerInfo : public RefObject
+    {
+        SerialIndex membersIndex = SerialIndex(0);      ///< The array holding the members
+        bool hasNameIndex = false;                      ///< Set when the following are set up
+        Dictionary<Name*, Index> lastMemberWithName;    ///< The index of the last member with a name
+        List<Index> prevMemberWithSameName;             ///< For each member the index of the previous with the same name, or -1
+    };
+
+    bool _isLazyContainer(ContainerDecl* decl);
+    bool _hasModifier(SerialIndex nodeIndex, const ReflectClassInfo& modifierClass);
+    Decl* _getMember(ContainerInfo* info, Index memberIndex);
+    void _ensureNameIndex(ContainerInfo* info);
+    Decl* _loadMembersWithName(ContainerDecl* decl, ContainerInfo* info, Name* name);
+    void _loadAllMembers(ContainerDecl* decl);
+
+    List<uint64_t> m_data;                          ///< Copy of the serialized data (entries point into it)
+    List<uint32_t> m_exportsData;                   ///< Copy of the exports data
+
+    RefPtr<ASTBuilder> m_astBuilder;
+    RefPtr<SerialClasses> m_serialClasses;
+    RefPtr<SerialSourceLocReader> m_sourceLocReader;
+    DefaultSerialObjectFactory m_objectFactory;
+    RefPtr<SerialReader> m_reader;
+    ASTSerialNodeFixer m_fixer;
+
+    const SerialField* m_membersField = nullptr;
+    const SerialField* m_nextInContainerWithSameNameField = nullptr;
+    const SerialField* m_nameAndLocField = nullptr;
+    const SerialField* m_modifiersField = nullptr;
+
+    Dictionary<ContainerDecl*, RefPtr<ContainerInfo>> m_containers;     ///< Containers with members yet to be created
+
+    StringSlicePool m_exportPool;                   ///< Mangled names of exports. Each is at the same index in m_exportNodes
+    List<SerialIndex> m_exportNodes;
+
+    std::mutex m_mutex;                             ///< Held whilst loading
+};
+
 struct ASTSerialUtil
 {
         /// Add the AST related classes
@@ -72,6 +72,12 @@ namespace Slang {
             auto moduleDecl = module->getModuleDecl();
             SLANG_ASSERT(moduleDecl);
 
+            // Everything in the module has to exist to be written
+            if (auto declLoader = module->getASTDeclLoader())
+            {
+                declLoader->loadAll();
+            }
+
             dstModule.astRootNode = moduleDecl;
         }
         if (options.optionFlags & SerialOptionFlag::IRModule)
@@ -90,10 +96,38 @@ namespace Slang {
 
 /* static */SlangResult SerialContainerUtil::addFrontEndRequestToData(FrontEndCompileRequest* frontEndReq, const WriteOptions& options, SerialContainerData& outData)
 {
+    Linkage* linkage = frontEndReq->getLinkage();
+    Session* session = linkage->getSessionImpl();
+
     // Go through translation units, adding modules
     for (TranslationUnitRequest* translationUnit : frontEndReq->translationUnits)
     {
-        SLANG_RETURN_ON_FAIL(addModuleToData(translationUnit->module, options, outData));        
+        const Index moduleIndex = outData.modules.getCount();
+        SLANG_RETURN_ON_FAIL(addModuleToData(translationUnit->module, options, outData));
+
+        // Record what the module was produced from, so that it can be checked when it is imported
+        if (moduleIndex < outData.modules.getCount())
+        {
+            auto& dstModule = outData.modules[moduleIndex];
+
+            SerialBinary::ModuleHeader& header = dstModule.header;
+            header.semanticVersion = SerialBinary::ModuleHeader::getCurrentVersion().m_raw;
+            header.stdLibSourceHash = session->getStdLibSourceHash();
+
+            // Every file the module depends on (its source, included files and the files of the modules it imports).
+            // They are read through the linkage's file system, as they are when the module is imported.
+            for (const String& path : translationUnit->module->getFilePathDependencyList())
+            {
+                ComPtr<ISlangBlob> blob;
+                if (SLANG_SUCCEEDED(linkage->getFileSystemExt()->loadFile(path.getBuffer(), blob.writeRef())))
+                {
+                    SerialContainerData::FileDependency dependency;
+                    dependency.path = path;
+                    dependency.contentsHash = calcFileContentsHash(blob);
+                    dstModule.fileDependencies.add(dependency);
+                }
+            }
+        }
     }
 
     return SLANG_OK;
@@ -189,6 +223,29 @@ namespace Slang {
             // Okay, we need to serialize this module to our container file.
             // We currently don't serialize it's name..., but support for that could be added.
 
+            // Write the header followed by the file dependencies, if the module has one
+            if (module.header.semanticVersion)
+            {
+                RiffContainer::ScopeChunk scopeHeader(container, RiffContainer::Chunk::Kind::Data, SerialBinary::kModuleHeaderFourCc);
+
+                SerialBinary::ModuleHeader header = module.header;
+                header.dependencyCount = uint32_t(module.fileDependencies.getCount());
+                container->write(&header, sizeof(header));
+
+                for (const auto& srcDependency : module.fileDependencies)
+                {
+                    SerialBinary::ModuleFileDependency dependency;
+                    dependency.contentsHash = srcDependency.contentsHash;
+                    dependency.pathSize = uint32_t(srcDependency.path.getLength());
+                    dependency.pad = 0;
+                    container->write(&dependency, sizeof(dependency));
+
+                    const uint32_t zeros = 0;
+                    container->write(srcDependency.path.getBuffer(), dependency.pathSize);
+                    container->write(&zeros, ((dependency.pathSize + 3) & ~uint32_t(3)) - dependency.pathSize);
+                }
+            }
+
             // Write the IR information
             if ((options.optionFlags & SerialOptionFlag::IRModule) && module.irModule)
             {
@@ -220,9 +277,30 @@ namespace Slang {
                     // Add the module and everything that isn't filtered out in the filter.
                     writer.addPointer(moduleDecl);
 
+                    // Add the exported symbols, such that they can be found without creating all of the nodes
+                    // when read back (see ASTSerialDeclLoader)
+                    List<uint32_t> exports;
+                    if (Module* moduleDeclModule = moduleDecl->module)
+                    {
+                        List<UnownedStringSlice> mangledNames;
+                        List<NodeBase*> nodes;
+                        moduleDeclModule->getExportSymbols(mangledNames, nodes);
+
+                        for (Index i = 0; i < nodes.getCount(); ++i)
+                        {
+                            exports.add(SerialIndexRaw(writer.addString(mangledNames[i])));
+                            exports.add(SerialIndexRaw(writer.addPointer(nodes[i])));
+                        }
+                    }
 
                     // We can now serialize it into the riff container.
                     SLANG_RETURN_ON_FAIL(writer.writeIntoContainer(ASTSerialBinary::kSlangASTModuleDataFourCC, container));
+
+                    if (exports.getCount())
+                    {
+                        RiffContainer::ScopeChunk scopeExports(container, RiffContainer::Chunk::Kind::Data, ASTSerialBinary::kSlangASTModuleExportsFourCC);
+                        container->write(exports.getBuffer(), exports.getCount() * sizeof(uint32_t));
+                    }
                 }
             }
         }
@@ -287,27 +365,156 @@ namespace Slang {
 }
 
 
-static List<ExtensionDecl*>& _getCandidateExtensionList(
-    AggTypeDecl* typeDecl,
-    Dictionary<AggTypeDecl*, RefPtr<CandidateExtensionList>>& mapTypeToCandidateExtensions)
+    /// Set the objects of the imported symbols in reader, to the nodes they refer to in other modules.
+    /// Does nothing if the options don't specify a linkage.
+static SlangResult _resolveImportSymbols(SerialReader* reader, const SerialContainerUtil::ReadOptions& options)
 {
-    RefPtr<CandidateExtensionList> entry;
-    if (!mapTypeToCandidateExtensions.TryGetValue(typeDecl, entry))
+    if (!options.linkage)
+    {
+        return SLANG_OK;
+    }
+
+    const auto& entries = reader->getEntries();
+    auto& objects = reader->getObjects();
+    const Index entriesCount = entries.getCount();
+
+    String currentModuleName;
+    Module* currentModule = nullptr;
+
+    // Index from 1 (0 is null)
+    for (Index i = 1; i < entriesCount; ++i)
     {
-        entry = new CandidateExtensionList();
-        mapTypeToCandidateExtensions.Add(typeDecl, entry);
+        const SerialInfo::Entry* entry = entries[i];
+        if (entry->typeKind == SerialTypeKind::ImportSymbol)
+        {
+            UnownedStringSlice mangledName = reader->getStringSlice(SerialIndex(i));
+
+            UnownedStringSlice moduleName;
+            SLANG_RETURN_ON_FAIL(MangledNameParser::parseModuleName(mangledName, moduleName));
+
+            // If we already have looked up this module and it has the same name just use what we have
+            Module* readModule = nullptr;
+            if (currentModule && moduleName == currentModuleName.getUnownedSlice())
+            {
+                readModule = currentModule;
+            }
+            else
+            {
+                // The modules are loaded on the linkage.
+                Linkage* linkage = options.linkage;
+
+                NamePool* namePool = linkage->getNamePool();
+                Name* moduleNameName = namePool->getName(moduleName);
+
+                readModule = linkage->findOrImportModule(moduleNameName, SourceLoc::fromRaw(0), options.sink);
+                if (!readModule)
+                {
+                    return SLANG_FAIL;
+                }
+
+                // Set the current module and name
+                currentModule = readModule;
+                currentModuleName = moduleName;
+            }
+
+            // Look up the symbol
+            NodeBase* nodeBase = readModule->findExportFromMangledName(mangledName);
+
+            if (!nodeBase)
+            {
+                if (options.sink)
+                {
+                    options.sink->diagnose(SourceLoc::fromRaw(0), Diagnostics::unableToFindSymbolInModule, mangledName, moduleName);
+                }
+
+                // If didn't find the export then we are done
+                return SLANG_FAIL;
+            }
+
+            // set the result
+            objects[i] = nodeBase;
+        }
     }
-    return entry->candidateExtensions;
+
+    return SLANG_OK;
+}
+/* static */HashCode64 SerialContainerUtil::calcFileContentsHash(ISlangBlob* blob)
+{
+    return getHashCode64((const char*)blob->getBufferPointer(), blob->getBufferSize());
 }
 
-/* static */Result SerialContainerUtil::read(RiffContainer* container, const ReadOptions& options, SerialContainerData& out)
+static SlangResult _readModuleHeader(RiffContainer::DataChunk* headerChunk, SerialBinary::ModuleHeader& outHeader, List<SerialContainerData::FileDependency>& outDependencies)
 {
-    out.clear();
+    outDependencies.clear();
+
+    RiffContainer::Data* headerData = headerChunk->getSingleData();
+    if (!headerData || headerData->getSize() < sizeof(outHeader))
+    {
+        return SLANG_FAIL;
+    }
+    const uint8_t* cur = (const uint8_t*)headerData->getPayload();
+    const uint8_t* end = cur + headerData->getSize();
+
+    ::memcpy(&outHeader, cur, sizeof(outHeader));
+    cur += sizeof(outHeader);
+
+    for (uint32_t i = 0; i < outHeader.dependencyCount; ++i)
+    {
+        SerialBinary::ModuleFileDependency dependency;
+        if (size_t(end - cur) < sizeof(dependency))
+        {
+            return SLANG_FAIL;
+        }
+        ::memcpy(&dependency, cur, sizeof(dependency));
+        cur += sizeof(dependency);
+
+        const size_t alignedPathSize = (size_t(dependency.pathSize) + 3) & ~size_t(3);
+        if (size_t(end - cur) < alignedPathSize)
+        {
+            return SLANG_FAIL;
+        }
+
+        SerialContainerData::FileDependency dstDependency;
+        dstDependency.path = UnownedStringSlice((const char*)cur, dependency.pathSize);
+        dstDependency.contentsHash = dependency.contentsHash;
+        outDependencies.add(dstDependency);
 
+        cur += alignedPathSize;
+    }
+    return SLANG_OK;
+}
+
+/* static */SlangResult SerialContainerUtil::readModuleHeader(RiffContainer::ListChunk* containerChunk, SerialBinary::ModuleHeader& outHeader, List<SerialContainerData::FileDependency>& outDependencies)
+{
+    RiffContainer::ListChunk* moduleList = containerChunk->findContainedList(SerialBinary::kModuleListFourCc);
+    if (!moduleList)
+    {
+        return SLANG_FAIL;
+    }
+    // The header precedes the other chunks of the module
+    auto headerChunk = as<RiffContainer::DataChunk>(moduleList->getFirstContainedChunk(), SerialBinary::kModuleHeaderFourCc);
+    return headerChunk ? _readModuleHeader(headerChunk, outHeader, outDependencies) : SLANG_FAIL;
+}
+
+/* static */Result SerialContainerUtil::read(RiffContainer* container, const ReadOptions& options, SerialContainerData& out)
+{
     RiffContainer::ListChunk* containerChunk = container->getRoot()->findListRec(SerialBinary::kContainerFourCc);
     if (!containerChunk)
     {
         // Must be a container
+        out.clear();
+        return SLANG_FAIL;
+    }
+
+    return read(containerChunk, options, out);
+}
+
+/* static */Result SerialContainerUtil::read(RiffContainer::ListChunk* containerChunk, const ReadOptions& options, SerialContainerData& out)
+{
+    out.clear();
+
+    if (containerChunk->m_fourCC != SerialBinary::kContainerFourCc)
+    {
         return SLANG_FAIL;
     }
 
@@ -352,7 +559,18 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
 
             RefPtr<ASTBuilder> astBuilder;
             NodeBase* astRootNode = nullptr;
+            RefPtr<ASTDeclLoader> astDeclLoader;
             RefPtr<IRModule> irModule;
+            SerialBinary::ModuleHeader header;
+            List<SerialContainerData::FileDependency> fileDependencies;
+
+            if (auto headerChunk = as<RiffContainer::DataChunk>(chunk, SerialBinary::kModuleHeaderFourCc))
+            {
+                SLANG_RETURN_ON_FAIL(_readModuleHeader(headerChunk, header, fileDependencies));
+
+                // Onto next chunk
+                chunk = chunk->m_next;
+            }
 
             if (auto irChunk = as<RiffContainer::ListChunk>(chunk, IRSerialBinary::kIRModuleFourCc))
             {
@@ -362,7 +580,7 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
 
                 // Read IR back from serialData
                 IRSerialReader reader;
-                SLANG_RETURN_ON_FAIL(reader.read(serialData, options.session, sourceLocReader, irModule));
+                SLANG_RETURN_ON_FAIL(reader.read(serialData, options.session, sourceLocReader, options.irReadFlags, irModule));
 
                 // Onto next chunk
                 chunk = chunk->m_next;
@@ -388,122 +606,64 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
 
                     astBuilder = new ASTBuilder(options.sharedASTBuilder, buf.ProduceString());
 
-                    DefaultSerialObjectFactory objectFactory(astBuilder);
-
-                    SerialReader reader(serialClasses, &objectFactory);
-
-                    // Sets up the entry table - one entry for each 'object'.
-                    // No native objects are constructed. No objects are deserialized.
-                    SLANG_RETURN_ON_FAIL(reader.loadEntries((const uint8_t*)astData->getPayload(), astData->getSize()));
-
-                    // Construct a native object for each table entry (where appropriate).
-                    // Note that this *doesn't* set all object pointers - some are special cased and created on demand (strings)
-                    // and imported symbols will have their object pointers unset (they are resolved in next step)
-                    SLANG_RETURN_ON_FAIL(reader.constructObjects(options.namePool));
-
-                    // Resolve external references if the linkage is specified
-                    if (options.linkage)
+                    if (options.astReadFlags & ASTSerialReadFlag::LazyMembers)
                     {
-                        const auto& entries = reader.getEntries();
-                        auto& objects = reader.getObjects();
-                        const Index entriesCount = entries.getCount();
-
-                        String currentModuleName;
-                        Module* currentModule = nullptr;
-
-                        // Index from 1 (0 is null)
-                        for (Index i = 1; i < entriesCount; ++i)
-                        {
-                            const SerialInfo::Entry* entry = entries[i];
-                            if (entry->typeKind == SerialTypeKind::ImportSymbol)
-                            {
-                                UnownedStringSlice mangledName = reader.getStringSlice(SerialIndex(i));
-
-                                UnownedStringSlice moduleName;
-                                SLANG_RETURN_ON_FAIL(MangledNameParser::parseModuleName(mangledName, moduleName));
-
-                                // If we already have looked up this module and it has the same name just use what we have
-                                Module* readModule = nullptr;
-                                if (currentModule && moduleName == currentModuleName.getUnownedSlice())
-                                {
-                                    readModule = currentModule;
-                                }
-                                else
-                                {
-                                    // The modules are loaded on the linkage.
-                                    Linkage* linkage = options.linkage;
-
-                                    NamePool* namePool = linkage->getNamePool();
-                                    Name* moduleNameName = namePool->getName(moduleName);
-
-                                    readModule = linkage->findOrImportModule(moduleNameName, SourceLoc::fromRaw(0), options.sink);
-                                    if (!readModule)
-                                    {
-                                        return SLANG_FAIL;
-                                    }
-
-                                    // Set the current module and name
-                                    currentModule = readModule;
-                                    currentModuleName = moduleName;
-                                }
-
-                                // Look up the symbol
-                                NodeBase* nodeBase = readModule->findExportFromMangledName(mangledName);
-
-                                if (!nodeBase)
-                                {
-                                    if (options.sink)
-                                    {
-                                        options.sink->diagnose(SourceLoc::fromRaw(0), Diagnostics::unableToFindSymbolInModule, mangledName, moduleName);
-                                    }
-
-                                    // If didn't find the export then we are done
-                                    return SLANG_FAIL;
-                                }
-
-                                // set the result
-                                objects[i] = nodeBase;
-                            }
-                        }
-                    }
-
-                    // Set the sourceLocReader before doing de-serialize, such can lookup the remapped sourceLocs
-                    reader.getExtraObjects().set(sourceLocReader);
+                        RefPtr<ASTSerialDeclLoader> declLoader = new ASTSerialDeclLoader(astBuilder, options.session->getNamePool());
 
-                    // Go through all of the AST nodes
-                    // 1) Set the ASTBuilder on Type nodes
-                    
+                        RiffContainer::Data* exportsData = astChunk->findContainedData(ASTSerialBinary::kSlangASTModuleExportsFourCC);
+                        SLANG_RETURN_ON_FAIL(declLoader->init(serialClasses,
+                            astData->getPayload(), astData->getSize(),
+                            exportsData ? exportsData->getPayload() : nullptr, exportsData ? exportsData->getSize() : 0,
+                            options.namePool, sourceLocReader));
 
-                    // TODO(JS):
-                    // If modules can have more complicated relationships (like a two modules can refer to symbols
-                    // from each other), then we can make this work by
-                    // 1) deserialize *without* the external symbols being set up
-                    // 2) calculate the symbols
-                    // 3) deserialize the other module (in the same way)
-                    // 4) run deserializeObjects *again* on each module
-                    // This is less efficient than it might be (because deserialize phase is done twice) so if this is necessary
-                    // may want a mechanism that *just* does reference lookups.
-                    //
-                    // For now if we assume a module can only access symbols from another module, and not the reverse.
-                    // So we just need to deserialize and we are done
-                    SLANG_RETURN_ON_FAIL(reader.deserializeObjects());
-
-                    // Get the root node. It's at index 1 (0 is the null value).
-                    astRootNode = reader.getPointer(SerialIndex(1)).dynamicCast<NodeBase>();
-
-                    // 2) Add the extensions to the module mapTypeToCandidateExtensions cache
-                    // 3) We need to fix the callback pointers for parsing
+                        SLANG_RETURN_ON_FAIL(_resolveImportSymbols(declLoader->getReader(), options));
 
+                        // Only the module decl, and what has to exist up front are created.
+                        // Everything else is created as it is looked up.
+                        astRootNode = declLoader->loadModuleDecl();
+                        astDeclLoader = declLoader;
+                    }
+                    else
                     {
-                        ModuleDecl* moduleDecl = as<ModuleDecl>(astRootNode);
-
-                        // Maps from keyword name name to index in (syntaxParseInfos)
-                        // Will be filled in lazily if needed (for SyntaxDecl setup)
-                        Dictionary<Name*, Index> syntaxKeywordDict;
-
-                        // Get the parse infos
-                        const auto syntaxParseInfos = getSyntaxParseInfos();
-                        SLANG_ASSERT(syntaxParseInfos.getCount());
+                        DefaultSerialObjectFactory objectFactory(astBuilder);
+
+                        SerialReader reader(serialClasses, &objectFactory);
+
+                        // Sets up the entry table - one entry for each 'object'.
+                        // No native objects are constructed. No objects are deserialized.
+                        SLANG_RETURN_ON_FAIL(reader.loadEntries((const uint8_t*)astData->getPayload(), astData->getSize()));
+
+                        // Construct a native object for each table entry (where appropriate).
+                        // Note that this *doesn't* set all object pointers - some are special cased and created on demand (strings)
+                        // and imported symbols will have their object pointers unset (they are resolved in next step)
+                        SLANG_RETURN_ON_FAIL(reader.constructObjects(options.namePool));
+
+                        // Resolve external references if the linkage is specified
+                        SLANG_RETURN_ON_FAIL(_resolveImportSymbols(&reader, options));
+
+                        // Set the sourceLocReader before doing de-serialize, such can lookup the remapped sourceLocs
+                        reader.getExtraObjects().set(sourceLocReader);
+
+                        // TODO(JS):
+                        // If modules can have more complicated relationships (like a two modules can refer to symbols
+                        // from each other), then we can make this work by
+                        // 1) deserialize *without* the external symbols being set up
+                        // 2) calculate the symbols
+                        // 3) deserialize the other module (in the same way)
+                        // 4) run deserializeObjects *again* on each module
+                        // This is less efficient than it might be (because deserialize phase is done twice) so if this is necessary
+                        // may want a mechanism that *just* does reference lookups.
+                        //
+                        // For now if we assume a module can only access symbols from another module, and not the reverse.
+                        // So we just need to deserialize and we are done
+                        SLANG_RETURN_ON_FAIL(reader.deserializeObjects());
+
+                        // Get the root node. It's at index 1 (0 is the null value).
+                        astRootNode = reader.getPointer(SerialIndex(1)).dynamicCast<NodeBase>();
+
+                        // Go through all of the AST nodes, setting them up for use
+                        ASTSerialNodeFixer fixer(astBuilder, options.session->getNamePool());
+                        fixer.setModuleDecl(as<ModuleDecl>(astRootNode));
 
                         for (auto& obj : reader.getObjects())
                         {
@@ -511,57 +671,7 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
                             {
                                 NodeBase* nodeBase = (NodeBase*)obj.m_ptr;
                                 SLANG_ASSERT(nodeBase);
-
-                                if (Type* type = dynamicCast<Type>(nodeBase))
-                                {
-                                    type->_setASTBuilder(astBuilder);
-                                }
-                                else if (ExtensionDecl* extensionDecl = dynamicCast<ExtensionDecl>(nodeBase))
-                                {
-                                    if (auto targetDeclRefType = as<DeclRefType>(extensionDecl->targetType))
-                                    {
-                                        // Attach our extension to that type as a candidate...
-                                        if (auto aggTypeDeclRef = targetDeclRefType->declRef.as<AggTypeDecl>())
-                                        {
-                                            auto aggTypeDecl = aggTypeDeclRef.getDecl();
-
-                                            _getCandidateExtensionList(aggTypeDecl, moduleDecl->mapTypeToCandidateExtensions).add(extensionDecl);
-                                        }
-                                    }
-                                }
-                                else if (SyntaxDecl* syntaxDecl = dynamicCast<SyntaxDecl>(nodeBase))
-                                {
-                                    // Set up the dictionary lazily
-                                    if (syntaxKeywordDict.Count() == 0)
-                                    {
-                                        NamePool* namePool = options.session->getNamePool();
-                                        for (Index i = 0; i < syntaxParseInfos.getCount(); ++i)
-                                        {
-                                            const auto& entry = syntaxParseInfos[i];
-                                            syntaxKeywordDict.Add(namePool->getName(entry.keywordName), i);
-                                        }
-                                        // Must have something in it at this point
-                                        SLANG_ASSERT(syntaxKeywordDict.Count());
-                                    }
-
-                                    // Look up the index 
-                                    Index* entryIndexPtr = syntaxKeywordDict.TryGetValue(syntaxDecl->getName());
-                                    if (entryIndexPtr)
-                                    {
-                                        // Set up SyntaxDecl based on the ParseSyntaxIndo
-                                        auto& info = syntaxParseInfos[*entryIndexPtr];
-                                        syntaxDecl->parseCallback = *info.callback;
-                                        syntaxDecl->parseUserData = const_cast<ReflectClassInfo*>(info.classInfo);
-                                    }
-                                    else
-                                    {
-                                        // If we don't find a setup entry, we use `parseSimpleSyntax`, and set
-                                        // the parseUserData to the ReflectClassInfo (as parseSimpleSyntax needs this)
-                                        syntaxDecl->parseCallback = &parseSimpleSyntax;
-                                        SLANG_ASSERT(syntaxDecl->syntaxClass.classInfo);
-                                        syntaxDecl->parseUserData = const_cast<ReflectClassInfo*>(syntaxDecl->syntaxClass.classInfo);
-                                    }
-                                }
+                                fixer.fixUp(nodeBase);
                             }
                         }
                     }
@@ -577,7 +687,10 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
 
                 module.astBuilder = astBuilder;
                 module.astRootNode = astRootNode;
+                module.astDeclLoader = astDeclLoader;
                 module.irModule = irModule;
+                module.header = header;
+                module.fileDependencies = fileDependencies;
 
                 out.modules.add(module);
             }
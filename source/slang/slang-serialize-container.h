@@ -4,6 +4,7 @@
 
 #include "../core/slang-riff.h"
 #include "slang-serialize-types.h"
+#include "slang-serialize-ir-types.h"
 #include "slang-ir-insts.h"
 #include "slang-profile.h"
 
@@ -48,11 +49,20 @@ struct SerialContainerData
         RefPtr<IRModule> irModule;
     };
 
+    struct FileDependency
+    {
+        String path;                            ///< The path as recorded in the module's file path dependency list
+        HashCode64 contentsHash = 0;            ///< The hash of the file's contents
+    };
+
     struct Module
     {
         RefPtr<IRModule> irModule;              ///< The IR for the module
         RefPtr<ASTBuilder> astBuilder;          ///< The astBuilder that owns the astRootNode
         NodeBase* astRootNode = nullptr;        ///< The module decl
+        RefPtr<ASTDeclLoader> astDeclLoader;    ///< Set if the AST nodes are created on demand
+        SerialBinary::ModuleHeader header;      ///< Identifies what the module was produced from. Only written if header.semanticVersion is set.
+        List<FileDependency> fileDependencies;  ///< The files the module was produced from, written with the header. The first is the module's source.
     };
 
     struct EntryPoint
@@ -91,6 +101,8 @@ struct SerialContainerUtil
         SharedASTBuilder* sharedASTBuilder = nullptr;
         Linkage* linkage = nullptr;
         DiagnosticSink* sink = nullptr;
+        IRSerialReadFlags irReadFlags = 0;          ///< Flags controlling how IR modules are read 
+        ASTSerialReadFlags astReadFlags = 0;        ///< Flags controlling how AST modules are read
     };
 
         /// Add module to outData
@@ -107,6 +119,15 @@ struct SerialContainerUtil
 
         /// Read the container into outData
     static SlangResult read(RiffContainer* container, const ReadOptions& options, SerialContainerData& outData);
+        /// Read the container held in containerChunk into outData. 
+    static SlangResult read(RiffContainer::ListChunk* containerChunk, const ReadOptions& options, SerialContainerData& outData);
+
+        /// Read the header (and file dependencies) of the first module in the container held in containerChunk, without reading the module.
+        /// Fails if there isn't one.
+    static SlangResult readModuleHeader(RiffContainer::ListChunk* containerChunk, SerialBinary::ModuleHeader& outHeader, List<SerialContainerData::FileDependency>& outDependencies);
+
+        /// The hash of the contents of a file a module depends on. The same hash is used when a module is written and when it's checked on import.
+    static HashCode64 calcFileContentsHash(ISlangBlob* blob);
 
         /// Verify IR serialization
     static SlangResult verifyIRSerialize(IRModule* module, Session* session, const WriteOptions& options);
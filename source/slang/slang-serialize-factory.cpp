@@ -137,4 +137,28 @@ SerialIndex ModuleSerialFilter::writePointer(SerialWriter* writer, const NodeBas
     return SLANG_OK;
 }
 
+/* static */HashCode64 SerialClassesUtil::calcLayoutHash(SerialClasses* serialClasses)
+{
+    StringBuilder buf;
+    for (Index typeKind = 0; typeKind < Index(SerialTypeKind::CountOf); ++typeKind)
+    {
+        for (const SerialClass* cls : serialClasses->getSerialClasses(SerialTypeKind(typeKind)))
+        {
+            if (!cls)
+            {
+                buf << "-\n";
+                continue;
+            }
+
+            buf << typeKind << " " << Index(cls->subType) << " " << Index(cls->size) << " " << Index(cls->alignment) << " " << Index(cls->flags) << "\n";
+            for (Index i = 0; i < cls->fieldsCount; ++i)
+            {
+                const SerialField& field = cls->fields[i];
+                buf << field.name << " " << Index(field.serialOffset) << " " << Index(field.type->serialSizeInBytes) << " " << Index(field.type->serialAlignment) << "\n";
+            }
+        }
+    }
+    return getHashCode64(buf.getBuffer(), size_t(buf.getLength()));
+}
+
 } // namespace Slang
@@ -40,6 +40,9 @@ struct SerialClassesUtil
     static SlangResult addSerialClasses(SerialClasses* serialClasses);
         /// Create SerialClasses with all the types added
     static SlangResult create(RefPtr<SerialClasses>& out);
+        /// Calculate a hash of the serialized layout of all of the classes in serialClasses. Changes whenever
+        /// a class or field is added or removed, or the serialized type of a field changes.
+    static HashCode64 calcLayoutHash(SerialClasses* serialClasses);
 };
 
 
@@ -19,6 +19,16 @@ namespace Slang {
 // Pre-declare
 class Name;
 
+typedef uint32_t IRSerialReadFlags;
+struct IRSerialReadFlag
+{
+    enum Enum : IRSerialReadFlags
+    {
+            /// The bodies of functions and generics are only created when first needed (see IRModule::ensureBodyLoaded)
+        LazyBodies = 0x01,
+    };
+};
+
 struct IRSerialBinary
 {
         /// IR module list
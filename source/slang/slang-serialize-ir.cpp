@@ -110,6 +110,9 @@ Result IRSerialWriter::write(IRModule* module, SerialSourceLocWriter* sourceLocW
 
     m_serialData = serialData;
 
+    // Everything in the module must be present to be written
+    module->ensureAllBodiesLoaded();
+
     serialData->clear();
 
     // We reserve 0 for null
@@ -671,30 +674,275 @@ static Result _readInstArrayChunk(SerialCompressionType containerCompressionType
     return SLANG_OK;
 }
 
-Result IRSerialReader::read(const IRSerialData& data, Session* session, SerialSourceLocReader* sourceLocReader, RefPtr<IRModule>& outModule)
+/* Holds the state needed to turn serialized instructions into IRInsts.
+
+When reading with IRSerialReadFlag::LazyBodies, the blocks of module level functions and generics (and everything
+they contain) are not created by IRSerialReader::read. The loader is then attached to the IRModule, and creates a body
+the first time it is requested.
+
+A lazily loaded module may be shared (as the stdlib is) between compiles on different threads, so loading is serialized
+through m_mutex. */
+class IRSerialBodyLoader : public IRModuleBodyLoader
 {
+public:
+    typedef IRSerialData Ser;
     typedef Ser::Inst::PayloadType PayloadType;
 
-    m_serialData = &data;
- 
-    auto module = new IRModule();
-    outModule = module;
-    m_module = module;
+    // IRModuleBodyLoader
+    virtual void loadBody(IRInst* inst) SLANG_OVERRIDE;
+    virtual void loadAllBodies() SLANG_OVERRIDE;
 
-    module->session = session;
+        /// Set up the instructions of the module. If lazy is set, the bodies of global values are deferred.
+    SlangResult init(const IRSerialData& data, IRModule* module, SerialSourceLocReader* sourceLocReader, bool lazy);
+
+        /// True if there are bodies that are yet to be loaded
+    bool hasPendingBodies() const { return m_pendingBodies.Count() != 0; }
+
+        /// Make the loader hold its own copy of the data, so it can outlive the data passed to init
+    void takeCopyOfData(const IRSerialData& data) { m_ownedData = data; m_data = &m_ownedData; }
+
+    IRSerialBodyLoader():
+        m_stringTable(StringSlicePool::Style::Default)
+    {
+    }
+
+protected:
+    IRInst* _createInst(const Ser::Inst& srcInst);
+    void _patchInst(Index instIndex);
+    void _markDeferred(Index instIndex, Ser::InstIndex rootIndex);
+    void _calcSourceLocs(SerialSourceLocReader* sourceLocReader);
+    void _loadBody(Ser::InstIndex rootIndex);
+    void _loadPendingBody(IRInst* inst);
+
+    IRModule* m_module = nullptr;
+    const IRSerialData* m_data = nullptr;
+    IRSerialData m_ownedData;                       ///< Only used if the loader outlives the data passed to init
+
+    StringSlicePool m_stringTable;
+
+    List<IRInst*> m_insts;                          ///< The instruction at each index, or nullptr if not yet created
+    List<Index> m_childRunIndices;                  ///< For each instruction the index of the run holding its children, or -1 if has none
+    List<Ser::InstIndex> m_rootIndices;             ///< For an instruction in a deferred body, the index of the global value that holds it. Otherwise 0.
+    List<SourceLoc> m_sourceLocs;                   ///< Source location for each instruction
+
+    Dictionary<IRInst*, Ser::InstIndex> m_pendingBodies;    ///< Global values whose body has not been loaded
+
+    std::mutex m_mutex;                             ///< Held whilst loading
+};
+
+IRInst* IRSerialBodyLoader::_createInst(const Ser::Inst& srcInst)
+{
+    IRModule* module = m_module;
+    const IROp op((IROp)srcInst.m_op);
+
+    if (_isConstant(op))
+    {
+        // Handling of constants
+
+        // Calculate the minimum object size (ie not including the payload of value)    
+        const size_t prefixSize = SLANG_OFFSET_OF(IRConstant, value);
+
+        IRConstant* irConst = nullptr;
+        switch (op)
+        {                    
+            case kIROp_BoolLit:
+            {
+                SLANG_ASSERT(srcInst.m_payloadType == PayloadType::UInt32);
+                irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, prefixSize + sizeof(IRIntegerValue)));
+                irConst->value.intVal = srcInst.m_payload.m_uint32 != 0;
+                break;
+            }
+            case kIROp_IntLit:
+            {
+                SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Int64);
+                irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, prefixSize + sizeof(IRIntegerValue)));
+                irConst->value.intVal = srcInst.m_payload.m_int64; 
+                break;
+            }
+            case kIROp_PtrLit:
+            {
+                SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Int64);
+                irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, prefixSize + sizeof(void*)));
+                irConst->value.ptrVal = (void*) (intptr_t) srcInst.m_payload.m_int64; 
+                break;
+            }
+            case kIROp_FloatLit:
+            {
+                SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Float64);
+                irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op,  prefixSize + sizeof(IRFloatingPointValue)));
+                irConst->value.floatVal = srcInst.m_payload.m_float64;
+                break;
+            }
+            case kIROp_StringLit:
+            {
+                SLANG_ASSERT(srcInst.m_payloadType == PayloadType::String_1);
+
+                const UnownedStringSlice slice = m_stringTable.getSlice(StringSlicePool::Handle(srcInst.m_payload.m_stringIndices[0]));
+                    
+                const size_t sliceSize = slice.getLength();
+                const size_t instSize = prefixSize + SLANG_OFFSET_OF(IRConstant::StringValue, chars) + sliceSize;
+
+                irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, instSize));
+
+                IRConstant::StringValue& dstString = irConst->value.stringVal;
+
+                dstString.numChars = uint32_t(sliceSize);
+                // Turn into pointer to avoid warning of array overrun
+                char* dstChars = dstString.chars;
+                // Copy the chars
+                memcpy(dstChars, slice.begin(), sliceSize);
+                break;
+            }
+            default:
+            {
+                SLANG_ASSERT(!"Unknown constant type");
+                return nullptr;
+            }
+        }
+
+        return irConst;
+    }
+    else if (_isTextureTypeBase(op))
+    {
+        IRTextureTypeBase* inst = static_cast<IRTextureTypeBase*>(createEmptyInst(module, op, 1));
+        SLANG_ASSERT(srcInst.m_payloadType == PayloadType::OperandAndUInt32);
+
+        // Reintroduce the texture type bits into the the
+        const uint32_t other = srcInst.m_payload.m_operandAndUInt32.m_uint32;
+        inst->op = IROp(uint32_t(inst->op) | (other << kIROpMeta_OtherShift));
+
+        return inst;
+    }
+    else
+    {
+        int numOperands = srcInst.getNumOperands();
+        return createEmptyInst(module, op, numOperands);
+    }
+}
+
+void IRSerialBodyLoader::_patchInst(Index instIndex)
+{
+    const Ser::Inst& srcInst = m_data->m_insts[instIndex];
+    IRInst* dstInst = m_insts[instIndex];
+
+    // Set the result type
+    if (srcInst.m_resultTypeIndex != Ser::InstIndex(0))
+    {
+        IRInst* resultInst = m_insts[int(srcInst.m_resultTypeIndex)];
+        // NOTE! Counter intuitively the IRType* paramter may not be IRType* derived for example 
+        // IRGlobalGenericParam is valid, but isn't IRType* derived
+
+        //SLANG_RELEASE_ASSERT(as<IRType>(resultInst));
+        dstInst->setFullType(static_cast<IRType*>(resultInst));
+    }
+
+    const Ser::InstIndex* srcOperandIndices;
+    const int numOperands = m_data->getOperands(srcInst, &srcOperandIndices);
+
+    auto dstOperands = dstInst->getOperands();
+
+    for (int j = 0; j < numOperands; j++)
+    {
+        dstOperands[j].init(dstInst, m_insts[int(srcOperandIndices[j])]);
+    }
+}
+
+void IRSerialBodyLoader::_markDeferred(Index instIndex, Ser::InstIndex rootIndex)
+{
+    List<Index> stack;
+    stack.add(instIndex);
+
+    while (stack.getCount())
+    {
+        const Index index = stack.getLast();
+        stack.removeLast();
+
+        m_rootIndices[index] = rootIndex;
+
+        const Index runIndex = m_childRunIndices[index];
+        if (runIndex >= 0)
+        {
+            const auto& run = m_data->m_childRuns[runIndex];
+            for (Index j = 0; j < Index(run.m_numChildren); ++j)
+            {
+                stack.add(Index(run.m_startInstIndex) + j);
+            }
+        }
+    }
+}
+
+void IRSerialBodyLoader::_calcSourceLocs(SerialSourceLocReader* sourceLocReader)
+{
+    const Index numInsts = m_data->m_insts.getCount();
+
+    // Re-add source locations, if they are defined
+    if (m_data->m_rawSourceLocs.getCount() == numInsts)
+    {
+        m_sourceLocs.setCount(numInsts);
+
+        const Ser::RawSourceLoc* srcLocs = m_data->m_rawSourceLocs.begin();
+        for (Index i = 1; i < numInsts; ++i)
+        {
+            m_sourceLocs[i].setRaw(Slang::SourceLoc::RawValue(srcLocs[i]));
+        }
+    }
+
+    // We now need to apply the runs
+    if (sourceLocReader && m_data->m_debugSourceLocRuns.getCount())
+    {
+        m_sourceLocs.setCount(numInsts);
+
+        List<IRSerialData::SourceLocRun> sourceRuns(m_data->m_debugSourceLocRuns);
+        // They are now in source location order
+        sourceRuns.sort();
+
+        // Just guess initially 0 for the source file that contains the initial run
+        SerialSourceLocData::SourceRange range = SerialSourceLocData::SourceRange::getInvalid();
+        int fix = 0;
+        
+        const Index numRuns = sourceRuns.getCount();
+        for (Index i = 0; i < numRuns; ++i)
+        {
+            const auto& run = sourceRuns[i];
+
+            // Work out the fixed source location
+            SourceLoc sourceLoc;
+            if (run.m_sourceLoc)
+            {
+                if (!range.contains(run.m_sourceLoc))
+                {
+                    fix = sourceLocReader->calcFixSourceLoc(run.m_sourceLoc, range);
+                }
+                sourceLoc = sourceLocReader->calcFixedLoc(run.m_sourceLoc, fix, range);
+            }
+
+            // Write to all the instructions
+            SLANG_ASSERT(Index(uint32_t(run.m_startInstIndex) + run.m_numInst) <= numInsts);
+            SourceLoc* dstLocs = m_sourceLocs.getBuffer() + int(run.m_startInstIndex);
+
+            const int runSize = int(run.m_numInst);
+            for (int j = 0; j < runSize; ++j)
+            {
+                dstLocs[j] = sourceLoc;
+            }
+        }
+    }
+}
+
+SlangResult IRSerialBodyLoader::init(const IRSerialData& data, IRModule* module, SerialSourceLocReader* sourceLocReader, bool lazy)
+{
+    m_data = &data;
+    m_module = module;
 
     // Convert m_stringTable into StringSlicePool.
     SerialStringTableUtil::decodeStringTable(data.m_stringTable.getBuffer(), data.m_stringTable.getCount(), m_stringTable);
 
-    // Add all the instructions
-    List<IRInst*> insts;
-
     const Index numInsts = data.m_insts.getCount();
 
     SLANG_ASSERT(numInsts > 0);
 
-    insts.setCount(numInsts);
-    insts[0] = nullptr;
+    m_insts.setCount(numInsts);
+    memset(m_insts.getBuffer(), 0, sizeof(IRInst*) * numInsts);
 
     // 0 holds null
     // 1 holds the IRModuleInst
@@ -710,201 +958,311 @@ Result IRSerialReader::read(const IRSerialData& data, Session* session, SerialSo
         moduleInst->module = module;
 
         // Set the IRModuleInst
-        insts[1] = moduleInst; 
+        m_insts[1] = moduleInst; 
     }
 
-    for (Index i = 2; i < numInsts; ++i)
+    // Find the children run for each parent
+    m_childRunIndices.setCount(numInsts);
+    for (auto& runIndex : m_childRunIndices)
+    {
+        runIndex = -1;
+    }
+    const Index numChildRuns = data.m_childRuns.getCount();
+    for (Index i = 0; i < numChildRuns; ++i)
     {
-        const Ser::Inst& srcInst = data.m_insts[i];
+        m_childRunIndices[Index(data.m_childRuns[i].m_parentIndex)] = i;
+    }
 
-        const IROp op((IROp)srcInst.m_op);
+    m_rootIndices.setCount(numInsts);
+    memset(m_rootIndices.getBuffer(), 0, sizeof(Ser::InstIndex) * numInsts);
 
-        if (_isConstant(op))
+    if (lazy && m_childRunIndices[1] >= 0)
+    {
+        // Defer all of the non decoration children of module level functions and generics. 
+        const auto& moduleRun = data.m_childRuns[m_childRunIndices[1]];
+        for (Index i = 0; i < Index(moduleRun.m_numChildren); ++i)
         {
-            // Handling of constants
-
-            // Calculate the minimum object size (ie not including the payload of value)    
-            const size_t prefixSize = SLANG_OFFSET_OF(IRConstant, value);
+            const Index globalIndex = Index(moduleRun.m_startInstIndex) + i;
+            const IROp op = IROp(data.m_insts[globalIndex].m_op);
+            if ((op != kIROp_Func && op != kIROp_Generic) || m_childRunIndices[globalIndex] < 0)
+            {
+                continue;
+            }
 
-            IRConstant* irConst = nullptr;
-            switch (op)
-            {                    
-                case kIROp_BoolLit:
-                {
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::UInt32);
-                    irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, prefixSize + sizeof(IRIntegerValue)));
-                    irConst->value.intVal = srcInst.m_payload.m_uint32 != 0;
-                    break;
-                }
-                case kIROp_IntLit:
-                {
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Int64);
-                    irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, prefixSize + sizeof(IRIntegerValue)));
-                    irConst->value.intVal = srcInst.m_payload.m_int64; 
-                    break;
-                }
-                case kIROp_PtrLit:
+            const auto& run = data.m_childRuns[m_childRunIndices[globalIndex]];
+            for (Index j = 0; j < Index(run.m_numChildren); ++j)
+            {
+                const Index childIndex = Index(run.m_startInstIndex) + j;
+                if (!IRDecoration::isaImpl(IROp(data.m_insts[childIndex].m_op)))
                 {
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Int64);
-                    irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, prefixSize + sizeof(void*)));
-                    irConst->value.ptrVal = (void*) (intptr_t) srcInst.m_payload.m_int64; 
-                    break;
+                    _markDeferred(childIndex, Ser::InstIndex(globalIndex));
                 }
-                case kIROp_FloatLit:
+            }
+        }
+
+        // Anything that is created up front must be able to reference its operands. If something outside of a body
+        // references something inside, the body has to be loaded up front too. Loading a body may in turn
+        // reference other bodies, so repeat until nothing changes.
+        List<bool> forceLoad;
+        forceLoad.setCount(numInsts);
+        for (;;)
+        {
+            memset(forceLoad.getBuffer(), 0, sizeof(bool) * numInsts);
+            bool changed = false;
+
+            for (Index i = 2; i < numInsts; ++i)
+            {
+                if (m_rootIndices[i] != Ser::InstIndex(0))
                 {
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Float64);
-                    irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op,  prefixSize + sizeof(IRFloatingPointValue)));
-                    irConst->value.floatVal = srcInst.m_payload.m_float64;
-                    break;
+                    continue;
                 }
-                case kIROp_StringLit:
-                {
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::String_1);
+                const Ser::Inst& srcInst = data.m_insts[i];
 
-                    const UnownedStringSlice slice = m_stringTable.getSlice(StringSlicePool::Handle(srcInst.m_payload.m_stringIndices[0]));
-                        
-                    const size_t sliceSize = slice.getLength();
-                    const size_t instSize = prefixSize + SLANG_OFFSET_OF(IRConstant::StringValue, chars) + sliceSize;
+                const Ser::InstIndex* srcOperandIndices;
+                const int numOperands = data.getOperands(srcInst, &srcOperandIndices);
 
-                    irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, instSize));
+                for (int j = -1; j < numOperands; ++j)
+                {
+                    const Ser::InstIndex rootIndex = m_rootIndices[Index(j < 0 ? srcInst.m_resultTypeIndex : srcOperandIndices[j])];
+                    if (rootIndex != Ser::InstIndex(0))
+                    {
+                        forceLoad[Index(rootIndex)] = true;
+                        changed = true;
+                    }
+                }
+            }
 
-                    IRConstant::StringValue& dstString = irConst->value.stringVal;
+            if (!changed)
+            {
+                break;
+            }
 
-                    dstString.numChars = uint32_t(sliceSize);
-                    // Turn into pointer to avoid warning of array overrun
-                    char* dstChars = dstString.chars;
-                    // Copy the chars
-                    memcpy(dstChars, slice.begin(), sliceSize);
-                    break;
-                }
-                default:
+            for (auto& rootIndex : m_rootIndices)
+            {
+                if (rootIndex != Ser::InstIndex(0) && forceLoad[Index(rootIndex)])
                 {
-                    SLANG_ASSERT(!"Unknown constant type");
-                    return SLANG_FAIL;
+                    rootIndex = Ser::InstIndex(0);
                 }
             }
-
-            insts[i] = irConst;
         }
-        else if (_isTextureTypeBase(op))
-        {
-            IRTextureTypeBase* inst = static_cast<IRTextureTypeBase*>(createEmptyInst(module, op, 1));
-            SLANG_ASSERT(srcInst.m_payloadType == PayloadType::OperandAndUInt32);
-
-            // Reintroduce the texture type bits into the the
-            const uint32_t other = srcInst.m_payload.m_operandAndUInt32.m_uint32;
-            inst->op = IROp(uint32_t(inst->op) | (other << kIROpMeta_OtherShift));
+    }
 
-            insts[i] = inst;
-        }
-        else
+    // Create all of the instructions that are not deferred
+    for (Index i = 2; i < numInsts; ++i)
+    {
+        if (m_rootIndices[i] == Ser::InstIndex(0))
         {
-            int numOperands = srcInst.getNumOperands();
-            insts[i] = createEmptyInst(module, op, numOperands);
+            IRInst* inst = _createInst(data.m_insts[i]);
+            if (!inst)
+            {
+                return SLANG_FAIL;
+            }
+            m_insts[i] = inst;
         }
     }
 
     // Patch up the operands
     for (Index i = 1; i < numInsts; ++i)
     {
-        const Ser::Inst& srcInst = data.m_insts[i];
-        const IROp op((IROp)srcInst.m_op);
-
-        IRInst* dstInst = insts[i];
-
-        // Set the result type
-        if (srcInst.m_resultTypeIndex != Ser::InstIndex(0))
+        if (m_insts[i])
         {
-            IRInst* resultInst = insts[int(srcInst.m_resultTypeIndex)];
-            // NOTE! Counter intuitively the IRType* paramter may not be IRType* derived for example 
-            // IRGlobalGenericParam is valid, but isn't IRType* derived
-
-            //SLANG_RELEASE_ASSERT(as<IRType>(resultInst));
-            dstInst->setFullType(static_cast<IRType*>(resultInst));
-        }
-       
-        //if (!isParentDerived(op))
-        {
-            const Ser::InstIndex* srcOperandIndices;
-            const int numOperands = data.getOperands(srcInst, &srcOperandIndices);
-
-            auto dstOperands = dstInst->getOperands();
-
-            for (int j = 0; j < numOperands; j++)
-            {
-                dstOperands[j].init(dstInst, insts[int(srcOperandIndices[j])]);
-            }
+            _patchInst(i);
         }
     }
     
     // Patch up the children
+    for (Index i = 0; i < numChildRuns; i++)
     {
-        const Index numChildRuns = data.m_childRuns.getCount();
-        for (Index i = 0; i < numChildRuns; i++)
-        {
-            const auto& run = data.m_childRuns[i];
+        const auto& run = data.m_childRuns[i];
 
-            IRInst* inst = insts[int(run.m_parentIndex)];
+        IRInst* inst = m_insts[int(run.m_parentIndex)];
+        if (!inst)
+        {
+            continue;
+        }
 
-            for (int j = 0; j < int(run.m_numChildren); ++j)
+        for (int j = 0; j < int(run.m_numChildren); ++j)
+        {
+            IRInst* child = m_insts[j + int(run.m_startInstIndex)];
+            // A child that isn't created is in a deferred body
+            if (child)
             {
-                IRInst* child = insts[j + int(run.m_startInstIndex)];
                 SLANG_ASSERT(child->parent == nullptr);
                 child->insertAtEnd(inst);
             }
         }
     }
 
-    // Re-add source locations, if they are defined
-    if (m_serialData->m_rawSourceLocs.getCount() == numInsts)
+    _calcSourceLocs(sourceLocReader);
+    if (m_sourceLocs.getCount())
     {
-        const Ser::RawSourceLoc* srcLocs = m_serialData->m_rawSourceLocs.begin();
         for (Index i = 1; i < numInsts; ++i)
         {
-            IRInst* dstInst = insts[i];
-            
-            dstInst->sourceLoc.setRaw(Slang::SourceLoc::RawValue(srcLocs[i]));
+            if (IRInst* dstInst = m_insts[i])
+            {
+                dstInst->sourceLoc = m_sourceLocs[i];
+            }
         }
     }
 
-    // We now need to apply the runs
-    if (sourceLocReader && m_serialData->m_debugSourceLocRuns.getCount())
+    // Record all of the bodies still to be loaded
+    for (Index i = 2; i < numInsts; ++i)
     {
-        List<IRSerialData::SourceLocRun> sourceRuns(m_serialData->m_debugSourceLocRuns);
-        // They are now in source location order
-        sourceRuns.sort();
+        const Ser::InstIndex rootIndex = m_rootIndices[i];
+        if (rootIndex != Ser::InstIndex(0))
+        {
+            m_pendingBodies.AddIfNotExists(m_insts[Index(rootIndex)], rootIndex);
+        }
+    }
 
-        // Just guess initially 0 for the source file that contains the initial run
-        SerialSourceLocData::SourceRange range = SerialSourceLocData::SourceRange::getInvalid();
-        int fix = 0;
-        
-        const Index numRuns = sourceRuns.getCount();
-        for (Index i = 0; i < numRuns; ++i)
+    return SLANG_OK;
+}
+
+void IRSerialBodyLoader::_loadBody(Ser::InstIndex rootIndex)
+{
+    const IRSerialData& data = *m_data;
+    IRInst* rootInst = m_insts[Index(rootIndex)];
+
+    // Find all of the instructions in the body
+    List<Index> bodyIndices;
+    {
+        List<Index> stack;
+        stack.add(Index(rootIndex));
+        while (stack.getCount())
         {
-            const auto& run = sourceRuns[i];
+            const Index index = stack.getLast();
+            stack.removeLast();
 
-            // Work out the fixed source location
-            SourceLoc sourceLoc;
-            if (run.m_sourceLoc)
+            const Index runIndex = m_childRunIndices[index];
+            if (runIndex < 0)
             {
-                if (!range.contains(run.m_sourceLoc))
+                continue;
+            }
+            const auto& run = data.m_childRuns[runIndex];
+            for (Index j = 0; j < Index(run.m_numChildren); ++j)
+            {
+                const Index childIndex = Index(run.m_startInstIndex) + j;
+                if (m_rootIndices[childIndex] == rootIndex)
                 {
-                    fix = sourceLocReader->calcFixSourceLoc(run.m_sourceLoc, range);
+                    bodyIndices.add(childIndex);
+                    stack.add(childIndex);
                 }
-                sourceLoc = sourceLocReader->calcFixedLoc(run.m_sourceLoc, fix, range);
             }
+        }
+    }
 
-            // Write to all the instructions
-            SLANG_ASSERT(Index(uint32_t(run.m_startInstIndex) + run.m_numInst) <= insts.getCount());
-            IRInst** dstInsts = insts.getBuffer() + int(run.m_startInstIndex);
+    for (Index index : bodyIndices)
+    {
+        m_insts[index] = _createInst(data.m_insts[index]);
+        SLANG_RELEASE_ASSERT(m_insts[index]);
+        m_rootIndices[index] = Ser::InstIndex(0);
+    }
 
-            const int runSize = int(run.m_numInst);
-            for (int j = 0; j < runSize; ++j)
+    for (Index index : bodyIndices)
+    {
+        // If this references an instruction in another body that has not been loaded, it must be loaded first
+        const Ser::Inst& srcInst = data.m_insts[index];
+        const Ser::InstIndex* srcOperandIndices;
+        const int numOperands = data.getOperands(srcInst, &srcOperandIndices);
+        for (int j = -1; j < numOperands; ++j)
+        {
+            const Ser::InstIndex otherRootIndex = m_rootIndices[Index(j < 0 ? srcInst.m_resultTypeIndex : srcOperandIndices[j])];
+            if (otherRootIndex != Ser::InstIndex(0))
+            {
+                _loadPendingBody(m_insts[Index(otherRootIndex)]);
+            }
+        }
+
+        _patchInst(index);
+
+        if (m_sourceLocs.getCount())
+        {
+            m_insts[index]->sourceLoc = m_sourceLocs[index];
+        }
+    }
+
+    // Add the children. The decorations of the root are already in place and come first.
+    {
+        const auto& run = data.m_childRuns[m_childRunIndices[Index(rootIndex)]];
+        for (Index j = 0; j < Index(run.m_numChildren); ++j)
+        {
+            IRInst* child = m_insts[Index(run.m_startInstIndex) + j];
+            if (child->parent == nullptr)
+            {
+                child->insertAtEnd(rootInst);
+            }
+        }
+    }
+    for (Index index : bodyIndices)
+    {
+        const Index runIndex = m_childRunIndices[index];
+        if (runIndex >= 0)
+        {
+            const auto& run = data.m_childRuns[runIndex];
+            IRInst* inst = m_insts[index];
+            for (Index j = 0; j < Index(run.m_numChildren); ++j)
             {
-                dstInsts[j]->sourceLoc = sourceLoc;
+                m_insts[Index(run.m_startInstIndex) + j]->insertAtEnd(inst);
             }
         }
     }
+}
+
+void IRSerialBodyLoader::_loadPendingBody(IRInst* inst)
+{
+    Ser::InstIndex rootIndex;
+    if (m_pendingBodies.TryGetValue(inst, rootIndex))
+    {
+        m_pendingBodies.Remove(inst);
+        _loadBody(rootIndex);
+    }
+}
+
+void IRSerialBodyLoader::loadBody(IRInst* inst)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    _loadPendingBody(inst);
+}
+
+void IRSerialBodyLoader::loadAllBodies()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    List<IRInst*> pending;
+    for (const auto& pair : m_pendingBodies)
+    {
+        pending.add(pair.Key);
+    }
+    for (IRInst* inst : pending)
+    {
+        _loadPendingBody(inst);
+    }
+}
+
+Result IRSerialReader::read(const IRSerialData& data, Session* session, SerialSourceLocReader* sourceLocReader, RefPtr<IRModule>& outModule)
+{
+    return read(data, session, sourceLocReader, 0, outModule);
+}
+
+Result IRSerialReader::read(const IRSerialData& data, Session* session, SerialSourceLocReader* sourceLocReader, IRSerialReadFlags flags, RefPtr<IRModule>& outModule)
+{
+    m_serialData = &data;
+ 
+    auto module = new IRModule();
+    outModule = module;
+    m_module = module;
+
+    module->session = session;
+
+    RefPtr<IRSerialBodyLoader> loader = new IRSerialBodyLoader;
+    SLANG_RETURN_ON_FAIL(loader->init(data, module, sourceLocReader, (flags & IRSerialReadFlag::LazyBodies) != 0));
+
+    // If anything was deferred, the loader is kept with the module, and needs its own copy of the data
+    if (loader->hasPendingBodies())
+    {
+        loader->takeCopyOfData(data);
+        module->bodyLoader = loader;
+    }
 
     return SLANG_OK;
 }
@@ -73,18 +73,17 @@ struct IRSerialReader
 
         /// Read a module from serial data
     Result read(const IRSerialData& data, Session* session, SerialSourceLocReader* sourceLocReader, RefPtr<IRModule>& outModule);
+        /// Read a module from serial data, with flags controlling how the module is constructed
+    Result read(const IRSerialData& data, Session* session, SerialSourceLocReader* sourceLocReader, IRSerialReadFlags flags, RefPtr<IRModule>& outModule);
 
     IRSerialReader():
         m_serialData(nullptr),
-        m_module(nullptr),
-        m_stringTable(StringSlicePool::Style::Default)
+        m_module(nullptr)
     {
     }
 
     protected:
 
-    StringSlicePool m_stringTable;
-
     const IRSerialData* m_serialData;
     IRModule* m_module;
 };
@@ -47,7 +47,7 @@ SerialSourceLocData::SourceLoc SerialSourceLocWriter::addSourceLoc(SourceLoc sou
     }
 
     // Look up the view it's from
-    SourceView* sourceView = m_sourceManager->findSourceView(sourceLoc);
+    SourceView* sourceView = m_sourceLocResolver.findSourceView(sourceLoc);
     if (!sourceView)
     {
         // If not found we just ingore 
@@ -75,7 +75,7 @@ SerialSourceLocData::SourceLoc SerialSourceLocWriter::addSourceLoc(SourceLoc sou
     // We need to work out the line index
 
     int offset = sourceView->getRange().getOffset(sourceLoc);
-    int lineIndex = sourceFile->calcLineIndexFromOffset(offset);
+    int lineIndex = m_sourceLocResolver.calcLineIndex(sourceView, sourceLoc);
 
     SerialSourceLocData::LineInfo lineInfo;
     lineInfo.m_lineStartOffset = sourceFile->getLineBreakOffsets()[lineIndex];
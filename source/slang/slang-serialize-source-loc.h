@@ -210,12 +210,14 @@ public:
     
     SerialSourceLocWriter(SourceManager* sourceManager):
         m_sourceManager(sourceManager),
+        m_sourceLocResolver(sourceManager, false),
         m_stringSlicePool(StringSlicePool::Style::Default),
         m_freeSourceLoc(1)
     {
     }
 
     SourceManager* m_sourceManager;
+    SourceLocResolver m_sourceLocResolver;         ///< Finds views and lines on m_sourceManager (but not its parents)
     StringSlicePool m_stringSlicePool;             ///< Slices held just for debug usage
     SourceLoc::RawValue m_freeSourceLoc;           ///< Locations greater than this are free
     Dictionary<SourceFile*, RefPtr<Source> > m_sourceFileMap;
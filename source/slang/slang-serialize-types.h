@@ -34,6 +34,16 @@ struct SerialOptionFlag
 };
 typedef SerialOptionFlag::Type SerialOptionFlags;
 
+typedef uint32_t ASTSerialReadFlags;
+struct ASTSerialReadFlag
+{
+    enum Enum : ASTSerialReadFlags
+    {
+            /// The members of modules, types and extensions are only created when first needed (see ASTDeclLoader)
+        LazyMembers = 0x01,
+    };
+};
+
 
 // Compression styles
 
@@ -148,6 +158,47 @@ struct SerialBinary
         uint32_t compressionType;         ///< Holds the compression type used (if used at all)
     };
 
+        /// A serialized standard library. Holds a StdLibHeader, followed by a container for each stdlib module (in load order).
+    static const FourCC kStdLibFourCc = SLANG_FOUR_CC('S', 'L', 's', 'l');
+        /// StdLibHeader
+    static const FourCC kStdLibHeaderFourCc = SLANG_FOUR_CC('S', 's', 'h', 'd');
+
+    struct StdLibHeader
+    {
+            /// The version of the stdlib serialized format. 
+            /// Should be changed whenever the format, or the representation of the contents (AST/IR) changes
+            ///
+            /// 2.0.0 - IR function bodies can be read on demand, and AST modules hold an exports chunk
+        static RiffSemanticVersion getCurrentVersion() { return RiffSemanticVersion::make(2, 0, 0); }
+
+        uint32_t semanticVersion;           ///< The RiffSemanticVersion raw value
+        uint32_t pad;                       ///< Padding, set to 0
+        uint64_t sourceHash;                ///< Session::getStdLibSourceHash of the compiler that produced it
+    };
+
+        /// ModuleHeader. Precedes the chunks of a module in a container's module list.
+        /// In the chunk the header is followed by dependencyCount ModuleFileDependency entries.
+    static const FourCC kModuleHeaderFourCc = SLANG_FOUR_CC('S', 'm', 'h', 'd');
+
+    struct ModuleHeader
+    {
+            /// The version of the serialized module format.
+            /// Should be changed whenever the format, or the representation of the contents (AST/IR) changes
+        static RiffSemanticVersion getCurrentVersion() { return RiffSemanticVersion::make(2, 0, 0); }
+
+        uint32_t semanticVersion = 0;       ///< The RiffSemanticVersion raw value. 0 if the module has no header.
+        uint32_t dependencyCount = 0;       ///< The number of ModuleFileDependency entries following the header
+        uint64_t stdLibSourceHash = 0;      ///< Session::getStdLibSourceHash of the compiler that produced the module
+    };
+
+        /// A file the module was compiled from. The first is the source file of the module.
+    struct ModuleFileDependency
+    {
+        uint64_t contentsHash;              ///< Hash of the contents of the file (see SerialContainerUtil::calcFileContentsHash)
+        uint32_t pathSize;                  ///< The size of the path in bytes. The path follows, without a terminating 0, padded to 4 bytes.
+        uint32_t pad;                       ///< Padding, set to 0
+    };
+
     struct ArrayHeader
     {
         uint32_t numEntries;
@@ -84,6 +84,22 @@ const SerialClass* SerialClasses::addUnserialized(SerialTypeKind kind, SerialSub
     return dst;
 }
 
+const SerialField* SerialClasses::findField(SerialTypeKind typeKind, SerialSubType subType, const char* name) const
+{
+    const SerialClass* cls = getSerialClass(typeKind, subType);
+    if (cls)
+    {
+        for (Index i = 0; i < cls->fieldsCount; ++i)
+        {
+            if (::strcmp(cls->fields[i].name, name) == 0)
+            {
+                return &cls->fields[i];
+            }
+        }
+    }
+    return nullptr;
+}
+
 bool SerialClasses::isOwned(const SerialClass* cls) const
 {
     const List<const SerialClass*>& classes = m_classesByTypeKind[Index(cls->typeKind)];
@@ -690,6 +706,12 @@ SerialPointer SerialReader::getPointer(SerialIndex index)
     SLANG_ASSERT(SerialIndexRaw(index) < SerialIndexRaw(m_entries.getCount()));
     const Entry* entry = m_entries[Index(index)];
 
+    if (m_onDemandHandler && !m_objects[Index(index)] &&
+        (entry->typeKind == SerialTypeKind::NodeBase || entry->typeKind == SerialTypeKind::RefObject))
+    {
+        _constructOnDemand(Index(index));
+    }
+
     const SerialPointer& ptr = m_objects[Index(index)];
 
     switch (entry->typeKind)
@@ -916,58 +938,127 @@ SlangResult SerialReader::constructObjects(NamePool* namePool)
     return SLANG_OK;
 }
 
-SlangResult SerialReader::deserializeObjects()
+SlangResult SerialReader::_deserializeObject(Index index)
 {
-    // Deserialize
-    for (Index i = 1; i < m_entries.getCount(); ++i)
+    const Entry* entry = m_entries[index];
+    const SerialPointer& dstPtr = m_objects[index];
+
+    switch (entry->typeKind)
     {
-        const Entry* entry = m_entries[i];
-        // First see if there is anything to construct
-        SerialPointer& dstPtr = m_objects[i];
-        if (!dstPtr)
-        {
-            continue;
-        }
-        switch (entry->typeKind)
+        case SerialTypeKind::NodeBase:
+        case SerialTypeKind::RefObject:
         {
-            case SerialTypeKind::NodeBase:
-            case SerialTypeKind::RefObject:
+            auto objectEntry = static_cast<const SerialInfo::ObjectEntry*>(entry);
+            auto serialClass = m_classes->getSerialClass(objectEntry->typeKind, objectEntry->subType);
+            if (!serialClass)
             {
-                auto objectEntry = static_cast<const SerialInfo::ObjectEntry*>(entry);
-                auto serialClass = m_classes->getSerialClass(objectEntry->typeKind, objectEntry->subType);
-                if (!serialClass)
-                {
-                    return SLANG_FAIL;
-                }
+                return SLANG_FAIL;
+            }
+
+            const uint8_t* src = (const uint8_t*)(objectEntry + 1);
+            uint8_t* dst = (uint8_t*)dstPtr.m_ptr;
 
-                const uint8_t* src = (const uint8_t*)(objectEntry + 1);
-                uint8_t* dst = (uint8_t*)dstPtr.m_ptr;
+            // It must be constructed
+            SLANG_ASSERT(dst);
 
-                // It must be constructed
-                SLANG_ASSERT(dst);
+            // Fields are only deferred when deserializing on demand
+            const Index deferredFieldsCount = m_onDemandHandler ? m_deferredFields.getCount() : 0;
 
-                while (serialClass)
+            while (serialClass)
+            {
+                for (Index j = 0; j < serialClass->fieldsCount; ++j)
                 {
-                    for (Index j = 0; j < serialClass->fieldsCount; ++j)
+                    const SerialField* field = &serialClass->fields[j];
+
+                    if (deferredFieldsCount && m_deferredFields.contains(field))
                     {
-                        auto field = serialClass->fields[j];
-                        auto fieldType = field.type;
-                        fieldType->toNativeFunc(this, src + field.serialOffset, dst + field.nativeOffset);
+                        m_onDemandHandler->deferField(this, SerialIndex(index), field, src + field->serialOffset);
+                        continue;
                     }
 
-                    // Get the super class
-                    serialClass = serialClass->super;
+                    field->type->toNativeFunc(this, src + field->serialOffset, dst + field->nativeOffset);
                 }
 
-                break;
+                // Get the super class
+                serialClass = serialClass->super;
             }
-            default: break;
+
+            break;
         }
+        default: break;
     }
 
     return SLANG_OK;
 }
 
+SlangResult SerialReader::deserializeObjects()
+{
+    // Deserialize
+    for (Index i = 1; i < m_entries.getCount(); ++i)
+    {
+        // First see if there is anything to construct
+        if (!m_objects[i])
+        {
+            continue;
+        }
+        SLANG_RETURN_ON_FAIL(_deserializeObject(i));
+    }
+
+    return SLANG_OK;
+}
+
+void SerialReader::prepareOnDemand(NamePool* namePool, SerialOnDemandHandler* handler)
+{
+    m_namePool = namePool;
+    m_onDemandHandler = handler;
+
+    m_objects.clearAndDeallocate();
+    m_objects.setCount(m_entries.getCount());
+    memset(m_objects.getBuffer(), 0, m_objects.getCount() * sizeof(SerialPointer));
+}
+
+void SerialReader::_constructOnDemand(Index index)
+{
+    auto objectEntry = static_cast<const SerialInfo::ObjectEntry*>(m_entries[index]);
+
+    void* obj = m_objectFactory->create(objectEntry->typeKind, objectEntry->subType);
+    SLANG_ASSERT(obj);
+    if (!obj)
+    {
+        return;
+    }
+
+    // The object is set before its fields are deserialized, so that references back to it (such as to a
+    // parent) find it rather than constructing it again
+    m_objects[index].set(objectEntry->typeKind, obj);
+
+    SlangResult res = _deserializeObject(index);
+    SLANG_ASSERT(SLANG_SUCCEEDED(res));
+    SLANG_UNUSED(res);
+
+    m_onDemandHandler->objectDeserialized(this, SerialIndex(index), m_objects[index]);
+}
+
+const SerialInfo::ObjectEntry* SerialReader::getObjectEntry(SerialIndex index) const
+{
+    if (index == SerialIndex(0) || SerialIndexRaw(index) >= SerialIndexRaw(m_entries.getCount()))
+    {
+        return nullptr;
+    }
+    const Entry* entry = m_entries[Index(index)];
+    if (entry->typeKind == SerialTypeKind::NodeBase || entry->typeKind == SerialTypeKind::RefObject)
+    {
+        return static_cast<const SerialInfo::ObjectEntry*>(entry);
+    }
+    return nullptr;
+}
+
+const void* SerialReader::getSerialField(SerialIndex index, const SerialField* field) const
+{
+    auto objectEntry = getObjectEntry(index);
+    SLANG_ASSERT(objectEntry);
+    return objectEntry ? (const uint8_t*)(objectEntry + 1) + field->serialOffset : nullptr;
+}
 
 SlangResult SerialReader::load(const uint8_t* data, size_t dataCount, NamePool* namePool)
 {
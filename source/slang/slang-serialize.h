@@ -211,6 +211,18 @@ protected:
    void* m_objects[Index(SerialExtraType::CountOf)];
 };
 
+/* Used by a SerialReader that deserializes objects on demand (see SerialReader::prepareOnDemand), to let the code
+that owns the objects take part */
+class SerialOnDemandHandler
+{
+public:
+        /// Called instead of deserializing a field added with SerialReader::addDeferredField.
+        /// serial points to the serialized field data of the object at objectIndex.
+    virtual void deferField(SerialReader* reader, SerialIndex objectIndex, const SerialField* field, const void* serial) = 0;
+        /// Called once the object at objectIndex has been constructed and all of its (not deferred) fields deserialized
+    virtual void objectDeserialized(SerialReader* reader, SerialIndex objectIndex, const SerialPointer& ptr) = 0;
+};
+
 /* This class is the interface used by toNative implementations to recreate a type. */
 class SerialReader : public RefObject
 {
@@ -237,6 +249,19 @@ public:
         /// NOTE! data must stay ins scope when reading takes place
     SlangResult load(const uint8_t* data, size_t dataCount, NamePool* namePool);
 
+        /// Instead of constructing and deserializing all objects up front, an object is constructed and deserialized
+        /// the first time it is accessed through getPointer. Entries must be loaded (with loadEntries) first.
+        /// NOTE! The data must stay in scope for as long as objects can be deserialized.
+    void prepareOnDemand(NamePool* namePool, SerialOnDemandHandler* handler);
+        /// When deserializing on demand, don't deserialize field (the handler is told about it instead)
+    void addDeferredField(const SerialField* field) { m_deferredFields.add(field); }
+
+        /// Get the object entry at index, or nullptr if it isn't an object. Doesn't construct the object.
+    const SerialInfo::ObjectEntry* getObjectEntry(SerialIndex index) const;
+        /// Get the serialized data of field in the object at index, without deserializing the object.
+        /// The field must be a field of the object's class (or one of its super classes).
+    const void* getSerialField(SerialIndex index, const SerialField* field) const;
+
         /// Get the entries list
     const List<const Entry*>& getEntries() const { return m_entries; }
 
@@ -266,6 +291,9 @@ public:
     static SlangResult loadEntries(const uint8_t* data, size_t dataCount, SerialClasses* serialClasses, List<const Entry*>& outEntries);
 
 protected:
+    SlangResult _deserializeObject(Index index);
+    void _constructOnDemand(Index index);
+
     List<const Entry*> m_entries;       ///< The entries
 
     List<SerialPointer> m_objects;      ///< The constructed objects
@@ -277,6 +305,9 @@ protected:
 
     SerialObjectFactory* m_objectFactory;
     SerialClasses* m_classes;           ///< Information used to deserialize 
+
+    SerialOnDemandHandler* m_onDemandHandler = nullptr;     ///< Set if objects are deserialized on demand
+    List<const SerialField*> m_deferredFields;              ///< Fields not deserialized when deserializing on demand
 };
 
 // ---------------------------------------------------------------------------
@@ -512,6 +543,12 @@ public:
         const auto& classes = m_classesByTypeKind[Index(typeKind)];
         return (subType < classes.getCount()) ? classes[subType] : nullptr;
     }
+        /// Find the field called name in the class identified by typeKind/subType (not including its super classes).
+        /// Returns nullptr if not found.
+    const SerialField* findField(SerialTypeKind typeKind, SerialSubType subType, const char* name) const;
+
+        /// Get all of the serial classes of typeKind, indexed by subType. Entries can be nullptr.
+    const List<const SerialClass*>& getSerialClasses(SerialTypeKind typeKind) const { return m_classesByTypeKind[Index(typeKind)]; }
     
         /// Ctor
     SerialClasses();
@@ -118,12 +118,16 @@ void SourceView::addDefaultLineDirective(SourceLoc directiveLoc)
 }
 
 HumaneSourceLoc SourceView::getHumaneLoc(SourceLoc loc, SourceLocType type)
+{
+    // We need the line index from the original source file
+    const int lineIndex = m_sourceFile->calcLineIndexFromOffset(m_range.getOffset(loc));
+    return getHumaneLoc(loc, lineIndex, type);
+}
+
+HumaneSourceLoc SourceView::getHumaneLoc(SourceLoc loc, int lineIndex, SourceLocType type)
 {
     const int offset = m_range.getOffset(loc);
 
-    // We need the line index from the original source file
-    const int lineIndex = m_sourceFile->calcLineIndexFromOffset(offset);
-    
     // TODO: we should really translate the byte index in the line
     // to deal with:
     //
@@ -198,6 +202,7 @@ PathInfo SourceView::getPathInfo(SourceLoc loc, SourceLocType type)
 
 void SourceFile::setLineBreakOffsets(const uint32_t* offsets, UInt numOffsets)
 {
+    std::lock_guard<std::mutex> lock(m_lineBreakOffsetsMutex);
     m_lineBreakOffsets.clear();
     m_lineBreakOffsets.addRange(offsets, numOffsets);
 }
@@ -207,14 +212,10 @@ const List<uint32_t>& SourceFile::getLineBreakOffsets()
     // We now have a raw input file that we can search for line breaks.
     // We obviously don't want to do a linear scan over and over, so we will
     // cache an array of line break locations in the file.
+    std::lock_guard<std::mutex> lock(m_lineBreakOffsetsMutex);
     if (m_lineBreakOffsets.getCount() == 0)
     {
-        UnownedStringSlice content(getContent()), line;
-        char const* contentBegin = content.begin();
-        while (StringUtil::extractLine(content, line))
-        {
-            m_lineBreakOffsets.add(uint32_t(line.begin() - contentBegin));
-        }
+        StringUtil::calcLineStartOffsets(getContent(), m_lineBreakOffsets);
         // Note that we do *not* treat the end of the file as a line
         // break, because otherwise we would report errors like
         // "end of file inside string literal" with a line number
@@ -254,6 +255,48 @@ int SourceFile::calcLineIndexFromOffset(int offset)
     return int(lo);
 }
 
+int SourceFile::calcLineIndexFromOffset(int offset, int hintLineIndex)
+{
+    SLANG_ASSERT(UInt(offset) <= getContentSize());
+
+    const auto& lineBreakOffsets = getLineBreakOffsets();
+    const Index count = lineBreakOffsets.getCount();
+
+    if (hintLineIndex < 0 || hintLineIndex >= count || lineBreakOffsets[hintLineIndex] > uint32_t(offset))
+    {
+        return calcLineIndexFromOffset(offset);
+    }
+
+    // Nearby lines are checked linearly
+    enum { kMaxWalkCount = 8 };
+    Index lo = hintLineIndex;
+    const Index walkEnd = (lo + kMaxWalkCount < count) ? lo + kMaxWalkCount : count;
+    while (lo + 1 < walkEnd && lineBreakOffsets[lo + 1] <= uint32_t(offset))
+    {
+        lo++;
+    }
+    if (lo + 1 < walkEnd || walkEnd == count)
+    {
+        return int(lo);
+    }
+
+    // Binary search the lines after
+    Index hi = count;
+    while (lo + 1 < hi)
+    {
+        const Index mid = (hi + lo) >> 1;
+        if (lineBreakOffsets[mid] <= uint32_t(offset))
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return int(lo);
+}
+
 int SourceFile::calcColumnIndex(int lineIndex, int offset)
 {
     const auto& lineBreakOffsets = getLineBreakOffsets();
@@ -569,6 +612,15 @@ HumaneSourceLoc SourceManager::getHumaneLoc(SourceLoc loc, SourceLocType type)
     }
 }
 
+void SourceManager::getHumaneLocs(const SourceLoc* locs, Index count, SourceLocType type, HumaneSourceLoc* outLocs)
+{
+    SourceLocResolver resolver(this);
+    for (Index i = 0; i < count; ++i)
+    {
+        outLocs[i] = resolver.getHumaneLoc(locs[i], type);
+    }
+}
+
 PathInfo SourceManager::getPathInfo(SourceLoc loc, SourceLocType type)
 {
     SourceView* sourceView = findSourceViewRecursively(loc);
@@ -582,4 +634,46 @@ PathInfo SourceManager::getPathInfo(SourceLoc loc, SourceLocType type)
     }
 }
 
+/* !!!!!!!!!!!!!!!!!!!!!!!!! SourceLocResolver !!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+SourceView* SourceLocResolver::findSourceView(SourceLoc loc)
+{
+    if (m_view && m_view->getRange().contains(loc))
+    {
+        return m_view;
+    }
+
+    SourceView* view = m_isRecursive ? m_sourceManager->findSourceViewRecursively(loc) : m_sourceManager->findSourceView(loc);
+    if (view)
+    {
+        m_view = view;
+    }
+    return view;
+}
+
+int SourceLocResolver::calcLineIndex(SourceView* view, SourceLoc loc)
+{
+    SourceFile* sourceFile = view->getSourceFile();
+    const int offset = view->getRange().getOffset(loc);
+
+    // The line of the previous lookup is only a useful starting point if it's in the same file
+    const int lineIndex = (sourceFile == m_lineSourceFile) ?
+        sourceFile->calcLineIndexFromOffset(offset, m_lineIndex) :
+        sourceFile->calcLineIndexFromOffset(offset);
+
+    m_lineSourceFile = sourceFile;
+    m_lineIndex = lineIndex;
+    return lineIndex;
+}
+
+HumaneSourceLoc SourceLocResolver::getHumaneLoc(SourceLoc loc, SourceLocType type)
+{
+    SourceView* view = findSourceView(loc);
+    if (!view)
+    {
+        return HumaneSourceLoc();
+    }
+    return view->getHumaneLoc(loc, calcLineIndex(view, loc), type);
+}
+
 } // namespace Slang
@@ -9,6 +9,8 @@
 #include "../../slang-com-ptr.h"
 #include "../../slang.h"
 
+#include <mutex>
+
 namespace Slang {
 
 /** Overview: 
@@ -158,7 +160,8 @@ class SourceFile
 public:
 
         /// Returns the line break offsets (in bytes from start of content)
-        /// Note that this is lazily evaluated - the line breaks are only calculated on the first request 
+        /// Note that this is lazily evaluated - the line breaks are only calculated on the first request.
+        /// Can be called from multiple threads.
     const List<uint32_t>& getLineBreakOffsets();
 
         /// Set the line break offsets
@@ -166,6 +169,9 @@ public:
 
         /// Calculate the line based on the offset 
     int calcLineIndexFromOffset(int offset);
+        /// Calculate the line based on the offset, searching forward from hintLineIndex first (such as the line of the previous lookup).
+        /// Looking up offsets in increasing order is then a short walk forward rather than a search of all lines.
+    int calcLineIndexFromOffset(int offset, int hintLineIndex);
 
         /// Calculate the offset for a line
     int calcColumnIndex(int line, int offset);
@@ -213,6 +219,9 @@ public:
     // we will cache the starting offset of each line break in
     // the input file:
     List<uint32_t> m_lineBreakOffsets;
+
+    // Source files (such as the stdlib's) can be used for diagnostics on multiple threads
+    std::mutex m_lineBreakOffsetsMutex;
 };
 
 enum class SourceLocType
@@ -285,6 +294,8 @@ class SourceView
         /// Get the humane location 
         /// Type determines if the location wanted is the original, or the 'normal' (which modifys behavior based on #line directives)
     HumaneSourceLoc getHumaneLoc(SourceLoc loc, SourceLocType type = SourceLocType::Nominal);
+        /// Get the humane location, where lineIndex is the (already calculated) line index of loc in the source file
+    HumaneSourceLoc getHumaneLoc(SourceLoc loc, int lineIndex, SourceLocType type);
 
         /// Get the path associated with a location
     PathInfo getPathInfo(SourceLoc loc, SourceLocType type = SourceLocType::Nominal);
@@ -339,6 +350,9 @@ struct SourceManager
 
         /// Get the humane source location
     HumaneSourceLoc getHumaneLoc(SourceLoc loc, SourceLocType type = SourceLocType::Nominal);
+        /// Get the humane source location of each of locs in outLocs. If locs are in increasing order (as are the
+        /// locations of code in source order), all of the lookups together take a single pass over the views and lines.
+    void getHumaneLocs(const SourceLoc* locs, Index count, SourceLocType type, HumaneSourceLoc* outLocs);
 
         /// Get the path associated with a location 
     PathInfo getPathInfo(SourceLoc loc, SourceLocType type = SourceLocType::Nominal);
@@ -435,6 +449,38 @@ struct SourceManager
     ComPtr<ISlangFileSystemExt> m_fileSystemExt;
 };
 
+/* Looks up source locations on a SourceManager, remembering the view and line of the previous lookup.
+
+When locations are looked up in increasing order - as happens when emitting or serializing code in source order -
+each lookup is a short walk forward from the previous one, rather than a search of all the views and lines.
+Lookups in any order give the same results as the equivalent SourceManager methods. */
+class SourceLocResolver
+{
+public:
+        /// Find the view that contains loc. Returns nullptr if not found.
+    SourceView* findSourceView(SourceLoc loc);
+        /// Calculate the line index of loc in the source file of view (which must contain loc)
+    int calcLineIndex(SourceView* view, SourceLoc loc);
+
+        /// Get the humane source location. Same as SourceManager::getHumaneLoc.
+    HumaneSourceLoc getHumaneLoc(SourceLoc loc, SourceLocType type = SourceLocType::Nominal);
+
+        /// Ctor. If isRecursive views are also found on the parent managers (as with findSourceViewRecursively)
+    SourceLocResolver(SourceManager* sourceManager, bool isRecursive = true):
+        m_sourceManager(sourceManager),
+        m_isRecursive(isRecursive)
+    {
+    }
+
+protected:
+    SourceManager* m_sourceManager;
+    bool m_isRecursive;
+
+    SourceView* m_view = nullptr;               ///< The view found by the previous lookup
+    SourceFile* m_lineSourceFile = nullptr;     ///< The source file of the previous line lookup
+    int m_lineIndex = 0;                        ///< The line index of the previous line lookup
+};
+
 } // namespace Slang
 
 #endif
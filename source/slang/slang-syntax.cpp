@@ -429,12 +429,10 @@ Index getFilterCountImpl(const ReflectClassInfo& clsInfo, MemberFilterStyle filt
 
     // TODO: need to figure out how to unify this with the logic
     // in the generic case...
-    DeclRefType* DeclRefType::create(
+    static DeclRefType* _createDeclRefType(
         ASTBuilder*     astBuilder,
         DeclRef<Decl>   declRef)
     {
-        declRef = createDefaultSubstitutionsIfNeeded(astBuilder, declRef);
-
         if (auto builtinMod = declRef.getDecl()->findModifier<BuiltinTypeModifier>())
         {
             auto type = astBuilder->create<BasicExpressionType>(builtinMod->tag);
@@ -602,6 +600,28 @@ Index getFilterCountImpl(const ReflectClassInfo& clsInfo, MemberFilterStyle filt
         }
     }
 
+    DeclRefType* DeclRefType::create(
+        ASTBuilder*     astBuilder,
+        DeclRef<Decl>   declRef)
+    {
+        declRef = createDefaultSubstitutionsIfNeeded(astBuilder, declRef);
+
+        // The same declRef always produces the same (immutable) type, so reuse it if it's
+        // already been created
+        ValKey key(ASTNodeType::DeclRefType);
+        key.addDeclRef(declRef);
+
+        ASTBuilder::SharedLock lock(astBuilder);
+        if (auto type = astBuilder->findInterned<DeclRefType>(key))
+        {
+            return type;
+        }
+
+        DeclRefType* type = _createDeclRefType(astBuilder, declRef);
+        astBuilder->addInterned(key, type);
+        return type;
+    }
+
     //
 
     GenericSubstitution* findInnerMostGenericSubstitution(Substitutions* subst)
@@ -1130,19 +1150,14 @@ Index getFilterCountImpl(const ReflectClassInfo& clsInfo, MemberFilterStyle filt
         Type* elementType,
         IntVal*         elementCount)
     {
-        auto arrayType = astBuilder->create<ArrayExpressionType>();
-        arrayType->baseType = elementType;
-        arrayType->arrayLength = elementCount;
-        return arrayType;
+        return astBuilder->getArrayType(elementType, elementCount);
     }
 
     ArrayExpressionType* getArrayType(
         ASTBuilder* astBuilder,
         Type* elementType)
     {
-        auto arrayType = astBuilder->create<ArrayExpressionType>();
-        arrayType->baseType = elementType;
-        return arrayType;
+        return astBuilder->getArrayType(elementType, nullptr);
     }
 
     NamedExpressionType* getNamedType(
@@ -1151,7 +1166,18 @@ Index getFilterCountImpl(const ReflectClassInfo& clsInfo, MemberFilterStyle filt
     {
         DeclRef<TypeDefDecl> specializedDeclRef = createDefaultSubstitutionsIfNeeded(astBuilder, declRef).as<TypeDefDecl>();
 
-        return astBuilder->create<NamedExpressionType>(specializedDeclRef);
+        ValKey key(ASTNodeType::NamedExpressionType);
+        key.addDeclRef(specializedDeclRef);
+
+        ASTBuilder::SharedLock lock(astBuilder);
+        if (auto namedType = astBuilder->findInterned<NamedExpressionType>(key))
+        {
+            return namedType;
+        }
+
+        auto namedType = astBuilder->create<NamedExpressionType>(specializedDeclRef);
+        astBuilder->addInterned(key, namedType);
+        return namedType;
     }
 
     
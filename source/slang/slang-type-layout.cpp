@@ -2593,6 +2593,15 @@ static TypeLayoutResult _createTypeLayout(
     TypeLayoutContext const&    context,
     Type*                       type);
 
+    /// Record that the layout being computed depends on more than the type and rules
+static void _markContextDependent(TypeLayoutContext const& context)
+{
+    if (context.targetReq)
+    {
+        context.targetReq->getTypeLayoutCache()->markContextDependent();
+    }
+}
+
     /// Create layout information for the given `type`, obeying any layout modifiers on the given declaration.
     ///
     /// If `declForModifiers` has any matrix layout modifiers associated with it, then
@@ -2635,6 +2644,9 @@ Type* findGlobalGenericSpecializationArg(
     TypeLayoutContext const&    context,
     GlobalGenericParamDecl*     decl)
 {
+    // The layout depends on the program being laid out
+    _markContextDependent(context);
+
     Val* arg = nullptr;
     context.programLayout->globalGenericArgs.TryGetValue(decl, arg);
     return as<Type>(arg);
@@ -3118,6 +3130,8 @@ static TypeLayoutResult _createTypeLayoutForGlobalGenericTypeParam(
     Type*                       type,
     GlobalGenericParamDecl*     globalGenericParamDecl)
 {
+    _markContextDependent(context);
+
     SimpleLayoutInfo info;
     info.alignment = 0;
     info.size = 0;
@@ -3144,7 +3158,7 @@ RefPtr<TypeLayout> createTypeLayoutForGlobalGenericTypeParam(
     return _createTypeLayoutForGlobalGenericTypeParam(context, type, globalGenericParamDecl).layout;
 }
 
-static TypeLayoutResult _createTypeLayout(
+static TypeLayoutResult _createTypeLayoutImpl(
     TypeLayoutContext const&    context,
     Type*                       type)
 {
@@ -4205,6 +4219,106 @@ RefPtr<TypeLayout> getSimpleVaryingParameterTypeLayout(
         rules).layout;
 }
 
+//
+// TypeLayoutCache
+//
+
+HashCode TypeLayoutCache::Key::getHashCode() const
+{
+    Hasher hasher;
+    hasher.hashObject(type);
+    hasher.hashValue(rules);
+    hasher.hashValue(int(matrixLayoutMode));
+    hasher.hashValue(targetFlags);
+    hasher.hashValue(profile.raw);
+    return hasher.getResult();
+}
+
+bool TypeLayoutCache::Key::operator==(const Key& rhs) const
+{
+    return rules == rhs.rules &&
+        matrixLayoutMode == rhs.matrixLayoutMode &&
+        targetFlags == rhs.targetFlags &&
+        profile == rhs.profile &&
+        (type == rhs.type || type->equals(rhs.type));
+}
+
+void TypeLayoutCache::_releaseIfStale()
+{
+    const Index releasedModuleCount = m_releasedModuleCounter->getCount();
+    if (releasedModuleCount != m_releasedModuleCount)
+    {
+        if (m_layouts.Count())
+        {
+            m_layouts.Clear();
+            m_stats.releaseCount++;
+        }
+        m_releasedModuleCount = releasedModuleCount;
+    }
+}
+
+TypeLayoutResult* TypeLayoutCache::find(const Key& key)
+{
+    _releaseIfStale();
+
+    TypeLayoutResult* result = m_layouts.TryGetValue(key);
+    if (result)
+    {
+        m_stats.hitCount++;
+    }
+    return result;
+}
+
+void TypeLayoutCache::add(const Key& key, const TypeLayoutResult& result)
+{
+    _releaseIfStale();
+
+    m_stats.missCount++;
+    m_layouts[key] = result;
+}
+
+static TypeLayoutResult _createTypeLayout(
+    TypeLayoutContext const&    context,
+    Type*                       type)
+{
+    // The layout of an existential type can depend on the specialization
+    // arguments, so those are always computed.
+    //
+    if (!context.targetReq || context.specializationArgCount)
+    {
+        return _createTypeLayoutImpl(context, type);
+    }
+
+    TypeLayoutCache* cache = context.targetReq->getTypeLayoutCache();
+
+    TypeLayoutCache::Key key;
+    key.type = type->getCanonicalType();
+    key.rules = context.rules;
+    key.matrixLayoutMode = context.matrixLayoutMode;
+    key.targetFlags = context.targetReq->getTargetFlags();
+    key.profile = context.targetReq->getTargetProfile();
+
+    if (TypeLayoutResult* found = cache->find(key))
+    {
+        return *found;
+    }
+
+    // If anything used in computing the layout depended on the program
+    // (such as a global generic parameter) the layout can't be reused.
+    //
+    const Index contextDependentCount = cache->getContextDependentCount();
+    TypeLayoutResult result = _createTypeLayoutImpl(context, type);
+    if (cache->getContextDependentCount() == contextDependentCount)
+    {
+        cache->add(key, result);
+    }
+    else
+    {
+        cache->addUncached();
+    }
+    return result;
+}
+
 RefPtr<TypeLayout> createTypeLayout(
     TypeLayoutContext const&    context,
     Type*                       type)
@@ -1057,6 +1057,81 @@ struct TypeLayoutResult
     {}
 };
 
+    /// Holds the type layouts computed for a target, so that laying out the
+    /// same type again (for another parameter, entry point or reflection query)
+    /// doesn't repeat the work.
+    ///
+    /// Layouts are keyed by the canonical type, the layout rules and the matrix
+    /// layout mode. A layout that also depends on the program (through a global
+    /// generic parameter) or on specialization arguments is not held.
+    ///
+    /// The layouts handed out are shared, so they must not be modified once they
+    /// have been created.
+    ///
+    /// Layouts are also keyed by the target flags and profile, as those can be changed
+    /// after layouts have been computed.
+    ///
+    /// The types in the keys (and referenced by the layouts) are owned by the linkage
+    /// and its modules - some of which can be released before the target is, such as
+    /// the modules of a compile request made on a session. A type doesn't know which
+    /// module owns it, so all of the layouts are released whenever a module of the
+    /// linkage is.
+class TypeLayoutCache : public RefObject
+{
+public:
+    struct Key
+    {
+        HashCode getHashCode() const;
+        bool operator==(const Key& rhs) const;
+
+        Type*               type = nullptr;
+        LayoutRulesImpl*    rules = nullptr;
+        MatrixLayoutMode    matrixLayoutMode = kMatrixLayoutMode_ColumnMajor;
+        SlangTargetFlags    targetFlags = 0;
+        Profile             profile;
+    };
+
+    struct Stats
+    {
+        uint64_t hitCount = 0;          ///< Layouts found in the cache
+        uint64_t missCount = 0;         ///< Layouts that had to be computed, and were added
+        uint64_t uncachedCount = 0;     ///< Layouts that had to be computed, but depend on more than the key
+        uint64_t releaseCount = 0;      ///< Times the held layouts were released, because a module of the linkage was released
+    };
+
+        /// Ctor. releasedModuleCounter counts the released modules of the linkage the types come from.
+    TypeLayoutCache(ReleasedModuleCounter* releasedModuleCounter) : m_releasedModuleCounter(releasedModuleCounter) {}
+
+        /// Find the layout for the key, or nullptr if there isn't one
+    TypeLayoutResult* find(const Key& key);
+        /// Add the layout for the key
+    void add(const Key& key, const TypeLayoutResult& result);
+
+        /// Record that a layout being computed depends on the program or specialization arguments.
+        /// Any layout being computed at the time won't be added.
+    void markContextDependent() { m_contextDependentCount++; }
+        /// Changes if any layout computed since the last call is context dependent
+    Index getContextDependentCount() const { return m_contextDependentCount; }
+
+        /// Record a layout computed that wasn't added, because it was context dependent
+    void addUncached() { m_stats.uncachedCount++; }
+
+    const Stats& getStats() const { return m_stats; }
+        /// The amount of layouts held
+    Index getCount() const { return Index(m_layouts.Count()); }
+
+protected:
+        /// Release the held layouts if a module of the linkage has been released since they were added
+    void _releaseIfStale();
+
+    Dictionary<Key, TypeLayoutResult> m_layouts;
+    Index m_contextDependentCount = 0;
+    RefPtr<ReleasedModuleCounter> m_releasedModuleCounter;
+        /// The count of released modules when the layouts held were checked
+    Index m_releasedModuleCount = 0;
+    Stats m_stats;
+};
+
     /// Helper type for building `struct` type layouts
 struct StructTypeLayoutBuilder
 {
@@ -1157,6 +1232,9 @@ RefPtr<TypeLayout> getSimpleVaryingParameterTypeLayout(
 
 // Create a full type-layout object for a type,
 // according to the layout rules in `context`.
+//
+// The layout may be shared with other uses of the type
+// (see `TypeLayoutCache`), so must not be modified.
 RefPtr<TypeLayout> createTypeLayout(
     TypeLayoutContext const&    context,
     Type*                       type);
@@ -7,6 +7,7 @@
 
 #include "slang-check.h"
 #include "slang-parameter-binding.h"
+#include "slang-lookup.h"
 #include "slang-lower-to-ir.h"
 #include "slang-mangle.h"
 #include "slang-parser.h"
@@ -27,6 +28,7 @@
 #include "slang-serialize-ast.h"
 #include "slang-serialize-ir.h"
 #include "slang-serialize-container.h"
+#include "slang-serialize-factory.h"
 
 #include "slang-check-impl.h"
 
@@ -45,6 +47,11 @@ extern Slang::String get_slang_cuda_prelude();
 extern Slang::String get_slang_cpp_prelude();
 extern Slang::String get_slang_hlsl_prelude();
 
+#ifdef SLANG_EMBED_STDLIB
+// Produced by `slang-embed -binary` from the serialized stdlib (see `embed-stdlib` in premake5.lua)
+extern const void* get_slang_stdlib(size_t* outSize);
+#endif
+
 namespace Slang {
 
 /* static */const BaseTypeInfo BaseTypeInfo::s_info[Index(BaseType::CountOf)] = 
@@ -174,141 +181,294 @@ void Session::init()
     slangLanguageScope = new Scope();
     slangLanguageScope->nextSibling = hlslLanguageScope;
 
-    if (false)
     {
-        // Let's try loading serialized modules and adding them
-        _readBuiltinModule(coreLanguageScope, "core");
-        _readBuiltinModule(hlslLanguageScope, "hlsl");
+        for (Index i = 0; i < Index(SourceLanguage::CountOf); ++i)
+        {
+            m_defaultDownstreamCompilers[i] = PassThroughMode::None;
+        }
+        m_defaultDownstreamCompilers[Index(SourceLanguage::C)] = PassThroughMode::GenericCCpp;
+        m_defaultDownstreamCompilers[Index(SourceLanguage::CPP)] = PassThroughMode::GenericCCpp;
+        m_defaultDownstreamCompilers[Index(SourceLanguage::CUDA)] = PassThroughMode::NVRTC;
+    }
+
+    // Set up default prelude code for target languages that need a prelude
+    m_languagePreludes[Index(SourceLanguage::CUDA)] = get_slang_cuda_prelude();
+    m_languagePreludes[Index(SourceLanguage::CPP)] = get_slang_cpp_prelude();
+    m_languagePreludes[Index(SourceLanguage::HLSL)] = get_slang_hlsl_prelude();
+}
+
+void Session::_addBuiltinModule(Scope* scope, Name* moduleName, Module* module)
+{
+    // Put in the loaded module map
+    m_builtinLinkage->mapNameToLoadedModules.Add(moduleName, module);
+
+    // Add the resulting code to the appropriate scope
+    if (!scope->containerDecl)
+    {
+        // We are the first chunk of code to be loaded for this scope
+        scope->containerDecl = module->getModuleDecl();
     }
     else
     {
-        addBuiltinSource(coreLanguageScope, "core", getCoreLibraryCode());
-        addBuiltinSource(hlslLanguageScope, "hlsl", getHLSLLibraryCode());
-
-        // Write out
-        if (false)
-        {
-            for (auto& pair : m_builtinLinkage->mapNameToLoadedModules)
-            {
-                const Name* moduleName = pair.Key;
-                Module* module = pair.Value;
+        // We need to create a new scope to link into the whole thing
+        auto subScope = new Scope();
+        subScope->containerDecl = module->getModuleDecl();
+        subScope->nextSibling = scope->nextSibling;
+        scope->nextSibling = subScope;
+    }
 
-                // Set up options
-                SerialContainerUtil::WriteOptions options;
+    // We need to retain this AST so that we can use it in other code
+    // (Note that the `Scope` type does not retain the AST it points to)
+    stdlibModules.add(module);
 
-                options.optionFlags |= SerialOptionFlag::SourceLocation;
-                // TODO(JS): Should this be the Session::getBuiltinSourceManager()
-                options.sourceManager = m_builtinLinkage->getSourceManager();
+    // Lookup builds member dictionaries on demand. Build them all now, so that the builtin modules are not
+    // modified when used from Linkages on different threads.
+    _buildMemberDictionaries(module->getModuleDecl());
+    m_sharedASTBuilder->finalizeStdLib();
 
-                StringBuilder builder;
-                builder << moduleName->text << ".slang-module";
+    // Nodes in the builtin modules can still be created lazily (such as canonical types), so
+    // the builders holding them have to lock when that happens.
+    module->getASTBuilder()->setShared();
+    m_builtinLinkage->getASTBuilder()->setShared();
+}
 
-                FileStream stream(builder.ProduceString(), FileMode::Create, FileAccess::Write, FileShare::ReadWrite);
-                if (SLANG_FAILED(SerialContainerUtil::write(module, options, &stream)))
-                {
-                    SLANG_UNEXPECTED("Unable to load stdlib");
-                }
-            }
-        }
+/* static */void Session::_buildMemberDictionaries(ContainerDecl* containerDecl)
+{
+    // If the members are created on demand, the loader builds the dictionary as they are created
+    if (containerDecl->memberLoader.load())
+    {
+        return;
     }
 
+    buildMemberDictionary(containerDecl);
+    for (Decl* member : containerDecl->members)
     {
-        for (Index i = 0; i < Index(SourceLanguage::CountOf); ++i)
+        if (auto childContainerDecl = as<ContainerDecl>(member))
         {
-            m_defaultDownstreamCompilers[i] = PassThroughMode::None;
+            _buildMemberDictionaries(childContainerDecl);
         }
-        m_defaultDownstreamCompilers[Index(SourceLanguage::C)] = PassThroughMode::GenericCCpp;
-        m_defaultDownstreamCompilers[Index(SourceLanguage::CPP)] = PassThroughMode::GenericCCpp;
-        m_defaultDownstreamCompilers[Index(SourceLanguage::CUDA)] = PassThroughMode::NVRTC;
     }
+}
 
-    // Set up default prelude code for target languages that need a prelude
-    m_languagePreludes[Index(SourceLanguage::CUDA)] = get_slang_cuda_prelude();
-    m_languagePreludes[Index(SourceLanguage::CPP)] = get_slang_cpp_prelude();
-    m_languagePreludes[Index(SourceLanguage::HLSL)] = get_slang_hlsl_prelude();
+Scope* Session::_getBuiltinModuleScope(Name* moduleName)
+{
+    // Modules other than `hlsl` are either `core` or were added via `spAddBuiltins`,
+    // which places them in the core scope.
+    if (moduleName && moduleName->text == "hlsl")
+    {
+        return hlslLanguageScope;
+    }
+    return coreLanguageScope;
 }
 
-SlangResult Session::_readBuiltinModule(Scope* scope, String moduleName)
+// A hash of how the AST and IR are represented when serialized - the layout of the serialized AST classes,
+// and the IR opcodes. Unlike the build tag (which is "unknown" for development builds) it changes with any
+// change to the compiler that changes what is serialized.
+static HashCode64 _calcSerialRepresentationHash()
 {
-    StringBuilder moduleFilename;
-    moduleFilename << moduleName << ".slang-module";
+    StringBuilder buf;
 
-    RiffContainer riffContainer;
-    try
+    RefPtr<SerialClasses> serialClasses;
+    if (SLANG_SUCCEEDED(SerialClassesUtil::create(serialClasses)))
     {
-        FileStream stream(moduleFilename.ProduceString(), FileMode::Open, FileAccess::Read, FileShare::ReadOnly);
-        // Load the riff container
-        SLANG_RETURN_ON_FAIL(RiffUtil::read(&stream, riffContainer));
+        buf << UInt64(SerialClassesUtil::calcLayoutHash(serialClasses)) << "\n";
     }
-    catch (const IOException&)
+
+    for (Index op = 0; op < Index(kIROpCount); ++op)
     {
-        return SLANG_FAIL;
+        const IROpInfo info = getIROpInfo(IROp(op));
+        buf << (info.name ? info.name : "") << " " << Index(info.fixedArgCount) << " " << Index(info.flags) << "\n";
     }
 
-    // Load up the module
-    
-    SerialContainerData containerData;
+    return getHashCode64(buf.getBuffer(), size_t(buf.getLength()));
+}
 
-    Linkage* linkage = getBuiltinLinkage();
+HashCode64 Session::getStdLibSourceHash()
+{
+    // The hash identifies the exact stdlib a serialized stdlib was produced from.
+    // It combines the build tag (which changes with every release), the serialized representation used by
+    // this build, and the generated stdlib source.
+    static const HashCode64 serialRepresentationHash = _calcSerialRepresentationHash();
 
-    SourceManager* sourceManger = getBuiltinSourceManager();
+    StringBuilder buf;
+    buf << getBuildTagString() << "\n";
+    buf << UInt64(serialRepresentationHash) << "\n";
+    buf << getCoreLibraryCode();
+    buf << getHLSLLibraryCode();
 
-    NamePool* sessionNamePool = &namePool;
-    NamePool* linkageNamePool = linkage->getNamePool();
+    return getHashCode64(buf.getBuffer(), size_t(buf.getLength()));
+}
+
+SlangResult Session::_readBuiltinModule(RiffContainer::ListChunk* containerChunk)
+{
+    Linkage* linkage = getBuiltinLinkage();
 
     SerialContainerUtil::ReadOptions options;
-    options.namePool = linkageNamePool;
+    options.namePool = linkage->getNamePool();
     options.session = this;
     options.sharedASTBuilder = linkage->getASTBuilder()->getSharedASTBuilder();
-    options.sourceManager = sourceManger;
+    options.sourceManager = getBuiltinSourceManager();
     options.linkage = linkage;
+    // Function bodies are only needed when they are linked into a program, so create them on demand
+    options.irReadFlags = IRSerialReadFlag::LazyBodies;
+    // Most declarations are never referenced, so only create them when they are looked up
+    options.astReadFlags = ASTSerialReadFlag::LazyMembers;
 
     // Hmm - don't have a suitable sink yet, so attempt to just not have one
     options.sink = nullptr;
 
-    SLANG_RETURN_ON_FAIL(SerialContainerUtil::read(&riffContainer, options, containerData));
+    SerialContainerData containerData;
+    SLANG_RETURN_ON_FAIL(SerialContainerUtil::read(containerChunk, options, containerData));
 
     for (auto& srcModule : containerData.modules)
     {
-        RefPtr<Module> module(new Module(linkage, srcModule.astBuilder));
-
         ModuleDecl* moduleDecl = as<ModuleDecl>(srcModule.astRootNode);
+        if (!moduleDecl || !srcModule.irModule)
+        {
+            // A stdlib module must have both AST and IR
+            return SLANG_FAIL;
+        }
+
+        RefPtr<Module> module(new Module(linkage, srcModule.astBuilder));
+        module->setASTDeclLoader(srcModule.astDeclLoader);
 
-        if (moduleDecl)
+        if (isFromStdLib(moduleDecl))
         {
-            if (isFromStdLib(moduleDecl))
+            if (auto declLoader = srcModule.astDeclLoader)
+            {
+                // Find the builtin decls without creating everything
+                List<Decl*> builtinDecls;
+                declLoader->loadDeclsWithModifier(BuiltinTypeModifier::kReflectClassInfo, builtinDecls);
+                declLoader->loadDeclsWithModifier(MagicTypeModifier::kReflectClassInfo, builtinDecls);
+                // A decl can have both modifiers, so make sure each is only registered once
+                HashSet<Decl*> registeredDecls;
+                for (Decl* builtinDecl : builtinDecls)
+                {
+                    if (registeredDecls.Add(builtinDecl))
+                    {
+                        registerBuiltinDecl(this, builtinDecl);
+                    }
+                }
+            }
+            else
             {
                 registerBuiltinDecls(this, moduleDecl);
             }
-            
-            module->setModuleDecl(moduleDecl);
         }
 
+        moduleDecl->module = module;
+        module->setModuleDecl(moduleDecl);
         module->setIRModule(srcModule.irModule);
 
-        // Put in the loaded module map
-        linkage->mapNameToLoadedModules.Add(sessionNamePool->getName(moduleName), module);
+        Name* moduleName = moduleDecl->getName();
+        _addBuiltinModule(_getBuiltinModuleScope(moduleName), moduleName, module);
+    }
+
+    return SLANG_OK;
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL Session::compileStdLib()
+{
+    if (stdlibModules.getCount())
+    {
+        // The stdlib has already been set up 
+        return SLANG_FAIL;
+    }
+
+    addBuiltinSource(coreLanguageScope, "core", getCoreLibraryCode());
+    addBuiltinSource(hlslLanguageScope, "hlsl", getHLSLLibraryCode());
+    return SLANG_OK;
+}
 
-        // Add the resulting code to the appropriate scope
-        if (!scope->containerDecl)
+SLANG_NO_THROW SlangResult SLANG_MCALL Session::loadStdLib(const void* stdLib, size_t stdLibSizeInBytes)
+{
+    if (stdlibModules.getCount())
+    {
+        // The stdlib has already been set up 
+        return SLANG_FAIL;
+    }
+
+    RiffContainer riffContainer;
+    {
+        MemoryStreamBase stream(FileAccess::Read, stdLib, stdLibSizeInBytes);
+        SLANG_RETURN_ON_FAIL(RiffUtil::read(&stream, riffContainer));
+    }
+
+    RiffContainer::ListChunk* stdLibChunk = riffContainer.getRoot();
+    if (!stdLibChunk || stdLibChunk->getSubType() != SerialBinary::kStdLibFourCc)
+    {
+        return SLANG_FAIL;
+    }
+
+    // Check the stdlib was produced from the same version and source as this build. If not we
+    // leave the session untouched so the caller can fall back to compiling the stdlib.
+    auto header = stdLibChunk->findContainedData<SerialBinary::StdLibHeader>(SerialBinary::kStdLibHeaderFourCc);
+    if (!header)
+    {
+        return SLANG_FAIL;
+    }
+    if (!RiffSemanticVersion::areCompatible(SerialBinary::StdLibHeader::getCurrentVersion(), RiffSemanticVersion::makeFromRaw(header->semanticVersion)) ||
+        header->sourceHash != getStdLibSourceHash())
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    // The modules are stored in the order they were loaded, so any module a module depends on will already be loaded.
+    for (RiffContainer::Chunk* chunk = stdLibChunk->getFirstContainedChunk(); chunk; chunk = chunk->m_next)
+    {
+        if (auto containerChunk = as<RiffContainer::ListChunk>(chunk, SerialBinary::kContainerFourCc))
         {
-            // We are the first chunk of code to be loaded for this scope
-            scope->containerDecl = moduleDecl;
+            SLANG_RETURN_ON_FAIL(_readBuiltinModule(containerChunk));
         }
-        else
+    }
+
+    return stdlibModules.getCount() ? SLANG_OK : SLANG_FAIL;
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL Session::saveStdLib(ISlangBlob** outBlob)
+{
+    if (stdlibModules.getCount() == 0)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    // Set up options
+    SerialContainerUtil::WriteOptions options;
+
+    options.optionFlags |= SerialOptionFlag::SourceLocation;
+    options.sourceManager = getBuiltinSourceManager();
+
+    RiffContainer container;
+    {
+        RiffContainer::ScopeChunk scopeStdLib(&container, RiffContainer::Chunk::Kind::List, SerialBinary::kStdLibFourCc);
+
+        // Write the header
         {
-            // We need to create a new scope to link into the whole thing
-            auto subScope = new Scope();
-            subScope->containerDecl = moduleDecl;
-            subScope->nextSibling = scope->nextSibling;
-            scope->nextSibling = subScope;
+            SerialBinary::StdLibHeader header;
+            header.semanticVersion = SerialBinary::StdLibHeader::getCurrentVersion().m_raw;
+            header.pad = 0;
+            header.sourceHash = getStdLibSourceHash();
+
+            RiffContainer::ScopeChunk scopeHeader(&container, RiffContainer::Chunk::Kind::Data, SerialBinary::kStdLibHeaderFourCc);
+            container.write(&header, sizeof(header));
         }
 
-        // We need to retain this AST so that we can use it in other code
-        // (Note that the `Scope` type does not retain the AST it points to)
-        stdlibModules.add(module);
+        // Write each module in its own container, in load order
+        for (Module* module : stdlibModules)
+        {
+            SerialContainerData data;
+            SLANG_RETURN_ON_FAIL(SerialContainerUtil::addModuleToData(module, options, data));
+            SLANG_RETURN_ON_FAIL(SerialContainerUtil::write(data, options, &container));
+        }
     }
 
+    OwnedMemoryStream stream(FileAccess::Write);
+    SLANG_RETURN_ON_FAIL(RiffUtil::write(container.getRoot(), true, &stream));
+
+    RefPtr<ListBlob> listBlob(new ListBlob);
+    stream.swapContents(listBlob->m_data);
+
+    *outBlob = listBlob.detach();
     return SLANG_OK;
 }
 
@@ -434,6 +594,32 @@ SLANG_NO_THROW const char* SLANG_MCALL Session::getBuildTagString()
     return spGetBuildTagString();
 }
 
+SlangResult Session::getOrCreateCompileCache(const String& directory, RefPtr<CompileCache>& outCache)
+{
+    if (!File::exists(directory) && !Path::createDirectory(directory))
+    {
+        return SLANG_FAIL;
+    }
+
+    // Different ways of naming the same directory should find the same cache
+    String canonicalDirectory;
+    SLANG_RETURN_ON_FAIL(Path::getCanonical(directory, canonicalDirectory));
+
+    std::lock_guard<std::mutex> lock(m_compileCacheMutex);
+
+    RefPtr<CompileCache>* cachePtr = m_compileCaches.TryGetValue(canonicalDirectory);
+    if (cachePtr)
+    {
+        outCache = *cachePtr;
+        return SLANG_OK;
+    }
+
+    RefPtr<CompileCache> cache = new CompileCache(canonicalDirectory);
+    m_compileCaches.Add(canonicalDirectory, cache);
+    outCache = cache;
+    return SLANG_OK;
+}
+
 SLANG_NO_THROW SlangResult SLANG_MCALL Session::setDefaultDownstreamCompiler(SlangSourceLanguage sourceLanguage, SlangPassThrough defaultCompiler)
 {
     if (DownstreamCompiler::canCompile(defaultCompiler, sourceLanguage))
@@ -793,13 +979,26 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::getTypeConformanceWitnessSequent
     auto supType = asInternal(interfaceType);
     auto name = getMangledNameForConformanceWitness(subType->getASTBuilder(), subType, supType);
     auto interfaceName = getMangledTypeName(supType->getASTBuilder(), supType);
+    uint32_t resultIndex = getOrAllocateWitnessTableSequentialID(name.getUnownedSlice(), interfaceName.getUnownedSlice());
+    if (outId)
+        *outId = resultIndex;
+    return SLANG_OK;
+}
+
+uint32_t Linkage::getOrAllocateWitnessTableSequentialID(
+    const UnownedStringSlice& witnessTableMangledName,
+    const UnownedStringSlice& interfaceMangledName)
+{
+    std::lock_guard<std::mutex> lock(m_sequentialIDMutex);
+
+    const String name(witnessTableMangledName);
     uint32_t resultIndex = 0;
     if (mapMangledNameToRTTIObjectIndex.TryGetValue(name, resultIndex))
     {
-        if (outId)
-            *outId = resultIndex;
-        return SLANG_OK;
+        return resultIndex;
     }
+
+    const String interfaceName(interfaceMangledName);
     auto idAllocator = mapInterfaceMangledNameToSequentialIDCounters.TryGetValue(interfaceName);
     if (!idAllocator)
     {
@@ -809,9 +1008,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::getTypeConformanceWitnessSequent
     resultIndex = (*idAllocator);
     ++(*idAllocator);
     mapMangledNameToRTTIObjectIndex[name] = resultIndex;
-    if (outId)
-        *outId = resultIndex;
-    return SLANG_OK;
+    return resultIndex;
 }
 
 SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::createCompileRequest(
@@ -881,6 +1078,15 @@ TypeLayout* TargetRequest::getTypeLayout(Type* type)
     return result.Ptr();
 }
 
+TypeLayoutCache* TargetRequest::getTypeLayoutCache()
+{
+    if (!m_typeLayoutCache)
+    {
+        m_typeLayoutCache = new TypeLayoutCache(linkage->getReleasedModuleCounter());
+    }
+    return m_typeLayoutCache;
+}
+
 
 //
 // TranslationUnitRequest
@@ -1584,16 +1790,20 @@ SlangResult FrontEndCompileRequest::executeActionsInner()
 
 
     // Parse everything from the input files requested
+    PerfPhaseRecorder perfRecorder(perfReport, "frontEnd");
+
     for (auto& translationUnit : translationUnits)
     {
         parseTranslationUnit(translationUnit.Ptr());
     }
+    perfRecorder.endPhase("parse");
 
     if (getSink()->getErrorCount() != 0)
         return SLANG_FAIL;
 
     // Perform semantic checking on the whole collection
     checkAllTranslationUnits();
+    perfRecorder.endPhase("check");
     if (getSink()->getErrorCount() != 0)
         return SLANG_FAIL;
 
@@ -1608,6 +1818,7 @@ SlangResult FrontEndCompileRequest::executeActionsInner()
     m_globalAndEntryPointsComponentType = createUnspecializedGlobalAndEntryPointsComponentType(
         this,
         m_unspecializedEntryPoints);
+    perfRecorder.endPhase("createComponentTypes");
     if (getSink()->getErrorCount() != 0)
         return SLANG_FAIL;
 
@@ -1620,6 +1831,7 @@ SlangResult FrontEndCompileRequest::executeActionsInner()
     // makes sense.
     //
     generateIR();
+    perfRecorder.endPhase("lowerToIR");
     if (getSink()->getErrorCount() != 0)
         return SLANG_FAIL;
 
@@ -1631,6 +1843,7 @@ SlangResult FrontEndCompileRequest::executeActionsInner()
         targetProgram->getOrCreateLayout(getSink());
         targetProgram->getOrCreateIRModuleForLayout(getSink());
     }
+    perfRecorder.endPhase("layout");
     if (getSink()->getErrorCount() != 0)
         return SLANG_FAIL;
 
@@ -1680,7 +1893,7 @@ void EndToEndCompileRequest::init()
     m_backEndReq = new BackEndCompileRequest(getLinkage(), getSink());
 }
 
-SlangResult EndToEndCompileRequest::executeActionsInner()
+void EndToEndCompileRequest::_addDefaultTargetIfNeeded()
 {
     // If no code-generation target was specified, then try to infer one from the source language,
     // just to make sure we can do something reasonable when invoked from the command line.
@@ -1705,6 +1918,11 @@ SlangResult EndToEndCompileRequest::executeActionsInner()
             break;
         }
     }
+}
+
+SlangResult EndToEndCompileRequest::executeActionsInner()
+{
+    _addDefaultTargetIfNeeded();
 
     // We only do parsing and semantic checking if we *aren't* doing
     // a pass-through compilation.
@@ -1739,27 +1957,7 @@ SlangResult EndToEndCompileRequest::executeActionsInner()
     //
     if (passThrough == PassThroughMode::None)
     {
-        m_specializedGlobalComponentType = createSpecializedGlobalComponentType(this);
-        if (getSink()->getErrorCount() != 0)
-            return SLANG_FAIL;
-
-        m_specializedGlobalAndEntryPointsComponentType = createSpecializedGlobalAndEntryPointsComponentType(
-            this,
-            m_specializedEntryPoints);
-        if (getSink()->getErrorCount() != 0)
-            return SLANG_FAIL;
-
-        // For each code generation target, we will generate specialized
-        // parameter binding information (taking global generic
-        // arguments into account at this time).
-        //
-        for (auto targetReq : getLinkage()->targets)
-        {
-            auto targetProgram = m_specializedGlobalAndEntryPointsComponentType->getTargetProgram(targetReq);
-            targetProgram->getOrCreateLayout(getSink());
-        }
-        if (getSink()->getErrorCount() != 0)
-            return SLANG_FAIL;
+        SLANG_RETURN_ON_FAIL(_specializeProgram());
     }
     else
     {
@@ -1796,10 +1994,291 @@ SlangResult EndToEndCompileRequest::executeActionsInner()
     return SLANG_OK;
 }
 
+SlangResult EndToEndCompileRequest::_specializeProgram()
+{
+    PerfPhaseRecorder perfRecorder(getPerfReport(), "frontEnd");
+
+    m_specializedGlobalComponentType = createSpecializedGlobalComponentType(this);
+    if (getSink()->getErrorCount() != 0)
+        return SLANG_FAIL;
+
+    m_specializedGlobalAndEntryPointsComponentType = createSpecializedGlobalAndEntryPointsComponentType(
+        this,
+        m_specializedEntryPoints);
+    perfRecorder.endPhase("specialize");
+    if (getSink()->getErrorCount() != 0)
+        return SLANG_FAIL;
+
+    // For each code generation target, we will generate specialized
+    // parameter binding information (taking global generic
+    // arguments into account at this time).
+    //
+    for (auto targetReq : getLinkage()->targets)
+    {
+        auto targetProgram = m_specializedGlobalAndEntryPointsComponentType->getTargetProgram(targetReq);
+        targetProgram->getOrCreateLayout(getSink());
+    }
+    perfRecorder.endPhase("specializedLayout");
+    if (getSink()->getErrorCount() != 0)
+        return SLANG_FAIL;
+
+    return SLANG_OK;
+}
+
+SlangResult EndToEndCompileRequest::ensureProgramForCompileCacheHit()
+{
+    if (!m_isCompileCacheHit || m_hasProgramForCompileCacheHit)
+    {
+        return SLANG_OK;
+    }
+    // Only try once, as the result won't change
+    m_hasProgramForCompileCacheHit = true;
+
+    RefPtr<ComponentType> cachedGlobalComponentType = m_specializedGlobalComponentType;
+    RefPtr<ComponentType> cachedProgram = m_specializedGlobalAndEntryPointsComponentType;
+    List<RefPtr<ComponentType>> cachedEntryPoints = m_specializedEntryPoints;
+
+    // The diagnostics were output when the request was compiled, so anything the front end reports again is dropped
+    DiagnosticSink* sink = getSink();
+    ISlangWriter* writer = sink->writer;
+    const Index startLength = sink->outputBuffer.getLength();
+    const Index startErrorCount = sink->getErrorCount();
+
+    sink->writer = nullptr;
+    SlangResult res = SLANG_OK;
+    try
+    {
+        res = getFrontEndReq()->executeActionsInner();
+        if (SLANG_SUCCEEDED(res))
+        {
+            res = _specializeProgram();
+        }
+    }
+    catch (const AbortCompilationException&)
+    {
+        res = SLANG_FAIL;
+    }
+    res = (sink->getErrorCount() != startErrorCount) ? SLANG_FAIL : res;
+
+    {
+        const String prior = UnownedStringSlice(sink->outputBuffer.getBuffer(), sink->outputBuffer.getBuffer() + startLength);
+        sink->outputBuffer.Clear();
+        sink->outputBuffer.append(prior);
+        sink->writer = writer;
+    }
+
+    auto program = m_specializedGlobalAndEntryPointsComponentType;
+    if (SLANG_FAILED(res) || !program || program->getEntryPointCount() != cachedProgram->getEntryPointCount())
+    {
+        // Keep the stand ins, so the results can still be accessed
+        m_specializedGlobalComponentType = cachedGlobalComponentType;
+        m_specializedGlobalAndEntryPointsComponentType = cachedProgram;
+        m_specializedEntryPoints = cachedEntryPoints;
+        return SLANG_FAIL;
+    }
+
+    // The results from the cache are moved to the program, so it's as if the program had been compiled
+    const Index entryPointCount = program->getEntryPointCount();
+    for (auto targetReq : getLinkage()->targets)
+    {
+        auto cachedTargetProgram = cachedProgram->getTargetProgram(targetReq);
+        auto targetProgram = program->getTargetProgram(targetReq);
+
+        targetProgram->getExistingWholeProgramResult() = cachedTargetProgram->getExistingWholeProgramResult();
+        for (Index i = 0; i < entryPointCount; ++i)
+        {
+            targetProgram->getExistingEntryPointResult(i) = cachedTargetProgram->getExistingEntryPointResult(i);
+        }
+    }
+
+    getBackEndReq()->setProgram(program);
+    return SLANG_OK;
+}
+
+SlangResult EndToEndCompileRequest::_applyCompileCacheEntry(const CompileCache::Entry& entry)
+{
+    auto linkage = getLinkage();
+
+    // The key matched, but check the entry is consistent with the request before changing anything
+    for (const auto& output : entry.outputs)
+    {
+        if (output.targetIndex < 0 || output.targetIndex >= linkage->targets.getCount() ||
+            output.entryPointIndex >= entry.entryPoints.getCount())
+        {
+            return SLANG_FAIL;
+        }
+    }
+
+    // As with pass-through, there is no AST, so dummy entry points stand in for the real ones
+    List<RefPtr<ComponentType>> entryPoints;
+    for (const auto& cacheEntryPoint : entry.entryPoints)
+    {
+        RefPtr<EntryPoint> entryPoint = EntryPoint::createDummyForPassThrough(
+            linkage,
+            getNamePool()->getName(cacheEntryPoint.name),
+            Profile(Profile::RawVal(cacheEntryPoint.profile)));
+        entryPoints.add(entryPoint);
+    }
+
+    RefPtr<ComponentType> program = CompositeComponentType::create(linkage, entryPoints);
+
+    m_specializedGlobalComponentType = CompositeComponentType::create(linkage, List<RefPtr<ComponentType>>());
+    m_specializedGlobalAndEntryPointsComponentType = program;
+    m_specializedEntryPoints = entryPoints;
+
+    for (const auto& output : entry.outputs)
+    {
+        auto targetProgram = program->getTargetProgram(linkage->targets[output.targetIndex]);
+
+        CompileResult result;
+        if (output.isText)
+        {
+            const char* text = (const char*)output.blob->getBufferPointer();
+            result = CompileResult(String(text, text + output.blob->getBufferSize()));
+        }
+        else
+        {
+            result = CompileResult(output.blob);
+        }
+
+        if (output.entryPointIndex < 0)
+        {
+            targetProgram->getExistingWholeProgramResult() = result;
+        }
+        else
+        {
+            targetProgram->getExistingEntryPointResult(output.entryPointIndex) = result;
+        }
+    }
+
+    m_isCompileCacheHit = true;
+    m_hasProgramForCompileCacheHit = false;
+    m_compileCacheDependencyPaths.clear();
+    for (const auto& dependency : entry.dependencies)
+    {
+        m_compileCacheDependencyPaths.add(dependency.path);
+    }
+
+    // Only compiles without errors are stored, so replaying the diagnostics doesn't change the error count
+    if (entry.diagnostics.getLength())
+    {
+        getSink()->diagnoseRaw(Severity::Note, entry.diagnostics.getUnownedSlice());
+    }
+
+    getBackEndReq()->setProgram(program);
+    if (isCommandLineCompile)
+    {
+        writeCommandLineOutput(this);
+    }
+    return SLANG_OK;
+}
+
+SlangResult EndToEndCompileRequest::_executeActionsWithCompileCache()
+{
+    // The targets are part of the key, so the default has to be set first
+    _addDefaultTargetIfNeeded();
+
+    CompileCache::Key key;
+    SLANG_RETURN_ON_FAIL(calcCompileCacheKey(this, key));
+
+    {
+        CompileCache::Entry entry;
+        if (SLANG_SUCCEEDED(m_compileCache->findEntry(key, getLinkage()->getFileSystemExt(), entry)) &&
+            SLANG_SUCCEEDED(_applyCompileCacheEntry(entry)))
+        {
+            return SLANG_OK;
+        }
+    }
+
+    // The diagnostics need to be stored with the entry, so they are collected in the output buffer,
+    // and only passed on to the writer (if there is one) when the compilation is complete.
+    DiagnosticSink* sink = getSink();
+    ISlangWriter* writer = sink->writer;
+    const Index startLength = sink->outputBuffer.getLength();
+
+    String diagnostics;
+    auto endCapture = [&]()
+    {
+        StringBuilder& buffer = sink->outputBuffer;
+        diagnostics = UnownedStringSlice(buffer.getBuffer() + startLength, buffer.getBuffer() + buffer.getLength());
+        if (writer)
+        {
+            const String prior = UnownedStringSlice(buffer.getBuffer(), buffer.getBuffer() + startLength);
+            buffer.Clear();
+            buffer.append(prior);
+
+            sink->writer = writer;
+            writer->write(diagnostics.getBuffer(), diagnostics.getLength());
+        }
+    };
+
+    sink->writer = nullptr;
+    SlangResult res = SLANG_OK;
+    try
+    {
+        res = executeActionsInner();
+    }
+    catch (...)
+    {
+        endCapture();
+        throw;
+    }
+    endCapture();
+
+    if (SLANG_SUCCEEDED(res) && sink->getErrorCount() == 0)
+    {
+        // Failing to store the results doesn't make the compilation fail
+        CompileCache::Entry entry;
+        if (SLANG_SUCCEEDED(createCompileCacheEntry(this, diagnostics, entry)))
+        {
+            m_compileCache->addEntry(key, entry);
+        }
+    }
+    return res;
+}
+
+List<String> const& EndToEndCompileRequest::getFilePathDependencies()
+{
+    if (m_isCompileCacheHit)
+    {
+        return m_compileCacheDependencyPaths;
+    }
+    return getFrontEndReq()->getGlobalAndEntryPointsComponentType()->getFilePathDependencies();
+}
+
 // Act as expected of the API-based compiler
+void EndToEndCompileRequest::setReportPerf(bool enable)
+{
+    RefPtr<PerfReport> perfReport;
+    if (enable)
+    {
+        perfReport = getPerfReport() ? getPerfReport() : new PerfReport;
+    }
+    getFrontEndReq()->perfReport = perfReport;
+    getBackEndReq()->perfReport = perfReport;
+}
+
 SlangResult EndToEndCompileRequest::executeActions()
 {
-    SlangResult res = executeActionsInner();
+    PerfReport* perfReport = getPerfReport();
+    if (perfReport)
+    {
+        perfReport->clear();
+    }
+
+    SlangResult res = (m_compileCache && canUseCompileCache(this)) ?
+        _executeActionsWithCompileCache() :
+        executeActionsInner();
+
+    // From the command line the report is output with the diagnostics
+    if (perfReport && isCommandLineCompile)
+    {
+        StringBuilder builder;
+        builder << "performance report:\n";
+        perfReport->appendAsText(builder);
+        getSink()->diagnoseRaw(Severity::Note, builder.getUnownedSlice());
+    }
+
     mDiagnosticOutput = getSink()->outputBuffer.ProduceString();
     return res;
 }
@@ -2013,40 +2492,286 @@ RefPtr<Module> Linkage::loadModule(
         this,
         module);
 
-    // Create with the 'friendly' name
-    SourceFile* sourceFile = getSourceManager()->createSourceFileWithBlob(filePathInfo, sourceBlob);
-    
-    translationUnit->addSourceFile(sourceFile);
+    // Create with the 'friendly' name
+    SourceFile* sourceFile = getSourceManager()->createSourceFileWithBlob(filePathInfo, sourceBlob);
+    
+    translationUnit->addSourceFile(sourceFile);
+
+    int errorCountBefore = sink->getErrorCount();
+    frontEndReq->parseTranslationUnit(translationUnit);
+    int errorCountAfter = sink->getErrorCount();
+
+    if( errorCountAfter != errorCountBefore )
+    {
+        sink->diagnose(srcLoc, Diagnostics::errorInImportedModule);
+    }
+    if (errorCountAfter)
+    {
+        // Something went wrong during the parsing, so we should bail out.
+        return nullptr;
+    }
+
+    loadParsedModule(
+        translationUnit,
+        name,
+        filePathInfo);
+
+    errorCountAfter = sink->getErrorCount();
+
+    if (errorCountAfter != errorCountBefore)
+    {
+        sink->diagnose(srcLoc, Diagnostics::errorInImportedModule);
+        // Something went wrong during the parsing, so we should bail out.
+        return nullptr;
+    }
+
+    return module;
+}
+
+SlangResult Linkage::loadSerializedModule(
+    Name*               name,
+    const PathInfo&     filePathInfo,
+    ISlangBlob*         fileContentsBlob,
+    ISlangBlob*         sourceBlob,
+    DiagnosticSink*     sink,
+    String&             outProblem,
+    RefPtr<Module>&     outModule)
+{
+    RiffContainer riffContainer;
+    {
+        MemoryStreamBase stream(FileAccess::Read, fileContentsBlob->getBufferPointer(), fileContentsBlob->getBufferSize());
+        if (SLANG_FAILED(RiffUtil::read(&stream, riffContainer)))
+        {
+            outProblem = "it is not a valid module container";
+            return SLANG_FAIL;
+        }
+    }
+
+    RiffContainer::ListChunk* containerChunk = riffContainer.getRoot()->findListRec(SerialBinary::kContainerFourCc);
+    SerialBinary::ModuleHeader header;
+    List<SerialContainerData::FileDependency> fileDependencies;
+    if (!containerChunk || SLANG_FAILED(SerialContainerUtil::readModuleHeader(containerChunk, header, fileDependencies)))
+    {
+        outProblem = "it is not a valid module container";
+        return SLANG_FAIL;
+    }
+
+    // Check the container was produced by a compatible compiler, with the same stdlib, and from
+    // the files that we have. Checking the header is cheap, and means we don't need to deserialize
+    // anything if the container can't be used.
+    if (!RiffSemanticVersion::areCompatible(SerialBinary::ModuleHeader::getCurrentVersion(), RiffSemanticVersion::makeFromRaw(header.semanticVersion)))
+    {
+        outProblem = "it was written by an incompatible version of slang";
+        return SLANG_FAIL;
+    }
+    Session* session = getSessionImpl();
+    if (header.stdLibSourceHash != session->getStdLibSourceHash())
+    {
+        outProblem = "it was compiled against a different standard library";
+        return SLANG_FAIL;
+    }
+
+    // The source found for the import must be what the module was compiled from (the first dependency),
+    // wherever it was compiled from
+    if (sourceBlob && (fileDependencies.getCount() == 0 || fileDependencies[0].contentsHash != SerialContainerUtil::calcFileContentsHash(sourceBlob)))
+    {
+        outProblem = "it is out of date with respect to its source";
+        return SLANG_FAIL;
+    }
+
+    // Every other file the module was compiled from must be unchanged. A file that can't be found
+    // isn't checked, so a module can be used without the files it was compiled from.
+    List<String> foundDependencyPaths;
+    for (const auto& dependency : fileDependencies)
+    {
+        ComPtr<ISlangBlob> dependencyBlob;
+        if (SLANG_FAILED(getFileSystemExt()->loadFile(dependency.path.getBuffer(), dependencyBlob.writeRef())))
+        {
+            continue;
+        }
+        if (dependency.contentsHash != SerialContainerUtil::calcFileContentsHash(dependencyBlob))
+        {
+            outProblem = "it is out of date with respect to '" + dependency.path + "'";
+            return SLANG_FAIL;
+        }
+        foundDependencyPaths.add(dependency.path);
+    }
+
+    SerialContainerUtil::ReadOptions options;
+    options.namePool = getNamePool();
+    options.session = session;
+    options.sharedASTBuilder = getASTBuilder()->getSharedASTBuilder();
+    options.sourceManager = getSourceManager();
+    options.linkage = this;
+    options.sink = sink;
+    // Function bodies are only needed when they are linked into a program, so create them on demand
+    options.irReadFlags = IRSerialReadFlag::LazyBodies;
+
+    // Reading resolves references into other modules, importing them as needed
+    SerialContainerData containerData;
+    if (SLANG_FAILED(SerialContainerUtil::read(containerChunk, options, containerData)))
+    {
+        outProblem = "it could not be read";
+        return SLANG_FAIL;
+    }
+
+    if (containerData.modules.getCount() != 1)
+    {
+        outProblem = "it does not hold a single module";
+        return SLANG_FAIL;
+    }
+
+    auto& srcModule = containerData.modules[0];
+    ModuleDecl* moduleDecl = as<ModuleDecl>(srcModule.astRootNode);
+    if (!moduleDecl || !srcModule.irModule)
+    {
+        outProblem = "it does not hold both the AST and IR of the module";
+        return SLANG_FAIL;
+    }
+
+    // The module name is part of the mangled names of everything it exports, so the module
+    // must have been compiled with the name it is imported by
+    if (moduleDecl->getName() != name)
+    {
+        outProblem = "the module it holds is named '" + getText(moduleDecl->getName()) + "' (it should be compiled with -module-name " + getText(name) + ")";
+        return SLANG_FAIL;
+    }
+
+    RefPtr<Module> module(new Module(this, srcModule.astBuilder));
+    moduleDecl->module = module;
+    module->setModuleDecl(moduleDecl);
+    module->setIRModule(srcModule.irModule);
+
+    // The imports of the module are not part of the container, so look them up again. They are
+    // already loaded, as reading the container resolved references to them.
+    for (auto importDecl : moduleDecl->getMembersOfType<ImportDecl>())
+    {
+        RefPtr<Module> importedModule = findOrImportModule(importDecl->moduleNameAndLoc.name, importDecl->moduleNameAndLoc.loc, sink);
+        if (!importedModule)
+        {
+            outProblem = "a module it imports could not be loaded";
+            return SLANG_FAIL;
+        }
+        importDecl->importedModuleDecl = importedModule->getModuleDecl();
+        module->addModuleDependency(importedModule);
+    }
+
+    if (filePathInfo.hasFileFoundPath())
+    {
+        module->addFilePathDependency(filePathInfo.foundPath);
+    }
+    // Changes to the files it was compiled from make the module out of date too
+    for (const String& path : foundDependencyPaths)
+    {
+        module->addFilePathDependency(path);
+    }
+
+    module->_collectShaderParams();
+
+    mapPathToLoadedModule[filePathInfo.getMostUniqueIdentity()] = module;
+    mapNameToLoadedModules[name] = module;
+    loadedModulesList.add(module);
+
+    outModule = module;
+    return SLANG_OK;
+}
+
+Linkage::SpecializationKey::SpecializationKey(ComponentType* inBase, SpecializationArg const* inArgs, Index argCount)
+    : base(inBase)
+{
+    args.setCount(argCount);
+    for (Index i = 0; i < argCount; ++i)
+    {
+        Val* val = inArgs[i].val;
+        if (auto type = dynamicCast<Type>(val))
+        {
+            val = type->getCanonicalType();
+        }
+        args[i].val = val;
+    }
+}
 
-    int errorCountBefore = sink->getErrorCount();
-    frontEndReq->parseTranslationUnit(translationUnit);
-    int errorCountAfter = sink->getErrorCount();
+HashCode Linkage::SpecializationKey::getHashCode() const
+{
+    Hasher hasher;
+    hasher.hashValue(base);
+    for (auto const& arg : args)
+    {
+        hasher.hashValue(arg.val ? arg.val->getHashCode() : 0);
+    }
+    return hasher.getResult();
+}
 
-    if( errorCountAfter != errorCountBefore )
+bool Linkage::SpecializationKey::operator==(const SpecializationKey& rhs) const
+{
+    if (base != rhs.base || args.getCount() != rhs.args.getCount())
     {
-        sink->diagnose(srcLoc, Diagnostics::errorInImportedModule);
+        return false;
     }
-    if (errorCountAfter)
+    for (Index i = 0; i < args.getCount(); ++i)
+    {
+        Val* val = args[i].val;
+        Val* rhsVal = rhs.args[i].val;
+        if (val != rhsVal && !(val && rhsVal && val->equalsVal(rhsVal)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+ComponentType* Linkage::findSpecialization(const SpecializationKey& key)
+{
+    SpecializationEntry* entry = m_specializationCache.TryGetValue(key);
+    if (!entry)
     {
-        // Something went wrong during the parsing, so we should bail out.
         return nullptr;
     }
+    entry->lastUsed = ++m_specializationUseCount;
+    return entry->componentType;
+}
 
-    loadParsedModule(
-        translationUnit,
-        name,
-        filePathInfo);
+void Linkage::addSpecialization(const SpecializationKey& key, ComponentType* specialized)
+{
+    if (m_maxSpecializationCacheEntryCount <= 0)
+    {
+        return;
+    }
 
-    errorCountAfter = sink->getErrorCount();
+    SpecializationEntry entry;
+    entry.componentType = specialized;
+    entry.lastUsed = ++m_specializationUseCount;
+    m_specializationCache[key] = entry;
 
-    if (errorCountAfter != errorCountBefore)
+    _evictSpecializationsIfNeeded();
+}
+
+void Linkage::setSpecializationCacheSize(Index maxEntryCount)
+{
+    m_maxSpecializationCacheEntryCount = maxEntryCount;
+    _evictSpecializationsIfNeeded();
+}
+
+void Linkage::_evictSpecializationsIfNeeded()
+{
+    while (m_specializationCache.Count() > Math::Max(m_maxSpecializationCacheEntryCount, Index(0)))
     {
-        sink->diagnose(srcLoc, Diagnostics::errorInImportedModule);
-        // Something went wrong during the parsing, so we should bail out.
-        return nullptr;
-    }
+        // Creating a specialization is far more costly than a linear search of those held,
+        // so finding the least recently used this way is fine
+        const SpecializationKey* lruKey = nullptr;
+        const SpecializationEntry* lruEntry = nullptr;
+        for (const auto& pair : m_specializationCache)
+        {
+            if (lruEntry == nullptr || pair.Value.lastUsed < lruEntry->lastUsed)
+            {
+                lruKey = &pair.Key;
+                lruEntry = &pair.Value;
+            }
+        }
 
-    return module;
+        const SpecializationKey key = *lruKey;
+        m_specializationCache.Remove(key);
+    }
 }
 
 bool Linkage::isBeingImported(Module* module)
@@ -2095,6 +2820,10 @@ RefPtr<Module> Linkage::findOrImportModule(
     // and then appending `.slang`.
     //
     // For example, `foo_bar` becomes `foo-bar.slang`.
+    //
+    // A module may also have been serialized ahead of time
+    // (for example with `slangc -no-codegen ... -o foo-bar.slang-module`),
+    // in which case we look for `foo-bar.slang-module` too.
 
     StringBuilder sb;
     for (auto c : getText(name))
@@ -2107,6 +2836,7 @@ RefPtr<Module> Linkage::findOrImportModule(
     sb.Append(".slang");
 
     String fileName = sb.ProduceString();
+    String serializedFileName = fileName + "-module";
 
     // Next, try to find the file of the given name,
     // using our ordinary include-handling logic.
@@ -2116,9 +2846,13 @@ RefPtr<Module> Linkage::findOrImportModule(
     // Get the original path info
     PathInfo pathIncludedFromInfo = getSourceManager()->getPathInfo(loc, SourceLocType::Actual);
     PathInfo filePathInfo;
+    PathInfo serializedPathInfo;
 
     // We have to load via the found path - as that is how file was originally loaded 
-    if (SLANG_FAILED(includeSystem.findFile(fileName, pathIncludedFromInfo.foundPath, filePathInfo)))
+    const bool hasSource = SLANG_SUCCEEDED(includeSystem.findFile(fileName, pathIncludedFromInfo.foundPath, filePathInfo));
+    const bool hasSerialized = SLANG_SUCCEEDED(includeSystem.findFile(serializedFileName, pathIncludedFromInfo.foundPath, serializedPathInfo));
+
+    if (!hasSource && !hasSerialized)
     {
         sink->diagnose(loc, Diagnostics::cannotFindFile, fileName);
         mapNameToLoadedModules[name] = nullptr;
@@ -2126,18 +2860,52 @@ RefPtr<Module> Linkage::findOrImportModule(
     }
 
     // Maybe this was loaded previously at a different relative name?
-    if (mapPathToLoadedModule.TryGetValue(filePathInfo.getMostUniqueIdentity(), loadedModule))
+    if (hasSource && mapPathToLoadedModule.TryGetValue(filePathInfo.getMostUniqueIdentity(), loadedModule))
+        return loadedModule;
+    if (hasSerialized && mapPathToLoadedModule.TryGetValue(serializedPathInfo.getMostUniqueIdentity(), loadedModule))
         return loadedModule;
 
     // Try to load it
     ComPtr<ISlangBlob> fileContents;
-    if(SLANG_FAILED(includeSystem.loadFile(filePathInfo, fileContents)))
+    if(hasSource && SLANG_FAILED(includeSystem.loadFile(filePathInfo, fileContents)))
     {
         sink->diagnose(loc, Diagnostics::cannotOpenFile, fileName);
         mapNameToLoadedModules[name] = nullptr;
         return nullptr;
     }
 
+    if (hasSerialized)
+    {
+        // The serialized module is used in preference to the source, as long as it was
+        // produced from that source. Otherwise we fall back to compiling the source.
+        String problem;
+        ComPtr<ISlangBlob> serializedContents;
+        if (SLANG_SUCCEEDED(includeSystem.loadFile(serializedPathInfo, serializedContents)))
+        {
+            RefPtr<Module> module;
+            if (SLANG_SUCCEEDED(loadSerializedModule(name, serializedPathInfo, serializedContents, fileContents, sink, problem, module)))
+            {
+                if (hasSource)
+                {
+                    mapPathToLoadedModule[filePathInfo.getMostUniqueIdentity()] = module;
+                }
+                return module;
+            }
+        }
+        else
+        {
+            problem = "it could not be opened";
+        }
+
+        if (!hasSource)
+        {
+            sink->diagnose(loc, Diagnostics::unableToImportSerializedModule, serializedFileName, problem);
+            mapNameToLoadedModules[name] = nullptr;
+            return nullptr;
+        }
+        sink->diagnose(loc, Diagnostics::serializedModuleIgnored, serializedFileName, problem, fileName);
+    }
+
     // We've found a file that we can load for the given module, so
     // go ahead and perform the module-load action
     return loadModule(
@@ -2226,9 +2994,16 @@ Module::Module(Linkage* linkage, ASTBuilder* astBuilder)
         m_astBuilder = new ASTBuilder(linkage->getASTBuilder()->getSharedASTBuilder(), "Module");
     }
 
+    m_releasedModuleCounter = linkage->getReleasedModuleCounter();
+
     addModuleDependency(this);
 }
 
+Module::~Module()
+{
+    m_releasedModuleCounter->add();
+}
+
 ISlangUnknown* Module::getInterface(const Guid& guid)
 {
     if(guid == IID_IModule)
@@ -2327,7 +3102,7 @@ void Module::_processFindDeclsExportSymbolsRec(Decl* decl)
     // If it's a container process it's children
     if(auto containerDecl = as<ContainerDecl>(decl))
     {
-        for (auto child : containerDecl->members)
+        for (auto child : containerDecl->getMembers())
         {
             _processFindDeclsExportSymbolsRec(child);
         }
@@ -2340,13 +3115,18 @@ void Module::_processFindDeclsExportSymbolsRec(Decl* decl)
     }
 }
 
-NodeBase* Module::findExportFromMangledName(const UnownedStringSlice& slice)
+void Module::_ensureExportSymbols()
 {
     // Will be non zero if has been previously attempted
     if (m_mangledExportSymbols.getCount() == 0)
     {
+        // The module itself can be referenced from another module (by an `import`)
+        ModuleDecl* moduleDecl = getModuleDecl();
+        m_mangledExportPool.add(getMangledName(getASTBuilder(), moduleDecl));
+        m_mangledExportSymbols.add(moduleDecl);
+
         // Build up the exported mangled name list
-        _processFindDeclsExportSymbolsRec(getModuleDecl());
+        _processFindDeclsExportSymbolsRec(moduleDecl);
 
         // If nothing found, mark that we have tried looking by making m_mangledExportSymbols.getCount() != 0
         if (m_mangledExportSymbols.getCount() == 0)
@@ -2354,11 +3134,40 @@ NodeBase* Module::findExportFromMangledName(const UnownedStringSlice& slice)
             m_mangledExportSymbols.add(nullptr);
         }        
     }
+}
+
+NodeBase* Module::findExportFromMangledName(const UnownedStringSlice& slice)
+{
+    // If the decls are created on demand, the loader can find the export without creating everything
+    if (m_astDeclLoader)
+    {
+        NodeBase* node = nullptr;
+        if (m_astDeclLoader->findExportFromMangledName(slice, node))
+        {
+            return node;
+        }
+    }
+
+    _ensureExportSymbols();
 
     const Index index = m_mangledExportPool.findIndex(slice);
     return (index >= 0) ? m_mangledExportSymbols[index] : nullptr;
 }
 
+void Module::getExportSymbols(List<UnownedStringSlice>& outMangledNames, List<NodeBase*>& outNodes)
+{
+    _ensureExportSymbols();
+
+    for (Index i = 0; i < m_mangledExportSymbols.getCount(); ++i)
+    {
+        if (NodeBase* node = m_mangledExportSymbols[i])
+        {
+            outMangledNames.add(m_mangledExportPool.getSlice(StringSlicePool::Handle(i)));
+            outNodes.add(node);
+        }
+    }
+}
+
 // ComponentType
 
 ComponentType::ComponentType(Linkage* linkage)
@@ -2448,11 +3257,24 @@ RefPtr<ComponentType> ComponentType::specialize(
         return this;
     }
 
+    // The same component type is often specialized with the same arguments
+    // many times, so if we have already made this specialization we return it,
+    // along with any layouts and code that have been produced for it.
+    //
+    Linkage* linkage = getLinkage();
+    Linkage::SpecializationKey key(this, inSpecializationArgs, Index(specializationArgCount));
+    if (ComponentType* found = linkage->findSpecialization(key))
+    {
+        return found;
+    }
+
     List<SpecializationArg> specializationArgs;
     specializationArgs.addRange(
         inSpecializationArgs,
         specializationArgCount);
 
+    const Index errorCountBefore = sink ? sink->getErrorCount() : 0;
+
     // We next need to validate that the specialization arguments
     // make sense, and also expand them to include any derived data
     // (e.g., interface conformance witnesses) that doesn't get
@@ -2463,11 +3285,20 @@ RefPtr<ComponentType> ComponentType::specialize(
         specializationArgCount,
         sink);
 
-    return new SpecializedComponentType(
+    RefPtr<ComponentType> specialized = new SpecializedComponentType(
         this,
         specializationInfo,
         specializationArgs,
         sink);
+
+    // Only a specialization without errors is reused, so that a failed
+    // specialization will report its errors each time.
+    //
+    if (sink && sink->getErrorCount() == errorCountBefore)
+    {
+        linkage->addSpecialization(key, specialized);
+    }
+    return specialized;
 }
 
 SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::specialize(
@@ -3126,29 +3957,8 @@ void Session::addBuiltinSource(
 
     // Extract the AST for the code we just parsed
     auto module = compileRequest->translationUnits[translationUnitIndex]->getModule();
-    auto moduleDecl = module->getModuleDecl();
 
-    // Put in the loaded module map
-    linkage->mapNameToLoadedModules.Add(moduleName, module);
-
-    // Add the resulting code to the appropriate scope
-    if (!scope->containerDecl)
-    {
-        // We are the first chunk of code to be loaded for this scope
-        scope->containerDecl = moduleDecl;
-    }
-    else
-    {
-        // We need to create a new scope to link into the whole thing
-        auto subScope = new Scope();
-        subScope->containerDecl = moduleDecl;
-        subScope->nextSibling = scope->nextSibling;
-        scope->nextSibling = subScope;
-    }
-
-    // We need to retain this AST so that we can use it in other code
-    // (Note that the `Scope` type does not retain the AST it points to)
-    stdlibModules.add(module);
+    _addBuiltinModule(scope, moduleName, module);
 }
 
 Session::~Session()
@@ -3161,10 +3971,84 @@ Session::~Session()
 
 // implementation of C interface
 
-SLANG_API SlangSession* spCreateSession(const char*)
+// The serialized stdlib saved next to the slang library by the build (see `slangc` in premake5.lua)
+static const char kStdLibFileName[] = "slang-stdlib.bin";
+
+static bool _tryLoadStdLib(Slang::RefPtr<Slang::Session>& ioSession, const void* stdLib, size_t stdLibSize)
+{
+    if (SLANG_SUCCEEDED(ioSession->loadStdLib(stdLib, stdLibSize)))
+    {
+        return true;
+    }
+
+    // If the stdlib doesn't match this build the session is untouched, and something else can be
+    // tried. If it failed part way through loading we need to start over.
+    if (ioSession->stdlibModules.getCount())
+    {
+        ioSession = new Slang::Session();
+        ioSession->init();
+    }
+    return false;
+}
+
+static bool _tryLoadStdLibFromLibraryDirectory(Slang::RefPtr<Slang::Session>& ioSession)
+{
+    using namespace Slang;
+
+    String libraryPath;
+    if (SLANG_FAILED(SharedLibrary::getPathFromSymbolAddress((const void*)&_tryLoadStdLibFromLibraryDirectory, libraryPath)))
+    {
+        return false;
+    }
+    const String stdLibPath = Path::combine(Path::getParentDirectory(libraryPath), kStdLibFileName);
+
+    // The file is only used if it was saved after the library was built. An older one could have been
+    // saved by a previous build that serializes the same way, but doesn't compile the same way.
+    uint64_t librarySize, libraryModifiedTime;
+    uint64_t stdLibSize, stdLibModifiedTime;
+    if (SLANG_FAILED(File::getSizeAndModifiedTime(libraryPath, librarySize, libraryModifiedTime)) ||
+        SLANG_FAILED(File::getSizeAndModifiedTime(stdLibPath, stdLibSize, stdLibModifiedTime)) ||
+        stdLibModifiedTime < libraryModifiedTime)
+    {
+        return false;
+    }
+
+    ComPtr<ISlangBlob> stdLibBlob;
+    if (SLANG_FAILED(OSFileSystemExt::getSingleton()->loadFile(stdLibPath.getBuffer(), stdLibBlob.writeRef())))
+    {
+        return false;
+    }
+    return _tryLoadStdLib(ioSession, stdLibBlob->getBufferPointer(), stdLibBlob->getBufferSize());
+}
+
+static Slang::RefPtr<Slang::Session> _createSessionWithStdLib()
 {
     Slang::RefPtr<Slang::Session> session(new Slang::Session());
     session->init();
+
+    // Use a serialized stdlib produced by the build if there is one that matches - embedded in the library,
+    // or saved next to it. The stdlib is only compiled from source if neither can be used.
+#ifdef SLANG_EMBED_STDLIB
+    size_t stdLibSize = 0;
+    const void* stdLib = get_slang_stdlib(&stdLibSize);
+    if (_tryLoadStdLib(session, stdLib, stdLibSize))
+    {
+        return session;
+    }
+#endif
+
+    if (_tryLoadStdLibFromLibraryDirectory(session))
+    {
+        return session;
+    }
+
+    session->compileStdLib();
+    return session;
+}
+
+SLANG_API SlangSession* spCreateSession(const char*)
+{
+    Slang::RefPtr<Slang::Session> session(_createSessionWithStdLib());
     // Will be returned with a refcount of 1
     return asExternal(session.detach());
 }
@@ -3176,6 +4060,19 @@ SLANG_API SlangResult slang_createGlobalSession(
     if(apiVersion != 0)
         return SLANG_E_NOT_IMPLEMENTED;
 
+    Slang::RefPtr<Slang::Session> globalSession(_createSessionWithStdLib());
+    Slang::ComPtr<slang::IGlobalSession> result(Slang::asExternal(globalSession));
+    *outGlobalSession = result.detach();
+    return SLANG_OK;
+}
+
+SLANG_API SlangResult slang_createGlobalSessionWithoutStdLib(
+    SlangInt                apiVersion,
+    slang::IGlobalSession** outGlobalSession)
+{
+    if(apiVersion != 0)
+        return SLANG_E_NOT_IMPLEMENTED;
+
     Slang::RefPtr<Slang::Session> globalSession(new Slang::Session());
     globalSession->init();
     Slang::ComPtr<slang::IGlobalSession> result(Slang::asExternal(globalSession));
@@ -3248,6 +4145,28 @@ SLANG_API SlangResult spSessionCheckPassThroughSupport(
     return Slang::checkExternalCompilerSupport(s, Slang::PassThroughMode(passThrough));
 }
 
+SLANG_API void spSessionSetDownstreamCompileResultCacheSize(
+    SlangSession*   session,
+    uint64_t        maxSizeInBytes)
+{
+    auto s = Slang::asInternal(session);
+    s->setDownstreamCompileResultCacheSize(maxSizeInBytes);
+}
+
+SLANG_API SlangResult spSessionGetDownstreamCompileResultCacheStats(
+    SlangSession*                           session,
+    SlangDownstreamCompileResultCacheStats* outStats)
+{
+    auto s = Slang::asInternal(session);
+    Slang::RefPtr<Slang::DownstreamCompileResultCache> cache = s->getDownstreamCompileResultCache();
+    if (!cache)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+    cache->getStats(*outStats);
+    return SLANG_OK;
+}
+
 SLANG_API SlangCompileRequest* spCreateCompileRequest(
     SlangSession* session)
 {
@@ -3404,6 +4323,116 @@ SLANG_API void spSetOptimizationLevel(
     linkage->optimizationLevel = Slang::OptimizationLevel(level);
 }
 
+SLANG_API void spSetParallelJobCount(
+    SlangCompileRequest*    request,
+    int                     jobCount)
+{
+    Slang::asInternal(request)->getBackEndReq()->parallelJobCount = Slang::Index(jobCount < 0 ? 1 : jobCount);
+}
+
+SLANG_API SlangResult spSetCompileCache(
+    SlangCompileRequest*    request,
+    char const*             directory,
+    uint64_t                maxSizeInBytes)
+{
+    using namespace Slang;
+    if (!request) return SLANG_ERROR_INVALID_PARAMETER;
+    auto req = asInternal(request);
+
+    if (!directory)
+    {
+        req->m_compileCache.setNull();
+        return SLANG_OK;
+    }
+
+    RefPtr<CompileCache> cache;
+    SLANG_RETURN_ON_FAIL(req->getSession()->getOrCreateCompileCache(directory, cache));
+    cache->setMaxSizeInBytes(maxSizeInBytes);
+
+    req->m_compileCache = cache;
+    return SLANG_OK;
+}
+
+SLANG_API SlangResult spGetCompileCacheStats(
+    SlangCompileRequest*    request,
+    SlangCompileCacheStats* outStats)
+{
+    using namespace Slang;
+    if (!request || !outStats) return SLANG_ERROR_INVALID_PARAMETER;
+    auto req = asInternal(request);
+
+    if (!req->m_compileCache)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+    return req->m_compileCache->getStats(*outStats);
+}
+
+SLANG_API SlangResult spGetTypeLayoutCacheStats(
+    SlangCompileRequest*        request,
+    int                         targetIndex,
+    SlangTypeLayoutCacheStats*  outStats)
+{
+    using namespace Slang;
+    if (!request || !outStats) return SLANG_ERROR_INVALID_PARAMETER;
+    auto linkage = asInternal(request)->getLinkage();
+    if (targetIndex < 0 || targetIndex >= linkage->targets.getCount())
+    {
+        return SLANG_ERROR_INVALID_PARAMETER;
+    }
+
+    TypeLayoutCache* cache = linkage->targets[targetIndex]->getTypeLayoutCache();
+    const TypeLayoutCache::Stats& stats = cache->getStats();
+
+    outStats->hitCount = stats.hitCount;
+    outStats->missCount = stats.missCount;
+    outStats->uncachedCount = stats.uncachedCount;
+    outStats->releaseCount = stats.releaseCount;
+    outStats->entryCount = uint64_t(cache->getCount());
+    return SLANG_OK;
+}
+
+SLANG_API void spSetReportPerf(
+    SlangCompileRequest*    request,
+    int                     enable)
+{
+    Slang::asInternal(request)->setReportPerf(enable != 0);
+}
+
+SLANG_API SlangInt spGetPerfReportEntryCount(
+    SlangCompileRequest*    request)
+{
+    using namespace Slang;
+    if (!request) return 0;
+    PerfReport* perfReport = asInternal(request)->getPerfReport();
+    return perfReport ? perfReport->getEntries().getCount() : 0;
+}
+
+SLANG_API SlangResult spGetPerfReportEntry(
+    SlangCompileRequest*    request,
+    SlangInt                index,
+    SlangPerfReportEntry*   outEntry)
+{
+    using namespace Slang;
+    if (!request || !outEntry) return SLANG_ERROR_INVALID_PARAMETER;
+    PerfReport* perfReport = asInternal(request)->getPerfReport();
+    if (!perfReport || index < 0 || index >= perfReport->getEntries().getCount())
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+
+    const auto& entry = perfReport->getEntries()[index];
+    outEntry->scope = entry.scope.getBuffer();
+    outEntry->name = entry.name.getBuffer();
+    outEntry->timeInSeconds = entry.timeInSeconds;
+    outEntry->instCountBefore = int64_t(entry.instCountBefore);
+    outEntry->instCountAfter = int64_t(entry.instCountAfter);
+    outEntry->arenaBytesAllocated = entry.arenaBytesAllocated;
+    outEntry->liveInstBytes = entry.liveInstBytes;
+    outEntry->peakLiveInstBytes = entry.peakLiveInstBytes;
+    return SLANG_OK;
+}
+
 
 SLANG_API void spSetOutputContainerFormat(
     SlangCompileRequest*    request,
@@ -3895,9 +4924,7 @@ spGetDependencyFileCount(
 {
     if(!request) return 0;
     auto req = Slang::asInternal(request);
-    auto frontEndReq = req->getFrontEndReq();
-    auto program = frontEndReq->getGlobalAndEntryPointsComponentType();
-    return (int) program->getFilePathDependencies().getCount();
+    return (int) req->getFilePathDependencies().getCount();
 }
 
 /** Get the path to a file this compilation dependend on.
@@ -3909,9 +4936,7 @@ spGetDependencyFilePath(
 {
     if(!request) return 0;
     auto req = Slang::asInternal(request);
-    auto frontEndReq = req->getFrontEndReq();
-    auto program = frontEndReq->getGlobalAndEntryPointsComponentType();
-    return program->getFilePathDependencies()[index].begin();
+    return req->getFilePathDependencies()[index].begin();
 }
 
 SLANG_API int
@@ -4258,6 +5283,7 @@ SLANG_API SlangResult spCompileRequest_getProgram(
 {
     if( !request ) return SLANG_ERROR_INVALID_PARAMETER;
     auto req = Slang::asInternal(request);
+    SLANG_RETURN_ON_FAIL(req->ensureProgramForCompileCacheHit());
     auto program = req->getSpecializedGlobalComponentType();
 
     *outProgram = Slang::ComPtr<slang::IComponentType>(program).detach();
@@ -4287,6 +5313,13 @@ SLANG_API SlangResult spCompileRequest_getSession(
     return SLANG_OK;
 }
 
+SLANG_API void spSession_setSpecializationCacheSize(
+    slang::ISession*    session,
+    SlangInt            maxEntryCount)
+{
+    Slang::asInternal(session)->setSpecializationCacheSize(Slang::Index(maxEntryCount));
+}
+
 SLANG_API SlangResult spCompileRequest_getEntryPoint(
     SlangCompileRequest*    request,
     SlangInt                entryPointIndex,
@@ -4294,6 +5327,7 @@ SLANG_API SlangResult spCompileRequest_getEntryPoint(
 {
     if( !request ) return SLANG_ERROR_INVALID_PARAMETER;
     auto req = Slang::asInternal(request);
+    SLANG_RETURN_ON_FAIL(req->ensureProgramForCompileCacheHit());
 
     auto entryPoint = req->getSpecializedEntryPointComponentType(entryPointIndex);
 
@@ -4308,6 +5342,12 @@ SLANG_API SlangReflection* spGetReflection(
     if( !request ) return 0;
     auto req = Slang::asInternal(request);
     auto linkage = req->getLinkage();
+
+    // Results from the compile cache are produced without parsing, so the front end has to be run
+    // to produce the layout
+    if (SLANG_FAILED(req->ensureProgramForCompileCacheHit()))
+        return nullptr;
+
     auto program = req->getSpecializedGlobalAndEntryPointsComponentType();
 
     // Note(tfoley): The API signature doesn't let the client
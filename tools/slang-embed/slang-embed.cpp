@@ -58,6 +58,7 @@ struct App
 {
     char const* appName = "slang-embed";
     char const* inputPath = nullptr;
+    bool isBinary = false;
 
     void parseOptions(int argc, char** argv)
     {
@@ -70,6 +71,14 @@ struct App
             argc--;
         }
 
+        // The input is embedded as text, unless `-binary` is specified
+        if( argc > 0 && strcmp(*argv, "-binary") == 0 )
+        {
+            isBinary = true;
+            argv++;
+            argc--;
+        }
+
         if( argc > 0 )
         {
             inputPath = *argv++;
@@ -78,9 +87,57 @@ struct App
 
         if( !inputPath || (argc != 0) )
         {
-            fprintf(stderr, "usage: %s <inputPath>\n", appName);
+            fprintf(stderr, "usage: %s [-binary] <inputPath>\n", appName);
+            exit(1);
+        }
+    }
+
+    void processBinaryInputFile(FILE* outputFile, char const* variableName)
+    {
+        // A binary file is embedded as an array of `unsigned char`,
+        // which is returned along with its size by the generated
+        // function. Unlike the text path we don't produce a `String`
+        // so the generated code has no dependency on the core library.
+        //
+        FILE* inputFile = fopen(inputPath, "rb");
+        ScopedFile inputFileCleanup(inputFile);
+        if( !inputFile )
+        {
+            fprintf(stderr, "%s: error: failed to open '%s' for reading\n", appName, inputPath);
             exit(1);
         }
+
+        fprintf(outputFile, "// generated code; do not edit\n");
+        fprintf(outputFile, "#include <stddef.h>\n\n");
+
+        fprintf(outputFile, "static const unsigned char s_%s[] =\n", variableName);
+        fprintf(outputFile, "{\n");
+
+        // Emit the bytes 16 to a line. A trailing `0` is always added, so
+        // that the array is never empty (an empty input is reported
+        // as a size of zero).
+        //
+        size_t byteCount = 0;
+        unsigned char buffer[4096];
+        size_t readCount;
+        while( (readCount = fread(buffer, 1, sizeof(buffer), inputFile)) > 0 )
+        {
+            for( size_t i = 0; i < readCount; ++i, ++byteCount )
+            {
+                fprintf(outputFile, "%u,", unsigned(buffer[i]));
+                if( (byteCount & 0xf) == 0xf )
+                {
+                    fprintf(outputFile, "\n");
+                }
+            }
+        }
+        fprintf(outputFile, "0\n};\n\n");
+
+        fprintf(outputFile, "const void* get_%s(size_t* outSize)\n", variableName);
+        fprintf(outputFile, "{\n");
+        fprintf(outputFile, "    *outSize = %zu;\n", byteCount);
+        fprintf(outputFile, "    return s_%s;\n", variableName);
+        fprintf(outputFile, "}\n");
     }
     size_t charCount = 0;
     bool useNewStringLit = true;
@@ -237,6 +294,12 @@ struct App
             }
         }
 
+        if( isBinary )
+        {
+            processBinaryInputFile(outputFile, variableName);
+            return;
+        }
+
         // With all the preliminaries out of the way, the actual
         // task of outputting the generated source file is simple.
         //
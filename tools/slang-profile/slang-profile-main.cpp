@@ -8,29 +8,1078 @@
 #include "../../slang-com-helper.h"
 
 #include "../../source/core/slang-string-util.h"
+#include "../../source/core/slang-type-text-util.h"
+
+#include "slang-profile-legacy-dictionary.h"
+
+#include <atomic>
+#include <new>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#if SLANG_WINDOWS_FAMILY
+#   define WIN32_LEAN_AND_MEAN
+#   define NOMINMAX
+#   include <windows.h>
+#   include <psapi.h>
+#   include <crtdbg.h>
+#elif SLANG_APPLE_FAMILY
+#   include <sys/resource.h>
+#   include <mach/mach.h>
+#else
+#   include <sys/resource.h>
+#   include <unistd.h>
+#endif
 
 using namespace Slang;
 
-SlangResult innerMain(int argc, char** argv)
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! Allocation counting !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+// All of the compiler is in this process. Much of its memory isn't allocated with new - List and blobs use malloc
+// directly, and a MemoryArena (as used for IR instructions) mallocs a block for many allocations. So where possible
+// malloc itself is counted, which includes new (it allocates with malloc), and counts each block of an arena:
+//
+// * With glibc, malloc and friends are replaced, forwarding to glibc's implementation.
+// * With the MSVC debug runtime, an allocation hook sees all allocations from the CRT heap.
+//
+// Otherwise only allocations with new are counted, by replacing the global operator new.
+
+static std::atomic<uint64_t> g_allocationCount;
+static std::atomic<uint64_t> g_allocatedBytes;
+
+static void _countAllocation(size_t size)
 {
-    auto stdWriters = StdWriters::initDefaultSingleton();
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+#if defined(__GLIBC__)
+
+#   define SLANG_PROFILE_COUNTS_MALLOC 1
+
+// The replacements are declared as glibc declares them (which includes the exception specification)
+extern "C"
+{
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* ptr, size_t size);
+    void* __libc_memalign(size_t alignment, size_t size);
+    void __libc_free(void* ptr);
+
+    void* malloc(size_t size) __THROW { _countAllocation(size); return __libc_malloc(size); }
+    void* calloc(size_t count, size_t size) __THROW { _countAllocation(count * size); return __libc_calloc(count, size); }
+    void* realloc(void* ptr, size_t size) __THROW { _countAllocation(size); return __libc_realloc(ptr, size); }
+    void* memalign(size_t alignment, size_t size) __THROW { _countAllocation(size); return __libc_memalign(alignment, size); }
+    void* aligned_alloc(size_t alignment, size_t size) __THROW { _countAllocation(size); return __libc_memalign(alignment, size); }
+    int posix_memalign(void** outPtr, size_t alignment, size_t size) __THROW
+    {
+        _countAllocation(size);
+        void* ptr = __libc_memalign(alignment, size);
+        if (!ptr)
+        {
+            return ENOMEM;
+        }
+        *outPtr = ptr;
+        return 0;
+    }
+    void free(void* ptr) __THROW { __libc_free(ptr); }
+}
+
+#elif defined(_MSC_VER) && defined(_DEBUG)
+
+#   define SLANG_PROFILE_COUNTS_MALLOC 1
+
+static int __cdecl _allocationHook(int allocType, void* userData, size_t size, int blockType, long requestNumber,
+    const unsigned char* fileName, int lineNumber)
+{
+    SLANG_UNUSED(userData);
+    SLANG_UNUSED(requestNumber);
+    SLANG_UNUSED(fileName);
+    SLANG_UNUSED(lineNumber);
 
-    // Time the creation of the session
+    // The CRT's own blocks aren't allocations by the compiler
+    if ((allocType == _HOOK_ALLOC || allocType == _HOOK_REALLOC) && blockType != _CRT_BLOCK)
     {
+        _countAllocation(size);
+    }
+    return TRUE;
+}
+
+#else
+
+#   define SLANG_PROFILE_COUNTS_MALLOC 0
+
+static void* _allocate(size_t size)
+{
+    _countAllocation(size);
+
+    void* ptr = ::malloc(size ? size : 1);
+    if (!ptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new(size_t size) { return _allocate(size); }
+void* operator new[](size_t size) { return _allocate(size); }
+void operator delete(void* ptr) noexcept { ::free(ptr); }
+void operator delete[](void* ptr) noexcept { ::free(ptr); }
+
+#endif
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! Measurement !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+    /// Get the current resident set size of the process in bytes, or 0 if not known
+static uint64_t _getResidentSetSize()
+{
+#if SLANG_WINDOWS_FAMILY
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return uint64_t(counters.WorkingSetSize);
+    }
+    return 0;
+#elif SLANG_APPLE_FAMILY
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) != KERN_SUCCESS)
+    {
+        return 0;
+    }
+    return uint64_t(info.resident_size);
+#else
+    // The second value is the resident size in pages
+    FILE* file = fopen("/proc/self/statm", "r");
+    if (!file)
+    {
+        return 0;
+    }
+    unsigned long long totalPages = 0, residentPages = 0;
+    const int count = fscanf(file, "%llu %llu", &totalPages, &residentPages);
+    fclose(file);
+    return (count == 2) ? uint64_t(residentPages) * uint64_t(sysconf(_SC_PAGESIZE)) : 0;
+#endif
+}
+
+    /// Get the peak resident set size of the process in bytes, or 0 if not known
+static uint64_t _getPeakResidentSetSize()
+{
+#if SLANG_WINDOWS_FAMILY
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return uint64_t(counters.PeakWorkingSetSize);
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+#   if SLANG_APPLE_FAMILY
+    // Reported in bytes
+    return uint64_t(usage.ru_maxrss);
+#   else
+    // Reported in kilobytes
+    return uint64_t(usage.ru_maxrss) * 1024;
+#   endif
+#endif
+}
+
+namespace { // anonymous
+
+    /// The measurements of repeatedly running something
+struct Measurement
+{
+    bool hasRun() const { return times.getCount() > 0; }
+
+    double getMinTime() const
+    {
+        double minTime = times.getCount() ? times[0] : 0.0;
+        for (auto time : times)
+        {
+            minTime = (time < minTime) ? time : minTime;
+        }
+        return minTime;
+    }
+    double getMedianTime() const
+    {
+        if (times.getCount() == 0)
+        {
+            return 0.0;
+        }
+        List<double> sortedTimes(times);
+        sortedTimes.sort();
+        return sortedTimes[sortedTimes.getCount() / 2];
+    }
+
+    SlangResult result = SLANG_OK;
+    String error;                           ///< The first line of the diagnostics, if it failed
+    List<double> times;                     ///< Wall time in seconds of each iteration
+    uint64_t allocationCount = 0;           ///< Allocations made by the last iteration
+    uint64_t allocatedBytes = 0;            ///< Bytes allocated by the last iteration
+    uint64_t residentSetSize = 0;           ///< RSS of the process after the last iteration
+    int64_t residentSetSizeDelta = 0;       ///< Change in the RSS of the process over the last iteration
+    uint64_t processPeakResidentSetSize = 0;    ///< Peak RSS of the process (over its whole life) after the last iteration
+};
+
+    /// Measures a function that returns a SlangResult, over warm up and timed iterations.
+    /// Stops on the first failure.
+template <typename F>
+static void _measure(Index warmUpCount, Index iterationCount, Measurement& out, const F& func)
+{
+    for (Index i = 0; i < warmUpCount; ++i)
+    {
+        out.result = func();
+        if (SLANG_FAILED(out.result))
+        {
+            return;
+        }
+    }
+
+    const double frequency = double(ProcessUtil::getClockFrequency());
+    for (Index i = 0; i < iterationCount; ++i)
+    {
+        const uint64_t startResidentSetSize = _getResidentSetSize();
+        const uint64_t startAllocationCount = g_allocationCount.load();
+        const uint64_t startAllocatedBytes = g_allocatedBytes.load();
         const auto startTick = ProcessUtil::getClockTick();
 
-        for (Int i = 0; i < 32; ++i)
+        out.result = func();
+
+        const auto endTick = ProcessUtil::getClockTick();
+
+        if (SLANG_FAILED(out.result))
+        {
+            return;
+        }
+
+        out.times.add(double(endTick - startTick) / frequency);
+        out.allocationCount = g_allocationCount.load() - startAllocationCount;
+        out.allocatedBytes = g_allocatedBytes.load() - startAllocatedBytes;
+        out.residentSetSize = _getResidentSetSize();
+        out.residentSetSizeDelta = int64_t(out.residentSetSize) - int64_t(startResidentSetSize);
+        out.processPeakResidentSetSize = _getPeakResidentSetSize();
+    }
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! JSONWriter !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+    /// Writes JSON with each member on its own line
+class JSONWriter
+{
+public:
+    void beginObject(const char* key = nullptr) { _beginValue(key); m_builder << "{"; _push(); }
+    void endObject() { _pop(); m_builder << "}"; }
+    void beginArray(const char* key = nullptr) { _beginValue(key); m_builder << "["; _push(); }
+    void endArray() { _pop(); m_builder << "]"; }
+
+    void write(const char* key, const UnownedStringSlice& value) { _beginValue(key); _writeString(value); }
+    void write(const char* key, const String& value) { write(key, value.getUnownedSlice()); }
+    void write(const char* key, const char* value) { write(key, UnownedStringSlice(value)); }
+    void write(const char* key, uint64_t value) { _beginValue(key); m_builder << value; }
+    void write(const char* key, Index value) { _beginValue(key); m_builder << value; }
+    void write(const char* key, bool value) { _beginValue(key); m_builder << (value ? "true" : "false"); }
+    void write(const char* key, double value)
+    {
+        _beginValue(key);
+        char buffer[64];
+        sprintf_s(buffer, SLANG_COUNT_OF(buffer), "%.6f", value);
+        m_builder << buffer;
+    }
+
+    const StringBuilder& getBuilder() const { return m_builder; }
+
+protected:
+    void _push() { m_isFirstStack.add(true); }
+    void _pop()
+    {
+        const bool isEmpty = m_isFirstStack.getLast();
+        m_isFirstStack.removeLast();
+        if (!isEmpty)
+        {
+            _writeNewLine();
+        }
+    }
+    void _writeNewLine()
+    {
+        m_builder << "\n";
+        for (Index i = 0; i < m_isFirstStack.getCount(); ++i)
+        {
+            m_builder << "  ";
+        }
+    }
+    void _beginValue(const char* key)
+    {
+        if (m_isFirstStack.getCount())
+        {
+            if (!m_isFirstStack.getLast())
+            {
+                m_builder << ",";
+            }
+            m_isFirstStack.getLast() = false;
+            _writeNewLine();
+        }
+        if (key)
+        {
+            _writeString(UnownedStringSlice(key));
+            m_builder << ": ";
+        }
+    }
+    void _writeString(const UnownedStringSlice& value)
+    {
+        m_builder << "\"";
+        for (const char c : value)
+        {
+            switch (c)
+            {
+                case '"':   m_builder << "\\\""; break;
+                case '\\':  m_builder << "\\\\"; break;
+                case '\n':  m_builder << "\\n"; break;
+                case '\r':  m_builder << "\\r"; break;
+                case '\t':  m_builder << "\\t"; break;
+                default:
+                {
+                    if (uint8_t(c) < 0x20)
+                    {
+                        char buffer[8];
+                        sprintf_s(buffer, SLANG_COUNT_OF(buffer), "\\u%04x", unsigned(c));
+                        m_builder << buffer;
+                    }
+                    else
+                    {
+                        m_builder.appendChar(c);
+                    }
+                    break;
+                }
+            }
+        }
+        m_builder << "\"";
+    }
+
+    StringBuilder m_builder;
+    List<bool> m_isFirstStack;              ///< For each open object/array, true if nothing has been written to it yet
+};
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! Corpus !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+struct Target
+{
+    String name;
+    SlangCompileTarget target;
+    bool isAvailable;
+};
+
+struct CorpusFile
+{
+    String path;
+    String entryPointName;
+    String stageName;
+    SlangStage stage;
+};
+
+struct Options
+{
+    List<String> paths;                     ///< Files or directories (searched recursively for .slang files)
+    List<String> targetNames;
+    Index iterationCount = 3;
+    Index warmUpCount = 1;
+    String outputPath;                      ///< If empty, the JSON is written to stdout
+    bool benchmarkDictionary = false;       ///< If set Dictionary is benchmarked, rather than the compiler
+};
+
+} // anonymous
+
+static const char* const kDefaultPaths[] = { "tests/compute", "examples" };
+static const char* const kDefaultTargetNames[] = { "hlsl", "glsl", "spirv", "cpp", "cuda" };
+
+static SlangStage _findStage(const UnownedStringSlice& name)
+{
+    static const struct
+    {
+        const char* name;
+        SlangStage stage;
+    } kStages[] =
+    {
+        { "vertex", SLANG_STAGE_VERTEX },
+        { "hull", SLANG_STAGE_HULL },
+        { "domain", SLANG_STAGE_DOMAIN },
+        { "geometry", SLANG_STAGE_GEOMETRY },
+        { "fragment", SLANG_STAGE_FRAGMENT },
+        { "pixel", SLANG_STAGE_FRAGMENT },
+        { "compute", SLANG_STAGE_COMPUTE },
+    };
+    for (const auto& info : kStages)
+    {
+        if (name == UnownedStringSlice(info.name))
+        {
+            return info.stage;
+        }
+    }
+    return SLANG_STAGE_NONE;
+}
+
+    /// Determines the entry point to compile from the test (//TEST) lines in the source. If there aren't any, a
+    /// `computeMain` is assumed to be a compute shader. Returns SLANG_E_NOT_FOUND if the entry point can't be determined.
+static SlangResult _findEntryPoint(const String& source, CorpusFile& ioFile)
+{
+    // Global generic parameters need specialization arguments, which can't be determined from the source
+    if (source.indexOf(UnownedStringSlice::fromLiteral("//TEST_IGNORE_FILE")) >= 0 ||
+        source.indexOf(UnownedStringSlice::fromLiteral("type_param ")) >= 0 ||
+        source.indexOf(UnownedStringSlice::fromLiteral("__generic_value_param ")) >= 0)
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(source.getUnownedSlice(), lines);
+
+    for (const auto& line : lines)
+    {
+        if (!line.startsWith(UnownedStringSlice::fromLiteral("//TEST")) ||
+            line.startsWith(UnownedStringSlice::fromLiteral("//TEST_INPUT")))
+        {
+            continue;
+        }
+
+        List<UnownedStringSlice> args;
+        StringUtil::split(line, ' ', args);
+
+        for (Index i = 0; i + 1 < args.getCount(); ++i)
+        {
+            if (args[i] == "-entry")
+            {
+                ioFile.entryPointName = args[i + 1];
+            }
+            else if (args[i] == "-stage")
+            {
+                ioFile.stageName = args[i + 1];
+            }
+        }
+        if (ioFile.entryPointName.getLength())
+        {
+            break;
+        }
+    }
+
+    if (ioFile.entryPointName.getLength() == 0)
+    {
+        if (source.indexOf(UnownedStringSlice::fromLiteral("computeMain")) < 0)
+        {
+            return SLANG_E_NOT_FOUND;
+        }
+        ioFile.entryPointName = "computeMain";
+    }
+    if (ioFile.stageName.getLength() == 0)
+    {
+        ioFile.stageName = "compute";
+    }
+
+    ioFile.stage = _findStage(ioFile.stageName.getUnownedSlice());
+    return (ioFile.stage != SLANG_STAGE_NONE) ? SLANG_OK : SLANG_E_NOT_FOUND;
+}
+
+static void _findSlangFiles(const String& directory, List<String>& outPaths)
+{
+    struct Visitor : public Path::Visitor
+    {
+        virtual void accept(Path::Type type, const UnownedStringSlice& filename) SLANG_OVERRIDE
+        {
+            const String path = Path::combine(m_directory, filename);
+            if (type == Path::Type::Directory)
+            {
+                m_directories.add(path);
+            }
+            else if (type == Path::Type::File && Path::getPathExt(path) == "slang")
+            {
+                m_paths->add(path);
+            }
+        }
+        String m_directory;
+        List<String>* m_paths;
+        List<String> m_directories;
+    };
+
+    Visitor visitor;
+    visitor.m_directory = directory;
+    visitor.m_paths = &outPaths;
+    Path::find(directory, nullptr, &visitor);
+
+    for (const auto& subDirectory : visitor.m_directories)
+    {
+        _findSlangFiles(subDirectory, outPaths);
+    }
+}
+
+    /// Finds the files of the corpus, in a deterministic order
+static void _findCorpus(const Options& options, List<CorpusFile>& outFiles, List<String>& outSkippedPaths)
+{
+    List<String> paths;
+    for (const auto& path : options.paths)
+    {
+        SlangPathType pathType;
+        if (SLANG_SUCCEEDED(Path::getPathType(path, &pathType)) && pathType == SLANG_PATH_TYPE_DIRECTORY)
+        {
+            _findSlangFiles(path, paths);
+        }
+        else
+        {
+            paths.add(path);
+        }
+    }
+    paths.sort();
+
+    for (const auto& path : paths)
+    {
+        String source;
+        try
+        {
+            source = File::readAllText(path);
+        }
+        catch (const IOException&)
+        {
+        }
+
+        CorpusFile file;
+        file.path = path;
+        if (source.getLength() && SLANG_SUCCEEDED(_findEntryPoint(source, file)))
+        {
+            outFiles.add(file);
+        }
+        else
+        {
+            outSkippedPaths.add(path);
+        }
+    }
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! Profiling !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+    /// Compile the file for the target. If the target is SLANG_TARGET_NONE, only the front end (parsing,
+    /// checking and lowering to IR) runs.
+static SlangResult _compile(slang::IGlobalSession* session, const CorpusFile& file, SlangCompileTarget target, String& outError)
+{
+    SlangCompileRequest* request = spCreateCompileRequest(session);
+    if (target != SLANG_TARGET_NONE)
+    {
+        spAddCodeGenTarget(request, target);
+    }
+
+    const int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceFile(request, tuIndex, file.path.getBuffer());
+    spAddEntryPoint(request, tuIndex, file.entryPointName.getBuffer(), file.stage);
+
+    const SlangResult res = spCompile(request);
+    if (SLANG_FAILED(res))
+    {
+        List<UnownedStringSlice> lines;
+        StringUtil::calcLines(UnownedStringSlice(spGetDiagnosticOutput(request)), lines);
+        outError = lines.getCount() ? String(lines[0]) : String();
+    }
+
+    spDestroyCompileRequest(request);
+    return res;
+}
+
+static void _writeMeasurement(const char* key, const char* name, const Measurement& measurement, JSONWriter& writer)
+{
+    writer.beginObject(key);
+    writer.write("name", name);
+    writer.write("result", SLANG_SUCCEEDED(measurement.result) ? "ok" : "failed");
+    if (SLANG_FAILED(measurement.result))
+    {
+        writer.write("error", measurement.error);
+    }
+    else if (measurement.hasRun())
+    {
+        writer.write("minTimeMs", measurement.getMinTime() * 1000.0);
+        writer.write("medianTimeMs", measurement.getMedianTime() * 1000.0);
+        writer.write("allocationCount", measurement.allocationCount);
+        writer.write("allocatedBytes", measurement.allocatedBytes);
+        writer.write("rssBytes", measurement.residentSetSize);
+        writer.write("rssDeltaBytes", Index(measurement.residentSetSizeDelta));
+        writer.write("processPeakRSSBytes", measurement.processPeakResidentSetSize);
+    }
+    writer.endObject();
+}
+
+namespace { // anonymous
+
+    /// The sum of the measurements of a phase over all the files it succeeded on
+struct PhaseTotal
+{
+    void add(const Measurement& measurement)
+    {
+        if (SLANG_SUCCEEDED(measurement.result) && measurement.hasRun())
+        {
+            successCount++;
+            minTime += measurement.getMinTime();
+            medianTime += measurement.getMedianTime();
+            allocationCount += measurement.allocationCount;
+            allocatedBytes += measurement.allocatedBytes;
+        }
+        else
+        {
+            failureCount++;
+        }
+    }
+
+    Index successCount = 0;
+    Index failureCount = 0;
+    double minTime = 0.0;
+    double medianTime = 0.0;
+    uint64_t allocationCount = 0;
+    uint64_t allocatedBytes = 0;
+};
+
+} // anonymous
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! Dictionary benchmark !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+// Compares Dictionary with LegacyDictionary (the implementation it replaced) on workloads modelled on how the
+// compiler uses its hottest maps. The keys come from the corpus - identifiers from the source of the corpus and the
+// standard library, and arena allocated objects standing in for IR instructions.
+
+namespace { // anonymous
+
+struct DictionaryWorkloadKeys
+{
+    List<String> identifiers;               ///< Every identifier in the sources, in order (so with repeats)
+    List<void*> objects;                    ///< Pointers to objects allocated like IR instructions
+    List<uint8_t> arena;
+};
+
+} // anonymous
+
+static void _findIdentifiers(const String& source, List<String>& outIdentifiers)
+{
+    const char* cur = source.getBuffer();
+    const char* end = cur + source.getLength();
+    while (cur < end)
+    {
+        const char c = *cur;
+        if (c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'))
+        {
+            const char* start = cur;
+            while (cur < end && (*cur == '_' || (*cur >= 'a' && *cur <= 'z') || (*cur >= 'A' && *cur <= 'Z') || (*cur >= '0' && *cur <= '9')))
+            {
+                cur++;
+            }
+            outIdentifiers.add(UnownedStringSlice(start, cur));
+        }
+        else
+        {
+            cur++;
+        }
+    }
+}
+
+static void _findDictionaryWorkloadKeys(const Options& options, DictionaryWorkloadKeys& outKeys)
+{
+    List<String> paths;
+    for (const auto& path : options.paths)
+    {
+        SlangPathType pathType;
+        if (SLANG_SUCCEEDED(Path::getPathType(path, &pathType)) && pathType == SLANG_PATH_TYPE_DIRECTORY)
+        {
+            _findSlangFiles(path, paths);
+        }
+        else
+        {
+            paths.add(path);
+        }
+    }
+    // The standard library is compiled for every session
+    _findSlangFiles("source/slang", paths);
+    paths.sort();
+
+    for (const auto& path : paths)
+    {
+        try
+        {
+            _findIdentifiers(File::readAllText(path), outKeys.identifiers);
+        }
+        catch (const IOException&)
+        {
+        }
+    }
+
+    // One object for each identifier, laid out like instructions allocated from a MemoryArena
+    const Index kObjectSize = 48;
+    const Index objectCount = outKeys.identifiers.getCount();
+    outKeys.arena.setCount(objectCount * kObjectSize);
+    for (Index i = 0; i < objectCount; ++i)
+    {
+        outKeys.objects.add(outKeys.arena.getBuffer() + i * kObjectSize);
+    }
+}
+
+    /// Interning names, as the NamePool does - mostly finding names already seen
+template <typename DictionaryType>
+static SlangResult _internNames(const DictionaryWorkloadKeys& keys)
+{
+    DictionaryType dict;
+    Index nameCount = 0;
+    for (const auto& identifier : keys.identifiers)
+    {
+        if (!dict.TryGetValueOrAdd(identifier, nameCount))
+        {
+            nameCount++;
+        }
+    }
+    return (dict.Count() == nameCount) ? SLANG_OK : SLANG_FAIL;
+}
+
+    /// Mapping from original to cloned values as when specializing or inlining a function - a map is filled,
+    /// looked up many times, and then discarded
+template <typename DictionaryType>
+static SlangResult _cloneValues(const DictionaryWorkloadKeys& keys)
+{
+    const Index kFunctionSize = 200;
+    const Index count = keys.objects.getCount();
+
+    Index foundCount = 0;
+    for (Index start = 0; start + kFunctionSize <= count; start += kFunctionSize)
+    {
+        DictionaryType clonedValues;
+        for (Index i = 0; i < kFunctionSize; ++i)
+        {
+            clonedValues.Add(keys.objects[start + i], keys.objects[count - 1 - (start + i)]);
+        }
+        // Each operand is looked up - most are in the function, some (such as types and constants) aren't
+        for (Index i = 0; i < kFunctionSize * 4; ++i)
+        {
+            const Index index = start + ((i * 7) % (kFunctionSize + kFunctionSize / 4));
+            foundCount += clonedValues.TryGetValue(keys.objects[index % count]) ? 1 : 0;
+        }
+    }
+    return foundCount ? SLANG_OK : SLANG_FAIL;
+}
+
+    /// A work list of instructions, as when eliminating dead code - entries are added and removed, with a small
+    /// amount present at any time
+template <typename DictionaryType>
+static SlangResult _workList(const DictionaryWorkloadKeys& keys)
+{
+    const Index kWindowSize = 64;
+    DictionaryType workList;
+    for (Index i = 0; i < keys.objects.getCount(); ++i)
+    {
+        workList.AddIfNotExists(keys.objects[i], i);
+        if (i >= kWindowSize)
+        {
+            workList.Remove(keys.objects[i - kWindowSize]);
+        }
+    }
+    return (workList.Count() <= kWindowSize) ? SLANG_OK : SLANG_FAIL;
+}
+
+    /// Finding deduplicated values, as global value numbering does - a large map mostly hit
+template <typename DictionaryType>
+static SlangResult _valueNumbering(const DictionaryWorkloadKeys& keys)
+{
+    DictionaryType numbering;
+    const Index count = keys.objects.getCount();
+    const Index uniqueCount = (count / 8) + 1;
+    for (Index i = 0; i < count; ++i)
+    {
+        void* key = keys.objects[(i * 31) % uniqueCount];
+        numbering.GetOrAddValue(key, i);
+    }
+    return (numbering.Count() <= uniqueCount) ? SLANG_OK : SLANG_FAIL;
+}
+
+template <typename F, typename LegacyF>
+static void _benchmarkWorkload(const char* name, const Options& options, const F& func, const LegacyF& legacyFunc, JSONWriter& writer)
+{
+    Measurement measurement, legacyMeasurement;
+    _measure(options.warmUpCount, options.iterationCount, measurement, func);
+    _measure(options.warmUpCount, options.iterationCount, legacyMeasurement, legacyFunc);
+
+    writer.beginObject();
+    writer.write("name", name);
+    _writeMeasurement("current", "Dictionary", measurement, writer);
+    _writeMeasurement("legacy", "LegacyDictionary", legacyMeasurement, writer);
+    if (measurement.hasRun() && legacyMeasurement.hasRun())
+    {
+        writer.write("speedUp", legacyMeasurement.getMinTime() / measurement.getMinTime());
+    }
+    writer.endObject();
+}
+
+static void _benchmarkDictionary(const Options& options, JSONWriter& writer)
+{
+    DictionaryWorkloadKeys keys;
+    _findDictionaryWorkloadKeys(options, keys);
+    writer.write("identifierCount", keys.identifiers.getCount());
+
+    typedef Dictionary<String, Index> NameDictionary;
+    typedef LegacyDictionary<String, Index> LegacyNameDictionary;
+    typedef Dictionary<void*, void*> CloneDictionary;
+    typedef LegacyDictionary<void*, void*> LegacyCloneDictionary;
+    typedef Dictionary<void*, Index> IndexDictionary;
+    typedef LegacyDictionary<void*, Index> LegacyIndexDictionary;
+
+    writer.beginArray("dictionary");
+    _benchmarkWorkload("internNames", options,
+        [&]() { return _internNames<NameDictionary>(keys); },
+        [&]() { return _internNames<LegacyNameDictionary>(keys); }, writer);
+    _benchmarkWorkload("cloneValues", options,
+        [&]() { return _cloneValues<CloneDictionary>(keys); },
+        [&]() { return _cloneValues<LegacyCloneDictionary>(keys); }, writer);
+    _benchmarkWorkload("workList", options,
+        [&]() { return _workList<IndexDictionary>(keys); },
+        [&]() { return _workList<LegacyIndexDictionary>(keys); }, writer);
+    _benchmarkWorkload("valueNumbering", options,
+        [&]() { return _valueNumbering<IndexDictionary>(keys); },
+        [&]() { return _valueNumbering<LegacyIndexDictionary>(keys); }, writer);
+    writer.endArray();
+}
+
+static SlangResult _parseOptions(int argc, char** argv, Options& outOptions)
+{
+    WriterHelper stdError = StdWriters::getError();
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const UnownedStringSlice arg(argv[i]);
+
+        if (arg == "-dictionary")
+        {
+            outOptions.benchmarkDictionary = true;
+        }
+        else if (arg.startsWith(UnownedStringSlice::fromLiteral("-")))
+        {
+            if (i + 1 >= argc)
+            {
+                stdError.print("error: expected a value after '%s'\n", argv[i]);
+                return SLANG_FAIL;
+            }
+            const char* value = argv[++i];
+
+            if (arg == "-target")
+            {
+                outOptions.targetNames.add(value);
+            }
+            else if (arg == "-iterations" || arg == "-warm-up")
+            {
+                const int count = atoi(value);
+                if (count < 0 || (count == 0 && arg == "-iterations"))
+                {
+                    stdError.print("error: invalid count '%s' for '%s'\n", value, argv[i - 1]);
+                    return SLANG_FAIL;
+                }
+                (arg == "-iterations" ? outOptions.iterationCount : outOptions.warmUpCount) = Index(count);
+            }
+            else if (arg == "-o")
+            {
+                outOptions.outputPath = value;
+            }
+            else
+            {
+                stdError.print("error: unknown option '%s'\n", argv[i - 1]);
+                return SLANG_FAIL;
+            }
+        }
+        else
+        {
+            outOptions.paths.add(arg);
+        }
+    }
+
+    if (outOptions.paths.getCount() == 0)
+    {
+        for (auto path : kDefaultPaths)
+        {
+            outOptions.paths.add(path);
+        }
+    }
+    if (outOptions.targetNames.getCount() == 0)
+    {
+        for (auto name : kDefaultTargetNames)
+        {
+            outOptions.targetNames.add(name);
+        }
+    }
+    return SLANG_OK;
+}
+
+    /// Profiles compiling each file of the corpus for each of the targets
+static SlangResult _profileCompiles(const Options& options, JSONWriter& writer)
+{
+    // Time the creation of the global session, which is mostly loading the stdlib
+    {
+        Measurement measurement;
+        _measure(options.warmUpCount, options.iterationCount, measurement, []() -> SlangResult
         {
             ComPtr<slang::IGlobalSession> slangSession;
             slangSession.attach(spCreateSession(nullptr));
+            return slangSession ? SLANG_OK : SLANG_FAIL;
+        });
+        _writeMeasurement("session", "createSession", measurement, writer);
+    }
+
+    ComPtr<slang::IGlobalSession> session;
+    session.attach(spCreateSession(nullptr));
+    if (!session)
+    {
+        return SLANG_FAIL;
+    }
+
+    List<Target> targets;
+    writer.beginArray("targets");
+    for (const auto& targetName : options.targetNames)
+    {
+        Target target;
+        target.name = targetName;
+        target.target = TypeTextUtil::findCompileTargetFromName(targetName.getUnownedSlice());
+        if (target.target == SLANG_TARGET_UNKNOWN)
+        {
+            StdWriters::getError().print("error: unknown target '%s'\n", targetName.getBuffer());
+            return SLANG_FAIL;
         }
+        target.isAvailable = SLANG_SUCCEEDED(spSessionCheckCompileTargetSupport(session, target.target));
+        targets.add(target);
 
-        const auto endTick = ProcessUtil::getClockTick();
+        writer.beginObject();
+        writer.write("name", target.name);
+        writer.write("available", target.isAvailable);
+        writer.endObject();
+    }
+    writer.endArray();
 
-        printf("Ticks %f\n", double(endTick - startTick) / ProcessUtil::getClockFrequency());
-        return SLANG_OK;
+    List<CorpusFile> files;
+    List<String> skippedPaths;
+    _findCorpus(options, files, skippedPaths);
+
+    PhaseTotal frontEndTotal;
+    List<PhaseTotal> targetTotals;
+    targetTotals.setCount(targets.getCount());
+
+    writer.beginArray("files");
+    for (const auto& file : files)
+    {
+        writer.beginObject();
+        writer.write("path", file.path);
+        writer.write("entryPoint", file.entryPointName);
+        writer.write("stage", file.stageName);
+
+        writer.beginArray("phases");
+        {
+            Measurement measurement;
+            _measure(options.warmUpCount, options.iterationCount, measurement, [&]() -> SlangResult
+            {
+                return _compile(session, file, SLANG_TARGET_NONE, measurement.error);
+            });
+            _writeMeasurement(nullptr, "frontEnd", measurement, writer);
+            frontEndTotal.add(measurement);
+        }
+        for (Index i = 0; i < targets.getCount(); ++i)
+        {
+            const Target& target = targets[i];
+            if (!target.isAvailable)
+            {
+                continue;
+            }
+
+            Measurement measurement;
+            _measure(options.warmUpCount, options.iterationCount, measurement, [&]() -> SlangResult
+            {
+                return _compile(session, file, target.target, measurement.error);
+            });
+            _writeMeasurement(nullptr, target.name.getBuffer(), measurement, writer);
+            targetTotals[i].add(measurement);
+        }
+        writer.endArray();
+
+        writer.endObject();
+    }
+    writer.endArray();
+
+    writer.beginArray("skipped");
+    for (const auto& path : skippedPaths)
+    {
+        writer.write(nullptr, path);
+    }
+    writer.endArray();
+
+    // The totals of each phase, over the files the phase succeeded on
+    writer.beginArray("totals");
+    for (Index i = -1; i < targets.getCount(); ++i)
+    {
+        if (i >= 0 && !targets[i].isAvailable)
+        {
+            continue;
+        }
+        const PhaseTotal& total = (i < 0) ? frontEndTotal : targetTotals[i];
+
+        writer.beginObject();
+        writer.write("name", (i < 0) ? String("frontEnd") : targets[i].name);
+        writer.write("succeeded", total.successCount);
+        writer.write("failed", total.failureCount);
+        writer.write("minTimeMs", total.minTime * 1000.0);
+        writer.write("medianTimeMs", total.medianTime * 1000.0);
+        writer.write("allocationCount", total.allocationCount);
+        writer.write("allocatedBytes", total.allocatedBytes);
+        writer.endObject();
+    }
+    writer.endArray();
+
+    return SLANG_OK;
+}
+
+SlangResult innerMain(int argc, char** argv)
+{
+#if defined(_MSC_VER) && defined(_DEBUG)
+    _CrtSetAllocHook(_allocationHook);
+#endif
+
+    auto stdWriters = StdWriters::initDefaultSingleton();
+
+    Options options;
+    SLANG_RETURN_ON_FAIL(_parseOptions(argc, argv, options));
+
+    JSONWriter writer;
+    writer.beginObject();
+    writer.write("formatVersion", Index(1));
+    writer.write("buildTag", spGetBuildTagString());
+    writer.write("iterations", options.iterationCount);
+    writer.write("warmUpIterations", options.warmUpCount);
+    writer.write("allocationsCounted", SLANG_PROFILE_COUNTS_MALLOC ? "malloc" : "new");
+
+    if (options.benchmarkDictionary)
+    {
+        _benchmarkDictionary(options, writer);
     }
+    else
+    {
+        SLANG_RETURN_ON_FAIL(_profileCompiles(options, writer));
+    }
+
+    writer.write("rssBytes", _getResidentSetSize());
+    writer.write("processPeakRSSBytes", _getPeakResidentSetSize());
+    writer.endObject();
 
+    StringBuilder json;
+    json << writer.getBuilder() << "\n";
+
+    if (options.outputPath.getLength())
+    {
+        try
+        {
+            File::writeAllText(options.outputPath, json);
+        }
+        catch (const IOException&)
+        {
+            StdWriters::getError().print("error: unable to write '%s'\n", options.outputPath.getBuffer());
+            return SLANG_FAIL;
+        }
+        return SLANG_OK;
+    }
+    StdWriters::getOut().write(json.getBuffer(), json.getLength());
     return SLANG_OK;
 }
 
@@ -0,0 +1,139 @@
+// unit-test-async-downstream-compile.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+
+#include "../../source/core/slang-downstream-compiler.h"
+#include "../../source/core/slang-blob.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-test-tool-util.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+// A compiler that 'compiles' by returning the source, tracking how many compiles run at the same time
+class TestDownstreamCompiler : public DownstreamCompiler
+{
+public:
+    typedef DownstreamCompiler Super;
+
+    virtual SlangResult compile(const CompileOptions& options, RefPtr<DownstreamCompileResult>& outResult) SLANG_OVERRIDE
+    {
+        const Index runningCount = m_runningCount.fetch_add(1) + 1;
+
+        Index maxRunningCount = m_maxRunningCount.load();
+        while (runningCount > maxRunningCount && !m_maxRunningCount.compare_exchange_weak(maxRunningCount, runningCount))
+        {
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+        m_runningCount.fetch_sub(1);
+
+        ComPtr<ISlangBlob> blob(new StringBlob(options.sourceContents));
+        outResult = new BlobDownstreamCompileResult(DownstreamDiagnostics(), blob);
+        return SLANG_OK;
+    }
+
+    TestDownstreamCompiler() :
+        Super(Desc(SLANG_PASS_THROUGH_NONE))
+    {}
+
+    std::atomic<Index> m_runningCount { 0 };
+    std::atomic<Index> m_maxRunningCount { 0 };
+};
+
+} // anonymous
+
+static const char kAsyncSource[] =
+    "RWStructuredBuffer<float> outputBuffer;\n"
+    "[numthreads(4, 1, 1)]\n"
+    "void first(uint3 tid : SV_DispatchThreadID) { outputBuffer[tid.x] = sin(float(tid.x)); }\n"
+    "[numthreads(4, 1, 1)]\n"
+    "void second(uint3 tid : SV_DispatchThreadID) { outputBuffer[tid.x] = cos(float(tid.x)); }\n"
+    "[numthreads(4, 1, 1)]\n"
+    "void third(uint3 tid : SV_DispatchThreadID) { outputBuffer[tid.x] = sqrt(float(tid.x)); }\n";
+
+static const char* const kAsyncEntryPoints[] = { "first", "second", "third" };
+
+static void asyncDownstreamCompileTest()
+{
+    // The pool runs all the jobs, and never more at the same time than it allows
+    {
+        RefPtr<TestDownstreamCompiler> compiler = new TestDownstreamCompiler;
+        RefPtr<DownstreamCompileJobPool> pool = new DownstreamCompileJobPool(2);
+        SLANG_CHECK(pool->getMaxConcurrentCount() == 2);
+
+        List<RefPtr<DownstreamCompileJob>> jobs;
+        for (Index i = 0; i < 8; ++i)
+        {
+            DownstreamCompiler::CompileOptions options;
+            options.sourceContents = String("source ") + String(i);
+
+            RefPtr<DownstreamCompileJob> job;
+            SLANG_CHECK(SLANG_SUCCEEDED(compiler->compileAsync(options, pool, job)));
+            SLANG_CHECK_ABORT(job);
+            jobs.add(job);
+        }
+
+        for (Index i = 0; i < jobs.getCount(); ++i)
+        {
+            RefPtr<DownstreamCompileResult> result;
+            SLANG_CHECK(SLANG_SUCCEEDED(jobs[i]->waitForResult(result)));
+            SLANG_CHECK(jobs[i]->isComplete());
+
+            ComPtr<ISlangBlob> blob;
+            SLANG_CHECK_ABORT(result && SLANG_SUCCEEDED(result->getBinary(blob)));
+            SLANG_CHECK(UnownedStringSlice((const char*)blob->getBufferPointer(), blob->getBufferSize()) == (String("source ") + String(i)).getUnownedSlice());
+        }
+
+        SLANG_CHECK(compiler->m_maxRunningCount.load() >= 1 && compiler->m_maxRunningCount.load() <= 2);
+    }
+
+    // Compiling multiple entry points to the CPU, where the C++ compiles are run asynchronously
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef())));
+
+    // The generated C++ includes the prelude, which is found relative to the root of the repository (the working directory)
+    if (SLANG_FAILED(spSessionCheckCompileTargetSupport(globalSession, SLANG_HOST_CALLABLE)) ||
+        !File::exists("prelude/slang-cpp-prelude.h"))
+    {
+        return;
+    }
+    TestToolUtil::setSessionDefaultPreludeFromRootPath(".", globalSession);
+
+    SlangCompileRequest* request = spCreateCompileRequest(globalSession);
+    spAddCodeGenTarget(request, SLANG_HOST_CALLABLE);
+
+    int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+    spAddTranslationUnitSourceString(request, tuIndex, "async.slang", kAsyncSource);
+    for (auto entryPointName : kAsyncEntryPoints)
+    {
+        spAddEntryPoint(request, tuIndex, entryPointName, SLANG_STAGE_COMPUTE);
+    }
+
+    SlangResult res = spCompile(request);
+    SLANG_CHECK(SLANG_SUCCEEDED(res));
+    if (SLANG_SUCCEEDED(res))
+    {
+        for (int entryPointIndex = 0; entryPointIndex < int(SLANG_COUNT_OF(kAsyncEntryPoints)); ++entryPointIndex)
+        {
+            ComPtr<ISlangSharedLibrary> sharedLibrary;
+            SLANG_CHECK(SLANG_SUCCEEDED(spGetEntryPointHostCallable(request, entryPointIndex, 0, sharedLibrary.writeRef())));
+            SLANG_CHECK(sharedLibrary && sharedLibrary->findFuncByName(kAsyncEntryPoints[entryPointIndex]) != nullptr);
+        }
+    }
+
+    spDestroyCompileRequest(request);
+}
+
+SLANG_UNIT_TEST("AsyncDownstreamCompile", asyncDownstreamCompileTest);
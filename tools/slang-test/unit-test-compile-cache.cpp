@@ -0,0 +1,179 @@
+// unit-test-compile-cache.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../source/core/slang-sha1.h"
+#include "../../source/core/slang-io.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static const char kCacheSource[] =
+    "#warning diagnostics are stored with the results\n"
+    "RWStructuredBuffer<float> outputBuffer;\n"
+    "[numthreads(4, 1, 1)]\n"
+    "void computeMain(uint3 tid : SV_DispatchThreadID) { outputBuffer[tid.x] = sin(float(tid.x)) * SCALE; }\n";
+
+namespace { // anonymous
+
+struct CompileOutput
+{
+    SlangResult result = SLANG_FAIL;
+    String diagnostics;
+    String code;
+    bool hasReflection = false;
+    unsigned parameterCount = 0;
+    String parameterName;
+    String codeAfterReflection;
+    SlangCompileCacheStats stats;
+};
+
+} // anonymous
+
+static void _compile(slang::IGlobalSession* globalSession, const String& cacheDirectory, const char* scale, CompileOutput& out)
+{
+    SlangCompileRequest* request = spCreateCompileRequest(globalSession);
+    SLANG_CHECK(SLANG_SUCCEEDED(spSetCompileCache(request, cacheDirectory.getBuffer(), 0)));
+
+    spAddCodeGenTarget(request, SLANG_HLSL);
+    spAddPreprocessorDefine(request, "SCALE", scale);
+
+    int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+    spAddTranslationUnitSourceString(request, tuIndex, "cache.slang", kCacheSource);
+    spAddEntryPoint(request, tuIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    out.result = spCompile(request);
+    out.diagnostics = spGetDiagnosticOutput(request);
+    if (SLANG_SUCCEEDED(out.result))
+    {
+        ComPtr<ISlangBlob> blob;
+        if (SLANG_SUCCEEDED(spGetEntryPointCodeBlob(request, 0, 0, blob.writeRef())))
+        {
+            out.code = String((const char*)blob->getBufferPointer(), (const char*)blob->getBufferPointer() + blob->getBufferSize());
+        }
+
+        auto reflection = (slang::ShaderReflection*)spGetReflection(request);
+        out.hasReflection = reflection != nullptr;
+        if (reflection)
+        {
+            out.parameterCount = reflection->getParameterCount();
+            if (out.parameterCount > 0)
+            {
+                out.parameterName = reflection->getParameterByIndex(0)->getName();
+            }
+        }
+
+        // Getting the reflection of a cached result doesn't lose the result
+        const char* code = spGetEntryPointSource(request, 0);
+        out.codeAfterReflection = code ? code : "";
+    }
+    SLANG_CHECK(SLANG_SUCCEEDED(spGetCompileCacheStats(request, &out.stats)));
+
+    spDestroyCompileRequest(request);
+}
+
+static void compileCacheTest()
+{
+    // Known SHA-1 digests
+    {
+        SLANG_CHECK(SHA1::compute("abc", 3).toString() == "a9993e364706816aba3e25717850c26c9cd0d89d");
+        SLANG_CHECK(SHA1::compute("", 0).toString() == "da39a3ee5e6b4b0d3255bfef95601890afd80709");
+
+        // Appending in pieces (across block boundaries) is the same as appending all at once
+        const char text[] = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+        SHA1 sha1;
+        sha1.append(text, 10);
+        sha1.append(text + 10, sizeof(text) - 1 - 10);
+        SLANG_CHECK(sha1.finalize().toString() == "84983e441c3bd26ebaae4aa1f95129e5e54670f1");
+
+        // Sized appends make the boundaries part of the digest
+        SHA1 sha1A, sha1B;
+        sha1A.appendSized(UnownedStringSlice("ab"));
+        sha1A.appendSized(UnownedStringSlice("c"));
+        sha1B.appendSized(UnownedStringSlice("a"));
+        sha1B.appendSized(UnownedStringSlice("bc"));
+        SLANG_CHECK(sha1A.finalize() != sha1B.finalize());
+    }
+
+    String cacheDirectory;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::generateTemporary(UnownedStringSlice::fromLiteral("slang-compile-cache"), cacheDirectory)));
+    // generateTemporary creates a file, the cache needs a directory
+    File::remove(cacheDirectory);
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef())));
+
+    CompileOutput first;
+    _compile(globalSession, cacheDirectory, "2.0", first);
+    SLANG_CHECK(SLANG_SUCCEEDED(first.result));
+    SLANG_CHECK(first.code.getLength() > 0);
+    SLANG_CHECK(first.diagnostics.indexOf(UnownedStringSlice::fromLiteral("diagnostics are stored")) >= 0);
+    SLANG_CHECK(first.hasReflection);
+    SLANG_CHECK(first.stats.hitCount == 0 && first.stats.missCount == 1);
+    SLANG_CHECK(first.stats.entryCount == 1 && first.stats.totalSizeInBytes > 0);
+
+    SLANG_CHECK(first.codeAfterReflection == first.code);
+
+    // The same inputs produce the same code and diagnostics from the cache. The reflection is produced
+    // by running the front end when it's asked for.
+    CompileOutput second;
+    _compile(globalSession, cacheDirectory, "2.0", second);
+    SLANG_CHECK(SLANG_SUCCEEDED(second.result));
+    SLANG_CHECK(second.code == first.code);
+    SLANG_CHECK(second.diagnostics == first.diagnostics);
+    SLANG_CHECK(second.hasReflection);
+    SLANG_CHECK(second.parameterCount == first.parameterCount && second.parameterName == first.parameterName);
+    SLANG_CHECK(second.codeAfterReflection == first.code);
+    SLANG_CHECK(second.stats.hitCount == 1 && second.stats.missCount == 1);
+    SLANG_CHECK(second.stats.entryCount == 1);
+
+    // A different option is a different entry
+    CompileOutput third;
+    _compile(globalSession, cacheDirectory, "3.0", third);
+    SLANG_CHECK(SLANG_SUCCEEDED(third.result));
+    SLANG_CHECK(third.code != first.code);
+    SLANG_CHECK(third.stats.hitCount == 1 && third.stats.missCount == 2);
+    SLANG_CHECK(third.stats.entryCount == 2);
+
+    // Entries are written to temporary files that are renamed, so only the entries are left
+    {
+        struct Visitor : public Path::Visitor
+        {
+            virtual void accept(Path::Type type, const UnownedStringSlice& filename) SLANG_OVERRIDE
+            {
+                m_fileCount += (type == Path::Type::File) ? 1 : 0;
+            }
+            Index m_fileCount = 0;
+        };
+        Visitor visitor;
+        Path::find(cacheDirectory, nullptr, &visitor);
+        SLANG_CHECK(visitor.m_fileCount == 2);
+    }
+
+    // Clean up the entries and the directory
+    {
+        struct Visitor : public Path::Visitor
+        {
+            virtual void accept(Path::Type type, const UnownedStringSlice& filename) SLANG_OVERRIDE
+            {
+                if (type == Path::Type::File)
+                {
+                    File::remove(Path::combine(m_directory, filename));
+                }
+            }
+            String m_directory;
+        };
+        Visitor visitor;
+        visitor.m_directory = cacheDirectory;
+        Path::find(cacheDirectory, nullptr, &visitor);
+        File::remove(cacheDirectory);
+    }
+}
+
+SLANG_UNIT_TEST("CompileCache", compileCacheTest);
@@ -0,0 +1,126 @@
+// unit-test-compute-dispatch.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-test-tool-util.h"
+
+#define SLANG_PRELUDE_NAMESPACE CPPPrelude
+#include "../../prelude/slang-cpp-dispatch.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static const char kSource[] =
+    "RWStructuredBuffer<uint> outputBuffer;\n"
+    "[numthreads(4, 2, 1)]\n"
+    "void computeMain(uint3 tid : SV_DispatchThreadID)\n"
+    "{\n"
+    "    uint index = tid.x + (tid.y + tid.z * 10) * 28;\n"
+    "    outputBuffer[index] = outputBuffer[index] + index + 1;\n"
+    "}\n";
+
+namespace { // anonymous
+
+// Matches the layout of the UniformState of the kernel
+struct UniformState
+{
+    CPPPrelude::RWStructuredBuffer<uint32_t> outputBuffer;
+};
+
+} // anonymous
+
+static void computeDispatchTest()
+{
+    // The chunk size picked, is always at least one group
+    SLANG_CHECK(CPPPrelude::ComputeDispatcher::calcChunkGroupCount(1, 8) == 1);
+    SLANG_CHECK(CPPPrelude::ComputeDispatcher::calcChunkGroupCount(64 * 1024, 8) == 1024);
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef())));
+
+    // The generated C++ includes the prelude, which is found relative to the root of the repository (the working directory)
+    if (SLANG_FAILED(spSessionCheckCompileTargetSupport(globalSession, SLANG_HOST_CALLABLE)) ||
+        !File::exists("prelude/slang-cpp-prelude.h"))
+    {
+        return;
+    }
+    TestToolUtil::setSessionDefaultPreludeFromRootPath(".", globalSession);
+
+    SlangCompileRequest* request = spCreateCompileRequest(globalSession);
+    spAddCodeGenTarget(request, SLANG_HOST_CALLABLE);
+    int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+    spAddTranslationUnitSourceString(request, tuIndex, "compute-dispatch.slang", kSource);
+    spAddEntryPoint(request, tuIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    const SlangResult res = spCompile(request);
+    SLANG_CHECK(SLANG_SUCCEEDED(res));
+
+    ComPtr<ISlangSharedLibrary> sharedLibrary;
+    if (SLANG_SUCCEEDED(res))
+    {
+        SLANG_CHECK(SLANG_SUCCEEDED(spGetEntryPointHostCallable(request, 0, 0, sharedLibrary.writeRef())));
+    }
+    spDestroyCompileRequest(request);
+
+    if (!sharedLibrary)
+    {
+        return;
+    }
+    auto func = (CPPPrelude::ComputeFunc)sharedLibrary->findFuncByName("computeMain");
+    SLANG_CHECK_ABORT(func);
+
+    // A grid of 7 x 5 x 3 groups of 4 x 2 threads, so 28 x 10 x 3 threads
+    const uint32_t dispatchSize[3] = { 7, 5, 3 };
+    const Index elementCount = 28 * 10 * 3;
+
+    List<uint32_t> elements;
+    elements.setCount(elementCount);
+    ::memset(elements.getBuffer(), 0, sizeof(uint32_t) * elementCount);
+
+    UniformState uniformState;
+    uniformState.outputBuffer.data = elements.getBuffer();
+    uniformState.outputBuffer.count = size_t(elementCount);
+
+    // Every thread of every group runs exactly once per dispatch, however the groups are shared out.
+    // A chunk of 4 groups doesn't fit evenly into a row of 7.
+    const uint32_t threadCounts[] = { 1, 3, 0 };
+    const uint32_t chunkGroupCounts[] = { 0, 1, 4, 1000 };
+
+    uint32_t dispatchCount = 0;
+    for (auto threadCount : threadCounts)
+    {
+        CPPPrelude::ComputeDispatcher dispatcher(threadCount);
+        SLANG_CHECK(dispatcher.getThreadCount() >= 1);
+        SLANG_CHECK(threadCount == 0 || dispatcher.getThreadCount() == threadCount);
+
+        for (auto chunkGroupCount : chunkGroupCounts)
+        {
+            dispatcher.dispatch(func, dispatchSize, nullptr, &uniformState, chunkGroupCount);
+            dispatchCount++;
+
+            bool isMatch = true;
+            for (Index i = 0; i < elementCount; ++i)
+            {
+                isMatch = isMatch && (elements[i] == uint32_t(i + 1) * dispatchCount);
+            }
+            SLANG_CHECK(isMatch);
+        }
+    }
+
+    // An empty grid does nothing
+    {
+        CPPPrelude::ComputeDispatcher dispatcher(2);
+        const uint32_t emptyDispatchSize[3] = { 7, 0, 3 };
+        dispatcher.dispatch(func, emptyDispatchSize, nullptr, &uniformState);
+        SLANG_CHECK(elements[0] == dispatchCount);
+    }
+}
+
+SLANG_UNIT_TEST("ComputeDispatch", computeDispatchTest);
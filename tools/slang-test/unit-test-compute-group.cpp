@@ -0,0 +1,176 @@
+// unit-test-compute-group.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-test-tool-util.h"
+
+#define SLANG_PRELUDE_NAMESPACE CPPPrelude
+#include "../../prelude/slang-cpp-dispatch.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+// A tree reduction in group shared memory. The barriers are in a loop, and in a function called
+// by the entry point, and the value read after each barrier was written by another invocation.
+static const char kSource[] =
+    "RWStructuredBuffer<uint> outputBuffer;\n"
+    "groupshared uint values[16];\n"
+    "void sync()\n"
+    "{\n"
+    "    GroupMemoryBarrierWithGroupSync();\n"
+    "}\n"
+    "[numthreads(16, 1, 1)]\n"
+    "void computeMain(uint3 tid : SV_DispatchThreadID, uint3 gtid : SV_GroupThreadID, uint3 gid : SV_GroupID)\n"
+    "{\n"
+    "    values[gtid.x] = tid.x;\n"
+    "    sync();\n"
+    "    for (uint stride = 8; stride > 0; stride >>= 1)\n"
+    "    {\n"
+    "        if (gtid.x < stride)\n"
+    "            values[gtid.x] += values[gtid.x + stride];\n"
+    "        AllMemoryBarrierWithGroupSync();\n"
+    "    }\n"
+    "    outputBuffer[tid.x] = values[15 - gtid.x] + (gtid.x == 15 ? values[0] : 0);\n"
+    "}\n";
+
+namespace { // anonymous
+
+// Matches the layout of the UniformState of the kernel
+struct UniformState
+{
+    CPPPrelude::RWStructuredBuffer<uint32_t> outputBuffer;
+};
+
+} // anonymous
+
+// Calculates the values of the reduction for a group on the host
+static void _calcExpected(uint32_t groupIndex, uint32_t outValues[16])
+{
+    uint32_t values[16];
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        values[i] = groupIndex * 16 + i;
+    }
+    for (uint32_t stride = 8; stride > 0; stride >>= 1)
+    {
+        for (uint32_t i = 0; i < stride; ++i)
+        {
+            values[i] += values[i + stride];
+        }
+    }
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        outValues[i] = values[15 - i] + (i == 15 ? values[0] : 0);
+    }
+}
+
+static SlangCompileRequest* _createRequest(slang::IGlobalSession* globalSession, SlangCompileTarget target)
+{
+    SlangCompileRequest* request = spCreateCompileRequest(globalSession);
+    spAddCodeGenTarget(request, target);
+    int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+    spAddTranslationUnitSourceString(request, tuIndex, "compute-group.slang", kSource);
+    spAddEntryPoint(request, tuIndex, "computeMain", SLANG_STAGE_COMPUTE);
+    return request;
+}
+
+    /// Compile the kernel with the prelude configured by preludeDefine, and check a dispatch of it
+    /// running groups on several threads
+static void _checkDispatch(slang::IGlobalSession* globalSession, const String& preludeIncludePath, const char* preludeDefine)
+{
+    StringBuilder prelude;
+    if (preludeDefine)
+    {
+        prelude << "#define " << preludeDefine << " 1\n";
+    }
+    prelude << "#include \"" << preludeIncludePath << "\"\n\n";
+    globalSession->setLanguagePrelude(SLANG_SOURCE_LANGUAGE_CPP, prelude.getBuffer());
+
+    ComPtr<ISlangSharedLibrary> sharedLibrary;
+    {
+        SlangCompileRequest* request = _createRequest(globalSession, SLANG_HOST_CALLABLE);
+        const SlangResult res = spCompile(request);
+        SLANG_CHECK(SLANG_SUCCEEDED(res));
+        if (SLANG_SUCCEEDED(res))
+        {
+            SLANG_CHECK(SLANG_SUCCEEDED(spGetEntryPointHostCallable(request, 0, 0, sharedLibrary.writeRef())));
+        }
+        spDestroyCompileRequest(request);
+    }
+    if (!sharedLibrary)
+    {
+        return;
+    }
+    auto func = (CPPPrelude::ComputeFunc)sharedLibrary->findFuncByName("computeMain");
+    SLANG_CHECK_ABORT(func);
+
+    // Groups run concurrently on several threads, each with its own group shared memory
+    const uint32_t groupCount = 64;
+    const uint32_t dispatchSize[3] = { groupCount, 1, 1 };
+    const Index elementCount = Index(groupCount) * 16;
+
+    List<uint32_t> elements;
+    elements.setCount(elementCount);
+    ::memset(elements.getBuffer(), 0, sizeof(uint32_t) * elementCount);
+
+    UniformState uniformState;
+    uniformState.outputBuffer.data = elements.getBuffer();
+    uniformState.outputBuffer.count = size_t(elementCount);
+
+    CPPPrelude::ComputeDispatcher dispatcher(4);
+    dispatcher.dispatch(func, dispatchSize, nullptr, &uniformState, 1);
+
+    bool isMatch = true;
+    for (uint32_t i = 0; i < groupCount; ++i)
+    {
+        uint32_t expected[16];
+        _calcExpected(i, expected);
+        isMatch = isMatch && (::memcmp(expected, elements.getBuffer() + i * 16, sizeof(expected)) == 0);
+    }
+    SLANG_CHECK(isMatch);
+}
+
+static void computeGroupBarrierTest()
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef())));
+
+    // Group shared memory is per thread, and a group with barriers runs its invocations as fibers
+    {
+        SlangCompileRequest* request = _createRequest(globalSession, SLANG_CPP_SOURCE);
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(spCompile(request)));
+
+        const char* source = spGetEntryPointSource(request, 0);
+        SLANG_CHECK_ABORT(source);
+        SLANG_CHECK(strstr(source, "#define SLANG_PRELUDE_ENABLE_COMPUTE_GROUP 1") != nullptr);
+        SLANG_CHECK(strstr(source, "thread_local ") != nullptr);
+        SLANG_CHECK(strstr(source, "ComputeGroupFibers::run(&computeMain_Thread,") != nullptr);
+
+        spDestroyCompileRequest(request);
+    }
+
+    // The generated C++ includes the prelude, which is found relative to the root of the repository (the working directory)
+    String preludeIncludePath;
+    if (SLANG_FAILED(spSessionCheckCompileTargetSupport(globalSession, SLANG_HOST_CALLABLE)) ||
+        SLANG_FAILED(TestToolUtil::getIncludePath(".", "prelude/slang-cpp-prelude.h", preludeIncludePath)))
+    {
+        return;
+    }
+
+    // The default way of switching between invocations for the platform
+    _checkDispatch(globalSession, preludeIncludePath, nullptr);
+#ifndef _WIN32
+    // The ucontext fallback, used on platforms without an assembly switch
+    _checkDispatch(globalSession, preludeIncludePath, "SLANG_PRELUDE_FIBER_UCONTEXT");
+#endif
+}
+
+SLANG_UNIT_TEST("ComputeGroupBarrier", computeGroupBarrierTest);
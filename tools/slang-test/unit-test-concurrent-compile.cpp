@@ -0,0 +1,150 @@
+// unit-test-concurrent-compile.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <thread>
+
+#include "test-context.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+struct CompileJob
+{
+    slang::IGlobalSession* globalSession = nullptr;
+    Index threadIndex = 0;
+    Index compileCount = 0;
+
+    List<String> outputs;
+    SlangResult result = SLANG_OK;
+};
+
+} // anonymous
+
+static SlangResult _compile(slang::IGlobalSession* globalSession, Index variant, String& outCode)
+{
+    // Each variant uses a different stdlib function, so the stdlib is used in different ways at the same time
+    const char* funcs[] = { "sin", "cos", "sqrt", "exp" };
+    const char* func = funcs[variant % SLANG_COUNT_OF(funcs)];
+
+    StringBuilder source;
+    source << "RWStructuredBuffer<float> outputBuffer;\n";
+    source << "[numthreads(4, 1, 1)]\n";
+    source << "void computeMain(uint3 tid : SV_DispatchThreadID)\n";
+    source << "{\n";
+    source << "    float3 v = float3(tid) * " << variant << ";\n";
+    source << "    outputBuffer[tid.x] = " << func << "(float(tid.x)) + dot(v, normalize(float3(1, 2, 3)));\n";
+    source << "}\n";
+
+    SlangCompileRequest* request = spCreateCompileRequest(globalSession);
+    spAddCodeGenTarget(request, SLANG_HLSL);
+    int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+    spAddTranslationUnitSourceString(request, tuIndex, "internalFile", source.getBuffer());
+    spAddEntryPoint(request, tuIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    SlangResult res = spCompile(request);
+    if (SLANG_SUCCEEDED(res))
+    {
+        const char* code = spGetEntryPointSource(request, 0);
+        if (code)
+        {
+            outCode = code;
+        }
+        else
+        {
+            res = SLANG_FAIL;
+        }
+    }
+
+    spDestroyCompileRequest(request);
+    return res;
+}
+
+static void _runCompileJob(CompileJob* job)
+{
+    for (Index i = 0; i < job->compileCount; ++i)
+    {
+        String code;
+        SlangResult res = _compile(job->globalSession, job->threadIndex + i, code);
+        if (SLANG_FAILED(res))
+        {
+            job->result = res;
+            return;
+        }
+        job->outputs.add(code);
+    }
+}
+
+static const Index kThreadCount = 4;
+static const Index kCompileCount = 3;
+
+static void _checkConcurrentCompile(slang::IGlobalSession* globalSession, const List<String>& expected)
+{
+    // Compile on multiple threads, all sharing the one global session (and so stdlib)
+    List<CompileJob> jobs;
+    jobs.setCount(kThreadCount);
+
+    List<std::thread> threads;
+    for (Index i = 0; i < kThreadCount; ++i)
+    {
+        CompileJob& job = jobs[i];
+        job.globalSession = globalSession;
+        job.threadIndex = i;
+        job.compileCount = kCompileCount;
+
+        threads.add(std::thread(_runCompileJob, &job));
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (const auto& job : jobs)
+    {
+        SLANG_CHECK(SLANG_SUCCEEDED(job.result));
+        SLANG_CHECK(job.outputs.getCount() == kCompileCount);
+
+        for (Index i = 0; i < job.outputs.getCount(); ++i)
+        {
+            SLANG_CHECK(job.outputs[i] == expected[job.threadIndex + i]);
+        }
+    }
+}
+
+static void concurrentCompileTest()
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef())));
+
+    // Compile everything on one thread to get the expected output
+    List<String> expected;
+    for (Index i = 0; i < kThreadCount + kCompileCount; ++i)
+    {
+        String code;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compile(globalSession, i, code)));
+        expected.add(code);
+    }
+
+    _checkConcurrentCompile(globalSession, expected);
+
+    // A loaded stdlib creates parts of itself on demand. Use a fresh session, such that
+    // this happens on multiple threads at the same time.
+    {
+        ComPtr<ISlangBlob> stdLibBlob;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(globalSession->saveStdLib(stdLibBlob.writeRef())));
+
+        ComPtr<slang::IGlobalSession> loadedSession;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSessionWithoutStdLib(SLANG_API_VERSION, loadedSession.writeRef())));
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(loadedSession->loadStdLib(stdLibBlob->getBufferPointer(), stdLibBlob->getBufferSize())));
+
+        _checkConcurrentCompile(loadedSession, expected);
+    }
+}
+
+SLANG_UNIT_TEST("ConcurrentCompile", concurrentCompileTest);
@@ -0,0 +1,267 @@
+// unit-test-cpu-simd.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-test-tool-util.h"
+
+#define SLANG_PRELUDE_NAMESPACE CPPPrelude
+#include "../../prelude/slang-cpp-dispatch.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+// Invocations diverge on both the branch and the loop trip count. As it has a loop, the kernel
+// isn't emitted lane wide, and instead the loop over the invocations is marked for vectorization.
+static const char kLoopSource[] =
+    "RWStructuredBuffer<uint> outputBuffer;\n"
+    "[numthreads(8, 2, 1)]\n"
+    "void computeMain(uint3 tid : SV_DispatchThreadID)\n"
+    "{\n"
+    "    uint index = tid.x + tid.y * 24;\n"
+    "    uint value = index;\n"
+    "    if ((index & 1) != 0)\n"
+    "        value = value * 3;\n"
+    "    for (uint i = 0; i < (index & 3); ++i)\n"
+    "        value += i;\n"
+    "    outputBuffer[index] = value;\n"
+    "}\n";
+
+// Has no loops, so is emitted lane wide. The size of a group is not a multiple of the amount of lanes,
+// so the last lanes are inactive, and the integer division must only run for the active lanes.
+static const char kLanesSource[] =
+    "RWStructuredBuffer<uint> outputBuffer;\n"
+    "[numthreads(5, 3, 1)]\n"
+    "void computeMain(uint3 tid : SV_DispatchThreadID)\n"
+    "{\n"
+    "    uint index = tid.x + tid.y * 15;\n"
+    "    uint value;\n"
+    "    if ((index % 3) == 0)\n"
+    "        value = index * 5 + 1;\n"
+    "    else if ((index & 1) != 0)\n"
+    "        value = 1000 / (index | 1);\n"
+    "    else\n"
+    "        value = index + 7;\n"
+    "    outputBuffer[index] = value * 2;\n"
+    "}\n";
+
+namespace { // anonymous
+
+// Matches the layout of the UniformState of the kernel
+struct UniformState
+{
+    CPPPrelude::RWStructuredBuffer<uint32_t> outputBuffer;
+};
+
+} // anonymous
+
+static uint32_t _calcLoopExpected(uint32_t index)
+{
+    uint32_t value = index;
+    if ((index & 1) != 0)
+        value = value * 3;
+    for (uint32_t i = 0; i < (index & 3); ++i)
+        value += i;
+    return value;
+}
+
+static uint32_t _calcLanesExpected(uint32_t index)
+{
+    uint32_t value;
+    if ((index % 3) == 0)
+        value = index * 5 + 1;
+    else if ((index & 1) != 0)
+        value = 1000 / (index | 1);
+    else
+        value = index + 7;
+    return value * 2;
+}
+
+namespace { // anonymous
+
+struct Kernel
+{
+    const char* source;
+    Index elementCount;                         ///< The amount of elements written by the dispatch
+    uint32_t (*calcExpected)(uint32_t index);
+};
+
+} // anonymous
+
+    /// True if the CPU running the test can run code compiled for the mode
+static bool _isModeSupportedByCPU(const char* mode)
+{
+    if (strcmp(mode, "avx2") == 0)
+    {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+        return false;
+#endif
+    }
+    return true;
+}
+
+static SlangCompileRequest* _createRequest(slang::IGlobalSession* globalSession, const char* source, SlangCompileTarget target, const char* mode = "sse")
+{
+    SlangCompileRequest* request = spCreateCompileRequest(globalSession);
+
+    const char* args[] = { "-cpu-simd", mode };
+    SLANG_CHECK(SLANG_SUCCEEDED(spProcessCommandLineArguments(request, args, SLANG_COUNT_OF(args))));
+
+    spAddCodeGenTarget(request, target);
+    int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+    spAddTranslationUnitSourceString(request, tuIndex, "cpu-simd.slang", source);
+    spAddEntryPoint(request, tuIndex, "computeMain", SLANG_STAGE_COMPUTE);
+    return request;
+}
+
+    /// Compile the kernel for the SIMD mode, and run it over a grid of 3 x 5 groups
+static bool _dispatch(slang::IGlobalSession* globalSession, const Kernel& kernel, const char* mode, List<uint32_t>& outElements)
+{
+    ComPtr<ISlangSharedLibrary> sharedLibrary;
+    {
+        SlangCompileRequest* request = _createRequest(globalSession, kernel.source, SLANG_HOST_CALLABLE, mode);
+        const SlangResult res = spCompile(request);
+        SLANG_CHECK(SLANG_SUCCEEDED(res));
+        if (SLANG_SUCCEEDED(res))
+        {
+            SLANG_CHECK(SLANG_SUCCEEDED(spGetEntryPointHostCallable(request, 0, 0, sharedLibrary.writeRef())));
+        }
+        spDestroyCompileRequest(request);
+    }
+    if (!sharedLibrary)
+    {
+        return false;
+    }
+    auto func = (CPPPrelude::ComputeFunc)sharedLibrary->findFuncByName("computeMain");
+    SLANG_CHECK(func);
+    if (!func)
+    {
+        return false;
+    }
+
+    const uint32_t dispatchSize[3] = { 3, 5, 1 };
+    const Index elementCount = kernel.elementCount;
+
+    outElements.setCount(elementCount);
+    ::memset(outElements.getBuffer(), 0, sizeof(uint32_t) * elementCount);
+
+    UniformState uniformState;
+    uniformState.outputBuffer.data = outElements.getBuffer();
+    uniformState.outputBuffer.count = size_t(elementCount);
+
+    CPPPrelude::ComputeDispatcher dispatcher(2);
+    dispatcher.dispatch(func, dispatchSize, nullptr, &uniformState);
+    return true;
+}
+
+    /// Check the scalar path gives the expected results, and each SIMD mode the CPU can run the same results
+static void _checkModes(slang::IGlobalSession* globalSession, const Kernel& kernel)
+{
+    List<uint32_t> scalarElements;
+    const char* modes[] = { "none", "sse", "avx2" };
+    for (const char* mode : modes)
+    {
+        if (!_isModeSupportedByCPU(mode))
+        {
+            continue;
+        }
+
+        List<uint32_t> elements;
+        if (!_dispatch(globalSession, kernel, mode, elements))
+        {
+            continue;
+        }
+
+        if (strcmp(mode, "none") == 0)
+        {
+            bool isMatch = true;
+            for (Index i = 0; i < elements.getCount(); ++i)
+            {
+                isMatch = isMatch && (elements[i] == kernel.calcExpected(uint32_t(i)));
+            }
+            SLANG_CHECK(isMatch);
+            scalarElements = elements;
+        }
+        else
+        {
+            SLANG_CHECK(elements.getCount() == scalarElements.getCount() &&
+                ::memcmp(elements.getBuffer(), scalarElements.getBuffer(), sizeof(uint32_t) * elements.getCount()) == 0);
+        }
+    }
+}
+
+static void cpuSIMDTest()
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef())));
+
+    // An unknown mode is an error
+    {
+        SlangCompileRequest* request = spCreateCompileRequest(globalSession);
+        const char* args[] = { "-cpu-simd", "mmx" };
+        SLANG_CHECK(SLANG_FAILED(spProcessCommandLineArguments(request, args, SLANG_COUNT_OF(args))));
+        spDestroyCompileRequest(request);
+    }
+
+    // The loop over the invocations of a group is marked for vectorization, with each lane
+    // having its own thread input
+    {
+        SlangCompileRequest* request = _createRequest(globalSession, kLoopSource, SLANG_CPP_SOURCE);
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(spCompile(request)));
+
+        const char* source = spGetEntryPointSource(request, 0);
+        SLANG_CHECK_ABORT(source);
+        SLANG_CHECK(strstr(source, "SLANG_SIMD_LOOP\n") != nullptr);
+        SLANG_CHECK(strstr(source, "_computeMain(&laneInput,") != nullptr);
+        SLANG_CHECK(strstr(source, "SLANG_FORCE_INLINE void _computeMain(") != nullptr);
+        SLANG_CHECK(strstr(source, "_computeMain_Lanes(") == nullptr);
+
+        spDestroyCompileRequest(request);
+    }
+
+    // A kernel without loops is run through its lane wide version, with a mask of the active lanes per block
+    {
+        SlangCompileRequest* request = _createRequest(globalSession, kLanesSource, SLANG_CPP_SOURCE, "avx2");
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(spCompile(request)));
+
+        const char* source = spGetEntryPointSource(request, 0);
+        SLANG_CHECK_ABORT(source);
+        SLANG_CHECK(strstr(source, "static void _computeMain_Lanes(const int32_t* laneMask,") != nullptr);
+        SLANG_CHECK(strstr(source, "_computeMain_Lanes(laneMask, laneInputs, entryPointParams, globalParams);") != nullptr);
+        SLANG_CHECK(strstr(source, "for (int _l = 0; _l < 8; ++_l)") != nullptr);
+        SLANG_CHECK(strstr(source, "isAnyLaneActive(") != nullptr);
+        SLANG_CHECK(strstr(source, "_computeMain(&laneInput,") == nullptr);
+
+        spDestroyCompileRequest(request);
+    }
+
+    // The generated C++ includes the prelude, which is found relative to the root of the repository (the working directory)
+    if (SLANG_FAILED(spSessionCheckCompileTargetSupport(globalSession, SLANG_HOST_CALLABLE)) ||
+        !File::exists("prelude/slang-cpp-prelude.h"))
+    {
+        return;
+    }
+    TestToolUtil::setSessionDefaultPreludeFromRootPath(".", globalSession);
+
+    // The scalar path, and each SIMD mode the CPU can run, produce the same (expected) results
+    const Kernel kernels[] =
+    {
+        { kLoopSource, 24 * 10, &_calcLoopExpected },       // Groups of 8 x 2
+        { kLanesSource, 15 * 15, &_calcLanesExpected },     // Groups of 5 x 3
+    };
+    for (const Kernel& kernel : kernels)
+    {
+        _checkModes(globalSession, kernel);
+    }
+}
+
+SLANG_UNIT_TEST("CPUSIMD", cpuSIMDTest);
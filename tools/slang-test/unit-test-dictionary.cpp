@@ -0,0 +1,168 @@
+// unit-test-dictionary.cpp
+
+#include "../../source/core/slang-dictionary.h"
+#include "../../source/core/slang-string.h"
+#include "../../source/core/slang-random-generator.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+// A key whose hash codes all collide, so keys are only told apart by comparison
+struct CollidingKey
+{
+    HashCode getHashCode() const { return 7; }
+    bool operator==(const CollidingKey& rhs) const { return value == rhs.value; }
+
+    int value = 0;
+};
+
+} // anonymous
+
+static void dictionaryTest()
+{
+    // Adding, finding and removing, checked against a list of which keys should be present
+    {
+        RefPtr<RandomGenerator> rand = RandomGenerator::create(0x12345);
+
+        const int kMaxKey = 2000;
+        List<int> expected;
+        expected.setCount(kMaxKey);
+        for (auto& value : expected)
+        {
+            value = -1;
+        }
+
+        Dictionary<int, int> dict;
+        int expectedCount = 0;
+
+        for (int i = 0; i < 100000; ++i)
+        {
+            const int key = rand->nextInt32InRange(0, kMaxKey);
+            const int op = rand->nextInt32InRange(0, 4);
+
+            if (op < 2)
+            {
+                const bool added = dict.AddIfNotExists(key, i);
+                SLANG_CHECK(added == (expected[key] < 0));
+                if (added)
+                {
+                    expected[key] = i;
+                    expectedCount++;
+                }
+            }
+            else if (op == 2)
+            {
+                dict[key] = i;
+                expectedCount += (expected[key] < 0) ? 1 : 0;
+                expected[key] = i;
+            }
+            else
+            {
+                dict.Remove(key);
+                expectedCount -= (expected[key] < 0) ? 0 : 1;
+                expected[key] = -1;
+            }
+            SLANG_CHECK(dict.Count() == expectedCount);
+        }
+
+        for (int key = 0; key < kMaxKey; ++key)
+        {
+            int* value = dict.TryGetValue(key);
+            SLANG_CHECK((value != nullptr) == (expected[key] >= 0));
+            SLANG_CHECK(!value || *value == expected[key]);
+        }
+
+        // Iteration visits every pair once
+        int iterCount = 0;
+        for (const auto& pair : dict)
+        {
+            SLANG_CHECK(expected[pair.Key] == pair.Value);
+            iterCount++;
+        }
+        SLANG_CHECK(iterCount == expectedCount);
+
+        // Copies are independent
+        Dictionary<int, int> copy(dict);
+        SLANG_CHECK(copy.Count() == dict.Count());
+        copy.Clear();
+        SLANG_CHECK(copy.Count() == 0 && copy.begin() == copy.end());
+        SLANG_CHECK(dict.Count() == expectedCount);
+
+        Dictionary<int, int> moved(_Move(dict));
+        SLANG_CHECK(moved.Count() == expectedCount && dict.Count() == 0);
+        SLANG_CHECK(!dict.ContainsKey(0));
+    }
+
+    // Many adds and removes of different keys, with a small amount of keys present at a time. The slots become
+    // deleted and need to be reclaimed, without the dictionary growing.
+    {
+        Dictionary<int, int> dict;
+        for (int i = 0; i < 100000; ++i)
+        {
+            dict.Add(i, i);
+            if (i >= 8)
+            {
+                dict.Remove(i - 8);
+            }
+        }
+        SLANG_CHECK(dict.Count() == 8);
+        for (int i = 100000 - 8; i < 100000; ++i)
+        {
+            SLANG_CHECK(dict.ContainsKey(i));
+        }
+    }
+
+    // Keys whose hashes collide
+    {
+        Dictionary<CollidingKey, int> dict;
+        for (int i = 0; i < 100; ++i)
+        {
+            CollidingKey key;
+            key.value = i;
+            dict.Add(key, i * 2);
+        }
+        for (int i = 0; i < 100; i += 2)
+        {
+            CollidingKey key;
+            key.value = i;
+            dict.Remove(key);
+        }
+        SLANG_CHECK(dict.Count() == 50);
+        for (int i = 0; i < 100; ++i)
+        {
+            CollidingKey key;
+            key.value = i;
+            int value = -1;
+            SLANG_CHECK(dict.TryGetValue(key, value) == ((i & 1) != 0));
+            SLANG_CHECK((i & 1) == 0 || value == i * 2);
+        }
+    }
+
+    // String keys, and values that hold references
+    {
+        Dictionary<String, String> dict;
+        for (int i = 0; i < 1000; ++i)
+        {
+            dict.Add(String("key") + String(i), String(i));
+        }
+        SLANG_CHECK(dict.GetOrAddValue("key10", "none") == "10");
+        SLANG_CHECK(dict.GetOrAddValue("new", "none") == "none");
+        SLANG_CHECK(dict.TryGetValueOrAdd("key20", "none") != nullptr);
+        SLANG_CHECK(dict.TryGetValueOrAdd("other", "value") == nullptr);
+        SLANG_CHECK(dict.Count() == 1002);
+
+        String value;
+        SLANG_CHECK(dict.TryGetValue("other", value) && value == "value");
+        SLANG_CHECK(!dict.ContainsKey("key1000"));
+
+        HashSet<String> set;
+        SLANG_CHECK(set.Add("a") && !set.Add("a") && set.Add("b"));
+        set.Remove("a");
+        SLANG_CHECK(!set.Contains("a") && set.Contains("b") && set.Count() == 1);
+    }
+}
+
+SLANG_UNIT_TEST("Dictionary", dictionaryTest);
@@ -0,0 +1,255 @@
+// unit-test-downstream-compile-result-cache.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../source/core/slang-downstream-compiler.h"
+#include "../../source/core/slang-blob.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-test-tool-util.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+// A compiler that 'compiles' by returning the source
+class TestDownstreamCompiler : public DownstreamCompiler
+{
+public:
+    typedef DownstreamCompiler Super;
+
+    virtual SlangResult compile(const CompileOptions& options, RefPtr<DownstreamCompileResult>& outResult) SLANG_OVERRIDE
+    {
+        DownstreamDiagnostics diagnostics;
+        diagnostics.result = SLANG_OK;
+
+        DownstreamDiagnostic diagnostic;
+        diagnostic.reset();
+        diagnostic.type = DownstreamDiagnostic::Type::Warning;
+        diagnostic.text = "a warning";
+        diagnostics.diagnostics.add(diagnostic);
+
+        ComPtr<ISlangBlob> blob(new StringBlob(options.sourceContents));
+        outResult = new BlobDownstreamCompileResult(diagnostics, blob);
+        return SLANG_OK;
+    }
+
+    virtual SlangResult getPath(String& outPath) SLANG_OVERRIDE
+    {
+        outPath = m_path;
+        return m_path.getLength() ? SLANG_OK : SLANG_E_NOT_AVAILABLE;
+    }
+
+    TestDownstreamCompiler(Int majorVersion) :
+        Super(Desc(SLANG_PASS_THROUGH_GCC, majorVersion))
+    {}
+
+    String m_path;                  ///< The compiler's file, if set
+};
+
+} // anonymous
+
+static String _getBinaryText(DownstreamCompileResult* result)
+{
+    ComPtr<ISlangBlob> blob;
+    if (!result || SLANG_FAILED(result->getBinary(blob)))
+    {
+        return String();
+    }
+    return String((const char*)blob->getBufferPointer(), (const char*)blob->getBufferPointer() + blob->getBufferSize());
+}
+
+static const char kResultCacheSource[] =
+    "RWStructuredBuffer<float> outputBuffer;\n"
+    "[numthreads(4, 1, 1)]\n"
+    "void computeMain(uint3 tid : SV_DispatchThreadID) { outputBuffer[tid.x] = sin(float(tid.x)); }\n";
+
+static SlangResult _compileSharedLibrary(slang::IGlobalSession* globalSession, String& outBinary)
+{
+    SlangCompileRequest* request = spCreateCompileRequest(globalSession);
+    spAddCodeGenTarget(request, SLANG_SHARED_LIBRARY);
+
+    int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+    spAddTranslationUnitSourceString(request, tuIndex, "result-cache.slang", kResultCacheSource);
+    spAddEntryPoint(request, tuIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    SlangResult res = spCompile(request);
+    if (SLANG_SUCCEEDED(res))
+    {
+        ComPtr<ISlangBlob> blob;
+        res = spGetEntryPointCodeBlob(request, 0, 0, blob.writeRef());
+        if (SLANG_SUCCEEDED(res))
+        {
+            outBinary = String((const char*)blob->getBufferPointer(), (const char*)blob->getBufferPointer() + blob->getBufferSize());
+        }
+    }
+
+    spDestroyCompileRequest(request);
+    return res;
+}
+
+static void downstreamCompileResultCacheTest()
+{
+    RefPtr<TestDownstreamCompiler> compiler = new TestDownstreamCompiler(9);
+
+    // Keys
+    {
+        DownstreamCompiler::CompileOptions options;
+        options.sourceContents = "int main() { return 0; }";
+
+        DownstreamCompileResultCache::Key key, otherKey;
+        SLANG_CHECK(SLANG_SUCCEEDED(DownstreamCompileResultCache::calcKey(compiler, options, key)));
+
+        // Where the output is written doesn't change the result
+        options.modulePath = "somewhere/else";
+        SLANG_CHECK(SLANG_SUCCEEDED(DownstreamCompileResultCache::calcKey(compiler, options, otherKey)));
+        SLANG_CHECK(key == otherKey);
+
+        // Anything that changes what is compiled, or how, does
+        options.optimizationLevel = DownstreamCompiler::OptimizationLevel::Maximal;
+        SLANG_CHECK(SLANG_SUCCEEDED(DownstreamCompileResultCache::calcKey(compiler, options, otherKey)));
+        SLANG_CHECK(key != otherKey);
+        options.optimizationLevel = DownstreamCompiler::OptimizationLevel::Default;
+
+        DownstreamCompiler::Define define;
+        define.nameWithSig = "VALUE";
+        define.value = "1";
+        options.defines.add(define);
+        SLANG_CHECK(SLANG_SUCCEEDED(DownstreamCompileResultCache::calcKey(compiler, options, otherKey)));
+        SLANG_CHECK(key != otherKey);
+        options.defines.clear();
+
+        RefPtr<TestDownstreamCompiler> otherVersionCompiler = new TestDownstreamCompiler(10);
+        SLANG_CHECK(SLANG_SUCCEEDED(DownstreamCompileResultCache::calcKey(otherVersionCompiler, options, otherKey)));
+        SLANG_CHECK(key != otherKey);
+
+        // A compiler that doesn't report a version (as for fxc, dxc and glslang) is told apart by its file. Compiles that
+        // invoke such a compiler's library directly key on its identity, followed by their arguments and source.
+        String compilerPath;
+        if (SLANG_SUCCEEDED(File::generateTemporary(UnownedStringSlice::fromLiteral("result-cache-compiler"), compilerPath)))
+        {
+            File::writeAllText(compilerPath, "compiler");
+
+            RefPtr<TestDownstreamCompiler> fileCompiler = new TestDownstreamCompiler(9);
+            fileCompiler->m_path = compilerPath;
+            SLANG_CHECK(SLANG_SUCCEEDED(DownstreamCompileResultCache::calcKey(fileCompiler, options, otherKey)));
+            SLANG_CHECK(key != otherKey);
+
+            SHA1 sha1;
+            DownstreamCompileResultCache::appendCompilerToKey(fileCompiler, sha1);
+            const DownstreamCompileResultCache::Key compilerKey = sha1.finalize();
+
+            // Replacing the compiler in place changes its identity
+            File::writeAllText(compilerPath, "replaced compiler");
+            SHA1 replacedSHA1;
+            DownstreamCompileResultCache::appendCompilerToKey(fileCompiler, replacedSHA1);
+            SLANG_CHECK(compilerKey != replacedSHA1.finalize());
+
+            DownstreamCompileResultCache::Key replacedKey;
+            SLANG_CHECK(SLANG_SUCCEEDED(DownstreamCompileResultCache::calcKey(fileCompiler, options, replacedKey)));
+            SLANG_CHECK(replacedKey != otherKey);
+
+            File::remove(compilerPath);
+        }
+
+        // The contents of files aren't known from the options
+        options.sourceFiles.add("source.cpp");
+        SLANG_CHECK(DownstreamCompileResultCache::calcKey(compiler, options, otherKey) == SLANG_E_NOT_AVAILABLE);
+    }
+
+    // Finding, adding and eviction
+    {
+        RefPtr<DownstreamCompileResultCache> cache = new DownstreamCompileResultCache(1024 * 1024);
+
+        List<DownstreamCompileResultCache::Key> keys;
+        for (Index i = 0; i < 3; ++i)
+        {
+            DownstreamCompiler::CompileOptions options;
+            options.sourceContents = String("source ") + String(i);
+
+            DownstreamCompileResultCache::Key key;
+            SLANG_CHECK(SLANG_SUCCEEDED(DownstreamCompileResultCache::calcKey(compiler, options, key)));
+            keys.add(key);
+
+            SLANG_CHECK(cache->find(key) == nullptr);
+
+            RefPtr<DownstreamCompileResult> result;
+            SLANG_CHECK(SLANG_SUCCEEDED(compiler->compile(options, result)));
+            RefPtr<DownstreamCompileResult> heldResult = cache->add(key, result);
+            SLANG_CHECK(_getBinaryText(heldResult) == options.sourceContents);
+        }
+
+        // The held results have the binary and the diagnostics
+        RefPtr<DownstreamCompileResult> found = cache->find(keys[1]);
+        SLANG_CHECK(_getBinaryText(found) == "source 1");
+        SLANG_CHECK_ABORT(found);
+        SLANG_CHECK(found->getDiagnostics().getCountByType(DownstreamDiagnostic::Type::Warning) == 1);
+
+        SlangDownstreamCompileResultCacheStats stats;
+        cache->getStats(stats);
+        SLANG_CHECK(stats.hitCount == 1 && stats.missCount == 3 && stats.evictedCount == 0);
+        SLANG_CHECK(stats.entryCount == 3 && stats.totalSizeInBytes > 0);
+
+        // Failed compiles aren't held
+        {
+            DownstreamDiagnostics diagnostics;
+            diagnostics.result = SLANG_OK;
+            DownstreamDiagnostic diagnostic;
+            diagnostic.reset();
+            diagnostic.type = DownstreamDiagnostic::Type::Error;
+            diagnostics.diagnostics.add(diagnostic);
+
+            DownstreamCompileResultCache::Key key = SHA1::compute("failed", 6);
+            RefPtr<DownstreamCompileResult> failedResult = new BlobDownstreamCompileResult(diagnostics, nullptr);
+            SLANG_CHECK(cache->add(key, failedResult) == failedResult);
+            SLANG_CHECK(cache->find(key) == nullptr);
+        }
+
+        // Shrinking evicts the least recently used. keys[1] was found after the others were added, so is kept.
+        const uint64_t entrySize = stats.totalSizeInBytes / 3;
+        cache->setMaxSizeInBytes(entrySize + entrySize / 2);
+        cache->getStats(stats);
+        SLANG_CHECK(stats.entryCount == 1 && stats.evictedCount == 2);
+        SLANG_CHECK(cache->find(keys[1]) != nullptr);
+        SLANG_CHECK(cache->find(keys[0]) == nullptr);
+        SLANG_CHECK(cache->find(keys[2]) == nullptr);
+    }
+
+    // Through the API
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef())));
+
+    SlangDownstreamCompileResultCacheStats stats;
+    SLANG_CHECK(spSessionGetDownstreamCompileResultCacheStats(globalSession, &stats) == SLANG_E_NOT_AVAILABLE);
+
+    // The generated C++ includes the prelude, which is found relative to the root of the repository (the working directory)
+    if (SLANG_FAILED(spSessionCheckCompileTargetSupport(globalSession, SLANG_SHARED_LIBRARY)) ||
+        !File::exists("prelude/slang-cpp-prelude.h"))
+    {
+        return;
+    }
+    TestToolUtil::setSessionDefaultPreludeFromRootPath(".", globalSession);
+
+    spSessionSetDownstreamCompileResultCacheSize(globalSession, 64 * 1024 * 1024);
+
+    // The second request generates the same C++, so the compiler isn't invoked again
+    String firstBinary, secondBinary;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compileSharedLibrary(globalSession, firstBinary)));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compileSharedLibrary(globalSession, secondBinary)));
+    SLANG_CHECK(firstBinary.getLength() > 0 && firstBinary == secondBinary);
+
+    SLANG_CHECK(SLANG_SUCCEEDED(spSessionGetDownstreamCompileResultCacheStats(globalSession, &stats)));
+    SLANG_CHECK(stats.hitCount == 1 && stats.missCount == 1 && stats.entryCount == 1);
+
+    // Disabling releases the results
+    spSessionSetDownstreamCompileResultCacheSize(globalSession, 0);
+    SLANG_CHECK(spSessionGetDownstreamCompileResultCacheStats(globalSession, &stats) == SLANG_E_NOT_AVAILABLE);
+}
+
+SLANG_UNIT_TEST("DownstreamCompileResultCache", downstreamCompileResultCacheTest);
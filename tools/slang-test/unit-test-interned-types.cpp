@@ -0,0 +1,64 @@
+// unit-test-interned-types.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../source/core/slang-basic.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static const char kSource[] =
+    "struct Thing { float value; };\n"
+    "struct Box<T> { T item; };\n"
+    "typedef Thing OtherThing;\n"
+    "RWStructuredBuffer<float> outputBuffer;\n"
+    "[numthreads(1, 1, 1)]\n"
+    "void computeMain() { Box<Thing> box; box.item.value = 1.0; outputBuffer[0] = box.item.value; }\n";
+
+static void internedTypesTest()
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef())));
+
+    SlangCompileRequest* request = spCreateCompileRequest(globalSession);
+    spAddCodeGenTarget(request, SLANG_HLSL);
+    int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+    spAddTranslationUnitSourceString(request, tuIndex, "interned-types.slang", kSource);
+    spAddEntryPoint(request, tuIndex, "computeMain", SLANG_STAGE_COMPUTE);
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(spCompile(request)));
+
+    auto reflection = slang::ShaderReflection::get(request);
+
+    // Naming the same type in different ways gives the same type, rather than an equivalent copy
+    const char* const typeNamePairs[][2] =
+    {
+        { "Box<Thing>", "Box< Thing >" },
+        { "Thing[4]", "Thing[2 + 2]" },
+        { "vector<float, 3>", "vector<float,3>" },
+        { "Box<Box<int> >", "Box< Box<int> >" },
+    };
+    for (const auto& typeNamePair : typeNamePairs)
+    {
+        slang::TypeReflection* type = reflection->findTypeByName(typeNamePair[0]);
+        slang::TypeReflection* sameType = reflection->findTypeByName(typeNamePair[1]);
+        SLANG_CHECK(type && type == sameType);
+    }
+
+    // A typedef keeps its own name, but is the same type underneath
+    slang::TypeReflection* otherThingType = reflection->findTypeByName("OtherThing");
+    SLANG_CHECK_ABORT(otherThingType);
+    SLANG_CHECK(UnownedStringSlice(otherThingType->getName()) == "Thing");
+
+    // Different arguments give different types
+    SLANG_CHECK(reflection->findTypeByName("Box<int>") != reflection->findTypeByName("Box<float>"));
+    SLANG_CHECK(reflection->findTypeByName("Thing[4]") != reflection->findTypeByName("Thing[5]"));
+
+    spDestroyCompileRequest(request);
+}
+
+SLANG_UNIT_TEST("InternedTypes", internedTypesTest);
@@ -0,0 +1,112 @@
+// unit-test-ir-inst-reuse.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../source/core/slang-basic.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+// Specialization, constant propagation, loop unrolling and value numbering each remove instructions
+// and create new ones (types, constants and specialized functions among them) while the maps of a
+// SharedIRBuilder that refer to the removed instructions are live. If the memory of a removed
+// instruction were reused while something still referred to it, the IR validation run after each
+// pass would fail, or the output would differ from one compile to the next.
+static const char kSource[] =
+    "interface IShape { float area(); float scale(float s); }\n"
+    "struct Square : IShape { float side; float area() { return side * side; } float scale(float s) { return side * s; } }\n"
+    "struct Circle : IShape { float radius; float area() { return 3.0f * radius * radius; } float scale(float s) { return radius * s * 2.0f; } }\n"
+    "float sumAreas<T : IShape>(T shape, int count)\n"
+    "{\n"
+    "    float total = 0.0f;\n"
+    "    [unroll]\n"
+    "    for (int i = 0; i < 4; ++i)\n"
+    "    {\n"
+    "        float weights[4] = { 1.0f, 2.0f, 3.0f, 4.0f };\n"
+    "        total += shape.area() * weights[i] + shape.scale(float(i + count * 2));\n"
+    "    }\n"
+    "    return total;\n"
+    "}\n"
+    "RWStructuredBuffer<float> outputBuffer;\n"
+    "[numthreads(4, 1, 1)]\n"
+    "void computeMain(uint3 tid : SV_DispatchThreadID)\n"
+    "{\n"
+    "    Square square; square.side = float(tid.x);\n"
+    "    Circle circle; circle.radius = float(tid.x + 1);\n"
+    "    const int count = 2 + 3;\n"
+    "    float value = sumAreas(square, count) + sumAreas(circle, count) + sumAreas(square, count - 1);\n"
+    "    outputBuffer[tid.x] = value + float(count * 4) * (value + 1.0f);\n"
+    "}\n";
+
+static SlangCompileRequest* _createRequest(slang::IGlobalSession* globalSession, SlangCompileTarget target)
+{
+    SlangCompileRequest* request = spCreateCompileRequest(globalSession);
+
+    const char* args[] = { "-O3", "-validate-ir" };
+    SLANG_CHECK(SLANG_SUCCEEDED(spProcessCommandLineArguments(request, args, SLANG_COUNT_OF(args))));
+
+    spAddCodeGenTarget(request, target);
+    int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+    spAddTranslationUnitSourceString(request, tuIndex, "ir-inst-reuse.slang", kSource);
+    spAddEntryPoint(request, tuIndex, "computeMain", SLANG_STAGE_COMPUTE);
+    return request;
+}
+
+static void irInstReuseTest()
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef())));
+
+    const SlangCompileTarget targets[] = { SLANG_HLSL, SLANG_GLSL, SLANG_CPP_SOURCE };
+    for (auto target : targets)
+    {
+        String firstSource;
+        for (Index i = 0; i < 2; ++i)
+        {
+            SlangCompileRequest* request = _createRequest(globalSession, target);
+            spSetReportPerf(request, 1);
+
+            // Validation failures are reported as errors
+            const SlangResult res = spCompile(request);
+            if (SLANG_FAILED(res))
+            {
+                printf("%s\n", spGetDiagnosticOutput(request));
+            }
+            SLANG_CHECK_ABORT(SLANG_SUCCEEDED(res));
+
+            const char* source = spGetEntryPointSource(request, 0);
+            SLANG_CHECK_ABORT(source);
+
+            if (i == 0)
+            {
+                firstSource = source;
+            }
+            else
+            {
+                SLANG_CHECK(firstSource == source);
+            }
+
+            // The instructions were removed and recreated: the passes took the live instruction bytes
+            // below their peak
+            bool hasDeallocated = false;
+            const SlangInt count = spGetPerfReportEntryCount(request);
+            for (SlangInt j = 0; j < count; ++j)
+            {
+                SlangPerfReportEntry entry;
+                SLANG_CHECK(SLANG_SUCCEEDED(spGetPerfReportEntry(request, j, &entry)));
+                hasDeallocated = hasDeallocated || (entry.liveInstBytes < entry.peakLiveInstBytes);
+            }
+            SLANG_CHECK(hasDeallocated);
+
+            spDestroyCompileRequest(request);
+        }
+    }
+}
+
+SLANG_UNIT_TEST("IRInstReuse", irInstReuseTest);
@@ -0,0 +1,125 @@
+// unit-test-mapped-file.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../source/core/slang-io.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static SlangResult _writeFile(const String& path, const String& contents)
+{
+    FILE* file = fopen(path.getBuffer(), "wb");
+    if (!file)
+    {
+        return SLANG_E_CANNOT_OPEN;
+    }
+    const size_t writtenSize = fwrite(contents.getBuffer(), 1, size_t(contents.getLength()), file);
+    fclose(file);
+    return writtenSize == size_t(contents.getLength()) ? SLANG_OK : SLANG_FAIL;
+}
+
+// Source large enough to be mapped when loaded, with the line ending newLine.
+// The entry point is at the end, so compiling it requires all of the contents.
+static String _makeLargeSource(const char* newLine)
+{
+    StringBuilder builder;
+    for (int i = 0; i < 1000; ++i)
+    {
+        builder << "int func" << i << "(int a) { return a + " << i << "; }" << newLine;
+    }
+    builder << "RWStructuredBuffer<int> outputBuffer;" << newLine;
+    builder << "[numthreads(4, 1, 1)]" << newLine;
+    builder << "void computeMain(uint3 tid : SV_DispatchThreadID) { outputBuffer[tid.x] = func999(int(tid.x)); }";
+    return builder.ProduceString();
+}
+
+// Compile the file at path. If fileSystemName is set, it's the name passed to -file-system to choose
+// the file system used to load it.
+static SlangResult _compileFile(slang::IGlobalSession* globalSession, const String& path, const char* fileSystemName)
+{
+    SlangCompileRequest* request = spCreateCompileRequest(globalSession);
+    if (fileSystemName)
+    {
+        const char* args[] = { "-file-system", fileSystemName };
+        if (SLANG_FAILED(spProcessCommandLineArguments(request, args, SLANG_COUNT_OF(args))))
+        {
+            spDestroyCompileRequest(request);
+            return SLANG_FAIL;
+        }
+    }
+    spAddCodeGenTarget(request, SLANG_HLSL);
+    const int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+    spAddTranslationUnitSourceFile(request, tuIndex, path.getBuffer());
+    spAddEntryPoint(request, tuIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    SlangResult res = spCompile(request);
+    if (SLANG_SUCCEEDED(res))
+    {
+        // The use of func999 must have been found
+        const char* source = spGetEntryPointSource(request, 0);
+        res = (source && strstr(source, "999")) ? SLANG_OK : SLANG_FAIL;
+    }
+    spDestroyCompileRequest(request);
+    return res;
+}
+
+static void mappedFileUnitTest()
+{
+    String path;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::generateTemporary(UnownedStringSlice::fromLiteral("slang-mapped-file"), path)));
+    // Make sure it's seen as slang source
+    const String sourcePath = path + ".slang";
+
+    // The blob holds the contents of the file
+    {
+        const String contents = _makeLargeSource("\n");
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_writeFile(sourcePath, contents)));
+
+        RefPtr<MappedFileBlob> blob;
+        SLANG_CHECK(SLANG_SUCCEEDED(MappedFileBlob::create(sourcePath, blob)));
+        if (blob)
+        {
+            SLANG_CHECK(blob->getBufferSize() == size_t(contents.getLength()));
+            SLANG_CHECK(::memcmp(blob->getBufferPointer(), contents.getBuffer(), size_t(contents.getLength())) == 0);
+        }
+    }
+
+    // Empty files and files that don't exist can't be mapped
+    {
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_writeFile(path, String())));
+
+        RefPtr<MappedFileBlob> blob;
+        SLANG_CHECK(MappedFileBlob::create(path, blob) == SLANG_E_NOT_AVAILABLE);
+        SLANG_CHECK(SLANG_FAILED(MappedFileBlob::create(path + "-missing", blob)));
+        SLANG_CHECK(blob == nullptr);
+    }
+
+    // Large source files are loaded by the compiler with the default file system (which reads them), and
+    // with the mapping file system - whether mapped (\n line endings) or converted (\r\n line endings)
+    {
+        ComPtr<slang::IGlobalSession> globalSession;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef())));
+
+        const char* fileSystemNames[] = { nullptr, "os", "os-mapped" };
+        for (auto fileSystemName : fileSystemNames)
+        {
+            SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_writeFile(sourcePath, _makeLargeSource("\n"))));
+            SLANG_CHECK(SLANG_SUCCEEDED(_compileFile(globalSession, sourcePath, fileSystemName)));
+
+            SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_writeFile(sourcePath, _makeLargeSource("\r\n"))));
+            SLANG_CHECK(SLANG_SUCCEEDED(_compileFile(globalSession, sourcePath, fileSystemName)));
+        }
+    }
+
+    File::remove(sourcePath);
+    File::remove(path);
+}
+
+SLANG_UNIT_TEST("MappedFile", mappedFileUnitTest);
@@ -0,0 +1,222 @@
+// unit-test-parallel-codegen.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../source/core/slang-thread-pool.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static const char kParallelSource[] =
+    "interface IShape { float area(); }\n"
+    "struct Square : IShape { float size; float area() { return size * size; } }\n"
+    "struct Circle : IShape { float radius; float area() { return 3.14159 * radius * radius; } }\n"
+    "RWStructuredBuffer<float> outputBuffer;\n"
+    "float calc<T : IShape>(T shape, float x) { return shape.area() * x; }\n"
+    "[numthreads(4, 1, 1)]\n"
+    "void first(uint3 tid : SV_DispatchThreadID) { Square s; s.size = 2; outputBuffer[tid.x] = calc(s, sin(float(tid.x))); }\n"
+    "[numthreads(4, 1, 1)]\n"
+    "void second(uint3 tid : SV_DispatchThreadID) { Circle c; c.radius = 1; outputBuffer[tid.x] = calc(c, cos(float(tid.y))); }\n"
+    "[numthreads(4, 1, 1)]\n"
+    "void third(uint3 tid : SV_DispatchThreadID) { outputBuffer[tid.x] = sqrt(dot(float3(tid), float3(1, 2, 3))); }\n"
+    "[numthreads(4, 1, 1)]\n"
+    "void fourth(uint3 tid : SV_DispatchThreadID) { outputBuffer[tid.x] = exp(float(tid.z)); }\n";
+
+// Dynamic dispatch, where the witness tables are given sequential IDs (shared between the entry points)
+// in the order code generation first reaches them. `first` reaches Triangle and Circle (the Square is
+// removed as dead code), and `second` reaches Square and Circle, so when generated serially Square gets
+// the last ID. That isn't the order of the witness tables in the module, which has the Square first.
+static const char kDynamicDispatchSource[] =
+    "[anyValueSize(8)]\n"
+    "interface IShape { float area(); }\n"
+    "struct Square : IShape { float size; float area() { return size * size; } }\n"
+    "struct Circle : IShape { float radius; float area() { return 3.14159 * radius * radius; } }\n"
+    "struct Triangle : IShape { float base; float area() { return 0.5 * base * base; } }\n"
+    "RWStructuredBuffer<float> outputBuffer;\n"
+    "IShape makeFirst(uint kind)\n"
+    "{\n"
+    "    if (false) { Square s; s.size = 4; return s; }\n"
+    "    if (kind == 0) { Triangle t; t.base = 1; return t; }\n"
+    "    Circle c; c.radius = 2; return c;\n"
+    "}\n"
+    "IShape makeSecond(uint kind)\n"
+    "{\n"
+    "    if (kind == 0) { Square s; s.size = 1; return s; }\n"
+    "    Circle c; c.radius = 3; return c;\n"
+    "}\n"
+    "[numthreads(4, 1, 1)]\n"
+    "void first(uint3 tid : SV_DispatchThreadID) { outputBuffer[tid.x] = makeFirst(tid.x).area(); }\n"
+    "[numthreads(4, 1, 1)]\n"
+    "void second(uint3 tid : SV_DispatchThreadID) { outputBuffer[tid.x] = makeSecond(tid.x).area(); }\n";
+
+static const char* const kParallelEntryPoints[] = { "first", "second", "third", "fourth" };
+static const SlangCompileTarget kParallelTargets[] = { SLANG_HLSL, SLANG_GLSL, SLANG_CPP_SOURCE };
+
+static const char* const kDynamicDispatchTypeNames[] = { "Square", "Circle", "Triangle" };
+
+namespace { // anonymous
+
+struct CompileOutput
+{
+    String diagnostics;
+    List<String> code;                          ///< For each target, the code for each entry point
+    List<uint32_t> sequentialIDs;               ///< The sequential ID of each of kDynamicDispatchTypeNames, if requested
+};
+
+} // anonymous
+
+static SlangResult _compileAll(
+    slang::IGlobalSession*  globalSession,
+    const char*             source,
+    Index                   entryPointCount,
+    int                     jobCount,
+    bool                    getSequentialIDs,
+    CompileOutput&          out)
+{
+    SlangCompileRequest* request = spCreateCompileRequest(globalSession);
+    for (auto target : kParallelTargets)
+    {
+        spAddCodeGenTarget(request, target);
+    }
+    spSetParallelJobCount(request, jobCount);
+
+    int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+    spAddTranslationUnitSourceString(request, tuIndex, "parallel.slang", source);
+    for (Index i = 0; i < entryPointCount; ++i)
+    {
+        spAddEntryPoint(request, tuIndex, kParallelEntryPoints[i], SLANG_STAGE_COMPUTE);
+    }
+
+    SlangResult res = spCompile(request);
+    out.diagnostics = spGetDiagnosticOutput(request);
+
+    if (SLANG_SUCCEEDED(res))
+    {
+        for (int targetIndex = 0; targetIndex < int(SLANG_COUNT_OF(kParallelTargets)); ++targetIndex)
+        {
+            for (int entryPointIndex = 0; entryPointIndex < int(entryPointCount); ++entryPointIndex)
+            {
+                ComPtr<ISlangBlob> blob;
+                res = spGetEntryPointCodeBlob(request, entryPointIndex, targetIndex, blob.writeRef());
+                if (SLANG_FAILED(res))
+                {
+                    break;
+                }
+                out.code.add(String((const char*)blob->getBufferPointer(), (const char*)blob->getBufferPointer() + blob->getBufferSize()));
+            }
+        }
+    }
+
+    // The IDs callers see from the session are the ones allocated while generating code
+    if (SLANG_SUCCEEDED(res) && getSequentialIDs)
+    {
+        ComPtr<slang::ISession> session;
+        spCompileRequest_getSession(request, session.writeRef());
+
+        auto reflection = (slang::ShaderReflection*)spGetReflection(request);
+        auto interfaceType = reflection->findTypeByName("IShape");
+        for (auto typeName : kDynamicDispatchTypeNames)
+        {
+            uint32_t id = 0;
+            res = session->getTypeConformanceWitnessSequentialID(reflection->findTypeByName(typeName), interfaceType, &id);
+            if (SLANG_FAILED(res))
+            {
+                break;
+            }
+            out.sequentialIDs.add(id);
+        }
+    }
+
+    spDestroyCompileRequest(request);
+    return res;
+}
+
+    /// Check generating code for the entry points in parallel gives exactly the same output as
+    /// generating it serially
+static void _checkParallelMatchesSerial(
+    slang::IGlobalSession*  globalSession,
+    const char*             source,
+    Index                   entryPointCount,
+    bool                    getSequentialIDs,
+    CompileOutput&          outSerial)
+{
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compileAll(globalSession, source, entryPointCount, 1, getSequentialIDs, outSerial)));
+    SLANG_CHECK(outSerial.code.getCount() == entryPointCount * Index(SLANG_COUNT_OF(kParallelTargets)));
+
+    const int jobCounts[] = { 2, 4, 0 };
+    for (auto jobCount : jobCounts)
+    {
+        CompileOutput output;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compileAll(globalSession, source, entryPointCount, jobCount, getSequentialIDs, output)));
+
+        SLANG_CHECK(output.diagnostics == outSerial.diagnostics);
+        SLANG_CHECK(output.code.getCount() == outSerial.code.getCount());
+        for (Index i = 0; i < output.code.getCount() && i < outSerial.code.getCount(); ++i)
+        {
+            SLANG_CHECK(output.code[i] == outSerial.code[i]);
+        }
+        SLANG_CHECK(output.sequentialIDs.getCount() == outSerial.sequentialIDs.getCount());
+        for (Index i = 0; i < output.sequentialIDs.getCount() && i < outSerial.sequentialIDs.getCount(); ++i)
+        {
+            SLANG_CHECK(output.sequentialIDs[i] == outSerial.sequentialIDs[i]);
+        }
+    }
+}
+
+static void parallelCodeGenTest()
+{
+    // The pool calls back for every index exactly once
+    {
+        RefPtr<ThreadPool> threadPool = new ThreadPool(3);
+        SLANG_CHECK(threadPool->getThreadCount() == 3);
+
+        List<Index> values;
+        values.setCount(1000);
+        for (auto& value : values)
+        {
+            value = 0;
+        }
+
+        threadPool->parallelFor(values.getCount(), [&](Index index) { values[index] += index + 1; });
+
+        bool allSet = true;
+        for (Index i = 0; i < values.getCount(); ++i)
+        {
+            allSet = allSet && (values[i] == i + 1);
+        }
+        SLANG_CHECK(allSet);
+    }
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef())));
+
+    // Generating on multiple threads produces exactly the same output and diagnostics
+    {
+        CompileOutput serial;
+        _checkParallelMatchesSerial(globalSession, kParallelSource, Index(SLANG_COUNT_OF(kParallelEntryPoints)), false, serial);
+    }
+
+    // Including the sequential IDs of witness tables used for dynamic dispatch, which are allocated
+    // in the order of the entry points
+    {
+        CompileOutput serial;
+        _checkParallelMatchesSerial(globalSession, kDynamicDispatchSource, 2, true, serial);
+
+        SLANG_CHECK(serial.sequentialIDs.getCount() == 3);
+        if (serial.sequentialIDs.getCount() == 3)
+        {
+            // Square, Circle, Triangle
+            SLANG_CHECK(serial.sequentialIDs[0] == 2);
+            SLANG_CHECK(serial.sequentialIDs[1] == 1);
+            SLANG_CHECK(serial.sequentialIDs[2] == 0);
+        }
+    }
+}
+
+SLANG_UNIT_TEST("ParallelCodeGen", parallelCodeGenTest);
@@ -0,0 +1,104 @@
+// unit-test-perf-report.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../source/core/slang-basic.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static const char kPerfReportSource[] =
+    "RWStructuredBuffer<float> outputBuffer;\n"
+    "[numthreads(4, 1, 1)]\n"
+    "void computeMain(uint3 tid : SV_DispatchThreadID) { outputBuffer[tid.x] = float(tid.x) * 2.0f; }\n";
+
+static SlangCompileRequest* _createRequest(slang::IGlobalSession* globalSession)
+{
+    SlangCompileRequest* request = spCreateCompileRequest(globalSession);
+    spAddCodeGenTarget(request, SLANG_HLSL);
+
+    int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+    spAddTranslationUnitSourceString(request, tuIndex, "perf-report.slang", kPerfReportSource);
+    spAddEntryPoint(request, tuIndex, "computeMain", SLANG_STAGE_COMPUTE);
+    return request;
+}
+
+static bool _findEntry(SlangCompileRequest* request, const char* scope, const char* name, SlangPerfReportEntry& outEntry)
+{
+    const SlangInt count = spGetPerfReportEntryCount(request);
+    for (SlangInt i = 0; i < count; ++i)
+    {
+        SlangPerfReportEntry entry;
+        if (SLANG_SUCCEEDED(spGetPerfReportEntry(request, i, &entry)) &&
+            strcmp(entry.scope, scope) == 0 && strcmp(entry.name, name) == 0)
+        {
+            outEntry = entry;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void perfReportTest()
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef())));
+
+    // Nothing is recorded unless enabled
+    {
+        SlangCompileRequest* request = _createRequest(globalSession);
+        SLANG_CHECK(SLANG_SUCCEEDED(spCompile(request)));
+        SLANG_CHECK(spGetPerfReportEntryCount(request) == 0);
+
+        SlangPerfReportEntry entry;
+        SLANG_CHECK(SLANG_FAILED(spGetPerfReportEntry(request, 0, &entry)));
+        spDestroyCompileRequest(request);
+    }
+
+    {
+        SlangCompileRequest* request = _createRequest(globalSession);
+        spSetReportPerf(request, 1);
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(spCompile(request)));
+
+        const SlangInt count = spGetPerfReportEntryCount(request);
+        SLANG_CHECK(count > 0);
+
+        // Front end phases have no instruction counts
+        SlangPerfReportEntry entry;
+        SLANG_CHECK(_findEntry(request, "frontEnd", "parse", entry) && entry.instCountBefore < 0);
+        SLANG_CHECK(_findEntry(request, "frontEnd", "check", entry));
+        SLANG_CHECK(_findEntry(request, "frontEnd", "lowerToIR", entry));
+
+        // IR passes do
+        SLANG_CHECK(_findEntry(request, "hlsl:computeMain", "linkIR", entry));
+        SLANG_CHECK(entry.instCountAfter > 0);
+        SLANG_CHECK(entry.liveInstBytes > 0 && entry.peakLiveInstBytes >= entry.liveInstBytes);
+        SLANG_CHECK(_findEntry(request, "hlsl:computeMain", "stripWitnessTables", entry));
+        SLANG_CHECK(entry.instCountBefore > 0 && entry.instCountAfter > 0);
+        SLANG_CHECK(_findEntry(request, "hlsl:computeMain", "emitSource", entry));
+
+        for (SlangInt i = 0; i < count; ++i)
+        {
+            SLANG_CHECK(SLANG_SUCCEEDED(spGetPerfReportEntry(request, i, &entry)) && entry.timeInSeconds >= 0.0);
+            SLANG_CHECK(entry.peakLiveInstBytes >= entry.liveInstBytes);
+        }
+        SLANG_CHECK(SLANG_FAILED(spGetPerfReportEntry(request, count, &entry)));
+
+        // Compiling again replaces the entries
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(spCompile(request)));
+        SLANG_CHECK(spGetPerfReportEntryCount(request) == count);
+
+        spSetReportPerf(request, 0);
+        SLANG_CHECK(spGetPerfReportEntryCount(request) == 0);
+
+        spDestroyCompileRequest(request);
+    }
+}
+
+SLANG_UNIT_TEST("PerfReport", perfReportTest);
@@ -0,0 +1,207 @@
+// unit-test-serialized-module-import.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-riff.h"
+#include "../../source/core/slang-stream.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static const char kLibSource[] =
+    "#include \"lib-scale.slangh\"\n"
+    "float scaleValue(float value) { return value * SCALE; }\n";
+
+static const char kLibInclude[] =
+    "#define SCALE 2.0\n";
+
+static const char kMainSource[] =
+    "import lib;\n"
+    "[numthreads(1, 1, 1)]\n"
+    "void computeMain(uniform RWStructuredBuffer<float> buffer) { buffer[0] = scaleValue(1.0); }\n";
+
+namespace { // anonymous
+
+struct ImportOutput
+{
+    SlangResult result = SLANG_FAIL;
+    String diagnostics;
+    bool usedSerializedModule = false;
+};
+
+} // anonymous
+
+    /// Compile the module in directory, returning the contents of the serialized module
+static void _compileModule(slang::IGlobalSession* globalSession, const String& directory, List<uint8_t>& outContents)
+{
+    SlangCompileRequest* request = spCreateCompileRequest(globalSession);
+
+    const char* args[] = { "-module-name", "lib", "-no-codegen" };
+    spProcessCommandLineArguments(request, args, SLANG_COUNT_OF(args));
+    spSetOutputContainerFormat(request, SLANG_CONTAINER_FORMAT_SLANG_MODULE);
+
+    int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "lib");
+    spAddTranslationUnitSourceFile(request, tuIndex, Path::combine(directory, "lib.slang").getBuffer());
+
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(spCompile(request)));
+
+    ComPtr<ISlangBlob> blob;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(spGetContainerCode(request, blob.writeRef())));
+    outContents.clear();
+    outContents.addRange((const uint8_t*)blob->getBufferPointer(), Index(blob->getBufferSize()));
+
+    spDestroyCompileRequest(request);
+}
+
+static void _writeModule(const String& directory, const List<uint8_t>& contents)
+{
+    FileStream stream(Path::combine(directory, "lib.slang-module"), FileMode::Create, FileAccess::Write, FileShare::None);
+    stream.write(contents.getBuffer(), size_t(contents.getCount()));
+    stream.close();
+}
+
+    /// Compile a program that imports the module from directory
+static void _import(slang::IGlobalSession* globalSession, const String& directory, ImportOutput& out)
+{
+    SlangCompileRequest* request = spCreateCompileRequest(globalSession);
+
+    spAddSearchPath(request, directory.getBuffer());
+    spSetCodeGenTarget(request, SLANG_HLSL);
+
+    int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "main");
+    spAddTranslationUnitSourceString(request, tuIndex, "main.slang", kMainSource);
+    spAddEntryPoint(request, tuIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    out.result = spCompile(request);
+    out.diagnostics = spGetDiagnosticOutput(request);
+
+    // If the serialized module is used, the program depends on it
+    out.usedSerializedModule = false;
+    const int dependencyCount = spGetDependencyFileCount(request);
+    for (int i = 0; i < dependencyCount; ++i)
+    {
+        out.usedSerializedModule = out.usedSerializedModule || UnownedStringSlice(spGetDependencyFilePath(request, i)).endsWith(UnownedStringSlice::fromLiteral(".slang-module"));
+    }
+
+    spDestroyCompileRequest(request);
+}
+
+    /// Check the import falls back to compiling the source, because of the problem
+static void _checkFallsBack(const ImportOutput& output, const char* problem)
+{
+    SLANG_CHECK(SLANG_SUCCEEDED(output.result));
+    SLANG_CHECK(!output.usedSerializedModule);
+    SLANG_CHECK(output.diagnostics.indexOf(UnownedStringSlice::fromLiteral("38202")) >= 0);
+    SLANG_CHECK(output.diagnostics.indexOf(UnownedStringSlice(problem)) >= 0);
+}
+
+    /// Find the module header in the serialized module. The header starts with the semantic version (uint32_t),
+    /// the dependency count (uint32_t) and the stdlib hash (uint64_t).
+static uint8_t* _findModuleHeader(List<uint8_t>& contents)
+{
+    const FourCC headerFourCC = SLANG_FOUR_CC('S', 'm', 'h', 'd');
+    for (Index i = 0; i + Index(sizeof(RiffHeader)) + 16 <= contents.getCount(); i += 4)
+    {
+        if (::memcmp(contents.getBuffer() + i, &headerFourCC, sizeof(headerFourCC)) == 0)
+        {
+            return contents.getBuffer() + i + sizeof(RiffHeader);
+        }
+    }
+    return nullptr;
+}
+
+static void serializedModuleImportTest()
+{
+    String directory;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::generateTemporary(UnownedStringSlice::fromLiteral("slang-serialized-module"), directory)));
+    // generateTemporary creates a file, the module needs a directory
+    File::remove(directory);
+    SLANG_CHECK_ABORT(Path::createDirectory(directory));
+
+    const String libPath = Path::combine(directory, "lib.slang");
+    const String includePath = Path::combine(directory, "lib-scale.slangh");
+    File::writeAllText(libPath, kLibSource);
+    File::writeAllText(includePath, kLibInclude);
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef())));
+
+    List<uint8_t> contents;
+    _compileModule(globalSession, directory, contents);
+
+    // The serialized module is used when everything it was compiled from is unchanged
+    {
+        _writeModule(directory, contents);
+
+        ImportOutput output;
+        _import(globalSession, directory, output);
+        SLANG_CHECK(SLANG_SUCCEEDED(output.result));
+        SLANG_CHECK(output.usedSerializedModule);
+        SLANG_CHECK(output.diagnostics.indexOf(UnownedStringSlice::fromLiteral("38202")) < 0);
+    }
+
+    // A module written by an incompatible version isn't used
+    {
+        List<uint8_t> modified(contents);
+        uint8_t* header = _findModuleHeader(modified);
+        SLANG_CHECK_ABORT(header);
+
+        uint32_t semanticVersion;
+        ::memcpy(&semanticVersion, header, sizeof(semanticVersion));
+        // The major version is in the top 16 bits
+        semanticVersion += 0x10000;
+        ::memcpy(header, &semanticVersion, sizeof(semanticVersion));
+        _writeModule(directory, modified);
+
+        ImportOutput output;
+        _import(globalSession, directory, output);
+        _checkFallsBack(output, "incompatible version");
+    }
+
+    // A module compiled against a different stdlib isn't used
+    {
+        List<uint8_t> modified(contents);
+        uint8_t* header = _findModuleHeader(modified);
+        SLANG_CHECK_ABORT(header);
+
+        header[8] ^= 0xff;
+        _writeModule(directory, modified);
+
+        ImportOutput output;
+        _import(globalSession, directory, output);
+        _checkFallsBack(output, "different standard library");
+    }
+
+    // A module is out of date if an included file is edited
+    {
+        _writeModule(directory, contents);
+        File::writeAllText(includePath, "#define SCALE 3.0\n");
+
+        ImportOutput output;
+        _import(globalSession, directory, output);
+        _checkFallsBack(output, "lib-scale.slangh");
+
+        File::writeAllText(includePath, kLibInclude);
+    }
+
+    // A module is out of date if its source is edited
+    {
+        _writeModule(directory, contents);
+        File::writeAllText(libPath, String(kLibSource) + "float unused() { return 0.0; }\n");
+
+        ImportOutput output;
+        _import(globalSession, directory, output);
+        _checkFallsBack(output, "with respect to its source");
+    }
+
+    File::remove(Path::combine(directory, "lib.slang-module"));
+    File::remove(includePath);
+    File::remove(libPath);
+    File::remove(directory);
+}
+
+SLANG_UNIT_TEST("SerializedModuleImport", serializedModuleImportTest);
@@ -0,0 +1,101 @@
+// unit-test-specialize-cache.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../source/core/slang-basic.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static const char kSource[] =
+    "interface IValue { float get(); }\n"
+    "struct One : IValue { float get() { return 1.0; } }\n"
+    "struct Two : IValue { float get() { return 2.0; } }\n"
+    "typedef One AlsoOne;\n"
+    "type_param T : IValue;\n"
+    "RWStructuredBuffer<float> outputBuffer;\n"
+    "[numthreads(1, 1, 1)]\n"
+    "void computeMain() { T t; outputBuffer[0] = t.get(); }\n";
+
+static ComPtr<slang::IComponentType> _specialize(slang::IComponentType* program, slang::TypeReflection* type)
+{
+    slang::SpecializationArg arg;
+    arg.kind = slang::SpecializationArg::Kind::Type;
+    arg.type = type;
+
+    ComPtr<slang::IComponentType> specialized;
+    SLANG_CHECK(SLANG_SUCCEEDED(program->specialize(&arg, 1, specialized.writeRef())));
+    return specialized;
+}
+
+static void specializeCacheTest()
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef())));
+
+    SlangCompileRequest* request = spCreateCompileRequest(globalSession);
+    spAddCodeGenTarget(request, SLANG_HLSL);
+    int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+    spAddTranslationUnitSourceString(request, tuIndex, "specialize-cache.slang", kSource);
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(spCompile(request)));
+
+    ComPtr<slang::IModule> module;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(spCompileRequest_getModule(request, 0, module.writeRef())));
+
+    auto reflection = slang::ShaderReflection::get(request);
+    slang::TypeReflection* oneType = reflection->findTypeByName("One");
+    slang::TypeReflection* alsoOneType = reflection->findTypeByName("AlsoOne");
+    slang::TypeReflection* twoType = reflection->findTypeByName("Two");
+    SLANG_CHECK_ABORT(oneType && alsoOneType && twoType);
+
+    // Specializing the same component type with the same argument gives the same component type.
+    // Naming the same type differently doesn't matter.
+    ComPtr<slang::IComponentType> specializedOne = _specialize(module, oneType);
+    ComPtr<slang::IComponentType> specializedOneAgain = _specialize(module, oneType);
+    ComPtr<slang::IComponentType> specializedAlsoOne = _specialize(module, alsoOneType);
+    SLANG_CHECK_ABORT(specializedOne);
+    SLANG_CHECK(specializedOne.get() == specializedOneAgain.get());
+    SLANG_CHECK(specializedOne.get() == specializedAlsoOne.get());
+
+    // A different argument gives a different component type
+    ComPtr<slang::IComponentType> specializedTwo = _specialize(module, twoType);
+    SLANG_CHECK(specializedTwo && specializedTwo.get() != specializedOne.get());
+
+    // So the layout is shared too
+    SLANG_CHECK(specializedOne->getLayout() == specializedOneAgain->getLayout());
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(spCompileRequest_getSession(request, session.writeRef())));
+
+    // With room for one specialization, the least recently used is released
+    {
+        spSession_setSpecializationCacheSize(session, 1);
+
+        // Two was used last, so One was released
+        SLANG_CHECK(_specialize(module, twoType).get() == specializedTwo.get());
+        ComPtr<slang::IComponentType> newOne = _specialize(module, oneType);
+        SLANG_CHECK(newOne && newOne.get() != specializedOne.get());
+
+        // Now One is held, and Two was released
+        SLANG_CHECK(_specialize(module, oneType).get() == newOne.get());
+        SLANG_CHECK(_specialize(module, twoType).get() != specializedTwo.get());
+    }
+
+    // With no room, nothing is held
+    {
+        spSession_setSpecializationCacheSize(session, 0);
+
+        ComPtr<slang::IComponentType> first = _specialize(module, oneType);
+        ComPtr<slang::IComponentType> second = _specialize(module, oneType);
+        SLANG_CHECK(first && second && first.get() != second.get());
+    }
+
+    spDestroyCompileRequest(request);
+}
+
+SLANG_UNIT_TEST("SpecializeCache", specializeCacheTest);
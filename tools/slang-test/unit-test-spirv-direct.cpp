@@ -0,0 +1,356 @@
+// unit-test-spirv-direct.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../source/core/slang-basic.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static const char kComputeSource[] =
+    "RWStructuredBuffer<float> outputBuffer;\n"
+    "Texture2D<float4> tex;\n"
+    "SamplerState samplerState;\n"
+    "[numthreads(4, 1, 1)]\n"
+    "void computeMain(uint3 tid : SV_DispatchThreadID)\n"
+    "{\n"
+    "    float sum = 0;\n"
+    "    for (uint i = 0; i < tid.x; ++i)\n"
+    "        sum += sqrt(float(i));\n"
+    "    float4 texel = tex.SampleLevel(samplerState, float2(sum, 0), 0);\n"
+    "    outputBuffer[tid.x] = tid.x > 2 ? sum : texel.x;\n"
+    "}\n";
+
+static const char kGeometrySource[] =
+    "struct VSOut { float4 pos : SV_Position; };\n"
+    "[maxvertexcount(1)]\n"
+    "void gsMain(point VSOut input[1], inout PointStream<VSOut> output) { output.Append(input[0]); }\n";
+
+static const char kEmptySource[] =
+    "[numthreads(4, 1, 1)]\n"
+    "void computeMain() {}\n";
+
+// The module emitted for kEmptySource
+static const uint32_t kEmptyModule[] =
+{
+    0x07230203, 0x00010000, 0x00000000, 0x00000005, 0x00000000,
+    0x00020011, 0x00000001,                                                     // OpCapability Shader
+    0x0003000e, 0x00000000, 0x00000001,                                         // OpMemoryModel Logical GLSL450
+    0x0006000f, 0x00000005, 0x00000003, 0x706d6f63, 0x4d657475, 0x006e6961,     // OpEntryPoint GLCompute %3 "computeMain"
+    0x00060010, 0x00000003, 0x00000011, 0x00000004, 0x00000001, 0x00000001,     // OpExecutionMode %3 LocalSize 4 1 1
+    0x00050005, 0x00000003, 0x706d6f63, 0x4d657475, 0x006e6961,                 // OpName %3 "computeMain"
+    0x00020013, 0x00000001,                                                     // %1 = OpTypeVoid
+    0x00030021, 0x00000002, 0x00000001,                                         // %2 = OpTypeFunction %1
+    0x00050036, 0x00000001, 0x00000003, 0x00000000, 0x00000002,                 // %3 = OpFunction %1 None %2
+    0x000200f8, 0x00000004,                                                     // %4 = OpLabel
+    0x000100fd,                                                                 // OpReturn
+    0x00010038,                                                                 // OpFunctionEnd
+};
+
+namespace { // anonymous
+
+enum
+{
+    kOpName = 5,
+    kOpExtInstImport = 11,
+    kOpExtInst = 12,
+    kOpEntryPoint = 15,
+    kOpExecutionMode = 16,
+    kOpCapability = 17,
+    kOpTypeVoid = 19,
+    kOpFunction = 54,
+    kOpFunctionEnd = 56,
+    kOpVariable = 59,
+    kOpDecorate = 71,
+    kOpImageSampleExplicitLod = 88,
+    kOpLoopMerge = 246,
+    kOpSelectionMerge = 247,
+    kOpLabel = 248,
+    kOpBranch = 249,
+    kOpReturnValue = 254,
+    kOpUnreachable = 255,
+
+    kExecutionModeLocalSize = 17,
+    kDecorationBinding = 33,
+    kDecorationDescriptorSet = 34,
+    kGLSLstd450Sqrt = 31,
+};
+
+struct SPIRVInst
+{
+    uint32_t opcode;
+    const uint32_t* operands;
+    uint32_t operandCount;
+};
+
+} // anonymous
+
+    /// Split the words of a module (after the header) into instructions. Returns false if the module is malformed.
+static bool _parseSPIRV(const uint32_t* words, size_t wordCount, List<SPIRVInst>& outInsts)
+{
+    if (wordCount < 5 || words[0] != 0x07230203)
+    {
+        return false;
+    }
+    size_t offset = 5;
+    while (offset < wordCount)
+    {
+        const uint32_t instWordCount = words[offset] >> 16;
+        if (instWordCount == 0 || offset + instWordCount > wordCount)
+        {
+            return false;
+        }
+        SPIRVInst inst;
+        inst.opcode = words[offset] & 0xffff;
+        inst.operands = words + offset + 1;
+        inst.operandCount = instWordCount - 1;
+        outInsts.add(inst);
+        offset += instWordCount;
+    }
+    return true;
+}
+
+    /// Returns true if the opcode ends a block
+static bool _isTerminator(uint32_t opcode)
+{
+    return opcode >= kOpBranch && opcode <= kOpUnreachable;
+}
+
+    /// Returns true if the opcode has a result type operand before its result id. Only covers the
+    /// opcodes whose result ids are checked here - those that aren't types or constants.
+static bool _hasResultType(uint32_t opcode)
+{
+    switch (opcode)
+    {
+        case kOpExtInst:
+        case kOpFunction:
+        case kOpVariable:
+        case kOpImageSampleExplicitLod:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static SlangCompileRequest* _createRequest(slang::IGlobalSession* globalSession, const char* source, const char* entryPointName, SlangStage stage)
+{
+    SlangCompileRequest* request = spCreateCompileRequest(globalSession);
+
+    const char* args[] = { "-emit-spirv-directly" };
+    spProcessCommandLineArguments(request, args, SLANG_COUNT_OF(args));
+
+    spAddCodeGenTarget(request, SLANG_SPIRV);
+
+    int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+    spAddTranslationUnitSourceString(request, tuIndex, "spirv-direct.slang", source);
+    spAddEntryPoint(request, tuIndex, entryPointName, stage);
+    return request;
+}
+
+    /// Compile the request, checking it's emitted directly, and get the module
+static void _compileDirectly(SlangCompileRequest* request, ComPtr<ISlangBlob>& outBlob)
+{
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(spCompile(request)));
+
+    const char* diagnostics = spGetDiagnosticOutput(request);
+    SLANG_CHECK(strstr(diagnostics, "52006") == nullptr);
+
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(spGetEntryPointCodeBlob(request, 0, 0, outBlob.writeRef())));
+    SLANG_CHECK_ABORT(outBlob->getBufferSize() % sizeof(uint32_t) == 0);
+}
+
+static void spirvDirectTest()
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef())));
+
+    // The module for an empty entry point is exactly as expected
+    {
+        SlangCompileRequest* request = _createRequest(globalSession, kEmptySource, "computeMain", SLANG_STAGE_COMPUTE);
+        ComPtr<ISlangBlob> blob;
+        _compileDirectly(request, blob);
+
+        SLANG_CHECK(blob->getBufferSize() == sizeof(kEmptyModule));
+        SLANG_CHECK(blob->getBufferSize() == sizeof(kEmptyModule) && memcmp(blob->getBufferPointer(), kEmptyModule, sizeof(kEmptyModule)) == 0);
+
+        spDestroyCompileRequest(request);
+    }
+
+    // A compute shader using buffers, textures, loops and intrinsics is emitted directly,
+    // without falling back to glslang
+    {
+        SlangCompileRequest* request = _createRequest(globalSession, kComputeSource, "computeMain", SLANG_STAGE_COMPUTE);
+        ComPtr<ISlangBlob> blob;
+        _compileDirectly(request, blob);
+
+        const size_t wordCount = blob->getBufferSize() / sizeof(uint32_t);
+        const uint32_t* words = (const uint32_t*)blob->getBufferPointer();
+
+        // Header: magic, version, generator, bound, schema
+        SLANG_CHECK_ABORT(wordCount > 5);
+        SLANG_CHECK(words[1] >= 0x00010000 && words[1] <= 0x00010500 && (words[1] & 0xff) == 0);
+        SLANG_CHECK(words[4] == 0);
+        const uint32_t bound = words[3];
+
+        List<SPIRVInst> insts;
+        SLANG_CHECK_ABORT(_parseSPIRV(words, wordCount, insts));
+
+        // Result ids are within the bound and defined once. The names of ids are kept to check decorations.
+        List<bool> isDefined;
+        isDefined.setCount(bound);
+        for (auto& defined : isDefined)
+        {
+            defined = false;
+        }
+        Dictionary<uint32_t, String> names;
+        uint32_t glslStd450 = 0;
+        uint32_t entryPointFunction = 0;
+        for (const auto& inst : insts)
+        {
+            uint32_t resultId = 0;
+            if (inst.opcode == kOpLabel || inst.opcode == kOpExtInstImport)
+            {
+                resultId = inst.operands[0];
+            }
+            else if (_hasResultType(inst.opcode))
+            {
+                resultId = inst.operands[1];
+            }
+            if (resultId)
+            {
+                SLANG_CHECK_ABORT(resultId < bound);
+                SLANG_CHECK(!isDefined[resultId]);
+                isDefined[resultId] = true;
+            }
+
+            if (inst.opcode == kOpName)
+            {
+                names[inst.operands[0]] = String((const char*)&inst.operands[1]);
+            }
+            else if (inst.opcode == kOpExtInstImport && strcmp((const char*)&inst.operands[1], "GLSL.std.450") == 0)
+            {
+                glslStd450 = inst.operands[0];
+            }
+            else if (inst.opcode == kOpEntryPoint)
+            {
+                SLANG_CHECK(inst.operandCount > 2);
+                SLANG_CHECK(inst.operands[0] == 5 /* GLCompute */);
+                SLANG_CHECK(strcmp((const char*)&inst.operands[2], "computeMain") == 0);
+                entryPointFunction = inst.operands[1];
+            }
+        }
+
+        // The logical layout starts with the capabilities, and the entry point is defined
+        SLANG_CHECK(insts[0].opcode == kOpCapability);
+        SLANG_CHECK(entryPointFunction != 0 && entryPointFunction < bound && isDefined[entryPointFunction]);
+
+        // Each function is a list of blocks, where each block starts with a label and ends with a terminator.
+        // The loop is structured, and the intrinsics map to the instructions expected.
+        bool inFunction = false;
+        bool inBlock = false;
+        bool hasLoopMerge = false;
+        bool hasSqrt = false;
+        bool hasSample = false;
+        for (const auto& inst : insts)
+        {
+            switch (inst.opcode)
+            {
+                case kOpFunction:
+                    SLANG_CHECK(!inFunction);
+                    inFunction = true;
+                    break;
+                case kOpFunctionEnd:
+                    SLANG_CHECK(inFunction && !inBlock);
+                    inFunction = false;
+                    break;
+                case kOpLabel:
+                    SLANG_CHECK(inFunction && !inBlock);
+                    inBlock = true;
+                    break;
+                default:
+                {
+                    if (_isTerminator(inst.opcode))
+                    {
+                        SLANG_CHECK(inBlock);
+                        inBlock = false;
+                    }
+                    else if (inFunction && inst.opcode != kOpVariable)
+                    {
+                        // Only variables can come before the first block
+                        SLANG_CHECK(inBlock);
+                    }
+                    break;
+                }
+            }
+
+            hasLoopMerge = hasLoopMerge || inst.opcode == kOpLoopMerge;
+            hasSqrt = hasSqrt || (inst.opcode == kOpExtInst && inst.operands[2] == glslStd450 && inst.operands[3] == kGLSLstd450Sqrt);
+            hasSample = hasSample || inst.opcode == kOpImageSampleExplicitLod;
+
+            // The workgroup size is from the numthreads attribute
+            if (inst.opcode == kOpExecutionMode && inst.operands[1] == kExecutionModeLocalSize)
+            {
+                SLANG_CHECK(inst.operands[0] == entryPointFunction);
+                SLANG_CHECK(inst.operandCount == 5 && inst.operands[2] == 4 && inst.operands[3] == 1 && inst.operands[4] == 1);
+            }
+        }
+        SLANG_CHECK(!inFunction);
+        SLANG_CHECK(hasLoopMerge);
+        SLANG_CHECK(glslStd450 != 0 && hasSqrt);
+        SLANG_CHECK(hasSample);
+
+        // The bindings of the parameters are as reflection reports them
+        Dictionary<String, uint32_t> bindings;
+        Dictionary<String, uint32_t> sets;
+        for (const auto& inst : insts)
+        {
+            String* name = (inst.opcode == kOpDecorate) ? names.TryGetValue(inst.operands[0]) : nullptr;
+            if (name && inst.operands[1] == kDecorationBinding)
+            {
+                bindings[*name] = inst.operands[2];
+            }
+            else if (name && inst.operands[1] == kDecorationDescriptorSet)
+            {
+                sets[*name] = inst.operands[2];
+            }
+        }
+
+        SlangReflection* reflection = spGetReflection(request);
+        SLANG_CHECK_ABORT(reflection);
+        const unsigned parameterCount = spReflection_GetParameterCount(reflection);
+        SLANG_CHECK(parameterCount == 3);
+        for (unsigned i = 0; i < parameterCount; ++i)
+        {
+            SlangReflectionParameter* parameter = spReflection_GetParameterByIndex(reflection, i);
+            const String name = spReflectionVariable_GetName(spReflectionVariableLayout_GetVariable(parameter));
+
+            uint32_t* binding = bindings.TryGetValue(name);
+            uint32_t* set = sets.TryGetValue(name);
+            SLANG_CHECK_ABORT(binding && set);
+            SLANG_CHECK(*binding == spReflectionParameter_GetBindingIndex(parameter));
+            SLANG_CHECK(*set == spReflectionParameter_GetBindingSpace(parameter));
+        }
+
+        spDestroyCompileRequest(request);
+    }
+
+    // A stage that isn't supported reports why, and then goes via GLSL (which
+    // may not be available)
+    {
+        SlangCompileRequest* request = _createRequest(globalSession, kGeometrySource, "gsMain", SLANG_STAGE_GEOMETRY);
+        spCompile(request);
+
+        const char* diagnostics = spGetDiagnosticOutput(request);
+        SLANG_CHECK(strstr(diagnostics, "52006") != nullptr);
+
+        spDestroyCompileRequest(request);
+    }
+}
+
+SLANG_UNIT_TEST("SPIRVDirect", spirvDirectTest);
@@ -0,0 +1,126 @@
+// unit-test-stdlib-serialize.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static SlangResult _compile(slang::IGlobalSession* globalSession, const char* testSource)
+{
+    SlangCompileRequest* request = spCreateCompileRequest(globalSession);
+    spAddCodeGenTarget(request, SLANG_HLSL);
+    int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+    spAddTranslationUnitSourceString(request, tuIndex, "internalFile", testSource);
+    spAddEntryPoint(request, tuIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    SlangResult res = spCompile(request);
+    if (SLANG_SUCCEEDED(res))
+    {
+        const char* code = spGetEntryPointSource(request, 0);
+        res = (code && strstr(code, "computeMain")) ? SLANG_OK : SLANG_FAIL;
+    }
+
+    spDestroyCompileRequest(request);
+    return res;
+}
+
+static SlangResult _compileWithStdLib(slang::IGlobalSession* globalSession)
+{
+    const char* testSource =
+        "RWStructuredBuffer<float> outputBuffer;"
+        "[numthreads(4, 1, 1)]"
+        "void computeMain(uint3 tid : SV_DispatchThreadID)"
+        "{"
+        "   outputBuffer[tid.x] = sin(float(tid.x)) + dot(float3(1, 2, 3), float3(tid));"
+        "}";
+
+    // Uses members of stdlib types and extensions (such as texture methods), interfaces, and syntax
+    // declared in the stdlib (cbuffer), all of which are looked up in the stdlib in different ways
+    const char* memberTestSource =
+        "cbuffer Params { float4x4 transform; float scale; }\n"
+        "Texture2D<float4> tex;\n"
+        "SamplerState samplerState;\n"
+        "RWStructuredBuffer<float4> outputBuffer;\n"
+        "interface IScaler { float4 apply(float4 v); }\n"
+        "struct Scaler : IScaler { float4 apply(float4 v) { return v * scale; } }\n"
+        "float4 scaleWith<T : IScaler>(T scaler, float4 v) { return scaler.apply(v); }\n"
+        "[numthreads(4, 1, 1)]\n"
+        "void computeMain(uint3 tid : SV_DispatchThreadID)\n"
+        "{\n"
+        "   uint width, height;\n"
+        "   tex.GetDimensions(width, height);\n"
+        "   float4 v = tex.SampleLevel(samplerState, float2(tid.xy) / float2(width, height), 0);\n"
+        "   Scaler scaler;\n"
+        "   outputBuffer[tid.x] = mul(transform, scaleWith(scaler, v)) + float4(asuint(scale).xxxx);\n"
+        "}\n";
+
+    SLANG_RETURN_ON_FAIL(_compile(globalSession, testSource));
+    SLANG_RETURN_ON_FAIL(_compile(globalSession, memberTestSource));
+    return SLANG_OK;
+}
+
+static void stdLibSerializeTest()
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef())));
+
+    // Save the stdlib from a session that has one
+    ComPtr<ISlangBlob> stdLibBlob;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(globalSession->saveStdLib(stdLibBlob.writeRef())));
+    SLANG_CHECK(stdLibBlob->getBufferSize() > 0);
+
+    // Can't set up the stdlib twice
+    SLANG_CHECK(SLANG_FAILED(globalSession->compileStdLib()));
+    SLANG_CHECK(SLANG_FAILED(globalSession->loadStdLib(stdLibBlob->getBufferPointer(), stdLibBlob->getBufferSize())));
+
+    // Load the serialized stdlib into a session without one, and check it can be used to compile
+    {
+        ComPtr<slang::IGlobalSession> loadedSession;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSessionWithoutStdLib(SLANG_API_VERSION, loadedSession.writeRef())));
+
+        // Nothing to save yet
+        ComPtr<ISlangBlob> emptyBlob;
+        SLANG_CHECK(SLANG_FAILED(loadedSession->saveStdLib(emptyBlob.writeRef())));
+
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(loadedSession->loadStdLib(stdLibBlob->getBufferPointer(), stdLibBlob->getBufferSize())));
+        SLANG_CHECK(SLANG_SUCCEEDED(_compileWithStdLib(loadedSession)));
+
+        // The loaded stdlib only creates declarations and function bodies when they are used. Saving it again has
+        // to produce all of them, such that the result is as usable as the original.
+        ComPtr<ISlangBlob> resavedBlob;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(loadedSession->saveStdLib(resavedBlob.writeRef())));
+
+        ComPtr<slang::IGlobalSession> reloadedSession;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSessionWithoutStdLib(SLANG_API_VERSION, reloadedSession.writeRef())));
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(reloadedSession->loadStdLib(resavedBlob->getBufferPointer(), resavedBlob->getBufferSize())));
+        SLANG_CHECK(SLANG_SUCCEEDED(_compileWithStdLib(reloadedSession)));
+    }
+
+    // A stdlib that doesn't match this build is rejected without modifying the session,
+    // so compiling from source can be used as a fallback
+    {
+        List<uint8_t> mismatched;
+        mismatched.addRange((const uint8_t*)stdLibBlob->getBufferPointer(), Index(stdLibBlob->getBufferSize()));
+
+        // The header is the first chunk in the stdlib list. Corrupt the source hash held in it.
+        // RIFF header (8) + list type (4) + chunk header (8) + version (4) + pad (4)
+        const Index sourceHashOffset = 8 + 4 + 8 + 4 + 4;
+        SLANG_CHECK_ABORT(mismatched.getCount() > sourceHashOffset + 8);
+        mismatched[sourceHashOffset] ^= 0xff;
+
+        ComPtr<slang::IGlobalSession> fallbackSession;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSessionWithoutStdLib(SLANG_API_VERSION, fallbackSession.writeRef())));
+
+        SLANG_CHECK(fallbackSession->loadStdLib(mismatched.getBuffer(), size_t(mismatched.getCount())) == SLANG_E_NOT_AVAILABLE);
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(fallbackSession->compileStdLib()));
+        SLANG_CHECK(SLANG_SUCCEEDED(_compileWithStdLib(fallbackSession)));
+    }
+}
+
+SLANG_UNIT_TEST("StdLibSerialize", stdLibSerializeTest);
@@ -43,6 +43,29 @@ static bool _checkLineParser(const UnownedStringSlice& input)
     return StringUtil::extractLine(remaining, line) == false;
 }
 
+// The line start offsets must match the starts of the lines found by extractLine
+static bool _checkLineStartOffsets(const UnownedStringSlice& input)
+{
+    List<uint32_t> offsets;
+    StringUtil::calcLineStartOffsets(input, offsets);
+
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(input, lines);
+
+    if (offsets.getCount() != lines.getCount())
+    {
+        return false;
+    }
+    for (Index i = 0; i < lines.getCount(); ++i)
+    {
+        if (offsets[i] != uint32_t(lines[i].begin() - input.begin()))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 static void stringUnitTest()
 {
     {
@@ -72,6 +95,28 @@ static void stringUnitTest()
         SLANG_CHECK(_checkLineParser(UnownedStringSlice::fromLiteral("\n")));
         SLANG_CHECK(_checkLineParser(UnownedStringSlice::fromLiteral("")));
     }
+    {
+        SLANG_CHECK(_checkLineStartOffsets(UnownedStringSlice(nullptr, nullptr)));
+        SLANG_CHECK(_checkLineStartOffsets(UnownedStringSlice::fromLiteral("")));
+        SLANG_CHECK(_checkLineStartOffsets(UnownedStringSlice::fromLiteral("\n")));
+        SLANG_CHECK(_checkLineStartOffsets(UnownedStringSlice::fromLiteral("Hello\n\rWorld!\n")));
+        SLANG_CHECK(_checkLineStartOffsets(UnownedStringSlice::fromLiteral("\r\r\n\n\n\r\n")));
+
+        // Random text long enough to be scanned in blocks, where line break pairs will straddle blocks
+        const char chars[] = { 'a', 'b', ' ', '\n', '\r' };
+        uint32_t state = 1;
+        for (int i = 0; i < 64; ++i)
+        {
+            StringBuilder builder;
+            const int length = 1 + (i * 7) % 97;
+            for (int j = 0; j < length; ++j)
+            {
+                state = state * 1664525 + 1013904223;
+                builder.appendChar(chars[(state >> 24) % SLANG_COUNT_OF(chars)]);
+            }
+            SLANG_CHECK(_checkLineStartOffsets(builder.getUnownedSlice()));
+        }
+    }
     {
         Int value;
         SLANG_CHECK(SLANG_SUCCEEDED(StringUtil::parseInt(UnownedStringSlice("-10"), value)) && value == -10);
@@ -0,0 +1,136 @@
+// unit-test-type-layout-cache.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../source/core/slang-basic.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static const char kSource[] =
+    "struct Light { float4 color; float3 direction; float intensity; };\n"
+    "struct Lights { Light lights[4]; int count; };\n"
+    "ConstantBuffer<Lights> lightsA;\n"
+    "ConstantBuffer<Lights> lightsB;\n"
+    "ConstantBuffer<Lights> lightsC;\n"
+    "RWStructuredBuffer<float4> outputBuffer;\n"
+    "[numthreads(1, 1, 1)]\n"
+    "void computeMain()\n"
+    "{\n"
+    "    outputBuffer[0] = lightsA.lights[0].color + lightsB.lights[1].color + lightsC.lights[2].color;\n"
+    "}\n";
+
+static void typeLayoutCacheTest()
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef())));
+
+    SlangCompileRequest* request = spCreateCompileRequest(globalSession);
+    spAddCodeGenTarget(request, SLANG_HLSL);
+    int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+    spAddTranslationUnitSourceString(request, tuIndex, "type-layout-cache.slang", kSource);
+    spAddEntryPoint(request, tuIndex, "computeMain", SLANG_STAGE_COMPUTE);
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(spCompile(request)));
+
+    // `Lights` (and so `Light`) is laid out once, and reused for the other parameters
+    SlangTypeLayoutCacheStats stats;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(spGetTypeLayoutCacheStats(request, 0, &stats)));
+    SLANG_CHECK(stats.hitCount >= 2);
+    SLANG_CHECK(stats.missCount > 0);
+    SLANG_CHECK(stats.entryCount == stats.missCount);
+
+    // The reused layouts are the same for each parameter
+    auto reflection = slang::ShaderReflection::get(request);
+    SLANG_CHECK_ABORT(reflection->getParameterCount() == 4);
+    auto layoutA = reflection->getParameterByIndex(0)->getTypeLayout()->getElementTypeLayout();
+    auto layoutB = reflection->getParameterByIndex(1)->getTypeLayout()->getElementTypeLayout();
+    SLANG_CHECK(layoutA == layoutB);
+    SLANG_CHECK(layoutA->getSize() == layoutB->getSize() && layoutA->getSize() > 0);
+    SLANG_CHECK(reflection->getParameterByIndex(1)->getBindingIndex() == 1);
+    SLANG_CHECK(reflection->getParameterByIndex(2)->getBindingIndex() == 2);
+
+    // A reflection query of a type that has already been laid out is a hit
+    const uint64_t hitCount = stats.hitCount;
+    slang::TypeReflection* lightsType = reflection->findTypeByName("Lights");
+    SLANG_CHECK_ABORT(lightsType);
+    slang::TypeLayoutReflection* lightsTypeLayout = reflection->getTypeLayout(lightsType);
+    SLANG_CHECK(lightsTypeLayout && lightsTypeLayout->getSize() == layoutA->getSize());
+
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(spGetTypeLayoutCacheStats(request, 0, &stats)));
+    SLANG_CHECK(stats.hitCount > hitCount);
+
+    SLANG_CHECK(spGetTypeLayoutCacheStats(request, 1, &stats) == SLANG_ERROR_INVALID_PARAMETER);
+
+    // Releasing the modules of another linkage doesn't release the layouts held
+    {
+        SlangCompileRequest* otherRequest = spCreateCompileRequest(globalSession);
+        spAddCodeGenTarget(otherRequest, SLANG_HLSL);
+        int otherTUIndex = spAddTranslationUnit(otherRequest, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+        spAddTranslationUnitSourceString(otherRequest, otherTUIndex, "type-layout-cache.slang", kSource);
+        spAddEntryPoint(otherRequest, otherTUIndex, "computeMain", SLANG_STAGE_COMPUTE);
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(spCompile(otherRequest)));
+        spDestroyCompileRequest(otherRequest);
+
+        const uint64_t otherHitCount = stats.hitCount;
+        slang::TypeReflection* lightType = reflection->findTypeByName("Light");
+        SLANG_CHECK_ABORT(lightType);
+        SLANG_CHECK(reflection->getTypeLayout(lightType) != nullptr);
+
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(spGetTypeLayoutCacheStats(request, 0, &stats)));
+        SLANG_CHECK(stats.hitCount > otherHitCount);
+        SLANG_CHECK(stats.releaseCount == 0);
+    }
+
+    // Layouts computed with other target flags aren't reused
+    {
+        spSetTargetFlags(request, 0, SLANG_TARGET_FLAG_PARAMETER_BLOCKS_USE_REGISTER_SPACES);
+
+        const uint64_t missCount = stats.missCount;
+        slang::TypeReflection* vectorType = reflection->findTypeByName("float4");
+        SLANG_CHECK_ABORT(vectorType);
+        SLANG_CHECK(reflection->getTypeLayout(vectorType) != nullptr);
+
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(spGetTypeLayoutCacheStats(request, 0, &stats)));
+        SLANG_CHECK(stats.missCount > missCount);
+    }
+
+    spDestroyCompileRequest(request);
+
+    // The target of a session outlives the compile requests made on it, and the types of their modules.
+    // Once those are released the layouts that could refer to them are too.
+    {
+        slang::TargetDesc targetDesc;
+        targetDesc.format = SLANG_HLSL;
+
+        slang::SessionDesc sessionDesc;
+        sessionDesc.targets = &targetDesc;
+        sessionDesc.targetCount = 1;
+
+        ComPtr<slang::ISession> session;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+
+        for (Index i = 0; i < 2; ++i)
+        {
+            SlangCompileRequest* sessionRequest = nullptr;
+            SLANG_CHECK_ABORT(SLANG_SUCCEEDED(session->createCompileRequest(&sessionRequest)));
+            int sessionTUIndex = spAddTranslationUnit(sessionRequest, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+            spAddTranslationUnitSourceString(sessionRequest, sessionTUIndex, "type-layout-cache.slang", kSource);
+            spAddEntryPoint(sessionRequest, sessionTUIndex, "computeMain", SLANG_STAGE_COMPUTE);
+            SLANG_CHECK_ABORT(SLANG_SUCCEEDED(spCompile(sessionRequest)));
+
+            SLANG_CHECK_ABORT(SLANG_SUCCEEDED(spGetTypeLayoutCacheStats(sessionRequest, 0, &stats)));
+            SLANG_CHECK(stats.entryCount > 0);
+            // The first request's module was released, so its layouts were too
+            SLANG_CHECK(i == 0 || stats.releaseCount > 0);
+
+            spDestroyCompileRequest(sessionRequest);
+        }
+    }
+}
+
+SLANG_UNIT_TEST("TypeLayoutCache", typeLayoutCacheTest);